@@ -7,11 +7,14 @@
 #include <stella/emucore/FrameBufferConstants.hxx>
 #include <stella/emucore/EventHandlerConstants.hxx>
 #include <imagine/pixmap/Pixmap.hh>
+#include <imagine/thread/Semaphore.hh>
 #include <array>
+#include <thread>
 
 class Console;
 class OSystem;
 class TIA;
+class EmuVideo;
 
 class FrameBuffer
 {
@@ -49,9 +52,31 @@ public:
 	float myPhosphorPercent = 0.80f;
 	bool myUsePhosphor = false;
 
+	// pipelined rendering state, see startAsyncRender()
+	std::array<uInt16, 160 * TIAConstants::frameBufferHeight> asyncFrame{};
+	std::thread asyncThread{};
+	IG::Semaphore asyncStartSem{0};
+	IG::Semaphore asyncDoneSem{0};
+	const uInt8 *asyncSrc{};
+	EmuVideo *asyncVideo{};
+	IG::PixmapDesc asyncDesc{};
+	bool asyncPending = false;
+	bool asyncQuit = false;
+
 	FrameBuffer() {}
+	~FrameBuffer();
 
 	void render(IG::Pixmap pix, TIA &tia);
+	void render(IG::Pixmap pix, const uInt8 *frame);
+
+	// Palette-expands & phosphor-blends the TIA's current frame buffer on a worker
+	// thread while the caller emulates the next frame, which only writes the TIA's
+	// back buffers. The result is collected by finishAsyncRender() before the next
+	// TIA::renderToFrameBuffer() and submitted to the given video.
+	void startAsyncRender(TIA &tia, EmuVideo &video);
+	IG::Pixmap finishAsyncRender(EmuVideo *&videoOut);
+	// waits for & drops any frame in progress
+	void cancelAsyncRender();
 
 	FrameBuffer &tiaSurface() { return *this; }
 
@@ -95,12 +95,23 @@ class CustomVideoOptionView : public VideoOptionView
 		setRuntimeTVPhosphor(optionTVPhosphor, val);
 	}
 
+	BoolMenuItem pipelinedRendering
+	{
+		"Pipelined Rendering",
+		(bool)optionPipelinedRendering,
+		[this](BoolMenuItem &item, View &, Input::Event e)
+		{
+			optionPipelinedRendering = item.flipBoolValue(*this);
+		}
+	};
+
 public:
 	CustomVideoOptionView(ViewAttachParams attach): VideoOptionView{attach, true}
 	{
 		loadStockItems();
 		item.emplace_back(&systemSpecificHeading);
 		item.emplace_back(&tvPhosphorBlend);
+		item.emplace_back(&pipelinedRendering);
 	}
 };
 
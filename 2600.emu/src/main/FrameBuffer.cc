@@ -18,6 +18,7 @@
 // TODO: Some Stella types collide with MacTypes.h
 #define Debugger DebuggerMac
 #include <emuframework/EmuApp.hh>
+#include <emuframework/EmuVideo.hh>
 #undef Debugger
 #include <imagine/logger/logger.h>
 
@@ -26,8 +27,19 @@ void FrameBuffer::showMessage(const string& message, int position, bool force, u
 	EmuApp::printfMessage(3, false, "%s", message.c_str());
 }
 
+FrameBuffer::~FrameBuffer()
+{
+	if(!asyncThread.joinable())
+		return;
+	cancelAsyncRender();
+	asyncQuit = true;
+	asyncStartSem.notify();
+	asyncThread.join();
+}
+
 void FrameBuffer::enablePhosphor(bool enable, int blend)
 {
+	cancelAsyncRender();
 	myUsePhosphor = enable;
 	if(blend >= 0)
 	{
@@ -54,6 +66,7 @@ uint8_t FrameBuffer::getPhosphor(uInt8 c1, uInt8 c2) const
 void FrameBuffer::setTIAPalette(const PaletteArray& palette)
 {
 	logMsg("setTIAPalette");
+	cancelAsyncRender();
 	iterateTimes(256, i)
 	{
 		uint8_t r = (palette[i] >> 16) & 0xff;
@@ -84,18 +97,63 @@ void FrameBuffer::render(IG::Pixmap pix, TIA &tia)
 {
 	assumeExpr(pix.w() == tia.width());
 	assumeExpr(pix.h() == tia.height());
-	IG::Pixmap framePix{{{(int)tia.width(), (int)tia.height()}, IG::PIXEL_I8}, tia.frameBuffer()};
+	render(pix, tia.frameBuffer());
+}
+
+void FrameBuffer::render(IG::Pixmap pix, const uInt8 *frame)
+{
+	IG::Pixmap framePix{{pix.size(), IG::PIXEL_I8}, (void*)frame};
 	if(myUsePhosphor)
 	{
-		uint8_t* prevFrame = prevFramebuffer.data();
+		const uint8_t* prevFrame = prevFramebuffer.data();
 		pix.writeTransformed([this, &prevFrame](uint8_t p)
 			{
 				return getRGBPhosphor(tiaColorMap32[p], tiaColorMap32[*prevFrame++]);
 			}, framePix);
-		memcpy(prevFramebuffer.data(), tia.frameBuffer(), sizeof(prevFramebuffer));
+		memcpy(prevFramebuffer.data(), frame, sizeof(prevFramebuffer));
 	}
 	else
 	{
 		pix.writeTransformed([this](uint8_t p){ return tiaColorMap16[p]; }, framePix);
 	}
 }
+
+void FrameBuffer::startAsyncRender(TIA &tia, EmuVideo &video)
+{
+	assumeExpr(!asyncPending);
+	if(!asyncThread.joinable())
+	{
+		asyncThread = std::thread{[this]()
+			{
+				while(true)
+				{
+					asyncStartSem.wait();
+					if(asyncQuit)
+						return;
+					render({asyncDesc, asyncFrame.data()}, asyncSrc);
+					asyncDoneSem.notify();
+				}
+			}};
+	}
+	asyncSrc = tia.frameBuffer();
+	asyncVideo = &video;
+	asyncDesc = {{(int)tia.width(), (int)tia.height()}, IG::PIXEL_FMT_RGB565};
+	asyncPending = true;
+	asyncStartSem.notify();
+}
+
+IG::Pixmap FrameBuffer::finishAsyncRender(EmuVideo *&videoOut)
+{
+	if(!asyncPending)
+		return {};
+	asyncDoneSem.wait();
+	asyncPending = false;
+	videoOut = asyncVideo;
+	return {asyncDesc, asyncFrame.data()};
+}
+
+void FrameBuffer::cancelAsyncRender()
+{
+	EmuVideo *video;
+	finishAsyncRender(video);
+}
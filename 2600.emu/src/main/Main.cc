@@ -17,7 +17,6 @@
 #include <stella/emucore/Cart.hxx>
 #include <stella/emucore/CartDetector.hxx>
 #include <stella/emucore/Props.hxx>
-#include <stella/emucore/MD5.hxx>
 #include <stella/emucore/Sound.hxx>
 #include <stella/emucore/tia/TIA.hxx>
 #include <stella/emucore/Switches.hxx>
@@ -37,6 +36,7 @@
 #include <emuframework/EmuAudio.hh>
 #include <emuframework/EmuVideo.hh>
 #include <emuframework/EmuInput.hh>
+#include <emuframework/RomIdentity.hh>
 #undef Debugger
 #include "internal.hh"
 
@@ -83,6 +83,7 @@ FS::PathString EmuSystem::sprintStateFilename(int slot, const char *savePath, co
 
 void EmuSystem::closeSystem()
 {
+	osystem->frameBuffer().cancelAsyncRender();
 	osystem->deleteConsole();
 }
 
@@ -114,7 +115,7 @@ EmuSystem::Error EmuSystem::loadGame(IO &io, EmuSystemCreateParams, OnLoadProgre
 	{
 		return makeFileReadError();
 	}
-	string md5 = MD5::hash(image, size);
+	string md5 = makeRomDigest(image.get(), size, fullGamePath(), originalGameFileName().data()).md5String().data();
 	Properties props{};
 	os->propSet().getMD5(md5, props);
 	defaultGameProps = props;
@@ -158,13 +159,27 @@ void EmuSystem::runFrame(EmuSystemTask *task, EmuVideo *video, EmuAudio *audio)
 	console.switches().update();
 	console.riot().update();
 	auto &tia = console.tia();
+	auto &fb = os->frameBuffer();
 	tia.update(0xFFFFFFFF);
+	// the previous frame was rendered on the worker while the TIA ran
+	EmuVideo *asyncVideo{};
+	if(auto pix = fb.finishAsyncRender(asyncVideo); pix)
+	{
+		asyncVideo->startFrameWithFormat(task, pix);
+	}
 	tia.renderToFrameBuffer();
 	if(video)
 	{
-		auto img = video->startFrameWithFormat(task, {{(int)tia.width(), (int)tia.height()}, IG::PIXEL_FMT_RGB565});
-		os->frameBuffer().render(img.pixmap(), tia);
-		img.endFrame();
+		if(optionPipelinedRendering)
+		{
+			fb.startAsyncRender(tia, *video);
+		}
+		else
+		{
+			auto img = video->startFrameWithFormat(task, {{(int)tia.width(), (int)tia.height()}, IG::PIXEL_FMT_RGB565});
+			fb.render(img.pixmap(), tia);
+			img.endFrame();
+		}
 	}
 	os->processAudio(audio);
 }
@@ -173,6 +188,7 @@ void EmuSystem::reset(ResetMode mode)
 {
 	auto os = osystem.get();
 	assert(gameIsRunning());
+	os->frameBuffer().cancelAsyncRender();
 	if(mode == RESET_HARD)
 	{
 		os->console().system().reset();
@@ -203,6 +219,7 @@ EmuSystem::Error EmuSystem::saveState(const char *path)
 EmuSystem::Error EmuSystem::loadState(const char *path)
 {
 	Serializer state(string(path), Serializer::Mode::ReadOnly);
+	osystem->frameBuffer().cancelAsyncRender();
 	if(!osystem->state().loadState(state))
 	{
 		return makeFileReadError();
@@ -27,7 +27,7 @@ enum
 	CFGKEY_2600_TV_PHOSPHOR = 270, CFGKEY_VIDEO_SYSTEM = 271,
 	CFGKEY_2600_TV_PHOSPHOR_BLEND = 272, CFGKEY_AUDIO_RESAMPLE_QUALITY = 273,
 	CFGKEY_INPUT_PORT_1 = 274, CFGKEY_INPUT_PORT_2 = 275,
-	CFGKEY_PADDLE_DIGITAL_SENSITIVITY = 276
+	CFGKEY_PADDLE_DIGITAL_SENSITIVITY = 276, CFGKEY_PIPELINED_RENDERING = 277
 };
 
 const char *EmuSystem::configFilename = "2600emu.config";
@@ -46,6 +46,7 @@ Byte1Option optionAudioResampleQuality{CFGKEY_AUDIO_RESAMPLE_QUALITY,
 Byte1Option optionInputPort1{CFGKEY_INPUT_PORT_1, 0, false, optionIsValidControllerType};
 Byte1Option optionPaddleDigitalSensitivity{CFGKEY_PADDLE_DIGITAL_SENSITIVITY, 1, false,
 	optionIsValidWithMinMax<1, 20>};
+Byte1Option optionPipelinedRendering{CFGKEY_PIPELINED_RENDERING, 0};
 
 static bool optionIsValidControllerType(uint8_t val)
 {
@@ -108,6 +109,7 @@ bool EmuSystem::readConfig(IO &io, uint key, uint readSize)
 		default: return 0;
 		bcase CFGKEY_2600_TV_PHOSPHOR_BLEND: optionTVPhosphorBlend.readFromIO(io, readSize);
 		bcase CFGKEY_AUDIO_RESAMPLE_QUALITY: optionAudioResampleQuality.readFromIO(io, readSize);
+		bcase CFGKEY_PIPELINED_RENDERING: optionPipelinedRendering.readFromIO(io, readSize);
 	}
 	return 1;
 }
@@ -116,6 +118,7 @@ void EmuSystem::writeConfig(IO &io)
 {
 	optionTVPhosphorBlend.writeWithKeyIfNotDefault(io);
 	optionAudioResampleQuality.writeWithKeyIfNotDefault(io);
+	optionPipelinedRendering.writeWithKeyIfNotDefault(io);
 }
 
 const char *optionVideoSystemToStr()
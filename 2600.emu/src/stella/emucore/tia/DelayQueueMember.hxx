@@ -18,11 +18,16 @@
 #ifndef TIA_DELAY_QUEUE_MEMBER
 #define TIA_DELAY_QUEUE_MEMBER
 
-#include "Serializable.hxx"
+#include "Serializer.hxx"
 #include "bspf.hxx"
 
+/**
+  Not derived from Serializable: the queue saves its members directly, and
+  without a vtable pointer a member is just its size byte and its entries,
+  so neighbouring members share cache lines.
+*/
 template<unsigned capacity>
-class DelayQueueMember : public Serializable {
+class DelayQueueMember {
 
   public:
     struct Entry {
@@ -40,15 +45,12 @@ class DelayQueueMember : public Serializable {
 
     void clear();
 
-    /**
-      Serializable methods (see that class for more information).
-    */
-    bool save(Serializer& out) const override;
-    bool load(Serializer& in) override;
+    bool save(Serializer& out) const;
+    bool load(Serializer& in);
 
   public:
-    std::array<Entry, capacity> myEntries;
     uInt8 mySize{0};
+    std::array<Entry, capacity> myEntries;
 
   private:
     DelayQueueMember(const DelayQueueMember<capacity>&) = delete;
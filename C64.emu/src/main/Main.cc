@@ -501,6 +501,14 @@ static bool initC64()
 	}
 	c64IsInit = true;
 	updateKeyMappingArray();
+	// start the emulation thread only once a system is created so it doesn't delay app startup
+	IG::makeDetachedThread(
+		[]()
+		{
+			execSem.wait();
+			logMsg("starting maincpu_mainloop()");
+			plugin.maincpu_mainloop();
+		});
 	return true;
 }
 
@@ -688,14 +696,6 @@ void EmuSystem::onPrepareAudio(EmuAudio &audio)
 
 EmuSystem::Error EmuSystem::onInit()
 {
-	IG::makeDetachedThread(
-		[]()
-		{
-			execSem.wait();
-			logMsg("starting maincpu_mainloop()");
-			plugin.maincpu_mainloop();
-		});
-
 	#if defined CONFIG_ENV_LINUX && !defined CONFIG_MACHINE_PANDORA
 	sysFilePath[1] = EmuApp::assetPath();
 	sysFilePath[2] = FS::makePathStringPrintf("%s/C64.emu.zip", EmuApp::assetPath().data());
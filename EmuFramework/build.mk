@@ -8,7 +8,9 @@ SRC += AudioOptionView.cc \
 BundledGamesView.cc \
 ButtonConfigView.cc \
 Cheats.cc \
+CompressedCDImage.cc \
 ConfigFile.cc \
+ConfigStore.cc \
 CreditsView.cc \
 EmuApp.cc \
 EmuAudio.cc \
@@ -28,10 +30,15 @@ EmuViewController.cc \
 FilePicker.cc \
 FileUtils.cc \
 GUIOptionView.cc \
+InputMovie.cc \
+InputLatch.cc \
 InputManagerView.cc \
 Recent.cc \
 RecentGameView.cc \
+RegressionRunner.cc \
+RomIdentity.cc \
 Screenshot.cc \
+StartupTrace.cc \
 StateSlotView.cc \
 SystemOptionView.cc \
 VideoImageEffect.cc \
@@ -64,6 +71,7 @@ LDLIBS := -l$(libName) $(LDLIBS)
 
 include $(IMAGINE_PATH)/make/package/imagine.mk
 include $(IMAGINE_PATH)/make/package/stdc++.mk
+include $(IMAGINE_PATH)/make/package/zlib.mk
 
 include $(IMAGINE_PATH)/make/imagineStaticLibTarget.mk
 
@@ -0,0 +1,137 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/io/IO.hh>
+#include <imagine/thread/Semaphore.hh>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <system_error>
+
+// Reader for hunk-indexed compressed CD images (.cdz), shared by the CD-capable cores.
+// All integers are little-endian, the file layout is:
+//   Header
+//   Track[header.tracks]
+//   uint64_t hunkOffset[hunks + 1], hunk N occupies [hunkOffset[N], hunkOffset[N+1])
+//   hunk data
+// Each hunk holds header.hunkSectors sectors of header.sectorSize bytes (2352, or 2448 with
+// interleaved P-W subchannel data) compressed as a raw deflate stream, or stored as-is when
+// its size equals the uncompressed hunk size. Sector N of the image is LBA N of the disc,
+// so track pregaps are stored inline and the 150 sector lead-in is omitted.
+
+class CompressedCDImage
+{
+public:
+	static constexpr char MAGIC[8]{'E', 'X', 'C', 'D', 'Z', 'I', 'M', 'G'};
+	static constexpr uint32_t FORMAT_VERSION = 1;
+	static constexpr uint32_t RAW_SECTOR_SIZE = 2352;
+	static constexpr uint32_t SUBCHANNEL_SIZE = 96;
+	static constexpr uint32_t MAX_HUNK_SECTORS = 64;
+	static constexpr uint32_t MAX_TRACKS = 99;
+
+	struct Header
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t sectorSize;
+		uint32_t hunkSectors;
+		uint32_t sectors;
+		uint32_t tracks;
+		uint32_t reserved;
+	};
+
+	enum class TrackType : uint8_t
+	{
+		AUDIO, MODE1, MODE2
+	};
+
+	struct Track
+	{
+		uint8_t number;
+		TrackType type;
+		uint16_t reserved;
+		uint32_t lba; // start of INDEX 01
+		uint32_t sectors; // sectors from INDEX 01 to the next track's pregap
+		uint32_t pregap; // INDEX 00 sectors stored before lba
+	};
+
+	static_assert(sizeof(Header) == 32);
+	static_assert(sizeof(Track) == 16);
+
+	struct Stats
+	{
+		uint32_t hits;
+		uint32_t misses;
+		uint32_t readAheadHunks;
+	};
+
+	CompressedCDImage();
+	CompressedCDImage(const CompressedCDImage &) = delete;
+	CompressedCDImage &operator=(const CompressedCDImage &) = delete;
+	~CompressedCDImage();
+	std::error_code open(GenericIO io, uint32_t cacheHunks = 16);
+	std::error_code open(const char *path, uint32_t cacheHunks = 16);
+	void close();
+	// reads sectorSize() bytes, returns false if sector is out of range or the data is corrupt
+	bool readSector(void *buff, uint32_t sector);
+	// queue the hunk containing sector for decompression on the read-ahead thread
+	void hintReadAhead(uint32_t sector);
+	uint32_t sectors() const { return header.sectors; }
+	uint32_t sectorSize() const { return header.sectorSize; }
+	bool hasSubchannel() const { return header.sectorSize == RAW_SECTOR_SIZE + SUBCHANNEL_SIZE; }
+	uint32_t tracks() const { return header.tracks; }
+	const Track &track(uint32_t idx) const { return trackTable[idx]; }
+	// index into the track table for the given sector, including its pregap
+	int trackForSector(uint32_t sector) const;
+	Stats stats() const;
+	explicit operator bool() const { return (bool)io; }
+	static bool hasExtension(const char *name);
+
+protected:
+	struct CacheEntry
+	{
+		std::unique_ptr<uint8_t[]> data{};
+		int32_t hunk = -1;
+		uint32_t lastUse = 0;
+	};
+
+	struct Decoder;
+
+	GenericIO io{};
+	Header header{};
+	std::unique_ptr<Track[]> trackTable{};
+	std::unique_ptr<uint64_t[]> hunkOffset{};
+	std::unique_ptr<CacheEntry[]> cache{};
+	std::unique_ptr<Decoder> decoder{}, readAheadDecoder{};
+	std::thread readAheadThread{};
+	IG::Semaphore readAheadSem{0};
+	mutable std::mutex cacheMutex{};
+	std::atomic_int32_t readAheadHunk{-1};
+	std::atomic_bool readAheadRunning{};
+	uint32_t hunks = 0;
+	uint32_t hunkBytes = 0;
+	uint32_t cacheEntries = 0;
+	uint32_t useCounter = 0;
+	Stats stats_{};
+
+	CacheEntry *findHunk(int32_t hunk);
+	CacheEntry &leastRecentlyUsed();
+	bool decodeHunk(Decoder &dec, uint32_t hunk, uint8_t *dest);
+	void insertHunk(int32_t hunk, std::unique_ptr<uint8_t[]> &data);
+	void runReadAhead();
+};
@@ -18,6 +18,7 @@
 #include <imagine/audio/OutputStream.hh>
 #include <imagine/time/Time.hh>
 #include <imagine/vmem/RingBuffer.hh>
+#include <imagine/util/DelegateFunc.hh>
 #include <memory>
 #include <atomic>
 
@@ -32,6 +33,23 @@ public:
 		MULTI_UNDERRUN
 	};
 
+	struct Stats
+	{
+		uint32_t queuedFrames;
+		uint32_t targetFrames;
+		uint32_t capacityFrames;
+		uint32_t underruns;
+		uint32_t overruns;
+		uint32_t callbacks;
+		uint32_t callbackFrames;
+		IG::Microseconds avgCallbackPeriod;
+		IG::Microseconds callbackJitter; // max - min callback period
+		IG::Microseconds latency; // queued frames plus the last callback's frames
+	};
+
+	// receives the samples passed to writeFrames() instead of the output stream, for headless runs
+	using CaptureDelegate = DelegateFunc<void (const void *samples, uint32_t frames)>;
+
 	constexpr EmuAudio() {}
 	void open(IG::Audio::Api api);
 	void start(IG::Microseconds targetBufferFillUSecs, IG::Microseconds bufferIncrementUSecs);
@@ -45,10 +63,16 @@ public:
 	void setAddSoundBuffersOnUnderrun(bool on);
 	void setVolume(uint8_t vol);
 	IG::Audio::Format format() const;
+	// counters cover the time since the last resetStats(), safe to call from any thread
+	Stats stats() const;
+	void resetStats();
+	void setLogStats(bool on);
+	void setCapture(CaptureDelegate del);
 	explicit operator bool() const;
 
 protected:
 	std::unique_ptr<IG::Audio::OutputStream> audioStream{};
+	CaptureDelegate capture{};
 	IG::RingBuffer rBuff{};
 	IG::Time lastUnderrunTime{};
 	uint32_t targetBufferFillBytes = 0;
@@ -59,10 +83,24 @@ protected:
 	bool addSoundBuffersOnUnderrun = false;
 	uint8_t speedMultiplier = 1;
 	uint8_t channels = 2;
+	bool logStats = false;
+	IG::Time lastCallbackTime{};
+	std::atomic_uint32_t underruns{};
+	std::atomic_uint32_t overruns{};
+	std::atomic_uint32_t callbacks{};
+	std::atomic_uint32_t callbackPeriods{};
+	std::atomic_uint32_t callbackFrames{};
+	std::atomic_uint32_t lastCallbackFrames{};
+	std::atomic_uint32_t minCallbackUSecs{UINT32_MAX};
+	std::atomic_uint32_t maxCallbackUSecs{};
+	std::atomic_uint64_t callbackUSecsSum{};
 
 	uint32_t framesFree() const;
 	uint32_t framesWritten() const;
 	uint32_t framesCapacity() const;
 	bool shouldStartAudioWrites(uint32_t bytesToWrite = 0) const;
 	void resizeAudioBuffer(uint32_t targetBufferFillBytes);
+	void updateCallbackStats(uint32_t frames);
+	void startStats();
+	void stopStats();
 };
@@ -146,6 +146,11 @@ public:
 	static void startAutoSaveStateTimer();
 	static Error loadState(const char *path);
 	static Error saveState(const char *path);
+	// states kept in memory for rewind & run-ahead, stateSize() returns 0
+	// if unsupported, otherwise the buffer size needed by saveStateToMemory()
+	static size_t stateSize();
+	static Error saveStateToMemory(void *buff, size_t size);
+	static Error loadStateFromMemory(const void *buff, size_t size);
 	static bool stateExists(int slot);
 	static bool shouldOverwriteExistingState();
 	static const char *systemName();
@@ -216,6 +221,8 @@ public:
 		bool turbo;
 		return translateInputAction(input, turbo);
 	}
+	// called by the emulation core right before it latches the state of its input ports
+	static void latchInput();
 	static bool touchControlsApplicable();
 	static bool handlePointerInputEvent(Input::Event e, IG::WindowRect gameRect);
 	static EmuFrameTimeInfo advanceFramesWithTime(IG::FrameTime time);
@@ -226,6 +233,9 @@ public:
 	static void clearGamePaths();
 	static FS::PathString baseDefaultGameSavePath();
 	static IG::Time benchmark(EmuVideo &video);
+	// average time of a saveStateToMemory() & loadStateFromMemory() round trip,
+	// returns {} if unsupported
+	static std::pair<IG::Time, IG::Time> benchmarkStates();
 	static bool gameIsRunning()
 	{
 		return !string_equal(gameName_.data(), "");
@@ -17,6 +17,7 @@
 
 #include <imagine/gfx/PixmapBufferTexture.hh>
 #include <imagine/gfx/SyncFence.hh>
+#include <memory>
 
 class EmuVideo;
 class EmuSystemTask;
@@ -68,21 +69,34 @@ public:
 	bool setImageBuffers(unsigned num);
 	unsigned imageBuffers() const;
 	void setCompatTextureSampler(const Gfx::TextureSampler &);
+	// without a renderer task, as in headless runs, frames are written to this buffer
+	IG::Pixmap memoryImage() const;
+	// frames matching the previous one skip the texture upload, counts are since the last clear()
+	bool lastFrameIsDuplicate() const { return lastFrameIsDuplicate_; }
+	uint32_t finishedFrames() const { return finishedFrames_; }
+	uint32_t duplicateFrames() const { return duplicateFrames_; }
 
 protected:
 	Gfx::RendererTask *rTask{};
 	const Gfx::TextureSampler *texSampler{};
 	Gfx::SyncFence fence{};
 	Gfx::PixmapBufferTexture vidImg{};
+	std::unique_ptr<char[]> memImg{};
+	IG::PixmapDesc memImgDesc{};
+	uint64_t lastFrameHash{};
+	uint32_t finishedFrames_{};
+	uint32_t duplicateFrames_{};
 	FrameFinishedDelegate onFrameFinished{};
 	FormatChangedDelegate onFormatChanged{};
 	Gfx::TextureBufferMode bufferMode{};
 	bool screenshotNextFrame = false;
 	bool singleBuffer = false;
 	bool needsFence = false;
+	bool hasFrameHash = false;
+	bool lastFrameIsDuplicate_ = false;
 
 	void doScreenshot(EmuSystemTask *task, IG::Pixmap pix);
-	void dispatchFinishFrame(EmuSystemTask *task);
+	void dispatchFinishFrame(EmuSystemTask *task, bool isDuplicate = false);
 	void postSetFormat(EmuSystemTask &task, IG::PixmapDesc desc);
 	void syncImageAccess();
 	void updateNeedsFence();
@@ -16,6 +16,7 @@
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <imagine/gui/View.hh>
+#include <emuframework/EmuAudio.hh>
 #ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
 #include <imagine/gfx/GfxText.hh>
 #endif
@@ -34,7 +35,7 @@ public:
 	bool inputEvent(Input::Event e) final;
 	bool hasLayer() const { return layer; }
 	void setLayoutInputView(EmuInputView *view);
-	void updateAudioStats(uint underruns, uint overruns, uint callbacks, double avgCallbackFrames, uint frames);
+	void updateAudioStats(const EmuAudio::Stats &stats);
 	void clearAudioStats();
 	EmuVideoLayer *videoLayer() const { return layer; }
 
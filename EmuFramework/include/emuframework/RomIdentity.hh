@@ -0,0 +1,83 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <array>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+// ROM identification shared by the cores: the CRC32, MD5 & SHA-1 of a ROM image are
+// computed together in one pass and looked up in per-core tables sorted by their key.
+
+struct RomDigest
+{
+	uint32_t crc32{};
+	std::array<uint8_t, 16> md5{};
+	std::array<uint8_t, 20> sha1{};
+
+	// the last 8 MD5 bytes read as a big-endian integer, as keyed in FCEUX's tables
+	uint64_t md5Lower64() const;
+	// lower-case hex string of the MD5
+	std::array<char, 33> md5String() const;
+	// the SHA-1 as 5 big-endian words
+	std::array<uint32_t, 5> sha1Words() const;
+};
+
+class RomHasher
+{
+public:
+	RomHasher();
+	void update(const void *data, size_t size);
+	RomDigest finish();
+
+private:
+	uint64_t bytes = 0;
+	uint32_t crc = 0;
+	uint32_t md5State[4];
+	uint32_t sha1State[5];
+	uint32_t blockSize = 0;
+	uint8_t block[64];
+
+	void processBlock(const uint8_t *block);
+};
+
+RomDigest makeRomDigest(const void *data, size_t size);
+
+// returns the digest of a previous call with the same content path, size,
+// and modification time instead of re-hashing the data, subPath selects a
+// file inside an archive
+RomDigest makeRomDigest(const void *data, size_t size, const char *path, const char *subPath = nullptr);
+
+// binary search of a table sorted by the key returned from proj,
+// returns the first matching entry or nullptr
+template <class Entry, size_t N, class Key, class Proj>
+static constexpr const Entry *findRomDBEntry(const Entry (&table)[N], const Key &key, Proj proj)
+{
+	auto it = std::lower_bound(std::begin(table), std::end(table), key,
+		[&](const Entry &e, const Key &key){ return std::invoke(proj, e) < key; });
+	if(it == std::end(table) || !(std::invoke(proj, *it) == key))
+		return nullptr;
+	return it;
+}
+
+template <class Entry, size_t N, class Proj>
+static constexpr bool romDBIsSorted(const Entry (&table)[N], Proj proj)
+{
+	return std::is_sorted(std::begin(table), std::end(table),
+		[&](const Entry &a, const Entry &b){ return std::invoke(proj, a) < std::invoke(proj, b); });
+}
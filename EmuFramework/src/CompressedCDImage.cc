@@ -0,0 +1,292 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "CDZImage"
+#include <emuframework/CompressedCDImage.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/util/string.h>
+#include <imagine/util/algorithm.h>
+#include <imagine/logger/logger.h>
+#include <zlib.h>
+#include <cstring>
+
+struct CompressedCDImage::Decoder
+{
+	z_stream stream{};
+	std::unique_ptr<uint8_t[]> compBuff{};
+	std::unique_ptr<uint8_t[]> hunkBuff{};
+
+	Decoder(uint32_t hunkBytes):
+		compBuff{std::make_unique<uint8_t[]>(hunkBytes)},
+		hunkBuff{std::make_unique<uint8_t[]>(hunkBytes)}
+	{
+		inflateInit2(&stream, -MAX_WBITS);
+	}
+
+	~Decoder()
+	{
+		inflateEnd(&stream);
+	}
+};
+
+CompressedCDImage::CompressedCDImage() {}
+
+CompressedCDImage::~CompressedCDImage()
+{
+	close();
+}
+
+bool CompressedCDImage::hasExtension(const char *name)
+{
+	return string_hasDotExtension(name, "cdz");
+}
+
+std::error_code CompressedCDImage::open(const char *path, uint32_t cacheHunks)
+{
+	FileIO file;
+	if(auto ec = file.open(path, IO::AccessHint::RANDOM);
+		ec)
+	{
+		return ec;
+	}
+	return open(file.makeGeneric(), cacheHunks);
+}
+
+std::error_code CompressedCDImage::open(GenericIO io_, uint32_t cacheHunks)
+{
+	close();
+	Header h;
+	if(io_.read(&h, sizeof(h)) != sizeof(h) ||
+		memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0)
+	{
+		logErr("missing header");
+		return {EINVAL, std::system_category()};
+	}
+	if(h.version != FORMAT_VERSION)
+	{
+		logErr("unsupported version:%u", h.version);
+		return {ENOTSUP, std::system_category()};
+	}
+	if((h.sectorSize != RAW_SECTOR_SIZE && h.sectorSize != RAW_SECTOR_SIZE + SUBCHANNEL_SIZE) ||
+		!h.hunkSectors || h.hunkSectors > MAX_HUNK_SECTORS ||
+		!h.tracks || h.tracks > MAX_TRACKS)
+	{
+		logErr("invalid header values");
+		return {EINVAL, std::system_category()};
+	}
+	hunks = (h.sectors + h.hunkSectors - 1) / h.hunkSectors;
+	hunkBytes = h.hunkSectors * h.sectorSize;
+	trackTable = std::make_unique<Track[]>(h.tracks);
+	hunkOffset = std::make_unique<uint64_t[]>(hunks + 1);
+	if(io_.read(trackTable.get(), sizeof(Track) * h.tracks) != (ssize_t)(sizeof(Track) * h.tracks) ||
+		io_.read(hunkOffset.get(), sizeof(uint64_t) * (hunks + 1)) != (ssize_t)(sizeof(uint64_t) * (hunks + 1)))
+	{
+		logErr("truncated index");
+		trackTable.reset();
+		hunkOffset.reset();
+		return {EIO, std::system_category()};
+	}
+	header = h;
+	cacheEntries = std::max(cacheHunks, 2u);
+	cache = std::make_unique<CacheEntry[]>(cacheEntries);
+	iterateTimes(cacheEntries, i)
+	{
+		cache[i].data = std::make_unique<uint8_t[]>(hunkBytes);
+	}
+	decoder = std::make_unique<Decoder>(hunkBytes);
+	readAheadDecoder = std::make_unique<Decoder>(hunkBytes);
+	io = std::move(io_);
+	io.advise(0, 0, IO::Advice::RANDOM);
+	stats_ = {};
+	readAheadRunning = true;
+	readAheadThread = std::thread{[this](){ runReadAhead(); }};
+	logMsg("opened image with %u sectors in %u hunks of %u sectors, %u tracks",
+		h.sectors, hunks, h.hunkSectors, h.tracks);
+	return {};
+}
+
+void CompressedCDImage::close()
+{
+	if(readAheadThread.joinable())
+	{
+		readAheadRunning = false;
+		readAheadSem.notify();
+		readAheadThread.join();
+	}
+	if(io)
+	{
+		logMsg("closing image, cache hits:%u misses:%u read-ahead hunks:%u",
+			stats_.hits, stats_.misses, stats_.readAheadHunks);
+	}
+	io = {};
+	trackTable.reset();
+	hunkOffset.reset();
+	cache.reset();
+	decoder.reset();
+	readAheadDecoder.reset();
+	readAheadHunk = -1;
+	header = {};
+	hunks = hunkBytes = cacheEntries = useCounter = 0;
+}
+
+int CompressedCDImage::trackForSector(uint32_t sector) const
+{
+	for(int i = header.tracks - 1; i >= 0; i--)
+	{
+		if(sector + trackTable[i].pregap >= trackTable[i].lba)
+			return i;
+	}
+	return 0;
+}
+
+CompressedCDImage::CacheEntry *CompressedCDImage::findHunk(int32_t hunk)
+{
+	iterateTimes(cacheEntries, i)
+	{
+		if(cache[i].hunk == hunk)
+			return &cache[i];
+	}
+	return nullptr;
+}
+
+CompressedCDImage::CacheEntry &CompressedCDImage::leastRecentlyUsed()
+{
+	auto *lru = &cache[0];
+	iterateTimes(cacheEntries, i)
+	{
+		auto &e = cache[i];
+		if(e.hunk == -1)
+			return e;
+		if(e.lastUse < lru->lastUse)
+			lru = &e;
+	}
+	return *lru;
+}
+
+bool CompressedCDImage::decodeHunk(Decoder &dec, uint32_t hunk, uint8_t *dest)
+{
+	auto offset = hunkOffset[hunk];
+	auto compSize = hunkOffset[hunk + 1] - offset;
+	if(compSize > hunkBytes)
+	{
+		logErr("hunk %u has invalid size:%llu", hunk, (unsigned long long)compSize);
+		return false;
+	}
+	auto bytes = hunk == hunks - 1 ?
+		(header.sectors - hunk * header.hunkSectors) * header.sectorSize : hunkBytes;
+	if(compSize == bytes)
+	{
+		// stored uncompressed
+		return io.readAtPos(dest, compSize, offset) == (ssize_t)compSize;
+	}
+	if(io.readAtPos(dec.compBuff.get(), compSize, offset) != (ssize_t)compSize)
+	{
+		logErr("error reading hunk %u", hunk);
+		return false;
+	}
+	inflateReset(&dec.stream);
+	dec.stream.next_in = dec.compBuff.get();
+	dec.stream.avail_in = compSize;
+	dec.stream.next_out = dest;
+	dec.stream.avail_out = bytes;
+	if(inflate(&dec.stream, Z_FINISH) != Z_STREAM_END || dec.stream.avail_out)
+	{
+		logErr("error decompressing hunk %u", hunk);
+		return false;
+	}
+	return true;
+}
+
+void CompressedCDImage::insertHunk(int32_t hunk, std::unique_ptr<uint8_t[]> &data)
+{
+	// swap buffers so no copy or allocation is needed, caller holds cacheMutex
+	auto &e = leastRecentlyUsed();
+	e.data.swap(data);
+	e.hunk = hunk;
+	e.lastUse = useCounter;
+}
+
+bool CompressedCDImage::readSector(void *buff, uint32_t sector)
+{
+	if(sector >= header.sectors)
+		return false;
+	int32_t hunk = sector / header.hunkSectors;
+	auto sectorOffset = (sector % header.hunkSectors) * header.sectorSize;
+	{
+		std::lock_guard<std::mutex> lock{cacheMutex};
+		useCounter++;
+		auto e = findHunk(hunk);
+		if(!e)
+		{
+			// decode on the calling thread, the read-ahead thread never touches decoder
+			stats_.misses++;
+			if(!decodeHunk(*decoder, hunk, decoder->hunkBuff.get()))
+				return false;
+			insertHunk(hunk, decoder->hunkBuff);
+			e = findHunk(hunk);
+		}
+		else
+		{
+			stats_.hits++;
+			e->lastUse = useCounter;
+		}
+		memcpy(buff, &e->data[sectorOffset], header.sectorSize);
+	}
+	// keep the next hunk ready for sequential reads
+	if((uint32_t)hunk + 1 < hunks && sector % header.hunkSectors >= header.hunkSectors / 2)
+		hintReadAhead((hunk + 1) * header.hunkSectors);
+	return true;
+}
+
+void CompressedCDImage::hintReadAhead(uint32_t sector)
+{
+	if(sector >= header.sectors)
+		return;
+	int32_t hunk = sector / header.hunkSectors;
+	if(readAheadHunk.exchange(hunk) != hunk)
+		readAheadSem.notify();
+}
+
+void CompressedCDImage::runReadAhead()
+{
+	while(true)
+	{
+		readAheadSem.wait();
+		if(!readAheadRunning)
+			return;
+		auto hunk = readAheadHunk.exchange(-1);
+		if(hunk == -1)
+			continue;
+		{
+			std::lock_guard<std::mutex> lock{cacheMutex};
+			if(findHunk(hunk))
+				continue;
+		}
+		// decompress outside the lock so the emulation thread isn't blocked
+		if(!decodeHunk(*readAheadDecoder, hunk, readAheadDecoder->hunkBuff.get()))
+			continue;
+		std::lock_guard<std::mutex> lock{cacheMutex};
+		if(findHunk(hunk))
+			continue;
+		insertHunk(hunk, readAheadDecoder->hunkBuff);
+		stats_.readAheadHunks++;
+	}
+}
+
+CompressedCDImage::Stats CompressedCDImage::stats() const
+{
+	std::lock_guard<std::mutex> lock{cacheMutex};
+	return stats_;
+}
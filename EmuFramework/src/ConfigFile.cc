@@ -374,6 +374,128 @@ static void writeConfig2(IO &io)
 	EmuSystem::writeConfig(io);
 }
 
+static void readInputDeviceConfigs(IO &io, uint16_t size)
+{
+	auto confs = io.get<uint8_t>(); // TODO: unused currently, use to pre-allocate memory for configs
+	size--;
+	if(!size)
+		return;
+
+	while(size)
+	{
+		InputDeviceSavedConfig devConf;
+
+		devConf.enumId = io.get<uint8_t>();
+		size--;
+		if(!size)
+			break;
+		if(devConf.enumId > 32)
+		{
+			logWarn("unusually large device id %d, skipping rest of configs", devConf.enumId);
+			break;
+		}
+
+		devConf.enabled = io.get<uint8_t>();
+		size--;
+		if(!size)
+			break;
+
+		devConf.player = io.get<uint8_t>();
+		if(devConf.player != InputDeviceConfig::PLAYER_MULTI && devConf.player > EmuSystem::maxPlayers)
+		{
+			logWarn("player %d out of range", devConf.player);
+			devConf.player = 0;
+		}
+		size--;
+		if(!size)
+			break;
+
+		devConf.joystickAxisAsDpadBits = io.get<uint8_t>();
+		size--;
+		if(!size)
+			break;
+
+		#ifdef CONFIG_INPUT_ICADE
+		devConf.iCadeMode = io.get<uint8_t>();
+		size--;
+		if(!size)
+			break;
+		#endif
+
+		auto nameLen = io.get<uint8_t>();
+		size--;
+		if(size < nameLen)
+			break;
+
+		if(nameLen > sizeof(devConf.name)-1)
+			break;
+		io.read(devConf.name, nameLen);
+		size -= nameLen;
+		if(!size)
+			break;
+
+		auto keyConfMap = io.get<uint8_t>();
+		size--;
+
+		if(keyConfMap)
+		{
+			if(!size)
+				break;
+
+			auto keyConfNameLen = io.get<uint8_t>();
+			size--;
+			if(size < keyConfNameLen)
+				break;
+
+			if(keyConfNameLen > sizeof(devConf.name)-1)
+				break;
+			char keyConfName[sizeof(devConf.name)]{};
+			if(io.read(keyConfName, keyConfNameLen) != keyConfNameLen)
+				break;
+			size -= keyConfNameLen;
+
+			for(auto &e : customKeyConfig)
+			{
+				if(e.map == keyConfMap && string_equal(e.name, keyConfName))
+				{
+					logMsg("found referenced custom key config %s while reading input device config", keyConfName);
+					devConf.keyConf = &e;
+					break;
+				}
+			}
+
+			if(!devConf.keyConf) // check built-in configs after user-defined ones
+			{
+				uint defaultConfs = 0;
+				auto defaultConf = KeyConfig::defaultConfigsForInputMap(keyConfMap, defaultConfs);
+				iterateTimes(defaultConfs, c)
+				{
+					if(string_equal(defaultConf[c].name, keyConfName))
+					{
+						logMsg("found referenced built-in key config %s while reading input device config", keyConfName);
+						devConf.keyConf = &defaultConf[c];
+						break;
+					}
+				}
+			}
+		}
+
+		logMsg("read input device config %s, id %d", devConf.name, devConf.enumId);
+		savedInputDevList.push_back(devConf);
+
+		if(savedInputDevList.size() == INPUT_DEVICE_CONFIGS_HARD_LIMIT)
+		{
+			logWarn("reached input device config hard limit:%d", INPUT_DEVICE_CONFIGS_HARD_LIMIT);
+			break;
+		}
+	}
+	if(size)
+	{
+		// skip leftover bytes
+		logWarn("%d bytes leftover reading input device configs", size);
+	}
+}
+
 void loadConfigFile()
 {
 	auto configFilePath = FS::makePathStringPrintf("%s/config", EmuApp::supportPath().data());
@@ -413,8 +535,10 @@ void loadConfigFile()
 		logMsg("no config file");
 		return;
 	}
+	off_t inputDevConfigsOffset = -1;
+	uint16_t inputDevConfigsSize = 0;
 	readConfigKeys(configFile,
-		[](uint16_t key, uint16_t size, IO &io)
+		[&](uint16_t key, uint16_t size, IO &io)
 		{
 			switch(key)
 			{
@@ -537,127 +661,14 @@ void loadConfigFile()
 				}
 				bcase CFGKEY_INPUT_DEVICE_CONFIGS:
 				{
-					auto confs = io.get<uint8_t>(); // TODO: unused currently, use to pre-allocate memory for configs
-					size--;
-					if(!size)
-						break;
-
-					while(size)
-					{
-						InputDeviceSavedConfig devConf;
-
-						devConf.enumId = io.get<uint8_t>();
-						size--;
-						if(!size)
-							break;
-						if(devConf.enumId > 32)
-						{
-							logWarn("unusually large device id %d, skipping rest of configs", devConf.enumId);
-							break;
-						}
-
-						devConf.enabled = io.get<uint8_t>();
-						size--;
-						if(!size)
-							break;
-
-						devConf.player = io.get<uint8_t>();
-						if(devConf.player != InputDeviceConfig::PLAYER_MULTI && devConf.player > EmuSystem::maxPlayers)
-						{
-							logWarn("player %d out of range", devConf.player);
-							devConf.player = 0;
-						}
-						size--;
-						if(!size)
-							break;
-
-						devConf.joystickAxisAsDpadBits = io.get<uint8_t>();
-						size--;
-						if(!size)
-							break;
-
-						#ifdef CONFIG_INPUT_ICADE
-						devConf.iCadeMode = io.get<uint8_t>();
-						size--;
-						if(!size)
-							break;
-						#endif
-
-						auto nameLen = io.get<uint8_t>();
-						size--;
-						if(size < nameLen)
-							break;
-
-						if(nameLen > sizeof(devConf.name)-1)
-							break;
-						io.read(devConf.name, nameLen);
-						size -= nameLen;
-						if(!size)
-							break;
-
-						auto keyConfMap = io.get<uint8_t>();
-						size--;
-
-						if(keyConfMap)
-						{
-							if(!size)
-								break;
-
-							auto keyConfNameLen = io.get<uint8_t>();
-							size--;
-							if(size < keyConfNameLen)
-								break;
-
-							if(keyConfNameLen > sizeof(devConf.name)-1)
-								break;
-							char keyConfName[sizeof(devConf.name)]{};
-							if(io.read(keyConfName, keyConfNameLen) != keyConfNameLen)
-								break;
-							size -= keyConfNameLen;
-
-							for(auto &e : customKeyConfig)
-							{
-								if(e.map == keyConfMap && string_equal(e.name, keyConfName))
-								{
-									logMsg("found referenced custom key config %s while reading input device config", keyConfName);
-									devConf.keyConf = &e;
-									break;
-								}
-							}
-
-							if(!devConf.keyConf) // check built-in configs after user-defined ones
-							{
-								uint defaultConfs = 0;
-								auto defaultConf = KeyConfig::defaultConfigsForInputMap(keyConfMap, defaultConfs);
-								iterateTimes(defaultConfs, c)
-								{
-									if(string_equal(defaultConf[c].name, keyConfName))
-									{
-										logMsg("found referenced built-in key config %s while reading input device config", keyConfName);
-										devConf.keyConf = &defaultConf[c];
-										break;
-									}
-								}
-							}
-						}
-
-						logMsg("read input device config %s, id %d", devConf.name, devConf.enumId);
-						savedInputDevList.push_back(devConf);
-
-						if(savedInputDevList.size() == INPUT_DEVICE_CONFIGS_HARD_LIMIT)
-						{
-							logWarn("reached input device config hard limit:%d", INPUT_DEVICE_CONFIGS_HARD_LIMIT);
-							break;
-						}
-					}
-					if(size)
-					{
-						// skip leftover bytes
-						logWarn("%d bytes leftover reading input device configs", size);
-					}
+					// read after all other keys since these reference the key configs
+					inputDevConfigsOffset = io.tell();
+					inputDevConfigsSize = size;
 				}
 			}
 		});
+	if(inputDevConfigsOffset != -1 && configFile.seekS(inputDevConfigsOffset) != -1)
+		readInputDeviceConfigs(configFile, inputDevConfigsSize);
 }
 
 void saveConfigFile()
@@ -667,7 +678,7 @@ void saveConfigFile()
 	{
 		fixFilePermissions(EmuApp::supportPath().data());
 	}
-	FileIO configFile;
-	configFile.create(configFilePath.data());
-	writeConfig2(configFile);
+	ConfigImageIO configImage;
+	writeConfig2(configImage);
+	writeConfigFile(configFilePath.data(), configImage.data(), configImage.size());
 }
@@ -0,0 +1,327 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "ConfigStore"
+#include "configFile.hh"
+#include <imagine/fs/FS.hh>
+#include <imagine/logger/logger.h>
+#include <zlib.h>
+#include <algorithm>
+#include <cstring>
+
+static constexpr uint8_t blockHeaderSize = 2;
+static constexpr uint16_t commitBlockSize = 2 + sizeof(uint32_t);
+// don't bother compacting files smaller than this
+static constexpr size_t minCompactBytes = 4096;
+
+struct ConfigLog
+{
+	std::vector<ConfigBlock> blocks{};
+	size_t committedBytes = 0; // header + all committed batches
+	bool hasCommit = false;
+};
+
+template <class T>
+static T readValue(const uint8_t *data)
+{
+	T val;
+	memcpy(&val, data, sizeof(T));
+	return val;
+}
+
+template <class T>
+static void appendValue(std::vector<uint8_t> &buff, T val)
+{
+	auto bytes = (const uint8_t*)&val;
+	buff.insert(buff.end(), bytes, bytes + sizeof(T));
+}
+
+static void appendBlock(std::vector<uint8_t> &buff, uint16_t key, const uint8_t *data, uint16_t size)
+{
+	appendValue<uint16_t>(buff, 2 + size);
+	appendValue<uint16_t>(buff, key);
+	buff.insert(buff.end(), data, data + size);
+}
+
+static auto findBlock(std::vector<ConfigBlock> &blocks, uint16_t key)
+{
+	return std::find_if(blocks.begin(), blocks.end(), [&](const ConfigBlock &b){ return b.key == key; });
+}
+
+static void applyBlock(std::vector<ConfigBlock> &blocks, ConfigBlock block, bool remove)
+{
+	if(auto it = findBlock(blocks, block.key);
+		it != blocks.end())
+	{
+		blocks.erase(it);
+	}
+	if(!remove)
+		blocks.push_back(block);
+}
+
+static bool parseConfigLog(const uint8_t *data, size_t size, ConfigLog &log)
+{
+	if(!size || data[0] != blockHeaderSize)
+	{
+		logErr("can't read config with block size %d", size ? data[0] : 0);
+		return false;
+	}
+	struct PendingBlock
+	{
+		ConfigBlock block;
+		bool remove;
+	};
+	std::vector<PendingBlock> pending{};
+	size_t pos = 1, batchStart = 1;
+	while(size - pos >= 2)
+	{
+		auto blockPos = pos;
+		auto blockSize = readValue<uint16_t>(&data[blockPos]);
+		if(!blockSize)
+		{
+			logMsg("invalid 0 size block, skipping rest of config");
+			break;
+		}
+		if(blockSize > size - blockPos - 2)
+		{
+			logErr("size of key exceeds rest of file, skipping rest of config");
+			break;
+		}
+		pos += 2 + blockSize;
+		if(blockSize < 2)
+		{
+			logMsg("skipping %d byte block", blockSize);
+			continue;
+		}
+		auto key = readValue<uint16_t>(&data[blockPos + 2]);
+		if(key == CFGKEY_COMMIT)
+		{
+			if(blockSize != commitBlockSize ||
+				readValue<uint32_t>(&data[blockPos + 4]) != crc32(0, &data[batchStart], blockPos - batchStart))
+			{
+				logErr("invalid commit block at offset %zu, skipping rest of config", blockPos);
+				break;
+			}
+			for(auto &p : pending)
+			{
+				applyBlock(log.blocks, p.block, p.remove);
+			}
+			pending.clear();
+			log.hasCommit = true;
+			log.committedBytes = batchStart = pos;
+			continue;
+		}
+		pending.push_back({{key, uint16_t(blockSize - 2), off_t(blockPos + 4)}, blockSize == 2});
+	}
+	if(!log.hasCommit)
+	{
+		// written in one piece, either an image or a file from before the log format
+		for(auto &p : pending)
+		{
+			applyBlock(log.blocks, p.block, p.remove);
+		}
+		log.committedBytes = pos;
+	}
+	else if(pending.size())
+	{
+		logWarn("ignoring %zu uncommitted blocks", pending.size());
+	}
+	return true;
+}
+
+bool readConfigIndex(IO &io, std::vector<ConfigBlock> &blocks)
+{
+	auto buff = io.constBufferView();
+	if(!buff)
+		return false;
+	ConfigLog log;
+	if(!parseConfigLog((const uint8_t*)buff.data(), buff.size(), log))
+		return false;
+	blocks = std::move(log.blocks);
+	return true;
+}
+
+static void appendCommitBlock(std::vector<uint8_t> &buff, const uint8_t *batch, size_t batchSize)
+{
+	// batch may point into buff, so compute the CRC before appending
+	uint32_t crc = crc32(0, batch, batchSize);
+	appendValue<uint16_t>(buff, commitBlockSize);
+	appendValue<uint16_t>(buff, CFGKEY_COMMIT);
+	appendValue<uint32_t>(buff, crc);
+}
+
+static bool compactConfigFile(const char *path, const uint8_t *image, size_t imageSize)
+{
+	auto tmpPath = FS::makePathStringPrintf("%s.tmp", path);
+	FileIO tmpFile;
+	if(auto ec = tmpFile.create(tmpPath.data());
+		ec)
+	{
+		logErr("error creating %s", tmpPath.data());
+		return false;
+	}
+	std::vector<uint8_t> commit{};
+	appendCommitBlock(commit, image + 1, imageSize - 1);
+	if(tmpFile.write(image, imageSize) != (ssize_t)imageSize ||
+		tmpFile.write(commit.data(), commit.size()) != (ssize_t)commit.size())
+	{
+		logErr("error writing %s", tmpPath.data());
+		tmpFile.close();
+		FS::remove(tmpPath);
+		return false;
+	}
+	tmpFile.sync();
+	tmpFile.close();
+	std::error_code ec{};
+	FS::rename(tmpPath.data(), path, ec);
+	if(ec)
+	{
+		logErr("error renaming %s to %s", tmpPath.data(), path);
+		FS::remove(tmpPath);
+		return false;
+	}
+	logMsg("wrote compacted config:%s (%zu bytes)", path, imageSize + commit.size());
+	return true;
+}
+
+bool writeConfigFile(const char *path, const void *imageData, size_t imageSize)
+{
+	auto image = (const uint8_t*)imageData;
+	ConfigLog imageLog;
+	if(!parseConfigLog(image, imageSize, imageLog))
+		return false;
+	ConfigLog fileLog;
+	std::vector<uint8_t> batch{};
+	size_t liveBytes = 1;
+	{
+		FileIO file;
+		IG::ConstBufferView fileData{};
+		if(!file.open(path, IO::AccessHint::ALL))
+		{
+			fileData = file.constBufferView();
+		}
+		if(!fileData || !parseConfigLog((const uint8_t*)fileData.data(), fileData.size(), fileLog)
+			|| !fileLog.hasCommit)
+		{
+			// missing, unreadable, or from before the log format
+			return compactConfigFile(path, image, imageSize);
+		}
+		auto fileBytes = (const uint8_t*)fileData.data();
+		for(auto &b : imageLog.blocks)
+		{
+			liveBytes += 4 + b.size;
+			if(auto it = findBlock(fileLog.blocks, b.key);
+				it != fileLog.blocks.end() && it->size == b.size
+				&& !memcmp(&fileBytes[it->offset], &image[b.offset], b.size))
+			{
+				continue;
+			}
+			appendBlock(batch, b.key, &image[b.offset], b.size);
+		}
+		for(auto &b : fileLog.blocks)
+		{
+			if(findBlock(imageLog.blocks, b.key) == imageLog.blocks.end())
+			{
+				appendBlock(batch, b.key, nullptr, 0);
+			}
+		}
+	}
+	if(batch.empty())
+	{
+		logMsg("config:%s unchanged", path);
+		return true;
+	}
+	auto logBytes = fileLog.committedBytes + batch.size() + 2 + commitBlockSize;
+	if(logBytes > minCompactBytes && logBytes > liveBytes * 2)
+	{
+		return compactConfigFile(path, image, imageSize);
+	}
+	appendCommitBlock(batch, batch.data(), batch.size());
+	FileIO file;
+	if(auto ec = file.open(path, IO::AccessHint::NORMAL, IO::OPEN_WRITE);
+		ec)
+	{
+		logErr("error opening %s for writing", path);
+		return false;
+	}
+	// drop any uncommitted blocks left from an interrupted write
+	file.truncate(fileLog.committedBytes);
+	file.seekS(fileLog.committedBytes);
+	if(file.write(batch.data(), batch.size()) != (ssize_t)batch.size())
+	{
+		logErr("error appending to %s", path);
+		return false;
+	}
+	logMsg("appended %zu bytes to config:%s", batch.size(), path);
+	return true;
+}
+
+ssize_t ConfigImageIO::read(void *buff, size_t bytes, std::error_code *ecOut)
+{
+	bytes = std::min(bytes, this->buff.size() - pos);
+	memcpy(buff, &this->buff[pos], bytes);
+	pos += bytes;
+	return bytes;
+}
+
+ssize_t ConfigImageIO::write(const void *buff, size_t bytes, std::error_code *ecOut)
+{
+	if(pos + bytes > this->buff.size())
+		this->buff.resize(pos + bytes);
+	memcpy(&this->buff[pos], buff, bytes);
+	pos += bytes;
+	return bytes;
+}
+
+off_t ConfigImageIO::seek(off_t offset, SeekMode mode, std::error_code *ecOut)
+{
+	off_t newPos;
+	switch(mode)
+	{
+		case SEEK_SET: newPos = offset; break;
+		case SEEK_CUR: newPos = pos + offset; break;
+		case SEEK_END: newPos = buff.size() + offset; break;
+		default: newPos = -1;
+	}
+	if(newPos < 0 || newPos > (off_t)buff.size())
+	{
+		if(ecOut)
+			*ecOut = {EINVAL, std::system_category()};
+		return -1;
+	}
+	pos = newPos;
+	return pos;
+}
+
+void ConfigImageIO::close()
+{
+	buff.clear();
+	pos = 0;
+}
+
+size_t ConfigImageIO::size()
+{
+	return buff.size();
+}
+
+bool ConfigImageIO::eof()
+{
+	return pos >= buff.size();
+}
+
+ConfigImageIO::operator bool() const
+{
+	return true;
+}
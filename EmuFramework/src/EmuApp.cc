@@ -35,6 +35,7 @@
 #include "privateInput.hh"
 #include "configFile.hh"
 #include "EmuSystemTask.hh"
+#include "StartupTrace.hh"
 
 class ExitConfirmAlertView : public AlertView
 {
@@ -131,6 +132,11 @@ extern EmuViewController &emuViewController()
 	return *emuViewControllerPtr;
 }
 
+bool hasEmuViewController()
+{
+	return (bool)emuViewControllerPtr;
+}
+
 void setCPUNeedsLowLatency(bool needed)
 {
 	#ifdef __ANDROID__
@@ -188,12 +194,26 @@ void EmuApp::showExitAlert(ViewAttachParams attach, Input::Event e)
 
 static const char *parseCmdLineArgs(int argc, char** argv)
 {
-	if(argc < 2)
+	const char *launchGame{};
+	for(int i = 1; i < argc; i++)
 	{
-		return nullptr;
+		if(string_equal(argv[i], "--log-audio-stats"))
+		{
+			logMsg("logging audio stats");
+			emuAudio.setLogStats(true);
+		}
+		else if(constexpr char traceArg[] = "--startup-trace=";
+			!strncmp(argv[i], traceArg, sizeof(traceArg) - 1))
+		{
+			startupTrace.setOutputPath(argv[i] + sizeof(traceArg) - 1);
+			logMsg("writing startup trace to: %s", argv[i] + sizeof(traceArg) - 1);
+		}
+		else if(!launchGame)
+		{
+			launchGame = argv[i];
+			logMsg("starting game from command line: %s", launchGame);
+		}
 	}
-	auto launchGame = argv[1];
-	logMsg("starting game from command line: %s", launchGame);
 	return launchGame;
 }
 
@@ -241,18 +261,21 @@ void mainInitCommon(int argc, char** argv)
 	initOptions();
 	auto launchGame = parseCmdLineArgs(argc, argv);
 	loadConfigFile();
+	startupTrace.mark("config");
 	if(auto err = EmuSystem::onOptionsLoaded();
 		err)
 	{
 		Base::exitWithErrorMessagePrintf(-1, "%s", err->what());
 		return;
 	}
+	startupTrace.mark("core options");
 	AudioManager::setMusicVolumeControlHint();
 	AudioManager::startSession();
 	if(optionSoundRate > optionSoundRate.defaultVal)
 		optionSoundRate.reset();
 	emuAudio.setAddSoundBuffersOnUnderrun(optionAddSoundBuffersOnUnderrun);
 	applyOSNavStyle(false);
+	startupTrace.mark("audio session");
 
 	{
 		auto [r, err] = Gfx::Renderer::makeConfiguredRenderer({windowPixelFormat()});
@@ -265,6 +288,7 @@ void mainInitCommon(int argc, char** argv)
 			optionVideoImageBuffers.resetToConst();
 		rendererPtr = std::make_unique<Gfx::Renderer>(std::move(r));
 	}
+	startupTrace.mark("renderer");
 	auto &renderer = *rendererPtr;
 	if(optionTextureBufferMode.val)
 	{
@@ -283,21 +307,25 @@ void mainInitCommon(int argc, char** argv)
 	auto &emuVideoLayer = *emuVideoLayerPtr;
 	emuVideoLayer.setOverlayIntensity(optionOverlayEffectLevel/100.);
 	emuViewControllerPtr = std::make_unique<EmuViewController>(mainWin, renderer, renderer.task(), vController, emuVideoLayer, emuSystemTask);
+	startupTrace.mark("video & view controller");
 
 	auto compiled = renderer.makeCommonProgram(Gfx::CommonProgram::TEX_ALPHA);
 	compiled |= renderer.makeCommonProgram(Gfx::CommonProgram::NO_TEX);
 	compiled |= View::compileGfxPrograms(renderer);
 	if(compiled)
 		renderer.autoReleaseShaderCompiler();
+	startupTrace.mark("shaders");
 
 	View::defaultFace = Gfx::GlyphTextureSet::makeSystem(renderer, IG::FontSettings{});
 	View::defaultBoldFace = Gfx::GlyphTextureSet::makeBoldSystem(renderer, IG::FontSettings{});
+	startupTrace.mark("fonts");
 
 	#ifdef CONFIG_INPUT_ANDROID_MOGA
 	if(optionMOGAInputSystem)
 		Input::initMOGA(false);
 	#endif
 	updateInputDevices();
+	startupTrace.mark("input devices");
 
 	Base::addOnResume(
 		[](bool focused)
@@ -418,6 +446,7 @@ void mainInitCommon(int argc, char** argv)
 	renderer.setWindowValidOrientations(win, optionMenuOrientation);
 	vController.setWindow(win);
 	initVControls(vController, renderer);
+	startupTrace.mark("window & on-screen controls");
 
 	#if defined CONFIG_BASE_ANDROID
 	if(!Base::apkSignatureIsConsistent())
@@ -437,6 +466,7 @@ void mainInitCommon(int argc, char** argv)
 	win.show();
 	win.postDraw();
 	EmuApp::onMainWindowCreated(viewAttach, Input::defaultEvent());
+	startupTrace.mark("views");
 	if(launchGame)
 	{
 		emuViewController().handleOpenFileCommand(launchGame);
@@ -505,8 +535,18 @@ void runBenchmarkOneShot()
 {
 	logMsg("starting benchmark");
 	IG::FloatSeconds time = EmuSystem::benchmark(emuVideo);
+	auto [saveTime, loadTime] = EmuSystem::benchmarkStates();
 	emuViewController().closeSystem(false);
 	logMsg("done in: %f", time.count());
+	if(saveTime.count())
+	{
+		auto saveUSecs = std::chrono::duration_cast<IG::Microseconds>(saveTime).count();
+		auto loadUSecs = std::chrono::duration_cast<IG::Microseconds>(loadTime).count();
+		logMsg("state save:%lldus load:%lldus", (long long)saveUSecs, (long long)loadUSecs);
+		EmuApp::printfMessage(2, 0, "%.2f fps, state save %lldus load %lldus", double(180.)/time.count(),
+			(long long)saveUSecs, (long long)loadUSecs);
+		return;
+	}
 	EmuApp::printfMessage(2, 0, "%.2f fps", double(180.)/time.count());
 }
 
@@ -870,27 +910,24 @@ void EmuApp::saveSessionOptions()
 	if(!EmuSystem::sessionOptionsSet)
 		return;
 	auto configFilePath = sessionConfigPath();
-	FileIO configFile;
-	if(auto ec = configFile.create(configFilePath.data());
-		ec)
-	{
-		logMsg("error creating session config file:%s", configFilePath.data());
-		return;
-	}
-	writeConfigHeader(configFile);
-	EmuSystem::writeSessionConfig(configFile);
+	ConfigImageIO configImage;
+	writeConfigHeader(configImage);
+	EmuSystem::writeSessionConfig(configImage);
 	EmuSystem::sessionOptionsSet = false;
-	if(configFile.size() == 1)
+	if(configImage.size() == 1)
 	{
 		// delete file if only header was written
-		configFile.close();
 		FS::remove(configFilePath);
 		logMsg("deleted empty session config file:%s", configFilePath.data());
 	}
-	else
+	else if(writeConfigFile(configFilePath.data(), configImage.data(), configImage.size()))
 	{
 		logMsg("wrote session config file:%s", configFilePath.data());
 	}
+	else
+	{
+		logMsg("error writing session config file:%s", configFilePath.data());
+	}
 }
 
 void EmuApp::loadSessionOptions()
@@ -943,12 +980,16 @@ namespace Base
 
 void onInit(int argc, char** argv)
 {
+	startupTrace.start();
 	if(auto err = EmuSystem::onInit();
 		err)
 	{
 		Base::exitWithErrorMessagePrintf(-1, "%s", err->what());
 		return;
 	}
+	startupTrace.mark("core init");
+	if(runRegressionFromCmdLine(argc, argv))
+		return;
 	mainInitCommon(argc, argv);
 }
 
@@ -18,50 +18,104 @@
 #include <emuframework/EmuSystem.hh>
 #include "private.hh"
 #include <imagine/audio/AudioManager.hh>
+#include <imagine/base/Timer.hh>
 #include <imagine/logger/logger.h>
 
-struct AudioStats
+static Base::Timer audioStatsTimer{"audioStatsTimer"};
+
+void EmuAudio::updateCallbackStats(uint32_t frames)
 {
-	constexpr AudioStats() {}
-	unsigned underruns = 0;
-	unsigned overruns = 0;
-	std::atomic_uint callbacks{};
-	std::atomic_uint callbackBytes{};
+	auto now = IG::steadyClockTimestamp();
+	if(lastCallbackTime.count())
+	{
+		uint32_t period = std::chrono::duration_cast<IG::Microseconds>(now - lastCallbackTime).count();
+		if(period < minCallbackUSecs.load(std::memory_order_relaxed))
+			minCallbackUSecs.store(period, std::memory_order_relaxed);
+		if(period > maxCallbackUSecs.load(std::memory_order_relaxed))
+			maxCallbackUSecs.store(period, std::memory_order_relaxed);
+		callbackUSecsSum.fetch_add(period, std::memory_order_relaxed);
+		callbackPeriods.fetch_add(1, std::memory_order_relaxed);
+	}
+	lastCallbackTime = now;
+	callbacks.fetch_add(1, std::memory_order_relaxed);
+	callbackFrames.fetch_add(frames, std::memory_order_relaxed);
+	lastCallbackFrames.store(frames, std::memory_order_relaxed);
+}
 
-	void reset()
+EmuAudio::Stats EmuAudio::stats() const
+{
+	auto inputFormat = format();
+	Stats s{};
+	s.queuedFrames = framesWritten();
+	s.targetFrames = inputFormat.bytesToFrames(targetBufferFillBytes);
+	s.capacityFrames = framesCapacity();
+	s.underruns = underruns.load(std::memory_order_relaxed);
+	s.overruns = overruns.load(std::memory_order_relaxed);
+	s.callbacks = callbacks.load(std::memory_order_relaxed);
+	s.callbackFrames = callbackFrames.load(std::memory_order_relaxed);
+	if(auto periods = callbackPeriods.load(std::memory_order_relaxed);
+		periods)
 	{
-		underruns = overruns = 0;
-		callbacks = 0;
-		callbackBytes = 0;
+		s.avgCallbackPeriod = IG::Microseconds(callbackUSecsSum.load(std::memory_order_relaxed) / periods);
+		s.callbackJitter = IG::Microseconds(maxCallbackUSecs.load(std::memory_order_relaxed) - minCallbackUSecs.load(std::memory_order_relaxed));
 	}
-};
+	s.latency = IG::Microseconds((uint64_t)(s.queuedFrames + lastCallbackFrames.load(std::memory_order_relaxed)) * 1000000 / rate);
+	return s;
+}
 
-#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-static AudioStats audioStats{};
-static Base::Timer audioStatsTimer{"audioStatsTimer"};
-#endif
+void EmuAudio::resetStats()
+{
+	underruns.store(0, std::memory_order_relaxed);
+	overruns.store(0, std::memory_order_relaxed);
+	callbacks.store(0, std::memory_order_relaxed);
+	callbackPeriods.store(0, std::memory_order_relaxed);
+	callbackFrames.store(0, std::memory_order_relaxed);
+	minCallbackUSecs.store(UINT32_MAX, std::memory_order_relaxed);
+	maxCallbackUSecs.store(0, std::memory_order_relaxed);
+	callbackUSecsSum.store(0, std::memory_order_relaxed);
+}
 
-static void startAudioStats(IG::Audio::Format format)
+void EmuAudio::setLogStats(bool on)
 {
-	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-	audioStats.reset();
-	audioStatsTimer.run(IG::Seconds(1), IG::Seconds(1), {},
-		[format]()
+	logStats = on;
+}
+
+void EmuAudio::setCapture(CaptureDelegate del)
+{
+	capture = del;
+}
+
+void EmuAudio::startStats()
+{
+	resetStats();
+	lastCallbackTime = {};
+	#ifndef CONFIG_EMUFRAMEWORK_AUDIO_STATS
+	if(!logStats)
+		return;
+	#endif
+	audioStatsTimer.runIn(IG::Seconds(1), IG::Seconds(1), {},
+		[this]()
 		{
-			auto frames = format.bytesToFrames(audioStats.callbackBytes);
-			emuViewController.updateEmuAudioStats(audioStats.underruns, audioStats.overruns,
-				audioStats.callbacks, frames / (double)audioStats.callbacks, frames);
-			audioStats.callbacks = 0;
-			audioStats.callbackBytes = 0;
+			auto s = stats();
+			if(logStats)
+			{
+				logMsg("queued:%u/%u frames (target %u) latency:%lldus callbacks:%u frames:%u period:%lldus jitter:%lldus underruns:%u overruns:%u",
+					s.queuedFrames, s.capacityFrames, s.targetFrames, (long long)s.latency.count(),
+					s.callbacks, s.callbackFrames, (long long)s.avgCallbackPeriod.count(), (long long)s.callbackJitter.count(),
+					s.underruns, s.overruns);
+			}
+			#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
+			emuViewController().updateEmuAudioStats(s);
+			#endif
+			resetStats();
 		});
-	#endif
 }
 
-static void stopAudioStats()
+void EmuAudio::stopStats()
 {
+	audioStatsTimer.cancel();
 	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-	audioStatsTimer.deinit();
-	clearEmuAudioStats();
+	emuViewController().clearEmuAudioStats();
 	#endif
 }
 
@@ -166,10 +220,7 @@ void EmuAudio::start(IG::Microseconds targetBufferFillUSecs, IG::Microseconds bu
 			[this, outputSampleFormat = outputFormat.sample, inputSampleFormat = inputFormat.sample, channels = outputFormat.channels](void *samples, unsigned frames)
 			{
 				IG::Audio::Format outputFormat{{}, outputSampleFormat, channels};
-				#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-				audioStats.callbacks++;
-				audioStats.callbackBytes += bytes;
-				#endif
+				updateCallbackStats(frames);
 				if(audioWriteState == AudioWriteState::ACTIVE)
 				{
 					IG::Audio::Format inputFormat = {{}, inputSampleFormat, channels};
@@ -182,7 +233,7 @@ void EmuAudio::start(IG::Microseconds targetBufferFillUSecs, IG::Microseconds bu
 						auto padFrames = frames - framesToRead;
 						std::fill_n(frameEndAddr, outputFormat.framesToBytes(padFrames), 0);
 						//logMsg("underrun, %d bytes ready out of %d", bytesReady, bytes);
-						auto now = IG::steadyClockTimestamp();
+						auto now = lastCallbackTime;
 						if(now - lastUnderrunTime < IG::Seconds(1))
 						{
 							//logWarn("multiple underruns within a short time");
@@ -193,9 +244,7 @@ void EmuAudio::start(IG::Microseconds targetBufferFillUSecs, IG::Microseconds bu
 							audioWriteState = AudioWriteState::UNDERRUN;
 						}
 						lastUnderrunTime = now;
-						#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-						audioStats.underruns++;
-						#endif
+						underruns.fetch_add(1, std::memory_order_relaxed);
 					}
 					return true;
 				}
@@ -207,12 +256,12 @@ void EmuAudio::start(IG::Microseconds targetBufferFillUSecs, IG::Microseconds bu
 			}
 		};
 		outputConf.setWantedLatencyHint({});
-		startAudioStats(inputFormat);
+		startStats();
 		audioStream->open(outputConf);
 	}
 	else
 	{
-		startAudioStats(inputFormat);
+		startStats();
 		if(shouldStartAudioWrites())
 		{
 			if(Config::DEBUG_BUILD)
@@ -229,7 +278,7 @@ void EmuAudio::start(IG::Microseconds targetBufferFillUSecs, IG::Microseconds bu
 
 void EmuAudio::stop()
 {
-	stopAudioStats();
+	stopStats();
 	audioWriteState = AudioWriteState::BUFFER;
 	if(audioStream)
 		audioStream->close();
@@ -247,7 +296,7 @@ void EmuAudio::flush()
 {
 	if(unlikely(!audioStream))
 		return;
-	stopAudioStats();
+	stopStats();
 	audioWriteState = AudioWriteState::BUFFER;
 	if(audioStream)
 		audioStream->flush();
@@ -256,6 +305,11 @@ void EmuAudio::flush()
 
 void EmuAudio::writeFrames(const void *samples, uint32_t framesToWrite)
 {
+	if(unlikely(capture))
+	{
+		capture(samples, framesToWrite);
+		return;
+	}
 	assumeExpr(rBuff);
 	auto inputFormat = format();
 	switch(audioWriteState)
@@ -296,9 +350,7 @@ void EmuAudio::writeFrames(const void *samples, uint32_t framesToWrite)
 	else
 	{
 		logMsg("overrun, only %d out of %d bytes free", freeBytes, bytes);
-		#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-		audioStats.overruns++;
-		#endif
+		overruns.fetch_add(1, std::memory_order_relaxed);
 		auto freeFrames = inputFormat.bytesToFrames(freeBytes);
 		simpleResample(rBuff.writeAddr(), freeFrames, samples, sampleFrames, inputFormat);
 		rBuff.commitWrite(freeBytes);
@@ -24,6 +24,8 @@
 #include <emuframework/InputManagerView.hh>
 #include "private.hh"
 #include "privateInput.hh"
+#include "InputMovie.hh"
+#include "InputLatch.hh"
 #include <cstdlib>
 
 struct RelPtr  // for Android trackball
@@ -199,6 +201,12 @@ void initVControls(Gfx::Renderer &r) {}
 
 #endif // CONFIG_EMUFRAMEWORK_VCONTROLS
 
+void dispatchInputAction(uint state, uint emuKey)
+{
+	if(inputMovie.recordAction(state, emuKey) && !inputLatch.queueAction(state, emuKey))
+		EmuSystem::handleInputAction(state, emuKey);
+}
+
 void processRelPtr(Input::Event e)
 {
 	using namespace IG;
@@ -206,7 +214,7 @@ void processRelPtr(Input::Event e)
 	{
 		//logMsg("reversed trackball X direction");
 		relPtr.x = e.pos().x;
-		EmuSystem::handleInputAction(Input::RELEASED, relPtr.xAction);
+		dispatchInputAction(Input::RELEASED, relPtr.xAction);
 	}
 	else
 		relPtr.x += e.pos().x;
@@ -214,14 +222,14 @@ void processRelPtr(Input::Event e)
 	if(e.pos().x)
 	{
 		relPtr.xAction = EmuSystem::translateInputAction(e.pos().x > 0 ? EmuControls::systemKeyMapStart+1 : EmuControls::systemKeyMapStart+3);
-		EmuSystem::handleInputAction(Input::PUSHED, relPtr.xAction);
+		dispatchInputAction(Input::PUSHED, relPtr.xAction);
 	}
 
 	if(relPtr.y != 0 && sign(relPtr.y) != sign(e.pos().y))
 	{
 		//logMsg("reversed trackball Y direction");
 		relPtr.y = e.pos().y;
-		EmuSystem::handleInputAction(Input::RELEASED, relPtr.yAction);
+		dispatchInputAction(Input::RELEASED, relPtr.yAction);
 	}
 	else
 		relPtr.y += e.pos().y;
@@ -229,7 +237,7 @@ void processRelPtr(Input::Event e)
 	if(e.pos().y)
 	{
 		relPtr.yAction = EmuSystem::translateInputAction(e.pos().y > 0 ? EmuControls::systemKeyMapStart+2 : EmuControls::systemKeyMapStart);
-		EmuSystem::handleInputAction(Input::PUSHED, relPtr.yAction);
+		dispatchInputAction(Input::PUSHED, relPtr.yAction);
 	}
 
 	//logMsg("trackball event %d,%d, rel ptr %d,%d", e.x, e.y, relPtr.x, relPtr.y);
@@ -253,12 +261,12 @@ void TurboInput::update()
 			if(clock == 0)
 			{
 				//logMsg("turbo push for player %d, action %d", e.player, e.action);
-				EmuSystem::handleInputAction(Input::PUSHED, e.action);
+				dispatchInputAction(Input::PUSHED, e.action);
 			}
 			else if(clock == turboFrames/2)
 			{
 				//logMsg("turbo release for player %d, action %d", e.player, e.action);
-				EmuSystem::handleInputAction(Input::RELEASED, e.action);
+				dispatchInputAction(Input::RELEASED, e.action);
 			}
 		}
 	}
@@ -279,13 +287,13 @@ void commonUpdateInput()
 	{
 		relPtr.x = applyRelPointerDecel(relPtr.x);
 		if(!relPtr.x)
-			EmuSystem::handleInputAction(Input::RELEASED, relPtr.xAction);
+			dispatchInputAction(Input::RELEASED, relPtr.xAction);
 	}
 	if(relPtr.y)
 	{
 		relPtr.y = applyRelPointerDecel(relPtr.y);
 		if(!relPtr.y)
-			EmuSystem::handleInputAction(Input::RELEASED, relPtr.yAction);
+			dispatchInputAction(Input::RELEASED, relPtr.yAction);
 	}
 #endif
 }
@@ -606,6 +614,7 @@ void KeyMapping::buildAll()
 		{
 			logMsg("no keys in mapping");
 			inputDevActionTablePtr[0] = nullptr;
+			inputLatch.update();
 			return;
 		}
 		logMsg("allocating key mapping with %d keys", totalKeys);
@@ -643,12 +652,14 @@ void KeyMapping::buildAll()
 
 		i++;
 	}
+	inputLatch.update();
 }
 
 void KeyMapping::free()
 {
 	inputDevActionTable.resize(0);
 	inputDevActionTablePtr.reset();
+	inputLatch.update();
 }
 
 KeyMapping::operator bool() const
@@ -278,7 +278,7 @@ bool EmuInputView::inputEvent(Input::Event e)
 								turboActions.removeEvent(sysAction);
 							}
 						}
-						EmuSystem::handleInputAction(e.state(), sysAction);
+						dispatchInputAction(e.state(), sysAction);
 					}
 				}
 			}
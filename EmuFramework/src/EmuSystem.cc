@@ -27,9 +27,12 @@
 #include <imagine/util/ScopeGuard.hh>
 #include <algorithm>
 #include <string>
+#include <vector>
 #include "private.hh"
 #include "privateInput.hh"
 #include "EmuTiming.hh"
+#include "InputMovie.hh"
+#include "InputLatch.hh"
 
 EmuSystem::State EmuSystem::state = EmuSystem::State::OFF;
 FS::PathString EmuSystem::gamePath_{};
@@ -292,6 +295,7 @@ void EmuSystem::closeRuntimeSystem(bool allowAutosaveState)
 			EmuApp::saveAutoState();
 		EmuApp::saveSessionOptions();
 		logMsg("closing game %s", gameName_.data());
+		inputMovie.stop();
 		closeSystem();
 		cancelAutoSaveStateTimer();
 		state = State::OFF;
@@ -332,12 +336,38 @@ IG::Time EmuSystem::benchmark(EmuVideo &video)
 	return after-now;
 }
 
+std::pair<IG::Time, IG::Time> EmuSystem::benchmarkStates()
+{
+	auto size = stateSize();
+	if(!size)
+		return {};
+	std::vector<uint8_t> buff(size);
+	// first round trip warms up any buffers the core reuses
+	if(saveStateToMemory(buff.data(), size) || loadStateFromMemory(buff.data(), size))
+		return {};
+	constexpr uint rounds = 60;
+	IG::Time saveTime{}, loadTime{};
+	iterateTimes(rounds, i)
+	{
+		auto start = IG::steadyClockTimestamp();
+		saveStateToMemory(buff.data(), size);
+		auto saved = IG::steadyClockTimestamp();
+		loadStateFromMemory(buff.data(), size);
+		auto loaded = IG::steadyClockTimestamp();
+		saveTime += saved - start;
+		loadTime += loaded - saved;
+	}
+	return {saveTime / rounds, loadTime / rounds};
+}
+
 void EmuSystem::skipFrames(EmuSystemTask *task, uint32_t frames, EmuAudio *audio)
 {
 	assumeExpr(gameIsRunning());
 	iterateTimes(frames, i)
 	{
 		turboActions.update();
+		inputLatch.applyQueuedActions();
+		inputMovie.onFrame();
 		runFrame(task, nullptr, audio);
 	}
 }
@@ -624,6 +654,18 @@ void EmuSystem::sessionOptionSet()
 
 [[gnu::weak]] void EmuSystem::saveBackupMem() {}
 
+[[gnu::weak]] size_t EmuSystem::stateSize() { return 0; }
+
+[[gnu::weak]] EmuSystem::Error EmuSystem::saveStateToMemory(void *buff, size_t size)
+{
+	return makeError("In-memory states not supported");
+}
+
+[[gnu::weak]] EmuSystem::Error EmuSystem::loadStateFromMemory(const void *buff, size_t size)
+{
+	return makeError("In-memory states not supported");
+}
+
 [[gnu::weak]] void EmuSystem::savePathChanged() {}
 
 [[gnu::weak]] uint EmuSystem::multiresVideoBaseX() { return 0; }
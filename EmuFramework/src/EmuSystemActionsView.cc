@@ -27,6 +27,7 @@
 #include <emuframework/InputManagerView.hh>
 #include <emuframework/BundledGamesView.hh>
 #include "private.hh"
+#include "InputMovie.hh"
 
 class ResetAlertView : public BaseAlertView
 {
@@ -81,6 +82,11 @@ static std::array<char, 16> makeStateSlotStr(int slot)
 	return string_makePrintf<16>("State Slot (%c)", EmuSystem::saveSlotChar(slot));
 }
 
+static const char *recordMovieStr()
+{
+	return inputMovie.mode() == InputMovie::Mode::OFF ? "Record Input Movie" : "Stop Input Movie";
+}
+
 void EmuSystemActionsView::onShow()
 {
 	TableView::onShow();
@@ -91,6 +97,11 @@ void EmuSystemActionsView::onShow()
 	loadState.setActive(EmuSystem::gameIsRunning() && EmuSystem::stateExists(EmuSystem::saveStateSlot));
 	stateSlot.compile(makeStateSlotStr(EmuSystem::saveStateSlot).data(), renderer(), projP);
 	screenshot.setActive(EmuSystem::gameIsRunning());
+	recordMovie.compile(recordMovieStr(), renderer(), projP);
+	recordMovie.setActive(EmuSystem::gameIsRunning());
+	bool movieExists = EmuSystem::gameIsRunning() && FS::exists(InputMovie::makeDefaultPath());
+	playMovie.setActive(movieExists);
+	benchmarkMovie.setActive(movieExists);
 	#ifdef CONFIG_EMUFRAMEWORK_ADD_LAUNCHER_ICON
 	addLauncherIcon.setActive(EmuSystem::gameIsRunning());
 	#endif
@@ -113,6 +124,10 @@ void EmuSystemActionsView::loadStandardItems()
 	item.emplace_back(&addLauncherIcon);
 	#endif
 	item.emplace_back(&screenshot);
+	recordMovie.setName(recordMovieStr());
+	item.emplace_back(&recordMovie);
+	item.emplace_back(&playMovie);
+	item.emplace_back(&benchmarkMovie);
 	item.emplace_back(&resetSessionOptions);
 	item.emplace_back(&close);
 }
@@ -267,6 +282,65 @@ EmuSystemActionsView::EmuSystemActionsView(ViewAttachParams attach, bool customM
 			pushAndShowModal(std::move(ynAlertView), e);
 		}
 	},
+	recordMovie
+	{
+		nullptr,
+		[this]()
+		{
+			if(!EmuSystem::gameIsRunning())
+				return;
+			if(inputMovie.mode() != InputMovie::Mode::OFF)
+			{
+				if(auto err = inputMovie.stop();
+					err)
+				{
+					EmuApp::printfMessage(4, true, "Input Movie: %s", err->what());
+				}
+				recordMovie.compile(recordMovieStr(), renderer(), projP);
+				return;
+			}
+			if(auto err = inputMovie.startRecording(InputMovie::makeDefaultPath().data());
+				err)
+			{
+				EmuApp::printfMessage(4, true, "Input Movie: %s", err->what());
+				return;
+			}
+			emuViewController().showEmulation();
+		}
+	},
+	playMovie
+	{
+		"Play Input Movie",
+		[this](TextMenuItem &item, View &, Input::Event e)
+		{
+			if(!item.active() || !EmuSystem::gameIsRunning())
+				return;
+			if(auto err = inputMovie.startPlayback(InputMovie::makeDefaultPath().data());
+				err)
+			{
+				EmuApp::printfMessage(4, true, "Input Movie: %s", err->what());
+				return;
+			}
+			emuViewController().showEmulation();
+		}
+	},
+	benchmarkMovie
+	{
+		"Benchmark Input Movie",
+		[this](TextMenuItem &item, View &, Input::Event e)
+		{
+			if(!item.active() || !EmuSystem::gameIsRunning())
+				return;
+			if(auto err = inputMovie.startPlayback(InputMovie::makeDefaultPath().data());
+				err)
+			{
+				EmuApp::printfMessage(4, true, "Input Movie: %s", err->what());
+				return;
+			}
+			emuViewController().benchmarkInputMovie();
+			recordMovie.compile(recordMovieStr(), renderer(), projP);
+		}
+	},
 	resetSessionOptions
 	{
 		"Reset Saved Options",
@@ -20,6 +20,8 @@
 #include <emuframework/EmuVideo.hh>
 #include "EmuSystemTask.hh"
 #include "privateInput.hh"
+#include "InputMovie.hh"
+#include "InputLatch.hh"
 
 void EmuSystemTask::start()
 {
@@ -45,6 +47,13 @@ void EmuSystemTask::start()
 					{
 						EmuApp::printScreenshotResult(msg.args.screenshot.num, msg.args.screenshot.success);
 					}
+					bcase Reply::PLAYED_MOVIE:
+					{
+						auto [frames, seconds] = msg.args.movie;
+						logMsg("played %u frames in: %f", frames, seconds);
+						if(seconds)
+							EmuApp::printfMessage(2, false, "%u frames, %.2f fps", frames, frames / seconds);
+					}
 					bdefault:
 					{
 						logErr("unknown reply message:%d", (int)msg.reply);
@@ -89,8 +98,16 @@ void EmuSystemTask::start()
 									EmuSystem::skipFrames(this, frames - 1, audio);
 								}
 								turboActions.update();
+								inputLatch.applyQueuedActions();
+								inputMovie.onFrame();
 								EmuSystem::runFrame(this, video, audio);
 							}
+							bcase Command::RUN_MOVIE:
+							{
+								auto frames = inputMovie.frames();
+								IG::FloatSeconds time = inputMovie.runHeadless(this, msg.args.run.video);
+								sendMovieReply(frames, time);
+							}
 							bcase Command::PAUSE:
 							{
 								//logMsg("got pause command");
@@ -147,6 +164,12 @@ void EmuSystemTask::runFrame(EmuVideo *video, EmuAudio *audio, uint8_t frames, b
 	commandPort.send({Command::RUN_FRAME, video, audio, frames, skipForward});
 }
 
+void EmuSystemTask::runMovie(EmuVideo *video)
+{
+	start();
+	commandPort.send({Command::RUN_MOVIE, video, nullptr, 1});
+}
+
 void EmuSystemTask::sendVideoFormatChangedReply(EmuVideo &video, IG::PixmapDesc desc)
 {
 	replyPort.send({Reply::VIDEO_FORMAT_CHANGED, video, desc}, true);
@@ -156,3 +179,8 @@ void EmuSystemTask::sendScreenshotReply(int num, bool success)
 {
 	replyPort.send({Reply::TOOK_SCREENSHOT, num, success});
 }
+
+void EmuSystemTask::sendMovieReply(uint32_t frames, IG::FloatSeconds time)
+{
+	replyPort.send({Reply::PLAYED_MOVIE, frames, (float)time.count()});
+}
@@ -19,6 +19,7 @@
 #include <imagine/base/CustomEvent.hh>
 #include <imagine/thread/Semaphore.hh>
 #include <imagine/pixmap/PixmapDesc.hh>
+#include <imagine/time/Time.hh>
 
 class EmuVideo;
 class EmuAudio;
@@ -28,7 +29,7 @@ class EmuSystemTask
 public:
 	enum class Command: uint8_t
 	{
-		UNSET, RUN_FRAME, PAUSE, EXIT
+		UNSET, RUN_FRAME, RUN_MOVIE, PAUSE, EXIT
 	};
 
 	struct CommandMessage
@@ -57,7 +58,7 @@ public:
 
 	enum class Reply: uint8_t
 	{
-		UNSET, VIDEO_FORMAT_CHANGED, TOOK_SCREENSHOT
+		UNSET, VIDEO_FORMAT_CHANGED, TOOK_SCREENSHOT, PLAYED_MOVIE
 	};
 
 	struct ReplyMessage
@@ -75,6 +76,11 @@ public:
 				int num;
 				bool success;
 			} screenshot;
+			struct MovieArgs
+			{
+				uint32_t frames;
+				float seconds;
+			} movie;
 		} args{};
 		Reply reply{Reply::UNSET};
 
@@ -86,6 +92,11 @@ public:
 		{
 			args.screenshot = {num, success};
 		}
+		constexpr ReplyMessage(Reply reply, uint32_t frames, float seconds):
+			reply{reply}
+		{
+			args.movie = {frames, seconds};
+		}
 		explicit operator bool() const { return reply != Reply::UNSET; }
 		void setReplySemaphore(IG::Semaphore *semPtr_) { assert(!semPtr); semPtr = semPtr_; };
 	};
@@ -94,8 +105,11 @@ public:
 	void pause();
 	void stop();
 	void runFrame(EmuVideo *video, EmuAudio *audio, uint8_t frames, bool skipForward = false);
+	// plays the loaded input movie at full speed without blocking the caller
+	void runMovie(EmuVideo *video);
 	void sendVideoFormatChangedReply(EmuVideo &video, IG::PixmapDesc desc);
 	void sendScreenshotReply(int num, bool success);
+	void sendMovieReply(uint32_t frames, IG::FloatSeconds time);
 
 private:
 	Base::MessagePort<CommandMessage> commandPort{"EmuSystemTask Command"};
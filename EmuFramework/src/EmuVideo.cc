@@ -22,6 +22,44 @@
 #include <imagine/gfx/RendererCommands.hh>
 #include <imagine/logger/logger.h>
 #include "EmuSystemTask.hh"
+#include <cstring>
+
+// multiply-rotate hash of a frame's pixels in the style of xxHash64, the four
+// lanes are independent so the compiler can keep them in vector registers
+static uint64_t frameHash(IG::Pixmap pix)
+{
+	constexpr uint64_t prime1 = 0x9E3779B185EBCA87ull, prime2 = 0xC2B2AE3D27D4EB4Full;
+	auto rotl = [](uint64_t x, int r){ return (x << r) | (x >> (64 - r)); };
+	uint64_t lane[4]{prime1 + prime2, prime2, 0, -prime1};
+	uint64_t tail = pix.w() * (uint64_t)pix.h();
+	auto lineBytes = pix.format().pixelBytes(pix.w());
+	auto lines = pix.isPadded() ? pix.h() : 1;
+	if(!pix.isPadded())
+		lineBytes *= pix.h();
+	for(uint32_t y = 0; y < lines; y++)
+	{
+		auto data = (const char*)pix.pixel({0, (int)y});
+		size_t i = 0;
+		for(; i + 32 <= lineBytes; i += 32)
+		{
+			for(int l = 0; l < 4; l++)
+			{
+				uint64_t v;
+				memcpy(&v, &data[i + l * 8], 8);
+				lane[l] = rotl(lane[l] + v * prime2, 31) * prime1;
+			}
+		}
+		for(; i < lineBytes; i++)
+		{
+			tail = rotl(tail ^ (uint8_t)data[i] * prime1, 11) * prime2;
+		}
+	}
+	uint64_t h = rotl(lane[0], 1) + rotl(lane[1], 7) + rotl(lane[2], 12) + rotl(lane[3], 18) + tail;
+	h ^= h >> 33;
+	h *= prime2;
+	h ^= h >> 29;
+	return h;
+}
 
 void EmuVideo::resetImage()
 {
@@ -30,6 +68,12 @@ void EmuVideo::resetImage()
 
 IG::PixmapDesc EmuVideo::deleteImage()
 {
+	hasFrameHash = false;
+	if(!rTask)
+	{
+		memImg.reset();
+		return std::exchange(memImgDesc, {});
+	}
 	auto desc = vidImg.usedPixmapDesc();
 	vidImg = {};
 	return desc;
@@ -46,7 +90,13 @@ void EmuVideo::setFormat(IG::PixmapDesc desc)
 	{
 		return; // no change to format
 	}
-	if(!vidImg)
+	hasFrameHash = false;
+	if(!rTask)
+	{
+		memImg = std::make_unique<char[]>(desc.pixelBytes());
+		memImgDesc = desc;
+	}
+	else if(!vidImg)
 	{
 		Gfx::TextureConfig conf{desc, texSampler};
 		vidImg = renderer().makePixmapBufferTexture(conf, bufferMode, singleBuffer);
@@ -72,11 +122,17 @@ void EmuVideo::postSetFormat(EmuSystemTask &task, IG::PixmapDesc desc)
 
 void EmuVideo::syncImageAccess()
 {
+	if(!rTask)
+		return;
 	rTask->clientWaitSync(std::exchange(fence, {}));
 }
 
 EmuVideoImage EmuVideo::startFrame(EmuSystemTask *task)
 {
+	if(!rTask)
+	{
+		return {task, *this, Gfx::LockedTextureBuffer{nullptr, memoryImage(), {}, 0, false}};
+	}
 	auto lockedTex = vidImg.lock();
 	syncImageAccess();
 	return {task, *this, lockedTex};
@@ -115,12 +171,16 @@ void EmuVideo::startFrameWithFormat(EmuSystemTask *task, IG::Pixmap pix)
 
 void EmuVideo::startUnchangedFrame(EmuSystemTask *task)
 {
-	dispatchFinishFrame(task);
+	dispatchFinishFrame(task, true);
 }
 
-void EmuVideo::dispatchFinishFrame(EmuSystemTask *task)
+void EmuVideo::dispatchFinishFrame(EmuSystemTask *task, bool isDuplicate)
 {
 	//logDMsg("frame finished");
+	finishedFrames_++;
+	if(isDuplicate)
+		duplicateFrames_++;
+	lastFrameIsDuplicate_ = isDuplicate;
 	onFrameFinished(*this);
 }
 
@@ -130,7 +190,12 @@ void EmuVideo::finishFrame(EmuSystemTask *task, Gfx::LockedTextureBuffer texBuff
 	{
 		doScreenshot(task, texBuff.pixmap());
 	}
-	vidImg.unlock(texBuff);
+	if(rTask)
+	{
+		// written directly to texture memory, which may be slow to read back for hashing
+		hasFrameHash = false;
+		vidImg.unlock(texBuff);
+	}
 	dispatchFinishFrame(task);
 }
 
@@ -140,6 +205,23 @@ void EmuVideo::finishFrame(EmuSystemTask *task, IG::Pixmap pix)
 	{
 		doScreenshot(task, pix);
 	}
+	if(!rTask)
+	{
+		memoryImage().write(pix);
+		dispatchFinishFrame(task);
+		return;
+	}
+	if(auto hash = frameHash(pix);
+		hasFrameHash && hash == lastFrameHash)
+	{
+		dispatchFinishFrame(task, true);
+		return;
+	}
+	else
+	{
+		lastFrameHash = hash;
+		hasFrameHash = true;
+	}
 	syncImageAccess();
 	vidImg.write(pix, vidImg.WRITE_FLAG_ASYNC);
 	dispatchFinishFrame(task);
@@ -155,6 +237,8 @@ bool EmuVideo::addFence(Gfx::RendererCommands &cmds)
 
 void EmuVideo::clear()
 {
+	hasFrameHash = false;
+	finishedFrames_ = duplicateFrames_ = 0;
 	if(!vidImg)
 		return;
 	vidImg.clear();
@@ -237,6 +321,8 @@ void EmuVideoImage::endFrame()
 
 IG::WP EmuVideo::size() const
 {
+	if(!rTask)
+		return memImgDesc.size();
 	if(!vidImg)
 		return {};
 	else
@@ -245,6 +331,8 @@ IG::WP EmuVideo::size() const
 
 bool EmuVideo::formatIsEqual(IG::PixmapDesc desc) const
 {
+	if(!rTask)
+		return memImg && desc == memImgDesc;
 	return vidImg && desc == vidImg.usedPixmapDesc();
 }
 
@@ -300,3 +388,8 @@ void EmuVideo::setCompatTextureSampler(const Gfx::TextureSampler &compatTexSampl
 		return;
 	vidImg.setCompatTextureSampler(compatTexSampler);
 }
+
+IG::Pixmap EmuVideo::memoryImage() const
+{
+	return {memImgDesc, memImg.get()};
+}
@@ -79,11 +79,14 @@ void EmuView::setLayoutInputView(EmuInputView *view)
 	inputView = view;
 }
 
-void EmuView::updateAudioStats(uint underruns, uint overruns, uint callbacks, double avgCallbackFrames, uint frames)
+void EmuView::updateAudioStats(const EmuAudio::Stats &stats)
 {
 	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-	audioStatsText.setString(string_makePrintf<512>("Underruns:%u\nOverruns:%u\nCallbacks per second:%u\nFrames per callback:%.2f\nTotal frames:%u",
-		underruns, overruns, callbacks, avgCallbackFrames, frames), &View::defaultFace);
+	audioStatsText.setString(string_makePrintf<512>("Underruns:%u\nOverruns:%u\nCallbacks per second:%u\nFrames per callback:%.2f\nTotal frames:%u\n"
+		"Queued frames:%u/%u\nCallback period:%.2fms (jitter %.2fms)\nLatency:%.2fms",
+		stats.underruns, stats.overruns, stats.callbacks, stats.callbacks ? stats.callbackFrames / (double)stats.callbacks : 0., stats.callbackFrames,
+		stats.queuedFrames, stats.capacityFrames, stats.avgCallbackPeriod.count() / 1000., stats.callbackJitter.count() / 1000.,
+		stats.latency.count() / 1000.), &View::defaultFace);
 	place();
 	#endif
 }
@@ -32,6 +32,7 @@
 #include "configFile.hh"
 #include "EmuSystemTask.hh"
 #include "EmuTiming.hh"
+#include "StartupTrace.hh"
 
 class AutoStateConfirmAlertView : public YesNoAlertView
 {
@@ -231,9 +232,12 @@ void EmuViewController::initViews(ViewAttachParams viewAttach)
 	pushAndShow(std::move(mainMenu), Input::defaultEvent());
 	applyFrameRates();
 	videoLayer().emuVideo().setOnFrameFinished(
-		[this](EmuVideo &)
+		[this](EmuVideo &video)
 		{
 			emuVideoInProgress = false;
+			// the displayed image is already up to date unless draws drive the frame timing
+			if(video.lastFrameIsDuplicate() && !useRendererTime())
+				return;
 			postDrawToEmuWindows();
 		});
 	videoLayer().emuVideo().setOnFormatChanged(
@@ -310,6 +314,8 @@ Base::WindowConfig EmuViewController::addWindowConfig(Base::WindowConfig winConf
 					cmds.clear();
 					drawMainWindow(win, cmds, winData.hasEmuView, winData.hasPopup);
 				});
+			if(unlikely(startupTrace.isActive()))
+				startupTrace.finish("first frame");
 			return false;
 		});
 
@@ -629,9 +635,9 @@ void EmuViewController::updateWindowViewport(Base::Window &win, Base::Window::Su
 	}
 }
 
-void EmuViewController::updateEmuAudioStats(uint underruns, uint overruns, uint callbacks, double avgCallbackFrames, uint frames)
+void EmuViewController::updateEmuAudioStats(const EmuAudio::Stats &stats)
 {
-	emuView.updateAudioStats(underruns, overruns, callbacks, avgCallbackFrames, frames);
+	emuView.updateAudioStats(stats);
 }
 
 void EmuViewController::clearEmuAudioStats()
@@ -745,10 +751,21 @@ void EmuViewController::pauseEmulation()
 	removeOnFrame();
 }
 
+void EmuViewController::benchmarkInputMovie()
+{
+	// runs on the emulation thread, the result is shown when its reply arrives
+	systemTask->runMovie(&videoLayer().emuVideo());
+}
+
 void EmuViewController::closeSystem(bool allowAutosaveState)
 {
 	showUI();
 	systemTask->stop();
+	if(auto &video = videoLayer().emuVideo();
+		video.finishedFrames())
+	{
+		logMsg("skipped upload of %u duplicate frames out of %u", video.duplicateFrames(), video.finishedFrames());
+	}
 	EmuSystem::closeRuntimeSystem(allowAutosaveState);
 	viewStack.navView()->showRightBtn(false);
 	if(int idx = viewStack.viewIdx("System Actions");
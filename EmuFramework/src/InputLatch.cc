@@ -0,0 +1,128 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "InputLatch"
+#include "InputLatch.hh"
+#include <emuframework/EmuApp.hh>
+#include <emuframework/inGameActionKeys.hh>
+#include <imagine/input/Input.hh>
+#include <imagine/logger/logger.h>
+#include "privateInput.hh"
+#include "InputMovie.hh"
+
+InputLatch inputLatch{};
+
+void InputLatch::update()
+{
+	EmuApp::syncEmulationThread();
+	applyQueuedActions();
+	if(actions_)
+	{
+		logMsg("applied %u actions at latch time", actions_);
+		actions_ = 0;
+	}
+	sources.clear();
+	if(!keyMapping)
+		return;
+	uint i = 0;
+	for(auto &dev : Input::deviceList())
+	{
+		auto actionGroup = keyMapping.inputDevActionTablePtr[i++];
+		Input::KeyStateSnapshot state;
+		if(!actionGroup || !dev->readKeyState(state))
+			continue;
+		Source src{dev};
+		iterateTimes(Input::Event::mapNumKeys(dev->map()), k)
+		{
+			for(auto action : actionGroup[k])
+			{
+				if(!action)
+					break;
+				action--;
+				if(action < EmuControls::systemKeyMapStart)
+					continue;
+				bool turbo;
+				uint emuKey = EmuSystem::translateInputAction(action, turbo);
+				if(turbo)
+					continue; // handled by TurboInput
+				src.keyActions.push_back({(Input::Key)k, emuKey});
+			}
+		}
+		if(src.keyActions.empty())
+			continue;
+		logMsg("latching %zu actions from device:%s", src.keyActions.size(), dev->name());
+		// events for the keys already pushed have been handled by the main thread
+		src.state = state;
+		sources.emplace_back(std::move(src));
+	}
+}
+
+bool InputLatch::queueAction(uint state, uint emuKey)
+{
+	if(sources.empty())
+		return false;
+	std::lock_guard lock{queueMutex};
+	queuedActions.push_back((emuKey << 1) | (state == Input::PUSHED));
+	return true;
+}
+
+void InputLatch::applyQueuedActions()
+{
+	if(sources.empty())
+		return;
+	std::lock_guard lock{queueMutex};
+	for(auto action : queuedActions)
+	{
+		EmuSystem::handleInputAction((action & 1) ? Input::PUSHED : Input::RELEASED, action >> 1);
+	}
+	queuedActions.clear();
+}
+
+void InputLatch::latch()
+{
+	if(sources.empty())
+		return;
+	auto now = IG::steadyClockTimestamp();
+	if(now - lastLatchTime < MIN_INTERVAL)
+		return;
+	lastLatchTime = now;
+	// apply everything the main thread has already seen before the newer sampled state
+	applyQueuedActions();
+	for(auto &src : sources)
+	{
+		Input::KeyStateSnapshot state;
+		if(!src.dev->readKeyState(state))
+			continue;
+		// the main thread applies the same actions when it processes the events,
+		// so this only moves them earlier
+		for(auto [key, emuKey] : src.keyActions)
+		{
+			bool pushed = state.isPushed(key);
+			if(pushed != src.state.isPushed(key))
+			{
+				auto action = pushed ? Input::PUSHED : Input::RELEASED;
+				if(inputMovie.recordAction(action, emuKey))
+					EmuSystem::handleInputAction(action, emuKey);
+				actions_++;
+			}
+		}
+		src.state = state;
+	}
+}
+
+void EmuSystem::latchInput()
+{
+	inputLatch.latch();
+}
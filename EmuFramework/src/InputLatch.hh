@@ -0,0 +1,67 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/input/Device.hh>
+#include <imagine/time/Time.hh>
+#include <mutex>
+#include <vector>
+
+// Samples the key state of devices supporting Input::Device::readKeyState() when
+// the emulation core latches its input ports so presses that haven't been
+// delivered through the main thread's event loop yet are applied to the current
+// frame. The source list is only modified while the emulation thread is paused.
+// While any source is latched, the main thread queues its actions instead of
+// applying them so the core's input state is only written from one thread.
+class InputLatch
+{
+public:
+	// don't sample more often than this when a core latches its ports repeatedly
+	static constexpr IG::Time MIN_INTERVAL = IG::Milliseconds{1};
+
+	InputLatch() {}
+	// rebuild from the current key mapping, call from the main thread
+	void update();
+	// call from the main thread, returns false if the action should be applied directly
+	bool queueAction(uint state, uint emuKey);
+	// call from the emulation thread before running a frame
+	void applyQueuedActions();
+	// call from the emulation thread
+	void latch();
+	uint32_t actions() const { return actions_; }
+
+protected:
+	struct KeyAction
+	{
+		Input::Key key;
+		uint emuKey;
+	};
+
+	struct Source
+	{
+		const Input::Device *dev{};
+		std::vector<KeyAction> keyActions{};
+		Input::KeyStateSnapshot state{};
+	};
+
+	std::vector<Source> sources{};
+	std::mutex queueMutex{};
+	std::vector<uint32_t> queuedActions{};
+	IG::Time lastLatchTime{};
+	uint32_t actions_ = 0;
+};
+
+extern InputLatch inputLatch;
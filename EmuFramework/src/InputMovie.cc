@@ -0,0 +1,296 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "InputMovie"
+#include "InputMovie.hh"
+#include <emuframework/EmuApp.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/fs/FS.hh>
+#include <imagine/logger/logger.h>
+#include "private.hh"
+
+InputMovie inputMovie{};
+
+static void writeVarInt(std::vector<uint8_t> &data, uint32_t val)
+{
+	while(val >= 0x80)
+	{
+		data.push_back((val & 0x7F) | 0x80);
+		val >>= 7;
+	}
+	data.push_back(val);
+}
+
+static uint32_t readVarInt(const std::vector<uint8_t> &data, size_t &pos)
+{
+	uint32_t val = 0;
+	for(unsigned shift = 0; pos < data.size() && shift < 32; shift += 7)
+	{
+		auto byte = data[pos++];
+		val |= (uint32_t)(byte & 0x7F) << shift;
+		if(!(byte & 0x80))
+			break;
+	}
+	return val;
+}
+
+static FS::PathString makeStatePath(const char *moviePath)
+{
+	return FS::makePathStringPrintf("%s.state", moviePath);
+}
+
+FS::PathString InputMovie::makeDefaultPath()
+{
+	return FS::makePathStringPrintf("%s/%s.emv", EmuSystem::savePath(), EmuSystem::gameName().data());
+}
+
+EmuSystem::Error InputMovie::startRecording(const char *path_)
+{
+	stop();
+	auto statePath = makeStatePath(path_);
+	if(auto err = EmuApp::saveState(statePath.data());
+		err)
+	{
+		return err;
+	}
+	FileIO stateFile;
+	stateFile.open(statePath, IO::AccessHint::ALL);
+	if(!stateFile)
+	{
+		return EmuSystem::makeFileReadError();
+	}
+	stateData.resize(stateFile.size());
+	stateFile.read(stateData.data(), stateData.size());
+	stateFile.close();
+	FS::remove(statePath);
+	string_copy(path, path_);
+	actionData.clear();
+	actionData.reserve(4096);
+	pendingActions.clear();
+	lastActionFrame = totalFrames = actions = 0;
+	frame_ = 0;
+	clearInputBuffers();
+	mode_ = Mode::RECORD;
+	logMsg("recording to %s, start state is %zu bytes", path, stateData.size());
+	return {};
+}
+
+EmuSystem::Error InputMovie::startPlayback(const char *path_)
+{
+	stop();
+	FileIO file;
+	file.open(path_, IO::AccessHint::ALL);
+	if(!file)
+	{
+		return EmuSystem::makeFileReadError();
+	}
+	Header header;
+	if(file.read(&header, sizeof(header)) != sizeof(header) ||
+		memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+	{
+		return EmuSystem::makeError("Invalid input movie file");
+	}
+	header.gameName[sizeof(header.gameName) - 1] = 0;
+	if(!string_equal(header.gameName, EmuSystem::gameName().data()))
+	{
+		logWarn("movie recorded with game:%s", header.gameName);
+	}
+	stateData.resize(header.stateBytes);
+	actionData.resize(header.actionBytes);
+	if(file.read(stateData.data(), stateData.size()) != (ssize_t)stateData.size() ||
+		file.read(actionData.data(), actionData.size()) != (ssize_t)actionData.size())
+	{
+		return EmuSystem::makeError("Input movie file is truncated");
+	}
+	string_copy(path, path_);
+	totalFrames = header.frames;
+	actions = header.actions;
+	if(auto err = loadStartState();
+		err)
+	{
+		return err;
+	}
+	logMsg("playing %s, %u frames with %u actions", path.data(), totalFrames, actions);
+	return {};
+}
+
+EmuSystem::Error InputMovie::loadStartState()
+{
+	auto statePath = makeStatePath(path.data());
+	if(FileUtils::writeToPath(statePath.data(), stateData.data(), stateData.size()) != (ssize_t)stateData.size())
+	{
+		return EmuSystem::makeFileWriteError();
+	}
+	auto err = EmuApp::loadState(statePath.data());
+	FS::remove(statePath);
+	if(err)
+		return err;
+	clearInputBuffers();
+	frame_ = 0;
+	playbackPos = 0;
+	nextActionFrame = 0;
+	decodeNextActionFrame();
+	mode_ = Mode::PLAYBACK;
+	return {};
+}
+
+EmuSystem::Error InputMovie::stop()
+{
+	switch(mode_.exchange(Mode::OFF))
+	{
+		case Mode::RECORD:
+		{
+			EmuApp::syncEmulationThread();
+			totalFrames = frame_;
+			// input after the last recorded frame still reaches the system
+			flushPendingActions(false);
+			return write();
+		}
+		case Mode::PLAYBACK:
+			logMsg("stopped playback at frame %u of %u", (uint32_t)frame_, totalFrames);
+			break;
+		default:
+			break;
+	}
+	return {};
+}
+
+EmuSystem::Error InputMovie::write()
+{
+	FileIO file;
+	if(auto ec = file.create(path);
+		ec)
+	{
+		return EmuSystem::makeError(ec);
+	}
+	Header header{};
+	memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.frames = totalFrames;
+	header.actions = actions;
+	header.stateBytes = stateData.size();
+	header.actionBytes = actionData.size();
+	string_copy(header.gameName, EmuSystem::gameName().data());
+	if(file.write(&header, sizeof(header)) != sizeof(header) ||
+		file.write(stateData.data(), stateData.size()) != (ssize_t)stateData.size() ||
+		file.write(actionData.data(), actionData.size()) != (ssize_t)actionData.size())
+	{
+		return EmuSystem::makeFileWriteError();
+	}
+	logMsg("wrote %s, %u frames with %u actions in %zu bytes", path.data(), totalFrames, actions, actionData.size());
+	return {};
+}
+
+bool InputMovie::recordAction(uint state, uint emuKey)
+{
+	switch(mode_)
+	{
+		case Mode::OFF: return true;
+		case Mode::PLAYBACK: return false;
+		case Mode::RECORD:
+		{
+			// applied & recorded by onFrame() at the next frame boundary, the same point playback applies them
+			std::lock_guard<std::mutex> lock{recordMutex};
+			pendingActions.push_back((emuKey << 1) | (state == Input::PUSHED));
+			return false;
+		}
+	}
+	return true;
+}
+
+void InputMovie::applyAction(uint32_t action)
+{
+	EmuSystem::handleInputAction((action & 1) ? Input::PUSHED : Input::RELEASED, action >> 1);
+}
+
+void InputMovie::flushPendingActions(bool record)
+{
+	std::lock_guard<std::mutex> lock{recordMutex};
+	for(auto action : pendingActions)
+	{
+		applyAction(action);
+		if(record)
+		{
+			uint32_t frame = frame_;
+			writeVarInt(actionData, frame - lastActionFrame);
+			writeVarInt(actionData, action);
+			lastActionFrame = frame;
+			actions++;
+		}
+	}
+	pendingActions.clear();
+}
+
+void InputMovie::decodeNextActionFrame()
+{
+	nextActionFrame = playbackPos < actionData.size() ?
+		nextActionFrame + readVarInt(actionData, playbackPos) : UINT32_MAX;
+}
+
+void InputMovie::onFrame()
+{
+	switch(mode_)
+	{
+		case Mode::OFF: return;
+		case Mode::RECORD:
+			flushPendingActions(true);
+			frame_++;
+			return;
+		case Mode::PLAYBACK:
+		{
+			uint32_t frame = frame_;
+			if(frame == totalFrames)
+			{
+				logMsg("playback finished after %u frames", frame);
+				mode_ = Mode::OFF;
+				return;
+			}
+			while(nextActionFrame == frame)
+			{
+				applyAction(readVarInt(actionData, playbackPos));
+				decodeNextActionFrame();
+			}
+			frame_ = frame + 1;
+			return;
+		}
+	}
+}
+
+IG::Time InputMovie::runHeadless(EmuSystemTask *task, EmuVideo *video, EmuAudio *audio, DelegateFunc<void()> onFrameDone)
+{
+	if(!totalFrames)
+		return {};
+	if(mode_ != Mode::PLAYBACK || frame_ != 0)
+	{
+		if(loadStartState())
+			return {};
+	}
+	auto startTime = IG::steadyClockTimestamp();
+	while(true)
+	{
+		onFrame();
+		if(mode_ != Mode::PLAYBACK)
+			break;
+		EmuSystem::runFrame(task, video, audio);
+		onFrameDone.callSafe();
+	}
+	return IG::steadyClockTimestamp() - startTime;
+}
+
+void InputMovie::clearInputBuffers()
+{
+	// headless runs have no input view
+	if(hasEmuViewController())
+		EmuSystem::clearInputBuffers(emuViewController().inputView());
+}
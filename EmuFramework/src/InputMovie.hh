@@ -0,0 +1,95 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/EmuSystem.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/util/DelegateFunc.hh>
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+class EmuVideo;
+class EmuAudio;
+class EmuSystemTask;
+
+// Records the input actions passed to EmuSystem::handleInputAction along with the
+// frame they were applied on, starting from a saved state, so a session can be
+// replayed deterministically. Actions are stored as a byte stream of
+// (frame delta, action << 1 | pushed) varint pairs.
+class InputMovie
+{
+public:
+	enum class Mode : uint8_t
+	{
+		OFF,
+		RECORD,
+		PLAYBACK
+	};
+
+	static constexpr char MAGIC[4]{'E', 'M', 'V', '1'};
+
+	struct Header
+	{
+		char magic[4];
+		uint32_t frames;
+		uint32_t actions;
+		uint32_t stateBytes;
+		uint32_t actionBytes;
+		char gameName[256];
+	};
+
+	InputMovie() {}
+	EmuSystem::Error startRecording(const char *path);
+	EmuSystem::Error startPlayback(const char *path);
+	EmuSystem::Error stop();
+	// called from any thread that generates input, returns false if the action shouldn't be
+	// applied now, while recording it's queued and applied by the next onFrame()
+	bool recordAction(uint state, uint emuKey);
+	// called on the emulation thread before each EmuSystem::runFrame(), applies recorded
+	// or played back actions so both modes change input at the same frame boundary
+	void onFrame();
+	// replay the movie from its start state without video/audio pacing, rewinds first
+	// unless playback was just started, onFrameDone runs after each emulated frame
+	IG::Time runHeadless(EmuSystemTask *task, EmuVideo *video, EmuAudio *audio = nullptr, DelegateFunc<void()> onFrameDone = {});
+	Mode mode() const { return mode_; }
+	uint32_t frame() const { return frame_; }
+	uint32_t frames() const { return totalFrames; }
+	static FS::PathString makeDefaultPath();
+
+protected:
+	std::vector<uint8_t> actionData{};
+	std::vector<uint8_t> stateData{};
+	FS::PathString path{};
+	std::mutex recordMutex{};
+	std::vector<uint32_t> pendingActions{};
+	std::atomic<Mode> mode_{Mode::OFF};
+	std::atomic_uint32_t frame_{};
+	uint32_t lastActionFrame = 0;
+	uint32_t totalFrames = 0;
+	uint32_t actions = 0;
+	size_t playbackPos = 0;
+	uint32_t nextActionFrame = 0;
+
+	EmuSystem::Error loadStartState();
+	EmuSystem::Error write();
+	void decodeNextActionFrame();
+	void flushPendingActions(bool record);
+	static void applyAction(uint32_t action);
+	static void clearInputBuffers();
+};
+
+extern InputMovie inputMovie;
@@ -0,0 +1,330 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "Regression"
+#include <emuframework/EmuSystem.hh>
+#include <emuframework/EmuApp.hh>
+#include <imagine/fs/FS.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/logger/logger.h>
+#include <imagine/util/string.h>
+#include "private.hh"
+#include "InputMovie.hh"
+#include <zlib.h>
+#include <vector>
+#include <algorithm>
+#include <cstdarg>
+#include <cstring>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/wait.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+// Headless ROM regression testing, run with:
+// --headless --regression=<rom dir> --golden=<dir> [--frames=<n>] [--jobs=<n>] [--update-golden]
+//   [--movies=<dir>]
+// Every core keeps its state in globals, so each ROM runs in its own forked
+// worker process. A worker records the CRC32 of each frame's image and of the
+// audio stream up to that frame, then compares them against the golden file
+// for the ROM, or replaces it with --update-golden. Default options and a
+// temporary save directory are used so results don't depend on the user's setup.
+// If <movies dir>/<game name>.emv exists, the worker replays that input movie
+// from its start state instead of running --frames frames without input, and
+// reports the replay speed.
+
+static constexpr uint32_t regressionAudioRate = 48000;
+
+enum WorkerResult
+{
+	WORKER_PASS,
+	WORKER_FAIL,
+	WORKER_ERROR,
+	WORKER_NO_GOLDEN,
+};
+
+struct RegressionArgs
+{
+	const char *romDir{};
+	const char *goldenDir{};
+	uint32_t frames = 600;
+	const char *movieDir{};
+	uint32_t jobs = 0;
+	bool updateGolden = false;
+};
+
+static const char *argValue(const char *arg, const char *name)
+{
+	auto len = strlen(name);
+	if(strncmp(arg, name, len) || arg[len] != '=')
+		return nullptr;
+	return &arg[len + 1];
+}
+
+static bool parseRegressionArgs(int argc, char **argv, RegressionArgs &args)
+{
+	for(int i = 1; i < argc; i++)
+	{
+		if(auto val = argValue(argv[i], "--regression"))
+			args.romDir = val;
+		else if(auto val = argValue(argv[i], "--golden"))
+			args.goldenDir = val;
+		else if(auto val = argValue(argv[i], "--frames"))
+			args.frames = std::max(atoi(val), 1);
+		else if(auto val = argValue(argv[i], "--jobs"))
+			args.jobs = std::max(atoi(val), 0);
+		else if(auto val = argValue(argv[i], "--movies"))
+			args.movieDir = val;
+		else if(string_equal(argv[i], "--update-golden"))
+			args.updateGolden = true;
+	}
+	return args.romDir;
+}
+
+static void printLine(const char *format, ...)
+{
+	// single write so lines from concurrent workers don't interleave
+	std::array<char, 512> line;
+	va_list args;
+	va_start(args, format);
+	int len = vsnprintf(line.data(), line.size(), format, args);
+	va_end(args);
+	if(len > 0)
+		write(STDOUT_FILENO, line.data(), std::min(len, (int)line.size() - 1));
+}
+
+static std::vector<char> readFile(const char *path)
+{
+	FileIO io;
+	if(io.open(path, IO::AccessHint::ALL))
+		return {};
+	auto buff = io.constBufferView();
+	return {buff.data(), buff.data() + buff.size()};
+}
+
+static uint32_t pixmapCRC(IG::Pixmap pix)
+{
+	uint32_t crc = crc32(0, nullptr, 0);
+	auto lineBytes = pix.format().pixelBytes(pix.w());
+	for(uint32_t y = 0; y < pix.h(); y++)
+	{
+		crc = crc32(crc, (const Bytef*)pix.pixel({0, (int)y}), lineBytes);
+	}
+	return crc;
+}
+
+static void removeDirectory(const char *path)
+{
+	std::error_code ec{};
+	for(auto &entry : FS::directory_iterator{path, ec})
+	{
+		FS::remove(FS::makePathStringPrintf("%s/%s", path, entry.name()));
+	}
+	rmdir(path);
+}
+
+static int runWorker(const RegressionArgs &args, const char *romPath)
+{
+	auto romName = FS::basename(romPath);
+	auto saveDir = FS::makePathStringPrintf("%s/emuex-regression-XXXXXX", P_tmpdir);
+	if(!mkdtemp(saveDir.data()))
+	{
+		printLine("ERROR %s: can't create save directory\n", romName.data());
+		return WORKER_ERROR;
+	}
+	EmuSystem::savePath_ = saveDir;
+	auto result = [&]()
+	{
+		if(auto err = EmuSystem::loadGameFromPath(romPath, {}, {});
+			err)
+		{
+			printLine("ERROR %s: %s\n", romName.data(), err->what());
+			return WORKER_ERROR;
+		}
+		uint32_t audioCRC = crc32(0, nullptr, 0);
+		emuAudio.setCapture(
+			[&](const void *samples, uint32_t frames)
+			{
+				audioCRC = crc32(audioCRC, (const Bytef*)samples, emuAudio.format().framesToBytes(frames));
+			});
+		EmuSystem::onPrepareAudio(emuAudio);
+		EmuSystem::configAudioPlayback(regressionAudioRate);
+		EmuSystem::prepareVideo(emuVideo);
+		std::vector<char> results{};
+		results.reserve(args.frames * 24);
+		uint32_t frame = 0;
+		auto recordFrame = [&]()
+		{
+			auto line = string_makePrintf<32>("%u %08x %08x\n", frame++, pixmapCRC(emuVideo.memoryImage()), audioCRC);
+			results.insert(results.end(), line.data(), line.data() + strlen(line.data()));
+		};
+		auto moviePath = args.movieDir ?
+			FS::makePathStringPrintf("%s/%s.emv", args.movieDir, EmuSystem::gameName().data()) : FS::PathString{};
+		if(args.movieDir && FS::exists(moviePath))
+		{
+			if(auto err = inputMovie.startPlayback(moviePath.data());
+				err)
+			{
+				printLine("ERROR %s: %s: %s\n", romName.data(), moviePath.data(), err->what());
+				return WORKER_ERROR;
+			}
+			IG::FloatSeconds time = inputMovie.runHeadless(nullptr, &emuVideo, &emuAudio, [&recordFrame](){ recordFrame(); });
+			printLine("MOVIE %s: %u frames, %.2f fps\n", romName.data(), frame, time.count() ? frame / time.count() : 0.);
+		}
+		else
+		{
+			while(frame < args.frames)
+			{
+				EmuSystem::runFrame(nullptr, &emuVideo, &emuAudio);
+				recordFrame();
+			}
+		}
+		auto goldenPath = FS::makePathStringPrintf("%s/%s.txt", args.goldenDir, romName.data());
+		if(args.updateGolden)
+		{
+			FileIO io;
+			if(io.create(goldenPath.data()) || io.write(results.data(), results.size()) != (ssize_t)results.size())
+			{
+				printLine("ERROR %s: can't write %s\n", romName.data(), goldenPath.data());
+				return WORKER_ERROR;
+			}
+			printLine("UPDATED %s\n", romName.data());
+			return WORKER_PASS;
+		}
+		auto golden = readFile(goldenPath.data());
+		if(golden.empty())
+		{
+			printLine("MISSING %s: no golden file %s\n", romName.data(), goldenPath.data());
+			return WORKER_NO_GOLDEN;
+		}
+		if(golden == results)
+		{
+			printLine("PASS %s\n", romName.data());
+			return WORKER_PASS;
+		}
+		// report the first frame that differs
+		auto mismatch = std::mismatch(results.begin(), results.end(), golden.begin(), golden.end()).first;
+		auto mismatchFrame = std::count(results.begin(), mismatch, '\n');
+		printLine("FAIL %s: first difference at frame %ld\n", romName.data(), (long)mismatchFrame);
+		return WORKER_FAIL;
+	}();
+	removeDirectory(saveDir.data());
+	return result;
+}
+
+static void setWorkerCPU(uint32_t slot)
+{
+	#ifdef __linux__
+	auto cpus = std::max(sysconf(_SC_NPROCESSORS_ONLN), 1l);
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(slot % cpus, &set);
+	if(sched_setaffinity(0, sizeof(set), &set))
+		logWarn("error setting CPU affinity for worker %u", slot);
+	#endif
+}
+
+bool runRegressionFromCmdLine(int argc, char **argv)
+{
+	RegressionArgs args{};
+	bool headless = std::any_of(&argv[1], &argv[argc],
+		[](const char *arg){ return string_equal(arg, "--headless"); });
+	if(!parseRegressionArgs(argc, argv, args))
+	{
+		if(!headless)
+			return false;
+		// nothing else can run without a window
+		printLine("--headless requires --regression=<rom dir>\n");
+		::exit(WORKER_ERROR);
+	}
+	if(!args.goldenDir)
+	{
+		printLine("--regression requires --golden=<dir>\n");
+		::exit(WORKER_ERROR);
+	}
+	if(!args.jobs)
+		args.jobs = std::max(sysconf(_SC_NPROCESSORS_ONLN), 1l);
+	EmuSystem::initOptions();
+	if(auto err = EmuSystem::onOptionsLoaded();
+		err)
+	{
+		printLine("ERROR: %s\n", err->what());
+		::exit(WORKER_ERROR);
+	}
+	std::vector<FS::PathString> roms{};
+	std::error_code ec{};
+	for(auto &entry : FS::directory_iterator{args.romDir, ec})
+	{
+		if(entry.type() == FS::file_type::directory || !EmuSystem::defaultFsFilter(entry.name()))
+			continue;
+		roms.emplace_back(FS::makePathStringPrintf("%s/%s", args.romDir, entry.name()));
+	}
+	if(ec)
+	{
+		printLine("can't open ROM directory %s\n", args.romDir);
+		::exit(WORKER_ERROR);
+	}
+	std::sort(roms.begin(), roms.end(),
+		[](const FS::PathString &a, const FS::PathString &b){ return strcmp(a.data(), b.data()) < 0; });
+	logMsg("running %zu ROMs for %u frames with %u workers", roms.size(), args.frames, args.jobs);
+	std::vector<pid_t> slotPids(args.jobs);
+	std::vector<size_t> slotRoms(args.jobs);
+	uint32_t counts[4]{};
+	size_t nextRom = 0, running = 0;
+	while(nextRom < roms.size() || running)
+	{
+		if(nextRom < roms.size() && running < args.jobs)
+		{
+			auto slot = std::find(slotPids.begin(), slotPids.end(), 0) - slotPids.begin();
+			auto &romPath = roms[nextRom++];
+			auto pid = fork();
+			if(pid == 0)
+			{
+				setWorkerCPU(slot);
+				_exit(runWorker(args, romPath.data()));
+			}
+			if(pid == -1)
+			{
+				printLine("ERROR %s: fork failed\n", FS::basename(romPath).data());
+				counts[WORKER_ERROR]++;
+				continue;
+			}
+			slotPids[slot] = pid;
+			slotRoms[slot] = nextRom - 1;
+			running++;
+			continue;
+		}
+		int status;
+		auto pid = wait(&status);
+		if(pid == -1)
+			break;
+		auto it = std::find(slotPids.begin(), slotPids.end(), pid);
+		if(it == slotPids.end())
+			continue;
+		*it = 0;
+		running--;
+		if(!WIFEXITED(status))
+		{
+			printLine("ERROR %s: worker killed by signal %d\n",
+				FS::basename(roms[slotRoms[it - slotPids.begin()]]).data(), WTERMSIG(status));
+		}
+		auto result = WIFEXITED(status) ? WEXITSTATUS(status) : WORKER_ERROR;
+		counts[std::min(result, (int)WORKER_NO_GOLDEN)]++;
+	}
+	printLine("%u passed, %u failed, %u errors, %u missing golden files\n",
+		counts[WORKER_PASS], counts[WORKER_FAIL], counts[WORKER_ERROR], counts[WORKER_NO_GOLDEN]);
+	::exit(counts[WORKER_FAIL] || counts[WORKER_ERROR] || counts[WORKER_NO_GOLDEN] ? 1 : 0);
+}
@@ -0,0 +1,306 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "RomIdentity"
+#include <emuframework/RomIdentity.hh>
+#include <imagine/fs/FS.hh>
+#include <imagine/logger/logger.h>
+#include <imagine/util/string.h>
+#include <zlib.h>
+#include <mutex>
+#include <cstring>
+
+static constexpr uint32_t rotl(uint32_t x, int n) { return (x << n) | (x >> (32 - n)); }
+
+static uint32_t loadLE32(const uint8_t *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+static uint32_t loadBE32(const uint8_t *p) { return ((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3]; }
+static void storeLE32(uint8_t *p, uint32_t v) { p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24; }
+static void storeBE32(uint8_t *p, uint32_t v) { p[0] = v >> 24; p[1] = v >> 16; p[2] = v >> 8; p[3] = v; }
+
+#define MD5_STEP(f, a, b, c, d, x, k, s) a += f(b, c, d) + x + k; a = rotl(a, s) + b;
+#define MD5_F(x, y, z) (z ^ (x & (y ^ z)))
+#define MD5_G(x, y, z) (y ^ (z & (x ^ y)))
+#define MD5_H(x, y, z) (x ^ y ^ z)
+#define MD5_I(x, y, z) (y ^ (x | ~z))
+
+static void md5Block(uint32_t state[4], const uint8_t *block)
+{
+	uint32_t m[16];
+	for(int i = 0; i < 16; i++)
+		m[i] = loadLE32(block + i * 4);
+	uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+	MD5_STEP(MD5_F, a, b, c, d, m[0], 0xd76aa478, 7)
+	MD5_STEP(MD5_F, d, a, b, c, m[1], 0xe8c7b756, 12)
+	MD5_STEP(MD5_F, c, d, a, b, m[2], 0x242070db, 17)
+	MD5_STEP(MD5_F, b, c, d, a, m[3], 0xc1bdceee, 22)
+	MD5_STEP(MD5_F, a, b, c, d, m[4], 0xf57c0faf, 7)
+	MD5_STEP(MD5_F, d, a, b, c, m[5], 0x4787c62a, 12)
+	MD5_STEP(MD5_F, c, d, a, b, m[6], 0xa8304613, 17)
+	MD5_STEP(MD5_F, b, c, d, a, m[7], 0xfd469501, 22)
+	MD5_STEP(MD5_F, a, b, c, d, m[8], 0x698098d8, 7)
+	MD5_STEP(MD5_F, d, a, b, c, m[9], 0x8b44f7af, 12)
+	MD5_STEP(MD5_F, c, d, a, b, m[10], 0xffff5bb1, 17)
+	MD5_STEP(MD5_F, b, c, d, a, m[11], 0x895cd7be, 22)
+	MD5_STEP(MD5_F, a, b, c, d, m[12], 0x6b901122, 7)
+	MD5_STEP(MD5_F, d, a, b, c, m[13], 0xfd987193, 12)
+	MD5_STEP(MD5_F, c, d, a, b, m[14], 0xa679438e, 17)
+	MD5_STEP(MD5_F, b, c, d, a, m[15], 0x49b40821, 22)
+	MD5_STEP(MD5_G, a, b, c, d, m[1], 0xf61e2562, 5)
+	MD5_STEP(MD5_G, d, a, b, c, m[6], 0xc040b340, 9)
+	MD5_STEP(MD5_G, c, d, a, b, m[11], 0x265e5a51, 14)
+	MD5_STEP(MD5_G, b, c, d, a, m[0], 0xe9b6c7aa, 20)
+	MD5_STEP(MD5_G, a, b, c, d, m[5], 0xd62f105d, 5)
+	MD5_STEP(MD5_G, d, a, b, c, m[10], 0x02441453, 9)
+	MD5_STEP(MD5_G, c, d, a, b, m[15], 0xd8a1e681, 14)
+	MD5_STEP(MD5_G, b, c, d, a, m[4], 0xe7d3fbc8, 20)
+	MD5_STEP(MD5_G, a, b, c, d, m[9], 0x21e1cde6, 5)
+	MD5_STEP(MD5_G, d, a, b, c, m[14], 0xc33707d6, 9)
+	MD5_STEP(MD5_G, c, d, a, b, m[3], 0xf4d50d87, 14)
+	MD5_STEP(MD5_G, b, c, d, a, m[8], 0x455a14ed, 20)
+	MD5_STEP(MD5_G, a, b, c, d, m[13], 0xa9e3e905, 5)
+	MD5_STEP(MD5_G, d, a, b, c, m[2], 0xfcefa3f8, 9)
+	MD5_STEP(MD5_G, c, d, a, b, m[7], 0x676f02d9, 14)
+	MD5_STEP(MD5_G, b, c, d, a, m[12], 0x8d2a4c8a, 20)
+	MD5_STEP(MD5_H, a, b, c, d, m[5], 0xfffa3942, 4)
+	MD5_STEP(MD5_H, d, a, b, c, m[8], 0x8771f681, 11)
+	MD5_STEP(MD5_H, c, d, a, b, m[11], 0x6d9d6122, 16)
+	MD5_STEP(MD5_H, b, c, d, a, m[14], 0xfde5380c, 23)
+	MD5_STEP(MD5_H, a, b, c, d, m[1], 0xa4beea44, 4)
+	MD5_STEP(MD5_H, d, a, b, c, m[4], 0x4bdecfa9, 11)
+	MD5_STEP(MD5_H, c, d, a, b, m[7], 0xf6bb4b60, 16)
+	MD5_STEP(MD5_H, b, c, d, a, m[10], 0xbebfbc70, 23)
+	MD5_STEP(MD5_H, a, b, c, d, m[13], 0x289b7ec6, 4)
+	MD5_STEP(MD5_H, d, a, b, c, m[0], 0xeaa127fa, 11)
+	MD5_STEP(MD5_H, c, d, a, b, m[3], 0xd4ef3085, 16)
+	MD5_STEP(MD5_H, b, c, d, a, m[6], 0x04881d05, 23)
+	MD5_STEP(MD5_H, a, b, c, d, m[9], 0xd9d4d039, 4)
+	MD5_STEP(MD5_H, d, a, b, c, m[12], 0xe6db99e5, 11)
+	MD5_STEP(MD5_H, c, d, a, b, m[15], 0x1fa27cf8, 16)
+	MD5_STEP(MD5_H, b, c, d, a, m[2], 0xc4ac5665, 23)
+	MD5_STEP(MD5_I, a, b, c, d, m[0], 0xf4292244, 6)
+	MD5_STEP(MD5_I, d, a, b, c, m[7], 0x432aff97, 10)
+	MD5_STEP(MD5_I, c, d, a, b, m[14], 0xab9423a7, 15)
+	MD5_STEP(MD5_I, b, c, d, a, m[5], 0xfc93a039, 21)
+	MD5_STEP(MD5_I, a, b, c, d, m[12], 0x655b59c3, 6)
+	MD5_STEP(MD5_I, d, a, b, c, m[3], 0x8f0ccc92, 10)
+	MD5_STEP(MD5_I, c, d, a, b, m[10], 0xffeff47d, 15)
+	MD5_STEP(MD5_I, b, c, d, a, m[1], 0x85845dd1, 21)
+	MD5_STEP(MD5_I, a, b, c, d, m[8], 0x6fa87e4f, 6)
+	MD5_STEP(MD5_I, d, a, b, c, m[15], 0xfe2ce6e0, 10)
+	MD5_STEP(MD5_I, c, d, a, b, m[6], 0xa3014314, 15)
+	MD5_STEP(MD5_I, b, c, d, a, m[13], 0x4e0811a1, 21)
+	MD5_STEP(MD5_I, a, b, c, d, m[4], 0xf7537e82, 6)
+	MD5_STEP(MD5_I, d, a, b, c, m[11], 0xbd3af235, 10)
+	MD5_STEP(MD5_I, c, d, a, b, m[2], 0x2ad7d2bb, 15)
+	MD5_STEP(MD5_I, b, c, d, a, m[9], 0xeb86d391, 21)
+	state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+}
+
+// message schedule kept in a 16 word ring, expanded as the rounds consume it
+#define SHA1_W(i) (w[(i) & 15] = rotl(w[((i) + 13) & 15] ^ w[((i) + 8) & 15] ^ w[((i) + 2) & 15] ^ w[(i) & 15], 1))
+#define SHA1_STEP(f, k, a, b, c, d, e, x) e += rotl(a, 5) + f(b, c, d) + k + x; b = rotl(b, 30);
+#define SHA1_CH(x, y, z) (z ^ (x & (y ^ z)))
+#define SHA1_PARITY(x, y, z) (x ^ y ^ z)
+#define SHA1_MAJ(x, y, z) ((x & y) | (z & (x | y)))
+#define SHA1_5STEPS(f, k, i, x) \
+	SHA1_STEP(f, k, a, b, c, d, e, x(i)) \
+	SHA1_STEP(f, k, e, a, b, c, d, x(i + 1)) \
+	SHA1_STEP(f, k, d, e, a, b, c, x(i + 2)) \
+	SHA1_STEP(f, k, c, d, e, a, b, x(i + 3)) \
+	SHA1_STEP(f, k, b, c, d, e, a, x(i + 4))
+#define SHA1_W0(i) w[i]
+
+static void sha1Block(uint32_t state[5], const uint8_t *block)
+{
+	uint32_t w[16];
+	for(int i = 0; i < 16; i++)
+		w[i] = loadBE32(block + i * 4);
+	uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+	SHA1_5STEPS(SHA1_CH, 0x5a827999, 0, SHA1_W0)
+	SHA1_5STEPS(SHA1_CH, 0x5a827999, 5, SHA1_W0)
+	SHA1_5STEPS(SHA1_CH, 0x5a827999, 10, SHA1_W0)
+	SHA1_STEP(SHA1_CH, 0x5a827999, a, b, c, d, e, w[15])
+	SHA1_STEP(SHA1_CH, 0x5a827999, e, a, b, c, d, SHA1_W(16))
+	SHA1_STEP(SHA1_CH, 0x5a827999, d, e, a, b, c, SHA1_W(17))
+	SHA1_STEP(SHA1_CH, 0x5a827999, c, d, e, a, b, SHA1_W(18))
+	SHA1_STEP(SHA1_CH, 0x5a827999, b, c, d, e, a, SHA1_W(19))
+	SHA1_5STEPS(SHA1_PARITY, 0x6ed9eba1, 20, SHA1_W)
+	SHA1_5STEPS(SHA1_PARITY, 0x6ed9eba1, 25, SHA1_W)
+	SHA1_5STEPS(SHA1_PARITY, 0x6ed9eba1, 30, SHA1_W)
+	SHA1_5STEPS(SHA1_PARITY, 0x6ed9eba1, 35, SHA1_W)
+	SHA1_5STEPS(SHA1_MAJ, 0x8f1bbcdc, 40, SHA1_W)
+	SHA1_5STEPS(SHA1_MAJ, 0x8f1bbcdc, 45, SHA1_W)
+	SHA1_5STEPS(SHA1_MAJ, 0x8f1bbcdc, 50, SHA1_W)
+	SHA1_5STEPS(SHA1_MAJ, 0x8f1bbcdc, 55, SHA1_W)
+	SHA1_5STEPS(SHA1_PARITY, 0xca62c1d6, 60, SHA1_W)
+	SHA1_5STEPS(SHA1_PARITY, 0xca62c1d6, 65, SHA1_W)
+	SHA1_5STEPS(SHA1_PARITY, 0xca62c1d6, 70, SHA1_W)
+	SHA1_5STEPS(SHA1_PARITY, 0xca62c1d6, 75, SHA1_W)
+	state[0] += a; state[1] += b; state[2] += c; state[3] += d; state[4] += e;
+}
+
+RomHasher::RomHasher():
+	md5State{0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476},
+	sha1State{0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0}
+{}
+
+void RomHasher::processBlock(const uint8_t *block)
+{
+	// MD5 & SHA-1 share the same 64 byte block size so each block is only touched once
+	md5Block(md5State, block);
+	sha1Block(sha1State, block);
+}
+
+void RomHasher::update(const void *dataPtr, size_t size)
+{
+	auto data = (const uint8_t*)dataPtr;
+	bytes += size;
+	// zlib's CRC32 takes a 32-bit length
+	for(size_t pos = 0; pos < size;)
+	{
+		auto len = std::min<size_t>(size - pos, 0x40000000);
+		crc = ::crc32(crc, data + pos, len);
+		pos += len;
+	}
+	if(blockSize)
+	{
+		auto copySize = std::min<size_t>(64 - blockSize, size);
+		memcpy(block + blockSize, data, copySize);
+		blockSize += copySize;
+		data += copySize;
+		size -= copySize;
+		if(blockSize < 64)
+			return;
+		processBlock(block);
+		blockSize = 0;
+	}
+	for(; size >= 64; data += 64, size -= 64)
+	{
+		processBlock(data);
+	}
+	memcpy(block, data, size);
+	blockSize = size;
+}
+
+RomDigest RomHasher::finish()
+{
+	uint64_t bits = bytes * 8;
+	block[blockSize++] = 0x80;
+	if(blockSize > 56)
+	{
+		memset(block + blockSize, 0, 64 - blockSize);
+		processBlock(block);
+		blockSize = 0;
+	}
+	memset(block + blockSize, 0, 56 - blockSize);
+	// MD5 stores the bit count little-endian and SHA-1 big-endian so the final block differs
+	uint8_t sha1Final[64];
+	memcpy(sha1Final, block, 56);
+	storeLE32(block + 56, bits);
+	storeLE32(block + 60, bits >> 32);
+	md5Block(md5State, block);
+	storeBE32(sha1Final + 56, bits >> 32);
+	storeBE32(sha1Final + 60, bits);
+	sha1Block(sha1State, sha1Final);
+	RomDigest digest;
+	digest.crc32 = crc;
+	for(int i = 0; i < 4; i++)
+		storeLE32(&digest.md5[i * 4], md5State[i]);
+	for(int i = 0; i < 5; i++)
+		storeBE32(&digest.sha1[i * 4], sha1State[i]);
+	*this = {};
+	return digest;
+}
+
+uint64_t RomDigest::md5Lower64() const
+{
+	uint64_t val = 0;
+	for(int i = 0; i < 8; i++)
+		val |= (uint64_t)md5[15 - i] << (i * 8);
+	return val;
+}
+
+std::array<char, 33> RomDigest::md5String() const
+{
+	static constexpr char hex[] = "0123456789abcdef";
+	std::array<char, 33> str{};
+	for(int i = 0; i < 16; i++)
+	{
+		str[i * 2] = hex[md5[i] >> 4];
+		str[i * 2 + 1] = hex[md5[i] & 0xf];
+	}
+	return str;
+}
+
+std::array<uint32_t, 5> RomDigest::sha1Words() const
+{
+	std::array<uint32_t, 5> words;
+	for(int i = 0; i < 5; i++)
+		words[i] = loadBE32(&sha1[i * 4]);
+	return words;
+}
+
+RomDigest makeRomDigest(const void *data, size_t size)
+{
+	RomHasher hasher;
+	hasher.update(data, size);
+	return hasher.finish();
+}
+
+struct RomDigestCacheEntry
+{
+	FS::PathString path{};
+	FS::FileString subPath{};
+	size_t size = 0;
+	FS::file_time_type mtime{};
+	RomDigest digest{};
+};
+
+static std::array<RomDigestCacheEntry, 8> digestCache{};
+static unsigned digestCacheNext = 0;
+static std::mutex digestCacheMutex{};
+
+RomDigest makeRomDigest(const void *data, size_t size, const char *path, const char *subPath)
+{
+	std::error_code ec{};
+	auto status = FS::status(path, ec);
+	if(ec)
+	{
+		return makeRomDigest(data, size);
+	}
+	if(!subPath)
+		subPath = "";
+	{
+		std::lock_guard<std::mutex> lock{digestCacheMutex};
+		for(const auto &e : digestCache)
+		{
+			if(e.size == size && e.mtime == status.lastWriteTime() && string_equal(e.path.data(), path)
+				&& string_equal(e.subPath.data(), subPath))
+			{
+				logMsg("using cached digest of %s", path);
+				return e.digest;
+			}
+		}
+	}
+	auto digest = makeRomDigest(data, size);
+	std::lock_guard<std::mutex> lock{digestCacheMutex};
+	auto &e = digestCache[digestCacheNext++ % digestCache.size()];
+	string_copy(e.path, path);
+	string_copy(e.subPath, subPath);
+	e.size = size;
+	e.mtime = status.lastWriteTime();
+	e.digest = digest;
+	return digest;
+}
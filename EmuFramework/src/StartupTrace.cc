@@ -0,0 +1,82 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "StartupTrace"
+#include "StartupTrace.hh"
+#include <imagine/io/FileIO.hh>
+#include <imagine/logger/logger.h>
+#include <imagine/util/string.h>
+#include <cstring>
+
+StartupTrace startupTrace{};
+
+void StartupTrace::start()
+{
+	startTime = lastTime = IG::steadyClockTimestamp();
+	phaseCount = 0;
+	active = true;
+}
+
+void StartupTrace::mark(const char *phase)
+{
+	if(!active)
+		return;
+	auto now = IG::steadyClockTimestamp();
+	if(phaseCount < phases.size())
+		phases[phaseCount++] = {phase, std::chrono::duration_cast<IG::Microseconds>(now - lastTime)};
+	lastTime = now;
+}
+
+void StartupTrace::finish(const char *phase)
+{
+	if(!active)
+		return;
+	mark(phase);
+	active = false;
+	auto total = std::chrono::duration_cast<IG::Microseconds>(lastTime - startTime);
+	for(size_t i = 0; i < phaseCount; i++)
+	{
+		logMsg("%s: %lldus", phases[i].name, (long long)phases[i].duration.count());
+	}
+	logMsg("total: %lldus", (long long)total.count());
+	if(outputPath)
+		writeJSON(total);
+}
+
+void StartupTrace::setOutputPath(const char *path)
+{
+	outputPath = path;
+}
+
+void StartupTrace::writeJSON(IG::Microseconds total) const
+{
+	FileIO io;
+	if(auto ec = io.create(outputPath);
+		ec)
+	{
+		logErr("error creating trace file:%s", outputPath);
+		return;
+	}
+	auto writeStr = [&](const char *str){ io.write(str, strlen(str)); };
+	writeStr("{\n\t\"phases\": [\n");
+	for(size_t i = 0; i < phaseCount; i++)
+	{
+		auto line = string_makePrintf<128>("\t\t{\"name\": \"%s\", \"us\": %lld}%s\n",
+			phases[i].name, (long long)phases[i].duration.count(), i + 1 == phaseCount ? "" : ",");
+		writeStr(line.data());
+	}
+	writeStr(string_makePrintf<64>("\t],\n\t\"total_us\": %lld\n}\n", (long long)total.count()).data());
+	logMsg("wrote trace file:%s", outputPath);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/time/Time.hh>
+#include <array>
+
+// Records the time spent in each phase of app startup until the first frame
+// of the main window is drawn, then logs the results and optionally writes
+// them as JSON (enabled with the --startup-trace=<file> command line arg)
+
+class StartupTrace
+{
+public:
+	constexpr StartupTrace() {}
+	void start();
+	void mark(const char *phase);
+	void finish(const char *phase);
+	void setOutputPath(const char *path);
+	bool isActive() const { return active; }
+
+protected:
+	struct Phase
+	{
+		const char *name;
+		IG::Microseconds duration;
+	};
+	std::array<Phase, 24> phases{};
+	size_t phaseCount = 0;
+	IG::Time startTime{};
+	IG::Time lastTime{};
+	const char *outputPath{};
+	bool active = false;
+
+	void writeJSON(IG::Microseconds total) const;
+};
+
+extern StartupTrace startupTrace;
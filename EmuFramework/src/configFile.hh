@@ -16,59 +16,70 @@
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <imagine/io/FileIO.hh>
+#include <imagine/logger/logger.h>
+#include <vector>
 
-template<class ON_KEY>
-static bool readConfigKeys(IO &io, ON_KEY onKey)
-{
-	auto blockSize = io.get<uint8_t>();
-	auto fileBytesLeft = io.size() - 1;
+// Config files are a header byte followed by blocks of [uint16 size][uint16 key][data].
+// Saving only appends the blocks that changed since the file was last written,
+// ending each batch with a commit block holding a CRC32 of the batch so one
+// cut short by a crash or power loss is ignored when loading. A later block
+// replaces an earlier one with the same key and a block without data
+// removes its key. Once superseded blocks make up most of the file, it's
+// rewritten to a temporary file that's renamed over the original.
 
-	if(blockSize != 2)
-	{
-		logErr("can't read config with block size %d", blockSize);
-		return false;
-	}
+static constexpr uint16_t CFGKEY_COMMIT = 0xFFFF;
 
-	while(!io.eof() && fileBytesLeft >= 2)
-	{
-		auto size = io.get<uint16_t>();
-		auto nextBlockPos = io.tell() + size;
+struct ConfigBlock
+{
+	uint16_t key;
+	uint16_t size; // data size, excluding the key
+	off_t offset; // offset of the data
+};
 
-		if(!size)
-		{
-			logMsg("invalid 0 size block, skipping rest of config");
-			return false;
-		}
+// returns the current blocks in the order last written, or false if the header is invalid
+bool readConfigIndex(IO &io, std::vector<ConfigBlock> &blocks);
 
-		if(size > fileBytesLeft)
-		{
-			logErr("size of key exceeds rest of file, skipping rest of config");
-			return false;
-		}
-		fileBytesLeft -= size;
+// appends the blocks of a complete config image (including its header) that
+// differ from the file at path, creating or compacting it as needed
+bool writeConfigFile(const char *path, const void *image, size_t imageSize);
 
-		if(size < 3) // all blocks are at least a 2 byte key + 1 byte or more of data
-		{
-			logMsg("skipping %d byte block", size);
-			if(io.seekC(size) == -1)
-			{
-				logErr("unable to seek to next block, skipping rest of config");
-				return false;
-			}
-			continue;
-		}
+// in-memory IO used to build a config image for writeConfigFile()
+class ConfigImageIO final : public IO
+{
+public:
+	using IO::read;
+	using IO::write;
+	using IO::seek;
 
-		auto key = io.get<uint16_t>();
-		size -= 2;
+	ssize_t read(void *buff, size_t bytes, std::error_code *ecOut) final;
+	ssize_t write(const void *buff, size_t bytes, std::error_code *ecOut) final;
+	off_t seek(off_t offset, SeekMode mode, std::error_code *ecOut) final;
+	void close() final;
+	size_t size() final;
+	bool eof() final;
+	explicit operator bool() const final;
+	const uint8_t *data() const { return buff.data(); }
 
-		logMsg("got config key %u, size %u", key, size);
-		onKey(key, size, io);
+private:
+	std::vector<uint8_t> buff{};
+	size_t pos = 0;
+};
 
-		if(io.seekS(nextBlockPos) == -1)
+template<class ON_KEY>
+static bool readConfigKeys(IO &io, ON_KEY onKey)
+{
+	std::vector<ConfigBlock> blocks;
+	if(!readConfigIndex(io, blocks))
+		return false;
+	for(auto &b : blocks)
+	{
+		if(io.seekS(b.offset) == -1)
 		{
-			logErr("unable to seek to next block, skipping rest of config");
+			logErr("unable to seek to block, skipping rest of config");
 			return false;
 		}
+		logMsg("got config key %u, size %u", b.key, b.size);
+		onKey(b.key, b.size, io);
 	}
 	return true;
 }
@@ -76,7 +76,7 @@ public:
 	void placeElements();
 	void setEmuViewOnExtraWindow(bool on, Base::Screen &screen);
 	void startMainViewportAnimation();
-	void updateEmuAudioStats(uint underruns, uint overruns, uint callbacks, double avgCallbackFrames, uint frames);
+	void updateEmuAudioStats(const EmuAudio::Stats &stats);
 	void clearEmuAudioStats();
 	void closeSystem(bool allowAutosaveState = true);
 	void popToSystemActionsMenu();
@@ -103,6 +103,7 @@ public:
 	void updateAutoOnScreenControlVisible();
 	void setPhysicalControlsPresent(bool present);
 	void setFastForwardActive(bool active);
+	void benchmarkInputMovie();
 
 protected:
 	static constexpr bool HAS_USE_RENDER_TIME = Config::envIsLinux
@@ -152,6 +153,8 @@ extern RecentGameList recentGameList;
 static constexpr const char *strftimeFormat = "%x  %r";
 
 EmuViewController &emuViewController();
+// false in headless runs
+bool hasEmuViewController();
 void loadConfigFile();
 void saveConfigFile();
 void addRecentGame(const char *fullPath, const char *name);
@@ -164,6 +167,8 @@ bool hasGooglePlayStoreFeatures();
 void setCPUNeedsLowLatency(bool needed);
 void onMainMenuItemOptionChanged();
 void runBenchmarkOneShot();
+// returns false if no --regression arg was given, otherwise runs the tests and exits
+bool runRegressionFromCmdLine(int argc, char **argv);
 void onSelectFileFromPicker(const char* name, Input::Event e, EmuSystemCreateParams params);
 void launchSystem(bool tryAutoState, bool addToRecent);
 Gfx::PixmapTexture &getAsset(Gfx::Renderer &r, AssetID assetID);
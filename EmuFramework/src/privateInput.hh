@@ -133,6 +133,8 @@ extern uint pointerInputPlayer;
 #endif
 
 void processRelPtr(Input::Event e);
+// passes an action to the system, going through any active input movie
+void dispatchInputAction(uint state, uint emuKey);
 void commonInitInput();
 void commonUpdateInput();
 void updateInputDevices();
@@ -0,0 +1,259 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+// Converts a BIN/CUE disc image with 2352 byte sectors to the .cdz format read by
+// CompressedCDImage, build with: c++ -std=c++17 -O2 mkcdz.cc -lz -o mkcdz
+
+#include <zlib.h>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static constexpr char MAGIC[8]{'E', 'X', 'C', 'D', 'Z', 'I', 'M', 'G'};
+static constexpr uint32_t SECTOR_SIZE = 2352;
+static constexpr uint32_t HUNK_SECTORS = 8;
+
+struct Header
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t sectorSize;
+	uint32_t hunkSectors;
+	uint32_t sectors;
+	uint32_t tracks;
+	uint32_t reserved;
+};
+
+struct Track
+{
+	uint8_t number;
+	uint8_t type;
+	uint16_t reserved;
+	uint32_t lba;
+	uint32_t sectors;
+	uint32_t pregap;
+};
+
+struct CueTrack
+{
+	std::string file;
+	Track track{};
+	uint32_t fileSector{}; // INDEX 01 position in file
+	uint32_t index0Sectors{}; // INDEX 00 sectors present in file
+	uint32_t pregapSectors{}; // PREGAP sectors absent from file
+};
+
+static uint32_t msfToSectors(const char *msf)
+{
+	unsigned m = 0, s = 0, f = 0;
+	sscanf(msf, "%u:%u:%u", &m, &s, &f);
+	return (m * 60 + s) * 75 + f;
+}
+
+static long fileSectors(const std::string &path)
+{
+	FILE *f = fopen(path.c_str(), "rb");
+	if(!f)
+		return -1;
+	fseek(f, 0, SEEK_END);
+	long size = ftell(f);
+	fclose(f);
+	return size / SECTOR_SIZE;
+}
+
+static bool parseCue(const char *cuePath, std::vector<CueTrack> &tracks)
+{
+	FILE *cue = fopen(cuePath, "r");
+	if(!cue)
+	{
+		fprintf(stderr, "can't open %s\n", cuePath);
+		return false;
+	}
+	std::string dir{cuePath};
+	auto slash = dir.find_last_of('/');
+	dir = slash == std::string::npos ? "" : dir.substr(0, slash + 1);
+	std::string currFile;
+	char line[1024];
+	while(fgets(line, sizeof(line), cue))
+	{
+		char arg1[512]{}, arg2[64]{};
+		const char *cmd = line + strspn(line, " \t");
+		if(!strncmp(cmd, "FILE", 4))
+		{
+			auto start = strchr(cmd, '"'), end = strrchr(cmd, '"');
+			if(!start || end == start)
+				return false;
+			currFile = dir + std::string{start + 1, end};
+		}
+		else if(sscanf(cmd, "TRACK %511s %63s", arg1, arg2) == 2)
+		{
+			CueTrack t;
+			t.file = currFile;
+			t.track.number = atoi(arg1);
+			if(!strcmp(arg2, "AUDIO"))
+				t.track.type = 0;
+			else if(!strcmp(arg2, "MODE1/2352"))
+				t.track.type = 1;
+			else if(!strcmp(arg2, "MODE2/2352"))
+				t.track.type = 2;
+			else
+			{
+				fprintf(stderr, "unsupported track type %s\n", arg2);
+				return false;
+			}
+			tracks.push_back(t);
+		}
+		else if(sscanf(cmd, "INDEX %511s %63s", arg1, arg2) == 2 && tracks.size())
+		{
+			auto index = atoi(arg1);
+			auto pos = msfToSectors(arg2);
+			if(index == 0)
+				tracks.back().index0Sectors = pos;
+			else if(index == 1)
+			{
+				tracks.back().index0Sectors = tracks.back().index0Sectors ? pos - tracks.back().index0Sectors : 0;
+				tracks.back().fileSector = pos;
+			}
+		}
+		else if(sscanf(cmd, "PREGAP %63s", arg2) == 1 && tracks.size())
+		{
+			tracks.back().pregapSectors = msfToSectors(arg2);
+		}
+	}
+	fclose(cue);
+	return tracks.size();
+}
+
+int main(int argc, char **argv)
+{
+	if(argc != 3)
+	{
+		fprintf(stderr, "usage: %s input.cue output.cdz\n", argv[0]);
+		return 1;
+	}
+	std::vector<CueTrack> cueTracks;
+	if(!parseCue(argv[1], cueTracks))
+		return 1;
+
+	// lay out the disc, each track's data runs until the next track in the same file or the file end
+	std::vector<Track> tracks;
+	uint32_t lba = 0;
+	for(size_t i = 0; i < cueTracks.size(); i++)
+	{
+		auto &t = cueTracks[i];
+		long endSector;
+		if(i + 1 < cueTracks.size() && cueTracks[i + 1].file == t.file)
+			endSector = cueTracks[i + 1].fileSector - cueTracks[i + 1].index0Sectors;
+		else
+			endSector = fileSectors(t.file);
+		if(endSector < (long)t.fileSector)
+		{
+			fprintf(stderr, "invalid track %d layout\n", t.track.number);
+			return 1;
+		}
+		lba += t.pregapSectors + t.index0Sectors;
+		t.track.pregap = t.pregapSectors + t.index0Sectors;
+		t.track.lba = lba;
+		t.track.sectors = endSector - t.fileSector;
+		lba += t.track.sectors;
+		tracks.push_back(t.track);
+	}
+	uint32_t totalSectors = lba;
+	uint32_t hunks = (totalSectors + HUNK_SECTORS - 1) / HUNK_SECTORS;
+
+	FILE *out = fopen(argv[2], "wb");
+	if(!out)
+	{
+		fprintf(stderr, "can't create %s\n", argv[2]);
+		return 1;
+	}
+	Header header{};
+	memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = 1;
+	header.sectorSize = SECTOR_SIZE;
+	header.hunkSectors = HUNK_SECTORS;
+	header.sectors = totalSectors;
+	header.tracks = tracks.size();
+	fwrite(&header, sizeof(header), 1, out);
+	fwrite(tracks.data(), sizeof(Track), tracks.size(), out);
+	std::vector<uint64_t> hunkOffset(hunks + 1);
+	auto indexPos = ftell(out);
+	fwrite(hunkOffset.data(), sizeof(uint64_t), hunkOffset.size(), out);
+
+	// stream all sectors in disc order, generating silent sectors for PREGAP entries
+	std::vector<uint8_t> hunk(HUNK_SECTORS * SECTOR_SIZE);
+	std::vector<uint8_t> comp(compressBound(hunk.size()) + 64);
+	uint32_t hunkFill = 0, hunkIdx = 0;
+	auto flushHunk = [&]()
+	{
+		uint32_t bytes = hunkFill * SECTOR_SIZE;
+		z_stream s{};
+		deflateInit2(&s, 9, Z_DEFLATED, -MAX_WBITS, 9, Z_DEFAULT_STRATEGY);
+		s.next_in = hunk.data();
+		s.avail_in = bytes;
+		s.next_out = comp.data();
+		s.avail_out = comp.size();
+		deflate(&s, Z_FINISH);
+		uint32_t compBytes = s.total_out;
+		deflateEnd(&s);
+		hunkOffset[hunkIdx] = ftell(out);
+		if(compBytes >= bytes)
+			fwrite(hunk.data(), 1, bytes, out);
+		else
+			fwrite(comp.data(), 1, compBytes, out);
+		hunkIdx++;
+		hunkFill = 0;
+	};
+	auto addSector = [&](const uint8_t *data)
+	{
+		if(data)
+			memcpy(&hunk[hunkFill * SECTOR_SIZE], data, SECTOR_SIZE);
+		else
+			memset(&hunk[hunkFill * SECTOR_SIZE], 0, SECTOR_SIZE);
+		if(++hunkFill == HUNK_SECTORS)
+			flushHunk();
+	};
+	uint8_t sector[SECTOR_SIZE];
+	for(auto &t : cueTracks)
+	{
+		for(uint32_t i = 0; i < t.pregapSectors; i++)
+			addSector(nullptr);
+		FILE *in = fopen(t.file.c_str(), "rb");
+		if(!in)
+		{
+			fprintf(stderr, "can't open %s\n", t.file.c_str());
+			return 1;
+		}
+		fseek(in, (long)(t.fileSector - t.index0Sectors) * SECTOR_SIZE, SEEK_SET);
+		for(uint32_t i = 0; i < t.index0Sectors + t.track.sectors; i++)
+		{
+			if(fread(sector, SECTOR_SIZE, 1, in) != 1)
+				memset(sector, 0, SECTOR_SIZE);
+			addSector(sector);
+		}
+		fclose(in);
+	}
+	if(hunkFill)
+		flushHunk();
+	hunkOffset[hunks] = ftell(out);
+	fseek(out, indexPos, SEEK_SET);
+	fwrite(hunkOffset.data(), sizeof(uint64_t), hunkOffset.size(), out);
+	fclose(out);
+	printf("wrote %u sectors in %u tracks, %llu bytes\n", totalSectors, (unsigned)tracks.size(),
+		(unsigned long long)hunkOffset[hunks]);
+	return 0;
+}
@@ -154,6 +154,27 @@ public:
 	  */
 	bool loadState(std::string const &filepath);
 
+	/**
+	  * Size of the buffer needed by saveStateToMemory(), constant while
+	  * the same ROM is loaded. Returns 0 if no ROM is loaded.
+	  */
+	std::size_t stateSize() const;
+
+	/**
+	  * Saves emulator state to 'buf' in a compact binary layout without a
+	  * thumbnail, for rewind and similar uses that keep states in memory.
+	  * Does no file I/O or memory allocation.
+	  * @return success, false if bufsize is less than stateSize()
+	  */
+	bool saveStateToMemory(void *buf, std::size_t bufsize);
+
+	/**
+	  * Loads emulator state saved by saveStateToMemory() with the same ROM.
+	  * Unlike loadState(), doesn't write persistent cartridge data to disk.
+	  * @return success
+	  */
+	bool loadStateFromMemory(void const *buf, std::size_t bufsize);
+
 	/**
 	  * Selects which state slot to save state to or load state from.
 	  * There are 10 such slots, numbered from 0 to 9 (periodically extended for all n).
@@ -195,6 +195,41 @@ bool GB::saveState(gambatte::uint_least32_t const *videoBuf, std::ptrdiff_t pitc
 	return false;
 }
 
+std::size_t GB::stateSize() const {
+	if (p_->cpu.loaded()) {
+		SaveState state;
+		p_->cpu.setStatePtrs(state);
+		return StateSaver::stateSize(state);
+	}
+
+	return 0;
+}
+
+bool GB::saveStateToMemory(void *const buf, std::size_t const bufsize) {
+	if (p_->cpu.loaded()) {
+		SaveState state;
+		p_->cpu.setStatePtrs(state);
+		p_->cpu.saveState(state);
+		return StateSaver::saveState(state, buf, bufsize);
+	}
+
+	return false;
+}
+
+bool GB::loadStateFromMemory(void const *const buf, std::size_t const bufsize) {
+	if (p_->cpu.loaded()) {
+		SaveState state = SaveState();
+		p_->cpu.setStatePtrs(state);
+
+		if (StateSaver::loadState(state, buf, bufsize)) {
+			p_->cpu.loadState(state);
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void GB::selectState(int n) {
 	n -= (n / 10) * 10;
 	p_->stateNo = n < 0 ? n + 10 : n;
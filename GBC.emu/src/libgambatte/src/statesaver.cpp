@@ -46,6 +46,10 @@ struct Saver {
 	void (*save)(std::ofstream &file, SaveState const &state);
 	void (*load)(std::ifstream &file, SaveState &state);
 	std::size_t labelsize;
+	// raw copies for in-memory states, without labels or size fields
+	void (*saveRaw)(unsigned char *&dst, SaveState const &state);
+	void (*loadRaw)(unsigned char const *&src, SaveState &state);
+	std::size_t (*rawsize)(SaveState const &state);
 };
 
 inline bool operator<(Saver const &l, Saver const &r) {
@@ -152,6 +156,16 @@ void read(std::ifstream &file, bool *buf, std::size_t bufsize) {
 	file.ignore(size - minsize);
 }
 
+void putRaw(unsigned char *&dst, void const *data, std::size_t size) {
+	std::memcpy(dst, data, size);
+	dst += size;
+}
+
+void getRaw(unsigned char const *&src, void *data, std::size_t size) {
+	std::memcpy(data, src, size);
+	src += size;
+}
+
 } // anon namespace
 
 namespace gambatte {
@@ -174,8 +188,11 @@ private:
 static void push(SaverList::list_t &list, char const *label,
 		void (*save)(std::ofstream &file, SaveState const &state),
 		void (*load)(std::ifstream &file, SaveState &state),
-		std::size_t labelsize) {
-	Saver saver = { label, save, load, labelsize };
+		std::size_t labelsize,
+		void (*saveRaw)(unsigned char *&dst, SaveState const &state),
+		void (*loadRaw)(unsigned char const *&src, SaveState &state),
+		std::size_t (*rawsize)(SaveState const &state)) {
+	Saver saver = { label, save, load, labelsize, saveRaw, loadRaw, rawsize };
 	list.push_back(saver);
 }
 
@@ -186,8 +203,16 @@ SaverList::SaverList()
 	struct Func { \
 		static void save(std::ofstream &file, SaveState const &state) { write(file, state.arg); } \
 		static void load(std::ifstream &file, SaveState &state) { read(file, state.arg); } \
+		static void saveRaw(unsigned char *&dst, SaveState const &state) { \
+			putRaw(dst, &state.arg, sizeof state.arg); \
+		} \
+		static void loadRaw(unsigned char const *&src, SaveState &state) { \
+			getRaw(src, &state.arg, sizeof state.arg); \
+		} \
+		static std::size_t rawsize(SaveState const &state) { return sizeof state.arg; } \
 	}; \
-	push(list, label, Func::save, Func::load, sizeof label); \
+	push(list, label, Func::save, Func::load, sizeof label, \
+		Func::saveRaw, Func::loadRaw, Func::rawsize); \
 } while (0)
 
 #define ADDPTR(arg) do { \
@@ -198,8 +223,18 @@ SaverList::SaverList()
 		static void load(std::ifstream &file, SaveState &state) { \
 			read(file, state.arg.ptr, state.arg.size()); \
 		} \
+		static void saveRaw(unsigned char *&dst, SaveState const &state) { \
+			putRaw(dst, state.arg.get(), rawsize(state)); \
+		} \
+		static void loadRaw(unsigned char const *&src, SaveState &state) { \
+			getRaw(src, state.arg.ptr, rawsize(state)); \
+		} \
+		static std::size_t rawsize(SaveState const &state) { \
+			return state.arg.size() * sizeof *state.arg.get(); \
+		} \
 	}; \
-	push(list, label, Func::save, Func::load, sizeof label); \
+	push(list, label, Func::save, Func::load, sizeof label, \
+		Func::saveRaw, Func::loadRaw, Func::rawsize); \
 } while (0)
 
 #define ADDARRAY(arg) do { \
@@ -210,8 +245,16 @@ SaverList::SaverList()
 		static void load(std::ifstream &file, SaveState &state) { \
 			read(file, state.arg, sizeof state.arg); \
 		} \
+		static void saveRaw(unsigned char *&dst, SaveState const &state) { \
+			putRaw(dst, state.arg, sizeof state.arg); \
+		} \
+		static void loadRaw(unsigned char const *&src, SaveState &state) { \
+			getRaw(src, state.arg, sizeof state.arg); \
+		} \
+		static std::size_t rawsize(SaveState const &state) { return sizeof state.arg; } \
 	}; \
-	push(list, label, Func::save, Func::load, sizeof label); \
+	push(list, label, Func::save, Func::load, sizeof label, \
+		Func::saveRaw, Func::loadRaw, Func::rawsize); \
 } while (0)
 
 	{ static char const label[] = { c,c,           NUL }; ADD(cpu.cycleCounter); }
@@ -422,7 +465,7 @@ bool StateSaver::loadState(SaveState &state, std::string const &filename) {
 	file.ignore(get24(file));
 
 	Array<char> const labelbuf(list.maxLabelsize());
-	Saver const labelbufSaver = { labelbuf, 0, 0, list.maxLabelsize() };
+	Saver const labelbufSaver = { labelbuf, 0, 0, list.maxLabelsize(), 0, 0, 0 };
 	SaverList::const_iterator done = list.begin();
 
 	while (file.good() && done != list.end()) {
@@ -446,3 +489,45 @@ bool StateSaver::loadState(SaveState &state, std::string const &filename) {
 
 	return true;
 }
+
+// In-memory layout: the payload size followed by every field of the list in
+// order, copied as is. Only meant for states kept by the same build.
+
+std::size_t StateSaver::stateSize(SaveState const &state) {
+	std::size_t size = sizeof(uint_least32_t);
+	for (SaverList::const_iterator it = list.begin(); it != list.end(); ++it)
+		size += (*it->rawsize)(state);
+
+	return size;
+}
+
+bool StateSaver::saveState(SaveState const &state, void *const buf, std::size_t const bufsize) {
+	std::size_t const size = stateSize(state);
+	if (bufsize < size)
+		return false;
+
+	unsigned char *dst = static_cast<unsigned char *>(buf);
+	uint_least32_t const payloadSize = size - sizeof payloadSize;
+	putRaw(dst, &payloadSize, sizeof payloadSize);
+	for (SaverList::const_iterator it = list.begin(); it != list.end(); ++it)
+		(*it->saveRaw)(dst, state);
+
+	return true;
+}
+
+bool StateSaver::loadState(SaveState &state, void const *const buf, std::size_t const bufsize) {
+	std::size_t const size = stateSize(state);
+	uint_least32_t payloadSize;
+	if (bufsize < size)
+		return false;
+
+	unsigned char const *src = static_cast<unsigned char const *>(buf);
+	getRaw(src, &payloadSize, sizeof payloadSize);
+	if (payloadSize != size - sizeof payloadSize)
+		return false;
+
+	for (SaverList::const_iterator it = list.begin(); it != list.end(); ++it)
+		(*it->loadRaw)(src, state);
+
+	return true;
+}
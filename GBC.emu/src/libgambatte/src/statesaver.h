@@ -40,6 +40,11 @@ public:
 			std::string const &filename);
 	static bool loadState(SaveState &state, std::string const &filename);
 
+	// binary in-memory states, no snapshot image or field labels
+	static std::size_t stateSize(SaveState const &state);
+	static bool saveState(SaveState const &state, void *buf, std::size_t bufsize);
+	static bool loadState(SaveState &state, void const *buf, std::size_t bufsize);
+
 private:
 	StateSaver();
 };
@@ -0,0 +1,186 @@
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License version 2 as
+//   published by the Free Software Foundation.
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//   GNU General Public License version 2 for more details.
+//
+//   You should have received a copy of the GNU General Public License
+//   version 2 along with this program; if not, write to the
+//   Free Software Foundation, Inc.,
+//   51 Franklin St, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+
+// Round trip check of GB::saveStateToMemory()/loadStateFromMemory(). Runs a
+// generated ROM that keeps the LCD, timer, WRAM, VRAM and a sound channel busy,
+// saves a state, and verifies that loading it reproduces the same video and
+// audio output bit for bit and saves back to an identical buffer.
+
+#include "gambatte.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// normally supplied by the frontend
+gambatte::uint_least32_t gbcToRgb32(unsigned const bgr15) {
+	unsigned const r = bgr15       & 0x1F;
+	unsigned const g = bgr15 >>  5 & 0x1F;
+	unsigned const b = bgr15 >> 10 & 0x1F;
+	return r << 19 | g << 11 | b << 3;
+}
+
+namespace {
+
+class NoInput : public gambatte::InputGetter {
+public:
+	virtual unsigned operator()() { return 0; }
+};
+
+std::vector<unsigned char> const makeRom(bool cgb) {
+	std::vector<unsigned char> rom(0x8000);
+	unsigned char const entry[] = { 0x00, 0xc3, 0x50, 0x01 }; // nop; jp $0150
+	std::memcpy(&rom[0x100], entry, sizeof entry);
+	std::memcpy(&rom[0x134], "STATETEST", 9);
+	rom[0x143] = cgb ? 0x80 : 0x00;
+	rom[0x147] = 0x00; // ROM only
+	rom[0x148] = 0x00; // 32 KiB
+	rom[0x149] = 0x00; // no RAM
+
+	unsigned char const program[] = {
+		0x3e, 0x80, 0xe0, 0x26, // ld a,$80; ldh (NR52),a
+		0x3e, 0x77, 0xe0, 0x24, // ld a,$77; ldh (NR50),a
+		0x3e, 0xff, 0xe0, 0x25, // ld a,$ff; ldh (NR51),a
+		0x3e, 0x80, 0xe0, 0x11, // ld a,$80; ldh (NR11),a
+		0x3e, 0xf3, 0xe0, 0x12, // ld a,$f3; ldh (NR12),a
+		0x3e, 0x05, 0xe0, 0x07, // ld a,$05; ldh (TAC),a
+		0x3e, 0xe4, 0xe0, 0x47, // ld a,$e4; ldh (BGP),a
+		0x3e, 0x91, 0xe0, 0x40, // ld a,$91; ldh (LCDC),a
+		0x11, 0x00, 0x80,       // ld de,$8000
+		0x21, 0x00, 0xc0,       // ld hl,$c000
+		// loop:
+		0x04,                   // inc b
+		0x78,                   // ld a,b
+		0x22,                   // ld (hl+),a
+		0x12,                   // ld (de),a
+		0x1c,                   // inc e
+		0xe0, 0x13,             // ldh (NR13),a
+		0xf0, 0x05,             // ldh a,(TIMA)
+		0xe0, 0x43,             // ldh (SCX),a
+		0xf0, 0x44,             // ldh a,(LY)
+		0xe0, 0x42,             // ldh (SCY),a
+		0x78,                   // ld a,b
+		0xe6, 0x3f,             // and $3f
+		0x20, 0x04,             // jr nz,+4
+		0x3e, 0x86,             // ld a,$86
+		0xe0, 0x14,             // ldh (NR14),a
+		0x7c,                   // ld a,h
+		0xfe, 0xd0,             // cp $d0
+		0x20, 0xe3,             // jr nz,loop
+		0x26, 0xc0,             // ld h,$c0
+		0x18, 0xdf              // jr loop
+	};
+	std::memcpy(&rom[0x150], program, sizeof program);
+
+	unsigned char headerSum = 0;
+	for (std::size_t i = 0x134; i < 0x14d; ++i)
+		headerSum = headerSum - rom[i] - 1;
+
+	rom[0x14d] = headerSum;
+	return rom;
+}
+
+struct Output {
+	std::vector<gambatte::uint_least32_t> video;
+	std::vector<gambatte::uint_least32_t> audio;
+};
+
+std::size_t const samplesPerFrame = 35112;
+
+// runs until 'frames' video frames have completed, so a state saved afterwards
+// is at a frame boundary and the next frame draws every line
+Output const runFrames(gambatte::GB &gb, unsigned frames) {
+	Output out;
+	std::vector<gambatte::uint_least32_t> videoBuf(160 * 144);
+	std::vector<gambatte::uint_least32_t> audioBuf(samplesPerFrame + 2064);
+	while (frames) {
+		std::size_t samples = samplesPerFrame;
+		std::ptrdiff_t const frameSample =
+			gb.runFor(&videoBuf[0], 160, &audioBuf[0], samples, {});
+		out.audio.insert(out.audio.end(), audioBuf.begin(), audioBuf.begin() + samples);
+		if (frameSample >= 0) {
+			out.video.insert(out.video.end(), videoBuf.begin(), videoBuf.end());
+			--frames;
+		}
+	}
+
+	return out;
+}
+
+int failures = 0;
+
+void check(bool cond, char const *mode, char const *what) {
+	if (!cond) {
+		std::printf("FAIL %s: %s\n", mode, what);
+		++failures;
+	}
+}
+
+void testRoundTrip(bool cgb) {
+	char const *const mode = cgb ? "CGB" : "DMG";
+	NoInput input;
+	gambatte::GB gb;
+	gb.setInputGetter(&input);
+	std::vector<unsigned char> const rom = makeRom(cgb);
+	if (gb.load(&rom[0], rom.size(), "statesaver_test.gb", cgb ? 0 : gambatte::GB::FORCE_DMG) != gambatte::LOADRES_OK) {
+		check(false, mode, "ROM load");
+		return;
+	}
+
+	check(gb.isCgb() == cgb, mode, "CGB mode");
+	runFrames(gb, 30);
+
+	std::size_t const size = gb.stateSize();
+	check(size > 0, mode, "non-zero state size");
+	std::vector<unsigned char> state(size), resaved(size);
+	check(!gb.saveStateToMemory(&state[0], size - 1), mode, "save rejects a short buffer");
+	check(gb.saveStateToMemory(&state[0], size), mode, "save");
+
+	Output const expected = runFrames(gb, 10);
+	check(!gb.loadStateFromMemory(&state[0], size - 1), mode, "load rejects a short buffer");
+	check(gb.loadStateFromMemory(&state[0], size), mode, "load");
+	check(gb.saveStateToMemory(&resaved[0], size), mode, "save after load");
+	check(state == resaved, mode, "re-saved state matches the loaded one");
+
+	Output const actual = runFrames(gb, 10);
+	check(expected.video == actual.video, mode, "video output after load is identical");
+	check(expected.audio == actual.audio, mode, "audio output after load is identical");
+
+	// the state must change with emulation, otherwise the comparisons above prove nothing
+	check(gb.saveStateToMemory(&resaved[0], size), mode, "save after running");
+	check(state != resaved, mode, "state changes while running");
+	bool audible = false;
+	for (std::size_t i = 0; i < actual.audio.size() && !audible; ++i)
+		audible = actual.audio[i] != actual.audio[0];
+
+	check(audible, mode, "test ROM produces audio");
+	std::printf("%s: %lu byte state, %lu frames, %lu samples compared\n", mode,
+	            static_cast<unsigned long>(size), static_cast<unsigned long>(actual.video.size() / (160 * 144)),
+	            static_cast<unsigned long>(actual.audio.size()));
+}
+
+} // anon namespace
+
+int main() {
+	testRoundTrip(true);
+	testRoundTrip(false);
+	if (failures) {
+		std::printf("%d check(s) failed\n", failures);
+		return 1;
+	}
+
+	std::printf("all checks passed\n");
+	return 0;
+}
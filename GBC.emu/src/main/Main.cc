@@ -145,6 +145,27 @@ EmuSystem::Error EmuSystem::loadState(const char *path)
 		return {};
 }
 
+size_t EmuSystem::stateSize()
+{
+	return gbEmu.stateSize();
+}
+
+EmuSystem::Error EmuSystem::saveStateToMemory(void *buff, size_t size)
+{
+	if(!gbEmu.saveStateToMemory(buff, size))
+		return makeError("State buffer too small");
+	else
+		return {};
+}
+
+EmuSystem::Error EmuSystem::loadStateFromMemory(const void *buff, size_t size)
+{
+	if(!gbEmu.loadStateFromMemory(buff, size))
+		return makeError("Invalid state data");
+	else
+		return {};
+}
+
 void EmuSystem::saveBackupMem()
 {
 	logMsg("saving battery");
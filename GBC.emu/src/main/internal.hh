@@ -1,5 +1,6 @@
 #pragma once
 
+#include <emuframework/EmuSystem.hh>
 #include <emuframework/Option.hh>
 #include <gambatte.h>
 #include "Palette.hh"
@@ -9,7 +10,12 @@ class GbcInput : public gambatte::InputGetter
 public:
 	GbcInput() {}
 	unsigned bits = 0;
-	unsigned operator()() override { return bits; }
+	unsigned operator()() override
+	{
+		// called when the game selects a P1 input line
+		EmuSystem::latchInput();
+		return bits;
+	}
 };
 
 static GBPalette gbPal[]
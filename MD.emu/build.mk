@@ -94,6 +94,7 @@ ifdef hasSCD
 
  SRC += MDFNApi.cc \
  CDImpl.cc \
+ CDAccess_CDZ.cc \
  error.cpp \
  endian.cpp \
  general.cpp \
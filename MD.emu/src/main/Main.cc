@@ -18,6 +18,7 @@
 #include <emuframework/EmuInput.hh>
 #include <emuframework/EmuAudio.hh>
 #include <emuframework/EmuAppInlines.hh>
+#include <emuframework/CompressedCDImage.hh>
 #include "internal.hh"
 #include "system.h"
 #include "loadrom.h"
@@ -52,7 +53,8 @@ bool hasMDExtension(const char *name)
 
 static bool hasMDCDExtension(const char *name)
 {
-	return string_hasDotExtension(name, "cue") || string_hasDotExtension(name, "iso");
+	return string_hasDotExtension(name, "cue") || string_hasDotExtension(name, "iso") ||
+		CompressedCDImage::hasExtension(name);
 }
 
 static bool hasMDWithCDExtension(const char *name)
@@ -1,2852 +1,2843 @@
-	{ {0xfd156985, 0x18172bcd, 0xe3318f08, 0xee032531, 0xcbbb9f5d }, 19 },
-	{ {0x33536dac, 0x686b375b, 0xa13faf76, 0xa3baf2d6, 0x978904e0 }, 19 },
-	{ {0x150b249b, 0x6402ed89, 0xed03cc71, 0x25f9472c, 0x931dcb2a }, 19 },
-	{ {0x0733cd62, 0x7467a866, 0x846e15ca, 0xf1770a55, 0x94eaf4cc }, 5 },
-	{ {0xda397e78, 0x3d677d1a, 0x78fff222, 0xd9d6cb48, 0xb915dada }, 5 },
-	{ {0xba07b1b5, 0x85386f88, 0x7d4c7e45, 0x7210b3fc, 0xe819709a }, 4 },
-	{ {0xdd1e87a1, 0x6e5fb38d, 0x9d729ef7, 0xedc6da21, 0x146a99fe }, 4 },
-	{ {0x9c544426, 0xa02312b7, 0x148249ef, 0x20ae6e20, 0x21b45db4 }, 4 },
-	{ {0x9a63d48c, 0x4fc05e76, 0xc9de25e5, 0xc5f2a0c9, 0x9b5d1be4 }, 39 },
-	{ {0xf8164d38, 0x72b5d54e, 0xaeafc6de, 0x3bb98a47, 0x2f0c828d }, 39 },
-	{ {0x6fe8c172, 0x5c35d85a, 0x5e489c0c, 0x8d21134d, 0xef09ecfb }, 39 },
-	{ {0x8f71dddd, 0x429173df, 0x7ce52c52, 0x45af1a76, 0xb482a901 }, 39 },
-	{ {0x937464eb, 0x371c68ad, 0xd2236bce, 0xf91d24a8, 0xce7c4ed1 }, 3 },
-	{ {0x5bd09e5a, 0x9669c583, 0x65c87f32, 0xa0e9a8e5, 0x9680d5c9 }, 19 },
-	{ {0xd76c7a5c, 0x2d28684f, 0x0d67114c, 0xc7b9707b, 0x296e68a2 }, 5 },
-	{ {0x3ca4a1ab, 0x35b3cbe3, 0xddb238ce, 0x88ca9df2, 0x58ae37d6 }, 19 },
-	{ {0xcb48969f, 0x27eaebf2, 0x4c61f651, 0x399ec243, 0x3d85bcbc }, 19 },
-	{ {0x2707dcf3, 0x77066b3c, 0x1755c56c, 0xc4c2f953, 0xd82f6524 }, 19 },
-	{ {0x8f5e7717, 0xa506e331, 0x4d48ae9f, 0xf5e6c6c8, 0xa3df72eb }, 19 },
-	{ {0xae0c0b0c, 0x9468e137, 0xeba5b52f, 0x96241acd, 0x55d9746a }, 19 },
-	{ {0x6b8a684d, 0xdbadd798, 0xa8e59944, 0x9b823bce, 0xca9cdb58 }, 19 },
-	{ {0xe1497038, 0x7aa89272, 0x56397cd3, 0x5fd8c356, 0xa0502143 }, 19 },
-	{ {0x3a9e1020, 0xb693b244, 0xf8437e93, 0x8cdc7e09, 0x17eb441b }, 19 },
-	{ {0x13D38CC8, 0x0112BAA9, 0xBCBF0356, 0x9988C163, 0x015D434C }, 19 },
-	{ {0xb31f223d, 0xd6304244, 0xc49c026e, 0x26503b58, 0x6ebc1885 }, 19 },
-	{ {0xec5111e3, 0xb06d64ef, 0x51196ff8, 0x7448e1c6, 0x2be4cdd8 }, 19 },
-	{ {0xf3815211, 0xc6183b4f, 0x9c26b9e7, 0xd0a12c3b, 0x3870bdda }, 19 },
-	{ {0x80767603, 0x8cbba043, 0xb8099eba, 0x9c5840a4, 0x811a7e59 }, 19 },
-	{ {0x83ed71c0, 0xe245a35c, 0xc4c4f622, 0xa6c88c02, 0x6140748f }, 19 },
+	{ {0x000fbc40, 0x1c7558d9, 0xc54a401c, 0x7875daa7, 0x2ab76920 }, 19 },
 	{ {0x0025565b, 0xf89b8dd6, 0x98fcf49f, 0x10345ca2, 0x9adbc2f6 }, 19 },
-	{ {0x148c9a4f, 0x316ff73c, 0x4e802baa, 0xdc34bf85, 0x2492821d }, 19 },
-	{ {0xf9e8cc6e, 0x47d5632e, 0x3b285001, 0x97f8e918, 0x7295c52b }, 5 },
-	{ {0x639cb280, 0x544b060a, 0x618af23d, 0xaf234a44, 0xbaaf88de }, 19 },
-	{ {0xacc14e98, 0x86a3281b, 0x658dc458, 0xc1ae93fa, 0x9f24db04 }, 19 },
-	{ {0x41b3b183, 0x0084ef00, 0xb61339c4, 0x6c96bd0e, 0xf62cd6d3 }, 19 },
-	{ {0xf19712f0, 0xda98b542, 0x3ebec315, 0x0f5741df, 0xa25acf85 }, 19 },
-	{ {0xcc93d295, 0xa7a5d6b6, 0x69328cd4, 0x9b1825c7, 0x7fe39705 }, 19 },
-	{ {0x49fd0580, 0x4c78c791, 0x732d2f73, 0xb83b3af5, 0x6999f270 }, 19 },
-	{ {0x5fb90be0, 0x78e432db, 0x92dd39e6, 0x21d12f61, 0x2dbea4a8 }, 19 },
-	{ {0x3de0cea6, 0xa4575e63, 0x1fee0db9, 0x85e0f0f5, 0x84761980 }, 19 },
-	{ {0x91d3f146, 0x3dac4d5f, 0xed8d4ff3, 0x4bed0d38, 0x8c61f164 }, 3 },
-	{ {0x5380e913, 0xd8dac234, 0x70446844, 0xcab21f69, 0x21101af8 }, 6 },
-	{ {0x0d9c472c, 0xf7687b86, 0xf3fe2e5a, 0xf6545a26, 0xa0efd5fc }, 6 },
-	{ {0x2639792d, 0xf6f7c7cf, 0xaffc2616, 0xb0e1849f, 0x18897ace }, 6 },
-	{ {0x1e7ac217, 0x96642c3c, 0xcb66b0ef, 0x0f00ba47, 0x52428aca }, 6 },
-	{ {0x6bde4e67, 0x61286a29, 0x09858ece, 0xf04155e1, 0x7072996e }, 5 },
-	{ {0x1d81e6cc, 0x165b3330, 0xb9b3c8b4, 0xf4da0417, 0xb1ab901e }, 19 },
-	{ {0x97e7d0ee, 0x40c7d6ce, 0x1a8edf7b, 0x06e5014e, 0x6745cfda }, 19 },
-	{ {0x627e4d31, 0x1dfe8a43, 0xa629e63f, 0x444a6f41, 0xeebad835 }, 19 },
-	{ {0x7e5264d3, 0x8c9d83c6, 0x2f60a74d, 0x2c51476a, 0x7ca2856f }, 19 },
-	{ {0x73e3a43c, 0xabbe2a4e, 0xa504a06b, 0x88ccf7f0, 0xb066c726 }, 19 },
-	{ {0xf294becf, 0x726a704c, 0xed1d7214, 0xf1c2b1ed, 0xc77b6bf0 }, 19 },
-	{ {0x6e15b3d9, 0x2191bf2c, 0x5ff07435, 0xc9849e31, 0xdad3ed1e }, 19 },
-	{ {0x55cc5074, 0x0d68d255, 0x8351cd8d, 0x125821dd, 0x1be70a1c }, 19 },
-	{ {0x88fa967c, 0x420f7090, 0xa11e5de1, 0xd3674f45, 0x27f53d52 }, 19 },
-	{ {0x076abc98, 0x8d51faef, 0x30143750, 0xdd41318a, 0x8a48c5c4 }, 19 },
-	{ {0xfd6cc08d, 0x4842a85a, 0x3c741cf9, 0xc30883dd, 0xfc378895 }, 19 },
-	{ {0xa6cd42c6, 0xcdebcd9b, 0x20330e64, 0xa38bb7ab, 0xde5bbe30 }, 19 },
-	{ {0xe1c0aaf5, 0x3501aff4, 0x07c49b53, 0x32c7b5e3, 0x977317c3 }, 19 },
-	{ {0xf67ea4e2, 0xdd0356e7, 0x747b2463, 0x3dedae8c, 0x414e7e32 }, 19 },
-	{ {0x2f2383a8, 0xf264172e, 0x88465a4c, 0xab66e04f, 0xbfce1d2e }, 19 },
-	{ {0x27c40ec7, 0x013c1ad1, 0xf9a7e1ac, 0x1e0c8be9, 0x9f1e703f }, 19 },
-	{ {0x876c0945, 0x0bc2b36a, 0x873e1733, 0xcfa31c6b, 0x9d080ba5 }, 19 },
-	{ {0x3a4a65dc, 0x6d540297, 0xa7aae0a9, 0x914897aa, 0xcf740807 }, 19 },
-	{ {0xa1abfc53, 0xa36d387b, 0x9f0687e3, 0xf5897c1e, 0xbdf21517 }, 19 },
-	{ {0x495876c5, 0x04bdc4de, 0x24860ea1, 0x5b25dda8, 0xf3b06c49 }, 5 },
-	{ {0xdb33011d, 0x006201b3, 0xbd3bbc4c, 0x7c952da2, 0x990f36e4 }, 17 },
-	{ {0x6bd5b97b, 0xaceb3bc8, 0xda357159, 0x0e2a6a76, 0x1bb90b48 }, 55 },
-	{ {0xe1c7169b, 0xd44a3c67, 0xf2941a14, 0x699b954d, 0x7e337d29 }, 56 },
-	{ {0x0ede48e2, 0x53729833, 0x963f1239, 0x932d8d26, 0xa5e618a1 }, 19 },
-	{ {0x46d1c97b, 0x97a83738, 0x7445e603, 0x9669fd9d, 0x04df8873 }, 19 },
-	{ {0x2185be57, 0x9cb51729, 0xf66bf02b, 0xdf3a7b6a, 0x3cbd7b40 }, 19 },
-	{ {0x44deaef7, 0x47c572a4, 0x550681fc, 0xccc1bbbd, 0xc46a1ffc }, 19 },
-	{ {0x292215c9, 0x5c829488, 0x23eb0fbe, 0x1b081f14, 0xd6b6290d }, 19 },
-	{ {0xe894a38f, 0x3e2ad435, 0xcc5d17a6, 0x6600e601, 0x6b5e47fb }, 19 },
-	{ {0x8999a51c, 0x94460c8d, 0xb1ca033b, 0x64b568bf, 0x919300c2 }, 19 },
-	{ {0xe8af1da8, 0x478ebfd7, 0x96b1f04a, 0x24290732, 0x59761ebb }, 19 },
-	{ {0x63d3755c, 0x81b2c294, 0xff3bd96c, 0xfb9f5a2f, 0x3d83b86c }, 19 },
-	{ {0xc7af3306, 0xdbae898f, 0xcc077492, 0xcc457429, 0x8951df34 }, 19 },
-	{ {0x1a00eef3, 0xdf449d71, 0xabf4be5a, 0x4c8d01ba, 0x9dcd6b79 }, 19 },
-	{ {0x4b614717, 0x2c12f74f, 0xe5b2386e, 0x6cc78ea0, 0xd763316a }, 19 },
-	{ {0xf236345f, 0x43828597, 0x739f4a32, 0x6318b6a3, 0x876ff73f }, 19 },
-	{ {0x0400bf9f, 0xcebf76ea, 0xd52a702a, 0x00b51eef, 0x991f730a }, 19 },
-	{ {0x633cb458, 0xeeab0fea, 0x59a70a9a, 0x620b7783, 0xa44eb0a6 }, 19 },
-	{ {0x93462ac9, 0xa322c2e5, 0xe0d996fd, 0xdbe9eba2, 0xf3436931 }, 19 },
-	{ {0x3ce544aa, 0xefdb8a91, 0x6a1639af, 0xea774eb7, 0x5ec4702f }, 19 },
-	{ {0x6b4b099f, 0xa7a87c50, 0x59ebb40d, 0xa3089d0d, 0x61967644 }, 19 },
-	{ {0xec53d72e, 0x41e11457, 0x4f4c116c, 0xab19e163, 0x3f3da207 }, 42 },
-	{ {0x5002ba59, 0x8469b34a, 0xf25bff50, 0x11ccc70e, 0xd3723b0d }, 19 },
-	{ {0x45ce64a4, 0x55a2b07f, 0x3c8a6d54, 0x1cda3b0e, 0x058cc732 }, 19 },
-	{ {0xe1527ae1, 0x6d33a09d, 0x9cf3d4ea, 0x52e63337, 0xd2273910 }, 19 },
-	{ {0x2183f07f, 0xa3ba8736, 0x0100b2fa, 0x21fda0f5, 0x5c0f8814 }, 19 },
-	{ {0xc30d7363, 0xfcfb3827, 0x2ae927c6, 0x84df1c52, 0xc7de1a72 }, 19 },
-	{ {0xfd9eef4e, 0xa54e31e9, 0xffb121c0, 0x79e4b76c, 0x990d755c }, 19 },
-	{ {0x194ff03c, 0x3063a852, 0xc831b034, 0xfe215208, 0x802b64cf }, 19 },
-	{ {0x66acd2f8, 0xef08dd4c, 0xb0dc7ef5, 0x176650fb, 0xf5828acf }, 19 },
-	{ {0x87eb1620, 0x47403974, 0x0bfe0e7e, 0x3bea0908, 0x5d85f247 }, 19 },
-	{ {0x72815a72, 0x13f899a4, 0x54bcf767, 0x33834ba4, 0x99d35cd8 }, 6 },
-	{ {0xfbe43d67, 0xa5bc0aed, 0xb2e194a4, 0xe5f9497b, 0x7488362b }, 19 },
-	{ {0xc0476fab, 0x5ca3c69b, 0x381bb8c4, 0x3efea127, 0x7d7a1b43 }, 19 },
-	{ {0x866cb3ab, 0x10f17e4f, 0xb356fbd7, 0x277bbf17, 0xc4e27ebe }, 19 },
-	{ {0x90bdd12d, 0x632d2e90, 0x9ac5d692, 0x35ad0366, 0xf430b734 }, 19 },
-	{ {0x29e2f2da, 0xed13cef1, 0x2c20c9c0, 0xd383b99d, 0x18e489de }, 19 },
-	{ {0xde9eb0e9, 0xef183f49, 0xe9d9b631, 0xf8818f9c, 0xac5df409 }, 19 },
-	{ {0xc5f1897c, 0x416f62cd, 0x58cd6257, 0x282e3428, 0x155cd698 }, 19 },
-	{ {0xc6c64d80, 0x3d65ce43, 0x9d00034a, 0x86a570f8, 0xc77d18d5 }, 19 },
-	{ {0x0d504c35, 0x9661ac73, 0x1de07a73, 0x19afd0e3, 0x1f01a5d7 }, 19 },
-	{ {0x4c8a9766, 0x9017296c, 0x2360ff9d, 0x53694a29, 0x2197991e }, 19 },
-	{ {0xcd2159b9, 0xc60f3ca7, 0xbf9f4b3f, 0x3163203b, 0x9ce2851f }, 19 },
-	{ {0x469b07ee, 0xf08348c9, 0xacc14e63, 0xba0cd35a, 0xef236983 }, 42 },
-	{ {0x1a6a7513, 0x34c663fb, 0xfdf93f61, 0x7a7d779f, 0x76f488ce }, 42 },
-	{ {0xa7cf4cbe, 0x12c8956c, 0x0a51a5c2, 0x336fe70a, 0xee7f4a65 }, 42 },
-	{ {0xc345357e, 0x71d1b8f2, 0xc9663bf2, 0x8abb5a3a, 0x2957d49f }, 19 },
-	{ {0x2b887860, 0x9bcc0d15, 0x55ae250d, 0x621ba6e9, 0xdf4afc52 }, 19 },
-	{ {0x363b5a8c, 0x94cdb63a, 0x7ee72b9d, 0x25f7b505, 0x3cab319a }, 19 },
-	{ {0x8301e325, 0x65cc8102, 0x3c71da10, 0xf2f3e2f8, 0xbefb7e3f }, 19 },
-	{ {0xe984bfb4, 0x251e7b9f, 0x9b6b95d5, 0xe1005e67, 0xc223ae67 }, 39 },
-	{ {0x619a2d42, 0x263da74a, 0x723cceea, 0xd5a19e0e, 0x0dd86c6f }, 39 },
-	{ {0x134a6faf, 0x15929786, 0x08b55269, 0xaea101d5, 0xfad68760 }, 19 },
-	{ {0xb103d424, 0x8729aeda, 0x9ebf5766, 0xc1791b19, 0x50246968 }, 19 },
-	{ {0x28323e06, 0xa402747a, 0x1e131dc3, 0x0ce031a3, 0x39f6c947 }, 19 },
-	{ {0x6d73ee99, 0xac367a25, 0x58fd9366, 0xaf75ad39, 0xed0d4e69 }, 19 },
-	{ {0x4e78689a, 0xddca0c49, 0xbefaeec2, 0x9d096e33, 0x1d4600b2 }, 19 },
-	{ {0xcd452442, 0x33836641, 0x1f6b2473, 0x9fe59e20, 0xf3ac24dc }, 19 },
-	{ {0xc46f85f2, 0x1f780f12, 0x6a0d6184, 0x8071fcdc, 0xf84f15b9 }, 39 },
-	{ {0x7a402378, 0x67f62611, 0xd0e97666, 0x6451648e, 0xdb80753c }, 19 },
-	{ {0xf0fee046, 0x198a076e, 0x664811f4, 0xe3a788d5, 0xf0b47183 }, 3 },
-	{ {0xb0956b97, 0xc9087aab, 0xab333c27, 0x1c7afd97, 0x54ae84cd }, 19 },
-	{ {0xb337ea56, 0x278523f9, 0x84d1b000, 0xcd00f339, 0xd82017a0 }, 19 },
-	{ {0x5ed42deb, 0x02556f93, 0x024b7911, 0xb4ac17c6, 0x469a8340 }, 19 },
-	{ {0xccf79dc8, 0x9000d2c2, 0xed45112a, 0x76a7cfce, 0x86fb1aff }, 19 },
-	{ {0x22366113, 0x8586a1b0, 0x24d6dba5, 0xe5fa67d6, 0xb7685884 }, 19 },
-	{ {0x84c5cce8, 0xe8e74ab5, 0x1c3c0430, 0x75165679, 0x270bc5e7 }, 19 },
-	{ {0x9f0cbb11, 0x91235ecc, 0xa4985de9, 0x76a09937, 0x44b57930 }, 19 },
-	{ {0x01cf8588, 0x88f5a0d3, 0xaee08f42, 0xa66c515a, 0xb0d06400 }, 19 },
-	{ {0xeebfb48d, 0x0fd8fe5a, 0x7f370195, 0xa2b4a76b, 0x51b89dc8 }, 19 },
-	{ {0x709fb353, 0x38f21897, 0xe275237c, 0xc4c5615d, 0x0a5c2753 }, 5 },
-	{ {0x3739d841, 0xabfef971, 0xdb76ba10, 0x915b19b9, 0xdf833476 }, 5 },
-	{ {0xee7dbd36, 0xa2b0bbae, 0x11c68ac4, 0xde75077f, 0x283bed05 }, 19 },
-	{ {0xf86a7945, 0xb34c97cc, 0x58d5ee27, 0x96496887, 0x0bfcef93 }, 19 },
-	{ {0xefe44e5f, 0x4593036a, 0x6c003586, 0x38462a93, 0x3d16b979 }, 19 },
-	{ {0x16f29e95, 0x53419865, 0xc1160617, 0x232614a7, 0x2f88f3d4 }, 19 },
-	{ {0x8b63f36b, 0xe31d7d02, 0x1c19103e, 0xbe8c68b6, 0x9aae699c }, 19 },
-	{ {0x59bc608b, 0x1cb5bde2, 0x230bca0e, 0xb045cd6c, 0x58650774 }, 19 },
-	{ {0x8E2A2837, 0xC48BC8E2, 0xD2478043, 0xC728A463, 0x0982BA87 }, 19 },
-	{ {0x532037fd, 0x92f7f1d3, 0x4a477674, 0x16ce5c97, 0x9a0694ad }, 19 },
-	{ {0x0f214ea9, 0xe8d673ee, 0x0c66cb66, 0x15032e57, 0x920d588b }, 19 },
-	{ {0x1bdb1898, 0x796e2b48, 0xb62a3560, 0x35192b16, 0x3113962c }, 19 },
-	{ {0xf51f9368, 0x87498d21, 0xf6ee9fe8, 0xa7701633, 0xbe67e79d }, 19 },
-	{ {0x1231984a, 0xe24bf35f, 0x9f38596b, 0x864420d8, 0xccd3f30b }, 19 },
-	{ {0x6da1c669, 0x3b67b041, 0x5be6de17, 0x8bc5d319, 0xc0bef59d }, 19 },
-	{ {0xd69d4a6f, 0x2834b20d, 0xf3a2afbd, 0x7a927220, 0xe96e31e1 }, 19 },
-	{ {0x01ebdd59, 0x81c4841a, 0xbddf6f76, 0xeb1f73e2, 0x37e7688f }, 19 },
-	{ {0x702d8f17, 0x62d4efe9, 0x94f520e2, 0x1e8867ad, 0xae13b817 }, 19 },
-	{ {0x3197d73a, 0x5400a724, 0x20f91def, 0x6d3aa8bd, 0xcb392754 }, 19 },
-	{ {0x250d4c7c, 0x6565b0c4, 0x935f6301, 0xe8de2c18, 0x2e659fd0 }, 19 },
-	{ {0xa2de4575, 0x67e87c79, 0x4fba8e35, 0xc992eac3, 0x52da78be }, 19 },
-	{ {0x65961a19, 0x26b24c8e, 0xfa71f2ab, 0x68cbafa2, 0xd0122acf }, 19 },
-	{ {0xbd44cc15, 0x2851d9f3, 0x827fb304, 0xf3e4780e, 0xe607f896 }, 19 },
-	{ {0x908bb09b, 0xa2883c3e, 0xcdec96ed, 0x7e0211cc, 0xb05c5018 }, 3 },
-	{ {0xafe11b84, 0x0b7bf024, 0x3b1c4f98, 0x309e274a, 0x3ddde35f }, 19 },
-	{ {0x8a3749af, 0x3d6ff884, 0x04df59da, 0x9d9ac799, 0x0bbc318d }, 19 },
-	{ {0x9267ea63, 0xe1d32095, 0x868eec13, 0x47a4eafb, 0xdfb5ef7e }, 19 },
-	{ {0xebff5d2b, 0x4253f62d, 0x3a00f1a6, 0xd6b4d810, 0x53c7b8a6 }, 19 },
-	{ {0x4806e6bc, 0x1fd24d5a, 0x62c6df57, 0xea8fd1b5, 0x1d6e4b80 }, 19 },
-	{ {0xef476e25, 0xfb6b7221, 0xca778a37, 0x91178854, 0x50dd36f0 }, 19 },
-	{ {0x5400c0c9, 0x29b31a70, 0xe76aac67, 0x6b91d404, 0x45f1b427 }, 19 },
-	{ {0x49f0e168, 0x020fddd2, 0x54843c95, 0xb5e6bcf6, 0x5bdc84ac }, 19 },
+	{ {0x0039cff2, 0x92fe740d, 0x8c87cc21, 0x31a473cb, 0xb4f8c4f4 }, 19 },
+	{ {0x003d5898, 0x8d120823, 0xc84f6617, 0x326f5df8, 0x3c7e5131 }, 55 },
+	{ {0x005794c1, 0x0a4237de, 0x3907ba4a, 0x44d43607, 0x8d3c06c2 }, 31 },
+	{ {0x0071b2eb, 0x214ff002, 0xdbbb7532, 0x653585b3, 0x5b56f243 }, 19 },
+	{ {0x007e08a4, 0x3482e1e4, 0x4dd017fb, 0x64091056, 0xc27438c1 }, 42 },
+	{ {0x0081ea0d, 0x25bc5cd8, 0xd70b60ad, 0x8cfdc730, 0x7812c0fd }, 1 },
 	{ {0x008e9b14, 0x47b7f321, 0xaa1f1b4d, 0xdf8e0ac0, 0xfd62c771 }, 19 },
-	{ {0x2588b9ad, 0xe775b93f, 0x03fd4b17, 0xfd3f78ba, 0x70b556d6 }, 6 },
-	{ {0xb4dd886d, 0x4a44cc42, 0xfc9e95d2, 0xdb0943d4, 0x22e4bda8 }, 42 },
-	{ {0x65af16d3, 0x5b8d8454, 0xec07718e, 0x9f894833, 0x5ca73bad }, 19 },
-	{ {0x6bc6acb1, 0x1e684406, 0xa5d93933, 0x7b29f33d, 0xc9816ad1 }, 19 },
-	{ {0x8e3e05e8, 0x928b5b77, 0xfa61f3b8, 0x33e164bf, 0x5222a5fb }, 19 },
-	{ {0xd2ce76cd, 0xdb6cc12d, 0xc68e9683, 0xb072fb57, 0x947ec172 }, 42 },
-	{ {0xbd4b8c48, 0xf1d8107f, 0x11ae680a, 0x787d7b38, 0x25669b7c }, 19 },
-	{ {0x3e44a4e5, 0x608e0179, 0x3877e62f, 0x82c12c2b, 0x82908461 }, 39 },
-	{ {0xf5551b5c, 0x88e64509, 0x0cd9297a, 0xa1b3ca92, 0x1526a6ba }, 39 },
-	{ {0xae3bd232, 0x0892fb02, 0xab9facce, 0x986af078, 0x07513600 }, 39 },
-	{ {0xe2ef32f2, 0xfc312f96, 0xb8424569, 0xe9e85a6e, 0xa3b21ce4 }, 19 },
-	{ {0x04283ae0, 0x2107917d, 0xa6f54a0f, 0x38d3a282, 0x54f7ab69 }, 19 },
-	{ {0x5c961692, 0x07e19723, 0x7aa728d8, 0xce4e24c0, 0x635d5904 }, 19 },
-	{ {0xb52b68e6, 0xaaa3be87, 0x6b3349a3, 0x2b388853, 0xea32fbcc }, 19 },
-	{ {0xd7e2a4f7, 0x8b3e2403, 0x09c6367a, 0xc9dd9c9a, 0xeb95e3ee }, 19 },
-	{ {0x5503d23f, 0xaf94f076, 0x410d252f, 0x69f6bf5e, 0xce4da292 }, 19 },
-	{ {0xe5171c36, 0x8883de03, 0xfc8d75e6, 0x1bf23d95, 0x4ec1bba4 }, 19 },
-	{ {0xd83bb9d7, 0xf71de899, 0xa726af11, 0x80e2e766, 0xd39fe5a2 }, 19 },
-	{ {0xceb7807a, 0x78bcc462, 0x85afbf6e, 0x607d2f9a, 0x5bdffbcc }, 19 },
-	{ {0x46ecaf85, 0xf1ff1b48, 0x21670bf4, 0x4ff1249f, 0xe1b13a35 }, 39 },
-	{ {0x482cd650, 0x220e6931, 0xf85ee853, 0x2c61dac5, 0x61365e30 }, 5 },
-	{ {0x5324e053, 0x709ff8da, 0x6c18ae4a, 0xfba6a2e0, 0xc3a722ba }, 19 },
-	{ {0x8bcefc25, 0x0be1c3a6, 0x77de78e6, 0xaf4d01d3, 0x2fe4e5b8 }, 19 },
-	{ {0x6714e939, 0xf0592d3a, 0x97f995bf, 0xc6d70472, 0x42ebd123 }, 19 },
-	{ {0x64781236, 0xe70cf5dd, 0x530a4203, 0x05533ff5, 0x5db0e4ad }, 19 },
-	{ {0x8976f8b8, 0xab2a82f6, 0x26a73c78, 0x1d0a2189, 0x9ae68dae }, 19 },
-	{ {0x2c0e3d13, 0x0a165561, 0x7f9f8083, 0x6f4b8b60, 0x6f0774f2 }, 19 },
-	{ {0x99cc271b, 0x5cffa38b, 0x8ec6e6d8, 0x770adf21, 0x19055fff }, 19 },
-	{ {0xe700493e, 0x1c4c14f7, 0x11e9c1c2, 0x62fe3e8d, 0x76931ca3 }, 19 },
-	{ {0xabe625e8, 0x53cde990, 0x8a302f63, 0xda407d3e, 0x67c6e59e }, 19 },
-	{ {0xcef76580, 0xa01cc8e1, 0x6704590d, 0x0d884d7e, 0xeadaa3a8 }, 19 },
-	{ {0xfd5dd1d1, 0x6c46eba1, 0x34910b5e, 0x9550656b, 0xa9a1fd82 }, 19 },
-	{ {0x5ceffd3d, 0xc9887833, 0xe7b5b717, 0x650dd956, 0xe89803a3 }, 19 },
-	{ {0x0b324120, 0x2f0e2be4, 0x70e5f2e6, 0x139c0198, 0x3a895bc8 }, 19 },
-	{ {0x05b7a1db, 0x1ff15f71, 0x2e619fd1, 0xc79fd771, 0x0e93cb3b }, 19 },
-	{ {0x86f8e325, 0x0cdcbadc, 0xcf131255, 0xa1ef59ed, 0x291be8e9 }, 19 },
-	{ {0xda7cfd16, 0xdd1a76ae, 0x6b551cea, 0xbfd7053c, 0xa8e3412f }, 19 },
-	{ {0xef535ab6, 0x013d9b6e, 0x38227272, 0xf2ebe6a0, 0xf0b33cb5 }, 19 },
-	{ {0x16c3ced0, 0xfb2e360b, 0xc7c43d37, 0x2a0a30eb, 0x6bd3963d }, 6 },
-	{ {0x855cabd1, 0xad1abae3, 0xa9d26999, 0xd48c66de, 0x8096d7c5 }, 6 },
-	{ {0x0bf7b432, 0xdc132f9a, 0x7bc74106, 0x261bca07, 0xd5f99690 }, 19 },
-	{ {0x33ad6d1b, 0xf1fb816b, 0x232ea706, 0xd149327e, 0x363c7b21 }, 19 },
-	{ {0x451cbb07, 0x2011b26a, 0x7e0bc993, 0x1e67995a, 0x71f5fd6f }, 19 },
-	{ {0xb15e73a5, 0xff1ae17a, 0xc67f2ceb, 0xb5862d5e, 0x5bd80bc0 }, 42 },
-	{ {0x1ffef57e, 0x6c06068b, 0x33002729, 0x4aae1731, 0x03c8f141 }, 42 },
-	{ {0x254208d7, 0xea2f7cc1, 0x035cfe76, 0x85238ac3, 0xad17e438 }, 19 },
-	{ {0x14fae375, 0xb81c86f7, 0x1e872adc, 0xa792c23a, 0xafac66a0 }, 19 },
-	{ {0x9B4B4D93, 0xBAE38876, 0xCE095C35, 0x993553F9, 0x62D26FDA }, 19 },
-	{ {0xA294F54D, 0xA2BE26F7, 0x90206746, 0x16AF95A2, 0x5428BCD3 }, 19 },
-	{ {0x9b3be704, 0x92994320, 0xe185aae3, 0x02cdb384, 0x1d7f518a }, 19 },
-	{ {0x6097fb71, 0x94b64148, 0x287e6548, 0x70c98eb0, 0xe2b33850 }, 19 },
-	{ {0xd28201ca, 0x9b7d062d, 0x37c62bc4, 0xd6212f2a, 0x0d3e1cb4 }, 19 },
-	{ {0xb76ffb94, 0xa08457df, 0x0a51897c, 0xd87cd8a9, 0x1610224c }, 19 },
-	{ {0xf1f571c1, 0xd9360839, 0x450c26d7, 0x3c6aef89, 0xe1e052eb }, 19 },
-	{ {0xf2d1a057, 0x940b44c0, 0x4ba08f4f, 0xf2767eef, 0x8b515833 }, 19 },
-	{ {0x78b1bb63, 0x975d2b51, 0x39089853, 0x9c075bf4, 0xbdd72343 }, 19 },
-	{ {0x208ce6cb, 0xff7402bf, 0xe52b1062, 0xe6b10ae0, 0x9c0a3179 }, 39 },
-	{ {0xbcfdb43b, 0x275c62a7, 0x6856aab9, 0x4fb1b53b, 0xd92b2db2 }, 19 },
-	{ {0x3d065377, 0xf11b2341, 0x0282b6b7, 0x6f26bd93, 0xb9d05184 }, 39 },
-	{ {0x0d9a37ff, 0x931e5db2, 0xcdee2e0f, 0x312fd4bb, 0xef5cfd29 }, 42 },
-	{ {0xc1219e07, 0x35d31f1c, 0x41995795, 0xe58b04b9, 0x7bf1b71a }, 3 },
-	{ {0xc64f2fad, 0x6417c645, 0x95bc204d, 0x843527e1, 0x7a58776f }, 19 },
+	{ {0x0099492b, 0xd11dfa3d, 0xdf87af3a, 0xeb4c92b2, 0x9f78bd82 }, 8 },
 	{ {0x00a8aac8, 0x535a3387, 0xae9bed5d, 0x8f4e2a21, 0x183666e0 }, 19 },
-	{ {0x6f9b4d79, 0x1f4a43d7, 0x182650f2, 0x1a7bfe88, 0xd1c5c2b4 }, 19 },
-	{ {0x621ea075, 0xa5345843, 0x61c9e9d6, 0x40e39007, 0xa79dfd78 }, 19 },
-	{ {0xce137694, 0x1359471c, 0xae41887f, 0xe11f10d3, 0xb696a926 }, 19 },
+	{ {0x00c70cf3, 0x7c71cb8f, 0x99567ae4, 0x07ff6dd5, 0x2c4774c2 }, 5 },
+	{ {0x00f6e7ef, 0xbb5a50b6, 0x6723a313, 0x0009a96d, 0x8a588363 }, 19 },
+	{ {0x00ffd7ad, 0xfc0a7a34, 0x2912344a, 0xd64902e2, 0x26b3ad41 }, 19 },
+	{ {0x010d5f32, 0x5fc38c5b, 0x590841d1, 0x5ce4f07d, 0x59f2a4cb }, 19 },
+	{ {0x0125bce3, 0x73c95ee7, 0x8df074d1, 0x9ad03215, 0x8edc74a2 }, 19 },
+	{ {0x01544042, 0xb810c0b4, 0x01fce5d1, 0x80adb6fe, 0xa9b5ed20 }, 19 },
+	{ {0x016c6316, 0x1d5112ef, 0x637d4892, 0x0a85001c, 0x9eb6a10f }, 19 },
+	{ {0x01788f62, 0x38dc934f, 0xbc843aab, 0x85fdc058, 0x1ed96989 }, 19 },
+	{ {0x018d7a52, 0x22f28514, 0x908fb1b1, 0x513286a6, 0x558a6d05 }, 141 },
 	{ {0x01b506cf, 0xecb366f7, 0xe00bcabb, 0x717e86e8, 0x974c02a2 }, 19 },
-	{ {0x613c7415, 0x35c92dfb, 0x01afec41, 0x35ef8ebd, 0xdb49f999 }, 19 },
-	{ {0x2f7ff043, 0x8f1a8d80, 0x292c9e1c, 0xb8d77a92, 0xc600b505 }, 19 },
-	{ {0xe6a1d90a, 0x7a8b4e4b, 0x8a8e1afb, 0x3d971866, 0x931b986d }, 19 },
-	{ {0xb755d7db, 0x109cd0a9, 0x392accd1, 0xc83e6d99, 0x5a8a04d6 }, 19 },
-	{ {0x7d53991b, 0x3d63ab97, 0xe2788769, 0xf1078eb5, 0x57973500 }, 19 },
-	{ {0x8b485373, 0x7f7f4006, 0xca4291f4, 0x81cfdfcf, 0x66e2ce34 }, 19 },
-	{ {0x695ac043, 0xeaf66268, 0x922ad97b, 0xf4ed5275, 0x3c93b2d0 }, 19 },
-	{ {0xb9ac3ac1, 0x5b49eaab, 0xcb640cc6, 0xb48f4706, 0xe0f18246 }, 19 },
-	{ {0x22183520, 0xd99924a4, 0x185c5572, 0xa3cf948f, 0x4f0f04b5 }, 19 },
-	{ {0xcd69ce70, 0x747bc0de, 0xebba9fd3, 0x07a07f5d, 0xfb926cc3 }, 19 },
-	{ {0xc6e0b0bc, 0x71059583, 0xe7e9da22, 0xfe13be9e, 0x937ad7dc }, 19 },
-	{ {0x286094c7, 0x127bf98d, 0x53d88624, 0x27487b49, 0x132b16da }, 19 },
-	{ {0x2a0f9899, 0xa4d8dba7, 0x6db501d6, 0xe3435546, 0xcc7cd9aa }, 19 },
-	{ {0x7b6e6451, 0x1a55eed5, 0x8ba04f34, 0xcf2547f7, 0xdf631c33 }, 19 },
-	{ {0xc06de0ed, 0xa82e1daa, 0x3ea3cbc5, 0xeba5d884, 0xfd0ce8e8 }, 19 },
-	{ {0xed547caf, 0x3e45f621, 0xb588cb1f, 0xa91008c9, 0xc1bc9ed7 }, 19 },
-	{ {0x77f3f675, 0x8bd4cf5d, 0x2b44c51d, 0xe958aa96, 0x7c41a9d7 }, 19 },
-	{ {0x69710f4b, 0x9cc3440e, 0x58c54bd4, 0xc562b3e9, 0x0ff323e0 }, 19 },
-	{ {0xd32279e0, 0x1fb57627, 0x78d696ac, 0xc2053b95, 0x03d5a715 }, 19 },
-	{ {0xb36c9250, 0x05f1e530, 0xcab2b5f6, 0xe2a5ddfd, 0x182c0140 }, 19 },
-	{ {0xaeca6948, 0x208b14d1, 0x12b4733a, 0xdedea026, 0x56b706a0 }, 19 },
-	{ {0x31d80470, 0xc8d23ec8, 0xb14256aa, 0x32f3d54d, 0xbc532d76 }, 19 },
-	{ {0xe997d8f0, 0x2e413d2d, 0xf5aed2bf, 0x7e79986c, 0x4c851d34 }, 19 },
-	{ {0x317a7cc0, 0xab90882d, 0x25d1185e, 0xeb9aca6b, 0x884c8879 }, 19 },
-	{ {0x37f30229, 0x1c75847f, 0x4b87a82e, 0x3acbbf62, 0xeab625f8 }, 19 },
-	{ {0xf025c9c2, 0xdb97dce6, 0x08fcc105, 0x0426beff, 0x0dea43eb }, 19 },
-	{ {0x5ad0ba43, 0x4407a7ee, 0xecb597b3, 0xd20bcfc6, 0xfe05c319 }, 19 },
-	{ {0xbb7468dd, 0x32a16085, 0x1b39121d, 0x24713b0b, 0x4e065c19 }, 19 },
-	{ {0xb272f73f, 0xe2cb27de, 0x212d6753, 0xaf0e0981, 0x2a707f0e }, 19 },
-	{ {0xe93c3966, 0x49bf6328, 0x103e8da0, 0x247952eb, 0xef2a04e9 }, 19 },
-	{ {0x8a158cde, 0xc0923b81, 0xce13af2d, 0xffa5d1b7, 0xe096a469 }, 19 },
-	{ {0x11e2f95d, 0x1b58e124, 0x4efda761, 0x603a2ae6, 0xd0090d18 }, 19 },
-	{ {0x97af4f42, 0x2a283ac8, 0xba387eb0, 0xb1b29395, 0xc2c966eb }, 19 },
-	{ {0xe7396ad7, 0x00f7edf9, 0x8cc2b0ec, 0x2e6127a6, 0x8d3cd9ba }, 19 },
-	{ {0x4fd41171, 0xb6b43d51, 0x678590a5, 0x9f004b0b, 0x9121751e }, 19 },
-	{ {0xab7354c9, 0xced9782d, 0x572c4dd6, 0x9249b76a, 0x1244e5ce }, 19 },
-	{ {0x5b17cb69, 0x697cf55d, 0xff1f0b87, 0x77e19d5a, 0xbc1771fc }, 19 },
-	{ {0xd4480639, 0xd6468e19, 0x19c43f4c, 0xd0a08e9a, 0xc60073dc }, 19 },
-	{ {0xe32d7334, 0xace26a57, 0x0a08fe7c, 0x01ad01a2, 0xc08b1991 }, 5 },
-	{ {0xfe53d85a, 0xdb758103, 0x097fd561, 0x32e71c7f, 0x4cb32313 }, 19 },
-	{ {0x616c3b9a, 0x0c185c1a, 0xa683afa5, 0x3989f0bb, 0x39cd768c }, 19 },
+	{ {0x01cf8588, 0x88f5a0d3, 0xaee08f42, 0xa66c515a, 0xb0d06400 }, 19 },
+	{ {0x01ebdd59, 0x81c4841a, 0xbddf6f76, 0xeb1f73e2, 0x37e7688f }, 19 },
+	{ {0x02155fc2, 0x5c9bd23e, 0x1654fe81, 0xc7448635, 0x1e1ecc28 }, 1 },
+	{ {0x022a53d7, 0x9bb72c73, 0x6a5fdad6, 0xd82434a9, 0x8f33e6e7 }, 5 },
+	{ {0x0274dd9b, 0x5096065a, 0x7f4ed019, 0x101124c9, 0xbd1d56b8 }, 65 },
+	{ {0x028eb2de, 0x64ee129f, 0x9403d114, 0xb3059e8b, 0x62fef6c2 }, 5 },
+	{ {0x0293bc55, 0xdf4f9b7f, 0xb97ae9cd, 0xed8ab2c5, 0xc9ed0fd4 }, 19 },
+	{ {0x02943609, 0x157b14cb, 0x036c1338, 0x8093af7d, 0xe0033b48 }, 19 },
+	{ {0x02a2fafc, 0x7b9249db, 0x76803ece, 0x347ba73b, 0xe25f71b5 }, 19 },
+	{ {0x02c3ec94, 0x190c6fce, 0x6fa4984d, 0x92be48b2, 0x697e7706 }, 5 },
+	{ {0x02cfc411, 0x32d518e2, 0xb9fc632e, 0xc6ad0065, 0x6bd9ec92 }, 17 },
+	{ {0x02ee1a32, 0xd48525cc, 0x29440608, 0x666bfdfe, 0x77507888 }, 141 },
+	{ {0x0303ca82, 0x776894ec, 0x8c6597e5, 0xc29afc4a, 0x605b2a59 }, 19 },
+	{ {0x03055770, 0x6d72199a, 0xcf17df44, 0x80f6b1a8, 0xff798d1e }, 4 },
+	{ {0x0306181b, 0xb8babbc2, 0x15e8c506, 0x6c1f4907, 0x19541665 }, 19 },
+	{ {0x030b6ea5, 0x34f2285b, 0x57b8740c, 0x0dcb4c8b, 0xf92ed7c7 }, 19 },
+	{ {0x031a611b, 0xa1f75b7d, 0x5fe3ed08, 0x8a61c245, 0x98b4b314 }, 19 },
+	{ {0x032cb1c1, 0xc75b9a19, 0x1fa12309, 0x78971698, 0xd9d2a17f }, 21 },
+	{ {0x033f5c35, 0xc5ddce6c, 0xef8b53fa, 0xac2edd85, 0x047e5805 }, 19 },
+	{ {0x0348f175, 0x8daa118e, 0xbaf2bc59, 0x3ff9a0a6, 0x22fc89e8 }, 19 },
+	{ {0x03556d38, 0x0a9bd413, 0xfaf1b9e3, 0xcbd7da47, 0xc7238775 }, 1 },
+	{ {0x03ae0eeb, 0xbbf80f8e, 0x51c5892a, 0x74aa2b4f, 0x287a9319 }, 19 },
+	{ {0x03b42b77, 0xb1a7412f, 0x1d7bd099, 0x8cf8f2f0, 0x03f77d0a }, 4 },
+	{ {0x03bf6d2a, 0xc86f5c9a, 0xb618e155, 0x442787c7, 0x00f99fed }, 1 },
+	{ {0x03f112b3, 0x8fb1d05a, 0x9b0b50d3, 0xc6a54aa2, 0xce9dd2b0 }, 19 },
+	{ {0x0400bf9f, 0xcebf76ea, 0xd52a702a, 0x00b51eef, 0x991f730a }, 19 },
+	{ {0x0413bb3a, 0xeacb0c28, 0x429b8c85, 0xb42796db, 0xe48bef6d }, 3 },
+	{ {0x0421a25a, 0xff3ae300, 0xb2a4536d, 0xd0aa5fa9, 0x24e7dd72 }, 19 },
+	{ {0x04283ae0, 0x2107917d, 0xa6f54a0f, 0x38d3a282, 0x54f7ab69 }, 19 },
+	{ {0x04325bfe, 0x5bc20a8f, 0x6d086933, 0xd138fb92, 0xca200111 }, 19 },
+	{ {0x0442dd29, 0xea0f7b78, 0xc9cd5849, 0xec7ef5bb, 0x21ec0bf5 }, 6 },
+	{ {0x0479fa6f, 0xcedf97c2, 0x560c08cc, 0x13556c9e, 0x3adf5671 }, 110 },
+	{ {0x0486938b, 0x52fbcf30, 0xa4fa206e, 0x07960a5b, 0x866fca61 }, 19 },
+	{ {0x048737f9, 0x95eecb1d, 0xd8dd341d, 0x750efd00, 0x5267796f }, 5 },
+	{ {0x049892d1, 0x633bcb3f, 0x1d5067ba, 0x710adeb8, 0x9b38fcac }, 19 },
+	{ {0x04990aa1, 0xc3a3fc72, 0x94ec884b, 0x81deaa89, 0x832df614 }, 1 },
+	{ {0x049e7dcc, 0xd3977049, 0xb5f68aad, 0x7754105b, 0x014ba771 }, 19 },
+	{ {0x04a13591, 0x0588ef87, 0x53b04a49, 0xc66d138c, 0x081284d2 }, 4 },
+	{ {0x04a56495, 0x8ea71653, 0xf87a8aa5, 0x1b84aa56, 0x7c73a8bd }, 56 },
+	{ {0x04bd7873, 0x0b100dd8, 0x79e2fbd3, 0xfe646d2b, 0xc9bbc46b }, 19 },
+	{ {0x04e4eb1c, 0xae7cf379, 0x977d238b, 0x74d727bb, 0x929c8d23 }, 3 },
+	{ {0x05182561, 0xe05fa8e7, 0xc8a8184e, 0xda885dc4, 0xfd12cc5b }, 19 },
+	{ {0x0527fb75, 0x775caa76, 0xc7eca8d4, 0x49938ace, 0x83d36e96 }, 143 },
+	{ {0x05280f0a, 0x26ac5c42, 0xab63b80a, 0x487bb909, 0x683e7461 }, 5 },
+	{ {0x05680151, 0x6eb672b4, 0xe06de5ec, 0xe8812173, 0x4bdd4385 }, 19 },
+	{ {0x05723830, 0x7d93a8c2, 0xcbb2a296, 0xb9dc2f45, 0x85315af1 }, 42 },
+	{ {0x05767fec, 0x34beaaee, 0x390a86be, 0x496d98d2, 0xb27de641 }, 6 },
+	{ {0x058af007, 0x9b868387, 0xad39c6b8, 0xa390b18b, 0x936d0e48 }, 19 },
+	{ {0x059ab9b1, 0x67c0e71b, 0xda811145, 0xa6ea04f0, 0xa41a0bdf }, 19 },
+	{ {0x05a53104, 0x3d13ba26, 0x1b0db37e, 0x4ef8b257, 0x986ce05f }, 4 },
+	{ {0x05b7a1db, 0x1ff15f71, 0x2e619fd1, 0xc79fd771, 0x0e93cb3b }, 19 },
+	{ {0x05b8109f, 0x4f0a4d9c, 0x1bcb8379, 0x82abb573, 0x236be936 }, 19 },
+	{ {0x05d7016f, 0x39e94bf9, 0xfc33d0e8, 0x482ff303, 0x8d6e01bd }, 39 },
+	{ {0x05da8409, 0x3d973d3b, 0xfbd3143f, 0xfd155a16, 0xa9ec5f82 }, 19 },
+	{ {0x06132ead, 0x4caadb23, 0x95302381, 0xbf72c608, 0x31500dce }, 5 },
+	{ {0x0626bb3b, 0x5b230adc, 0x1faab9c8, 0x0cf4f33a, 0x539a82a7 }, 19 },
+	{ {0x0672e025, 0xb47c9447, 0x398d69fb, 0xed5c56af, 0xc157acc1 }, 19 },
+	{ {0x068e5cd2, 0x32a794f7, 0xe203e531, 0x6a3ad2bc, 0xc7f3c939 }, 19 },
+	{ {0x06aa7bdc, 0x1d8f01e6, 0x7d1a1736, 0x08438439, 0x3074e613 }, 3 },
+	{ {0x06bfdd6d, 0x0f0d84b1, 0xd534c81b, 0x27150193, 0x969168b3 }, 19 },
+	{ {0x06c527db, 0x4fbe929b, 0x4da005e7, 0x463078c0, 0x5944f477 }, 5 },
+	{ {0x06cc2eca, 0x2930d67f, 0x23568ccf, 0x77a894f4, 0x75f27efe }, 19 },
+	{ {0x06fb8b9a, 0x0304037a, 0xe0e4196c, 0xa88cddf5, 0xaffd4c5f }, 31 },
+	{ {0x071e07f1, 0x10bf1b25, 0x74c63f81, 0x042fc80c, 0x894e3f73 }, 19 },
+	{ {0x0733cd62, 0x7467a866, 0x846e15ca, 0xf1770a55, 0x94eaf4cc }, 5 },
+	{ {0x0738fefa, 0x62be2acb, 0xd0f324f2, 0x8538bba9, 0x551406ac }, 19 },
+	{ {0x073feb8b, 0xb645d935, 0xe099afaf, 0x61e6f04f, 0x52adee42 }, 64 },
+	{ {0x07448ffb, 0x20f260df, 0x159a19df, 0x2cae1ee5, 0x545a0aef }, 19 },
+	{ {0x076abc98, 0x8d51faef, 0x30143750, 0xdd41318a, 0x8a48c5c4 }, 19 },
+	{ {0x076c45e1, 0x52598777, 0xcdb1ace8, 0x2b119940, 0x18bfed83 }, 3 },
+	{ {0x076d6f5b, 0x9f8427f6, 0x959f7a25, 0x5abb4aca, 0xc0dd9d0c }, 19 },
+	{ {0x076f4b6d, 0x3f6d825b, 0x8b8d3fb2, 0xbc872134, 0x21a42210 }, 19 },
+	{ {0x07793d57, 0xb00ad892, 0x7a3c1f0b, 0x1ed61c60, 0x6441dbbb }, 5 },
+	{ {0x079bacc9, 0x708f711a, 0xf90310f3, 0xe08f2aba, 0xfa8fc919 }, 136 },
+	{ {0x07af8b1e, 0xc0786c44, 0x778f68ef, 0x3bb0b3d4, 0x793f42e3 }, 19 },
+	{ {0x07c4c39c, 0x6e6c0324, 0x1d235330, 0x0f630b36, 0x7322e78a }, 5 },
+	{ {0x07db3e3f, 0xfb16c138, 0xf9da12ca, 0xcde48bf7, 0x522a188c }, 19 },
+	{ {0x0809b47c, 0xf385328c, 0x3faa6a80, 0xf8378fa5, 0xc6690829 }, 3 },
+	{ {0x08524fbe, 0xa5688512, 0x0124fbee, 0xb6e47bc0, 0x7aea4c30 }, 19 },
+	{ {0x0856cba1, 0x4ff2396e, 0xa257ff92, 0x7da0767a, 0xe74084c5 }, 19 },
+	{ {0x08691564, 0x5d703f20, 0x274aac73, 0x07f61f73, 0xcc56545c }, 19 },
+	{ {0x087afebb, 0x16bfd96f, 0x465fb0d0, 0x04326d55, 0x452bdd81 }, 19 },
+	{ {0x0889ca38, 0x3bcf2419, 0x8db1fb2d, 0xd23dea1b, 0xf8c18be8 }, 19 },
+	{ {0x08be9214, 0x5a99dd6e, 0x0539ff79, 0xdca62b2f, 0x4cc59b0b }, 19 },
+	{ {0x08cb8d0a, 0x42e1c2a0, 0x961aff3a, 0xb7026252, 0x5964b434 }, 19 },
+	{ {0x08d5a55b, 0x80726fb9, 0xc793be20, 0xe36f6d88, 0xbeb643a6 }, 19 },
+	{ {0x08eb5001, 0xbd95ffb7, 0x232cdbdf, 0xfbec7634, 0xeb110ad8 }, 19 },
+	{ {0x08fb8a2a, 0x1c05537b, 0x9deacfc0, 0xcc55e803, 0x17b84d19 }, 63 },
+	{ {0x093d5ab3, 0x9878ed4c, 0xdd42fb7c, 0x2a1502b7, 0xe65b17c0 }, 3 },
+	{ {0x0949bd31, 0xcdbdfacb, 0x3224506c, 0x72a2210c, 0x50432157 }, 19 },
+	{ {0x094d11eb, 0xf8a20b6b, 0xfc07902c, 0x7f136bdd, 0x18b1e7ca }, 5 },
+	{ {0x09779f0e, 0x9ec0c36e, 0xe3700690, 0xe2b6e282, 0xa4b40a0b }, 19 },
+	{ {0x097cae3b, 0xf23e1f38, 0x7b2c9708, 0xfbfc324d, 0xdd88837c }, 19 },
+	{ {0x09af3b68, 0xbe4eea5f, 0x5594d5d2, 0xd124d92b, 0x127dd390 }, 19 },
+	{ {0x09b0ea7c, 0x5595f4e9, 0xc9a15219, 0xf30e3423, 0xbbc25f66 }, 19 },
+	{ {0x09cc29b4, 0x13dc7b87, 0x47420615, 0xbf798169, 0xae68ad14 }, 19 },
+	{ {0x09d2563f, 0xd5d9df09, 0x5aa48be5, 0xead7771c, 0x23c50ad2 }, 19 },
+	{ {0x09db7369, 0xe42b5064, 0x1ae1a862, 0x2428909c, 0x17d23180 }, 1 },
+	{ {0x09fbbd92, 0x3e0deb82, 0xf5e20fa8, 0xce2d842a, 0xdbf4a646 }, 19 },
+	{ {0x0a0203d6, 0x9b68e1c6, 0x36fdb789, 0x34ae7fb5, 0xb4d88179 }, 56 },
+	{ {0x0a04143b, 0x9357c6f2, 0xf0dc177c, 0x2acc5b27, 0x562e2a76 }, 19 },
 	{ {0x0a2209e0, 0xa7168449, 0x3998f661, 0x8af032ba, 0x580d4ff9 }, 19 },
-	{ {0x5ec989d0, 0x82566819, 0xd2a88664, 0x63408463, 0x4f1a2c11 }, 19 },
-	{ {0xd55e9e23, 0x7504bc64, 0x44c6b628, 0x94bf8829, 0x2150042a }, 19 },
-	{ {0x811dca8f, 0xc14a2b00, 0xf503fbef, 0x74fdeae4, 0xf2873d4c }, 19 },
-	{ {0x42af8975, 0xebad6fb3, 0xed5c00c1, 0x1a236fc4, 0x9c184875 }, 19 },
-	{ {0xcb35e8c3, 0xa0a3e922, 0x81810d5b, 0x0eb886fb, 0xb1e461cc }, 19 },
-	{ {0xcf6a4318, 0x1a15cfde, 0x3091d182, 0xceaddf3d, 0x9bddd57b }, 19 },
-	{ {0xf53bdd84, 0x7d0097fd, 0x4ca47dab, 0x03157036, 0x6c882e65 }, 19 },
-	{ {0x615c0882, 0x0b926e28, 0xb143cd78, 0x12852e01, 0x1d3eeffb }, 19 },
-	{ {0x7f5a9568, 0x9b81da98, 0x387d812e, 0x0f628046, 0x6f51b832 }, 19 },
-	{ {0xb5b24db1, 0xa01ba677, 0x8b6768df, 0x15efb097, 0xfad5856f }, 19 },
-	{ {0x902d109e, 0x4ff45247, 0x1b119360, 0x39a472cb, 0xee81a902 }, 39 },
-	{ {0xa5802d5f, 0xe8bcda79, 0x354519d7, 0xe7a7b710, 0xbb6f9db8 }, 19 },
-	{ {0x6aa9f757, 0x20bb38e4, 0x10d75122, 0x5d18e898, 0x5ab4d61f }, 19 },
-	{ {0xc5568fc0, 0x7bfb193b, 0x43ad7c84, 0x0787f274, 0xd9c1e42f }, 19 },
-	{ {0x983f97a0, 0xd8aedad5, 0x2f5a2ade, 0x5fed6f28, 0x12218b2e }, 19 },
+	{ {0x0a272147, 0x999e5075, 0x987e8649, 0x35c84ab3, 0xdef2c47d }, 19 },
+	{ {0x0a7bed65, 0x2592ed63, 0x25acd037, 0xf1f5bbbd, 0x1d31b239 }, 5 },
+	{ {0x0a9c576e, 0xabaf2651, 0xddca35bf, 0x17f96e50, 0x9d6c6ba0 }, 19 },
+	{ {0x0ac6c061, 0xc3897a39, 0x89dcd75b, 0x4878c850, 0xc71e4bb8 }, 19 },
+	{ {0x0b02dda5, 0x316a318a, 0x7f75a811, 0xaa54200d, 0xdd7abc30 }, 5 },
+	{ {0x0b324120, 0x2f0e2be4, 0x70e5f2e6, 0x139c0198, 0x3a895bc8 }, 19 },
+	{ {0x0b379610, 0xcb708500, 0x5a56b24a, 0x0890b79d, 0xd5a7e817 }, 10 },
+	{ {0x0b3a217d, 0x3278a43d, 0x7460136f, 0x955171c7, 0x62a1f8e5 }, 19 },
+	{ {0x0b3f5dbd, 0xbf5636e2, 0x2b3a6bc1, 0x2eeb4ac6, 0x4b0501e5 }, 3 },
+	{ {0x0b474ac5, 0x3701ff0d, 0x53d30e09, 0x90faa76f, 0xcca90f39 }, 19 },
+	{ {0x0b8ab949, 0x7924547b, 0x6afbddb1, 0x7013dd5d, 0x84efebb9 }, 67 },
 	{ {0x0b9a870d, 0x1e6cc712, 0xa3efce23, 0x49fb1c1c, 0xf6902d22 }, 19 },
-	{ {0xde3035a1, 0x59dbd910, 0xd4f390cc, 0x814e9e99, 0xfba94ee0 }, 19 },
-	{ {0xb6f10b6b, 0xedc26d94, 0x15335997, 0x493139ce, 0x7a2c7916 }, 19 },
-	{ {0x3abae41c, 0xb742b76f, 0xf45dd178, 0xbd7db346, 0x137fe0fa }, 19 },
-	{ {0x39cb046a, 0x9b6b6ef4, 0xe769cdc6, 0xfdf36b27, 0x4cd44039 }, 19 },
-	{ {0xe8b9690a, 0xf00be945, 0x13c417d7, 0xcb780163, 0x39f6dc60 }, 19 },
-	{ {0xebb46dd4, 0xcf36407a, 0xd82d9f50, 0xd9bef3e9, 0x38dc144e }, 19 },
-	{ {0xaf1a6f4d, 0xd12d726a, 0x7a437775, 0x3ce3db82, 0xbf24eba4 }, 19 },
-	{ {0xd1e3afec, 0xde165609, 0x9dadff99, 0xc6ed2aa8, 0xfa6dd834 }, 19 },
+	{ {0x0ba8ae69, 0x7f3045b3, 0xb3175b27, 0xd00ac0e5, 0x22288ff1 }, 19 },
+	{ {0x0bc97a87, 0xb42b0e9d, 0x5855dde9, 0xb8839292, 0x1a9b3277 }, 19 },
+	{ {0x0bf7b432, 0xdc132f9a, 0x7bc74106, 0x261bca07, 0xd5f99690 }, 19 },
 	{ {0x0c364c34, 0x99df76f2, 0xe15d2aeb, 0x744a0de3, 0x730ff47b }, 19 },
-	{ {0x821c611b, 0x851ddd4c, 0xf8cfb4e7, 0x7cecbc88, 0x2f12eb72 }, 19 },
-	{ {0xf9e9a6e5, 0x17ee0b9b, 0x3147abb6, 0x144b31ed, 0x2ca8dbda }, 19 },
-	{ {0xa502e37f, 0x580bd287, 0xed8338fc, 0xb1d809b8, 0xdc90bbe0 }, 19 },
-	{ {0x650381b9, 0x6f36e74a, 0x4eaf5ae3, 0xf924f6f8, 0xdeac7100 }, 19 },
-	{ {0xf5526481, 0xe64def12, 0x9bd4109f, 0xa2074609, 0xee2e92a0 }, 19 },
-	{ {0xb5afee9c, 0x37901735, 0x4fbefce7, 0x97701efe, 0xeb30caea }, 19 },
-	{ {0xca770384, 0x382bd487, 0xdd733055, 0x2403f85d, 0x7edbb8ce }, 39 },
-	{ {0x80ada024, 0x1ded833e, 0x249c498d, 0x01b0bb54, 0x179e6643 }, 19 },
-	{ {0xa4be5763, 0xcdf2dcd6, 0x47b87e3a, 0xecbab28e, 0xcc69776e }, 19 },
-	{ {0xdd5c2d2d, 0x5f094715, 0x9b7615f6, 0x47fb8121, 0xf3b037a2 }, 19 },
-	{ {0x20aeb411, 0xab5adb9b, 0xd3db412a, 0x7837e496, 0x969f8ce3 }, 19 },
-	{ {0x4075ef9f, 0x51b4e010, 0xbd2481a6, 0x48e05b2c, 0x29b3329d }, 42 },
-	{ {0xadc65666, 0xdb35cd2c, 0xe694a8e2, 0xf32b95bd, 0x98d72291 }, 19 },
-	{ {0x2544de44, 0x386cf49d, 0xad2eb103, 0x5ea0e855, 0x3dd7598b }, 19 },
-	{ {0xb3ca70c8, 0xc8120f82, 0x61bb865b, 0xaf5f57b6, 0x506ca02e }, 19 },
-	{ {0xfe71908e, 0x340aa5dd, 0x241d56a3, 0xe8381263, 0xe5eb5aeb }, 19 },
-	{ {0x30673d17, 0x3f96fe18, 0x30e579f1, 0x8daf8ac9, 0xfc3366cb }, 19 },
-	{ {0xa2a7c93c, 0x9c8b55a5, 0xcce4c900, 0x5f3c194e, 0x3b762e9c }, 19 },
-	{ {0xee3ca231, 0x328534bb, 0xa92f9a90, 0x8c4faed8, 0x65bcea68 }, 19 },
-	{ {0x615d685f, 0xef332a77, 0x42324f96, 0x08eb69e6, 0x336faaa1 }, 19 },
-	{ {0x99f9e975, 0x3edbaee8, 0x20e36a1a, 0x58f1cd7a, 0xe2b26265 }, 19 },
-	{ {0x53ed25cf, 0x66a6ed4b, 0x432fa7e4, 0xf10a6730, 0xce6923be }, 19 },
-	{ {0x7eeeaaed, 0x7c69a524, 0x5f45b937, 0x183a203a, 0xde3c11a4 }, 19 },
-	{ {0x20ce189d, 0x670c0fe5, 0xf2a945d7, 0x3107df7d, 0x83070ff7 }, 19 },
-	{ {0xae6d0efd, 0x55def942, 0x74f4cec4, 0x59df8927, 0xd132675a }, 19 },
-	{ {0x83dc4599, 0xfb670605, 0x9424695c, 0x58e7dd7b, 0x3041a846 }, 19 },
-	{ {0x0071b2eb, 0x214ff002, 0xdbbb7532, 0x653585b3, 0x5b56f243 }, 19 },
-	{ {0x488a9aae, 0xd538c2a2, 0x4088cbd6, 0x815d4741, 0x4cff999f }, 19 },
-	{ {0x07af8b1e, 0xc0786c44, 0x778f68ef, 0x3bb0b3d4, 0x793f42e3 }, 19 },
-	{ {0xd632a1f0, 0x6a801842, 0x2fc9bc83, 0xab26c501, 0xd34d447d }, 19 },
-	{ {0x92727e6e, 0xcc52dfec, 0xa071673f, 0x0d58e964, 0x746899d2 }, 19 },
-	{ {0x59a124ed, 0x38869892, 0x496fc12f, 0x14af404a, 0x422e162a }, 19 },
-	{ {0x47ea8d51, 0x2d9fec15, 0xdf8770f3, 0xb5017aea, 0x9bbba9fd }, 19 },
-	{ {0x308c73fc, 0x04c3b390, 0xb72ea8d4, 0x980c94c7, 0x4ba38a5c }, 19 },
-	{ {0x17f24b93, 0x39291dea, 0x40d2ed36, 0x517f223b, 0x9e4f49e1 }, 19 },
-	{ {0xac391fe5, 0x1f69e0a5, 0x5fe3ab66, 0xc8ec3f27, 0x92dd5d08 }, 19 },
-	{ {0x83fdaa42, 0x9ad8b155, 0xab2328a7, 0x2fcb8de6, 0x42ff5615 }, 19 },
-	{ {0x95d8a590, 0xbad595f9, 0x441aea4b, 0xf68667de, 0x05b1b34b }, 19 },
-	{ {0x3a8c815f, 0x9f97c067, 0x828e22f5, 0x0386a938, 0x3f8e1a3d }, 19 },
-	{ {0x76a79dd0, 0x554b8f7e, 0x84468fcd, 0x3bf73459, 0xce4aeb2b }, 19 },
-	{ {0x3450f93f, 0xc2b08a05, 0x2a709930, 0xc97edead, 0x0099e447 }, 19 },
-	{ {0x1cf39e12, 0x313ff306, 0x4353c136, 0x262f176a, 0x56ab20a6 }, 19 },
-	{ {0xf3434cae, 0x8631f2f9, 0x068b3624, 0xbfd1ed8b, 0xa4292370 }, 19 },
-	{ {0x546aaf36, 0xee78717f, 0xe0612518, 0x5f0d420f, 0xdff0d34c }, 19 },
-	{ {0xa054ddea, 0xf4712127, 0x64cc596b, 0xcbd30e94, 0xb10e6c28 }, 39 },
-	{ {0xfc327d39, 0x46366ca7, 0x5de0d061, 0x9eb0917a, 0x27e1bd61 }, 19 },
-	{ {0xd2604a1f, 0x76cadd36, 0xede570e2, 0x3ad49b08, 0x85187e25 }, 19 },
-	{ {0x8cf06f93, 0xd4e8bcf7, 0xbe04ae85, 0x32f72e6e, 0xec8ba2f1 }, 19 },
-	{ {0x553ed3a8, 0x577f25b6, 0xee884ba7, 0x8fba5454, 0xdd5cac36 }, 19 },
-	{ {0x9aab2b5d, 0xd7ae963d, 0x2f1eb7b3, 0x51222219, 0x96b96ffe }, 19 },
-	{ {0x10907d8e, 0x9845d8f9, 0xd8b5283a, 0xffd7bb82, 0x4963194f }, 5 },
-	{ {0x630aec6f, 0x93df8d1e, 0xf83c52a0, 0xbb6ec571, 0xb9c6eed4 }, 19 },
+	{ {0x0c425d8f, 0xc1ad36c9, 0xb8e248e4, 0x77b1796c, 0xd62d9bed }, 4 },
+	{ {0x0c625910, 0x33aa4e5e, 0x6b9eeb21, 0xeb2e5e60, 0xdcd8ee8e }, 3 },
+	{ {0x0cb11c76, 0x6bd357d2, 0x03879bd6, 0xbee041a4, 0x690cc3df }, 6 },
+	{ {0x0cbe0df4, 0xaf45e8f5, 0x31e9c761, 0x403ac9e7, 0x1808f20c }, 1 },
+	{ {0x0cc6c30c, 0x6918fcf7, 0x80e57d40, 0xf58a4cf2, 0xa82225cd }, 38 },
+	{ {0x0cf26bf0, 0x2c5b94df, 0x118129a6, 0x81a7f14a, 0xdd708177 }, 19 },
+	{ {0x0d246b0e, 0x3edc6380, 0x3fcce861, 0xea07eadf, 0x29dc488c }, 42 },
+	{ {0x0d2ba1f2, 0x033ae006, 0x9236d9eb, 0xc5411130, 0xf159d5cd }, 19 },
+	{ {0x0d2f86db, 0xb70f4b4a, 0x4e4dc1bc, 0x95df232f, 0x48856037 }, 18 },
+	{ {0x0d459788, 0xb6c464b5, 0x0cbc2436, 0xe67a2cef, 0x248e0c4a }, 3 },
+	{ {0x0d504c35, 0x9661ac73, 0x1de07a73, 0x19afd0e3, 0x1f01a5d7 }, 19 },
+	{ {0x0d53c456, 0x603a56b3, 0x9392b203, 0xad753233, 0x57895381 }, 19 },
+	{ {0x0d737079, 0x4507150d, 0x78825e5b, 0xc20553be, 0xa034c309 }, 19 },
+	{ {0x0d76a069, 0x726fec73, 0x26541f75, 0xb809b8b7, 0x2148ed3a }, 5 },
 	{ {0x0d8b7fff, 0xbaccddca, 0xe324e38f, 0x7f85722e, 0xce8d5976 }, 19 },
-	{ {0xfa9ae320, 0x5ac5fe83, 0x04d53d94, 0xbb8b1cb3, 0x94183c3a }, 19 },
-	{ {0x76461e05, 0x3178371a, 0xeb457588, 0x233cbfcc, 0xd0d6c02a }, 19 },
-	{ {0xfc6660a2, 0x02dbd228, 0xc9e0d7c4, 0x04340d1d, 0xcc1e2844 }, 19 },
-	{ {0x2c0c71c5, 0x49738d66, 0x8518db31, 0x7dd70aec, 0xefd4aa72 }, 19 },
-	{ {0xc83ee585, 0xa2b5643f, 0xefa61d77, 0xcd4455d6, 0xaad7cb52 }, 19 },
-	{ {0x1fc9d3b5, 0x4a617e57, 0xfd6ed10f, 0x2ce3c014, 0x56710e37 }, 19 },
-	{ {0xbd8f335f, 0xc45e9920, 0xf0691a52, 0x5a0fc853, 0xb2e4b595 }, 19 },
-	{ {0x99d3ef10, 0x7f2ac4d4, 0x52b05eb9, 0x6b922924, 0xef4c5434 }, 19 },
-	{ {0xe73fb565, 0x55a72327, 0x58d4b5bf, 0x2dd6736c, 0x9b3d5358 }, 39 },
-	{ {0xd44e9a41, 0x9f5bba1b, 0xccecc907, 0x71f066fd, 0x6a8093db }, 39 },
-	{ {0x8c19e017, 0x6b87f243, 0x60579223, 0x28dd1945, 0xbb3175ba }, 39 },
-	{ {0x8592b14e, 0xe701eaaf, 0x433113a2, 0x6b199084, 0xc124992f }, 19 },
-	{ {0x868d84f8, 0xa6ae0434, 0xbf86adfb, 0xb86996ce, 0xddefba84 }, 19 },
-	{ {0x09cc29b4, 0x13dc7b87, 0x47420615, 0xbf798169, 0xae68ad14 }, 19 },
-	{ {0x9865f0bc, 0x4d541378, 0x09f0d8b4, 0x8d5461dd, 0xf0c5bf4c }, 19 },
-	{ {0x76107162, 0x2b60384e, 0xc38e964f, 0xa2b2ee12, 0xd3d0b2c9 }, 19 },
-	{ {0x03ae0eeb, 0xbbf80f8e, 0x51c5892a, 0x74aa2b4f, 0x287a9319 }, 19 },
-	{ {0x97b8ef65, 0xd86ec425, 0xd5901fce, 0x80d33a3d, 0x731e50e1 }, 19 },
-	{ {0xd76a904d, 0xd88f7360, 0xfe79000c, 0x374f40a6, 0x9b801325 }, 19 },
-	{ {0xb5bb76d6, 0x66dda2c3, 0xad93f2ec, 0xe44be72f, 0x5d0f61e3 }, 19 },
-	{ {0x0ac6c061, 0xc3897a39, 0x89dcd75b, 0x4878c850, 0xc71e4bb8 }, 19 },
-	{ {0xb6f8e143, 0x1bda1296, 0xc2959b10, 0xb021b80e, 0x0ff2a8a2 }, 19 },
-	{ {0x613cc52f, 0xbd5822ad, 0xe47daa3e, 0xc2147964, 0x1a009c2c }, 19 },
-	{ {0x78818059, 0xd126e80c, 0x33ab654e, 0x9ec749cf, 0x336f8f96 }, 19 },
-	{ {0x6cf3f098, 0xd592d7dc, 0xb767a0e2, 0x4b5caf32, 0x7b5f22db }, 19 },
-	{ {0x30fa1447, 0xf8ef8e8f, 0xf9653dce, 0x6d7d6721, 0x04f6e6ab }, 19 },
-	{ {0x9e0312e7, 0x2f30a20f, 0x556b64fe, 0x37dbbfe0, 0xd4471823 }, 6 },
-	{ {0xa731d3d3, 0xb5badf33, 0xc7602feb, 0xd32cc4e6, 0xec98c646 }, 17 },
-	{ {0x5586085d, 0x3be79378, 0xf9623e52, 0xfd04cad2, 0x5febc34b }, 19 },
-	{ {0xff5b1227, 0x5950edae, 0x9ece3f49, 0xed59402d, 0x47f23b1b }, 39 },
-	{ {0x5d5dfe6c, 0xec605de4, 0x21c3aed3, 0xa743d684, 0x0fec1457 }, 39 },
-	{ {0x76c191bf, 0x7dcc0888, 0xd65e543c, 0x47f615ae, 0x45b75b92 }, 19 },
-	{ {0x70a8afee, 0x598dd2e2, 0x095353e5, 0x086b9f73, 0x7cf89be3 }, 19 },
-	{ {0x484a21c6, 0x2bde3eab, 0x537f394b, 0xc270ac7c, 0x1c557f7c }, 39 },
-	{ {0x31b452ff, 0x42624c6a, 0xc1e0141d, 0x65869df1, 0xeabe5bb3 }, 19 },
-	{ {0x8e644537, 0x6d1fd15c, 0xb5524786, 0x117a09ac, 0x5a832169 }, 19 },
-	{ {0xf0d74d95, 0x1a3781c7, 0xa2680e1d, 0x7ab809d2, 0xafe1fd18 }, 19 },
-	{ {0xd29414f6, 0x1bc1c4f8, 0xc1fe4a24, 0x3a8a8afc, 0x2d4f6925 }, 19 },
-	{ {0x2f4fa99f, 0x80313358, 0xe4308449, 0x0ec44f67, 0x3268bc52 }, 19 },
-	{ {0xbbe8df03, 0x4869a06c, 0xb263255a, 0xc04374de, 0x469c00ba }, 19 },
-	{ {0x25b28cfe, 0x8d6d51f6, 0x19d182c7, 0x74f6ceb0, 0x5b577eeb }, 6 },
-	{ {0xbb902e82, 0xa2bdda61, 0x101a9b36, 0x46462ade, 0xcdd18c8d }, 11 },
-	{ {0x7538fe6f, 0x0dfbf72b, 0xa7a89d34, 0x9258afdf, 0xf547b4c1 }, 19 },
-	{ {0xd0e8bc3f, 0x5fd93dcd, 0x07cbb945, 0xb00018a4, 0x91842242 }, 42 },
-	{ {0x3d2d0a2e, 0xb3d12fa6, 0x7ecbbb90, 0xb7ac1bdc, 0x76ad8412 }, 42 },
-	{ {0xc6f09088, 0x2886dcf7, 0x83e5b65b, 0xff75c5e0, 0x34fbb2eb }, 42 },
-	{ {0x882a63a9, 0x655e53fd, 0xdb1cd487, 0x61a1a09b, 0x28f7e5a3 }, 19 },
-	{ {0xe82bbd2d, 0x9dbbb30a, 0x2b4a2599, 0x54c5484f, 0xa236733a }, 19 },
-	{ {0xf864f825, 0xb2270c3b, 0x98b3c046, 0x71a3ac5f, 0x2d95affa }, 19 },
-	{ {0xba325451, 0xfb5a80c2, 0x872742c5, 0xbd61e7bb, 0x75c5763b }, 19 },
-	{ {0x0ba8ae69, 0x7f3045b3, 0xb3175b27, 0xd00ac0e5, 0x22288ff1 }, 19 },
-	{ {0xc62e058c, 0x2a54f3c9, 0xadba2e6a, 0x3006b8e7, 0x49c43bd7 }, 19 },
-	{ {0x18e87e15, 0xb09ec2fd, 0xdc52fad1, 0x0edc5791, 0x8fadec34 }, 19 },
+	{ {0x0d9a37ff, 0x931e5db2, 0xcdee2e0f, 0x312fd4bb, 0xef5cfd29 }, 42 },
+	{ {0x0d9c472c, 0xf7687b86, 0xf3fe2e5a, 0xf6545a26, 0xa0efd5fc }, 6 },
+	{ {0x0dbc7def, 0xd96b71c1, 0xfe2d63cb, 0xc725f5e5, 0x8aea2db0 }, 25 },
+	{ {0x0dde59e8, 0xd98fa524, 0x961cd37b, 0x0e100dbf, 0xb42cf576 }, 1 },
+	{ {0x0de3c802, 0x05756056, 0x0a03d796, 0x5fcc4cff, 0x69f8575c }, 1 },
+	{ {0x0dfe92b4, 0x8e99bed4, 0xcd879e40, 0x26d036f9, 0x4c826ce8 }, 19 },
+	{ {0x0e06519e, 0x68c78a8f, 0x01815251, 0x1f4f1337, 0x4c5856aa }, 19 },
+	{ {0x0e081572, 0xf84555dc, 0x13bdb0c7, 0x044a19d6, 0xc164d985 }, 65 },
+	{ {0x0e24c5c4, 0xf16d5f95, 0x64d1bcbf, 0x29e4187c, 0xb6ad9701 }, 19 },
+	{ {0x0e5062bb, 0x18b4a6fb, 0x93a89318, 0x77292887, 0x4dd4d6ea }, 19 },
+	{ {0x0e6b6644, 0x021dbfad, 0x3c486c37, 0x8818ea5e, 0x432bb9fd }, 19 },
+	{ {0x0eb3a48a, 0x8ab90826, 0x726f0c06, 0xdaadf4bf, 0x13390758 }, 9 },
+	{ {0x0ebd63dd, 0x4405bc14, 0x1ba3d170, 0x10d6d928, 0x979f19d5 }, 19 },
+	{ {0x0ec71916, 0x791e05d2, 0x07d7fe0a, 0x461a79a7, 0x6eab52c5 }, 4 },
+	{ {0x0ede48e2, 0x53729833, 0x963f1239, 0x932d8d26, 0xa5e618a1 }, 19 },
+	{ {0x0f10d77d, 0x1536993b, 0x8455b3b4, 0x7278ca57, 0x82ef9275 }, 5 },
+	{ {0x0f1c600f, 0xc3c3f7ef, 0x390214ee, 0x8028ce11, 0x8d2cf5b8 }, 19 },
+	{ {0x0f214ea9, 0xe8d673ee, 0x0c66cb66, 0x15032e57, 0x920d588b }, 19 },
+	{ {0x0f298581, 0xb85e838c, 0x1fbaa242, 0x73d29221, 0x7f81662c }, 3 },
+	{ {0x0f2c5a7c, 0x6cc9ff59, 0x1c911e4f, 0x3f204e42, 0x5bd3cf50 }, 136 },
+	{ {0x0f4f09f1, 0xa6ef7535, 0xb243afab, 0xfb44a3a0, 0xeb0498d9 }, 39 },
+	{ {0x0f579885, 0x0d11b316, 0xa4254b22, 0x2ca08cc4, 0xad6d4da2 }, 65 },
+	{ {0x0f57ede0, 0xe3deeabf, 0x47f03ea9, 0x7860934a, 0x5a36eee2 }, 96 },
 	{ {0x0f5e4590, 0xd526f5a1, 0x5d0442fd, 0x9194f76b, 0xce9bc081 }, 19 },
-	{ {0x3574a6dc, 0x95457934, 0x1934452f, 0xeb141859, 0xb7cfa3bc }, 19 },
-	{ {0x27a487e5, 0x6721e947, 0xc1f46644, 0xf2f8a501, 0x56dda82d }, 19 },
-	{ {0x2418c030, 0x2abbce8b, 0x0f8556b6, 0x3169c60a, 0x849f60ee }, 5 },
-	{ {0x6159cdfc, 0x79c68bf7, 0xdfe2653f, 0xc0b5893a, 0xe913c72b }, 5 },
-	{ {0x1833ffc2, 0x52d43d3d, 0x8239e57d, 0x5ac2c015, 0xb4367988 }, 17 },
-	{ {0xd8c07426, 0x7e0b2ec2, 0x25d5acba, 0x688ea730, 0x4233da13 }, 19 },
-	{ {0x0738fefa, 0x62be2acb, 0xd0f324f2, 0x8538bba9, 0x551406ac }, 19 },
-	{ {0x8c5cf2df, 0x5f0b9df6, 0x7239161a, 0xa843d980, 0x4af46f0e }, 19 },
-	{ {0x595ed23f, 0x45a83827, 0x39a3b865, 0xe153583f, 0x41f4ead7 }, 19 },
-	{ {0x7c618058, 0x809302bc, 0x3553d618, 0x9bcf310f, 0x2e5b0e08 }, 39 },
-	{ {0x50eafa5d, 0x735af5b3, 0x4d14f9f6, 0xb8c2d9cd, 0x2f0441db }, 39 },
-	{ {0x6a4e8325, 0xd2174747, 0xd56cbe4c, 0x6803cbf4, 0x0eb40a62 }, 39 },
-	{ {0x4b19979e, 0x01bab228, 0x9abb6034, 0xcb3c2d02, 0xc2e890d1 }, 19 },
-	{ {0xc5cd97ee, 0xbe8ac90e, 0x57197f0d, 0xf847f24e, 0x14779e2f }, 19 },
-	{ {0xf53fd0b5, 0x50c437d6, 0x83668376, 0x829fbd7f, 0x569f0ee5 }, 19 },
-	{ {0x6856a13b, 0x67750d36, 0xc4c466d3, 0x0472dc54, 0x65879bbf }, 19 },
-	{ {0x5d43cb6c, 0xa89f31d5, 0xf543e4dc, 0xd3fa9987, 0xb9769602 }, 19 },
-	{ {0xa1656f61, 0x2360a126, 0xe09ef2ba, 0xaa8002d9, 0x2054125d }, 19 },
-	{ {0x4233ab2f, 0xb0d956e0, 0xefb43e2a, 0x489ca46b, 0x65aeda8f }, 19 },
-	{ {0xe6419519, 0xc2d3247e, 0xa395e4fe, 0xaa494a2e, 0x23e469ce }, 8 },
-	{ {0xd82135a5, 0xe28b750c, 0x44995af1, 0x16db890a, 0x15f6428a }, 8 },
-	{ {0x6bad9af9, 0x1907c2a9, 0x7fa2f4b9, 0xdd2a699c, 0xe0d70fba }, 19 },
-	{ {0xd5b16479, 0x7bc969b5, 0x5c1a6f40, 0x06a4535c, 0x3fb03cf0 }, 17 },
-	{ {0x4b4a58a3, 0x10a1138b, 0x95192d7f, 0xe0881bbd, 0xc45601d4 }, 19 },
-	{ {0x91ba5c06, 0x3d0ed383, 0x165b26e4, 0x609d7abd, 0xa02a5242 }, 19 },
-	{ {0xe3391daa, 0xb17710b3, 0xf34c70f6, 0x0ac6c8bf, 0xea15b6cc }, 19 },
-	{ {0x6e2e5cff, 0x4ee4dd93, 0x5fbe6684, 0xf2c54b39, 0xeca06092 }, 19 },
-	{ {0xc1376fac, 0xb3db0124, 0xf0557a95, 0x684d3059, 0xa3043fec }, 19 },
-	{ {0x03b42b77, 0xb1a7412f, 0x1d7bd099, 0x8cf8f2f0, 0x03f77d0a }, 4 },
-	{ {0x65f89c81, 0x3a1d57a8, 0xf8a04e81, 0x682202f7, 0x59ee6980 }, 19 },
-	{ {0x39a40c12, 0x65cc663e, 0xef0d21de, 0xa01a9bf5, 0x2c8c140e }, 19 },
-	{ {0x6b12bb29, 0x1e1a98a4, 0x3ccff8ce, 0xb94d2358, 0x5848febc }, 19 },
-	{ {0x23531b4e, 0x8a2b3e97, 0x54833188, 0x46cf89e6, 0x5f32f7d1 }, 19 },
-	{ {0x8f27317f, 0x5eaa3ec7, 0xd5b63184, 0x808a6202, 0xcf036c0f }, 19 },
-	{ {0x9a743e99, 0x7179bafc, 0x51f04d42, 0x2f0bf1e8, 0xb22fb1d5 }, 19 },
-	{ {0x86fdfe9e, 0x26d6e77f, 0x41cbcb47, 0xe10e2f32, 0xe5518549 }, 17 },
-	{ {0x291108a6, 0x3e8aaaf0, 0x6997bee7, 0xe988f89b, 0x0a7bb187 }, 19 },
-	{ {0xf8feeac4, 0x384bc4f1, 0x09c70f96, 0x2e15ce92, 0x5bf70c13 }, 19 },
+	{ {0x0f74234a, 0xdda250d7, 0x2d414787, 0x2cb421a3, 0xb6f26efa }, 19 },
+	{ {0x0f7f55fe, 0x448d20fc, 0x65dc03c2, 0xa4f17177, 0x61671e43 }, 19 },
+	{ {0x0f81ebbd, 0x3d027965, 0x00b3f862, 0xfe1a8d58, 0x4fb228d3 }, 56 },
+	{ {0x0f851ee7, 0xa1cf7981, 0x9f61cc89, 0xe9948ee7, 0x2a413802 }, 1 },
+	{ {0x0fa2bb1e, 0xffefde08, 0x61fe53a3, 0x8ff5b56a, 0x6a320c80 }, 19 },
+	{ {0x0fbd45ef, 0x3dd7bb82, 0xd4c31f19, 0x47884f41, 0x1f1ca344 }, 1 },
+	{ {0x0ff68843, 0x3d7ad075, 0xfb22ac92, 0xac8f1b88, 0x3c7a9ae4 }, 19 },
+	{ {0x1064aa5c, 0x8a884ddd, 0xc0a27147, 0xca70881e, 0x04988725 }, 6 },
+	{ {0x10698ea6, 0xb0423f2e, 0x858a4c28, 0xc10f3964, 0x6ca5495f }, 19 },
+	{ {0x1074acd3, 0x7ee42661, 0xd86b75a8, 0x491365ed, 0x8ceaa6e0 }, 39 },
+	{ {0x10758fb5, 0xd42b97a0, 0x5b537db9, 0xb009bd64, 0x4c153c93 }, 5 },
+	{ {0x108abde7, 0x1e59839f, 0xb4d1e59c, 0x3a0cb236, 0x6220030c }, 19 },
+	{ {0x108e9164, 0xef6cf1ff, 0xe6e3c530, 0x3bfbbc3b, 0xd807b6df }, 5 },
+	{ {0x10907d8e, 0x9845d8f9, 0xd8b5283a, 0xffd7bb82, 0x4963194f }, 5 },
+	{ {0x1090b058, 0xd39dfd7b, 0xd7ea1a1f, 0x6f8fe994, 0x7a54805c }, 19 },
+	{ {0x10c38f91, 0xd8f5db24, 0x38414ea5, 0x8f26dcac, 0x78352088 }, 9 },
+	{ {0x10e63eba, 0x7d2b10d9, 0x46822f21, 0xe7fd106f, 0x5dfab632 }, 19 },
+	{ {0x11140aff, 0x5c92f580, 0x3f8fdbbb, 0x274c7518, 0xaf67b570 }, 98 },
+	{ {0x11306e41, 0x84da7930, 0x50ca6c0f, 0x59ad3b2b, 0x9f084ef6 }, 19 },
+	{ {0x1131e86e, 0x488e24cd, 0x8ef9a341, 0xc3115c5c, 0x7addd3b7 }, 110 },
+	{ {0x117d3b78, 0x3da9c693, 0xe3fcb71f, 0xd113f7d9, 0x0895c8d6 }, 19 },
+	{ {0x11b71263, 0x3bd0e44e, 0x8d59ceba, 0x5a2d6b1c, 0x20a43ef9 }, 6 },
+	{ {0x11e2f95d, 0x1b58e124, 0x4efda761, 0x603a2ae6, 0xd0090d18 }, 19 },
+	{ {0x11f1b9fd, 0xa9a44f59, 0xa6de479a, 0xebc18fbc, 0x6347f5a7 }, 5 },
+	{ {0x120d477c, 0xd28b48b8, 0xa63efb34, 0x920ac331, 0xb54e66e5 }, 19 },
+	{ {0x122f6592, 0x50a0ae10, 0xce0be0dd, 0xe626dd3e, 0x384affa7 }, 6 },
+	{ {0x1231984a, 0xe24bf35f, 0x9f38596b, 0x864420d8, 0xccd3f30b }, 19 },
+	{ {0x124126ce, 0xe840e43c, 0x7668c11c, 0x2bec2f34, 0xb3d00c68 }, 63 },
+	{ {0x12b3c31f, 0x0fd10ff5, 0x823dcc8b, 0xf6dfeb78, 0x5a8af2f7 }, 38 },
 	{ {0x12c5edb4, 0x1e696943, 0xc16f39c7, 0xb45b2aed, 0xc421411f }, 19 },
-	{ {0x8bb26018, 0x1c404222, 0xe67f37ce, 0x84a252c5, 0x777472bc }, 19 },
-	{ {0x83fce8c3, 0xe4843c4b, 0x1782b9ef, 0x83413c98, 0xf081d12e }, 19 },
+	{ {0x12f2cc79, 0xb3d09723, 0x840bae77, 0x4be48c0d, 0x721ec1c6 }, 65 },
+	{ {0x12f6f31f, 0x495bfb38, 0x4c9ca906, 0x7bfbf8f9, 0x8af6adf9 }, 6 },
+	{ {0x12f7eafa, 0x2e411351, 0x73dafed9, 0x07c8643c, 0xf5298d31 }, 42 },
+	{ {0x13007f93, 0x40670ded, 0xa42c4b53, 0xc06c19d3, 0xd3c09704 }, 27 },
+	{ {0x1302d258, 0xc952e936, 0x66ecec12, 0x429d6d2c, 0x2f841f43 }, 5 },
+	{ {0x134a6faf, 0x15929786, 0x08b55269, 0xaea101d5, 0xfad68760 }, 19 },
+	{ {0x136d838c, 0xc1297940, 0xd96cd8e2, 0x7aea9f9e, 0x3c7088a6 }, 42 },
+	{ {0x136f2ded, 0xd45f4419, 0x837eb1e4, 0xe623cb1d, 0xc317ef39 }, 19 },
+	{ {0x138a2d56, 0x237aea91, 0x5baaef85, 0xe69425a6, 0x58506cfb }, 19 },
+	{ {0x13c59dd8, 0xf7320856, 0xb15c8340, 0x38af3c84, 0x6db33e4e }, 4 },
+	{ {0x13D38CC8, 0x0112BAA9, 0xBCBF0356, 0x9988C163, 0x015D434C }, 19 },
+	{ {0x13f55fcb, 0x993dabbe, 0xf792f2a3, 0x696c4f54, 0x5f31f44b }, 19 },
+	{ {0x13fbb273, 0xa9548133, 0x0d33c9ed, 0xc4263e30, 0xccf1774d }, 5 },
+	{ {0x1417f9e8, 0xca99deb3, 0xb422c596, 0x8fdfa03c, 0xfa633ec6 }, 4 },
+	{ {0x141e61cc, 0x8e0e5138, 0x2e508fbd, 0x77a34b77, 0x8a4f8444 }, 57 },
+	{ {0x14343864, 0x54c77680, 0x0cba3805, 0xc4041b01, 0x05c2f71f }, 56 },
+	{ {0x14393568, 0x469c74bd, 0x6f8be777, 0x0149db19, 0xf0553ab6 }, 19 },
+	{ {0x14403ca7, 0x1d287084, 0x569e6c2f, 0x4124d271, 0x2c665219 }, 5 },
+	{ {0x14451b29, 0x31a014e9, 0x49a4b3d2, 0x973d424d, 0x910e0d9d }, 19 },
+	{ {0x1449f9b1, 0xf8891378, 0x31089ddc, 0x73e04b8c, 0x6b5a56ee }, 19 },
+	{ {0x14537ad9, 0xa5512452, 0x61776bf9, 0xb64068fe, 0x4921ad47 }, 6 },
+	{ {0x145552b3, 0xf62885ef, 0xcfe74840, 0x08fa4ceb, 0xe2feae84 }, 136 },
+	{ {0x146332dd, 0x0a190c3e, 0x6eb4abe1, 0xc4306a8f, 0x6faca9f0 }, 19 },
+	{ {0x148c9a4f, 0x316ff73c, 0x4e802baa, 0xdc34bf85, 0x2492821d }, 19 },
+	{ {0x14de1be5, 0xde19a279, 0x19d80cda, 0xd2ceb055, 0x4a48ff02 }, 19 },
+	{ {0x14e7ef12, 0x5cc90200, 0x1995bbd8, 0xacca0eae, 0x2f213dc1 }, 19 },
+	{ {0x14f2d64d, 0x05e2e53e, 0x876e3d6a, 0xf0a5711e, 0x557e3c96 }, 19 },
+	{ {0x14fae375, 0xb81c86f7, 0x1e872adc, 0xa792c23a, 0xafac66a0 }, 19 },
+	{ {0x14faf5da, 0x6ab76de0, 0xb62f1ede, 0x91e27d46, 0xb9db77a2 }, 5 },
+	{ {0x14ff6fe4, 0x64362c6b, 0x7dbb47b2, 0xecda3a8c, 0x5f05ef79 }, 5 },
+	{ {0x1500a076, 0x93a7c061, 0x89f4cd67, 0x64d5ee62, 0xf0edd85d }, 19 },
+	{ {0x150b249b, 0x6402ed89, 0xed03cc71, 0x25f9472c, 0x931dcb2a }, 19 },
+	{ {0x15193ca7, 0x79ed9daf, 0x6950da70, 0xc155d7ca, 0x94767383 }, 19 },
+	{ {0x152e4edc, 0x0cadeab7, 0x83f4724c, 0x6539875d, 0x9c6ca018 }, 19 },
+	{ {0x15345c87, 0x45028c96, 0xfc79036b, 0x2e3e180a, 0xd2f62dab }, 19 },
+	{ {0x1545566b, 0xd7decb16, 0x12009daa, 0x2daa7175, 0x8fa6e4a1 }, 5 },
+	{ {0x15665321, 0x46fcfc28, 0xc7077537, 0x77c66585, 0xdc12418a }, 65 },
+	{ {0x158cc62b, 0x46b51016, 0x194176fd, 0x805e767c, 0x2ad3dc6c }, 19 },
+	{ {0x1594eea1, 0x91c9f660, 0xe7b8ab2f, 0x3b68f76d, 0x02605c80 }, 135 },
+	{ {0x15b0ac54, 0x0b31d835, 0x69c275cd, 0x3970571b, 0x637cc8f2 }, 19 },
+	{ {0x15b83242, 0x8c4648e4, 0xdaadd05e, 0xec12f615, 0x072cc839 }, 31 },
+	{ {0x15ba1ffa, 0x2f557305, 0x92258c9f, 0xf4b2d6f9, 0x1c9ed0ba }, 19 },
+	{ {0x15ca9629, 0x94fd25a5, 0x6bee2f54, 0x3a83f133, 0xf9d2265f }, 39 },
+	{ {0x15cc2f74, 0x12373253, 0xe908689a, 0x778738d5, 0x2656ad74 }, 19 },
+	{ {0x16351e6a, 0x7d7fc38c, 0x23b54ee1, 0x5ac6f027, 0x5621ba96 }, 8 },
+	{ {0x1642891b, 0x693df616, 0xf2743129, 0x9352e1d7, 0x750ac94b }, 5 },
+	{ {0x16553c30, 0xfcdd0e1d, 0x00a48fe1, 0xcb2def53, 0x7c4a7c3f }, 19 },
+	{ {0x1672af5b, 0xc1740480, 0xe8302f76, 0x90589ea5, 0xb5391bcb }, 19 },
+	{ {0x167b226b, 0x54cc5b68, 0x1a69d2c1, 0x509116ff, 0xaba868e4 }, 19 },
+	{ {0x168d59fc, 0xa3170f56, 0x858f39d0, 0xb53067c0, 0xc0d414a8 }, 3 },
+	{ {0x16c3ced0, 0xfb2e360b, 0xc7c43d37, 0x2a0a30eb, 0x6bd3963d }, 6 },
+	{ {0x16c692a2, 0xc9babfda, 0xdd8408d2, 0xf0f8fae3, 0xa8d96fd5 }, 5 },
+	{ {0x16f06109, 0xc57de5a3, 0x9fbe150d, 0xe9c25754, 0x483ee9fb }, 5 },
+	{ {0x16f29e95, 0x53419865, 0xc1160617, 0x232614a7, 0x2f88f3d4 }, 19 },
+	{ {0x1709541a, 0xc3063432, 0x3392e509, 0x8d47d1f6, 0x44dbfc09 }, 19 },
+	{ {0x171b587b, 0xd5a947a1, 0x3f311412, 0x0b6e7bac, 0xa3b57d78 }, 1 },
+	{ {0x17315e6b, 0x40f89c2c, 0xd0d8929e, 0xefcb9394, 0xb04e4cc6 }, 39 },
+	{ {0x174437bf, 0xb20e2895, 0xf0f55260, 0x2da823ca, 0x17b2fe93 }, 19 },
+	{ {0x174c9254, 0xf09d9936, 0x1ff76076, 0x30248ff9, 0xd7d8d4d6 }, 1 },
+	{ {0x175488d7, 0xef82b5ee, 0x94eebce3, 0xb96ef675, 0x30f7bad9 }, 19 },
+	{ {0x17583adb, 0x63d16d64, 0xae518200, 0x55cd32c0, 0xe935425a }, 3 },
+	{ {0x176c82d9, 0x69a8bef1, 0x71bdc2b7, 0x91520195, 0x7f43b260 }, 19 },
+	{ {0x176ec8e6, 0x5a9fdbf5, 0x9edc245b, 0x9e8388cc, 0x94195db9 }, 5 },
+	{ {0x17ac538d, 0xd63bc93e, 0xc0b88b6d, 0xd92079e8, 0x07c22908 }, 19 },
+	{ {0x17bbed84, 0x6045f332, 0x5b1d34c6, 0x86d35889, 0xf9efe157 }, 19 },
+	{ {0x17d6db13, 0xd7d76fbd, 0x110f53b1, 0x68ab0001, 0xc7e65817 }, 19 },
+	{ {0x17dcbe8e, 0x9ab79248, 0x3a542b02, 0x30897baf, 0x0240dcc9 }, 4 },
+	{ {0x17e1111b, 0x1d6aa80e, 0x8bc525be, 0x345c25e3, 0xb00ed504 }, 19 },
+	{ {0x17e39a9a, 0x38c70608, 0x984b4d14, 0xf4948f35, 0xd131c816 }, 19 },
+	{ {0x17e78fd4, 0x05e65afa, 0x3763c2f7, 0x271c82ab, 0x155c004b }, 42 },
+	{ {0x17f24b93, 0x39291dea, 0x40d2ed36, 0x517f223b, 0x9e4f49e1 }, 19 },
+	{ {0x1804cfbc, 0x4f175136, 0xb7b934b5, 0x75d49cbc, 0x0e726ffe }, 19 },
+	{ {0x181bf58d, 0xa7184e12, 0x8cd419da, 0x3109b933, 0x44a543cf }, 42 },
+	{ {0x181c62bf, 0x30a66ca3, 0xc74b4165, 0xc230fb44, 0x674bdb5d }, 55 },
+	{ {0x1833ffc2, 0x52d43d3d, 0x8239e57d, 0x5ac2c015, 0xb4367988 }, 17 },
+	{ {0x18419523, 0x962b57f1, 0xff49d621, 0x82f50882, 0xd6c42228 }, 19 },
+	{ {0x18b90aaa, 0x2284eb46, 0x233e9203, 0xaf1e8cf1, 0x922c417c }, 19 },
+	{ {0x18be429f, 0x8b5c7bc4, 0x775c9929, 0x2110aa09, 0x341cd644 }, 8 },
+	{ {0x18e87e15, 0xb09ec2fd, 0xdc52fad1, 0x0edc5791, 0x8fadec34 }, 19 },
+	{ {0x18eada21, 0x78fc1a89, 0x895087aa, 0x513305d1, 0xba73c926 }, 4 },
+	{ {0x190bcab0, 0x325ded99, 0xf42f3297, 0x6bf965f0, 0x164ad2a4 }, 19 },
+	{ {0x194ff03c, 0x3063a852, 0xc831b034, 0xfe215208, 0x802b64cf }, 19 },
+	{ {0x19595017, 0x3701abeb, 0x460a1a07, 0x0d83466f, 0x3f53b337 }, 1 },
+	{ {0x19a95d8e, 0x0fd5cb61, 0xed02e064, 0x1ed15454, 0xf0b9de42 }, 55 },
+	{ {0x19bf90b8, 0xd2e695ff, 0xad61fff6, 0xf47f7fcd, 0xa2f24a1d }, 87 },
 	{ {0x19c61033, 0x9c0480c3, 0xd2d0d1c2, 0x1e3ccbf2, 0x179bb191 }, 19 },
-	{ {0x6724b2ab, 0xce814560, 0x9333c8b2, 0x964de0f1, 0xa90d9cd5 }, 19 },
-	{ {0xac2475e9, 0x55e98c5d, 0x5816ec60, 0x118b424b, 0x46c30670 }, 19 },
-	{ {0x08cb8d0a, 0x42e1c2a0, 0x961aff3a, 0xb7026252, 0x5964b434 }, 19 },
-	{ {0x3627431d, 0xb990b691, 0x3606328a, 0xe2fb3340, 0x452b2797 }, 19 },
-	{ {0x7b89c2d6, 0x2c3106a8, 0x7c3375bb, 0xc0284d2b, 0x5a364cc9 }, 19 },
-	{ {0x6e6b8cdc, 0x55713eab, 0xc724f3ec, 0x9624e988, 0x4254ab33 }, 19 },
-	{ {0x761ab0aa, 0x7f528bf0, 0xf51ea9de, 0x75c847ea, 0x949478d7 }, 19 },
-	{ {0x533dc6d2, 0x8ca60c09, 0x0740879d, 0xcb3cfa38, 0x6544ee45 }, 19 },
-	{ {0x0a04143b, 0x9357c6f2, 0xf0dc177c, 0x2acc5b27, 0x562e2a76 }, 19 },
-	{ {0x7b94a728, 0xa5945a53, 0xd518c189, 0x94e1e09a, 0x09ec3c1b }, 5 },
-	{ {0x3df7c19f, 0x739d74d6, 0xefdfd815, 0x1343e5a5, 0x5d4ac842 }, 5 },
-	{ {0xd7b46aec, 0xe68c924e, 0x09f07e3d, 0xf45711f3, 0x37d35d6a }, 5 },
-	{ {0x68691348, 0xa29ce590, 0x46f993e9, 0xabaf3c86, 0x51bdda3c }, 17 },
-	{ {0x397716d2, 0x6a075c6d, 0x731f0b04, 0xf3fa24aa, 0x39521798 }, 19 },
-	{ {0x6c1814c7, 0x0d69a50e, 0xc60e39ef, 0x281f0b8c, 0xd7bf8598 }, 8 },
-	{ {0x88cd9059, 0x5fbb7dba, 0xbd73ac9c, 0x0985c0a0, 0x13992dc6 }, 8 },
-	{ {0xfcdbc5e1, 0x5dd6b973, 0xe0f1112f, 0x4599dad9, 0x85f48042 }, 17 },
-	{ {0x2f0db48f, 0xbcf3444f, 0x52b9c7c7, 0x6ba9c4bd, 0x38bc2a15 }, 6 },
-	{ {0xa52c37c1, 0xf16ba13d, 0x3f39bb54, 0x03c82c01, 0x87cbff51 }, 6 },
-	{ {0xf100a761, 0x17e95ab0, 0x335e89a9, 0x01e47d84, 0x4bbc0ab6 }, 5 },
-	{ {0xe3416103, 0x4364ef03, 0xdf907d62, 0x976c2ac8, 0xf551404f }, 19 },
-	{ {0x95d968ba, 0xa9f49969, 0x26371b84, 0x86ab5583, 0x5b7d9d52 }, 19 },
-	{ {0xd22817c5, 0x19f5316f, 0x61c96358, 0x0a620b04, 0x93a6232d }, 19 },
-	{ {0xc55dd15a, 0x27b69b61, 0xe839f850, 0x0f56badb, 0x4ee58ad4 }, 39 },
-	{ {0x52a9173b, 0x22c8a723, 0x76003764, 0xd73e0757, 0x9dc2015d }, 3 },
-	{ {0xa6145a65, 0x8ac51d8f, 0x455ac606, 0x29ed2d11, 0x8d50f1ad }, 19 },
-	{ {0xd1fbdbdf, 0x2e830139, 0x584d7dc7, 0x96806aa3, 0x327720dd }, 6 },
-	{ {0x353e2bd9, 0x01e55023, 0x75dc92a0, 0x4e1686c1, 0x192fcf42 }, 19 },
-	{ {0xf63d274a, 0x8a7ad8e2, 0x85dd8800, 0x264ab9c1, 0x4aa9f870 }, 19 },
-	{ {0xe7d9d1e4, 0xdcf48779, 0xdab41eb6, 0xc15478f9, 0x34bd8bc1 }, 19 },
-	{ {0x2799d221, 0xd5486d48, 0x226bbbd3, 0x941207e1, 0xfc7c985e }, 6 },
-	{ {0x20c24130, 0xb7a9d50b, 0x5cede80f, 0x1638b686, 0xc2778800 }, 19 },
-	{ {0xc20def84, 0xefe71efd, 0xf91df310, 0x0919d151, 0xb2e7bdc1 }, 19 },
-	{ {0xc79626ed, 0xdf8bc390, 0xd64ada99, 0xad6da32d, 0xfd52d086 }, 19 },
-	{ {0xd7109cf2, 0x0a22558f, 0x923c833f, 0xf0b4e231, 0x1340acb1 }, 6 },
-	{ {0xa14b357a, 0x1b16163f, 0x5ffa96b0, 0xb617d352, 0x713ac047 }, 19 },
-	{ {0x5b33d3f8, 0x32acd6aa, 0x44a48232, 0xa9e4ff66, 0xfe63c8d5 }, 19 },
-	{ {0x7f6906ff, 0x7017a558, 0x95219719, 0x8ac7a1c1, 0xe222ed9d }, 19 },
-	{ {0x6365ee1b, 0xfd476454, 0x6681d860, 0xc90b59f2, 0x7b25f213 }, 19 },
-	{ {0xd916f0e4, 0xbd3c829a, 0x0472c6ec, 0x18d08907, 0xa5c991f3 }, 19 },
-	{ {0x83fed409, 0x0d0942c8, 0xe0054437, 0x745c1c0e, 0xbefc6222 }, 19 },
-	{ {0xd31eb4ff, 0x4d6e4b3a, 0xf645f243, 0x88c734a1, 0xd00a0c47 }, 39 },
-	{ {0xa02db35c, 0x2bdfd9d6, 0x838b6cc9, 0x2a3e3d30, 0xa0ced5bf }, 39 },
-	{ {0x30c6f729, 0x28b81c7d, 0x37d192cf, 0x6d6d6d3d, 0x1232469b }, 39 },
-	{ {0x373319d9, 0xdbadc959, 0xdd953894, 0xbe166637, 0x88918655 }, 39 },
-	{ {0x28bf2354, 0xcdd70e30, 0xb682f40b, 0x734029ec, 0xe44d70bd }, 19 },
-	{ {0x20f1883c, 0x45fc3c39, 0xddf48a7d, 0xe69b6ef5, 0x88fac8fb }, 19 },
-	{ {0x4b34bf7b, 0x950d9467, 0xbf701add, 0x259a3268, 0x6f283d24 }, 19 },
-	{ {0xe49f66e8, 0xba45d064, 0x7c93a57b, 0xbc1fb7ab, 0xa4665a6e }, 19 },
-	{ {0x94584ca2, 0xe89ab0b2, 0x49cd52f3, 0xa356176a, 0x03f9e35f }, 19 },
-	{ {0x6cbddd11, 0x8afe63e7, 0x9cb8a40f, 0x8aa879df, 0x1c7590e1 }, 19 },
-	{ {0xe9ca3d6a, 0x21092ec8, 0xd6933279, 0xdc6c96f3, 0x927f3b15 }, 19 },
-	{ {0xacab2c61, 0x47df1015, 0x36efde0d, 0x57ca4ccd, 0xe8ba3379 }, 19 },
-	{ {0xad2e1e95, 0x7ee469d5, 0x1faa07a9, 0x9a20dbf0, 0x0003dacf }, 19 },
-	{ {0xf2ac1ce7, 0x584297bb, 0x646caec3, 0xfe4f0384, 0xed5b072f }, 19 },
-	{ {0xb0d384ec, 0x10f59d20, 0x1f346a3c, 0xd7eb31b9, 0xa80c28ca }, 19 },
-	{ {0x7de755f9, 0x8b6a6888, 0x6e61473d, 0x524d0aa6, 0xab6577d7 }, 19 },
-	{ {0xb5b28f53, 0xb16d4374, 0x2d9d7daf, 0x5ee7dcf7, 0x4b80e6c8 }, 39 },
-	{ {0xded8d969, 0x542b7be0, 0x2524037f, 0xa244e664, 0x8c3f4e03 }, 39 },
-	{ {0xa059f6fb, 0x5ffd3762, 0x010b9743, 0x51883349, 0x9fe2205f }, 39 },
-	{ {0x09b0ea7c, 0x5595f4e9, 0xc9a15219, 0xf30e3423, 0xbbc25f66 }, 19 },
-	{ {0x8ecc34eb, 0xff9d37c0, 0xfe9560cf, 0xdc53a052, 0xcff3d1ab }, 19 },
-	{ {0x5be82c29, 0x7566b3e0, 0x8fa1fe25, 0x34be06ca, 0x2f95d565 }, 19 },
-	{ {0x975fdf52, 0x1c080308, 0x96eb50af, 0x4f39a235, 0x00eaf7ac }, 19 },
-	{ {0xc221c5d9, 0x0c3c6eab, 0xf1a65107, 0x2cd9841a, 0xd1b25d7d }, 19 },
-	{ {0xfc63b9cd, 0x7d3fbf5a, 0x8309ef09, 0xbe46ed04, 0x1321e029 }, 19 },
-	{ {0x4516a0e0, 0xb915cb09, 0x3e82a19b, 0x4570d26c, 0x28e213fd }, 19 },
-	{ {0xaa1621a6, 0xb61f7cfb, 0x2df8dd2c, 0xf8647a94, 0x3e13dfa7 }, 19 },
-	{ {0x2b36fe2b, 0x0d98d65a, 0xb31f13fc, 0xb858db68, 0x58a51d46 }, 19 },
-	{ {0x3137e676, 0xc37195d4, 0x6fe6acc4, 0x395d0dc4, 0xd711d919 }, 19 },
-	{ {0x91bee8af, 0x612f69c5, 0x413a1d23, 0x102cc5ea, 0x896c2caa }, 19 },
-	{ {0x06bfdd6d, 0x0f0d84b1, 0xd534c81b, 0x27150193, 0x969168b3 }, 19 },
-	{ {0x3987c45a, 0x35e5c3fe, 0x494a00ef, 0x0690a329, 0x790ae34d }, 19 },
-	{ {0x22c7abe6, 0xc8f4b789, 0x7ecb583d, 0x4913d35b, 0x5f62c5e1 }, 19 },
-	{ {0xa5dc0aa2, 0x83072f77, 0x2ee4b9eb, 0x93b09665, 0x00dd306b }, 19 },
-	{ {0x4ab3c16e, 0x32a3a0f4, 0x373e24cd, 0x47cd2805, 0x013f2f65 }, 19 },
-	{ {0x3880b064, 0xdcb851ca, 0x221ff67e, 0x435137a7, 0xcf1141f8 }, 5 },
-	{ {0x6e5acdfb, 0x1c161025, 0x7a7aabf3, 0xd5aa8588, 0x66dbcf2e }, 3 },
-	{ {0xff72a178, 0x8d47f987, 0x6d9fabd7, 0x20f6a289, 0xfb409090 }, 3 },
-	{ {0x42fbb187, 0x22df3e34, 0xe5b0f935, 0xa2dc0ce0, 0xd85099e9 }, 3 },
-	{ {0x8b252fe7, 0x84692fc1, 0x5290a04f, 0xa59848f6, 0x09216f16 }, 3 },
-	{ {0xf0be97ce, 0xca47b65b, 0x46c9518e, 0x6157b295, 0xf8c99c38 }, 3 },
-	{ {0x5c7a13b6, 0x4b480652, 0x31f05c35, 0xb4c8b209, 0x534f3a8b }, 19 },
-	{ {0xb11b93ad, 0xd30086ce, 0x00d21262, 0x52893700, 0xca6fd82b }, 19 },
-	{ {0x39e85842, 0x2a865af9, 0x91f5dae9, 0x7fbfbb3d, 0x7e1ca69a }, 104 },
-	{ {0xa469935d, 0xd39a856c, 0x06676817, 0xf51b403a, 0x3678ac1a }, 19 },
-	{ {0x32b9ae84, 0x09abcca5, 0xe8536e89, 0x0b21cc31, 0x0cf45822 }, 19 },
-	{ {0xe8d4acdc, 0x4141fb9e, 0xdaaa5c6a, 0xeb4fcf19, 0x594e3512 }, 19 },
-	{ {0xa420f8d7, 0xd3631b1c, 0x795d1821, 0x62221b21, 0xaaf48f1b }, 19 },
+	{ {0x19e79a79, 0xbe13ac62, 0xbb002ed3, 0x323502be, 0x97886e17 }, 4 },
+	{ {0x1a00eef3, 0xdf449d71, 0xabf4be5a, 0x4c8d01ba, 0x9dcd6b79 }, 19 },
+	{ {0x1a5295a3, 0x37e5b969, 0xc939644c, 0xb5ad55b8, 0x4a6ad31d }, 19 },
+	{ {0x1a6a7513, 0x34c663fb, 0xfdf93f61, 0x7a7d779f, 0x76f488ce }, 42 },
+	{ {0x1a6c5ba0, 0x3e0cc76f, 0x7e001784, 0xe1a20537, 0x5f5602b8 }, 19 },
+	{ {0x1a6de1cf, 0xf8314293, 0x94dc2b95, 0x28993a1d, 0xfcae14c6 }, 19 },
+	{ {0x1a90b7c7, 0xf24bb7fa, 0x93c84bde, 0x2d1b655e, 0x30c4a7cb }, 19 },
+	{ {0x1ab38b01, 0x4480745e, 0xaae143c9, 0xe6f67b54, 0x2e62442f }, 4 },
+	{ {0x1ad2178c, 0x27874704, 0xb395ab25, 0x0200d9ac, 0xb7d3de9c }, 19 },
+	{ {0x1aeae118, 0x0471e9a6, 0xe8e86699, 0x3031b881, 0xa341f921 }, 6 },
+	{ {0x1aee947b, 0x1ad6d478, 0xc0def550, 0x868a3851, 0xc2910809 }, 5 },
+	{ {0x1af617bf, 0xd11b10a7, 0x1936c606, 0x174a8001, 0x9762ea71 }, 40 },
+	{ {0x1b3059c7, 0x873765a4, 0x76fb7791, 0xa4d6fc84, 0x6ab05ade }, 19 },
+	{ {0x1b4f56a1, 0xd6d17324, 0xe4145fb7, 0x7f3291a1, 0xa4e6f42d }, 19 },
+	{ {0x1b5b269b, 0xc0c905af, 0xf94ebea5, 0x98a936e3, 0x4a74fb07 }, 19 },
+	{ {0x1b70a195, 0xa00b1fc4, 0x99576639, 0x0f39d3ba, 0x884b5148 }, 1 },
+	{ {0x1b946463, 0x07fbc586, 0xd9572e42, 0xe871f7af, 0x82dd5f73 }, 21 },
+	{ {0x1ba6b699, 0xb4e34c23, 0xee60db4e, 0x58e1265d, 0xc03f0b50 }, 8 },
+	{ {0x1bdb1898, 0x796e2b48, 0xb62a3560, 0x35192b16, 0x3113962c }, 19 },
+	{ {0x1c17e58f, 0x1a602e07, 0xf185bce1, 0xaa8589fa, 0xe76e8b44 }, 5 },
+	{ {0x1c238009, 0xe77c5536, 0xd0059631, 0x954c2c4a, 0x52527283 }, 3 },
+	{ {0x1c462c36, 0x29d43297, 0xa006ba90, 0x55b39a2d, 0xccba9f6c }, 5 },
+	{ {0x1c4de8d4, 0xa1cbf5aa, 0x2bcf7816, 0xa1e55ee4, 0x584f59fb }, 19 },
+	{ {0x1c4e9d38, 0xa8f57212, 0xdbf12f7a, 0xaba65496, 0x83b93ed4 }, 19 },
+	{ {0x1c6b2b81, 0x552590e8, 0x2d3205af, 0xbde93653, 0xfa449429 }, 19 },
+	{ {0x1c79c8fc, 0xfd661394, 0xf91be94b, 0x218955c8, 0x4cabd742 }, 96 },
 	{ {0x1c90a57c, 0xc1237bda, 0xdd70d90d, 0x74e69c33, 0xd7a89293 }, 19 },
-	{ {0xedd61208, 0xe11149e2, 0x26cd2edd, 0xf5c9eca8, 0xee1ba33e }, 19 },
-	{ {0x44204705, 0x8fe0f290, 0xf8022ac8, 0x8d18e540, 0x7ea6068c }, 19 },
-	{ {0xe11afc03, 0xdb4e1d03, 0x976d0279, 0x6b29da9c, 0x65d4ff3d }, 5 },
-	{ {0x2bb837a9, 0x051277ba, 0x574d8351, 0xa9f91f9e, 0x57033074 }, 5 },
-	{ {0x84566b5f, 0x37ab4f04, 0xa2e5b950, 0xc5beecbd, 0x27b88ea0 }, 4 },
+	{ {0x1cbd5c78, 0x49f97dea, 0x1e3375a8, 0x42f784ff, 0x9283310c }, 145 },
+	{ {0x1ccac7ca, 0xeaaa1c5a, 0x89503221, 0xb0a5eec2, 0xf34b1c91 }, 3 },
+	{ {0x1ce1ebbb, 0x0f62224a, 0xa776c452, 0x3e2ef708, 0x154e7b52 }, 39 },
+	{ {0x1cf39e12, 0x313ff306, 0x4353c136, 0x262f176a, 0x56ab20a6 }, 19 },
+	{ {0x1d129bde, 0x09c9db24, 0x33b334d3, 0x6762704d, 0xe94983ba }, 17 },
+	{ {0x1d4c0916, 0x6755c656, 0x9ff0ed38, 0x78bbf1b2, 0x2d7e3864 }, 134 },
+	{ {0x1d6a355a, 0x9ce84c78, 0xe3bafc27, 0xa4f1151e, 0x240f68f0 }, 19 },
+	{ {0x1d6e68a3, 0xfe7c831e, 0xea257e0c, 0x0ab8d324, 0xaa0df9b7 }, 63 },
+	{ {0x1d81e6cc, 0x165b3330, 0xb9b3c8b4, 0xf4da0417, 0xb1ab901e }, 19 },
+	{ {0x1d97922a, 0x5ab63e73, 0x611d0edb, 0xe952f041, 0xaf3385b3 }, 5 },
+	{ {0x1dc5dfa6, 0xcd8d5548, 0x44f484a1, 0xb4e68071, 0x0c1b9515 }, 19 },
+	{ {0x1dd7fe1d, 0x71354a8b, 0x2c2df315, 0xac442b9c, 0xe3583b3c }, 19 },
+	{ {0x1e2abac0, 0x1eb37e43, 0xa7a61da2, 0x5dc147bb, 0xdc30ad32 }, 19 },
+	{ {0x1e429b73, 0xaf3d9e9a, 0xe0718d88, 0x405a7b7e, 0xdd0a24f2 }, 19 },
+	{ {0x1e70296a, 0x07a5ff62, 0xd01e5115, 0xb8c8b87f, 0x891585c9 }, 19 },
+	{ {0x1e7ac217, 0x96642c3c, 0xcb66b0ef, 0x0f00ba47, 0x52428aca }, 6 },
+	{ {0x1e92d20a, 0x5815ad0d, 0xffd50d83, 0x24fce389, 0xca033e05 }, 56 },
+	{ {0x1e9a9559, 0x43aeea9b, 0x1807ddf1, 0x250ba643, 0x6d8dd276 }, 1 },
+	{ {0x1eb9f2bd, 0x558dd8ec, 0xafcde3ce, 0x61881bfa, 0x27f70f1f }, 39 },
+	{ {0x1ebb0606, 0x2428fcdc, 0x66808a03, 0x761818db, 0x2bba3c73 }, 29 },
+	{ {0x1ec94d04, 0x9fcbf59c, 0x5493d5de, 0x76bdfb89, 0x1d24249e }, 3 },
+	{ {0x1edabc32, 0x26648b54, 0xae98d524, 0xb31f37ca, 0x47c8c88b }, 19 },
+	{ {0x1eea2cae, 0x2bb3401d, 0x6734b200, 0x1f6b5516, 0x28a99101 }, 19 },
+	{ {0x1ef3956f, 0x7f918873, 0xfb9b0313, 0x39bba45d, 0x1e5e5878 }, 42 },
+	{ {0x1efcf9e9, 0xa8ea38ba, 0xd319a70a, 0x5f7319e2, 0x589d4a8b }, 19 },
+	{ {0x1f17e461, 0x90635a32, 0x14057d33, 0xad4a7689, 0x39d5a071 }, 6 },
+	{ {0x1f26dfa0, 0x26b116c8, 0x0c951a99, 0x5633b4c2, 0xf7fa033d }, 5 },
+	{ {0x1f39c472, 0xf1e02511, 0xfa7eaaf8, 0xed9fcce4, 0xd45861b9 }, 6 },
+	{ {0x1f3f5862, 0x55dd49b0, 0xf912bf41, 0xe07e88fe, 0x3eb3fb61 }, 5 },
+	{ {0x1f47ccfd, 0x979e653b, 0x96c9d7a3, 0x6f62daf3, 0xa186e186 }, 19 },
+	{ {0x1f72e0cd, 0x58afe220, 0x75a129ac, 0x854bbdce, 0x0704b0c8 }, 19 },
+	{ {0x1f7b822b, 0x47430a3d, 0x817a21af, 0x2ab95c34, 0x14b328a6 }, 19 },
+	{ {0x1f8334dc, 0x7459cfcf, 0x2ad132e9, 0x4976015c, 0x02e51390 }, 19 },
+	{ {0x1f8b9ac2, 0x8dbadaf5, 0x316770cd, 0x6a421c99, 0x8e33a8cb }, 19 },
+	{ {0x1fa73980, 0x05fb0bd7, 0x07514103, 0x5e8d8881, 0x97162030 }, 19 },
+	{ {0x1fb821d2, 0x007b28fd, 0x6a059744, 0x54f5bf87, 0x67b106ac }, 19 },
+	{ {0x1fb86115, 0x2a9f3f9c, 0x2b2dace2, 0x6d5f1d93, 0xab9b4ad8 }, 19 },
+	{ {0x1fbd7af2, 0x3177ab1d, 0xe799764d, 0x8a26bc2b, 0xbf85b042 }, 19 },
+	{ {0x1fbf5640, 0xdf41fe48, 0xc7d64ffc, 0x51e33b57, 0xb41fd7e1 }, 19 },
+	{ {0x1fc23069, 0x11ab6e1e, 0xbdf7cb8c, 0x3c34a7f1, 0x16414e88 }, 1 },
+	{ {0x1fc9d3b5, 0x4a617e57, 0xfd6ed10f, 0x2ce3c014, 0x56710e37 }, 19 },
+	{ {0x1ff0afe3, 0x93f89b65, 0x17025dc3, 0x9a282c11, 0xc7da87ca }, 5 },
+	{ {0x1ff13030, 0xd171fb5f, 0x653664e5, 0xd11d0777, 0x884b2463 }, 19 },
+	{ {0x1ffef57e, 0x6c06068b, 0x33002729, 0x4aae1731, 0x03c8f141 }, 42 },
+	{ {0x20191b43, 0x7958e990, 0xd14660f4, 0x76c340e1, 0x40236c70 }, 19 },
+	{ {0x2033ea83, 0x1fd887c8, 0x2fd8f8a1, 0xc9491f7a, 0x5dbe0175 }, 19 },
+	{ {0x206b2a47, 0xf437ba9d, 0xfc85f6d0, 0x1c9e2c18, 0x00000000 }, 4 },
+	{ {0x208ce6cb, 0xff7402bf, 0xe52b1062, 0xe6b10ae0, 0x9c0a3179 }, 39 },
+	{ {0x208f8029, 0x29913bd2, 0x683bf86b, 0x587f6398, 0x11c3419e }, 19 },
+	{ {0x20a2e3d7, 0x966916f4, 0x6eb26cc1, 0xaa226ec2, 0xd11646f9 }, 19 },
+	{ {0x20aeb411, 0xab5adb9b, 0xd3db412a, 0x7837e496, 0x969f8ce3 }, 19 },
+	{ {0x20c24130, 0xb7a9d50b, 0x5cede80f, 0x1638b686, 0xc2778800 }, 19 },
+	{ {0x20ce189d, 0x670c0fe5, 0xf2a945d7, 0x3107df7d, 0x83070ff7 }, 19 },
+	{ {0x20ce8211, 0x2ba0c500, 0x63667d61, 0xe43979ac, 0x464a3bb4 }, 19 },
+	{ {0x20efab45, 0xafd6be50, 0x9ab4f8a0, 0x12e67b09, 0x4c196c73 }, 19 },
+	{ {0x20effe09, 0x3026e920, 0x9bd33271, 0x14e9ad51, 0x676cf807 }, 19 },
+	{ {0x20f1883c, 0x45fc3c39, 0xddf48a7d, 0xe69b6ef5, 0x88fac8fb }, 19 },
+	{ {0x2111cec4, 0xb5ea698d, 0x772bb806, 0x64f6be69, 0x0b47391c }, 3 },
+	{ {0x2117a337, 0x5684fa3c, 0x5bedebce, 0xd4d7c101, 0x9a1ccdca }, 6 },
+	{ {0x211e1f7e, 0x86495178, 0xfb2b05e1, 0x63b04ed4, 0xb7455034 }, 19 },
+	{ {0x21329398, 0xc0f350e3, 0x30b353f4, 0x5f21aa7b, 0xa338fc8d }, 1 },
 	{ {0x21380bee, 0x0748625e, 0x9951a7a9, 0x24016cc6, 0xcec46fb8 }, 4 },
+	{ {0x2144036d, 0x6573d666, 0x143e890e, 0x5413956b, 0xfe8f66c5 }, 65 },
+	{ {0x214cedb8, 0xf4689da1, 0x50878ca6, 0xf4fcac31, 0x359c9766 }, 19 },
 	{ {0x216243b4, 0xbcb9070f, 0x9e86c3f0, 0x4edaaa49, 0x3e4b459c }, 19 },
-	{ {0x2b10234d, 0xebd2a6a9, 0xa02e0750, 0xba656376, 0x8bc4a2f3 }, 5 },
-	{ {0xdccdb2d1, 0x8c70a94e, 0x48b3ec5e, 0x0cb986c5, 0xd708bbc9 }, 4 },
-	{ {0x048737f9, 0x95eecb1d, 0xd8dd341d, 0x750efd00, 0x5267796f }, 5 },
-	{ {0x6868e705, 0x0d989d1e, 0xcbd13393, 0xed360add, 0xefa4bcd3 }, 5 },
-	{ {0x442a39b1, 0x96f19a22, 0xfc7fb8f1, 0x4bf17386, 0xa292b60e }, 4 },
-	{ {0xe6b71484, 0xd5ab578f, 0xd3695917, 0xfce3c1e8, 0x05a5b536 }, 19 },
-	{ {0x43dbcc95, 0x36fe61c8, 0x172eceee, 0xc1481778, 0xf7a2b9bd }, 19 },
-	{ {0x6d800787, 0xf5f5d638, 0x27b841aa, 0x29fe26ed, 0x89ea2cef }, 5 },
-	{ {0x75eb441c, 0x8298b7fd, 0x3982999f, 0x772e4c8b, 0x983ef17f }, 3 },
-	{ {0x59e35d24, 0xab5f8e3b, 0x812ba4a1, 0xa4feb5be, 0x1ab269fe }, 3 },
-	{ {0xd833c66d, 0xd5412399, 0x08555762, 0xe04bcbb2, 0x2bca748a }, 19 },
-	{ {0x9bca89c7, 0x1c033bb9, 0xa85ee30c, 0xf75960ec, 0x839c0462 }, 19 },
-	{ {0x068e5cd2, 0x32a794f7, 0xe203e531, 0x6a3ad2bc, 0xc7f3c939 }, 19 },
-	{ {0x1e70296a, 0x07a5ff62, 0xd01e5115, 0xb8c8b87f, 0x891585c9 }, 19 },
-	{ {0xd086280d, 0xea7fb10f, 0xabaae26e, 0xd9d404bb, 0xe69c70c4 }, 19 },
-	{ {0xa553c3f2, 0x04c105c2, 0x3b227a1e, 0x5aeb2906, 0x71ccdbeb }, 5 },
-	{ {0x90ea059c, 0x57f011a4, 0xfb33a558, 0xe868ee63, 0x9882fe5e }, 4 },
-	{ {0x50422ba2, 0x4fd158ca, 0x5f0b9728, 0xb8e41829, 0x048cfdfd }, 6 },
-	{ {0xec0320ed, 0xa10bf6bb, 0xee8081f6, 0x672a7bf9, 0xd858c1bb }, 19 },
-	{ {0x0889ca38, 0x3bcf2419, 0x8db1fb2d, 0xd23dea1b, 0xf8c18be8 }, 19 },
-	{ {0x40c626d8, 0xc53e2e2d, 0x4e7e25d5, 0x5aa2c11c, 0x2645780f }, 19 },
-	{ {0x6f391d04, 0x08223138, 0xb7927ed7, 0x19d7ac1b, 0x6c38ca0d }, 19 },
-	{ {0x46f3954d, 0x7f92f5d0, 0x0f45b82f, 0xdde543c2, 0x8a4b53c9 }, 19 },
-	{ {0xa3fc0a55, 0xa91ed004, 0x1221f8da, 0x788d824d, 0x9d795913 }, 4 },
-	{ {0xde95b99d, 0xffeab5c2, 0xb453778d, 0xbdc8723d, 0xc15cbfd7 }, 4 },
-	{ {0x60f68567, 0x0de6d2d8, 0xed5f1b1d, 0xdd40fac8, 0x51ff1982 }, 19 },
-	{ {0x5d2bb062, 0xd5d783d4, 0xd08fe04c, 0x2f5c13d6, 0x18b096f2 }, 19 },
-	{ {0x5999cc14, 0x07afe5ba, 0x8a760f16, 0x178c4cac, 0x9c3fa192 }, 19 },
-	{ {0x7bf28813, 0xfb11e9db, 0x3bf78cc7, 0x3ee5fb2d, 0x76b547de }, 19 },
-	{ {0x488f0131, 0x4da5644f, 0xbf2ca938, 0xc6f9720e, 0xf2b0d0f9 }, 19 },
-	{ {0x3eee7c72, 0x362522c2, 0x7866d436, 0x7a8cf1e2, 0x2932db32 }, 19 },
-	{ {0x453eac75, 0x68d5d04c, 0x8cf7da86, 0xf2e8dc79, 0x777343da }, 5 },
-	{ {0x2bd311a4, 0xbaf59cb8, 0x5b839cca, 0x1f55b746, 0x2aa96952 }, 4 },
-	{ {0x3377d201, 0x7cc8433f, 0xa20b432c, 0x9d2328c5, 0x3bbc10e6 }, 19 },
-	{ {0x49bfa987, 0x1bb0ad3b, 0x47a7c63b, 0x14a10e0e, 0x8ae48a52 }, 19 },
-	{ {0x097cae3b, 0xf23e1f38, 0x7b2c9708, 0xfbfc324d, 0xdd88837c }, 19 },
-	{ {0xc0d33b51, 0x3704adc5, 0x6718b1f5, 0x6c106271, 0x8683c77c }, 19 },
-	{ {0xce01afe3, 0x0da38dc5, 0x8994c826, 0x4070195e, 0x1cd921b8 }, 19 },
-	{ {0x5c3ccb16, 0x81fbf63e, 0xbe318d05, 0x616eebac, 0xe91b5ed9 }, 39 },
-	{ {0x971da55e, 0x92167674, 0x628a12c4, 0x43efc43b, 0xafcfb6b4 }, 19 },
-	{ {0x33708719, 0x9d586660, 0x29f00e08, 0xca82b191, 0x7ab58c80 }, 19 },
-	{ {0x39c12004, 0xadb3442f, 0x2c43aade, 0x8a0be420, 0xd59eefb1 }, 19 },
-	{ {0xe60e2abf, 0x907b66f5, 0xb275c7b7, 0xb710439a, 0xdae58d37 }, 19 },
+	{ {0x2164c6ee, 0x1819f7fe, 0x763dbcc9, 0xef366b62, 0xbf04aec6 }, 39 },
+	{ {0x216b2c18, 0x1c9ee0fb, 0x48e2d9ef, 0xdb88ea91, 0x8c8ff04f }, 4 },
+	{ {0x217b21d1, 0x0d80fe2d, 0x5d04636e, 0xe8c2f97f, 0x6edfe34a }, 5 },
+	{ {0x2183f07f, 0xa3ba8736, 0x0100b2fa, 0x21fda0f5, 0x5c0f8814 }, 19 },
+	{ {0x2185be57, 0x9cb51729, 0xf66bf02b, 0xdf3a7b6a, 0x3cbd7b40 }, 19 },
+	{ {0x218d91eb, 0x6df2823c, 0x924d3774, 0xa9f45549, 0x2a10aecb }, 24 },
+	{ {0x219e9acc, 0x2c023c25, 0xa8bbe9fb, 0x7d1764ff, 0xcff66034 }, 5 },
+	{ {0x21ac0ae7, 0xda47abf3, 0x0986b479, 0x489134c7, 0x9405f95d }, 3 },
+	{ {0x21e43a08, 0x613fe974, 0x36e9e1bd, 0xf1f4d0dc, 0x7a0c058b }, 19 },
+	{ {0x21e44cc5, 0x957b65b2, 0x4c34d2c4, 0x2b39879c, 0xacd82ff9 }, 39 },
+	{ {0x22183520, 0xd99924a4, 0x185c5572, 0xa3cf948f, 0x4f0f04b5 }, 19 },
+	{ {0x221c76d6, 0xac483fb1, 0xf11c87d3, 0x7b9617f1, 0xe1d7bc6d }, 19 },
+	{ {0x2220363a, 0xe56ef707, 0xab2471fc, 0xdb36f481, 0x6ad1d32c }, 3 },
+	{ {0x223337db, 0x25c942ec, 0xe732214a, 0xba5dd624, 0xb574e9c4 }, 39 },
+	{ {0x22366113, 0x8586a1b0, 0x24d6dba5, 0xe5fa67d6, 0xb7685884 }, 19 },
+	{ {0x223c1f5d, 0x38b54d4d, 0x5a589882, 0x23bb95df, 0x1998a620 }, 19 },
+	{ {0x225894da, 0x7e3afabf, 0x33abf05e, 0x519e1f6b, 0xcac77a21 }, 39 },
+	{ {0x22a927a7, 0xbc70a363, 0x79404743, 0xa3fde5df, 0x8ca543ce }, 19 },
+	{ {0x22b3191d, 0x86501026, 0x4001b9d8, 0x96186a98, 0x18478a6b }, 39 },
+	{ {0x22c7abe6, 0xc8f4b789, 0x7ecb583d, 0x4913d35b, 0x5f62c5e1 }, 19 },
+	{ {0x22d8ac99, 0xef692675, 0x210f101e, 0xb4e688cd, 0xe9b2d7f5 }, 3 },
+	{ {0x22e095ee, 0xfb53adf4, 0x7648520f, 0x117afd8b, 0xfafa63d0 }, 56 },
+	{ {0x22e8e217, 0xe96cd822, 0x9462c58c, 0xa7ead1ae, 0x33088fc4 }, 19 },
+	{ {0x22f5998b, 0x4de47bf2, 0xccc077d5, 0x881ac448, 0xe6b0484d }, 38 },
+	{ {0x22f9b023, 0x8ff48840, 0xfb7d45ac, 0x93a7f154, 0x95393920 }, 17 },
+	{ {0x22fab445, 0x9e8afc4f, 0x88605506, 0x50e8ff08, 0x3f3ad92a }, 57 },
+	{ {0x2300aa82, 0xbfcbcf95, 0x329eb04e, 0x58bcd7e4, 0xca0a7889 }, 17 },
+	{ {0x2308dd0f, 0x15fb5395, 0xa1d8a084, 0x89daff65, 0xead8e0f2 }, 91 },
+	{ {0x2312bff7, 0x0c83e60d, 0x1ca0fb9c, 0xa78a5063, 0x7d02771c }, 3 },
+	{ {0x2338946a, 0x671d31d1, 0x2360ace4, 0xeeb33f7b, 0xc7db56f1 }, 19 },
+	{ {0x23531b4e, 0x8a2b3e97, 0x54833188, 0x46cf89e6, 0x5f32f7d1 }, 19 },
+	{ {0x2367ad17, 0xbc6bfaaf, 0x7b94a009, 0xae26d508, 0xbdcf5565 }, 140 },
+	{ {0x2391ae8c, 0x961b4a38, 0xb3beaee9, 0xed3362fb, 0x2c71851f }, 19 },
+	{ {0x23a05191, 0x10245957, 0x9aee8af4, 0x527d6998, 0x912f0f80 }, 39 },
+	{ {0x23b1b225, 0x8b36997c, 0x97c02478, 0xfd17d0ff, 0xa22f9cc9 }, 39 },
+	{ {0x23b9dfdd, 0x7789fcca, 0x1fd2d395, 0xee9e3778, 0x07b76c9a }, 19 },
+	{ {0x23e70208, 0x4e303115, 0x8a50a056, 0x0746767b, 0xbc1b7bee }, 6 },
+	{ {0x23f3e1b5, 0x97bee953, 0x75f38063, 0x8340995b, 0x55232e7c }, 4 },
+	{ {0x240a23b6, 0x3e901b98, 0x8951dda1, 0xded561c2, 0x81ccbbc1 }, 3 },
+	{ {0x240e15fb, 0x5d918aa8, 0x21f22600, 0x2772dc80, 0x0d9f20a4 }, 5 },
+	{ {0x2418c030, 0x2abbce8b, 0x0f8556b6, 0x3169c60a, 0x849f60ee }, 5 },
 	{ {0x24287956, 0xe5bfafc4, 0x9335eadd, 0x16b45729, 0x3e3e35e5 }, 19 },
-	{ {0x7c2743df, 0x543c0d8a, 0x4ba7e42b, 0xf7db580b, 0x996d102e }, 19 },
-	{ {0xf5e2e4aa, 0xcd44739d, 0x3a0c1ea4, 0xecb87da3, 0x85ce89dc }, 19 },
-	{ {0x05723830, 0x7d93a8c2, 0xcbb2a296, 0xb9dc2f45, 0x85315af1 }, 42 },
-	{ {0xe4c8f3b8, 0x7d755c21, 0x572040c5, 0x1cec1431, 0xae59a0be }, 42 },
-	{ {0x2a4b4a46, 0x57e3077d, 0xf8a88f98, 0x210b7688, 0x3d3702b1 }, 42 },
-	{ {0x7b179856, 0x1ee1844a, 0x7d643292, 0x4fbee9b4, 0xfc591c19 }, 42 },
-	{ {0x30747a56, 0xf45389be, 0x76362f7f, 0xc55d673f, 0x1bff8312 }, 42 },
-	{ {0xe930f53b, 0xf480aba5, 0xd50d97ee, 0x7c60aad9, 0x6c000d33 }, 19 },
-	{ {0xbb3df0a7, 0x656249e4, 0x86accc60, 0xf583d3dd, 0x41db590b }, 19 },
-	{ {0xa194b845, 0x857c8b33, 0xef4fd5e5, 0x3d7f3815, 0x0b4fa4cf }, 19 },
-	{ {0xc84487e4, 0x85b8739e, 0xc75e09a0, 0x31f84260, 0xfb0e319c }, 19 },
-	{ {0xd8e9fd3e, 0x9420bcbb, 0x1dd530fd, 0xa1e9c718, 0xaa08d8e4 }, 19 },
-	{ {0x0a272147, 0x999e5075, 0x987e8649, 0x35c84ab3, 0xdef2c47d }, 19 },
-	{ {0xec54e05a, 0x6f784f9c, 0x616c94ab, 0x8d57e5d2, 0x647abc66 }, 19 },
-	{ {0x64ae3acd, 0xce06d1b4, 0x1e23ee27, 0x30797fd7, 0xe472bddf }, 19 },
-	{ {0x883537f1, 0x2814ee63, 0xc48a0ab7, 0x44383f8d, 0x8e6a5ca2 }, 19 },
-	{ {0x50ae2f5e, 0xa4f03e71, 0xca49ca02, 0xb0a0cfaf, 0x4464286f }, 19 },
-	{ {0xa27eb9cd, 0x77837c1e, 0x443e275d, 0x0e10888e, 0x0fd248f4 }, 19 },
-	{ {0xa41e43fa, 0x3c64d776, 0x831451c3, 0x5fe8bdee, 0x58625041 }, 19 },
-	{ {0xe7657d80, 0x70399d8e, 0x4d65308b, 0x356e110d, 0x83d23151 }, 19 },
-	{ {0x138a2d56, 0x237aea91, 0x5baaef85, 0xe69425a6, 0x58506cfb }, 19 },
+	{ {0x242e73d8, 0x284a012b, 0x275c0a26, 0x6844ebbc, 0x4269d787 }, 141 },
+	{ {0x24384e63, 0xbfe450bc, 0xe6abd327, 0xeae3e279, 0x69025379 }, 5 },
+	{ {0x244399d6, 0x7d7851f3, 0xdaa9bb87, 0xa14f5b8e, 0xf6d8c160 }, 4 },
+	{ {0x244eae70, 0x5df950f6, 0x0b7d4b52, 0x3d57b9cf, 0xded96b8e }, 19 },
+	{ {0x249da12e, 0x2711c643, 0xc5e18cf9, 0x6184d33d, 0xbf7e2305 }, 19 },
+	{ {0x24c5cbf1, 0xee4caa6d, 0x83a5aa7a, 0x5f381869, 0x2542fda8 }, 19 },
+	{ {0x24f36e4d, 0x879f6492, 0xfbf0cb5a, 0x3b141a18, 0xdc4938ad }, 57 },
+	{ {0x25022c4f, 0x5cfc805e, 0x93026fd5, 0xfda781e9, 0xa1807474 }, 62 },
+	{ {0x250d0d6e, 0x646eae48, 0x17802c49, 0xe367ad8c, 0x1c35a462 }, 19 },
+	{ {0x250d4c7c, 0x6565b0c4, 0x935f6301, 0xe8de2c18, 0x2e659fd0 }, 19 },
 	{ {0x25308ebb, 0x33fd87a7, 0xf6a8e618, 0x68d3dcde, 0x3bd622c5 }, 19 },
-	{ {0x95f36cf0, 0x0cee3db5, 0x5940eb60, 0xcd394122, 0x26a99e94 }, 19 },
-	{ {0xfaa5aef2, 0x3febc61a, 0x875e28ee, 0xbe3aadf8, 0x3e1f5ba7 }, 19 },
+	{ {0x254208d7, 0xea2f7cc1, 0x035cfe76, 0x85238ac3, 0xad17e438 }, 19 },
+	{ {0x2544de44, 0x386cf49d, 0xad2eb103, 0x5ea0e855, 0x3dd7598b }, 19 },
+	{ {0x2588b9ad, 0xe775b93f, 0x03fd4b17, 0xfd3f78ba, 0x70b556d6 }, 6 },
+	{ {0x25a51cd9, 0x367c4614, 0x291013b8, 0xa816fa5e, 0x8a2a564c }, 19 },
+	{ {0x25b28cfe, 0x8d6d51f6, 0x19d182c7, 0x74f6ceb0, 0x5b577eeb }, 6 },
+	{ {0x25b80aa6, 0x70e7fdc8, 0x4b51628b, 0x6dbe930e, 0xb234beb7 }, 6 },
+	{ {0x25db27eb, 0xb67eec8f, 0xe15e3e51, 0x947c840d, 0x23944533 }, 19 },
+	{ {0x25f5adec, 0xa8a2ddb7, 0x54d25eb1, 0x8cff0d84, 0xe5b003bc }, 4 },
+	{ {0x25ffc7e8, 0xca902745, 0x66c31e10, 0xb5998cca, 0x6522673a }, 38 },
+	{ {0x2639792d, 0xf6f7c7cf, 0xaffc2616, 0xb0e1849f, 0x18897ace }, 6 },
+	{ {0x2644b852, 0x51b03f64, 0xfc5c5661, 0x3d5cd07d, 0x9bcd345d }, 39 },
+	{ {0x26a7b011, 0x8d158e9b, 0xd3ea947f, 0xbe68f57b, 0x54e0b847 }, 6 },
+	{ {0x26fc48dd, 0xaca0fedc, 0x90fc151d, 0x4ecd5ca6, 0xd1ccc77b }, 19 },
+	{ {0x2707dcf3, 0x77066b3c, 0x1755c56c, 0xc4c2f953, 0xd82f6524 }, 19 },
+	{ {0x27248716, 0x29b46e05, 0xa0c8b555, 0x4a962211, 0xe700de0e }, 4 },
+	{ {0x2729bb0e, 0x68a64af5, 0x25df4c5d, 0x9687bae0, 0x7245980a }, 19 },
+	{ {0x273a3dab, 0x994b5b9c, 0x975fd127, 0x11dd19e0, 0xc6367caa }, 5 },
+	{ {0x2752cd89, 0x754c05ab, 0xdf7c23cb, 0xa132d38e, 0x3ef0f27d }, 42 },
+	{ {0x2761df1f, 0xf6bf826e, 0x00dbd4f9, 0xa346aa14, 0x5e91c6c6 }, 6 },
+	{ {0x27847b02, 0xd2acbeba, 0xb61f2f05, 0xbd2fff0c, 0x2291a09d }, 19 },
+	{ {0x278e4d57, 0x02b2b319, 0x8d4ac1d4, 0x1fb39463, 0xf5843a3b }, 19 },
+	{ {0x2799d221, 0xd5486d48, 0x226bbbd3, 0x941207e1, 0xfc7c985e }, 6 },
+	{ {0x27a487e5, 0x6721e947, 0xc1f46644, 0xf2f8a501, 0x56dda82d }, 19 },
+	{ {0x27bc8095, 0x18fbb6c0, 0xd52c949e, 0x7cbe8198, 0x0a801d32 }, 39 },
+	{ {0x27c2cdee, 0x4be0ca16, 0x6c2ebd2d, 0xac61115a, 0x56bb9856 }, 19 },
+	{ {0x27c40ec7, 0x013c1ad1, 0xf9a7e1ac, 0x1e0c8be9, 0x9f1e703f }, 19 },
+	{ {0x27ce427e, 0xb1c86ba2, 0x2707a6ee, 0x9086db9d, 0x39962dc6 }, 19 },
+	{ {0x27dc3ae8, 0xa5d6bef8, 0x532c9c21, 0x0a44bbcb, 0xaad436d5 }, 19 },
+	{ {0x27e56fbe, 0xc7fa39ce, 0x19d045b0, 0xdbc4217d, 0x290f92e2 }, 19 },
+	{ {0x27f9144f, 0xb24b434f, 0x7a75737a, 0xa6942830, 0x84782766 }, 17 },
+	{ {0x28323e06, 0xa402747a, 0x1e131dc3, 0x0ce031a3, 0x39f6c947 }, 19 },
+	{ {0x286094c7, 0x127bf98d, 0x53d88624, 0x27487b49, 0x132b16da }, 19 },
+	{ {0x289ac363, 0x81905685, 0xdda39946, 0x127ab2af, 0x3317a010 }, 6 },
+	{ {0x28aaf59d, 0xadb425c1, 0xef6fca86, 0x0439f4e4, 0x2e1737b8 }, 19 },
+	{ {0x28b54294, 0x007ec345, 0xaef7322a, 0x2fcaa18d, 0x3363a73e }, 6 },
+	{ {0x28bf2354, 0xcdd70e30, 0xb682f40b, 0x734029ec, 0xe44d70bd }, 19 },
+	{ {0x291108a6, 0x3e8aaaf0, 0x6997bee7, 0xe988f89b, 0x0a7bb187 }, 19 },
+	{ {0x292215c9, 0x5c829488, 0x23eb0fbe, 0x1b081f14, 0xd6b6290d }, 19 },
+	{ {0x295578c0, 0x6ff3f451, 0xf5203fc4, 0x67a191c9, 0xea335952 }, 19 },
+	{ {0x299e52df, 0xbbb94ace, 0x4fd1ef59, 0xece45364, 0xce0bb450 }, 19 },
+	{ {0x29a42c2b, 0x679bac55, 0xa0318ce8, 0xc97708e4, 0x02e2779b }, 5 },
+	{ {0x29e2f2da, 0xed13cef1, 0x2c20c9c0, 0xd383b99d, 0x18e489de }, 19 },
+	{ {0x2a0d228a, 0xfde36ac7, 0xc5d3c2aa, 0xc9c7c664, 0xdd071a8c }, 57 },
+	{ {0x2a0f9899, 0xa4d8dba7, 0x6db501d6, 0xe3435546, 0xcc7cd9aa }, 19 },
+	{ {0x2a1c91bc, 0xc9b1b621, 0x77323206, 0x1d74b709, 0x8420f1d4 }, 5 },
 	{ {0x2a34f022, 0x1193712c, 0x43f336f0, 0x8d2a6e58, 0xa1a8974a }, 19 },
-	{ {0x817019ca, 0x70a0f72d, 0x294eaa87, 0xed3cb194, 0xb99ceb58 }, 19 },
-	{ {0xc81a30ec, 0xa8cc5226, 0x855ea752, 0xa9d83181, 0x247329ea }, 19 },
-	{ {0x692fd8a8, 0x5978adaf, 0xbb530510, 0xfff71848, 0xf39d4fbd }, 19 },
-	{ {0x8f95a833, 0x28b06e35, 0x9e02fc62, 0x5c3d9c54, 0xa6576bcd }, 19 },
-	{ {0x15b0ac54, 0x0b31d835, 0x69c275cd, 0x3970571b, 0x637cc8f2 }, 19 },
-	{ {0xaa2ba89e, 0x0b1c91a4, 0x405f516e, 0xf003ad14, 0xa401096c }, 19 },
-	{ {0xe2abb08a, 0xbacce577, 0x03fc0088, 0x81279890, 0x328f6277 }, 19 },
-	{ {0xe8ab4678, 0x5e75e19d, 0xac497c4a, 0x82ac2f5b, 0x37ac0580 }, 6 },
-	{ {0x3425eea3, 0x36140da0, 0x3d7d7f09, 0xa94fd928, 0xd70e2212 }, 6 },
-	{ {0xabe52920, 0xe895c148, 0x851649ec, 0xb9c029fd, 0xc41a275f }, 6 },
-	{ {0x2117a337, 0x5684fa3c, 0x5bedebce, 0xd4d7c101, 0x9a1ccdca }, 6 },
-	{ {0xc3c67787, 0xe2a69e2f, 0xdc739d8d, 0x1542726e, 0xc4ee7c47 }, 6 },
-	{ {0x89073c05, 0x2b0fe29b, 0x6de077c8, 0xbdf53734, 0x74081edf }, 5 },
-	{ {0x39ffaacd, 0x0c287501, 0x8e7673a8, 0x87a921fe, 0x9d31d6dc }, 19 },
-	{ {0xb2cca92b, 0x7a51a43c, 0x310e58e0, 0x11f3ede1, 0xe7125a96 }, 6 },
-	{ {0x3f0a7b0c, 0xbaa3d4c3, 0xc6ce7447, 0x08c68c89, 0xeff82289 }, 14 },
+	{ {0x2a3c7ad7, 0x0e34989f, 0xa5170028, 0xbad760e6, 0x5ebe9d57 }, 6 },
+	{ {0x2a4aef32, 0xdb28c059, 0xc30f5f97, 0x2f1c0970, 0x8ef6ce62 }, 38 },
+	{ {0x2a4b4a46, 0x57e3077d, 0xf8a88f98, 0x210b7688, 0x3d3702b1 }, 42 },
+	{ {0x2a9430fc, 0x0ca601cc, 0xa12f860c, 0xecf9fee3, 0x2e2a9ff4 }, 19 },
+	{ {0x2ae97f3c, 0x8152f566, 0x95c3d3a2, 0xdedaa781, 0xbf0a15f1 }, 3 },
+	{ {0x2af58d6b, 0x3a8c7727, 0x0fa5bb82, 0xf129fc97, 0xf999b7ec }, 19 },
+	{ {0x2b10234d, 0xebd2a6a9, 0xa02e0750, 0xba656376, 0x8bc4a2f3 }, 5 },
+	{ {0x2b255c3e, 0x5615b2f5, 0xe2365419, 0xa35e4115, 0xa060e93c }, 5 },
+	{ {0x2b36fe2b, 0x0d98d65a, 0xb31f13fc, 0xb858db68, 0x58a51d46 }, 19 },
+	{ {0x2b4c386a, 0x56dddd2a, 0x3354bdf1, 0xa0041d3f, 0xaa0ccc72 }, 4 },
+	{ {0x2b80f46d, 0x1c40aede, 0x85a60e53, 0xddcfcc0c, 0xbb6d6d5b }, 19 },
+	{ {0x2b887860, 0x9bcc0d15, 0x55ae250d, 0x621ba6e9, 0xdf4afc52 }, 19 },
+	{ {0x2b9ab445, 0x26a19706, 0xde76ff37, 0x4459ccca, 0xe3e65c84 }, 19 },
+	{ {0x2bb837a9, 0x051277ba, 0x574d8351, 0xa9f91f9e, 0x57033074 }, 5 },
+	{ {0x2bd311a4, 0xbaf59cb8, 0x5b839cca, 0x1f55b746, 0x2aa96952 }, 4 },
+	{ {0x2bfa08db, 0x95502ee9, 0xbde61c5f, 0xe7b6557c, 0x0e4aef5a }, 5 },
+	{ {0x2c0c71c5, 0x49738d66, 0x8518db31, 0x7dd70aec, 0xefd4aa72 }, 19 },
+	{ {0x2c0e3d13, 0x0a165561, 0x7f9f8083, 0x6f4b8b60, 0x6f0774f2 }, 19 },
+	{ {0x2c4f9305, 0xd160b9a0, 0xfbc3ee42, 0x26983750, 0xee5f1952 }, 56 },
+	{ {0x2c85b993, 0x671de612, 0xe9338d09, 0x4565a4eb, 0x32a97ea0 }, 19 },
+	{ {0x2c86e339, 0xbb486a84, 0xbaffee81, 0xe9eac062, 0x44363779 }, 19 },
+	{ {0x2c9600c6, 0xe0025fee, 0x10d249e9, 0x7448ecaa, 0x37e38c42 }, 42 },
+	{ {0x2cea9cdd, 0x501d77f2, 0xb6bd78ae, 0x2ae9a63a, 0xba64cfed }, 5 },
+	{ {0x2d09b2ea, 0x90ad0cb0, 0xda104293, 0xd9962356, 0x9c33b86a }, 19 },
+	{ {0x2d174a58, 0xc81eda04, 0x90e4606a, 0xfa167bbe, 0x4082d845 }, 19 },
+	{ {0x2d1880d1, 0xf5a6944f, 0xcb1b198b, 0x997a3d90, 0xecd1903d }, 42 },
+	{ {0x2d1983a3, 0x85b4c09d, 0x317b72cd, 0xc9665926, 0x2882a412 }, 19 },
+	{ {0x2d3e86ab, 0x553c3ac7, 0xc97b8f21, 0x0207f2c8, 0x578656b5 }, 19 },
+	{ {0x2D8A35B7, 0xC5142D33, 0xBB54C066, 0xE35FEE49, 0x83330DD9 }, 19 },
+	{ {0x2d8e39f2, 0x10da6d63, 0x3f773cda, 0x03e99707, 0x12ea84cf }, 19 },
+	{ {0x2dacf7a0, 0x8857cbdc, 0x706d24b4, 0xa4666511, 0x3d16ff99 }, 19 },
+	{ {0x2dd728d7, 0xde1f83c1, 0xb60cdf48, 0x0f1fc6b4, 0x97bd3cd9 }, 19 },
 	{ {0x2de78919, 0x88a868f8, 0x9f0c02fc, 0x84f76259, 0x7d542d6f }, 13 },
-	{ {0x5f912637, 0x565932c2, 0xbd7c0d7b, 0x9be6ad3d, 0xc971f96f }, 13 },
+	{ {0x2dfbca8f, 0x5cc3a9e9, 0xd151382e, 0xbe0da410, 0xf5393eaf }, 5 },
+	{ {0x2e043630, 0x3648097e, 0x8e936c54, 0x67574aff, 0x5e3f1517 }, 3 },
+	{ {0x2e0acabe, 0x8a5baac4, 0xd17271ef, 0x6c0b4c86, 0xed540747 }, 67 },
+	{ {0x2e16a588, 0x246743c9, 0xb901afdb, 0xf1ba094a, 0x0b1c8b5d }, 19 },
+	{ {0x2e2543ac, 0x99193f76, 0xb4f35463, 0x142294c0, 0x16f0cf3d }, 8 },
+	{ {0x2e388978, 0xf765bc5f, 0xe1fa9a42, 0xe1f059de, 0x5053721d }, 17 },
+	{ {0x2ebd7b78, 0x4094097d, 0x9f0fbebe, 0x4e69be8b, 0xa9a08a5c }, 19 },
+	{ {0x2f0db48f, 0xbcf3444f, 0x52b9c7c7, 0x6ba9c4bd, 0x38bc2a15 }, 6 },
+	{ {0x2f1aacc5, 0xd18973e5, 0x9f9eafa2, 0x0d7ffddc, 0xa34d0ef9 }, 19 },
+	{ {0x2f2383a8, 0xf264172e, 0x88465a4c, 0xab66e04f, 0xbfce1d2e }, 19 },
+	{ {0x2f2c7559, 0xa5ba7fb9, 0x38aba152, 0xbd84879c, 0x0bd3cae2 }, 6 },
+	{ {0x2f4404d1, 0x41acc40e, 0x48af0b12, 0xc70cd44b, 0x066ece10 }, 19 },
+	{ {0x2f4fa99f, 0x80313358, 0xe4308449, 0x0ec44f67, 0x3268bc52 }, 19 },
+	{ {0x2f6e0a02, 0xfcc3d368, 0xdb142ac8, 0x37304c18, 0xc5226e2f }, 55 },
+	{ {0x2f7ff043, 0x8f1a8d80, 0x292c9e1c, 0xb8d77a92, 0xc600b505 }, 19 },
+	{ {0x2f8416d9, 0xcce6587a, 0xba4b71b1, 0xd3e3b626, 0x609ce7ed }, 19 },
+	{ {0x2fa9c0f0, 0x16efc2d1, 0x752a272c, 0x632393f5, 0x063ea06c }, 19 },
+	{ {0x2fc050db, 0xc44ba9df, 0xb7229912, 0x9d48e5e5, 0xe1c892c3 }, 5 },
+	{ {0x2fc15ef2, 0xc728a247, 0x2cfa3a34, 0x053e07f8, 0x21dc18d4 }, 4 },
+	{ {0x2feff37d, 0x593683ce, 0x1c7dfac3, 0x3ed32078, 0x95e01a03 }, 61 },
+	{ {0x300f20ad, 0xde3941ab, 0x10eb158d, 0xb48250e8, 0xe856a911 }, 4 },
+	{ {0x301ef3c7, 0x28041eb1, 0xdfd89227, 0xa901c32e, 0xb000d348 }, 19 },
+	{ {0x302afb5d, 0x8be26c75, 0x8309ca3d, 0xf611ae69, 0xcced2821 }, 1 },
+	{ {0x304bb59b, 0x8fcc19fd, 0x76b68793, 0x31243f42, 0xf53fc47d }, 140 },
+	{ {0x304ea294, 0x69461f1c, 0xfa801f62, 0xaf0bf504, 0x5a6882fc }, 19 },
+	{ {0x3063bc3a, 0xc5af6d99, 0x0d8d002a, 0xcbc9c3a1, 0x8bab71f6 }, 19 },
+	{ {0x30673d17, 0x3f96fe18, 0x30e579f1, 0x8daf8ac9, 0xfc3366cb }, 19 },
+	{ {0x30747a56, 0xf45389be, 0x76362f7f, 0xc55d673f, 0x1bff8312 }, 42 },
+	{ {0x308c73fc, 0x04c3b390, 0xb72ea8d4, 0x980c94c7, 0x4ba38a5c }, 19 },
+	{ {0x308f6593, 0x073a5211, 0xc73ea3e0, 0x0da3bae6, 0x6a44031a }, 21 },
+	{ {0x30a7f3ea, 0x1612f20c, 0x0f62b1a1, 0x21bc7d79, 0xae515e89 }, 4 },
 	{ {0x30b41d0e, 0x9b3c59e8, 0x826112c6, 0x18206e12, 0xe187fb5d }, 5 },
-	{ {0xa4a75ed3, 0x2c2af3c5, 0xf009661b, 0xb76be4f6, 0x5e2e9a1f }, 13 },
-	{ {0xedd109e4, 0xb518c41e, 0xb30a2b6f, 0x2a492598, 0xc9a08008 }, 51 },
-	{ {0x1ce1ebbb, 0x0f62224a, 0xa776c452, 0x3e2ef708, 0x154e7b52 }, 39 },
-	{ {0x12b3c31f, 0x0fd10ff5, 0x823dcc8b, 0xf6dfeb78, 0x5a8af2f7 }, 38 },
-	{ {0xea62733c, 0xe2a8cd17, 0xff665225, 0x1d6879c1, 0x3fe6377a }, 19 },
-	{ {0xba30ad98, 0xa8488bec, 0x6d0c661f, 0x7b859beb, 0x2fe219d1 }, 19 },
-	{ {0x8a25afae, 0xd4bf8746, 0x8ad7a0c5, 0xcf123755, 0x54d67741 }, 5 },
-	{ {0x310ab424, 0xedf15d53, 0x99e31fdb, 0xc1230ddc, 0xde307d1a }, 19 },
-	{ {0x3a46902d, 0x265d98b2, 0x7bff3a34, 0x160de1c7, 0xef4f116c }, 19 },
-	{ {0x69757f6f, 0xf1da2235, 0xfe78ffb1, 0x20bae4e9, 0xa16783c2 }, 19 },
-	{ {0xaffc4dcc, 0x0b2c8846, 0x202cd99a, 0x2f0ef27f, 0xc705d96d }, 19 },
-	{ {0xb987a785, 0x8c9fbf2a, 0x996cc200, 0xf52fb2a8, 0x40766eb2 }, 19 },
-	{ {0x071e07f1, 0x10bf1b25, 0x74c63f81, 0x042fc80c, 0x894e3f73 }, 19 },
-	{ {0xf416b424, 0xfb913ca0, 0x67fe7527, 0x9c924a20, 0xfac5c6a1 }, 5 },
-	{ {0x7393f677, 0xe0fae5fc, 0x83071c6b, 0x74756117, 0xb7d75e2d }, 3 },
-	{ {0x0413bb3a, 0xeacb0c28, 0x429b8c85, 0xb42796db, 0xe48bef6d }, 3 },
-	{ {0x40a0f35d, 0xccc7572a, 0xe53bcd4b, 0xe70abfe4, 0x77d49bc9 }, 3 },
-	{ {0x5692e41b, 0x3a4c5e76, 0x7cf290fd, 0x6c24942d, 0x0fd7b2e3 }, 3 },
-	{ {0xb4788d85, 0xe6795017, 0x7882ea4c, 0xf6a5fa32, 0x19f3fbd0 }, 3 },
-	{ {0x520739ca, 0xa1e0aac1, 0xb8eabc43, 0x05556aa7, 0x5f3f5a3b }, 3 },
-	{ {0xc84ea9e7, 0xa02609c7, 0x1ff75893, 0xcbb948fc, 0x1f1cf21c }, 3 },
-	{ {0xedc238c1, 0xeb254cbf, 0x90f1dfdc, 0x276ff7cc, 0xc93a940e }, 3 },
-	{ {0xd605458c, 0x96bbb538, 0xc4624dee, 0xeed3294e, 0xa489a61e }, 3 },
+	{ {0x30c6f729, 0x28b81c7d, 0x37d192cf, 0x6d6d6d3d, 0x1232469b }, 39 },
+	{ {0x30d914cd, 0xa2180889, 0xa40a3328, 0xe0a0c132, 0x7f4eaa10 }, 42 },
 	{ {0x30e3681b, 0xe376a76c, 0xf9e0f89e, 0x54555a76, 0x31759e15 }, 19 },
-	{ {0x69bda8b4, 0xa9618759, 0x7b95cd5c, 0x43e58da0, 0x716d0fc8 }, 39 },
-	{ {0x27847b02, 0xd2acbeba, 0xb61f2f05, 0xbd2fff0c, 0x2291a09d }, 19 },
-	{ {0xe904efab, 0xc5a75840, 0xc50ea7ed, 0xb0705268, 0x3468a64a }, 19 },
-	{ {0x031a611b, 0xa1f75b7d, 0x5fe3ed08, 0x8a61c245, 0x98b4b314 }, 19 },
-	{ {0x7a412693, 0x4f9e68c3, 0x4bf00dd3, 0xd9a9e753, 0xc05ee73f }, 6 },
-	{ {0x930df587, 0x62e7b5bc, 0xf2d36246, 0x2f03335b, 0xad732398 }, 6 },
-	{ {0xd2ccc4a8, 0xde5da217, 0x45209d07, 0x31671e8f, 0x3cbea515 }, 6 },
-	{ {0x8b7e4bc4, 0x08a8c715, 0x943bfa00, 0x069f2d51, 0x7b39a748 }, 6 },
-	{ {0x05767fec, 0x34beaaee, 0x390a86be, 0x496d98d2, 0xb27de641 }, 6 },
-	{ {0x678efe59, 0x9b8085bd, 0x27f9d3d4, 0x2cfbbd7c, 0xa74ceb89 }, 6 },
-	{ {0x91505fcc, 0xdcc43230, 0x550d1019, 0x67010bed, 0x27f9b573 }, 4 },
-	{ {0x959a2dde, 0xfc9dc1a7, 0x51cf3077, 0x9b1aaac7, 0x75f1612f }, 6 },
-	{ {0x6f0f6128, 0x5be1158e, 0xcf2e5393, 0x619187f2, 0x6a7395be }, 19 },
-	{ {0xedff8461, 0xc6b88028, 0x31a59f82, 0xcdf0fa37, 0x35921c00 }, 19 },
-	{ {0xaacaf2e6, 0x94a1c05f, 0x2ef20a8c, 0xe6892242, 0xc0f88919 }, 19 },
-	{ {0xb1248f7b, 0x9d4e16a8, 0x94555c51, 0xc533d3fd, 0x9a90802e }, 19 },
-	{ {0xe0fd133e, 0xb7f64523, 0x8b3ec546, 0x624c2d12, 0xb8a913f9 }, 19 },
-	{ {0x250d0d6e, 0x646eae48, 0x17802c49, 0xe367ad8c, 0x1c35a462 }, 19 },
-	{ {0xb7b4d5c8, 0x3d8c336d, 0xbfe32833, 0xbba974ce, 0xa7f0cb8d }, 19 },
-	{ {0x4624af3d, 0xea3996f7, 0x0d860dfd, 0xbd1a8844, 0xb8cf43ec }, 19 },
-	{ {0x3ceb18cc, 0xdd8153aa, 0x260f287f, 0x5de44606, 0x01040ab6 }, 19 },
-	{ {0x2dacf7a0, 0x8857cbdc, 0x706d24b4, 0xa4666511, 0x3d16ff99 }, 19 },
-	{ {0x83fba433, 0x71d8d3c5, 0x0a97c969, 0x23e52b40, 0xdf2a7816 }, 19 },
-	{ {0xfa717868, 0x6ddf5dd2, 0x898c9453, 0xd8bb2c0b, 0x83984c73 }, 19 },
-	{ {0x8bd874aa, 0x854cc26d, 0x7fc48e7d, 0x2de60dbb, 0xee681721 }, 19 },
-	{ {0xd6b6cb3d, 0x85b991f8, 0xadf2e07a, 0x0e8e74b5, 0x86741d12 }, 19 },
-	{ {0xeadf124b, 0x91b996b8, 0x90b1ae84, 0xb75b21ee, 0x6568d1f3 }, 19 },
-	{ {0xdc49e2ac, 0x9985a417, 0x078412cc, 0x09fe7270, 0x033ffb17 }, 19 },
-	{ {0x50efb704, 0x0339632c, 0xf8bddbc1, 0xd3eaae1f, 0xb2e2188f }, 5 },
-	{ {0xe96888c9, 0x6c3044ca, 0x7ce57dbd, 0xf1744df7, 0x469f7465 }, 5 },
-	{ {0xe31ac652, 0x0e912c27, 0xce96431a, 0x1dfb112b, 0xf71cb7b9 }, 4 },
-	{ {0xf0e4168e, 0xa18188fc, 0xa2581526, 0xc2503223, 0xb9a28581 }, 4 },
-	{ {0x98748c36, 0x4e7bff50, 0xcf073c1a, 0x421ebe5b, 0x5d8b7025 }, 4 },
-	{ {0x910b156b, 0x562880ac, 0xe789fb3f, 0x9b118481, 0x63c2df20 }, 4 },
-	{ {0xf4a1e82c, 0x533677ed, 0x9923b11a, 0x0b970264, 0xd9ecf8ca }, 4 },
-	{ {0x30a7f3ea, 0x1612f20c, 0x0f62b1a1, 0x21bc7d79, 0xae515e89 }, 4 },
-	{ {0x6b42315e, 0xddefa0a3, 0x3ea0c451, 0x0d6a4bc1, 0x086a5163 }, 55 },
-	{ {0xf2854b71, 0x98f32569, 0x1a5ad312, 0x9bd05b44, 0xd6120771 }, 55 },
-	{ {0x14343864, 0x54c77680, 0x0cba3805, 0xc4041b01, 0x05c2f71f }, 56 },
-	{ {0xfd7b23a4, 0xf1c2058b, 0x966b5ddd, 0x52cf7ae4, 0x4a0eebb0 }, 5 },
-	{ {0xab30cdea, 0xacbdf14e, 0x6366d43d, 0x88133817, 0x8fc665cb }, 3 },
-	{ {0xd63e2036, 0x9f984877, 0x67810a0c, 0x57603bef, 0x6a2a07e5 }, 3 },
-	{ {0x076c45e1, 0x52598777, 0xcdb1ace8, 0x2b119940, 0x18bfed83 }, 3 },
-	{ {0x2ae97f3c, 0x8152f566, 0x95c3d3a2, 0xdedaa781, 0xbf0a15f1 }, 3 },
-	{ {0xc66483cd, 0x0d83292e, 0x4f2b54a3, 0xe89bd96b, 0x8bf9abb2 }, 3 },
-	{ {0x41278449, 0x55388f81, 0x2e33437f, 0x618936dc, 0x98944c0a }, 3 },
-	{ {0x4c153759, 0x10461a7a, 0x34a2fd54, 0xc7f51e71, 0x2f06bc69 }, 3 },
-	{ {0x76666da5, 0x870d1901, 0x026e3dde, 0xd3f22ce7, 0xa706689d }, 3 },
-	{ {0xd441ccfe, 0xde2c089f, 0xbef54e20, 0xb90c0d4b, 0x513c5196 }, 3 },
-	{ {0x06aa7bdc, 0x1d8f01e6, 0x7d1a1736, 0x08438439, 0x3074e613 }, 3 },
-	{ {0x4c2f0156, 0x85a17db7, 0xa8c3893e, 0x868e0a84, 0xa8dbf1e5 }, 3 },
-	{ {0x6844758f, 0xf5c2c410, 0x115d4d7c, 0xf12498c4, 0x2e931732 }, 3 },
-	{ {0x87b7c800, 0x69a15fdb, 0x90b40dfe, 0xd736fb84, 0x92104cd9 }, 3 },
-	{ {0x711e03c6, 0x620ba574, 0xf98f8954, 0xf1750cdc, 0xafd60d14 }, 19 },
-	{ {0x3ea78826, 0x2557f578, 0xb25e4e36, 0xe61c1cf9, 0xfb1155d1 }, 42 },
-	{ {0xdcf79362, 0xf6885373, 0x3326a22e, 0xb8fdafa1, 0x7bca281e }, 42 },
-	{ {0xacd46021, 0xa228b2b6, 0x12c82d04, 0xc124b78e, 0x7d4c25e3 }, 42 },
-	{ {0xa6b77c58, 0x73f220c0, 0x05783397, 0x61552e5e, 0xe82fab62 }, 42 },
-	{ {0xd09d75c7, 0xf242a696, 0x93140745, 0x8e717c9b, 0xdaadb7d9 }, 6 },
-	{ {0x0e6b6644, 0x021dbfad, 0x3c486c37, 0x8818ea5e, 0x432bb9fd }, 19 },
-	{ {0x5a936427, 0x1ddca520, 0x8b625c89, 0x1f01a89f, 0xd2367a8d }, 19 },
-	{ {0x4785fafd, 0xef83b621, 0x03c9d3fe, 0xeed58278, 0x5b2e5189 }, 19 },
-	{ {0x989d9ba7, 0xc0f29694, 0xfa3b737d, 0x09cf1026, 0x06b2fd5b }, 19 },
-	{ {0xacb6e932, 0x27bc89da, 0x119443e0, 0x3890b58a, 0x1befc0b0 }, 19 },
-	{ {0xacb6e932, 0x27bc89da, 0x119443e0, 0x3890b58a, 0x1befc0b0 }, 19 },
-	{ {0x4dd2ec21, 0x474720eb, 0x56f012bb, 0x761117b4, 0xd507f331 }, 19 },
+	{ {0x30fa1447, 0xf8ef8e8f, 0xf9653dce, 0x6d7d6721, 0x04f6e6ab }, 19 },
+	{ {0x30fff22e, 0x3e3d4649, 0x93707488, 0x442721a5, 0xe56a9707 }, 24 },
+	{ {0x3103f017, 0x0bae627b, 0xdeb77108, 0xe0e78228, 0x4e4581c9 }, 19 },
+	{ {0x310ab424, 0xedf15d53, 0x99e31fdb, 0xc1230ddc, 0xde307d1a }, 19 },
+	{ {0x31292b9c, 0xa9fe7d1d, 0x8833530f, 0x44c0a567, 0x1bfefe4e }, 1 },
+	{ {0x3136bee4, 0xc7d4d20c, 0x1a5ba495, 0x16fc9499, 0xf405a5bf }, 19 },
+	{ {0x3137e676, 0xc37195d4, 0x6fe6acc4, 0x395d0dc4, 0xd711d919 }, 19 },
+	{ {0x31472edf, 0x134c8ba5, 0x32e6a1ed, 0xed0dcc1a, 0xa088e8ba }, 19 },
+	{ {0x3167ffc2, 0xf2411138, 0xe4545cbd, 0xf4466c32, 0x37a04874 }, 19 },
+	{ {0x31706b3f, 0xc6cf6ab1, 0xd2e3670d, 0xdead5645, 0x64e96c45 }, 19 },
+	{ {0x317a7cc0, 0xab90882d, 0x25d1185e, 0xeb9aca6b, 0x884c8879 }, 19 },
+	{ {0x3194153a, 0x9c93aa24, 0xb37804a7, 0x64f112bd, 0xef091bf8 }, 8 },
+	{ {0x3197d73a, 0x5400a724, 0x20f91def, 0x6d3aa8bd, 0xcb392754 }, 19 },
+	{ {0x31b452ff, 0x42624c6a, 0xc1e0141d, 0x65869df1, 0xeabe5bb3 }, 19 },
+	{ {0x31b8b69d, 0xe88d84aa, 0xbdb762af, 0x1adeac81, 0x5723562c }, 5 },
+	{ {0x31d80470, 0xc8d23ec8, 0xb14256aa, 0x32f3d54d, 0xbc532d76 }, 19 },
+	{ {0x31dbd1c0, 0x8659c649, 0xc49da8d2, 0xe6b80328, 0xcb6b59e8 }, 17 },
+	{ {0x3202af11, 0x3265e67e, 0x130a0b94, 0x8dc167a9, 0xf9e9cc79 }, 5 },
+	{ {0x32151ddc, 0x4303290c, 0x09889bf8, 0x107493dd, 0x34296043 }, 5 },
+	{ {0x32210a9c, 0xbbb51e30, 0xff59ed44, 0xbf32e628, 0xfdf6c42c }, 17 },
+	{ {0x3242e7b1, 0x320aa1c6, 0x9c58fade, 0xd826ab0f, 0xae5ad970 }, 19 },
+	{ {0x3243a5cc, 0x562451de, 0x527917e9, 0xca856572, 0x86b2852f }, 6 },
 	{ {0x32615267, 0xe8497db3, 0xf5e6f534, 0x8ee309e7, 0x3c80a1a7 }, 19 },
-	{ {0x04325bfe, 0x5bc20a8f, 0x6d086933, 0xd138fb92, 0xca200111 }, 19 },
-	{ {0xcf4c1a4d, 0xf0a55c4a, 0x0cf33436, 0xe649f32e, 0x5857b5cc }, 19 },
-	{ {0xea151b44, 0x3c27b77a, 0xc43fdae9, 0x9db3adb0, 0xabf43fbb }, 19 },
-	{ {0x3b7a7cdc, 0x05b45518, 0xd2757ab8, 0x2ed6415d, 0xa1309486 }, 19 },
-	{ {0x67baaaa8, 0x70ad4a08, 0xf55ec1c6, 0x7dbeabc9, 0x7b6f18a0 }, 19 },
-	{ {0x5e28fa0c, 0xd90bcfb7, 0x995acb02, 0x5a22f6f5, 0x56ccac08 }, 19 },
-	{ {0xca5f1492, 0x5a7d33d8, 0x3dc581bb, 0xe2ff5258, 0x389bfba7 }, 19 },
-	{ {0x49ab343d, 0xf35bf2df, 0x206cdffd, 0xcad63c64, 0xca6e7284 }, 19 },
-	{ {0xe90b579a, 0xc6479834, 0x3abb635f, 0xcbf929e8, 0x3714312a }, 19 },
-	{ {0x11306e41, 0x84da7930, 0x50ca6c0f, 0x59ad3b2b, 0x9f084ef6 }, 19 },
-	{ {0x50f61894, 0xc2f519fa, 0x369d7b92, 0x5de7d52b, 0x708dde29 }, 19 },
-	{ {0x0b474ac5, 0x3701ff0d, 0x53d30e09, 0x90faa76f, 0xcca90f39 }, 19 },
-	{ {0xed798b8e, 0xe852611a, 0x0e4d054b, 0xf31652ef, 0x3f73e67f }, 19 },
-	{ {0xc4bd9f0d, 0x34061b40, 0x25f8d5c5, 0x866d51c7, 0x63612e92 }, 19 },
-	{ {0x445963fd, 0xdfbd0487, 0xaddaf4b0, 0xad620520, 0xe426a1d2 }, 19 },
-	{ {0xf76e7e4c, 0xcca2a77a, 0x13d9a2d5, 0x198667ba, 0x810491f9 }, 19 },
-	{ {0x974d6ef7, 0x601dc590, 0xa35644e2, 0xaf774306, 0x7a867ac3 }, 19 },
-	{ {0xf2ec3714, 0x13817521, 0x2b6b6e28, 0xb5da4361, 0xcc4b5471 }, 19 },
-	{ {0xbe608739, 0x9419e253, 0x9751faf3, 0xaa079c45, 0xfcd590c7 }, 19 },
-	{ {0xa355e495, 0x23edce5f, 0x15ebf92b, 0x8320ffa6, 0x523c1382 }, 19 },
-	{ {0x3f52c04e, 0x64688e8a, 0x5cbfc95b, 0x21ef0369, 0x8e1de518 }, 19 },
-	{ {0xdd926342, 0x09338632, 0x401e2b6f, 0x118cbaaa, 0x5f8add86 }, 19 },
-	{ {0x99a8631c, 0xdc37f0dd, 0x9d8793ea, 0x8eadd3f3, 0x4e0bba51 }, 19 },
-	{ {0x6e17ee44, 0xd62f57be, 0x20177a69, 0x2319e4da, 0x14be572f }, 19 },
-	{ {0x6fbb3851, 0x47a939a7, 0xe6b47f59, 0x45d8e3b6, 0x71a8c065 }, 19 },
-	{ {0xebb70722, 0xf7527991, 0x1cce79e6, 0xbd78b8f5, 0x14561b0f }, 19 },
+	{ {0x32760893, 0xce06dbe3, 0x93062775, 0x5ba065cc, 0x3d8ec6ca }, 79 },
+	{ {0x3288894e, 0x1be6af70, 0x5871499b, 0x23c85732, 0xdbc40993 }, 1 },
+	{ {0x32972530, 0xda19cac5, 0x956f83c2, 0x253c7cbf, 0x41e14dc3 }, 55 },
+	{ {0x32b9ae84, 0x09abcca5, 0xe8536e89, 0x0b21cc31, 0x0cf45822 }, 19 },
+	{ {0x32c06b62, 0x47a40863, 0x458481df, 0x60a81115, 0x51dbaefb }, 19 },
+	{ {0x32cdc5c9, 0x8915ba03, 0x5865fb13, 0x4e08ce5b, 0x75084099 }, 3 },
+	{ {0x32dd4df2, 0xb39461c0, 0x694f6bb8, 0x4de07094, 0x78a69d31 }, 6 },
+	{ {0x32de67d6, 0x26d799d6, 0x6e41c57d, 0xd9e049d4, 0xea01c997 }, 1 },
+	{ {0x3325a55d, 0xc5cb88f7, 0x9d3a25dc, 0x21521d61, 0x24a6a90b }, 19 },
+	{ {0x3330d9b6, 0xb76e3c4c, 0xcb7cf252, 0x496ed15d, 0x08b95d3f }, 142 },
+	{ {0x33352b5e, 0x33057beb, 0xe0c9b989, 0xafe90f17, 0x8aba7243 }, 19 },
+	{ {0x33536dac, 0x686b375b, 0xa13faf76, 0xa3baf2d6, 0x978904e0 }, 19 },
+	{ {0x336a7c45, 0x1a03c9a5, 0x5726d171, 0x603b5462, 0x8ad832c8 }, 19 },
+	{ {0x336d714e, 0x3bc2dfe3, 0x626e55d0, 0x1ee4ef74, 0xa48cf652 }, 19 },
+	{ {0x33708719, 0x9d586660, 0x29f00e08, 0xca82b191, 0x7ab58c80 }, 19 },
+	{ {0x3376cf9d, 0xd2b1ac9b, 0x41bf6bf6, 0x598b3313, 0x6e86f9d5 }, 65 },
+	{ {0x3377d201, 0x7cc8433f, 0xa20b432c, 0x9d2328c5, 0x3bbc10e6 }, 19 },
+	{ {0x33846002, 0x9d65ebce, 0x0d9119d8, 0x11187a35, 0xc866a958 }, 5 },
+	{ {0x33ad6d1b, 0xf1fb816b, 0x232ea706, 0xd149327e, 0x363c7b21 }, 19 },
+	{ {0x33be9017, 0xfaf173ea, 0xe04d0c91, 0xca8d42d1, 0xc20596c0 }, 19 },
+	{ {0x33c62e6f, 0x7478be36, 0x9580a2d9, 0x85ff5766, 0x7f13cf84 }, 19 },
+	{ {0x33ec3136, 0xdfb6fd44, 0x014c8bbf, 0xfc8ac79c, 0x3cafe75c }, 19 },
+	{ {0x34019d5b, 0xc3687ec1, 0x255fd7ad, 0x7571830a, 0x67241ddd }, 19 },
+	{ {0x3425eea3, 0x36140da0, 0x3d7d7f09, 0xa94fd928, 0xd70e2212 }, 6 },
+	{ {0x342e7d4b, 0xd86f3351, 0x766f460f, 0x6de3c89a, 0x40791ee0 }, 1 },
+	{ {0x3450f93f, 0xc2b08a05, 0x2a709930, 0xc97edead, 0x0099e447 }, 19 },
+	{ {0x34544106, 0xfbd29b2a, 0x72e1e8c2, 0xe0f260b7, 0x9a0b0883 }, 39 },
+	{ {0x34635bf3, 0x518c7b33, 0x164f3d96, 0xda769c7a, 0x01102d28 }, 8 },
+	{ {0x34716d19, 0xc216436e, 0xdb8d68c6, 0x9f5b779a, 0x70250168 }, 19 },
+	{ {0x35195ab6, 0x7c289a0b, 0x47088346, 0x4df66bc6, 0xea5b00d3 }, 1 },
+	{ {0x352d6906, 0x6885fc2c, 0x7c75f0e3, 0xacd885f9, 0x53916d1c }, 19 },
+	{ {0x352ec8c9, 0x9fe1397a, 0x88ecb3ae, 0xe6dbb4d1, 0x21c818e9 }, 135 },
+	{ {0x3535be7d, 0x6d2a5d3c, 0x8048bca7, 0x52e6adcd, 0x52a994d6 }, 19 },
+	{ {0x353e2bd9, 0x01e55023, 0x75dc92a0, 0x4e1686c1, 0x192fcf42 }, 19 },
+	{ {0x356a9369, 0x87e62967, 0x597ec64a, 0x0d35a1e8, 0xad1aa20b }, 5 },
+	{ {0x3574a6dc, 0x95457934, 0x1934452f, 0xeb141859, 0xb7cfa3bc }, 19 },
+	{ {0x357c0c2e, 0x9b3b2970, 0xc587c96f, 0x86a6b727, 0x2160f54a }, 4 },
+	{ {0x358e69f4, 0x27390041, 0xb5aa2801, 0x8550a88f, 0x996bddb6 }, 64 },
+	{ {0x359c8171, 0xcdfbb965, 0x854ff494, 0x2a740d40, 0x45eb5ff5 }, 19 },
+	{ {0x35abd4a1, 0x40337107, 0x30da72ed, 0xf278aad4, 0x2d641621 }, 19 },
+	{ {0x35c02d8d, 0x590d9205, 0x3f083b0c, 0x0c897277, 0xa5375af6 }, 5 },
+	{ {0x35f13b5a, 0x32c64b21, 0x517f0c40, 0x09f26406, 0x7338912e }, 19 },
+	{ {0x3626b5dd, 0x3188ec2a, 0x16e102d0, 0x5c79f8f2, 0x42fbd892 }, 12 },
+	{ {0x3627431d, 0xb990b691, 0x3606328a, 0xe2fb3340, 0x452b2797 }, 19 },
+	{ {0x363b5a8c, 0x94cdb63a, 0x7ee72b9d, 0x25f7b505, 0x3cab319a }, 19 },
+	{ {0x364ae669, 0x5509f5cf, 0x16985cc2, 0x946a45af, 0x5ca4cf56 }, 19 },
+	{ {0x365c93d7, 0x652c9f72, 0x7221689b, 0xcc348652, 0x832a7b7a }, 1 },
+	{ {0x366cc928, 0xa5dd5948, 0xbf6cf2ab, 0x1e00efcb, 0x2b6a8fd8 }, 19 },
+	{ {0x36eda820, 0xb734ac7a, 0x42653af3, 0x70a475f3, 0x6bd36b1b }, 6 },
+	{ {0x371de6f1, 0x2d834da0, 0x7c8e67b1, 0x3e75fc22, 0x618ba5e9 }, 19 },
+	{ {0x37262340, 0x1599c579, 0x68daac03, 0x12dd9a0a, 0xbbc6bd2f }, 19 },
+	{ {0x372cdeff, 0x033701c8, 0x6d3e01ef, 0xe73c172a, 0xf7492dd1 }, 19 },
+	{ {0x373319d9, 0xdbadc959, 0xdd953894, 0xbe166637, 0x88918655 }, 39 },
+	{ {0x373412f9, 0xc32762de, 0x1c3a7e27, 0xfc3d8061, 0x4e0a0c8e }, 141 },
+	{ {0x3739d841, 0xabfef971, 0xdb76ba10, 0x915b19b9, 0xdf833476 }, 5 },
+	{ {0x373aa82d, 0x04268308, 0x80a7344e, 0xf98f7309, 0xd93814c7 }, 42 },
+	{ {0x37bd4680, 0xa36c3a1a, 0x078e2bc4, 0x7b631d85, 0x8d9296b8 }, 10 },
+	{ {0x37e6fe7d, 0x07b3f8b2, 0xc585c77b, 0x231207ac, 0x8baa1ea3 }, 19 },
+	{ {0x37f30229, 0x1c75847f, 0x4b87a82e, 0x3acbbf62, 0xeab625f8 }, 19 },
+	{ {0x380225f8, 0xbcd65345, 0x36b41fc6, 0xf15ab80e, 0x48aa7172 }, 1 },
+	{ {0x3828bf9e, 0x72aeaf78, 0xff0281a6, 0xb1f7fa44, 0x0a370cdd }, 19 },
+	{ {0x3837d3a7, 0x2498caa0, 0x70866d94, 0x7956a2e3, 0x0fb94fbe }, 6 },
+	{ {0x386cf567, 0xb7b73105, 0xd7f60346, 0x3e1fe2bd, 0x919c3d0d }, 19 },
+	{ {0x3880b064, 0xdcb851ca, 0x221ff67e, 0x435137a7, 0xcf1141f8 }, 5 },
+	{ {0x3888c923, 0xf8231448, 0x9405c38b, 0xd6110ab2, 0xfdbc1a61 }, 19 },
+	{ {0x38a103e5, 0x40eb5fbe, 0x2627fab2, 0x991bda08, 0x092635e0 }, 5 },
+	{ {0x38a3c665, 0x9080b38d, 0x9a2655e8, 0x69e9fc0c, 0xe3e26c5e }, 19 },
+	{ {0x38a645fe, 0xbd0e0fe8, 0x6d594f27, 0xc2d14be9, 0x95acc730 }, 1 },
+	{ {0x390fb09a, 0x9d944d1d, 0x17c328ae, 0x13832575, 0x1d1b4203 }, 3 },
+	{ {0x3926cdd9, 0x1fa89657, 0xa811463e, 0x48cfbdb3, 0x50676e51 }, 1 },
+	{ {0x3950f222, 0x65139a84, 0xcf57f3c0, 0x936e7927, 0x173f3d7a }, 19 },
+	{ {0x395c5f40, 0x692c45b8, 0x91abe07c, 0x89d1e878, 0x29665fc7 }, 19 },
+	{ {0x397716d2, 0x6a075c6d, 0x731f0b04, 0xf3fa24aa, 0x39521798 }, 19 },
+	{ {0x3987c45a, 0x35e5c3fe, 0x494a00ef, 0x0690a329, 0x790ae34d }, 19 },
+	{ {0x39a40c12, 0x65cc663e, 0xef0d21de, 0xa01a9bf5, 0x2c8c140e }, 19 },
+	{ {0x39a91558, 0xbba92b73, 0x10455cd7, 0x513276d4, 0x87de0f9d }, 56 },
 	{ {0x39b67dd1, 0xae799f2e, 0x151c229a, 0xc2e32954, 0xabb1bd72 }, 19 },
-	{ {0xed97f51e, 0xef9192ec, 0x7f905f2b, 0xa4aabf6a, 0xcc513587 }, 19 },
-	{ {0xfcc6b6b9, 0xf05de409, 0x492a1fb9, 0x88fa671e, 0x46d54196 }, 19 },
-	{ {0x1804cfbc, 0x4f175136, 0xb7b934b5, 0x75d49cbc, 0x0e726ffe }, 19 },
-	{ {0x44b23a17, 0x5d04ca21, 0x236a5fef, 0x18600b01, 0xb12aaf4d }, 5 },
-	{ {0x10758fb5, 0xd42b97a0, 0x5b537db9, 0xb009bd64, 0x4c153c93 }, 5 },
-	{ {0x984966dc, 0x32808afa, 0xd67c8460, 0x24aa2889, 0xdf20d6e2 }, 19 },
-	{ {0xa0e815c2, 0xd224d05f, 0xb2746e4d, 0x327ec22b, 0xfe5b349a }, 19 },
-	{ {0x301ef3c7, 0x28041eb1, 0xdfd89227, 0xa901c32e, 0xb000d348 }, 19 },
-	{ {0x9b2df344, 0xbaa30658, 0x9af86bdd, 0xf2ce373b, 0x6c66e60e }, 19 },
-	{ {0x5370b774, 0x61126211, 0x69d503bb, 0xec2e7fc5, 0x26279f53 }, 19 },
-	{ {0x26fc48dd, 0xaca0fedc, 0x90fc151d, 0x4ecd5ca6, 0xd1ccc77b }, 19 },
-	{ {0x7f086cc2, 0xca0c35bf, 0x599f48c2, 0xd5e901e8, 0x9411239f }, 19 },
-	{ {0xa67e699e, 0xdb471c35, 0xa217a5c3, 0xe6831c6c, 0xdb0eabe5 }, 19 },
-	{ {0x146332dd, 0x0a190c3e, 0x6eb4abe1, 0xc4306a8f, 0x6faca9f0 }, 19 },
-	{ {0x8f35c41a, 0x5235dec2, 0x2c3b99cd, 0x6dd63cfd, 0xa0a7a821 }, 19 },
-	{ {0x978aa035, 0xcc57a6b6, 0x3d8bbcaf, 0xcb310ebb, 0x2436dd87 }, 19 },
-	{ {0xf93e23d9, 0x58d2075b, 0xf476cb05, 0xa3c4f48d, 0x0c41aabb }, 19 },
-	{ {0x0d737079, 0x4507150d, 0x78825e5b, 0xc20553be, 0xa034c309 }, 19 },
-	{ {0xf4d4d132, 0x866707e7, 0xf8a97408, 0xb093acab, 0xb67ef5aa }, 19 },
-	{ {0x26a7b011, 0x8d158e9b, 0xd3ea947f, 0xbe68f57b, 0x54e0b847 }, 6 },
-	{ {0x69bc7cb4, 0x36ea2ea3, 0xa6b49c3b, 0x050bae24, 0x271a2f9c }, 19 },
+	{ {0x39bc111c, 0x953bdf25, 0x683db7ff, 0x4c0bad79, 0xb5c49958 }, 5 },
+	{ {0x39c12004, 0xadb3442f, 0x2c43aade, 0x8a0be420, 0xd59eefb1 }, 19 },
+	{ {0x39cb046a, 0x9b6b6ef4, 0xe769cdc6, 0xfdf36b27, 0x4cd44039 }, 19 },
+	{ {0x39d500fb, 0xf22168be, 0x2a12ac89, 0xff5a5013, 0x1bb1c30b }, 8 },
+	{ {0x39dfc462, 0x60f99b67, 0x0916b1e5, 0x5f67a5d4, 0x136e6e54 }, 1 },
+	{ {0x39e85842, 0x2a865af9, 0x91f5dae9, 0x7fbfbb3d, 0x7e1ca69a }, 104 },
+	{ {0x39ef139d, 0x8d66fb18, 0xb04dff8b, 0x9a538601, 0x1f497479 }, 19 },
+	{ {0x39ffaacd, 0x0c287501, 0x8e7673a8, 0x87a921fe, 0x9d31d6dc }, 19 },
+	{ {0x3a0b0bdd, 0x77a1f3a1, 0x1533f5ef, 0x030370bc, 0xc90c6334 }, 3 },
+	{ {0x3a1f5fcb, 0x8c0856aa, 0xef8dd611, 0x99a62acb, 0x760b0086 }, 141 },
+	{ {0x3a46902d, 0x265d98b2, 0x7bff3a34, 0x160de1c7, 0xef4f116c }, 19 },
+	{ {0x3a481c7b, 0x7e4f0406, 0xa55952bc, 0x5b9f8cf9, 0xd699376c }, 64 },
+	{ {0x3a4a65dc, 0x6d540297, 0xa7aae0a9, 0x914897aa, 0xcf740807 }, 19 },
+	{ {0x3a8c815f, 0x9f97c067, 0x828e22f5, 0x0386a938, 0x3f8e1a3d }, 19 },
+	{ {0x3a9a942e, 0xd888dd64, 0x1cddf8de, 0xada1879c, 0x454df3c6 }, 42 },
+	{ {0x3a9e1020, 0xb693b244, 0xf8437e93, 0x8cdc7e09, 0x17eb441b }, 19 },
+	{ {0x3abae41c, 0xb742b76f, 0xf45dd178, 0xbd7db346, 0x137fe0fa }, 19 },
+	{ {0x3abca440, 0xcba16ac5, 0xe162b602, 0x557d3016, 0x9f77adab }, 1 },
+	{ {0x3b13e164, 0x130cab9b, 0x36c1a95e, 0x06f8d9fd, 0x707fc97f }, 19 },
+	{ {0x3b1fc45b, 0x04bd03f2, 0x1d5b8833, 0x0a0c5d16, 0xa9bd2d65 }, 5 },
+	{ {0x3b4143e5, 0x769d6235, 0xbca8977b, 0x41241295, 0x493eaf5e }, 3 },
+	{ {0x3b6200f8, 0x8561a59a, 0xe5d2b3e9, 0x4515b89c, 0xdb96044b }, 4 },
 	{ {0x3b697fd0, 0x424848e2, 0x3d9d21ef, 0x97d47d27, 0x16bb08f6 }, 19 },
-	{ {0x0fa2bb1e, 0xffefde08, 0x61fe53a3, 0x8ff5b56a, 0x6a320c80 }, 19 },
-	{ {0x20191b43, 0x7958e990, 0xd14660f4, 0x76c340e1, 0x40236c70 }, 19 },
-	{ {0x70eaf556, 0xb2f9f077, 0x895d2b72, 0xebe880e2, 0xf9213b81 }, 19 },
-	{ {0x6844ddf6, 0x10e1a98b, 0x55e77fcc, 0x364b38a0, 0x37751a2b }, 19 },
-	{ {0xf72681f0, 0x9b52d530, 0xec905e8d, 0xf21c4a15, 0xe30201ab }, 19 },
-	{ {0x0672e025, 0xb47c9447, 0x398d69fb, 0xed5c56af, 0xc157acc1 }, 19 },
-	{ {0xc0fa7d53, 0xb3e66bd1, 0xe1680bb1, 0x35db8f74, 0xabbac52e }, 19 },
-	{ {0x650273f9, 0x6ec4cfa4, 0x80004952, 0x4e38aa9c, 0x28c6cafd }, 19 },
-	{ {0x3c2295fb, 0x9fc9f1b6, 0xa607a74f, 0x4538e24d, 0x170522e5 }, 19 },
-	{ {0xeade20a0, 0x145afd47, 0xec355182, 0x5e9994fa, 0x29e17e22 }, 19 },
-	{ {0xfc2a86cd, 0x2c24e2ac, 0xce77a6d3, 0xe491821a, 0x03dccdfa }, 19 },
-	{ {0x4b0c1ded, 0xc44cd181, 0x3b274162, 0x093f713e, 0x895973c1 }, 19 },
+	{ {0x3b6f140c, 0x99cba5bf, 0xa510200d, 0xf49d1e57, 0x3d687e4d }, 4 },
+	{ {0x3b6fd6a7, 0x8807e700, 0xa38f9ecb, 0x145ab284, 0x7c862f52 }, 19 },
+	{ {0x3b7a7cdc, 0x05b45518, 0xd2757ab8, 0x2ed6415d, 0xa1309486 }, 19 },
+	{ {0x3b9df9bf, 0x57ac9d8f, 0x155c623c, 0x8ed6057a, 0x79491738 }, 19 },
+	{ {0x3bb2f9f4, 0xbe38b5b0, 0x8da03ee1, 0x90c39cae, 0xc30e2f08 }, 5 },
+	{ {0x3bb48bed, 0xf53a781f, 0x0470e0bb, 0x5ad2e7bb, 0xa785310e }, 19 },
 	{ {0x3beb85d3, 0x0e3e7319, 0xc719e0a2, 0x90096fb8, 0xaa9ff3bc }, 19 },
-	{ {0xbbca0b00, 0x374ba536, 0x6ba53b38, 0x0285d388, 0x57450a7d }, 19 },
-	{ {0xc344ed78, 0x465203e1, 0x2143bd98, 0x89281ba9, 0x81a195e4 }, 19 },
-	{ {0x2f8416d9, 0xcce6587a, 0xba4b71b1, 0xd3e3b626, 0x609ce7ed }, 19 },
-	{ {0x030b6ea5, 0x34f2285b, 0x57b8740c, 0x0dcb4c8b, 0xf92ed7c7 }, 19 },
-	{ {0x4f73d4b7, 0x31b83091, 0x45b2a9bf, 0x9c37620e, 0x4f4a391c }, 19 },
-	{ {0xf3952b79, 0x0ae2a8a1, 0x434b52bf, 0x816c56c9, 0xe680f73e }, 19 },
-	{ {0x8d3f5cb0, 0xd2d23b4a, 0x3079f4f1, 0x39e72173, 0xaee18105 }, 19 },
-	{ {0xbb75492c, 0x6ebbbf18, 0x27b3695f, 0x70e481d6, 0x5487da44 }, 19 },
-	{ {0x84fb1346, 0x0412203c, 0xe8b35d3f, 0x83c1b41f, 0x15ca42c8 }, 19 },
-	{ {0x13f55fcb, 0x993dabbe, 0xf792f2a3, 0x696c4f54, 0x5f31f44b }, 19 },
-	{ {0xA5561715, 0x7C5D89DB, 0x5900654B, 0x641E757A, 0x37FECD1A }, 19 },
-	{ {0x0dbc7def, 0xd96b71c1, 0xfe2d63cb, 0xc725f5e5, 0x8aea2db0 }, 25 },
-	{ {0xa18b1d49, 0xdf954a33, 0x16ed215b, 0x6facfc1e, 0xc020ce13 }, 25 },
-	{ {0xb40b178c, 0x6876cf3d, 0xedf4ae48, 0x262a5914, 0xc5f674fd }, 25 },
-	{ {0xf29cac37, 0xc5001ddc, 0x752ff4a0, 0xb9cc51a9, 0x65906da8 }, 19 },
-	{ {0xdd9a41e4, 0xc8802cd4, 0xbbb87e30, 0x281711f4, 0xe7ae017f }, 19 },
-	{ {0xece128e7, 0x1c14cacd, 0xe1c58f61, 0xc51a86d9, 0x86789c3e }, 39 },
-	{ {0x21e44cc5, 0x957b65b2, 0x4c34d2c4, 0x2b39879c, 0xacd82ff9 }, 39 },
-	{ {0x7f189caa, 0x1f0c3076, 0x0707e05c, 0x13bc50c3, 0xfb3ac441 }, 19 },
-	{ {0xabb5cd4c, 0x8bdde234, 0xcadb0e10, 0xb794be32, 0x49dc51a5 }, 19 },
-	{ {0xac1096e7, 0xb725830e, 0x61213b2b, 0x26310ff3, 0x22df2946 }, 19 },
-	{ {0xb5bcbe2d, 0xfeaf7cc1, 0x56c0d8bb, 0xf4fdcbe9, 0x7b2007d4 }, 3 },
-	{ {0xe6ba4960, 0x3707c929, 0x291c39fb, 0xdf866474, 0xbf096316 }, 19 },
-	{ {0xa3de0761, 0x2da79863, 0x87a4f5c4, 0x1bbbc7e3, 0xb244e077 }, 9 },
-	{ {0x3626b5dd, 0x3188ec2a, 0x16e102d0, 0x5c79f8f2, 0x42fbd892 }, 12 },
-	{ {0xd3bc33d5, 0x6b93e19f, 0xd32cc473, 0xde3e5b99, 0x35b3ba28 }, 19 },
-	{ {0x86e688ce, 0xa0f0c8bc, 0xd31b6bcd, 0x19fd72ac, 0x108646bb }, 19 },
-	{ {0xe06ed9b0, 0xb3e1fbb9, 0xf27be65c, 0x37b4d9b5, 0x48889b4f }, 19 },
-	{ {0x9ae54a8a, 0x5badd3ed, 0xbcb6b693, 0xdf1821d1, 0x5efbd9c9 }, 19 },
-	{ {0x9dcb43b6, 0x54a08de2, 0xc52147f4, 0xa2e628b5, 0xfe3761c8 }, 19 },
-	{ {0xda4b44c7, 0x34029f60, 0x388b7cea, 0x4ab97c3d, 0x5c6a09e9 }, 9 },
-	{ {0xa3537934, 0xa4d9dfbf, 0x27aca5aa, 0xf42e0f18, 0xe4975366 }, 9 },
-	{ {0xb18d36cc, 0x60d0e3b3, 0x25138bb9, 0x8472b685, 0xcca89f90 }, 9 },
-	{ {0x552a758f, 0x77a7c359, 0x69523dba, 0xca74587f, 0x0b59eb2b }, 4 },
-	{ {0x74e9ea38, 0x1e2fed07, 0xd989d105, 0x6002de57, 0x37125aaf }, 5 },
-	{ {0x6ad2f111, 0x227d6d46, 0x59f0089b, 0x9397896d, 0x16f867a0 }, 42 },
-	{ {0xa9bf062f, 0x695475e8, 0x4be4ab78, 0xafb9715f, 0xc3f6f40e }, 19 },
-	{ {0x56c4813a, 0xc549af87, 0x11b2e2e4, 0x2d7db1b9, 0x60c4c040 }, 19 },
-	{ {0x82a15beb, 0x8b31d250, 0xc12666e5, 0xe773a539, 0xad5e47c5 }, 19 },
-	{ {0xcc9a8289, 0x8da39e5c, 0xfeb04000, 0x06d093d3, 0xb869f28c }, 19 },
-	{ {0x7dfe091e, 0x02f6c1b2, 0x1bd65e44, 0xeb5052d5, 0x64d0ef92 }, 19 },
-	{ {0x2033ea83, 0x1fd887c8, 0x2fd8f8a1, 0xc9491f7a, 0x5dbe0175 }, 19 },
-	{ {0x708eef06, 0xa0b5aca9, 0x0dda1208, 0x77b1cc3a, 0x5172a642 }, 19 },
-	{ {0xd1a7cbaf, 0xf354b590, 0x03f0e297, 0x723b912c, 0xb6ad0b36 }, 19 },
-	{ {0x14393568, 0x469c74bd, 0x6f8be777, 0x0149db19, 0xf0553ab6 }, 19 },
-	{ {0x3b13e164, 0x130cab9b, 0x36c1a95e, 0x06f8d9fd, 0x707fc97f }, 19 },
-	{ {0xeeb810dd, 0x36b512e8, 0xcc842be6, 0xa22ddf33, 0x80088a56 }, 19 },
-	{ {0x958c2a68, 0x6fe52324, 0xc0adb85b, 0x3dda4471, 0x910f7000 }, 56 },
-	{ {0xff4c92cc, 0x84676c62, 0xb9c08b19, 0x7effc6ed, 0xa741db01 }, 56 },
-	{ {0x2c85b993, 0x671de612, 0xe9338d09, 0x4565a4eb, 0x32a97ea0 }, 19 },
-	{ {0x9cab6a79, 0x3e39076e, 0x3f598aa5, 0x4bffd558, 0x5ddc7e3e }, 19 },
-	{ {0x4f6c94ce, 0xe6550b16, 0x19813eaa, 0xcd88af02, 0xebde51dc }, 19 },
-	{ {0x9002aa0b, 0x2d49a9fc, 0x32318048, 0x7ff59178, 0x1867a99c }, 19 },
-	{ {0x1c6b2b81, 0x552590e8, 0x2d3205af, 0xbde93653, 0xfa449429 }, 19 },
-	{ {0xd7446382, 0x4c3c15cb, 0x391ef7a1, 0x3054472b, 0x5e7abe73 }, 19 },
-	{ {0xcf726044, 0x3f814c57, 0x619a862f, 0x82162fe3, 0xe12369e1 }, 19 },
-	{ {0xd394e2f7, 0x1cdb955d, 0x03cbf817, 0x3950e82f, 0xc69646bd }, 55 },
-	{ {0x1e92d20a, 0x5815ad0d, 0xffd50d83, 0x24fce389, 0xca033e05 }, 56 },
-	{ {0xfcd563fe, 0x7ccb293b, 0xe1f1adb0, 0xda7d6f0d, 0xa8fc7e2e }, 56 },
-	{ {0x1e429b73, 0xaf3d9e9a, 0xe0718d88, 0x405a7b7e, 0xdd0a24f2 }, 19 },
-	{ {0xaf4e0490, 0xc178a18a, 0x47b34831, 0xfb5e3cf8, 0xb61d34d9 }, 19 },
-	{ {0xec76d4d9, 0xb61bdbde, 0x9a4b5be0, 0x82dbdae9, 0x6321a591 }, 19 },
-	{ {0x6842fb21, 0xabb2531c, 0x17fe0687, 0xd77e0123, 0x48d3dc2c }, 19 },
+	{ {0x3c0263c1, 0x52e0feaa, 0x93cb15bf, 0xa04eea61, 0xacb5236d }, 42 },
+	{ {0x3c2295fb, 0x9fc9f1b6, 0xa607a74f, 0x4538e24d, 0x170522e5 }, 19 },
+	{ {0x3c29eef3, 0x81d77f8c, 0x1f425a3e, 0x29919013, 0xc72f875c }, 19 },
+	{ {0x3c2db632, 0x1ee84e36, 0x90757c08, 0xade9dc09, 0x6bd209b3 }, 19 },
+	{ {0x3c86f9aa, 0x84febfe4, 0x9c1b2cd3, 0x5442a46a, 0x172b5493 }, 63 },
+	{ {0x3c9301ee, 0xa142857e, 0xe5e9e04d, 0x0caebbc5, 0xa4245715 }, 19 },
+	{ {0x3ca4a1ab, 0x35b3cbe3, 0xddb238ce, 0x88ca9df2, 0x58ae37d6 }, 19 },
+	{ {0x3caeec19, 0x423a960d, 0x98e4719b, 0x301a3d27, 0x6339e5ae }, 5 },
+	{ {0x3cce9cdf, 0x016792e5, 0x31017b87, 0x3e13eeb1, 0xe7c85013 }, 19 },
+	{ {0x3ce544aa, 0xefdb8a91, 0x6a1639af, 0xea774eb7, 0x5ec4702f }, 19 },
+	{ {0x3ce8e357, 0x90eb4689, 0xb21e14c7, 0xecdd4b63, 0x943ee158 }, 1 },
+	{ {0x3ceb18cc, 0xdd8153aa, 0x260f287f, 0x5de44606, 0x01040ab6 }, 19 },
+	{ {0x3cffef3c, 0xadd60fa3, 0x54da6a34, 0x9bf970bc, 0x1db15915 }, 19 },
+	{ {0x3d065377, 0xf11b2341, 0x0282b6b7, 0x6f26bd93, 0xb9d05184 }, 39 },
+	{ {0x3d107526, 0xc16ebbd4, 0x3bb0e9e5, 0xbe030531, 0xd5466ab0 }, 19 },
+	{ {0x3d2d0a2e, 0xb3d12fa6, 0x7ecbbb90, 0xb7ac1bdc, 0x76ad8412 }, 42 },
+	{ {0x3d36aaa5, 0x8909b813, 0xbff34b4b, 0x1b738dbc, 0xf807b86a }, 19 },
 	{ {0x3d45014a, 0xccbee7c0, 0xdf798a7c, 0x77771666, 0xf863dfd5 }, 19 },
-	{ {0x00f6e7ef, 0xbb5a50b6, 0x6723a313, 0x0009a96d, 0x8a588363 }, 19 },
-	{ {0x2d174a58, 0xc81eda04, 0x90e4606a, 0xfa167bbe, 0x4082d845 }, 19 },
-	{ {0xf332df80, 0x4849c7a1, 0x2f50dbbd, 0xbbb37949, 0x716b3671 }, 19 },
-	{ {0x630db251, 0x6b6f6da1, 0x6882f507, 0xe74fb354, 0x55552ea4 }, 19 },
-	{ {0x167b226b, 0x54cc5b68, 0x1a69d2c1, 0x509116ff, 0xaba868e4 }, 19 },
-	{ {0xa649e98e, 0xde62e7ca, 0xe982779d, 0x60674eea, 0x9eb7180e }, 19 },
-	{ {0xdc39adf9, 0xf825e2f5, 0x5fa7e6c1, 0xbb69483c, 0xbbec2695 }, 19 },
-	{ {0xf629b8f7, 0x133c3442, 0xd0371a4d, 0x84275fb2, 0xe0974854 }, 19 },
-	{ {0xf52113b4, 0x5062adc7, 0x5cf7a0ed, 0x0538b3a0, 0x7696cc24 }, 19 },
-	{ {0x1f8b9ac2, 0x8dbadaf5, 0x316770cd, 0x6a421c99, 0x8e33a8cb }, 19 },
-	{ {0x3bb48bed, 0xf53a781f, 0x0470e0bb, 0x5ad2e7bb, 0xa785310e }, 19 },
-	{ {0xed1f7342, 0xb9b26ec0, 0x2ca2d584, 0x570d75f9, 0x25167ea1 }, 19 },
-	{ {0xf9201b7b, 0x99a6cb4d, 0x8c847e30, 0xdc2617d4, 0x243be8e7 }, 19 },
-	{ {0x7d1c7b99, 0xc73ff9d8, 0x9cced66f, 0x50ee2f8c, 0x83809881 }, 19 },
-	{ {0x8aa6d0aa, 0xdf00de91, 0x12696da5, 0xb7dc6e3b, 0x62f2d9be }, 19 },
-	{ {0x17e39a9a, 0x38c70608, 0x984b4d14, 0xf4948f35, 0xd131c816 }, 19 },
+	{ {0x3d516033, 0x1beb1c5c, 0xc54ba6ec, 0xef6b3ce2, 0xff4660b6 }, 19 },
+	{ {0x3d78b034, 0x5fc88d76, 0x00192f2c, 0x268c6646, 0xfda6ae1a }, 19 },
+	{ {0x3d840685, 0xdaac4960, 0xce3a6d08, 0x50a49044, 0xbf44c607 }, 19 },
+	{ {0x3da301b1, 0x082c158e, 0x505523fa, 0x22c19f1b, 0x3f4d851c }, 19 },
+	{ {0x3dcecd61, 0x0e832e77, 0x69547d3b, 0x6ce2b767, 0xf65f3563 }, 19 },
+	{ {0x3de0cea6, 0xa4575e63, 0x1fee0db9, 0x85e0f0f5, 0x84761980 }, 19 },
+	{ {0x3df7c19f, 0x739d74d6, 0xefdfd815, 0x1343e5a5, 0x5d4ac842 }, 5 },
+	{ {0x3e0360a4, 0xf2355224, 0x98682a71, 0x4f523039, 0xa5ab6c7c }, 39 },
+	{ {0x3e2ef016, 0xf255168e, 0x2df1906e, 0x678ca22f, 0x880917b8 }, 19 },
+	{ {0x3e44a4e5, 0x608e0179, 0x3877e62f, 0x82c12c2b, 0x82908461 }, 39 },
+	{ {0x3e57fad1, 0x30be7922, 0x3068ab29, 0xf1e77ecb, 0x7f2ad237 }, 5 },
 	{ {0x3e7b4374, 0xcd6c0818, 0x2f968328, 0x888d1cb3, 0xfd1c7dd7 }, 19 },
-	{ {0xaa68633f, 0xf1afd385, 0x535b2abd, 0x7c8756b6, 0xcf79256a }, 19 },
-	{ {0xbd46981d, 0x1b580ec9, 0xa2d1d909, 0xf5c1a8df, 0xd9a71ed7 }, 19 },
-	{ {0x0293bc55, 0xdf4f9b7f, 0xb97ae9cd, 0xed8ab2c5, 0xc9ed0fd4 }, 19 },
-	{ {0xa53610ad, 0xcf84bdb1, 0xb84d94d4, 0xc6d1f0a7, 0xd45e9ddd }, 19 },
-	{ {0x217b21d1, 0x0d80fe2d, 0x5d04636e, 0xe8c2f97f, 0x6edfe34a }, 5 },
-	{ {0xdf505aec, 0xddb20171, 0xcafd0635, 0x1e0b7d20, 0x8365e708 }, 144 },
-	{ {0x77f2d9d2, 0x7724a7c7, 0x1c688a59, 0x8d34bd0c, 0x8a8e56d0 }, 3 },
-	{ {0xc654b842, 0xcff7227d, 0x9e85fda2, 0x5279259e, 0x837cee9e }, 3 },
-	{ {0x093d5ab3, 0x9878ed4c, 0xdd42fb7c, 0x2a1502b7, 0xe65b17c0 }, 3 },
-	{ {0x46f99530, 0x8d736da2, 0x35ba7f17, 0x841d8afe, 0xff403c99 }, 3 },
-	{ {0x95ae5b3e, 0x24ad0bea, 0x21902cb7, 0xdfd3fd95, 0x81166a76 }, 39 },
-	{ {0x1090b058, 0xd39dfd7b, 0xd7ea1a1f, 0x6f8fe994, 0x7a54805c }, 19 },
-	{ {0x02a2fafc, 0x7b9249db, 0x76803ece, 0x347ba73b, 0xe25f71b5 }, 19 },
-	{ {0x14451b29, 0x31a014e9, 0x49a4b3d2, 0x973d424d, 0x910e0d9d }, 19 },
-	{ {0x88533246, 0xb479840d, 0xe98c8244, 0x84dceeb5, 0xf2f99366 }, 19 },
-	{ {0x61793310, 0x1a195d1f, 0x52aba644, 0x4930cfe4, 0x53e6e50a }, 19 },
-	{ {0x1dd7fe1d, 0x71354a8b, 0x2c2df315, 0xac442b9c, 0xe3583b3c }, 19 },
-	{ {0x64f921c9, 0xc57aedb4, 0x7663a269, 0x046d4c51, 0x388f41fb }, 19 },
-	{ {0x5fe519d6, 0xbeb80398, 0x13d10cd1, 0xc08e6e6a, 0x08813d2d }, 19 },
-	{ {0x32cdc5c9, 0x8915ba03, 0x5865fb13, 0x4e08ce5b, 0x75084099 }, 3 },
-	{ {0x2391ae8c, 0x961b4a38, 0xb3beaee9, 0xed3362fb, 0x2c71851f }, 19 },
-	{ {0x6b9f1e8e, 0xa9173157, 0x0ab7e2ca, 0x6bdb9fba, 0x7937afa5 }, 19 },
-	{ {0x4e4989c8, 0xf6336663, 0x690217f3, 0x2aca22a3, 0x19b90091 }, 19 },
-	{ {0x912433d6, 0x80fd52bf, 0x91e9b926, 0xa98bb081, 0xffdeb1dc }, 39 },
-	{ {0x1aeae118, 0x0471e9a6, 0xe8e86699, 0x3031b881, 0xa341f921 }, 6 },
-	{ {0x6fefbe44, 0x8674b6ea, 0x846d0c6b, 0x9c8a0d57, 0xa11aa410 }, 6 },
-	{ {0x3b6200f8, 0x8561a59a, 0xe5d2b3e9, 0x4515b89c, 0xdb96044b }, 4 },
-	{ {0x842009e0, 0xf7d0e977, 0xe47be7a5, 0x6fe60707, 0xf477ed93 }, 4 },
-	{ {0xecc68b4a, 0x04279442, 0x4df771a3, 0x336361fd, 0xb50d0875 }, 19 },
+	{ {0x3ea78826, 0x2557f578, 0xb25e4e36, 0xe61c1cf9, 0xfb1155d1 }, 42 },
+	{ {0x3eee7c72, 0x362522c2, 0x7866d436, 0x7a8cf1e2, 0x2932db32 }, 19 },
+	{ {0x3f047469, 0xb62d9390, 0x4005a0ea, 0x29092e89, 0x2724ce0b }, 1 },
+	{ {0x3f072673, 0x752badfb, 0xd234d600, 0x5ddad60a, 0x494a9438 }, 5 },
+	{ {0x3f0a7b0c, 0xbaa3d4c3, 0xc6ce7447, 0x08c68c89, 0xeff82289 }, 14 },
+	{ {0x3f16d551, 0x3ad35692, 0x488ae7d8, 0x64f660e7, 0x6c6e8ed3 }, 103 },
+	{ {0x3f20b961, 0x49f58b86, 0xd1f0e794, 0x83d5ddf4, 0x02191ec9 }, 55 },
+	{ {0x3f4dd4b4, 0x59f12306, 0xfe368643, 0x44af0b35, 0xf8c5d3b4 }, 19 },
+	{ {0x3f52c04e, 0x64688e8a, 0x5cbfc95b, 0x21ef0369, 0x8e1de518 }, 19 },
+	{ {0x3f741ba2, 0xab08c5e9, 0xfb658882, 0xb36b8e3d, 0x01682f58 }, 5 },
+	{ {0x3f87c341, 0x3c8cc2a2, 0x5e1f64cf, 0xdcd01155, 0xa13711f0 }, 5 },
+	{ {0x3f9d72bd, 0xafecfa64, 0x0639cf66, 0x721e7380, 0xe41c6e6d }, 4 },
+	{ {0x3ff276af, 0x654c7dc7, 0x12abed79, 0xd9123317, 0xce79b4e4 }, 3 },
+	{ {0x3ff54468, 0xa5acf1ad, 0x44e85bdc, 0x993044aa, 0xa3165a63 }, 62 },
+	{ {0x400fe724, 0xbddb6a1e, 0x6c28fd18, 0x15820cb7, 0x64ef9e95 }, 50 },
+	{ {0x4025045e, 0x93f51afd, 0x58545104, 0xcc2c8972, 0x26febaf7 }, 39 },
+	{ {0x40348c56, 0xadd3cf5a, 0x4b40b8cb, 0xc94a39e0, 0xec94ff0a }, 1 },
+	{ {0x4061c461, 0xfa9ff21a, 0x6c0e46b3, 0xa71607e3, 0x32d80ba3 }, 50 },
+	{ {0x4075ef9f, 0x51b4e010, 0xbd2481a6, 0x48e05b2c, 0x29b3329d }, 42 },
+	{ {0x4077079d, 0xdebb6b78, 0x142715c2, 0x840cfe15, 0xc7e9f539 }, 19 },
+	{ {0x409e82ad, 0xac40f6bd, 0xd18eb6c8, 0x4e8b2fbd, 0xc7fb5498 }, 1 },
+	{ {0x40a0f35d, 0xccc7572a, 0xe53bcd4b, 0xe70abfe4, 0x77d49bc9 }, 3 },
+	{ {0x40b26d9c, 0x745d81c1, 0xc33711c1, 0xe2747afe, 0x3ba2a779 }, 39 },
+	{ {0x40c626d8, 0xc53e2e2d, 0x4e7e25d5, 0x5aa2c11c, 0x2645780f }, 19 },
+	{ {0x4108d6df, 0xce393ba2, 0x67993a9e, 0x51f8ad9b, 0x3ee7d3f9 }, 56 },
+	{ {0x41278449, 0x55388f81, 0x2e33437f, 0x618936dc, 0x98944c0a }, 3 },
+	{ {0x414fd2a2, 0x2076f455, 0x02c2329b, 0x45bda9f8, 0x730dcaae }, 8 },
+	{ {0x415561d4, 0x2dfe384f, 0x9cb9bc08, 0x7fe3ac89, 0x326e8114 }, 1 },
+	{ {0x4164dcdf, 0xe0613d0f, 0x4c53b6f3, 0x581548bb, 0xbad5eb43 }, 41 },
+	{ {0x416d9774, 0x1622ff3f, 0xfab2da50, 0x21a3bde3, 0xbbc07061 }, 19 },
 	{ {0x41805441, 0x58a57c99, 0x162269e3, 0x3e4f2c77, 0xc9fce84e }, 6 },
-	{ {0xba6bff43, 0xe5773c67, 0x77f73ebc, 0x63b4f384, 0x66dc2630 }, 19 },
-	{ {0x46611b1a, 0xb3b8ed27, 0x2d989fe3, 0xb209ebe2, 0x9a866718 }, 19 },
-	{ {0x53c6655b, 0x0ea7c071, 0x01018879, 0xf3bf60de, 0x071c247b }, 42 },
-	{ {0xcb352e97, 0xe9416f4c, 0x30321187, 0x58fc77d6, 0xd0f3ad73 }, 19 },
-	{ {0x45b5b0e9, 0xdd8d11d0, 0x34e09803, 0xf92ec972, 0x0cda1e3c }, 19 },
-	{ {0x1b4f56a1, 0xd6d17324, 0xe4145fb7, 0x7f3291a1, 0xa4e6f42d }, 19 },
-	{ {0xf99919c8, 0xf42addb7, 0xf65ab4fb, 0x21b603ee, 0x7e716c90 }, 19 },
-	{ {0xebde4d61, 0x18443817, 0x5db424fd, 0xf25cec23, 0x8d91a15f }, 19 },
-	{ {0xd358e08c, 0x3df089fb, 0x97acf94b, 0x27519b2d, 0x2d2ab44a }, 19 },
-	{ {0x5ceedd2a, 0xe401febb, 0x79c1f6a6, 0x4ddef4b2, 0xe1790674 }, 19 },
-	{ {0x39ef139d, 0x8d66fb18, 0xb04dff8b, 0x9a538601, 0x1f497479 }, 19 },
-	{ {0x633700d1, 0x1fc36ccd, 0xab118daf, 0xd4f7e71e, 0x3eca2f46 }, 19 },
-	{ {0x0bc97a87, 0xb42b0e9d, 0x5855dde9, 0xb8839292, 0x1a9b3277 }, 19 },
-	{ {0xab924f3b, 0x59a5aee1, 0x5be02584, 0x442a5eec, 0x8ff4e908 }, 19 },
-	{ {0xa53d1ea7, 0x75a6c90a, 0x84f1f363, 0x49540b16, 0xcf8307e4 }, 19 },
-	{ {0x60a938d4, 0x1398970a, 0x99a14c84, 0x7521fca3, 0x6d588009 }, 19 },
-	{ {0x0b3a217d, 0x3278a43d, 0x7460136f, 0x955171c7, 0x62a1f8e5 }, 19 },
-	{ {0xb5cdef44, 0xb22c7e23, 0x4895b053, 0xe487233c, 0x117d1a4f }, 19 },
-	{ {0xcfa30c1d, 0x6741e1b5, 0x6b54622b, 0xbc3d8900, 0x3f739a17 }, 19 },
-	{ {0x4e09d611, 0x62c3dd95, 0x7d59ece0, 0xaa5d7222, 0x294b5c5a }, 19 },
-	{ {0xc9a89cce, 0xb355e5da, 0xf47ed5e8, 0xee3e211e, 0xbd2494d8 }, 42 },
-	{ {0xa70c6b0e, 0x90e7b8ba, 0x3e5bc06c, 0x9ae7d6af, 0x344e491f }, 19 },
-	{ {0x14de1be5, 0xde19a279, 0x19d80cda, 0xd2ceb055, 0x4a48ff02 }, 19 },
-	{ {0xc5b4fdca, 0x8887a8ab, 0xa203b311, 0xc5519f8e, 0x4863d910 }, 19 },
-	{ {0x4ad170c5, 0xdfadc6a8, 0x11cd5b8d, 0xc4c99be6, 0x56ceff56 }, 19 },
-	{ {0xa54c4244, 0x526051d8, 0x87f9d74a, 0x767c254c, 0x08d47ad4 }, 19 },
-	{ {0x846bd4d8, 0x9bd034ac, 0x5346cbc5, 0x59752635, 0xad2bda6b }, 19 },
-	{ {0x4a92ec1b, 0xe15c45ee, 0x98c08ac9, 0x6191a369, 0xd562181b }, 19 },
-	{ {0x6ebe5e2e, 0xd0fd8409, 0x1ef1a32e, 0x44c1353f, 0x049ac085 }, 19 },
-	{ {0x4991dc09, 0x7e248436, 0x506ed5c8, 0xbc3f367a, 0x65267ee7 }, 19 },
-	{ {0x17e1111b, 0x1d6aa80e, 0x8bc525be, 0x345c25e3, 0xb00ed504 }, 19 },
-	{ {0xc6227431, 0xbfbc3aa9, 0x21120ec3, 0xda7f6429, 0xa1a799a0 }, 19 },
-	{ {0x666e82d8, 0xa8e5d267, 0x2a9b7159, 0xadcdc861, 0xa31c8fa1 }, 19 },
-	{ {0x3d78b034, 0x5fc88d76, 0x00192f2c, 0x268c6646, 0xfda6ae1a }, 19 },
-	{ {0xffc8c57b, 0x26f2f495, 0xbd77efac, 0x5b815efe, 0x9c25336c }, 19 },
-	{ {0x76a67138, 0xd445557e, 0x0c079424, 0xacdff3c6, 0x0423d8ec }, 19 },
-	{ {0x632ef250, 0xc76b2221, 0x58ba90df, 0xc68b9e00, 0x4dbafe3a }, 19 },
-	{ {0xfc71561a, 0x64f73da0, 0xe0043d25, 0x6f67fd18, 0xd7fc3a7f }, 19 },
-	{ {0x223337db, 0x25c942ec, 0xe732214a, 0xba5dd624, 0xb574e9c4 }, 39 },
-	{ {0x2d3e86ab, 0x553c3ac7, 0xc97b8f21, 0x0207f2c8, 0x578656b5 }, 19 },
-	{ {0x5c61a12d, 0x490d5e1d, 0x97da5e74, 0xac40311e, 0x9725ca20 }, 19 },
-	{ {0x1c462c36, 0x29d43297, 0xa006ba90, 0x55b39a2d, 0xccba9f6c }, 5 },
-	{ {0x09779f0e, 0x9ec0c36e, 0xe3700690, 0xe2b6e282, 0xa4b40a0b }, 19 },
-	{ {0x3d516033, 0x1beb1c5c, 0xc54ba6ec, 0xef6b3ce2, 0xff4660b6 }, 19 },
-	{ {0xfb4724b8, 0x159beae1, 0x32f89f39, 0x4f71ce39, 0x34a61ae2 }, 19 },
-	{ {0xf033ab8a, 0x33e2d7a8, 0xac1313b8, 0x62bc1381, 0x38b4346e }, 19 },
-	{ {0x65334123, 0xc7d00ca6, 0x23bf5f7a, 0x55756cc7, 0x5958debb }, 19 },
-	{ {0xf772396b, 0xecdbd15b, 0xa0648bf1, 0xaef8ccb1, 0x55e1adad }, 19 },
-	{ {0xed15174d, 0xec31a29f, 0x9d41a06d, 0xe3008db0, 0x4af11a25 }, 19 },
-	{ {0xbec70fbf, 0x9b1384b6, 0xa8adc452, 0x26689f02, 0xd996b6a7 }, 19 },
-	{ {0xd2c5497a, 0x52f5b8ab, 0xabfc24ff, 0xf1573622, 0xf86a69c6 }, 19 },
-	{ {0x122f6592, 0x50a0ae10, 0xce0be0dd, 0xe626dd3e, 0x384affa7 }, 6 },
-	{ {0xa2ca7e6e, 0x216f8b45, 0x0eb8db10, 0xa4120f03, 0x53275b6b }, 6 },
-	{ {0x46062d33, 0x93c49884, 0xf84c2dc4, 0x37ff2785, 0x4e9d2e49 }, 6 },
+	{ {0x418f6248, 0x221c7903, 0x9fe6c44f, 0xc5a95148, 0x42e3ec71 }, 5 },
+	{ {0x4190c488, 0xacc6a326, 0x5deb5d7c, 0xf9511fc7, 0xf61bb964 }, 1 },
+	{ {0x41b3b183, 0x0084ef00, 0xb61339c4, 0x6c96bd0e, 0xf62cd6d3 }, 19 },
+	{ {0x41ba54c9, 0x45104915, 0xccc8d465, 0x930445c9, 0x05d839e4 }, 19 },
+	{ {0x42252cf8, 0x7deeb581, 0x81a7bfec, 0x7c874190, 0xa1351779 }, 1 },
+	{ {0x4233ab2f, 0xb0d956e0, 0xefb43e2a, 0x489ca46b, 0x65aeda8f }, 19 },
+	{ {0x42432076, 0x2bcbbb60, 0x81b1e186, 0xe21accf7, 0x58aeb935 }, 3 },
+	{ {0x428b5bdd, 0x5cbb3e4f, 0xf637cfa5, 0xdb8c41d8, 0xd0070813 }, 19 },
+	{ {0x42af8975, 0xebad6fb3, 0xed5c00c1, 0x1a236fc4, 0x9c184875 }, 19 },
+	{ {0x42fbb187, 0x22df3e34, 0xe5b0f935, 0xa2dc0ce0, 0xd85099e9 }, 3 },
+	{ {0x43084db7, 0x2dd13112, 0x450a7af4, 0xb513e13e, 0x9266defb }, 4 },
+	{ {0x4323eb37, 0xb9a795be, 0x32a2b648, 0x24fc4acd, 0x7afe4e9d }, 4 },
+	{ {0x4334acc2, 0xbd5c921b, 0xc4dcb6de, 0x9a1fcc79, 0xd843ee15 }, 19 },
+	{ {0x4340a258, 0x0c949d49, 0x8d2c8e71, 0x699fff86, 0x0214e9ea }, 6 },
+	{ {0x43465130, 0x5f92aa77, 0x0a89e40b, 0x81125fb2, 0x2d91603d }, 106 },
+	{ {0x4376342b, 0xf42334d9, 0x8dbd3e35, 0xef354609, 0x74269c58 }, 17 },
 	{ {0x438bbb33, 0x67db4938, 0xb3d90fa9, 0xd2cfb1f0, 0x8c072bb7 }, 4 },
+	{ {0x43c6a757, 0xce5ec5a2, 0x21e6c0e9, 0x22638f68, 0x8de8fd8b }, 39 },
+	{ {0x43dbcc95, 0x36fe61c8, 0x172eceee, 0xc1481778, 0xf7a2b9bd }, 19 },
 	{ {0x43dc3911, 0xb9a336bb, 0x7b17bdbe, 0x6e48464e, 0x01f2c425 }, 19 },
-	{ {0x8c9a9a9a, 0xfe13a58e, 0x4cfb7248, 0x9af2d6b0, 0x80dffaf6 }, 19 },
-	{ {0xa4383f78, 0x9482a9e8, 0x68a9f136, 0xaa722129, 0x673c2a81 }, 19 },
-	{ {0x0cf26bf0, 0x2c5b94df, 0x118129a6, 0x81a7f14a, 0xdd708177 }, 19 },
-	{ {0x07448ffb, 0x20f260df, 0x159a19df, 0x2cae1ee5, 0x545a0aef }, 19 },
-	{ {0x0f74234a, 0xdda250d7, 0x2d414787, 0x2cb421a3, 0xb6f26efa }, 19 },
-	{ {0xde4e210e, 0x6f757efc, 0x45e66be6, 0x6b14cd6e, 0xc21b2ba7 }, 19 },
-	{ {0xf3306e6f, 0x25d111da, 0x21ce66db, 0x3404f5f4, 0x8acb25a1 }, 5 },
-	{ {0xcfd872d0, 0x05b7bd4c, 0xdd6e06c4, 0xc0162191, 0xf0b0415d }, 3 },
-	{ {0xdd76ee10, 0x71e427cb, 0xfedeeedc, 0xb3a4b8bc, 0xad56ba71 }, 19 },
-	{ {0xbf7e27b3, 0x456f1a96, 0xd94a8dbf, 0x06688c8f, 0x833bd818 }, 19 },
-	{ {0x7f16f43b, 0x2197f9bc, 0xc65c564c, 0x14850347, 0x97abacb6 }, 19 },
-	{ {0x9da58782, 0x05d58fbc, 0xc641c5f1, 0x0da1aa2d, 0xc450ec97 }, 19 },
-	{ {0x0f298581, 0xb85e838c, 0x1fbaa242, 0x73d29221, 0x7f81662c }, 3 },
-	{ {0xe98e4351, 0x119d78b6, 0x402c4499, 0xed16faeb, 0x3364f6c3 }, 19 },
-	{ {0x2D8A35B7, 0xC5142D33, 0xBB54C066, 0xE35FEE49, 0x83330DD9 }, 19 },
-	{ {0xee60e88a, 0xe409ddd9, 0x3d4259b7, 0x9586dacb, 0x2e5ee372 }, 5 },
-	{ {0x4d51d3c5, 0x03631139, 0x2b173a57, 0x6bc7d91d, 0xc9fed6cb }, 4 },
-	{ {0xd9432774, 0x5bbb865a, 0x394e31e1, 0x50a6c772, 0x63ee95da }, 4 },
-	{ {0x7a786959, 0xd8fc0b51, 0x8b353414, 0x22f096dd, 0x6019468d }, 4 },
-	{ {0xe7273fea, 0xa30b6769, 0x41b25061, 0xef0631ec, 0x09ccdb7c }, 4 },
-	{ {0x7d07fdf5, 0x8c7a86d9, 0xf93af35a, 0x35acf2d7, 0xded02ff1 }, 4 },
-	{ {0x0c425d8f, 0xc1ad36c9, 0xb8e248e4, 0x77b1796c, 0xd62d9bed }, 4 },
-	{ {0xfb053bec, 0xf87f12e1, 0x96e00b3e, 0x153ec802, 0x9ebf1ff8 }, 4 },
-	{ {0x240e15fb, 0x5d918aa8, 0x21f22600, 0x2772dc80, 0x0d9f20a4 }, 5 },
-	{ {0xd33508c8, 0x9656b180, 0x63893cad, 0xb74573e0, 0xb656792d }, 5 },
-	{ {0xf999e018, 0x7023413d, 0x839a6733, 0x7d0595e1, 0x50b2398f }, 5 },
-	{ {0x1ff0afe3, 0x93f89b65, 0x17025dc3, 0x9a282c11, 0xc7da87ca }, 5 },
-	{ {0x25f5adec, 0xa8a2ddb7, 0x54d25eb1, 0x8cff0d84, 0xe5b003bc }, 4 },
-	{ {0x3b6f140c, 0x99cba5bf, 0xa510200d, 0xf49d1e57, 0x3d687e4d }, 4 },
-	{ {0x4323eb37, 0xb9a795be, 0x32a2b648, 0x24fc4acd, 0x7afe4e9d }, 4 },
-	{ {0xd0dfc192, 0x7461d947, 0x3d0ed471, 0x375dcedd, 0xdba42279 }, 4 },
-	{ {0x8c609b8b, 0xee4245a1, 0xbb81e37d, 0x888ac5ef, 0xb66533cf }, 4 },
-	{ {0x64321138, 0xe03337d0, 0xe6178ac3, 0x0bb98e66, 0x23c640ba }, 6 },
-	{ {0x63d4e39c, 0x59f24f88, 0x0809caa5, 0x34d7a46a, 0xe83f4c9f }, 6 },
-	{ {0x6147f63a, 0x319b44b6, 0x0259b35a, 0x75b1c083, 0x280b92ea }, 42 },
-	{ {0xe0854e93, 0x22c113ec, 0xbccf61f9, 0xde1c0a59, 0xbda03d23 }, 19 },
-	{ {0x0d2ba1f2, 0x033ae006, 0x9236d9eb, 0xc5411130, 0xf159d5cd }, 19 },
-	{ {0x6895a062, 0xe10b790e, 0x19a55952, 0xe634662f, 0x3135fa55 }, 19 },
-	{ {0x076f4b6d, 0x3f6d825b, 0x8b8d3fb2, 0xbc872134, 0x21a42210 }, 19 },
-	{ {0x728340e9, 0x5ad58ab9, 0x89a59f61, 0x317a45ab, 0x1f6b0bdc }, 3 },
-	{ {0xee533b8e, 0x4bdd6cdf, 0x2c273f7c, 0x80753cf8, 0xdb60f545 }, 17 },
-	{ {0x51b24ab4, 0x846758a8, 0xb6dc6b15, 0xe21b0baa, 0x70c8a650 }, 55 },
-	{ {0x58132c6f, 0xf44095b1, 0x598f267b, 0x2bdca432, 0xd3178ec9 }, 55 },
-	{ {0xf2eef740, 0x2d2e6e7f, 0x7c15a1f3, 0xd8bd2516, 0x03eabf12 }, 3 },
-	{ {0x076d6f5b, 0x9f8427f6, 0x959f7a25, 0x5abb4aca, 0xc0dd9d0c }, 19 },
-	{ {0x9bdfe44a, 0x7a0d5151, 0x346ff14e, 0xce3216b5, 0x108cc775 }, 19 },
-	{ {0xda6a332d, 0xc2360732, 0x86aa7858, 0x2c0fccf7, 0x28c86ba4 }, 19 },
-	{ {0xfe31a9a3, 0xdab733f3, 0xd0edb24f, 0xea3cff93, 0xdc9df6ae }, 19 },
-	{ {0xf9c85b43, 0x4839f844, 0x072dc73a, 0xbc8d16c9, 0x30013f3f }, 19 },
-	{ {0xfc6660a2, 0x02dbd228, 0xc9e0d7c4, 0x04340d1d, 0xcc1e2844 }, 19 },
-	{ {0x7adb6812, 0xf3702b93, 0xaa2b2a87, 0x2722bbd4, 0x0915670d }, 19 },
-	{ {0x20efab45, 0xafd6be50, 0x9ab4f8a0, 0x12e67b09, 0x4c196c73 }, 19 },
-	{ {0x9e190cf3, 0xca52d85f, 0xd34eb5df, 0x2c0dd849, 0x0448b9a2 }, 19 },
-	{ {0x5e349166, 0xfce12d45, 0xf3ce3f69, 0xecd6b2a7, 0x0ef4d68b }, 19 },
-	{ {0xe3ac6a3a, 0xb223f544, 0x0bca5ea6, 0x96e99669, 0xdd1f626d }, 19 },
-	{ {0xaa95e2c1, 0x96a59b67, 0xbede3536, 0x6275a485, 0x57b1ae06 }, 19 },
+	{ {0x43ec23bb, 0xdb3af0f5, 0xdbc6d17e, 0xa0b8d745, 0xe8833c86 }, 19 },
+	{ {0x441dacb7, 0x4a47ca4b, 0x7d1ce473, 0x00d182bc, 0x7424ffac }, 3 },
+	{ {0x44204705, 0x8fe0f290, 0xf8022ac8, 0x8d18e540, 0x7ea6068c }, 19 },
+	{ {0x4421fa25, 0x04cbce18, 0xf7c84b5e, 0xa97f04e0, 0x17007f07 }, 39 },
+	{ {0x442a39b1, 0x96f19a22, 0xfc7fb8f1, 0x4bf17386, 0xa292b60e }, 4 },
+	{ {0x445963fd, 0xdfbd0487, 0xaddaf4b0, 0xad620520, 0xe426a1d2 }, 19 },
+	{ {0x44b23a17, 0x5d04ca21, 0x236a5fef, 0x18600b01, 0xb12aaf4d }, 5 },
+	{ {0x44baa180, 0xf6c9e0f1, 0x40ac1f0a, 0xfae75c41, 0x2cb06b9e }, 19 },
+	{ {0x44deaef7, 0x47c572a4, 0x550681fc, 0xccc1bbbd, 0xc46a1ffc }, 19 },
+	{ {0x44e0dd21, 0x5b2a9f07, 0x70dd76fb, 0x49187c05, 0xb083eed9 }, 1 },
+	{ {0x44ece006, 0x4495f7c9, 0x0344e42f, 0xc14e2934, 0x1d4e08bb }, 19 },
+	{ {0x4516a0e0, 0xb915cb09, 0x3e82a19b, 0x4570d26c, 0x28e213fd }, 19 },
+	{ {0x451cbb07, 0x2011b26a, 0x7e0bc993, 0x1e67995a, 0x71f5fd6f }, 19 },
+	{ {0x4524768e, 0x575298ce, 0xe3b7eee0, 0x9b3caab7, 0x84ca3bb7 }, 56 },
+	{ {0x452deac5, 0xb3341437, 0xe70c5b27, 0x26aa26cc, 0x1d074fba }, 5 },
+	{ {0x453eac75, 0x68d5d04c, 0x8cf7da86, 0xf2e8dc79, 0x777343da }, 5 },
 	{ {0x4569c02e, 0x59fb9d7a, 0x42d6a029, 0x6d821bc7, 0xae7e338d }, 19 },
-	{ {0x4e3a48a1, 0xacddff21, 0x2807f80a, 0x67691085, 0x1e4aca02 }, 55 },
-	{ {0x7768195d, 0x49ad389d, 0x388468c4, 0xf24a53a5, 0xf53e3c5d }, 56 },
-	{ {0xae24f03a, 0x969bfc73, 0x94b9620c, 0x8f227ae9, 0x7627a7ce }, 56 },
-	{ {0xeaa6b787, 0x784bae1c, 0x7f648b57, 0xdaa1c88c, 0xf2b1b095 }, 19 },
-	{ {0x10698ea6, 0xb0423f2e, 0x858a4c28, 0xc10f3964, 0x6ca5495f }, 19 },
-	{ {0x8e9fb34b, 0x356b02a8, 0x39dce513, 0x9c120305, 0x93be13a2 }, 19 },
-	{ {0x0099492b, 0xd11dfa3d, 0xdf87af3a, 0xeb4c92b2, 0x9f78bd82 }, 8 },
-	{ {0xfe74b4df, 0x9698a61d, 0xffd3ac88, 0xf4761967, 0x5514ba1c }, 7 },
-	{ {0x5c00f9e3, 0xa48411e0, 0x8fac89b1, 0xdfdd2a6e, 0x95853919 }, 7 },
-	{ {0xf02281aa, 0x13cb34d2, 0xf10add30, 0x1529b95a, 0xdff7f768 }, 7 },
-	{ {0x70ba2331, 0x844bd5c1, 0x4906e9f2, 0x284eba11, 0x9b3e41bf }, 19 },
-	{ {0x4fe90868, 0x37670433, 0x6fbf4561, 0x9a47ce18, 0x736ff1b2 }, 19 },
-	{ {0x9648d43f, 0x3c25d67b, 0x9e4972f7, 0x77d7b024, 0x70080d1c }, 19 },
-	{ {0xabce0b85, 0x5d67ac10, 0xbc667e0f, 0x23ceab4a, 0x12ffeee6 }, 19 },
-	{ {0x6a3a6883, 0x6a468cc7, 0x61a26817, 0x5c64d53c, 0x4c1c48bd }, 19 },
-	{ {0xd9634296, 0x511c5998, 0x52aff0c6, 0xb9993509, 0xbcbc3bef }, 19 },
-	{ {0xbcf72a46, 0x73c79823, 0x61db4efa, 0xf8ebc776, 0xb6539938 }, 19 },
-	{ {0x5c7971aa, 0x8688ffc4, 0x29a3e315, 0xdd3d45c3, 0x8f72ddeb }, 19 },
-	{ {0xebf474cf, 0x35a56e03, 0x771d0b17, 0x548b59fe, 0xb2df0656 }, 19 },
-	{ {0x1fb821d2, 0x007b28fd, 0x6a059744, 0x54f5bf87, 0x67b106ac }, 19 },
-	{ {0x2308dd0f, 0x15fb5395, 0xa1d8a084, 0x89daff65, 0xead8e0f2 }, 91 },
-	{ {0xf415e409, 0x6ff3f6a9, 0xf17bfbf0, 0x2f146e44, 0xf0d5fb66 }, 19 },
-	{ {0xc23c342f, 0xf5274356, 0xa2d17d18, 0x272253d1, 0x4fd8ffdf }, 19 },
-	{ {0xae5b8e69, 0x732a23ae, 0xe102bcd9, 0x96ad0622, 0x5f1b3eba }, 19 },
-	{ {0x3cce9cdf, 0x016792e5, 0x31017b87, 0x3e13eeb1, 0xe7c85013 }, 19 },
-	{ {0x9f4ac128, 0x7b8caa28, 0x6a847c86, 0xac8601a7, 0x11be2d82 }, 19 },
-	{ {0x6c68f7be, 0x1eb46cca, 0x6dcdbb91, 0x92cbff9d, 0x59604357 }, 19 },
-	{ {0x5e1a50af, 0xfe1fa973, 0xf69e423a, 0x8827751b, 0x93fc53ee }, 19 },
-	{ {0x90592a09, 0x228b3e33, 0x00eed51e, 0xbd7358b5, 0xed2afa09 }, 19 },
-	{ {0x0ff68843, 0x3d7ad075, 0xfb22ac92, 0xac8f1b88, 0x3c7a9ae4 }, 19 },
-	{ {0xfd7518a6, 0xaedb5163, 0x0364082c, 0x27bdfe44, 0x11adfd4c }, 19 },
-	{ {0x89ccb1a7, 0xffaaa75c, 0xee9bdc9b, 0x4a9ec9b0, 0x63af7199 }, 19 },
-	{ {0xa0ed2c50, 0xe55241d2, 0x3bb5d12c, 0xb6528a2a, 0x0c3bc156 }, 19 },
-	{ {0x79c1bf77, 0xc08b733a, 0xe04e069d, 0xeaf25fd2, 0x4b28beb7 }, 19 },
-	{ {0x34019d5b, 0xc3687ec1, 0x255fd7ad, 0x7571830a, 0x67241ddd }, 19 },
-	{ {0x2feff37d, 0x593683ce, 0x1c7dfac3, 0x3ed32078, 0x95e01a03 }, 61 },
-	{ {0x6a7faa12, 0x2454ba34, 0xcbdb9f1a, 0x75a111a1, 0xa4763a56 }, 61 },
-	{ {0x73a40e7d, 0x6da2bc84, 0x89297fd5, 0x7b7b93b2, 0xaa5a6440 }, 61 },
-	{ {0xf25c4168, 0x69372ac0, 0x7abefad1, 0x31fc732d, 0xfbe33a45 }, 61 },
-	{ {0x5f6972e9, 0xe374753f, 0xaf092409, 0xf1ee10bb, 0xa5231b66 }, 19 },
-	{ {0x27dc3ae8, 0xa5d6bef8, 0x532c9c21, 0x0a44bbcb, 0xaad436d5 }, 19 },
-	{ {0xd5f5d285, 0x0b0bfda4, 0x5ba4dfff, 0x70d3fd99, 0x86399a94 }, 19 },
-	{ {0x54008fe7, 0xcd7f1a47, 0xfca70462, 0xa0a7b568, 0x2146099b }, 19 },
-	{ {0x4f36d139, 0xee4baa7d, 0x5980f765, 0xde989557, 0x0ee05f40 }, 19 },
-	{ {0xbefa36ce, 0x537fefc0, 0x9a71de4b, 0xb7fc69ce, 0x0d6575fe }, 19 },
-	{ {0x0039cff2, 0x92fe740d, 0x8c87cc21, 0x31a473cb, 0xb4f8c4f4 }, 19 },
-	{ {0x000fbc40, 0x1c7558d9, 0xc54a401c, 0x7875daa7, 0x2ab76920 }, 19 },
-	{ {0x9776da8b, 0x475d8140, 0x0e027e37, 0xd949ccff, 0xbb33fe30 }, 19 },
-	{ {0x7056a2be, 0xa5013894, 0x930279f8, 0xc09cc776, 0x33964778 }, 19 },
-	{ {0x864824c2, 0xef01945b, 0x7fccb3ec, 0x3399347b, 0x714d6aac }, 19 },
-	{ {0x1fbf5640, 0xdf41fe48, 0xc7d64ffc, 0x51e33b57, 0xb41fd7e1 }, 19 },
-	{ {0x7a0ddc5f, 0x086a6bc7, 0xe8e7f7b1, 0x84098862, 0x3a2cc1b5 }, 19 },
-	{ {0x05da8409, 0x3d973d3b, 0xfbd3143f, 0xfd155a16, 0xa9ec5f82 }, 19 },
-	{ {0x1ff13030, 0xd171fb5f, 0x653664e5, 0xd11d0777, 0x884b2463 }, 19 },
-	{ {0x602c4d0d, 0x12fd5972, 0x5c0c4e40, 0xf51d6bde, 0xb679ea36 }, 19 },
-	{ {0xc1dfc86c, 0x441e1128, 0x194f3ab4, 0x90c94e29, 0x275b5df9 }, 19 },
-	{ {0x304ea294, 0x69461f1c, 0xfa801f62, 0xaf0bf504, 0x5a6882fc }, 19 },
-	{ {0x538f4c85, 0x67bf5caf, 0xf65dc034, 0xda6cb89f, 0x8beeab62 }, 19 },
-	{ {0xe817ab7b, 0x50674c41, 0x4b1c1b72, 0x530024eb, 0x03396a41 }, 19 },
-	{ {0x8d5fe498, 0xa25420de, 0x9f428265, 0xebbb1fc2, 0xa6c0f2ca }, 19 },
-	{ {0x2dd728d7, 0xde1f83c1, 0xb60cdf48, 0x0f1fc6b4, 0x97bd3cd9 }, 19 },
-	{ {0x4ac6a17c, 0x9c17bf6e, 0x9b149b72, 0x7663496b, 0xf1bf35b0 }, 19 },
-	{ {0x15ca9629, 0x94fd25a5, 0x6bee2f54, 0x3a83f133, 0xf9d2265f }, 39 },
-	{ {0x720b629e, 0x2e22e0af, 0x15b482b1, 0x54a1473e, 0x8ab6627c }, 3 },
-	{ {0x0a7bed65, 0x2592ed63, 0x25acd037, 0xf1f5bbbd, 0x1d31b239 }, 5 },
-	{ {0xc4f95225, 0x8020de9e, 0x23a718a7, 0x8c18d22e, 0x2cccfe3c }, 19 },
-	{ {0x25db27eb, 0xb67eec8f, 0xe15e3e51, 0x947c840d, 0x23944533 }, 19 },
-	{ {0x6584c843, 0x07e5dbb7, 0x36606828, 0x3c3c332a, 0xaf52b7a4 }, 19 },
-	{ {0xf69541b8, 0x6c2b396c, 0xdce765c2, 0xdec498e1, 0x1232b3c9 }, 19 },
-	{ {0xbf3d9433, 0xbf32d3af, 0x7a7adc0b, 0xa77b9690, 0xac754daa }, 19 },
-	{ {0x2cea9cdd, 0x501d77f2, 0xb6bd78ae, 0x2ae9a63a, 0xba64cfed }, 5 },
-	{ {0x6a98d578, 0x7dd0e76f, 0x04283ce0, 0xaec55d45, 0xba81565d }, 4 },
-	{ {0x598eb258, 0xcbe532e9, 0x8b4a3c8d, 0x87ecd953, 0x6d09ce56 }, 4 },
-	{ {0xe4401a78, 0x869ffa87, 0x9a55f239, 0xe5da4990, 0xcb6797a6 }, 3 },
-	{ {0x3103f017, 0x0bae627b, 0xdeb77108, 0xe0e78228, 0x4e4581c9 }, 19 },
-	{ {0x08eb5001, 0xbd95ffb7, 0x232cdbdf, 0xfbec7634, 0xeb110ad8 }, 19 },
-	{ {0x73938f51, 0xfcb26349, 0xaa17e1ae, 0x1f1bd43b, 0x20ef227b }, 19 },
-	{ {0x0442dd29, 0xea0f7b78, 0xc9cd5849, 0xec7ef5bb, 0x21ec0bf5 }, 6 },
-	{ {0x2b9ab445, 0x26a19706, 0xde76ff37, 0x4459ccca, 0xe3e65c84 }, 19 },
-	{ {0x6baf75aa, 0x6024cb13, 0x11fc1171, 0xcce4560e, 0x16de6d9a }, 19 },
-	{ {0xea774f43, 0xf9c02064, 0xfcc07d51, 0x31691f5b, 0xd4e9c4f5 }, 39 },
-	{ {0x0421a25a, 0xff3ae300, 0xb2a4536d, 0xd0aa5fa9, 0x24e7dd72 }, 19 },
-	{ {0x818a6ced, 0xbfdf3a5a, 0xf0c844f3, 0x2a18e393, 0x0178c798 }, 19 },
-	{ {0xa7c36fe1, 0x9bb4559e, 0x8cc38ca1, 0xfae1625e, 0xe14b5625 }, 19 },
-	{ {0x4b04574b, 0x3b719586, 0x64ac7309, 0x87c4c8eb, 0xedeba890 }, 19 },
-	{ {0x4025045e, 0x93f51afd, 0x58545104, 0xcc2c8972, 0x26febaf7 }, 39 },
-	{ {0x3c2db632, 0x1ee84e36, 0x90757c08, 0xade9dc09, 0x6bd209b3 }, 19 },
-	{ {0x0f2c5a7c, 0x6cc9ff59, 0x1c911e4f, 0x3f204e42, 0x5bd3cf50 }, 136 },
-	{ {0x079bacc9, 0x708f711a, 0xf90310f3, 0xe08f2aba, 0xfa8fc919 }, 136 },
-	{ {0xe348e62e, 0x3c4c02d8, 0x7ff2aa4d, 0x55ddebb6, 0x0c3ea507 }, 136 },
-	{ {0x145552b3, 0xf62885ef, 0xcfe74840, 0x08fa4ceb, 0xe2feae84 }, 136 },
-	{ {0x95f75fae, 0x9b3e9611, 0x49e352ce, 0xf3d7e478, 0xe9887d5a }, 19 },
-	{ {0x6ce808d6, 0x9e9198a0, 0x343e9fd0, 0x6744deb6, 0xf9e59419 }, 19 },
-	{ {0x0949bd31, 0xcdbdfacb, 0x3224506c, 0x72a2210c, 0x50432157 }, 19 },
-	{ {0x97dd31b2, 0xf0dd056a, 0xbd808062, 0xe306b0c2, 0x536975bc }, 19 },
-	{ {0x09af3b68, 0xbe4eea5f, 0x5594d5d2, 0xd124d92b, 0x127dd390 }, 19 },
-	{ {0x81ddaf3a, 0x42c1e1a3, 0xd3722e0c, 0xd046316a, 0x202acd33 }, 19 },
-	{ {0xcee2b352, 0x0404f1eb, 0x6eea6bc1, 0x4ae99713, 0x85920514 }, 19 },
-	{ {0x3e2ef016, 0xf255168e, 0x2df1906e, 0x678ca22f, 0x880917b8 }, 19 },
-	{ {0xa3d1212e, 0xb4c58958, 0xf063aa85, 0x77ddfa07, 0x903b28b3 }, 19 },
-	{ {0x087afebb, 0x16bfd96f, 0x465fb0d0, 0x04326d55, 0x452bdd81 }, 19 },
-	{ {0x71765b30, 0x95f4b9f2, 0xf04e5534, 0x02e74061, 0x91506a8b }, 19 },
-	{ {0x38a3c665, 0x9080b38d, 0x9a2655e8, 0x69e9fc0c, 0xe3e26c5e }, 19 },
-	{ {0xcb0d3556, 0x27b8c036, 0x931a6766, 0x6e425d8f, 0x9225a180 }, 19 },
-	{ {0xb82dc590, 0xaadc930b, 0x43db303b, 0xb3e3458e, 0x7695e3b5 }, 19 },
-	{ {0xf4b58fec, 0xbcbc8cd3, 0x07c34806, 0xecece2a2, 0x04c26c65 }, 19 },
-	{ {0x4ef4cd14, 0xa70e5eef, 0x213f8d70, 0x877dd394, 0xcb1999b1 }, 19 },
-	{ {0xbf5678f3, 0xc065a450, 0x7f71ed62, 0x06a63ac9, 0x22ad93dd }, 19 },
-	{ {0xdceffda9, 0x22852fd2, 0x2e1a566b, 0x9cb3106d, 0x82db5847 }, 19 },
-	{ {0xb9d5ec44, 0x8d5de19c, 0x62dc09ff, 0xe3b257e0, 0xcef610d2 }, 19 },
-	{ {0x44ece006, 0x4495f7c9, 0x0344e42f, 0xc14e2934, 0x1d4e08bb }, 19 },
+	{ {0x45760316, 0xa4ebc74d, 0xdd55ee16, 0x3c5aeaaa, 0xfe965d2c }, 5 },
+	{ {0x459f2fc5, 0x6412ad89, 0x6bb41898, 0x6d005156, 0x8d9b3b81 }, 65 },
+	{ {0x45b5b0e9, 0xdd8d11d0, 0x34e09803, 0xf92ec972, 0x0cda1e3c }, 19 },
+	{ {0x45bd8130, 0x39977750, 0xc9a34795, 0x2d2e527a, 0x4e1674c5 }, 19 },
+	{ {0x45ce64a4, 0x55a2b07f, 0x3c8a6d54, 0x1cda3b0e, 0x058cc732 }, 19 },
+	{ {0x45e72004, 0x565ea1af, 0x837f4f18, 0x1d7da215, 0xca81a965 }, 39 },
+	{ {0x46062d33, 0x93c49884, 0xf84c2dc4, 0x37ff2785, 0x4e9d2e49 }, 6 },
+	{ {0x4607ed28, 0x4bd4602a, 0xffa00600, 0xc749ce43, 0xb2b89b6d }, 6 },
+	{ {0x461c581e, 0xbc43b47c, 0x54a6d706, 0xa03c462b, 0xf7d1ef75 }, 56 },
+	{ {0x4624af3d, 0xea3996f7, 0x0d860dfd, 0xbd1a8844, 0xb8cf43ec }, 19 },
+	{ {0x462bbe53, 0x5702c52a, 0x7905ad9c, 0x6bcf9303, 0x2214eae2 }, 19 },
+	{ {0x46611b1a, 0xb3b8ed27, 0x2d989fe3, 0xb209ebe2, 0x9a866718 }, 19 },
+	{ {0x468a1e22, 0x31d790c7, 0x82c0daa0, 0x50083c1f, 0x44960e43 }, 19 },
+	{ {0x4690b2f6, 0xce28e55d, 0x56ab185c, 0x573fc27a, 0x9b414468 }, 5 },
+	{ {0x469b07ee, 0xf08348c9, 0xacc14e63, 0xba0cd35a, 0xef236983 }, 42 },
+	{ {0x46c98a31, 0x43f5a80b, 0x2090311a, 0x770f9b73, 0x000881c0 }, 6 },
+	{ {0x46d1c97b, 0x97a83738, 0x7445e603, 0x9669fd9d, 0x04df8873 }, 19 },
+	{ {0x46e9ed7b, 0x7f6dfda8, 0xeee26647, 0x6c9ebc4d, 0xd9d8fcc2 }, 19 },
+	{ {0x46ecaf85, 0xf1ff1b48, 0x21670bf4, 0x4ff1249f, 0xe1b13a35 }, 39 },
+	{ {0x46f3954d, 0x7f92f5d0, 0x0f45b82f, 0xdde543c2, 0x8a4b53c9 }, 19 },
+	{ {0x46f99530, 0x8d736da2, 0x35ba7f17, 0x841d8afe, 0xff403c99 }, 3 },
+	{ {0x47129fe3, 0x791a7171, 0xf8fa792f, 0x953d7b5d, 0x58ba5c24 }, 19 },
+	{ {0x47370bec, 0x7ca1f061, 0x5a54eda5, 0x48b07fbc, 0x0c7ef398 }, 42 },
+	{ {0x473bc0ea, 0x85ed1b21, 0x8974796d, 0x819416e7, 0x11ac193f }, 5 },
+	{ {0x475c3af7, 0x49592275, 0x9a5f424d, 0x2e22d7e4, 0x073d5992 }, 38 },
+	{ {0x47642bb0, 0xa2c46a82, 0x100543dc, 0x3970d0a4, 0x9fc53b69 }, 1 },
+	{ {0x47663f88, 0x3f98ab9d, 0xdaa0bf0c, 0x2831c567, 0x919f56f1 }, 19 },
+	{ {0x4781c2c1, 0x626211b4, 0x551af324, 0xc566aa37, 0xbc2274c7 }, 110 },
+	{ {0x4785fafd, 0xef83b621, 0x03c9d3fe, 0xeed58278, 0x5b2e5189 }, 19 },
+	{ {0x479100e8, 0x2d3f25bb, 0xeb9a2911, 0x63945d2f, 0x5bd62f74 }, 19 },
+	{ {0x479608b5, 0xa86d7c77, 0xbd6c4dd0, 0x0605b8ef, 0xb2e5b43e }, 19 },
+	{ {0x47a9d9a2, 0x4e4fc6f9, 0x467c6e7d, 0x61a02d45, 0xf5a753ef }, 42 },
+	{ {0x47de7524, 0xc32e72e8, 0x49daee4d, 0x7f3e6cf3, 0x93e3b7dc }, 5 },
+	{ {0x47ea8d51, 0x2d9fec15, 0xdf8770f3, 0xb5017aea, 0x9bbba9fd }, 19 },
+	{ {0x4806e6bc, 0x1fd24d5a, 0x62c6df57, 0xea8fd1b5, 0x1d6e4b80 }, 19 },
+	{ {0x480d85e5, 0x325c8902, 0x966fdf22, 0x6868eafc, 0x62de4663 }, 19 },
+	{ {0x480fe052, 0xff41f6f6, 0xaaa745c4, 0x13012d16, 0x10f02c90 }, 19 },
+	{ {0x4811956f, 0x878c3e03, 0xda46317f, 0x787cdc4b, 0xebc86f47 }, 1 },
+	{ {0x482cd650, 0x220e6931, 0xf85ee853, 0x2c61dac5, 0x61365e30 }, 5 },
+	{ {0x484a21c6, 0x2bde3eab, 0x537f394b, 0xc270ac7c, 0x1c557f7c }, 39 },
 	{ {0x48518d95, 0xd06a7761, 0xc4afe523, 0x5ef995bd, 0xc53c1952 }, 19 },
+	{ {0x4880bf34, 0xf1c86fff, 0x5456ec2b, 0x4cf70d02, 0x339e2caa }, 143 },
+	{ {0x488a9aae, 0xd538c2a2, 0x4088cbd6, 0x815d4741, 0x4cff999f }, 19 },
+	{ {0x488f0131, 0x4da5644f, 0xbf2ca938, 0xc6f9720e, 0xf2b0d0f9 }, 19 },
+	{ {0x48b0c2ff, 0x1f1e407c, 0xc4439421, 0x9f7b3878, 0xefaa919f }, 42 },
+	{ {0x4936916b, 0xf914d99c, 0x5b9e3f4c, 0x7385f44b, 0x6b97d4c5 }, 19 },
+	{ {0x4937a8e3, 0x5072012a, 0x980f85ec, 0xfc60604d, 0x9d900244 }, 19 },
+	{ {0x495876c5, 0x04bdc4de, 0x24860ea1, 0x5b25dda8, 0xf3b06c49 }, 5 },
+	{ {0x495ae7af, 0x3d299b96, 0x25cdd79a, 0x2ee41cde, 0x5b328362 }, 19 },
+	{ {0x495eb918, 0xced94ef4, 0x7885df40, 0xceceef8b, 0x56e96691 }, 5 },
+	{ {0x4971bdd3, 0xdb63d394, 0xfbc21861, 0x82c901ca, 0x4b32535b }, 19 },
+	{ {0x4991dc09, 0x7e248436, 0x506ed5c8, 0xbc3f367a, 0x65267ee7 }, 19 },
 	{ {0x4998d34b, 0x559f4a53, 0x1843cebd, 0x23022126, 0x58d953f7 }, 19 },
-	{ {0x9c5c1c40, 0xec30c34b, 0x1b436cf8, 0xcc494c0b, 0x509e81fc }, 6 },
-	{ {0x3243a5cc, 0x562451de, 0x527917e9, 0xca856572, 0x86b2852f }, 6 },
-	{ {0x06cc2eca, 0x2930d67f, 0x23568ccf, 0x77a894f4, 0x75f27efe }, 19 },
-	{ {0xc8ff858d, 0x239c62a8, 0x59f15c2f, 0x1bf44e1d, 0x657cec13 }, 19 },
-	{ {0xda824945, 0x2da86c0b, 0xa44f0ae2, 0x79ccff82, 0xa1ddd756 }, 19 },
-	{ {0xe568e345, 0x5c14cab8, 0x992b58c2, 0x849a745e, 0xf5b19b21 }, 19 },
-	{ {0x1d6a355a, 0x9ce84c78, 0xe3bafc27, 0xa4f1151e, 0x240f68f0 }, 19 },
-	{ {0xc484f44a, 0xf0ab1bca, 0xf46ae5f1, 0x4a3b38a5, 0x3ee77f31 }, 19 },
-	{ {0x7435a9ca, 0xec4cdefe, 0x398299ba, 0x9b6adf89, 0xc302fda5 }, 19 },
-	{ {0x8a6e0f93, 0x2ce12318, 0xa1c5b8db, 0xbfe44b21, 0x3acb03ae }, 19 },
-	{ {0xe2340608, 0x00fdcca4, 0x1eb3f701, 0x9edd21c2, 0x8c9ce223 }, 19 },
-	{ {0x6448aa09, 0x0d95ab42, 0xe8a63f52, 0xcd12e40c, 0x39521aa0 }, 19 },
-	{ {0xde7b6525, 0xf9aafe8e, 0xf77d25a7, 0x99f0f829, 0x0bbc8f2e }, 55 },
-	{ {0x19a95d8e, 0x0fd5cb61, 0xed02e064, 0x1ed15454, 0xf0b9de42 }, 55 },
-	{ {0xdf203139, 0xad0cd235, 0x7f312541, 0x7a4157e7, 0x01dbacf6 }, 56 },
-	{ {0xf795668a, 0xfe66c7d8, 0x8e51f5a2, 0x2471e2c0, 0xa42c7ffb }, 56 },
-	{ {0xe94d34d1, 0x64f5379e, 0xa85464b5, 0x1743461e, 0x3f6c92ab }, 19 },
-	{ {0xe6a0d6c4, 0x0419647e, 0x6b17d30a, 0x000331a9, 0x04c8f5df }, 19 },
-	{ {0x480fe052, 0xff41f6f6, 0xaaa745c4, 0x13012d16, 0x10f02c90 }, 19 },
-	{ {0xd7bd6e84, 0xedcaf6d9, 0x9abaf659, 0x78135019, 0x26bda398 }, 19 },
-	{ {0x47129fe3, 0x791a7171, 0xf8fa792f, 0x953d7b5d, 0x58ba5c24 }, 19 },
-	{ {0x2729bb0e, 0x68a64af5, 0x25df4c5d, 0x9687bae0, 0x7245980a }, 19 },
-	{ {0x820174b4, 0xdd3f3df8, 0x7e5e32fb, 0x6f7ed457, 0x542d96c1 }, 19 },
-	{ {0x386cf567, 0xb7b73105, 0xd7f60346, 0x3e1fe2bd, 0x919c3d0d }, 19 },
-	{ {0xb4333576, 0x83fb1154, 0xd75c677b, 0xa0189366, 0x5880f483 }, 19 },
-	{ {0x6600fab9, 0x0ca39551, 0x7d0845f8, 0xf380b0e6, 0x7541b392 }, 19 },
-	{ {0x20ce8211, 0x2ba0c500, 0x63667d61, 0xe43979ac, 0x464a3bb4 }, 19 },
-	{ {0xe7d06c0a, 0x5c7f256c, 0x061e5b81, 0x73fdcc14, 0x5d2fc4d6 }, 19 },
-	{ {0xa8313b0d, 0xce35faa8, 0x0b399a22, 0x0f19b043, 0x33fdec1d }, 19 },
-	{ {0x43ec23bb, 0xdb3af0f5, 0xdbc6d17e, 0xa0b8d745, 0xe8833c86 }, 19 },
-	{ {0xf7dd6841, 0xd280cbff, 0xa9f0f2da, 0x7af3549f, 0x23270ddb }, 5 },
-	{ {0xa66e19e5, 0x8ac5b4da, 0x7db071ca, 0x7ead40c2, 0x8a332198 }, 39 },
-	{ {0x2644b852, 0x51b03f64, 0xfc5c5661, 0x3d5cd07d, 0x9bcd345d }, 39 },
-	{ {0xa3772599, 0xcdb84df7, 0x1ef2bb38, 0xb1e2cb2f, 0x66593969 }, 19 },
-	{ {0xe4d61ee7, 0x4867066b, 0x04b0f6ab, 0xa35d98d7, 0x2665e6e0 }, 19 },
-	{ {0x8f92ea21, 0x4a7a1139, 0x4c512080, 0xd3b65a7a, 0xfa9a92ed }, 19 },
-	{ {0x57a39f69, 0x47d1f871, 0x07961cd5, 0x7ee6a520, 0x27d5c612 }, 19 },
-	{ {0x4c7dd442, 0x3ef40d5b, 0x929b3602, 0x60fc8675, 0x0abbe159 }, 19 },
-	{ {0xfafd58ec, 0x55b2e1e8, 0x4255036a, 0x3cdf2de8, 0x7d348942 }, 19 },
-	{ {0x763a0c9e, 0x1f2f847d, 0x79e60da4, 0xc6251ce0, 0xad80cb70 }, 19 },
-	{ {0xe738a8e4, 0xe09b5081, 0x67b552e9, 0xe4350c04, 0x1ca68c20 }, 19 },
-	{ {0xfbbd9a77, 0x004f9bdb, 0xcfc292f8, 0x5c32106f, 0xaa18cfa6 }, 19 },
-	{ {0xdb7e4c8d, 0xc56a0e8e, 0x0e3df08b, 0x14a65030, 0x738d5ac4 }, 3 },
-	{ {0x7f26383f, 0xc61af7be, 0xb0176a64, 0xeb936bcc, 0xee0d7a3b }, 19 },
-	{ {0xd8e34fab, 0xf8584bb5, 0x66c5056f, 0x8b42b50b, 0x6f497f48 }, 19 },
-	{ {0x778472f9, 0x113eb6a8, 0x0144cc71, 0x7151eb48, 0x474b9d34 }, 19 },
-	{ {0x5628514e, 0x2488ccb1, 0x5ae464e7, 0xf210dcab, 0xbb782b91 }, 19 },
-	{ {0xab29429f, 0x7d2df7ce, 0x4bab46d1, 0xd0f2b782, 0xdf7f908e }, 19 },
-	{ {0x3167ffc2, 0xf2411138, 0xe4545cbd, 0xf4466c32, 0x37a04874 }, 19 },
-	{ {0x2af58d6b, 0x3a8c7727, 0x0fa5bb82, 0xf129fc97, 0xf999b7ec }, 19 },
-	{ {0x8c6e1e21, 0xcc45b2ca, 0x72ceea93, 0xdf48eda9, 0xcef1dbad }, 19 },
-	{ {0x7dc7f7e3, 0x96694328, 0x0f348366, 0x56a7d1bd, 0x3ace67cd }, 5 },
-	{ {0x0cb11c76, 0x6bd357d2, 0x03879bd6, 0xbee041a4, 0x690cc3df }, 6 },
-	{ {0xe92baa5f, 0xdfb2715e, 0x68700024, 0xd964098e, 0xf35704d9 }, 6 },
-	{ {0x98b7a6ac, 0x44b82ccf, 0xc45eb515, 0x95e2905a, 0xdabac1c7 }, 6 },
-	{ {0xcbe6c0db, 0x6201f8ac, 0x09310c78, 0x8adc6348, 0x73251164 }, 17 },
-	{ {0xcf344e0f, 0x58fd918c, 0x089c4d45, 0x75caec88, 0x43944ff6 }, 6 },
-	{ {0x6523381f, 0xa5012b45, 0xa69af0e3, 0x51f239c9, 0x7afd4be7 }, 19 },
-	{ {0xbf0014ca, 0x7dd0815b, 0x2385a778, 0xc5328ae6, 0x3c692229 }, 3 },
-	{ {0xabeccfe4, 0x9a687470, 0x2d65eb4d, 0x06a970d8, 0xfcf55123 }, 3 },
-	{ {0xe7c800fa, 0x576b3a95, 0x54836aa9, 0xc5eaa3ae, 0x893805d4 }, 19 },
+	{ {0x49ab343d, 0xf35bf2df, 0x206cdffd, 0xcad63c64, 0xca6e7284 }, 19 },
+	{ {0x49bfa987, 0x1bb0ad3b, 0x47a7c63b, 0x14a10e0e, 0x8ae48a52 }, 19 },
+	{ {0x49e14b02, 0x48c649e7, 0xb5754357, 0x597695ab, 0xef70c17d }, 19 },
+	{ {0x49e2331f, 0x97ea9352, 0x329dafbe, 0x0627a238, 0x063ce6b7 }, 19 },
+	{ {0x49f0e168, 0x020fddd2, 0x54843c95, 0xb5e6bcf6, 0x5bdc84ac }, 19 },
+	{ {0x49fd0580, 0x4c78c791, 0x732d2f73, 0xb83b3af5, 0x6999f270 }, 19 },
+	{ {0x4a128290, 0x1221207d, 0xa79432fb, 0x0bcb4f1e, 0x722c8278 }, 19 },
+	{ {0x4a185a3d, 0xb81c2ce2, 0x0d176d13, 0xfa5f619c, 0x6b7a170c }, 19 },
+	{ {0x4a28e8bc, 0x5ff7b57c, 0x63ce8109, 0x72c3ffc2, 0x683ee3d4 }, 19 },
+	{ {0x4a306942, 0x6214aeec, 0xac1a5763, 0x2a9978cb, 0xfb2acc21 }, 19 },
+	{ {0x4a35065d, 0x97d81a94, 0xa7649d19, 0xb3f9abd3, 0x4f834eab }, 42 },
 	{ {0x4a5cf6ff, 0xfaa793ec, 0xa8583ac8, 0xb2ba71bf, 0x993cccb4 }, 19 },
-	{ {0x0e24c5c4, 0xf16d5f95, 0x64d1bcbf, 0x29e4187c, 0xb6ad9701 }, 19 },
-	{ {0x6ad2c394, 0xf8e3ace4, 0xc30c7b75, 0x1fc2cf2c, 0x78f47bb4 }, 19 },
-	{ {0xf1d68b47, 0x7f3f54c0, 0xb6080985, 0x954208b0, 0xd95c5973 }, 19 },
-	{ {0x97adcb65, 0x2bc4baf0, 0x2d29a9ab, 0xe5e65470, 0x65dec298 }, 19 },
-	{ {0x5359c905, 0xad063a0f, 0xaf1c46a8, 0xc03b1b9c, 0x9a04b3b3 }, 19 },
-	{ {0x5460aa3b, 0xe896ad94, 0x9bea7544, 0x4bc6e7e0, 0x72a859b8 }, 19 },
-	{ {0xaeeb8ddb, 0xd385bc3a, 0xba500967, 0x6e5192d3, 0x2beecf15 }, 19 },
-	{ {0x7c50d00a, 0x0d7b8c34, 0x74ed4924, 0x65a92622, 0xca160151 }, 19 },
-	{ {0xd2bf2769, 0x5023a3e7, 0xdaaeab1c, 0xb76572f2, 0xc412de1e }, 19 },
-	{ {0x5a709255, 0xf73eb8b6, 0x01bf9d81, 0x21026048, 0x8f8ac511 }, 19 },
-	{ {0x7abf8965, 0x2396a648, 0xa84ae06e, 0x6dabc097, 0x35a75798 }, 5 },
-	{ {0x176ec8e6, 0x5a9fdbf5, 0x9edc245b, 0x9e8388cc, 0x94195db9 }, 5 },
-	{ {0x7341efc0, 0x39394ec1, 0x59feebcf, 0xaa9d4a61, 0xebf08a18 }, 4 },
-	{ {0x0ec71916, 0x791e05d2, 0x07d7fe0a, 0x461a79a7, 0x6eab52c5 }, 4 },
-	{ {0xf924d89a, 0x28966a1d, 0x08c10d5d, 0xdbc9e0e1, 0x82be4669 }, 19 },
-	{ {0x428b5bdd, 0x5cbb3e4f, 0xf637cfa5, 0xdb8c41d8, 0xd0070813 }, 19 },
-	{ {0xde05494f, 0xae17c0a8, 0xc411cf0f, 0x782f00aa, 0x9209c34e }, 19 },
-	{ {0x336d714e, 0x3bc2dfe3, 0x626e55d0, 0x1ee4ef74, 0xa48cf652 }, 19 },
-	{ {0x917270dd, 0x44c63dc8, 0x83289b4e, 0x0902fe6c, 0x812f5ea3 }, 19 },
-	{ {0xc0717a98, 0x31d66e29, 0xeb907be5, 0x98ba6606, 0xe17ea044 }, 19 },
-	{ {0x4b565ee4, 0x4647923b, 0x349e6abb, 0x150a9c52, 0xf00722e4 }, 19 },
-	{ {0x17ac538d, 0xd63bc93e, 0xc0b88b6d, 0xd92079e8, 0x07c22908 }, 19 },
-	{ {0xaee97fa5, 0xe5ead1ff, 0x4f0bd4a7, 0x2872a929, 0x3e3fb536 }, 19 },
-	{ {0x7d0bb1da, 0xc966ceee, 0x2e4c53f7, 0x7e6e057d, 0x65f15d4d }, 39 },
-	{ {0x5720bf88, 0xea080ac5, 0x8e73ad11, 0xffa116cf, 0x29733d76 }, 19 },
-	{ {0xf364a44d, 0x0b4ceaaa, 0x87068302, 0x37c0b824, 0xdcf9ce0c }, 19 },
-	{ {0x8b2626f8, 0xdbbb3e97, 0xa5087b34, 0x0a3f3d56, 0xc8ee84d1 }, 19 },
-	{ {0x3d840685, 0xdaac4960, 0xce3a6d08, 0x50a49044, 0xbf44c607 }, 19 },
-	{ {0xe61f407e, 0x51ea4411, 0x145e2362, 0x72842bdb, 0x3e0743e6 }, 19 },
-	{ {0x6fefe304, 0xcc8cd099, 0x456bbbbb, 0xcb23ff77, 0x6cb113c9 }, 19 },
-	{ {0xe0d84b3b, 0x2ac7675c, 0x3ed10479, 0x7840d43b, 0xc2347a5b }, 19 },
-	{ {0xb6d39bba, 0xedb89f8c, 0x908cc2f4, 0x4a0ab17e, 0x4b80ca4f }, 19 },
-	{ {0x1f7b822b, 0x47430a3d, 0x817a21af, 0x2ab95c34, 0x14b328a6 }, 19 },
-	{ {0x1c238009, 0xe77c5536, 0xd0059631, 0x954c2c4a, 0x52527283 }, 3 },
-	{ {0xca45da2f, 0x9cd8edf4, 0xab04ffd5, 0x42b9c60e, 0xf6a9a254 }, 3 },
-	{ {0xaa6055ba, 0x0e433aa9, 0xc93df444, 0x4783cacb, 0x9628a7e2 }, 3 },
-	{ {0x7b8015f9, 0x19c8dd95, 0xdb683f3f, 0x3d0799cf, 0x7ef1bc22 }, 3 },
-	{ {0x9f2fb5f3, 0x1c2bcff9, 0x49e08449, 0xf197b0c3, 0x1bdebe50 }, 3 },
-	{ {0xb493dd7d, 0x082e25fc, 0x40ad1ccc, 0xc364e194, 0x5590a2f9 }, 3 },
-	{ {0x3ff276af, 0x654c7dc7, 0x12abed79, 0xd9123317, 0xce79b4e4 }, 3 },
-	{ {0x65160f0d, 0x59068dbb, 0xf76b11bc, 0x79e17a93, 0x69c8dcee }, 3 },
-	{ {0xb0378652, 0x8689b201, 0x4c90493f, 0x3e02d941, 0xc73122bc }, 19 },
-	{ {0x1dc5dfa6, 0xcd8d5548, 0x44f484a1, 0xb4e68071, 0x0c1b9515 }, 19 },
-	{ {0xbb422bc2, 0x72c72979, 0xb50e2c23, 0x11c649b5, 0x51c0fdfa }, 19 },
-	{ {0x80669b21, 0x72dbaa2d, 0x4f9d5485, 0xd41db699, 0x5ec4e123 }, 19 },
-	{ {0x17e78fd4, 0x05e65afa, 0x3763c2f7, 0x271c82ab, 0x155c004b }, 42 },
-	{ {0xb2d9dcee, 0x787ace26, 0xf8f4d2d1, 0x8e24a3d6, 0x45a6f853 }, 39 },
 	{ {0x4a7dc53f, 0x122dbe0c, 0xc6a29990, 0x2b0642c9, 0x6141e071 }, 19 },
-	{ {0xaadbd54e, 0xdd09d44e, 0xeee77fd0, 0x40039fab, 0xd3f9775b }, 19 },
-	{ {0xd1cf5410, 0xed71f776, 0x70f65eb0, 0x8ee94443, 0x6bc0eb10 }, 19 },
-	{ {0x33ec3136, 0xdfb6fd44, 0x014c8bbf, 0xfc8ac79c, 0x3cafe75c }, 19 },
-	{ {0x9255b2ac, 0x6d03fddf, 0x3df8880e, 0xc247dd34, 0x46e3209f }, 19 },
-	{ {0x4a185a3d, 0xb81c2ce2, 0x0d176d13, 0xfa5f619c, 0x6b7a170c }, 19 },
-	{ {0x14e7ef12, 0x5cc90200, 0x1995bbd8, 0xacca0eae, 0x2f213dc1 }, 19 },
-	{ {0xddc458bb, 0x3c70e070, 0x8841e516, 0xd9b89220, 0xc0e098a1 }, 19 },
-	{ {0x1b3059c7, 0x873765a4, 0x76fb7791, 0xa4d6fc84, 0x6ab05ade }, 19 },
-	{ {0xdd9d6ed4, 0x42122d14, 0x2987fd69, 0x1001efcc, 0x2bc18c7c }, 19 },
-	{ {0x9d8029aa, 0xfc4125af, 0x7f151f37, 0x79783899, 0x63432d49 }, 19 },
-	{ {0x4dd93490, 0x2907db50, 0xba76053f, 0x59ae7737, 0xd55824f4 }, 19 },
-	{ {0x1fb86115, 0x2a9f3f9c, 0x2b2dace2, 0x6d5f1d93, 0xab9b4ad8 }, 19 },
-	{ {0x7b6029bf, 0xd7cb4b9d, 0x4c5ec5b9, 0xb3e3c93d, 0x00558b5e }, 19 },
-	{ {0xb76f2e8d, 0xf68968e3, 0xaf8a10f7, 0xe5966448, 0xd6665cb6 }, 39 },
-	{ {0x40b26d9c, 0x745d81c1, 0xc33711c1, 0xe2747afe, 0x3ba2a779 }, 39 },
-	{ {0xb5d130a5, 0x0f693902, 0x8702c164, 0x5426a29e, 0xc8ead6e5 }, 19 },
-	{ {0xbd8227af, 0x9833b7c0, 0x2fa8ecff, 0x6416b7cb, 0x9e3e1de4 }, 19 },
-	{ {0x15ba1ffa, 0x2f557305, 0x92258c9f, 0xf4b2d6f9, 0x1c9ed0ba }, 19 },
-	{ {0x9e766243, 0xe681338b, 0xbb7d947e, 0x3ffc5f37, 0x3678ff4b }, 19 },
-	{ {0x01544042, 0xb810c0b4, 0x01fce5d1, 0x80adb6fe, 0xa9b5ed20 }, 19 },
-	{ {0x4cd78e26, 0x776b955e, 0xb27ac819, 0xc7eaf1f2, 0x645810ca }, 19 },
-	{ {0x5d8ee4d1, 0x6e388bb8, 0x647c671f, 0xbcf30f37, 0xcf8c30b1 }, 19 },
-	{ {0x7a8e82c1, 0x08b06855, 0xe39518b0, 0xf21269cb, 0xd041edf2 }, 19 },
-	{ {0x6af5044c, 0xcf48840d, 0xdd23fd07, 0xcbd3e230, 0xfa38fc8c }, 19 },
-	{ {0xdc69c7a9, 0xea93cbb0, 0x09330095, 0x5935ef15, 0x6af5c194 }, 19 },
-	{ {0xe9b36524, 0x82a5b09a, 0xe662203f, 0x8758a30a, 0xa23af62f }, 19 },
-	{ {0x4b168d75, 0x1cedf73f, 0x09ad6b7a, 0x7e4ce809, 0x880b10dd }, 19 },
-	{ {0x660db5d4, 0xb39de830, 0x8aac13be, 0x817a408f, 0xe3b52477 }, 19 },
-	{ {0x72783ba5, 0xa0b9f33b, 0x4573952a, 0x1c721fc5, 0xd5025fd5 }, 5 },
-	{ {0x168d59fc, 0xa3170f56, 0x858f39d0, 0xb53067c0, 0xc0d414a8 }, 3 },
-	{ {0xB00FDE74, 0x73740966, 0xC0713ED2, 0xE6043B2C, 0xD6D9262B }, 19 },
-	{ {0x158cc62b, 0x46b51016, 0x194176fd, 0x805e767c, 0x2ad3dc6c }, 19 },
-	{ {0x76d48849, 0x7d9ba54b, 0x302a4326, 0xf45909f6, 0x43bdcd7a }, 19 },
-	{ {0x85a3842e, 0xabac50c4, 0xe1332666, 0xc161541b, 0xe3508249 }, 19 },
-	{ {0xac150939, 0x558ec4e5, 0x6446be95, 0x02177f28, 0xa29881eb }, 19 },
-	{ {0xc1c350c7, 0x19236af5, 0xeef8798c, 0x4532351b, 0xefcfd348 }, 39 },
-	{ {0x473bc0ea, 0x85ed1b21, 0x8974796d, 0x819416e7, 0x11ac193f }, 5 },
-	{ {0xcc06d65a, 0x9aba634e, 0x3ad75675, 0xb9601409, 0x32506ffe }, 19 },
-	{ {0x35abd4a1, 0x40337107, 0x30da72ed, 0xf278aad4, 0x2d641621 }, 19 },
-	{ {0x3d107526, 0xc16ebbd4, 0x3bb0e9e5, 0xbe030531, 0xd5466ab0 }, 19 },
-	{ {0x299e52df, 0xbbb94ace, 0x4fd1ef59, 0xece45364, 0xce0bb450 }, 19 },
-	{ {0xd2aa1605, 0xa6b56c11, 0x8e18b385, 0xab879536, 0xd74cc355 }, 19 },
-	{ {0xc76ca96e, 0xd23621a6, 0x267d9906, 0xcc4a1ee4, 0x28677f98 }, 19 },
-	{ {0x556071f0, 0x3bfddef1, 0xbc84ae31, 0x1ba286ad, 0x849868ad }, 19 },
-	{ {0xa3a502af, 0xd3e65b16, 0x05260b37, 0x39b196f6, 0xfd0931e2 }, 19 },
-	{ {0x5d55fc27, 0x2184d160, 0xaf631885, 0x5c9d2f72, 0x8b3f25c0 }, 4 },
-	{ {0xd4edb2af, 0x4170fd40, 0x69960ad6, 0x1d3f6644, 0x62bef568 }, 19 },
-	{ {0x8557dcdb, 0x4cf1e151, 0x80d17acc, 0x8e6d515b, 0xf7bf7e7c }, 5 },
-	{ {0x7752b662, 0x4fb80d94, 0x99aaad28, 0xdd5776ec, 0x74565576 }, 5 },
-	{ {0xc2f4df1b, 0xd91f7dee, 0x1536774b, 0x9d708908, 0x6b9bf835 }, 5 },
-	{ {0x47663f88, 0x3f98ab9d, 0xdaa0bf0c, 0x2831c567, 0x919f56f1 }, 19 },
-	{ {0x2b80f46d, 0x1c40aede, 0x85a60e53, 0xddcfcc0c, 0xbb6d6d5b }, 19 },
-	{ {0x61d99816, 0x055858b3, 0xbcde3416, 0xeed30fd8, 0x6390393d }, 19 },
-	{ {0x08524fbe, 0xa5688512, 0x0124fbee, 0xb6e47bc0, 0x7aea4c30 }, 19 },
-	{ {0xca05a183, 0xf4e7e561, 0x02706d1b, 0x9b852ad4, 0x350264ba }, 39 },
-	{ {0x4c921e31, 0x137d1679, 0x76fb654e, 0x03d36ef1, 0x33701936 }, 19 },
-	{ {0x5dacde48, 0xfed402b1, 0xce9d0a41, 0xb2c12641, 0x7bf5436b }, 19 },
-	{ {0x32c06b62, 0x47a40863, 0x458481df, 0x60a81115, 0x51dbaefb }, 19 },
-	{ {0x0626bb3b, 0x5b230adc, 0x1faab9c8, 0x0cf4f33a, 0x539a82a7 }, 19 },
-	{ {0x20effe09, 0x3026e920, 0x9bd33271, 0x14e9ad51, 0x676cf807 }, 19 },
-	{ {0xbe42c55f, 0xfebc1aea, 0x52447512, 0x8cb687e2, 0xafe8e2e4 }, 19 },
-	{ {0x9e1633ec, 0x4492a01a, 0xd654d0a0, 0x8651daa5, 0xababd940 }, 19 },
-	{ {0x9f610356, 0x8e4c1122, 0x4932a223, 0xbfc86fa0, 0xc3eef021 }, 39 },
-	{ {0x20a2e3d7, 0x966916f4, 0x6eb26cc1, 0xaa226ec2, 0xd11646f9 }, 19 },
-	{ {0x85e3386d, 0x30dd9a64, 0xf4cc1bca, 0x03cff35b, 0x440f70b5 }, 39 },
-	{ {0x8c06d9e1, 0xe188431c, 0x13721af9, 0x65faa739, 0x1140af2e }, 19 },
-	{ {0xacc93f81, 0x8a9f2925, 0xbfcc61df, 0x7d9fe2e0, 0xcbc0a9ae }, 19 },
-	{ {0xd9195b9a, 0x24f6e7c5, 0xb99eca04, 0x6908915b, 0xfe369d46 }, 19 },
-	{ {0x05b8109f, 0x4f0a4d9c, 0x1bcb8379, 0x82abb573, 0x236be936 }, 19 },
-	{ {0xa39568be, 0x17b6ee5d, 0x10a61d82, 0xd8480cc8, 0x59be778a }, 19 },
-	{ {0xfb968a24, 0x07eee00c, 0x683af3ac, 0x19e88015, 0x341564ad }, 39 },
-	{ {0xb7fd07b7, 0x825c6bee, 0xb19b1f38, 0x631d2869, 0xf60939fb }, 19 },
-	{ {0xf8c69742, 0x60b4da94, 0x345295ee, 0xe27d97a3, 0x89abfe96 }, 19 },
-	{ {0xf6314590, 0x061a6b44, 0xc5ed24f6, 0x0ded13d8, 0xf2f7d95b }, 19 },
-	{ {0x223c1f5d, 0x38b54d4d, 0x5a589882, 0x23bb95df, 0x1998a620 }, 19 },
-	{ {0xd1ece8b5, 0xffeb9b99, 0x230e640a, 0xf32cb488, 0xfee51e35 }, 19 },
-	{ {0x58551545, 0xe73c838a, 0x2e995e69, 0x51ab644e, 0xd2590786 }, 19 },
-	{ {0xec1bb5c3, 0x6952b12e, 0x6c0805e9, 0xa8d5bf31, 0xc20a68c4 }, 5 },
-	{ {0xbc76a049, 0x70c547b7, 0xc080e747, 0xd393d13c, 0x87e82e7d }, 19 },
-	{ {0x88f3a725, 0x13b04459, 0x21228979, 0x7942c4d7, 0x6f495a05 }, 19 },
-	{ {0x5dd2ac08, 0xfd05a1e0, 0x91c7c6ec, 0xb6c10b49, 0x992bdd46 }, 19 },
-	{ {0x5b20c3e0, 0xb9f1f291, 0x49039d52, 0x46be881a, 0x6b0dfdb1 }, 19 },
-	{ {0x22f9b023, 0x8ff48840, 0xfb7d45ac, 0x93a7f154, 0x95393920 }, 17 },
+	{ {0x4a8eed64, 0x3993b86e, 0x71ea4609, 0x8a580ec1, 0x5038cbba }, 5 },
+	{ {0x4a92ec1b, 0xe15c45ee, 0x98c08ac9, 0x6191a369, 0xd562181b }, 19 },
+	{ {0x4a99f244, 0x4f29c2b6, 0x42efd6f0, 0x84081d6f, 0xd96bfa9b }, 42 },
+	{ {0x4ab3c16e, 0x32a3a0f4, 0x373e24cd, 0x47cd2805, 0x013f2f65 }, 19 },
+	{ {0x4ab7b203, 0x0d022f54, 0x86abaab2, 0x2aaeaf8a, 0xa23e05f3 }, 1 },
+	{ {0x4ac6a17c, 0x9c17bf6e, 0x9b149b72, 0x7663496b, 0xf1bf35b0 }, 19 },
+	{ {0x4ac9fc27, 0xa4a7b87e, 0x2c2347f5, 0xa420a6e8, 0x46555263 }, 19 },
+	{ {0x4ad170c5, 0xdfadc6a8, 0x11cd5b8d, 0xc4c99be6, 0x56ceff56 }, 19 },
+	{ {0x4ad4898d, 0xb3bdcf87, 0xb2acd575, 0x5e06d45c, 0x73d338cd }, 5 },
+	{ {0x4b04574b, 0x3b719586, 0x64ac7309, 0x87c4c8eb, 0xedeba890 }, 19 },
+	{ {0x4b0c1ded, 0xc44cd181, 0x3b274162, 0x093f713e, 0x895973c1 }, 19 },
 	{ {0x4b138e04, 0x19479903, 0x09c22889, 0x09146899, 0x08d46685 }, 17 },
-	{ {0x76b7a5e7, 0x5d5091f0, 0x482746e5, 0xa0c0a71d, 0xe07ddf83 }, 5 },
-	{ {0xce3f9356, 0xeaa5fd6c, 0x1b5ff1ad, 0xe244ebd9, 0x130f1ceb }, 5 },
-	{ {0xd8b93575, 0x7e77f071, 0x7559291e, 0x2abc7f7a, 0xd2e397ad }, 19 },
-	{ {0xfcc1cf81, 0x6657e90b, 0xb1e0a938, 0x98fd17a8, 0x325c2cd3 }, 19 },
-	{ {0x873bebca, 0x9668f0eb, 0xde02742a, 0xf9ebdcb9, 0x93c6791b }, 19 },
-	{ {0xcab996c6, 0xabc011b8, 0xc2abf3f3, 0xa7628437, 0xdd40deff }, 19 },
-	{ {0xc3f849c3, 0x42839fef, 0x2ef718b5, 0x115a90a3, 0x1e7db1f6 }, 19 },
-	{ {0x83fa6a78, 0x47faf14b, 0x6ebfae46, 0x37ac8868, 0xc869c7f5 }, 19 },
+	{ {0x4b168d75, 0x1cedf73f, 0x09ad6b7a, 0x7e4ce809, 0x880b10dd }, 19 },
+	{ {0x4b19979e, 0x01bab228, 0x9abb6034, 0xcb3c2d02, 0xc2e890d1 }, 19 },
+	{ {0x4b34bf7b, 0x950d9467, 0xbf701add, 0x259a3268, 0x6f283d24 }, 19 },
+	{ {0x4b4a58a3, 0x10a1138b, 0x95192d7f, 0xe0881bbd, 0xc45601d4 }, 19 },
+	{ {0x4b506234, 0xdfd3b6aa, 0x1c315b40, 0xcd8ddca0, 0x24dd15c9 }, 4 },
+	{ {0x4b565ee4, 0x4647923b, 0x349e6abb, 0x150a9c52, 0xf00722e4 }, 19 },
+	{ {0x4b614717, 0x2c12f74f, 0xe5b2386e, 0x6cc78ea0, 0xd763316a }, 19 },
+	{ {0x4b785147, 0x53008cab, 0xda2ff3d3, 0xcb537b24, 0x29efd7d2 }, 3 },
+	{ {0x4b84465c, 0x2faa802b, 0xfd5f7721, 0x18c4d31f, 0x993f29d0 }, 27 },
+	{ {0x4b872dac, 0x11a720e2, 0xb9e86f22, 0xdf1e2214, 0xc1059281 }, 4 },
+	{ {0x4B986D80, 0xFC0D4AD3, 0xB2E2D0FA, 0x77C743BB, 0x671BC5BB }, 19 },
+	{ {0x4b996bdd, 0xf88605c4, 0x32f73564, 0x922106a6, 0x3d31f62c }, 19 },
+	{ {0x4bd533cd, 0x7859489a, 0x3b26787f, 0xb5c7e4d8, 0x662cc420 }, 5 },
+	{ {0x4be8371f, 0x3b03e70d, 0xdaca4959, 0x58345f3c, 0x4f8e2d36 }, 1 },
+	{ {0x4c153759, 0x10461a7a, 0x34a2fd54, 0xc7f51e71, 0x2f06bc69 }, 3 },
+	{ {0x4c2a8cde, 0x9b40c493, 0x6f512365, 0xa7cd6c8c, 0xef92095e }, 4 },
+	{ {0x4c2f0156, 0x85a17db7, 0xa8c3893e, 0x868e0a84, 0xa8dbf1e5 }, 3 },
+	{ {0x4c44939a, 0x95a20d70, 0x1f608304, 0x99254e5d, 0xabedeeaa }, 5 },
+	{ {0x4c7dd442, 0x3ef40d5b, 0x929b3602, 0x60fc8675, 0x0abbe159 }, 19 },
+	{ {0x4c8a9766, 0x9017296c, 0x2360ff9d, 0x53694a29, 0x2197991e }, 19 },
+	{ {0x4c8ea05c, 0x09b40c41, 0x888fa18d, 0xb065575a, 0x317fda16 }, 1 },
+	{ {0x4c921e31, 0x137d1679, 0x76fb654e, 0x03d36ef1, 0x33701936 }, 19 },
+	{ {0x4cc5f197, 0xd2bd3f03, 0x06c07a88, 0x0590b4b4, 0xa5574e12 }, 5 },
+	{ {0x4cd78e26, 0x776b955e, 0xb27ac819, 0xc7eaf1f2, 0x645810ca }, 19 },
+	{ {0x4ce41fcc, 0x1a603411, 0xec4e9955, 0x6409c442, 0x078f0ecf }, 1 },
+	{ {0x4cede763, 0x79308294, 0x74e0bd2b, 0x640b328a, 0x41b51a5c }, 19 },
+	{ {0x4d51d3c5, 0x03631139, 0x2b173a57, 0x6bc7d91d, 0xc9fed6cb }, 4 },
+	{ {0x4d80fae5, 0x133d5550, 0x3968ee24, 0x6c1346cd, 0xdb020ffc }, 19 },
+	{ {0x4dad9de7, 0xc28b4523, 0x51cc1291, 0x0849b51b, 0xd9a37ab3 }, 1 },
+	{ {0x4db63ea4, 0x53df9d17, 0xcf84a0f9, 0x77f47684, 0x38ec9c45 }, 39 },
+	{ {0x4dd2ec21, 0x474720eb, 0x56f012bb, 0x761117b4, 0xd507f331 }, 19 },
+	{ {0x4dd93490, 0x2907db50, 0xba76053f, 0x59ae7737, 0xd55824f4 }, 19 },
+	{ {0x4e09d611, 0x62c3dd95, 0x7d59ece0, 0xaa5d7222, 0x294b5c5a }, 19 },
+	{ {0x4e17efbe, 0x87adc232, 0xc055d0dc, 0x26eb4476, 0xc661aafe }, 19 },
+	{ {0x4e3a48a1, 0xacddff21, 0x2807f80a, 0x67691085, 0x1e4aca02 }, 55 },
+	{ {0x4e4989c8, 0xf6336663, 0x690217f3, 0x2aca22a3, 0x19b90091 }, 19 },
+	{ {0x4e78689a, 0xddca0c49, 0xbefaeec2, 0x9d096e33, 0x1d4600b2 }, 19 },
+	{ {0x4e864cc0, 0x045c85c4, 0xf5c5c0ef, 0xcdf26340, 0xa178686a }, 3 },
+	{ {0x4e9384c9, 0xd137f0ab, 0x65ffc5a7, 0x8f04cd8c, 0x9df6c8b7 }, 42 },
+	{ {0x4edb5ed1, 0x2c1b9bc7, 0xefa571ca, 0x67ffc732, 0xf53d3a4a }, 17 },
+	{ {0x4ee3e785, 0xe6949bd5, 0x35804a32, 0xc6a1a31e, 0xeef30031 }, 4 },
+	{ {0x4ef4cd14, 0xa70e5eef, 0x213f8d70, 0x877dd394, 0xcb1999b1 }, 19 },
+	{ {0x4f0102cd, 0xc27216fd, 0x9bcdb966, 0x3db728d2, 0xccd8ca6d }, 1 },
+	{ {0x4f2a7e01, 0x72f0214f, 0x025f2384, 0x5f6e053d, 0x0ffd28e8 }, 1 },
+	{ {0x4f3114e9, 0x6d7b8929, 0x11e3dccf, 0x1eece712, 0xbe26f396 }, 1 },
+	{ {0x4f35f676, 0xd2f38207, 0x80783439, 0x21374c28, 0x89d06e11 }, 4 },
+	{ {0x4f36d139, 0xee4baa7d, 0x5980f765, 0xde989557, 0x0ee05f40 }, 19 },
+	{ {0x4f41f851, 0x24a682b0, 0x243e9d64, 0xa5f7f6a9, 0x9258ea20 }, 1 },
+	{ {0x4f6c94ce, 0xe6550b16, 0x19813eaa, 0xcd88af02, 0xebde51dc }, 19 },
+	{ {0x4f73ba24, 0x163946f6, 0x247523fc, 0x3f2aa5de, 0x00c3d7a6 }, 19 },
+	{ {0x4f73d4b7, 0x31b83091, 0x45b2a9bf, 0x9c37620e, 0x4f4a391c }, 19 },
+	{ {0x4f893002, 0xdbb9d456, 0xa16c7220, 0x6a2eedab, 0x2644936b }, 19 },
+	{ {0x4fa5382d, 0xf5a8ff7d, 0x631be22b, 0xb8445e7b, 0xc8018a11 }, 19 },
+	{ {0x4fd41171, 0xb6b43d51, 0x678590a5, 0x9f004b0b, 0x9121751e }, 19 },
+	{ {0x4fe1d66e, 0x8f3cbd5e, 0xcd9b22b6, 0xaea2b37a, 0x604f2492 }, 4 },
+	{ {0x4fe90868, 0x37670433, 0x6fbf4561, 0x9a47ce18, 0x736ff1b2 }, 19 },
+	{ {0x4ff12fc3, 0xadf389a1, 0xf76a7a9b, 0xab6b2fd2, 0x0044f5b4 }, 19 },
+	{ {0x4ff2aad8, 0x371e382e, 0x203c7f29, 0xb665612a, 0x8c9d937c }, 4 },
+	{ {0x5002ba59, 0x8469b34a, 0xf25bff50, 0x11ccc70e, 0xd3723b0d }, 19 },
+	{ {0x500d7a1d, 0x81621adf, 0x8c6914c6, 0xa42d65aa, 0x44ad4588 }, 3 },
+	{ {0x5017abec, 0xa8fbed43, 0xff2fd1a9, 0x36843acd, 0xc7192dcc }, 19 },
+	{ {0x5029cf47, 0x031b22bd, 0x5d1f68eb, 0xfd3be6d6, 0xda56dfe9 }, 1 },
+	{ {0x502d7cf7, 0xbc2595af, 0x6f83bb2b, 0x95baa4db, 0x5b0f6a4d }, 4 },
+	{ {0x503cbad7, 0x516c6fde, 0x89761388, 0xab32845f, 0x35284cc6 }, 19 },
+	{ {0x50422ba2, 0x4fd158ca, 0x5f0b9728, 0xb8e41829, 0x048cfdfd }, 6 },
+	{ {0x50439f12, 0xddff3ed4, 0x49da3cc1, 0x442385aa, 0xba609e7d }, 19 },
+	{ {0x50554269, 0x1f3d40ca, 0xcf7779e4, 0x22477172, 0x8c426059 }, 19 },
+	{ {0x50ae2f5e, 0xa4f03e71, 0xca49ca02, 0xb0a0cfaf, 0x4464286f }, 19 },
 	{ {0x50e27c5b, 0x83c8afe0, 0x0b077406, 0x081d0632, 0x63e98b62 }, 19 },
-	{ {0x7013fcf8, 0xc76bc610, 0xcec9f55f, 0xbb993741, 0x82641251 }, 19 },
-	{ {0xae52922a, 0x197a2f47, 0xc7fc4adf, 0x9dbfde13, 0xc136ed14 }, 19 },
-	{ {0xb7e279cd, 0x68faa5ae, 0xe4434480, 0xfeebdf18, 0x9fb54e73 }, 19 },
-	{ {0x371de6f1, 0x2d834da0, 0x7c8e67b1, 0x3e75fc22, 0x618ba5e9 }, 19 },
-	{ {0xac5639b8, 0xca66600e, 0x61452697, 0xed44b486, 0x07256065 }, 19 },
-	{ {0xec2f1e74, 0x7756ba1f, 0xdae60665, 0x8aeeafa0, 0x7e6e7fd4 }, 19 },
-	{ {0xc9d10b1d, 0xf3bcadb3, 0xd917cf2a, 0x6877ae6e, 0x71ca3a57 }, 19 },
-	{ {0xddc18248, 0x26d78e29, 0x261b30a6, 0x75bff986, 0x2f308392 }, 19 },
-	{ {0x7d566809, 0xea870ab6, 0x81680ba3, 0xdaa8946c, 0xfcb060e5 }, 19 },
-	{ {0x9dfc7188, 0x7ffc6d94, 0xb8780b5d, 0x6f207e24, 0xc1f58b54 }, 19 },
-	{ {0x62bfff23, 0xe2beae00, 0xdb14b6c3, 0xe9330432, 0x18b33ded }, 19 },
-	{ {0x152e4edc, 0x0cadeab7, 0x83f4724c, 0x6539875d, 0x9c6ca018 }, 19 },
-	{ {0x0125bce3, 0x73c95ee7, 0x8df074d1, 0x9ad03215, 0x8edc74a2 }, 19 },
-	{ {0x0ebd63dd, 0x4405bc14, 0x1ba3d170, 0x10d6d928, 0x979f19d5 }, 19 },
-	{ {0x049892d1, 0x633bcb3f, 0x1d5067ba, 0x710adeb8, 0x9b38fcac }, 19 },
-	{ {0xe6de8bbd, 0x60123444, 0xde2a9092, 0x8853985c, 0xeb0b4cbf }, 38 },
-	{ {0xbe7cfd5c, 0xa5d78b99, 0xc05dbda1, 0xe26f4afb, 0xddb50c48 }, 19 },
-	{ {0xce493944, 0xb6b57ffa, 0x56e7eb09, 0xdf76e73b, 0x65dcb800 }, 19 },
-	{ {0xaab3416a, 0xa54fa9b4, 0x9e98c828, 0x6ba6a8f5, 0x093545d9 }, 19 },
-	{ {0xaeecb99e, 0xd7bfe2ff, 0x39a5f426, 0x37b6b33e, 0xcc79c443 }, 19 },
-	{ {0x98e33dca, 0x445850cd, 0xf24f0905, 0x0756c3b7, 0x5202ac13 }, 19 },
-	{ {0x6511a7a1, 0xbf620f0b, 0x2d5e38e9, 0x54a01482, 0x8dfcda03 }, 19 },
-	{ {0x5dcecc7c, 0x790e398a, 0x1c652db5, 0x68c1e66c, 0x6f25e5e4 }, 19 },
-	{ {0x23b9dfdd, 0x7789fcca, 0x1fd2d395, 0xee9e3778, 0x07b76c9a }, 19 },
-	{ {0xa417d9e3, 0xfc22f409, 0x32d85ee0, 0x7fd7c365, 0x6b90894e }, 19 },
-	{ {0x244eae70, 0x5df950f6, 0x0b7d4b52, 0x3d57b9cf, 0xded96b8e }, 19 },
-	{ {0xfa4f31ba, 0x6d0d9ac8, 0x21592a8b, 0xb224dad3, 0x90fae0c4 }, 19 },
-	{ {0xc4c49d01, 0xeca572ce, 0x2e35d914, 0x53270f4d, 0x3e27152e }, 19 },
-	{ {0x5b53794d, 0x3d73df29, 0xcbcec411, 0xc0f65e9e, 0x9898977f }, 19 },
-	{ {0x366cc928, 0xa5dd5948, 0xbf6cf2ab, 0x1e00efcb, 0x2b6a8fd8 }, 19 },
-	{ {0x5971dd99, 0x06de38ff, 0x3668e9e0, 0x330008e2, 0x04f60f23 }, 19 },
-	{ {0x016c6316, 0x1d5112ef, 0x637d4892, 0x0a85001c, 0x9eb6a10f }, 19 },
-	{ {0x3c9301ee, 0xa142857e, 0xe5e9e04d, 0x0caebbc5, 0xa4245715 }, 19 },
-	{ {0x81c50af8, 0xef09e0b7, 0xa8a69fd4, 0x715592b5, 0xe803cdb5 }, 19 },
-	{ {0x6238f9c5, 0xf4c0012b, 0x3425be20, 0x3c23092f, 0x6b624fe8 }, 19 },
-	{ {0x6918679b, 0x2be2d014, 0xb60b4025, 0xa3877dee, 0x9ad5f407 }, 19 },
-	{ {0x41ba54c9, 0x45104915, 0xccc8d465, 0x930445c9, 0x05d839e4 }, 19 },
-	{ {0x3f4dd4b4, 0x59f12306, 0xfe368643, 0x44af0b35, 0xf8c5d3b4 }, 19 },
-	{ {0x56febd50, 0xbe4accb3, 0xeb8c73ff, 0x4ff641ea, 0x767108b3 }, 19 },
-	{ {0xa72724a7, 0x9c2c50ec, 0x66046c08, 0x28934b5c, 0xad11b7c9 }, 19 },
-	{ {0x61695eb1, 0xdc6242d8, 0xa70c7ef2, 0x172cf86a, 0x26e3c2dd }, 19 },
-	{ {0x66802dd9, 0x8370da80, 0x92503673, 0x65df234f, 0x9a6422b7 }, 6 },
-	{ {0x22e8e217, 0xe96cd822, 0x9462c58c, 0xa7ead1ae, 0x33088fc4 }, 19 },
-	{ {0xa2e14454, 0x6a191da8, 0x829b9ca9, 0xfa019884, 0xfe95156c }, 19 },
-	{ {0xcad65376, 0x6b597a4a, 0xa130a9a1, 0x956ece77, 0xba4d52bc }, 19 },
+	{ {0x50eafa5d, 0x735af5b3, 0x4d14f9f6, 0xb8c2d9cd, 0x2f0441db }, 39 },
+	{ {0x50efb704, 0x0339632c, 0xf8bddbc1, 0xd3eaae1f, 0xb2e2188f }, 5 },
+	{ {0x50f61894, 0xc2f519fa, 0x369d7b92, 0x5de7d52b, 0x708dde29 }, 19 },
+	{ {0x510f6d85, 0x4f813269, 0xf67ee15a, 0x4cc2ed77, 0xd96d2903 }, 5 },
+	{ {0x5118d6f1, 0xc1023706, 0x91903d07, 0x350d5090, 0x633589cd }, 19 },
+	{ {0x51a1467d, 0x73d26c91, 0xaab7923e, 0x3be66490, 0xdaaffdee }, 96 },
+	{ {0x51b24ab4, 0x846758a8, 0xb6dc6b15, 0xe21b0baa, 0x70c8a650 }, 55 },
+	{ {0x51e4231e, 0x245ffd73, 0x3590e320, 0x5fa3ffea, 0x92ad509f }, 5 },
+	{ {0x520739ca, 0xa1e0aac1, 0xb8eabc43, 0x05556aa7, 0x5f3f5a3b }, 3 },
+	{ {0x521928db, 0x7bc81a8d, 0xb4cac1e6, 0x66851e2b, 0xf01c8d53 }, 1 },
+	{ {0x522a5303, 0x4cf40448, 0xd441683f, 0x3308fcb4, 0xb65e6d7c }, 38 },
+	{ {0x523330d6, 0x09ca0e52, 0x7f3e28a0, 0x78635b3d, 0x28489ec9 }, 6 },
+	{ {0x5261006c, 0xa4245653, 0xf5153074, 0xdfcc8ca2, 0x7315bb59 }, 3 },
+	{ {0x52a9173b, 0x22c8a723, 0x76003764, 0xd73e0757, 0x9dc2015d }, 3 },
+	{ {0x52f95f6f, 0x4261be00, 0xae1b9caf, 0x88a05c02, 0x1c229e28 }, 19 },
+	{ {0x530ecff5, 0x42a537c3, 0x20b17bd5, 0xd64c86d5, 0xd65619f3 }, 19 },
+	{ {0x531a7f73, 0x6d86095d, 0x791d6d0f, 0x267be66e, 0xef07949c }, 19 },
+	{ {0x532037fd, 0x92f7f1d3, 0x4a477674, 0x16ce5c97, 0x9a0694ad }, 19 },
+	{ {0x5324e053, 0x709ff8da, 0x6c18ae4a, 0xfba6a2e0, 0xc3a722ba }, 19 },
+	{ {0x53337b61, 0xd7b86e6d, 0x18501967, 0xfcfc0908, 0xa00cc55c }, 19 },
+	{ {0x533dc6d2, 0x8ca60c09, 0x0740879d, 0xcb3cfa38, 0x6544ee45 }, 19 },
+	{ {0x5359c905, 0xad063a0f, 0xaf1c46a8, 0xc03b1b9c, 0x9a04b3b3 }, 19 },
+	{ {0x536e6ca8, 0xbaaa1925, 0x0b1272a7, 0x0b68dd11, 0xffc97047 }, 19 },
+	{ {0x5370b774, 0x61126211, 0x69d503bb, 0xec2e7fc5, 0x26279f53 }, 19 },
+	{ {0x5380e913, 0xd8dac234, 0x70446844, 0xcab21f69, 0x21101af8 }, 6 },
+	{ {0x53814fdf, 0xeacce237, 0xbb68fb90, 0x56d005eb, 0x614b708a }, 19 },
+	{ {0x538f4c85, 0x67bf5caf, 0xf65dc034, 0xda6cb89f, 0x8beeab62 }, 19 },
+	{ {0x5398bfcc, 0x6bf60d39, 0x3755a0ed, 0xc15f3b9c, 0x14180b47 }, 19 },
+	{ {0x53c6655b, 0x0ea7c071, 0x01018879, 0xf3bf60de, 0x071c247b }, 42 },
+	{ {0x53e1fb8e, 0xe77757cd, 0x20bf4c7a, 0xa4a5c6c7, 0x86c664d6 }, 3 },
+	{ {0x53ed25cf, 0x66a6ed4b, 0x432fa7e4, 0xf10a6730, 0xce6923be }, 19 },
+	{ {0x54008fe7, 0xcd7f1a47, 0xfca70462, 0xa0a7b568, 0x2146099b }, 19 },
+	{ {0x5400c0c9, 0x29b31a70, 0xe76aac67, 0x6b91d404, 0x45f1b427 }, 19 },
+	{ {0x5460a88c, 0x25386b1b, 0x950b57fc, 0x1325fd75, 0x587cc825 }, 4 },
+	{ {0x5460aa3b, 0xe896ad94, 0x9bea7544, 0x4bc6e7e0, 0x72a859b8 }, 19 },
+	{ {0x546aaf36, 0xee78717f, 0xe0612518, 0x5f0d420f, 0xdff0d34c }, 19 },
+	{ {0x54a1d356, 0xfd7bc609, 0x8f5c3d94, 0xf9d8bfcc, 0x2c6d5935 }, 3 },
+	{ {0x54a49a3c, 0x8b42b8b2, 0x46e62ed4, 0x5346cf52, 0x836ddcac }, 19 },
+	{ {0x54b05b9c, 0x064232d7, 0x5299fd31, 0xb53335f5, 0x30c20aea }, 4 },
+	{ {0x54f28859, 0x0f0c882f, 0x6e3a9b7c, 0x3f7d15b4, 0x07190975 }, 19 },
+	{ {0x54f91914, 0x8673fa54, 0x0f987e6d, 0xb85d85ba, 0xa45bd17b }, 21 },
+	{ {0x5503d23f, 0xaf94f076, 0x410d252f, 0x69f6bf5e, 0xce4da292 }, 19 },
+	{ {0x55183b7b, 0x7df66950, 0xdbb65ef1, 0x065d7d98, 0x7e0fdf5a }, 6 },
+	{ {0x552a758f, 0x77a7c359, 0x69523dba, 0xca74587f, 0x0b59eb2b }, 4 },
+	{ {0x553ed3a8, 0x577f25b6, 0xee884ba7, 0x8fba5454, 0xdd5cac36 }, 19 },
 	{ {0x5558ba63, 0x4018b22d, 0xcc687a01, 0xf9422fe6, 0x0ea57adc }, 19 },
-	{ {0x9ab584be, 0x0a054e76, 0xd345ca93, 0x7917f1ea, 0x195f7967 }, 39 },
-	{ {0x80c82bb4, 0x010476a6, 0x79cb616a, 0xc31fc691, 0xb8e8a526 }, 42 },
-	{ {0xdf13ed64, 0x7ed4f5a6, 0xb04f1710, 0xfc1140ea, 0x65dc966f }, 39 },
-	{ {0x27bc8095, 0x18fbb6c0, 0xd52c949e, 0x7cbe8198, 0x0a801d32 }, 39 },
-	{ {0xdc6437a5, 0xd52f77f5, 0x24198b9d, 0x539b34de, 0xc6122854 }, 42 },
-	{ {0xb5414e11, 0xb227c3c8, 0x28ee1de2, 0x06bf2d8f, 0x14486bd4 }, 42 },
-	{ {0x98df3e94, 0xd3bbef5d, 0x18095b62, 0xe65274eb, 0xfa8d527c }, 42 },
-	{ {0x58747cf7, 0x6b7c2785, 0xdd70409b, 0xe5d912ea, 0xfa328616 }, 42 },
-	{ {0x479608b5, 0xa86d7c77, 0xbd6c4dd0, 0x0605b8ef, 0xb2e5b43e }, 19 },
-	{ {0xcda2df54, 0x006d9889, 0x0feb1aac, 0x1dd955d0, 0x458132a4 }, 19 },
-	{ {0xf0b65b71, 0xc505c680, 0x19e2285d, 0x3b8afcf0, 0x68a74b9f }, 19 },
-	{ {0x0b02dda5, 0x316a318a, 0x7f75a811, 0xaa54200d, 0xdd7abc30 }, 5 },
-	{ {0x7c066cb7, 0x63f7a4fe, 0xc0474b5a, 0x09e3ef43, 0xbbf9248b }, 5 },
+	{ {0x556071f0, 0x3bfddef1, 0xbc84ae31, 0x1ba286ad, 0x849868ad }, 19 },
+	{ {0x5577e483, 0xcaca553c, 0xfbfc0cba, 0x26f3ab24, 0x44569f81 }, 5 },
+	{ {0x5586085d, 0x3be79378, 0xf9623e52, 0xfd04cad2, 0x5febc34b }, 19 },
+	{ {0x558b7383, 0x544542cf, 0x7333700f, 0xf90c3efb, 0xf93ba2a3 }, 42 },
 	{ {0x55adf3b4, 0x576b370d, 0xd2680d80, 0xc333ebde, 0x00000000 }, 5 },
-	{ {0x2220363a, 0xe56ef707, 0xab2471fc, 0xdb36f481, 0x6ad1d32c }, 3 },
-	{ {0x75d3b72d, 0x9ceeaa55, 0xc76223d9, 0x35629a30, 0xae4124d6 }, 3 },
-	{ {0xee66334f, 0xbac1c926, 0xed05c1c3, 0xf38df392, 0x0f501fe6 }, 3 },
-	{ {0x2111cec4, 0xb5ea698d, 0x772bb806, 0x64f6be69, 0x0b47391c }, 3 },
-	{ {0x04e4eb1c, 0xae7cf379, 0x977d238b, 0x74d727bb, 0x929c8d23 }, 3 },
-	{ {0xf1de76df, 0xcd8c4e35, 0x4a8a8058, 0xa7619116, 0x7fd112e3 }, 3 },
-	{ {0x9ce36aea, 0xa93f969b, 0x6c2ea915, 0x98b0b014, 0x00000000 }, 3 },
-	{ {0x240a23b6, 0x3e901b98, 0x8951dda1, 0xded561c2, 0x81ccbbc1 }, 3 },
-	{ {0xa6b2fdae, 0x9551ef36, 0x33926f61, 0x77c771d7, 0x94d1e91b }, 39 },
-	{ {0xaeb705ac, 0x42f8d9d6, 0x2ecdb258, 0x99535d1f, 0x14f1c49c }, 39 },
-	{ {0x8117ec66, 0xc0645a54, 0x422841a6, 0x32cfd660, 0x2f35c4f9 }, 19 },
-	{ {0x0486938b, 0x52fbcf30, 0xa4fa206e, 0x07960a5b, 0x866fca61 }, 19 },
-	{ {0x5f965bbb, 0xa0261348, 0x18759d25, 0x119d4114, 0x599132a8 }, 19 },
-	{ {0x536e6ca8, 0xbaaa1925, 0x0b1272a7, 0x0b68dd11, 0xffc97047 }, 19 },
-	{ {0xd92c82e1, 0x55cb34f6, 0x5587d472, 0xd4eb5ed1, 0xb9e68018 }, 19 },
-	{ {0xa0b45f20, 0x8df3091e, 0x461e15f6, 0x182896d2, 0x716c2a11 }, 19 },
-	{ {0x190bcab0, 0x325ded99, 0xf42f3297, 0x6bf965f0, 0x164ad2a4 }, 19 },
-	{ {0x37e6fe7d, 0x07b3f8b2, 0xc585c77b, 0x231207ac, 0x8baa1ea3 }, 19 },
-	{ {0x295578c0, 0x6ff3f451, 0xf5203fc4, 0x67a191c9, 0xea335952 }, 19 },
-	{ {0x058af007, 0x9b868387, 0xad39c6b8, 0xa390b18b, 0x936d0e48 }, 19 },
-	{ {0xbfa533c5, 0x39035345, 0xcee719b4, 0xbbc7b309, 0x89e97372 }, 19 },
-	{ {0x8c218c31, 0x7e1e213e, 0x1c5e9439, 0x87092900, 0x9d645a47 }, 5 },
-	{ {0xa2d2e98f, 0x68042b32, 0xf3225b58, 0xc9989529, 0xd5efacdc }, 19 },
-	{ {0x688564be, 0xdfd71343, 0x2350d7ae, 0xe3fbd7a7, 0xfc8691d1 }, 19 },
-	{ {0x86231b60, 0x4338a9b4, 0xc63be995, 0xadb2fd98, 0x60bab20b }, 19 },
-	{ {0x5aab6813, 0x34f9e97f, 0xe8d7e0eb, 0x008b2afd, 0x5e0fc3ac }, 19 },
-	{ {0x6c0d3a55, 0xf9e8e9c2, 0x74413d06, 0xf4729bc5, 0x17f77ff5 }, 19 },
-	{ {0x08691564, 0x5d703f20, 0x274aac73, 0x07f61f73, 0xcc56545c }, 19 },
-	{ {0x479100e8, 0x2d3f25bb, 0xeb9a2911, 0x63945d2f, 0x5bd62f74 }, 19 },
-	{ {0xbf041bc8, 0xce3b5dab, 0x7b1f85f6, 0x23b371b2, 0x63639aab }, 19 },
+	{ {0x55bad6c0, 0x0e6a676e, 0xfc7ff349, 0xfa1b5422, 0xd624f5ef }, 4 },
+	{ {0x55cc5074, 0x0d68d255, 0x8351cd8d, 0x125821dd, 0x1be70a1c }, 19 },
+	{ {0x55ed66ad, 0xa5d82039, 0x37554538, 0xb485fbe0, 0x27a2e2bb }, 19 },
+	{ {0x55f30c8b, 0x71188708, 0x02d00db8, 0x60bc1945, 0xf18a42c0 }, 19 },
+	{ {0x55fb4e3d, 0x3a762b61, 0x3b635ee9, 0x745d92f0, 0xf3711272 }, 5 },
+	{ {0x5628514e, 0x2488ccb1, 0x5ae464e7, 0xf210dcab, 0xbb782b91 }, 19 },
+	{ {0x5692e41b, 0x3a4c5e76, 0x7cf290fd, 0x6c24942d, 0x0fd7b2e3 }, 3 },
+	{ {0x56c4813a, 0xc549af87, 0x11b2e2e4, 0x2d7db1b9, 0x60c4c040 }, 19 },
+	{ {0x56febd50, 0xbe4accb3, 0xeb8c73ff, 0x4ff641ea, 0x767108b3 }, 19 },
+	{ {0x57034994, 0x710a9d74, 0x4c768493, 0x679b78ca, 0x06b9dc8d }, 19 },
+	{ {0x5720bf88, 0xea080ac5, 0x8e73ad11, 0xffa116cf, 0x29733d76 }, 19 },
+	{ {0x57827f8d, 0x49369e4d, 0xbf20a968, 0xe535374d, 0x35ff1648 }, 19 },
+	{ {0x5795c5f9, 0xbc8af39e, 0xa5b947bf, 0x25bda019, 0x2dcca89d }, 19 },
+	{ {0x57a39f69, 0x47d1f871, 0x07961cd5, 0x7ee6a520, 0x27d5c612 }, 19 },
+	{ {0x58132c6f, 0xf44095b1, 0x598f267b, 0x2bdca432, 0xd3178ec9 }, 55 },
+	{ {0x583b223c, 0x0b2ca91a, 0xe6da16ce, 0xd34ea3cd, 0x500ad54d }, 19 },
 	{ {0x58530a50, 0x80aa54ae, 0xd05e3b98, 0xed104a1b, 0x4c9278ea }, 19 },
-	{ {0x5f805a67, 0x0e31b227, 0x23aa7738, 0xaa3edc3f, 0xdbd8f870 }, 19 },
-	{ {0x7ec25356, 0xabf37208, 0x06b2b97c, 0xbabdc1f1, 0x9ed698f8 }, 19 },
-	{ {0x7033c47a, 0x3b20fd04, 0x054ef37d, 0x209e1545, 0xac053865 }, 19 },
-	{ {0xe59d739e, 0xcd56a11e, 0xcf402043, 0x0585ea4c, 0xc61b02a6 }, 19 },
-	{ {0xc10d2a3d, 0xc77816cf, 0xb5b5d4b9, 0x83323284, 0xf4a4aef5 }, 19 },
-	{ {0x390fb09a, 0x9d944d1d, 0x17c328ae, 0x13832575, 0x1d1b4203 }, 3 },
-	{ {0x68347886, 0x8f6c6423, 0xcc3e9c6a, 0xabe1868b, 0x30b1e47d }, 19 },
-	{ {0x1449f9b1, 0xf8891378, 0x31089ddc, 0x73e04b8c, 0x6b5a56ee }, 19 },
+	{ {0x58551545, 0xe73c838a, 0x2e995e69, 0x51ab644e, 0xd2590786 }, 19 },
+	{ {0x58747cf7, 0x6b7c2785, 0xdd70409b, 0xe5d912ea, 0xfa328616 }, 42 },
+	{ {0x58ac78bb, 0xa29a0664, 0x5ca8d6a9, 0x4ef2ac68, 0xb743ad32 }, 65 },
+	{ {0x58accf41, 0xa9069387, 0x4b86ce98, 0xd8d43c27, 0xbeb8b6dc }, 42 },
+	{ {0x58b3b3a6, 0x78364d06, 0x49c1af0c, 0x27da144c, 0xfee85146 }, 19 },
+	{ {0x58ba1887, 0xe8fd21c9, 0x12b6859c, 0xae6514bd, 0x874ffcca }, 65 },
+	{ {0x58e335c9, 0x43d2647c, 0x3ff1e689, 0x069d9fa5, 0xe1c7ff6e }, 19 },
+	{ {0x58fc860e, 0xb4e5c33b, 0x22d29a4a, 0x39650aea, 0x0f327b1e }, 19 },
+	{ {0x5925e88d, 0xf896104e, 0x25fc6941, 0xfcb7925a, 0xc7a277b3 }, 19 },
+	{ {0x595ed23f, 0x45a83827, 0x39a3b865, 0xe153583f, 0x41f4ead7 }, 19 },
+	{ {0x59679b1e, 0xd40416f4, 0xc8d65085, 0xe5473c62, 0x1bea6ac4 }, 19 },
+	{ {0x5971dd99, 0x06de38ff, 0x3668e9e0, 0x330008e2, 0x04f60f23 }, 19 },
+	{ {0x598eb258, 0xcbe532e9, 0x8b4a3c8d, 0x87ecd953, 0x6d09ce56 }, 4 },
+	{ {0x59967765, 0xd6e93289, 0x09dee4da, 0xc1cbe4cf, 0x9d47d315 }, 1 },
+	{ {0x5999cc14, 0x07afe5ba, 0x8a760f16, 0x178c4cac, 0x9c3fa192 }, 19 },
+	{ {0x599c824e, 0xc92be036, 0x9accaaaf, 0x31340df6, 0xf471f202 }, 5 },
+	{ {0x59a124ed, 0x38869892, 0x496fc12f, 0x14af404a, 0x422e162a }, 19 },
+	{ {0x59bc608b, 0x1cb5bde2, 0x230bca0e, 0xb045cd6c, 0x58650774 }, 19 },
+	{ {0x59e35d24, 0xab5f8e3b, 0x812ba4a1, 0xa4feb5be, 0x1ab269fe }, 3 },
+	{ {0x59f679c5, 0xebf75de9, 0x8b5e909d, 0xa9182dbd, 0x80413364 }, 5 },
+	{ {0x5a12439f, 0x74ca5d1c, 0x2664f01f, 0xf6a8302d, 0x3ce907a8 }, 5 },
+	{ {0x5a4e7dbb, 0xfb759109, 0xc7d2a3b3, 0x8bda9c60, 0xbf6ffef5 }, 65 },
+	{ {0x5a709255, 0xf73eb8b6, 0x01bf9d81, 0x21026048, 0x8f8ac511 }, 19 },
+	{ {0x5a936427, 0x1ddca520, 0x8b625c89, 0x1f01a89f, 0xd2367a8d }, 19 },
+	{ {0x5aab6813, 0x34f9e97f, 0xe8d7e0eb, 0x008b2afd, 0x5e0fc3ac }, 19 },
+	{ {0x5ad0ba43, 0x4407a7ee, 0xecb597b3, 0xd20bcfc6, 0xfe05c319 }, 19 },
+	{ {0x5aff2d9b, 0x6efc723b, 0xc395b0f9, 0x6f0adfa8, 0x3cc54a49 }, 24 },
+	{ {0x5b17cb69, 0x697cf55d, 0xff1f0b87, 0x77e19d5a, 0xbc1771fc }, 19 },
+	{ {0x5b20c3e0, 0xb9f1f291, 0x49039d52, 0x46be881a, 0x6b0dfdb1 }, 19 },
 	{ {0x5b25d932, 0x59a358f2, 0x064adc44, 0xf6382c91, 0xc9394861 }, 5 },
-	{ {0x663d12f6, 0xfed3ce50, 0x17b783db, 0x3032eb69, 0xd8554fed }, 19 },
-	{ {0x336a7c45, 0x1a03c9a5, 0x5726d171, 0x603b5462, 0x8ad832c8 }, 19 },
-	{ {0x9c9da64f, 0x7b0ad20b, 0x0d699bbb, 0x254ae206, 0x66867176 }, 19 },
-	{ {0x27e56fbe, 0xc7fa39ce, 0x19d045b0, 0xdbc4217d, 0x290f92e2 }, 19 },
-	{ {0x4a28e8bc, 0x5ff7b57c, 0x63ce8109, 0x72c3ffc2, 0x683ee3d4 }, 19 },
-	{ {0xc95f8edb, 0x24edca9f, 0x5d38c26d, 0x0e8a34c6, 0xb61efb0c }, 6 },
-	{ {0x91bd6c21, 0x530654fa, 0xb12cd8a7, 0x97044d49, 0x4834c223 }, 19 },
-	{ {0x211e1f7e, 0x86495178, 0xfb2b05e1, 0x63b04ed4, 0xb7455034 }, 19 },
-	{ {0x878554d3, 0xb579e72b, 0x2d3c22e6, 0x330208ee, 0x0d1ee8a6 }, 19 },
-	{ {0xc69c5b26, 0xeb3fb5e1, 0x03a887c9, 0x6e702ea4, 0xacafb75a }, 19 },
-	{ {0x1fbd7af2, 0x3177ab1d, 0xe799764d, 0x8a26bc2b, 0xbf85b042 }, 19 },
-	{ {0xa4f15647, 0xa4e50f1c, 0xa7777604, 0xdf07267d, 0xbaa8e12c }, 42 },
-	{ {0xbe8bb7f5, 0xe812cd31, 0xa65aec37, 0x82a2d526, 0xbef9b3d6 }, 19 },
-	{ {0x10e63eba, 0x7d2b10d9, 0x46822f21, 0xe7fd106f, 0x5dfab632 }, 19 },
-	{ {0x462bbe53, 0x5702c52a, 0x7905ad9c, 0x6bcf9303, 0x2214eae2 }, 19 },
-	{ {0xb084a949, 0x23ce948c, 0xb39dc186, 0xd83015f7, 0x487cfbe4 }, 19 },
-	{ {0x0a9c576e, 0xabaf2651, 0xddca35bf, 0x17f96e50, 0x9d6c6ba0 }, 19 },
-	{ {0xd621e2a2, 0xf0f924a1, 0x7673f5d4, 0x7f218209, 0x5074acf4 }, 19 },
-	{ {0xcf8e4031, 0x5f34e30e, 0x1be4776b, 0xbebc08c0, 0xa8403523 }, 19 },
-	{ {0xb1e6299c, 0x4711d2f5, 0x71b72f11, 0xd3b1aeb2, 0x3eb99b64 }, 19 },
-	{ {0x416d9774, 0x1622ff3f, 0xfab2da50, 0x21a3bde3, 0xbbc07061 }, 19 },
-	{ {0x8927b9aa, 0x770195f2, 0x55e4e0e1, 0x43f89bfe, 0x93353022 }, 56 },
-	{ {0x9293403c, 0x3811b667, 0xd21408f4, 0xd670b213, 0x73ea333e }, 56 },
-	{ {0x78079266, 0x711e6042, 0x0480e4d9, 0x5a39f0d7, 0xd974ad32 }, 19 },
-	{ {0x02943609, 0x157b14cb, 0x036c1338, 0x8093af7d, 0xe0033b48 }, 19 },
-	{ {0xae8c7355, 0xc8292483, 0x05384243, 0xf78a8704, 0x53367e77 }, 19 },
-	{ {0xf9a8731b, 0x7b978b6e, 0xb5310aa9, 0xbf644fae, 0x5a9015b3 }, 19 },
-	{ {0xb88e9c54, 0x8873dcfd, 0x190e0e38, 0xf7b27934, 0x4eea41ec }, 19 },
-	{ {0x2fa9c0f0, 0x16efc2d1, 0x752a272c, 0x632393f5, 0x063ea06c }, 19 },
-	{ {0x5fb4b6c3, 0x735e4d94, 0x15565a85, 0x6bb69f9f, 0xb4857161 }, 19 },
-	{ {0x744c92e3, 0xe861a9f6, 0x41da2710, 0x302b96b0, 0xa26c8dc0 }, 19 },
-	{ {0x8161d9b3, 0x25c708af, 0x463c5622, 0xbd89ca94, 0x754cfdef }, 19 },
-	{ {0xe6fbfb4b, 0x10dc3939, 0x53211dda, 0x4b114080, 0xa08302a1 }, 109 },
-	{ {0x23a05191, 0x10245957, 0x9aee8af4, 0x527d6998, 0x912f0f80 }, 39 },
-	{ {0x788ce4ba, 0x8d7e881d, 0xd2d3cc69, 0x7c2dd88f, 0x44e27798 }, 39 },
-	{ {0x08d5a55b, 0x80726fb9, 0xc793be20, 0xe36f6d88, 0xbeb643a6 }, 19 },
-	{ {0x2d09b2ea, 0x90ad0cb0, 0xda104293, 0xd9962356, 0x9c33b86a }, 19 },
-	{ {0x31706b3f, 0xc6cf6ab1, 0xd2e3670d, 0xdead5645, 0x64e96c45 }, 19 },
-	{ {0x85d305e3, 0xe5d06542, 0x7b8eda98, 0x6736b19f, 0x930abfd8 }, 19 },
-	{ {0x6f247c8a, 0xf6fc1881, 0x242281f1, 0x9912068b, 0x03ca4126 }, 19 },
-	{ {0xcdaf507d, 0xba4a48b5, 0xc98850a9, 0x6f61f6d2, 0xe8464e00 }, 19 },
-	{ {0x835b3e2b, 0xae1d680d, 0x7050ce18, 0x8c617fbc, 0xfb326eb3 }, 19 },
-	{ {0x692a5539, 0x3e8eef08, 0x00a612c0, 0x1456e9ce, 0xcd9c1418 }, 19 },
+	{ {0x5b33d3f8, 0x32acd6aa, 0x44a48232, 0xa9e4ff66, 0xfe63c8d5 }, 19 },
+	{ {0x5b39c1cc, 0xd3a213b7, 0x8e02927f, 0x56a9abc7, 0x2cd8c28d }, 141 },
+	{ {0x5b53794d, 0x3d73df29, 0xcbcec411, 0xc0f65e9e, 0x9898977f }, 19 },
+	{ {0x5bbcbd47, 0xf05a2742, 0xcfb0cad8, 0x8856eb2d, 0xf6e469fe }, 19 },
+	{ {0x5bd09e5a, 0x9669c583, 0x65c87f32, 0xa0e9a8e5, 0x9680d5c9 }, 19 },
+	{ {0x5be82c29, 0x7566b3e0, 0x8fa1fe25, 0x34be06ca, 0x2f95d565 }, 19 },
+	{ {0x5bff56d5, 0x671d1131, 0x05645102, 0x5b20c1ce, 0x192e279b }, 19 },
+	{ {0x5c00f9e3, 0xa48411e0, 0x8fac89b1, 0xdfdd2a6e, 0x95853919 }, 7 },
+	{ {0x5c1f9c7f, 0xb655e43d, 0x38e5dd1f, 0xcc6b942b, 0x2ff68b02 }, 1 },
+	{ {0x5c278deb, 0x1390eb45, 0xc79b7667, 0xb1ea1c54, 0x183123ac }, 5 },
+	{ {0x5c3ccb16, 0x81fbf63e, 0xbe318d05, 0x616eebac, 0xe91b5ed9 }, 39 },
+	{ {0x5c463dd9, 0x90582e67, 0x7c8206f6, 0x1035a7c5, 0x4d8c67f0 }, 1 },
 	{ {0x5c572daa, 0x07f588e3, 0x5bfa8be1, 0xa8d64caa, 0x73bfab5a }, 19 },
-	{ {0xc713ecd0, 0xe2ef89b2, 0x443e516d, 0x5ffa53d3, 0xa3422e22 }, 19 },
-	{ {0xb8f9248a, 0x6f2bc02e, 0xd2dcae3f, 0x21d6fe0e, 0x572e23fe }, 19 },
-	{ {0x583b223c, 0x0b2ca91a, 0xe6da16ce, 0xd34ea3cd, 0x500ad54d }, 19 },
-	{ {0xe9c35caa, 0x8544f81d, 0x927cb610, 0xe850085e, 0x5d81ceca }, 19 },
-	{ {0xac109dac, 0x24df4dae, 0x813ca5d9, 0xf0938cc4, 0x8a162bb1 }, 6 },
-	{ {0x24c5cbf1, 0xee4caa6d, 0x83a5aa7a, 0x5f381869, 0x2542fda8 }, 19 },
-	{ {0xda5fd6ce, 0x2f92a40b, 0x1ccaf6e3, 0xc425d720, 0xfebc3543 }, 19 },
-	{ {0x6589782C, 0x0AA43F6C, 0x7DA6D92E, 0x9B2F8BA4, 0x632E1D1D }, 19 },
-	{ {0x17bbed84, 0x6045f332, 0x5b1d34c6, 0x86d35889, 0xf9efe157 }, 19 },
-	{ {0xd03fdca5, 0x7b55bdb7, 0xe6b54816, 0x15b8ad0c, 0x8a71f77d }, 19 },
-	{ {0x5795c5f9, 0xbc8af39e, 0xa5b947bf, 0x25bda019, 0x2dcca89d }, 19 },
-	{ {0xb186d547, 0xc0b79612, 0xbffb63dd, 0x49c3230f, 0x156c2bbe }, 19 },
-	{ {0xfc4c05ca, 0x47c94df8, 0x77bed2e0, 0x2307bd63, 0x07f738a6 }, 19 },
-	{ {0xc2a1ea76, 0xf3e3517f, 0x9952e495, 0x395b8fcc, 0x820c7420 }, 19 },
-	{ {0x9c26a5a8, 0x9f543050, 0xdb2d614f, 0x8405c659, 0xf5baae08 }, 19 },
-	{ {0xc80228bd, 0x14f149db, 0xccf57bf9, 0xc00f34a4, 0xdf953d85 }, 19 },
-	{ {0xf6eb3444, 0x08fbf693, 0x32fdf865, 0xa8c21345, 0x5f0a024c }, 19 },
-	{ {0xf36af9ea, 0x08780ebf, 0xb194337c, 0xcc869aeb, 0xab65ac66 }, 19 },
-	{ {0xfae43707, 0x2234c65b, 0xca174db9, 0xaefd2107, 0xa53c358a }, 19 },
-	{ {0x16c692a2, 0xc9babfda, 0xdd8408d2, 0xf0f8fae3, 0xa8d96fd5 }, 5 },
-	{ {0xeb5ed1fd, 0x10bbdd68, 0x53f595f7, 0x48f92841, 0xde3f55f9 }, 19 },
-	{ {0xdcfd6739, 0x26a1c10c, 0xf4bada73, 0x1d072d3f, 0x6ce29c44 }, 19 },
-	{ {0x3b9df9bf, 0x57ac9d8f, 0x155c623c, 0x8ed6057a, 0x79491738 }, 19 },
-	{ {0x0dfe92b4, 0x8e99bed4, 0xcd879e40, 0x26d036f9, 0x4c826ce8 }, 19 },
-	{ {0x4e864cc0, 0x045c85c4, 0xf5c5c0ef, 0xcdf26340, 0xa178686a }, 3 },
-	{ {0xa36c00f3, 0x2cad6b60, 0x3bc5525a, 0x741cb090, 0x64670f34 }, 19 },
-	{ {0x1eb9f2bd, 0x558dd8ec, 0xafcde3ce, 0x61881bfa, 0x27f70f1f }, 39 },
-	{ {0x2164c6ee, 0x1819f7fe, 0x763dbcc9, 0xef366b62, 0xbf04aec6 }, 39 },
-	{ {0x681c30c7, 0x539ec738, 0xbe2e36dd, 0xca408eed, 0x392f3b6d }, 39 },
-	{ {0x1ad2178c, 0x27874704, 0xb395ab25, 0x0200d9ac, 0xb7d3de9c }, 19 },
-	{ {0xe35c48aa, 0xe9aed93a, 0x114a28ee, 0x90f8f20f, 0xced3587b }, 19 },
-	{ {0x2e16a588, 0x246743c9, 0xb901afdb, 0xf1ba094a, 0x0b1c8b5d }, 19 },
-	{ {0x531a7f73, 0x6d86095d, 0x791d6d0f, 0x267be66e, 0xef07949c }, 19 },
-	{ {0x6f177419, 0x5b8db0ba, 0x34af5e16, 0xef94700d, 0x1714e011 }, 19 },
-	{ {0xd5674f02, 0x17031d4b, 0xfab9c533, 0x93c18036, 0xa9707b72 }, 19 },
-	{ {0xbe9d337d, 0xd412056f, 0x5fe78fd1, 0x9467a63e, 0x80e3864c }, 19 },
-	{ {0x1f72e0cd, 0x58afe220, 0x75a129ac, 0x854bbdce, 0x0704b0c8 }, 19 },
-	{ {0x97c39dad, 0x3e065f90, 0x83fefae1, 0x57f27884, 0x4b208058 }, 19 },
-	{ {0x37bd4680, 0xa36c3a1a, 0x078e2bc4, 0x7b631d85, 0x8d9296b8 }, 10 },
-	{ {0x9b6cb224, 0xf2a7a4af, 0x69221f12, 0x80d3344a, 0x5c88450e }, 10 },
-	{ {0x9c886fff, 0x02779267, 0x041efe45, 0xdadefc5f, 0xd7f4b9a2 }, 10 },
-	{ {0x0b379610, 0xcb708500, 0x5a56b24a, 0x0890b79d, 0xd5a7e817 }, 10 },
-	{ {0x636eb837, 0xc5d80fb6, 0xb0692a72, 0x954ca912, 0x91ba831b }, 19 },
-	{ {0x108abde7, 0x1e59839f, 0xb4d1e59c, 0x3a0cb236, 0x6220030c }, 19 },
-	{ {0x4077079d, 0xdebb6b78, 0x142715c2, 0x840cfe15, 0xc7e9f539 }, 19 },
-	{ {0xfc7212c6, 0x81357422, 0x4114c3bb, 0x5bfa9920, 0x6c0816a5 }, 19 },
-	{ {0x3dcecd61, 0x0e832e77, 0x69547d3b, 0x6ce2b767, 0xf65f3563 }, 19 },
-	{ {0xc5af6c42, 0x55bab55d, 0x68e82fa0, 0x16cb35e3, 0x213ba244 }, 19 },
-	{ {0xe5de6e75, 0xab06822a, 0xa10263e9, 0x71b2473a, 0x3b573124 }, 19 },
-	{ {0x9e069397, 0x00ebfebc, 0x28d5fb88, 0x37a84da5, 0xc89fcf2a }, 42 },
-	{ {0x770805bd, 0x0be8b09a, 0x3be10030, 0x060d6ad8, 0xdc07d1c3 }, 19 },
-	{ {0x4334acc2, 0xbd5c921b, 0xc4dcb6de, 0x9a1fcc79, 0xd843ee15 }, 19 },
-	{ {0xac381dfb, 0x4d0b52de, 0xdb18a8df, 0x7a4651ed, 0x2978d12f }, 19 },
-	{ {0xfe1d0228, 0x4b0b0513, 0x08e3c796, 0xe8e9eee2, 0xf86521b8 }, 19 },
-	{ {0x441dacb7, 0x4a47ca4b, 0x7d1ce473, 0x00d182bc, 0x7424ffac }, 3 },
-	{ {0x1efcf9e9, 0xa8ea38ba, 0xd319a70a, 0x5f7319e2, 0x589d4a8b }, 19 },
-	{ {0x1a90b7c7, 0xf24bb7fa, 0x93c84bde, 0x2d1b655e, 0x30c4a7cb }, 19 },
-	{ {0x54a49a3c, 0x8b42b8b2, 0x46e62ed4, 0x5346cf52, 0x836ddcac }, 19 },
-	{ {0xc964e2a3, 0xb63e1261, 0xc1daec4b, 0x4d8bb8e7, 0x4018e0be }, 19 },
+	{ {0x5c61a12d, 0x490d5e1d, 0x97da5e74, 0xac40311e, 0x9725ca20 }, 19 },
+	{ {0x5c7971aa, 0x8688ffc4, 0x29a3e315, 0xdd3d45c3, 0x8f72ddeb }, 19 },
+	{ {0x5c7a13b6, 0x4b480652, 0x31f05c35, 0xb4c8b209, 0x534f3a8b }, 19 },
+	{ {0x5c947b82, 0xcf81a036, 0x74671b66, 0x3697c9b7, 0x9546c1ee }, 19 },
+	{ {0x5c961692, 0x07e19723, 0x7aa728d8, 0xce4e24c0, 0x635d5904 }, 19 },
+	{ {0x5ca722c5, 0x6381e2a9, 0xcdb41fc0, 0x0923bc4e, 0x05780e4f }, 110 },
+	{ {0x5cc22b5c, 0xea25b1b0, 0x0f6e32bc, 0xb58fbd49, 0xe7aeb641 }, 19 },
+	{ {0x5ceedd2a, 0xe401febb, 0x79c1f6a6, 0x4ddef4b2, 0xe1790674 }, 19 },
+	{ {0x5ceffd3d, 0xc9887833, 0xe7b5b717, 0x650dd956, 0xe89803a3 }, 19 },
+	{ {0x5d2062ec, 0xc7176ca2, 0xb100724c, 0x2a17f877, 0x878d721d }, 17 },
+	{ {0x5d218665, 0x8adcf4ce, 0x0c2d3232, 0x384b5712, 0x341108e5 }, 143 },
+	{ {0x5d2bb062, 0xd5d783d4, 0xd08fe04c, 0x2f5c13d6, 0x18b096f2 }, 19 },
+	{ {0x5d387d26, 0xb36347ff, 0x68a07d6a, 0xe98a95d7, 0x1efc0727 }, 42 },
+	{ {0x5d43cb6c, 0xa89f31d5, 0xf543e4dc, 0xd3fa9987, 0xb9769602 }, 19 },
+	{ {0x5d55fc27, 0x2184d160, 0xaf631885, 0x5c9d2f72, 0x8b3f25c0 }, 4 },
+	{ {0x5d5dfe6c, 0xec605de4, 0x21c3aed3, 0xa743d684, 0x0fec1457 }, 39 },
+	{ {0x5d65a308, 0xbb9ec8c4, 0xb4ce334b, 0x18d699b1, 0xf53227ef }, 4 },
+	{ {0x5d82713f, 0x36e93950, 0x92f16663, 0x084fbc85, 0xf05c664a }, 5 },
+	{ {0x5d8ee4d1, 0x6e388bb8, 0x647c671f, 0xbcf30f37, 0xcf8c30b1 }, 19 },
+	{ {0x5dacde48, 0xfed402b1, 0xce9d0a41, 0xb2c12641, 0x7bf5436b }, 19 },
+	{ {0x5db0acc0, 0x08672f29, 0x8d01686d, 0xa4d56428, 0xb690b77f }, 19 },
+	{ {0x5dbff5d7, 0x0978482f, 0xd5b79c02, 0x715bec1e, 0xd463e6bf }, 19 },
+	{ {0x5dcecc7c, 0x790e398a, 0x1c652db5, 0x68c1e66c, 0x6f25e5e4 }, 19 },
+	{ {0x5dd2ac08, 0xfd05a1e0, 0x91c7c6ec, 0xb6c10b49, 0x992bdd46 }, 19 },
+	{ {0x5e094fca, 0x95ab8e91, 0x873ee372, 0xa3f1239b, 0x9a48a48d }, 1 },
+	{ {0x5e1a50af, 0xfe1fa973, 0xf69e423a, 0x8827751b, 0x93fc53ee }, 19 },
+	{ {0x5e28fa0c, 0xd90bcfb7, 0x995acb02, 0x5a22f6f5, 0x56ccac08 }, 19 },
+	{ {0x5e349166, 0xfce12d45, 0xf3ce3f69, 0xecd6b2a7, 0x0ef4d68b }, 19 },
 	{ {0x5e67916f, 0x671ba197, 0x06604863, 0x0e3b9117, 0xe8534432 }, 19 },
-	{ {0xc7df1bc6, 0xe115a39c, 0x850d0d59, 0xcfba8c17, 0x407c476f }, 19 },
-	{ {0x61e26157, 0xf0701cce, 0x2ddb860a, 0x12f18791, 0x2398b1b4 }, 19 },
-	{ {0x91e17aba, 0x249925c7, 0xe0e5c280, 0x469bef09, 0xd5534da8 }, 19 },
-	{ {0x74ae85d4, 0x4cb8ef1b, 0xae428c90, 0x200cb74b, 0xe6d56d3a }, 5 },
-	{ {0xc72af511, 0x8835e49a, 0xc6d181cc, 0x832336ab, 0x22ec5dcb }, 39 },
-	{ {0xf02ca47b, 0xe665e83d, 0x812979d8, 0x074a985e, 0x5637b979 }, 19 },
+	{ {0x5e7c8eab, 0x238712d1, 0xe18b0219, 0xc0f4d4da, 0xe180420d }, 1 },
+	{ {0x5e872d58, 0x53698731, 0xa0ed22fb, 0x72dbcdfd, 0x59cd19c3 }, 24 },
+	{ {0x5e9cd697, 0xae2c85aa, 0x29eb5ece, 0xae729817, 0x4c4b3c9d }, 19 },
+	{ {0x5ea3d992, 0xdb53de3a, 0x19853173, 0x6d8926de, 0x8401b8c8 }, 19 },
+	{ {0x5ebfb4f6, 0xaf4cb5b4, 0xb228863d, 0xbdd41205, 0xdfaa1341 }, 110 },
+	{ {0x5ec88112, 0x54dc762c, 0x6852289a, 0x08acf229, 0x54404f0d }, 3 },
+	{ {0x5ec989d0, 0x82566819, 0xd2a88664, 0x63408463, 0x4f1a2c11 }, 19 },
+	{ {0x5ed42deb, 0x02556f93, 0x024b7911, 0xb4ac17c6, 0x469a8340 }, 19 },
+	{ {0x5ef7d03b, 0x138a2023, 0xf6def241, 0xb671c666, 0xf97ed83b }, 4 },
+	{ {0x5f2ab7f9, 0xc4e8218b, 0x956dd76f, 0x3706e9e7, 0xde3361f3 }, 1 },
+	{ {0x5f6972e9, 0xe374753f, 0xaf092409, 0xf1ee10bb, 0xa5231b66 }, 19 },
+	{ {0x5f805a67, 0x0e31b227, 0x23aa7738, 0xaa3edc3f, 0xdbd8f870 }, 19 },
+	{ {0x5f912637, 0x565932c2, 0xbd7c0d7b, 0x9be6ad3d, 0xc971f96f }, 13 },
+	{ {0x5f965bbb, 0xa0261348, 0x18759d25, 0x119d4114, 0x599132a8 }, 19 },
+	{ {0x5fb4b6c3, 0x735e4d94, 0x15565a85, 0x6bb69f9f, 0xb4857161 }, 19 },
+	{ {0x5fb90be0, 0x78e432db, 0x92dd39e6, 0x21d12f61, 0x2dbea4a8 }, 19 },
 	{ {0x5fbc5d6a, 0x01e66a1c, 0x456b82ac, 0x1190ccde, 0x61bc7832 }, 19 },
-	{ {0xa1d4461a, 0xdf060d68, 0x5c4a7e42, 0x01a38b5e, 0x24a03dee }, 19 },
-	{ {0xda55d2b5, 0xde5d6b04, 0xa55d9019, 0x11c9fa77, 0x76fd0159 }, 19 },
-	{ {0x3242e7b1, 0x320aa1c6, 0x9c58fade, 0xd826ab0f, 0xae5ad970 }, 19 },
-	{ {0x8891e3e3, 0x148bb0fe, 0x4e91e322, 0xba709d2f, 0x95285d1e }, 19 },
-	{ {0x94d7a756, 0xe199457e, 0xa9958c8f, 0x5d6860c9, 0xbf334126 }, 3 },
-	{ {0x9a611007, 0xb58a0016, 0x39676728, 0x614ffea6, 0x1cd5ff85 }, 3 },
-	{ {0xa1e14912, 0xd45944b9, 0xa6baef1d, 0x4d3a04c1, 0xae8df923 }, 19 },
-	{ {0x6d3d2cad, 0x90f3e038, 0x9b11780e, 0x1b43a728, 0x216d3c7b }, 19 },
-	{ {0x33be9017, 0xfaf173ea, 0xe04d0c91, 0xca8d42d1, 0xc20596c0 }, 19 },
-	{ {0xcb325faf, 0xed4b6604, 0xa7146bca, 0x14109a29, 0x443b0c7f }, 19 },
-	{ {0xbf4a0bab, 0x1e8eaa70, 0xa8b12cd9, 0xa81d7a90, 0xa74c9e26 }, 19 },
-	{ {0xbd865b52, 0xe80ae713, 0xf34e1d21, 0x37553011, 0xd0983e36 }, 19 },
-	{ {0x7abdf08e, 0x9c0a511b, 0x8182c502, 0xed8c5f42, 0x778437e9 }, 19 },
-	{ {0x5c947b82, 0xcf81a036, 0x74671b66, 0x3697c9b7, 0x9546c1ee }, 19 },
-	{ {0x9a5e3433, 0xc5d82f21, 0x66969162, 0xbb822a96, 0x5c741ce5 }, 56 },
-	{ {0xcc15f65d, 0x607a573e, 0x0bcd23ab, 0xe9d0d825, 0xe05deb10 }, 56 },
-	{ {0xacce81bf, 0x851fa586, 0x9cd75181, 0xdf4fcf7d, 0x4489a9db }, 19 },
-	{ {0xa2f9e125, 0x0c67d2e9, 0x8be70900, 0xd4370545, 0x321cdbfe }, 19 },
-	{ {0xb7f36450, 0xd1ac7683, 0x4046fd58, 0x2d6e77a6, 0xd3881a8c }, 3 },
-	{ {0xc960c1b8, 0x95557ef1, 0xb3360350, 0x29d5c6d5, 0x53c64085 }, 3 },
-	{ {0x46c98a31, 0x43f5a80b, 0x2090311a, 0x770f9b73, 0x000881c0 }, 6 },
-	{ {0x1edabc32, 0x26648b54, 0xae98d524, 0xb31f37ca, 0x47c8c88b }, 19 },
-	{ {0x8607b924, 0x58584d5a, 0xa770369d, 0x94d50361, 0xb1d64bd3 }, 19 },
-	{ {0x1500a076, 0x93a7c061, 0x89f4cd67, 0x64d5ee62, 0xf0edd85d }, 19 },
-	{ {0x7e830246, 0xe183665d, 0x02ac0447, 0x8fe6f590, 0xd330be4d }, 19 },
-	{ {0xb60dea0a, 0x4256869a, 0x1cd0d104, 0x4cde4269, 0x7852552e }, 19 },
-	{ {0xf6e0dff9, 0xf8674383, 0xa866902f, 0xddb72a28, 0x0d331d9d }, 17 },
-	{ {0xff987766, 0x6d983759, 0xd41398c5, 0xe3e29801, 0xad95a589 }, 19 },
-	{ {0x3325a55d, 0xc5cb88f7, 0x9d3a25dc, 0x21521d61, 0x24a6a90b }, 19 },
-	{ {0x44baa180, 0xf6c9e0f1, 0x40ac1f0a, 0xfae75c41, 0x2cb06b9e }, 19 },
-	{ {0x495ae7af, 0x3d299b96, 0x25cdd79a, 0x2ee41cde, 0x5b328362 }, 19 },
-	{ {0x34544106, 0xfbd29b2a, 0x72e1e8c2, 0xe0f260b7, 0x9a0b0883 }, 39 },
-	{ {0x993ba63b, 0x06e855ba, 0x7294bea2, 0x5b4250bf, 0x2a63fab5 }, 19 },
-	{ {0x877e8a60, 0xee165863, 0x4124db02, 0x3b50bf5d, 0xfa93624b }, 19 },
-	{ {0xe03ec3a6, 0xbb6d8b1b, 0xc6eab349, 0xc7675cb7, 0x2aa47d57 }, 19 },
-	{ {0xf448289d, 0xb0d5c8fe, 0x6c4b3ca8, 0x63af73db, 0x3c4a5e45 }, 19 },
-	{ {0xfa29ca44, 0x86a089e3, 0x2790a69a, 0x9598b051, 0xd6b7dac4 }, 19 },
+	{ {0x5fd07ed5, 0xb7c0492d, 0x42ed91a5, 0x4a0fe80c, 0xe6e4e40d }, 9 },
+	{ {0x5fe519d6, 0xbeb80398, 0x13d10cd1, 0xc08e6e6a, 0x08813d2d }, 19 },
+	{ {0x5fe86465, 0x11934380, 0x4a722ce4, 0x768eb33d, 0xe806a39f }, 19 },
+	{ {0x5ff1254d, 0xccd5dde5, 0x8d3475a4, 0x68178738, 0xd6260b05 }, 4 },
+	{ {0x602c4d0d, 0x12fd5972, 0x5c0c4e40, 0xf51d6bde, 0xb679ea36 }, 19 },
+	{ {0x6030005c, 0x4401b3cb, 0xcb09f802, 0xcd48f5c1, 0xc585303b }, 4 },
+	{ {0x605f5af3, 0xf358c681, 0x1f54e017, 0x3bad9086, 0x14a198c0 }, 1 },
+	{ {0x6075cd96, 0xbc85864f, 0x22c643b0, 0x23302f00, 0x6b565049 }, 4 },
+	{ {0x607cfca6, 0x05eaf82e, 0x3efa3345, 0x9d6583ef, 0xb7ecc13b }, 57 },
+	{ {0x608e8e9a, 0xb91c67f7, 0x015a67ea, 0x12f52ea3, 0xb0d609cd }, 65 },
+	{ {0x6097fb71, 0x94b64148, 0x287e6548, 0x70c98eb0, 0xe2b33850 }, 19 },
+	{ {0x609d0bac, 0x4933d1bc, 0xc877746a, 0x3e14d82c, 0x204f40e7 }, 19 },
+	{ {0x60a938d4, 0x1398970a, 0x99a14c84, 0x7521fca3, 0x6d588009 }, 19 },
+	{ {0x60f68567, 0x0de6d2d8, 0xed5f1b1d, 0xdd40fac8, 0x51ff1982 }, 19 },
+	{ {0x6103b39f, 0x1e38d1aa, 0x2d84b1c3, 0x219c44f1, 0xabb5436e }, 1 },
+	{ {0x612c1861, 0x6bc800d9, 0xeb69b9da, 0x3cd29eca, 0x31f50c1c }, 4 },
+	{ {0x61383444, 0xe658bdcc, 0x4df61e1e, 0x393b2516, 0xbed18106 }, 19 },
+	{ {0x613c7415, 0x35c92dfb, 0x01afec41, 0x35ef8ebd, 0xdb49f999 }, 19 },
+	{ {0x613cc52f, 0xbd5822ad, 0xe47daa3e, 0xc2147964, 0x1a009c2c }, 19 },
+	{ {0x6147f63a, 0x319b44b6, 0x0259b35a, 0x75b1c083, 0x280b92ea }, 42 },
+	{ {0x6159cdfc, 0x79c68bf7, 0xdfe2653f, 0xc0b5893a, 0xe913c72b }, 5 },
+	{ {0x615c0882, 0x0b926e28, 0xb143cd78, 0x12852e01, 0x1d3eeffb }, 19 },
+	{ {0x615d685f, 0xef332a77, 0x42324f96, 0x08eb69e6, 0x336faaa1 }, 19 },
+	{ {0x61695eb1, 0xdc6242d8, 0xa70c7ef2, 0x172cf86a, 0x26e3c2dd }, 19 },
+	{ {0x616c3b9a, 0x0c185c1a, 0xa683afa5, 0x3989f0bb, 0x39cd768c }, 19 },
+	{ {0x61793310, 0x1a195d1f, 0x52aba644, 0x4930cfe4, 0x53e6e50a }, 19 },
+	{ {0x619a2d42, 0x263da74a, 0x723cceea, 0xd5a19e0e, 0x0dd86c6f }, 39 },
+	{ {0x61d99816, 0x055858b3, 0xbcde3416, 0xeed30fd8, 0x6390393d }, 19 },
+	{ {0x61e26157, 0xf0701cce, 0x2ddb860a, 0x12f18791, 0x2398b1b4 }, 19 },
+	{ {0x621ea075, 0xa5345843, 0x61c9e9d6, 0x40e39007, 0xa79dfd78 }, 19 },
+	{ {0x6238f9c5, 0xf4c0012b, 0x3425be20, 0x3c23092f, 0x6b624fe8 }, 19 },
+	{ {0x626e4fc5, 0xf12f6f35, 0x4baf6d60, 0x7beadacb, 0xbafd74ce }, 19 },
+	{ {0x627e4d31, 0x1dfe8a43, 0xa629e63f, 0x444a6f41, 0xeebad835 }, 19 },
+	{ {0x62bfff23, 0xe2beae00, 0xdb14b6c3, 0xe9330432, 0x18b33ded }, 19 },
+	{ {0x6306ca2b, 0xc9fdd3be, 0xcf13e51a, 0x921ea6d3, 0x93f571ae }, 68 },
+	{ {0x63098f27, 0xbeac9eca, 0x6b39d837, 0xd2a55239, 0x5df33fe1 }, 42 },
+	{ {0x630aec6f, 0x93df8d1e, 0xf83c52a0, 0xbb6ec571, 0xb9c6eed4 }, 19 },
+	{ {0x630db251, 0x6b6f6da1, 0x6882f507, 0xe74fb354, 0x55552ea4 }, 19 },
+	{ {0x632bdb16, 0x4acab52e, 0xe715c7ee, 0xfed60e0b, 0x1ae629e0 }, 4 },
+	{ {0x632cb083, 0x4441626d, 0x20cc113c, 0xfad2e3a7, 0xec0e0dc7 }, 4 },
+	{ {0x632ef250, 0xc76b2221, 0x58ba90df, 0xc68b9e00, 0x4dbafe3a }, 19 },
+	{ {0x633700d1, 0x1fc36ccd, 0xab118daf, 0xd4f7e71e, 0x3eca2f46 }, 19 },
+	{ {0x633cb458, 0xeeab0fea, 0x59a70a9a, 0x620b7783, 0xa44eb0a6 }, 19 },
+	{ {0x6354ccc5, 0xc100b1c5, 0x58c9395f, 0xa8c00784, 0xd2e9b0a3 }, 78 },
+	{ {0x6365ee1b, 0xfd476454, 0x6681d860, 0xc90b59f2, 0x7b25f213 }, 19 },
+	{ {0x636eb837, 0xc5d80fb6, 0xb0692a72, 0x954ca912, 0x91ba831b }, 19 },
+	{ {0x639cb280, 0x544b060a, 0x618af23d, 0xaf234a44, 0xbaaf88de }, 19 },
+	{ {0x63d3755c, 0x81b2c294, 0xff3bd96c, 0xfb9f5a2f, 0x3d83b86c }, 19 },
+	{ {0x63d4e39c, 0x59f24f88, 0x0809caa5, 0x34d7a46a, 0xe83f4c9f }, 6 },
+	{ {0x6420473e, 0xc647e4d7, 0x50bc2247, 0x020b6722, 0x435b5211 }, 19 },
+	{ {0x6420d610, 0x02da3254, 0x03fcb6f4, 0x1afb1d34, 0x8eeba3b4 }, 38 },
+	{ {0x64321138, 0xe03337d0, 0xe6178ac3, 0x0bb98e66, 0x23c640ba }, 6 },
+	{ {0x6442c1c5, 0xcece64c6, 0xdae90cc6, 0xae3675f0, 0x70d93e06 }, 1 },
+	{ {0x6448aa09, 0x0d95ab42, 0xe8a63f52, 0xcd12e40c, 0x39521aa0 }, 19 },
+	{ {0x645ec2f2, 0x8f08b3ca, 0x20f0dfe6, 0x5fc7ca99, 0x3da6bfbb }, 19 },
+	{ {0x64781236, 0xe70cf5dd, 0x530a4203, 0x05533ff5, 0x5db0e4ad }, 19 },
+	{ {0x64ae3acd, 0xce06d1b4, 0x1e23ee27, 0x30797fd7, 0xe472bddf }, 19 },
 	{ {0x64c49fda, 0xbbdd5e13, 0xc4310b03, 0xa183ea1a, 0x018154a4 }, 5 },
-	{ {0xa2901318, 0xf8216ccd, 0x2f4d08b0, 0xf272e1bf, 0x90ab197a }, 19 },
-	{ {0x0d76a069, 0x726fec73, 0x26541f75, 0xb809b8b7, 0x2148ed3a }, 5 },
-	{ {0x3b1fc45b, 0x04bd03f2, 0x1d5b8833, 0x0a0c5d16, 0xa9bd2d65 }, 5 },
-	{ {0xa6761737, 0x80dc3ef4, 0x523ff312, 0x3fdf1792, 0x79d22932 }, 3 },
-	{ {0x0d459788, 0xb6c464b5, 0x0cbc2436, 0xe67a2cef, 0x248e0c4a }, 3 },
-	{ {0xa1830ad6, 0x6feb55f4, 0x71d52210, 0xc6f07937, 0xf38238fe }, 3 },
-	{ {0xc19f6788, 0x2b2586c4, 0xba577ffc, 0x5d04197e, 0x757e19a5 }, 3 },
+	{ {0x64f1ce46, 0x91056047, 0xf4044600, 0x31acb0b8, 0x2a76968d }, 19 },
+	{ {0x64f921c9, 0xc57aedb4, 0x7663a269, 0x046d4c51, 0x388f41fb }, 19 },
+	{ {0x650273f9, 0x6ec4cfa4, 0x80004952, 0x4e38aa9c, 0x28c6cafd }, 19 },
+	{ {0x650381b9, 0x6f36e74a, 0x4eaf5ae3, 0xf924f6f8, 0xdeac7100 }, 19 },
+	{ {0x65040fb1, 0xe9bc4b2d, 0x027d7d81, 0xe44be30e, 0x7620e368 }, 4 },
+	{ {0x6511a7a1, 0xbf620f0b, 0x2d5e38e9, 0x54a01482, 0x8dfcda03 }, 19 },
+	{ {0x65160f0d, 0x59068dbb, 0xf76b11bc, 0x79e17a93, 0x69c8dcee }, 3 },
+	{ {0x6523381f, 0xa5012b45, 0xa69af0e3, 0x51f239c9, 0x7afd4be7 }, 19 },
+	{ {0x65253cb3, 0x8ab11084, 0xf355a2d4, 0xad78fa6c, 0x64cbe660 }, 1 },
+	{ {0x65334123, 0xc7d00ca6, 0x23bf5f7a, 0x55756cc7, 0x5958debb }, 19 },
 	{ {0x655b15e8, 0xfd818664, 0x92bcf2b1, 0xd6609211, 0xb30efce1 }, 3 },
-	{ {0xd30c1710, 0x9fa1c4a8, 0x1e39dca5, 0x7b79464b, 0x0aa0b7c2 }, 3 },
-	{ {0x5261006c, 0xa4245653, 0xf5153074, 0xdfcc8ca2, 0x7315bb59 }, 3 },
-	{ {0xdf15daf1, 0xe68e9c8c, 0xd95c4431, 0x803d86fe, 0x6c2f985e }, 3 },
-	{ {0x14ff6fe4, 0x64362c6b, 0x7dbb47b2, 0xecda3a8c, 0x5f05ef79 }, 5 },
-	{ {0x3f741ba2, 0xab08c5e9, 0xfb658882, 0xb36b8e3d, 0x01682f58 }, 5 },
-	{ {0x96e2a716, 0x3c755fbe, 0xa77abfd9, 0xd09a7986, 0x87a5a993 }, 4 },
-	{ {0x7ad40ae5, 0x12bbf4ba, 0x688467ba, 0x23e16354, 0xb8421d0a }, 4 },
-	{ {0x395c5f40, 0x692c45b8, 0x91abe07c, 0x89d1e878, 0x29665fc7 }, 19 },
-	{ {0xe767c023, 0x9b798214, 0x63fa42f2, 0xc1989d3f, 0xd1b4b868 }, 19 },
-	{ {0x1a6de1cf, 0xf8314293, 0x94dc2b95, 0x28993a1d, 0xfcae14c6 }, 19 },
-	{ {0xbc3be8f8, 0x29211dd8, 0xa8eb854f, 0x86ff014c, 0x47ed9254 }, 19 },
-	{ {0x73f2ddb6, 0x1f15fcbd, 0x143e20e3, 0x520df8d7, 0x3e98dedb }, 19 },
-	{ {0x1709541a, 0xc3063432, 0x3392e509, 0x8d47d1f6, 0x44dbfc09 }, 19 },
-	{ {0x817bebb1, 0xbe373e9c, 0x1bae4850, 0xa2bc1dae, 0xc5586a91 }, 19 },
-	{ {0xfd0e46e4, 0xaef2d971, 0x3d20b51d, 0x2ba57d55, 0xbde7dcee }, 3 },
-	{ {0x84831671, 0x935bf80c, 0x250aff22, 0x3a996846, 0x69a0ce72 }, 3 },
-	{ {0x1ec94d04, 0x9fcbf59c, 0x5493d5de, 0x76bdfb89, 0x1d24249e }, 3 },
-	{ {0x54a1d356, 0xfd7bc609, 0x8f5c3d94, 0xf9d8bfcc, 0x2c6d5935 }, 3 },
-	{ {0x0b3f5dbd, 0xbf5636e2, 0x2b3a6bc1, 0x2eeb4ac6, 0x4b0501e5 }, 3 },
-	{ {0x3b4143e5, 0x769d6235, 0xbca8977b, 0x41241295, 0x493eaf5e }, 3 },
+	{ {0x6580f0c7, 0x2bac8d2e, 0x2ca14b96, 0x76452184, 0xbddd952e }, 19 },
+	{ {0x6584c843, 0x07e5dbb7, 0x36606828, 0x3c3c332a, 0xaf52b7a4 }, 19 },
+	{ {0x6589782C, 0x0AA43F6C, 0x7DA6D92E, 0x9B2F8BA4, 0x632E1D1D }, 19 },
+	{ {0x65961a19, 0x26b24c8e, 0xfa71f2ab, 0x68cbafa2, 0xd0122acf }, 19 },
+	{ {0x65a5bda3, 0x4d1e1b22, 0xcfa697e4, 0xe7fdf182, 0x9cf2238d }, 4 },
+	{ {0x65af16d3, 0x5b8d8454, 0xec07718e, 0x9f894833, 0x5ca73bad }, 19 },
+	{ {0x65da0e5c, 0x5de057a1, 0xed836ec1, 0x9b1f07e1, 0x0f4b738f }, 5 },
+	{ {0x65e427d3, 0x282fb471, 0x92e4a0f4, 0xa09245cf, 0xe1b00834 }, 56 },
+	{ {0x65f89c81, 0x3a1d57a8, 0xf8a04e81, 0x682202f7, 0x59ee6980 }, 19 },
+	{ {0x6600fab9, 0x0ca39551, 0x7d0845f8, 0xf380b0e6, 0x7541b392 }, 19 },
+	{ {0x660db5d4, 0xb39de830, 0x8aac13be, 0x817a408f, 0xe3b52477 }, 19 },
+	{ {0x663d12f6, 0xfed3ce50, 0x17b783db, 0x3032eb69, 0xd8554fed }, 19 },
+	{ {0x663f8c51, 0x2d04d213, 0xfa616b0d, 0xb5eefe37, 0x74012a4b }, 1 },
+	{ {0x66508bbd, 0xc3b133b9, 0xa69ea967, 0x89bc134e, 0xea46796a }, 6 },
+	{ {0x66620207, 0xca6c21bc, 0xbae8f868, 0xbb55532e, 0x72e521a6 }, 4 },
+	{ {0x666e82d8, 0xa8e5d267, 0x2a9b7159, 0xadcdc861, 0xa31c8fa1 }, 19 },
+	{ {0x66802dd9, 0x8370da80, 0x92503673, 0x65df234f, 0x9a6422b7 }, 6 },
+	{ {0x6680d711, 0x8d854188, 0x13f1db94, 0x49bf3e20, 0x942b16da }, 105 },
+	{ {0x66acd2f8, 0xef08dd4c, 0xb0dc7ef5, 0x176650fb, 0xf5828acf }, 19 },
+	{ {0x66d18c97, 0x14112d2b, 0xd0063a10, 0x10ce0330, 0x4b0a5038 }, 19 },
+	{ {0x6714e939, 0xf0592d3a, 0x97f995bf, 0xc6d70472, 0x42ebd123 }, 19 },
+	{ {0x6715aea3, 0x15258692, 0x20d7acb6, 0x38b6a432, 0x875e85a1 }, 5 },
+	{ {0x6724b2ab, 0xce814560, 0x9333c8b2, 0x964de0f1, 0xa90d9cd5 }, 19 },
+	{ {0x678efe59, 0x9b8085bd, 0x27f9d3d4, 0x2cfbbd7c, 0xa74ceb89 }, 6 },
 	{ {0x67a0ba97, 0xe4dbec6b, 0x53694548, 0xfdadb1a3, 0x4c15dfc9 }, 19 },
-	{ {0x09fbbd92, 0x3e0deb82, 0xf5e20fa8, 0xce2d842a, 0xdbf4a646 }, 19 },
-	{ {0xca0f156e, 0x66016c72, 0x681754d7, 0xd9a6da56, 0x85e48247 }, 19 },
-	{ {0xc73d4c27, 0xaa2b0fb9, 0x46e39832, 0x3bd67d9e, 0x53c4f9ef }, 39 },
-	{ {0x05182561, 0xe05fa8e7, 0xc8a8184e, 0xda885dc4, 0xfd12cc5b }, 19 },
-	{ {0x5e9cd697, 0xae2c85aa, 0x29eb5ece, 0xae729817, 0x4c4b3c9d }, 19 },
-	{ {0xaa9f3ffc, 0xc977fbcc, 0x04a0326d, 0x5a7371d3, 0x72d099f5 }, 19 },
-	{ {0x033f5c35, 0xc5ddce6c, 0xef8b53fa, 0xac2edd85, 0x047e5805 }, 19 },
-	{ {0x1b5b269b, 0xc0c905af, 0xf94ebea5, 0x98a936e3, 0x4a74fb07 }, 19 },
-	{ {0xc1d27264, 0x5a249757, 0xb8be5bd9, 0x13ba2d34, 0x47892387 }, 19 },
-	{ {0xd0cd4840, 0x4eec5975, 0xd0f284c4, 0x6b3cd710, 0x236b87a5 }, 19 },
-	{ {0xbbabc8ce, 0x1e39d440, 0x5dee5877, 0x37e4dea2, 0x4477c24d }, 19 },
-	{ {0xfdc3cc10, 0xb4821ea5, 0x169c817f, 0xcbd6e99f, 0xac464feb }, 19 },
-	{ {0x530ecff5, 0x42a537c3, 0x20b17bd5, 0xd64c86d5, 0xd65619f3 }, 19 },
-	{ {0xda95bcd1, 0xf0c28683, 0xcfb4a7a2, 0xc1059926, 0x1dca3622 }, 19 },
-	{ {0xb660a4e2, 0xf45477a6, 0xb62201ca, 0x2ac9cd36, 0x748c18d9 }, 19 },
-	{ {0xfc22cec0, 0x76c0a0a1, 0xee7e4107, 0x72af3d7d, 0x31de3149 }, 19 },
-	{ {0xd927dce3, 0xca188da7, 0x33889e41, 0x41aa526b, 0x9a10e635 }, 19 },
-	{ {0xc48f3950, 0x60d919a1, 0x3b3dfdb0, 0xd89cea9e, 0x32fc8f10 }, 19 },
-	{ {0x1eea2cae, 0x2bb3401d, 0x6734b200, 0x1f6b5516, 0x28a99101 }, 19 },
-	{ {0xe373e3e9, 0xbe4f6d30, 0xd5db84b6, 0x99082c00, 0xb2021ba3 }, 19 },
-	{ {0x4936916b, 0xf914d99c, 0x5b9e3f4c, 0x7385f44b, 0x6b97d4c5 }, 19 },
-	{ {0x2b255c3e, 0x5615b2f5, 0xe2365419, 0xa35e4115, 0xa060e93c }, 5 },
-	{ {0x98f3eec6, 0x07cae92e, 0x01c1310f, 0x25d980f2, 0x859b88cd }, 19 },
-	{ {0xdb0ed31c, 0x779fffd2, 0x084946e3, 0xba69512b, 0x372d845f }, 19 },
-	{ {0xa4d4a6fc, 0x06739c54, 0x3ff0767a, 0x1006ae28, 0x60d9b635 }, 19 },
-	{ {0x0e06519e, 0x68c78a8f, 0x01815251, 0x1f4f1337, 0x4c5856aa }, 19 },
-	{ {0x83df4081, 0x529fe5b8, 0xbb0a3601, 0x614d36c8, 0x384c9202 }, 19 },
-	{ {0xf9ad0cdb, 0x227c588b, 0x1a5c7522, 0x0ed53d03, 0x14550d7f }, 19 },
-	{ {0x1c4de8d4, 0xa1cbf5aa, 0x2bcf7816, 0xa1e55ee4, 0x584f59fb }, 19 },
-	{ {0xd844c4c5, 0xae9c7ac6, 0x71c4be71, 0xac1190a1, 0xe5db4d36 }, 19 },
-	{ {0x2a9430fc, 0x0ca601cc, 0xa12f860c, 0xecf9fee3, 0x2e2a9ff4 }, 19 },
-	{ {0x4937a8e3, 0x5072012a, 0x980f85ec, 0xfc60604d, 0x9d900244 }, 19 },
-	{ {0x938602b6, 0x5bb04b94, 0x1d67c453, 0xa948e1f1, 0x8bbbf5ac }, 19 },
-	{ {0x91e52247, 0x3a847051, 0x1584df3e, 0xe5b325ea, 0x5e2b81ef }, 19 },
-	{ {0x3c0263c1, 0x52e0feaa, 0x93cb15bf, 0xa04eea61, 0xacb5236d }, 42 },
-	{ {0xd120ca30, 0x3c3e1dd5, 0x6adee68f, 0x10e9e1ab, 0x51f50ab3 }, 19 },
-	{ {0xfc6292d4, 0x9736e4f9, 0x86d2f44e, 0xae19a2e0, 0xe3185f45 }, 19 },
-	{ {0x7bf7bd13, 0x4ddf9ed5, 0xb489f7f2, 0xeb0aa26b, 0xb2428fc9 }, 19 },
-	{ {0x364ae669, 0x5509f5cf, 0x16985cc2, 0x946a45af, 0x5ca4cf56 }, 19 },
+	{ {0x67baaaa8, 0x70ad4a08, 0xf55ec1c6, 0x7dbeabc9, 0x7b6f18a0 }, 19 },
+	{ {0x67fa6e90, 0x05d23d9c, 0x49f77884, 0xa856cfb3, 0x76194083 }, 4 },
+	{ {0x68158290, 0x666f4d7a, 0xc1ada40d, 0x674a1160, 0xc162b193 }, 5 },
+	{ {0x681c30c7, 0x539ec738, 0xbe2e36dd, 0xca408eed, 0x392f3b6d }, 39 },
+	{ {0x68347886, 0x8f6c6423, 0xcc3e9c6a, 0xabe1868b, 0x30b1e47d }, 19 },
+	{ {0x6842fb21, 0xabb2531c, 0x17fe0687, 0xd77e0123, 0x48d3dc2c }, 19 },
+	{ {0x6844758f, 0xf5c2c410, 0x115d4d7c, 0xf12498c4, 0x2e931732 }, 3 },
+	{ {0x6844ddf6, 0x10e1a98b, 0x55e77fcc, 0x364b38a0, 0x37751a2b }, 19 },
+	{ {0x6856a13b, 0x67750d36, 0xc4c466d3, 0x0472dc54, 0x65879bbf }, 19 },
+	{ {0x6868e705, 0x0d989d1e, 0xcbd13393, 0xed360add, 0xefa4bcd3 }, 5 },
+	{ {0x68691348, 0xa29ce590, 0x46f993e9, 0xabaf3c86, 0x51bdda3c }, 17 },
+	{ {0x688564be, 0xdfd71343, 0x2350d7ae, 0xe3fbd7a7, 0xfc8691d1 }, 19 },
+	{ {0x688b70e6, 0x0dc27265, 0x4ac6b0a7, 0x2237fefd, 0xce2ef9ff }, 5 },
+	{ {0x6895a062, 0xe10b790e, 0x19a55952, 0xe634662f, 0x3135fa55 }, 19 },
+	{ {0x6918679b, 0x2be2d014, 0xb60b4025, 0xa3877dee, 0x9ad5f407 }, 19 },
+	{ {0x692a5539, 0x3e8eef08, 0x00a612c0, 0x1456e9ce, 0xcd9c1418 }, 19 },
+	{ {0x692fd8a8, 0x5978adaf, 0xbb530510, 0xfff71848, 0xf39d4fbd }, 19 },
+	{ {0x6933de9a, 0x128e90a3, 0x4383f3a9, 0xb2660d5b, 0xae5d9fe3 }, 5 },
+	{ {0x695ac043, 0xeaf66268, 0x922ad97b, 0xf4ed5275, 0x3c93b2d0 }, 19 },
+	{ {0x69710f4b, 0x9cc3440e, 0x58c54bd4, 0xc562b3e9, 0x0ff323e0 }, 19 },
+	{ {0x69757f6f, 0xf1da2235, 0xfe78ffb1, 0x20bae4e9, 0xa16783c2 }, 19 },
+	{ {0x69bc7cb4, 0x36ea2ea3, 0xa6b49c3b, 0x050bae24, 0x271a2f9c }, 19 },
+	{ {0x69bda8b4, 0xa9618759, 0x7b95cd5c, 0x43e58da0, 0x716d0fc8 }, 39 },
+	{ {0x69bf27b6, 0x10e11437, 0xdad1f7a1, 0xc37a6317, 0x9a293d12 }, 1 },
+	{ {0x6a3a6883, 0x6a468cc7, 0x61a26817, 0x5c64d53c, 0x4c1c48bd }, 19 },
+	{ {0x6a4e8325, 0xd2174747, 0xd56cbe4c, 0x6803cbf4, 0x0eb40a62 }, 39 },
+	{ {0x6a50295e, 0xa35e720b, 0xa6f4ba56, 0x16c34411, 0x28b384ed }, 42 },
+	{ {0x6a56b46b, 0x8bf014b2, 0x5863433d, 0x6d96e646, 0x41a93eef }, 19 },
+	{ {0x6a5e4d81, 0xddc779e6, 0x289987da, 0x4a4ad4c2, 0x0461cef0 }, 19 },
+	{ {0x6a7ab69c, 0x47cc168d, 0xd872d32f, 0x395541be, 0x4939255e }, 19 },
+	{ {0x6a7faa12, 0x2454ba34, 0xcbdb9f1a, 0x75a111a1, 0xa4763a56 }, 61 },
+	{ {0x6a95b7f3, 0xa4cff9c9, 0xb3d7b8b3, 0x0b0b0f75, 0x2dadaa37 }, 6 },
+	{ {0x6a98d578, 0x7dd0e76f, 0x04283ce0, 0xaec55d45, 0xba81565d }, 4 },
+	{ {0x6aa856cc, 0x56eb9886, 0x3c9da7a5, 0x66571605, 0x682b5c6b }, 67 },
+	{ {0x6aa9f757, 0x20bb38e4, 0x10d75122, 0x5d18e898, 0x5ab4d61f }, 19 },
+	{ {0x6acaf2ee, 0xb57f65f7, 0x408235d5, 0xe07b7563, 0x229de799 }, 24 },
+	{ {0x6ad2c394, 0xf8e3ace4, 0xc30c7b75, 0x1fc2cf2c, 0x78f47bb4 }, 19 },
+	{ {0x6ad2f111, 0x227d6d46, 0x59f0089b, 0x9397896d, 0x16f867a0 }, 42 },
+	{ {0x6aea1aef, 0x5ec31c18, 0x26c22edf, 0x580525f9, 0x3baad425 }, 78 },
+	{ {0x6af5044c, 0xcf48840d, 0xdd23fd07, 0xcbd3e230, 0xfa38fc8c }, 19 },
+	{ {0x6b12bb29, 0x1e1a98a4, 0x3ccff8ce, 0xb94d2358, 0x5848febc }, 19 },
+	{ {0x6b42315e, 0xddefa0a3, 0x3ea0c451, 0x0d6a4bc1, 0x086a5163 }, 55 },
 	{ {0x6b496a50, 0x626c3e67, 0xdfe49c15, 0xa3847448, 0xdbeb05a8 }, 19 },
-	{ {0x8e413a3b, 0xe17e3f0e, 0x4304219a, 0x413a5eb0, 0x4f2b3a04 }, 19 },
-	{ {0x7a0a1c55, 0x70a3361a, 0xd75406ee, 0xa07c93fd, 0xad9fde02 }, 17 },
-	{ {0xe6ba7a6e, 0xcda80a1c, 0x844542be, 0x0b2a44a4, 0xa33dc113 }, 17 },
-	{ {0xe7351ef9, 0x606bd6d5, 0xf38acb7c, 0x17aed8a0, 0x0170b85d }, 5 },
-	{ {0x6715aea3, 0x15258692, 0x20d7acb6, 0x38b6a432, 0x875e85a1 }, 5 },
-	{ {0x17d6db13, 0xd7d76fbd, 0x110f53b1, 0x68ab0001, 0xc7e65817 }, 19 },
-	{ {0x3828bf9e, 0x72aeaf78, 0xff0281a6, 0xb1f7fa44, 0x0a370cdd }, 19 },
-	{ {0x8c317e50, 0xe0aa75df, 0xaa374412, 0xce9866d1, 0x6c0214fd }, 19 },
-	{ {0x18419523, 0x962b57f1, 0xff49d621, 0x82f50882, 0xd6c42228 }, 19 },
-	{ {0x4B986D80, 0xFC0D4AD3, 0xB2E2D0FA, 0x77C743BB, 0x671BC5BB }, 19 },
-	{ {0xd264152d, 0x4974b789, 0x59465acf, 0xe0d5678e, 0x72930073 }, 19 },
-	{ {0x64f1ce46, 0x91056047, 0xf4044600, 0x31acb0b8, 0x2a76968d }, 19 },
-	{ {0x136d838c, 0xc1297940, 0xd96cd8e2, 0x7aea9f9e, 0x3c7088a6 }, 42 },
-	{ {0x72845ccc, 0x50f71456, 0x2ddb87f9, 0x78c99b40, 0x76aa120a }, 42 },
-	{ {0x12f7eafa, 0x2e411351, 0x73dafed9, 0x07c8643c, 0xf5298d31 }, 42 },
-	{ {0x1f8334dc, 0x7459cfcf, 0x2ad132e9, 0x4976015c, 0x02e51390 }, 19 },
-	{ {0xe8959529, 0xa71ce9d5, 0x80766dd2, 0x074b2c17, 0xcde34c2d }, 19 },
-	{ {0x5398bfcc, 0x6bf60d39, 0x3755a0ed, 0xc15f3b9c, 0x14180b47 }, 19 },
-	{ {0xe8d2f130, 0xb0937d1b, 0xaced5a39, 0x96b78f16, 0x3d4fa70a }, 19 },
-	{ {0x0d53c456, 0x603a56b3, 0x9392b203, 0xad753233, 0x57895381 }, 19 },
-	{ {0xc55b0daf, 0x698d93b8, 0x278a9d89, 0xf3827206, 0x4d1594bd }, 19 },
-	{ {0xac4facb5, 0x17e2383b, 0x4cb22504, 0xcda961b1, 0x5af0a83e }, 56 },
-	{ {0xe3a52d44, 0x8e69d6d1, 0x4f67d35f, 0x24d99241, 0x58b1cce1 }, 19 },
-	{ {0xe8dd2edf, 0x5b0db48e, 0xee729988, 0x731d11b1, 0x67fe1dd3 }, 19 },
-	{ {0xd81a4fee, 0x5bff14ed, 0xa613fb72, 0xbc784298, 0x74bbb18f }, 19 },
-	{ {0xcf93e1f7, 0x90c4bdf5, 0x0b41ec05, 0x37dfb97e, 0xd0d11b21 }, 19 },
-	{ {0x5db0acc0, 0x08672f29, 0x8d01686d, 0xa4d56428, 0xb690b77f }, 19 },
-	{ {0x7300d44a, 0x753dacf5, 0x82d3079e, 0xd09eafc9, 0xdd629530 }, 19 },
-	{ {0xe168d460, 0xc2acc0f2, 0x5523e2b9, 0x9861d187, 0xd1aaac00 }, 39 },
-	{ {0xb9aad68e, 0x2338ab18, 0x14f2dac7, 0x8b2c4b58, 0x77d29cee }, 39 },
-	{ {0xae62d7cd, 0x44e6a85e, 0xe6d30a31, 0x9ef5e347, 0x6f784148 }, 19 },
-	{ {0x5dbff5d7, 0x0978482f, 0xd5b79c02, 0x715bec1e, 0xd463e6bf }, 19 },
-	{ {0x5a12439f, 0x74ca5d1c, 0x2664f01f, 0xf6a8302d, 0x3ce907a8 }, 5 },
-	{ {0x3caeec19, 0x423a960d, 0x98e4719b, 0x301a3d27, 0x6339e5ae }, 5 },
-	{ {0xf35a3f1f, 0x09b01895, 0x7696e015, 0xb20dc1d1, 0x2d3ccc2e }, 39 },
-	{ {0x45e72004, 0x565ea1af, 0x837f4f18, 0x1d7da215, 0xca81a965 }, 39 },
-	{ {0xdee167d8, 0x6c9d9d43, 0x5b141080, 0x4055b561, 0xffa2c6e3 }, 19 },
-	{ {0xcf55b0d1, 0x2e550f71, 0xcef70935, 0x8bc7e799, 0xeced0083 }, 19 },
-	{ {0x2338946a, 0x671d31d1, 0x2360ace4, 0xeeb33f7b, 0xc7db56f1 }, 19 },
-	{ {0x04bd7873, 0x0b100dd8, 0x79e2fbd3, 0xfe646d2b, 0xc9bbc46b }, 19 },
+	{ {0x6b4b099f, 0xa7a87c50, 0x59ebb40d, 0xa3089d0d, 0x61967644 }, 19 },
+	{ {0x6b8a684d, 0xdbadd798, 0xa8e59944, 0x9b823bce, 0xca9cdb58 }, 19 },
+	{ {0x6b9f1e8e, 0xa9173157, 0x0ab7e2ca, 0x6bdb9fba, 0x7937afa5 }, 19 },
+	{ {0x6bad9af9, 0x1907c2a9, 0x7fa2f4b9, 0xdd2a699c, 0xe0d70fba }, 19 },
+	{ {0x6baf75aa, 0x6024cb13, 0x11fc1171, 0xcce4560e, 0x16de6d9a }, 19 },
+	{ {0x6bc6acb1, 0x1e684406, 0xa5d93933, 0x7b29f33d, 0xc9816ad1 }, 19 },
+	{ {0x6bd5b97b, 0xaceb3bc8, 0xda357159, 0x0e2a6a76, 0x1bb90b48 }, 55 },
+	{ {0x6bde4e67, 0x61286a29, 0x09858ece, 0xf04155e1, 0x7072996e }, 5 },
+	{ {0x6c0d3a55, 0xf9e8e9c2, 0x74413d06, 0xf4729bc5, 0x17f77ff5 }, 19 },
+	{ {0x6c1814c7, 0x0d69a50e, 0xc60e39ef, 0x281f0b8c, 0xd7bf8598 }, 8 },
+	{ {0x6c68f7be, 0x1eb46cca, 0x6dcdbb91, 0x92cbff9d, 0x59604357 }, 19 },
+	{ {0x6cbddd11, 0x8afe63e7, 0x9cb8a40f, 0x8aa879df, 0x1c7590e1 }, 19 },
+	{ {0x6ce0632a, 0xcc2351ae, 0x968d7d3c, 0xe9c9a0af, 0x05c713cf }, 19 },
+	{ {0x6ce808d6, 0x9e9198a0, 0x343e9fd0, 0x6744deb6, 0xf9e59419 }, 19 },
+	{ {0x6cf3f098, 0xd592d7dc, 0xb767a0e2, 0x4b5caf32, 0x7b5f22db }, 19 },
+	{ {0x6d3008b9, 0x7b48d995, 0x22e45056, 0xf52ed944, 0xe3d8e208 }, 17 },
+	{ {0x6d3a530a, 0xe822ec91, 0xf6444c68, 0x1c9b08b9, 0xefadc7e7 }, 67 },
+	{ {0x6d3d2cad, 0x90f3e038, 0x9b11780e, 0x1b43a728, 0x216d3c7b }, 19 },
+	{ {0x6d72a04e, 0xf018fa1f, 0xa3708c8b, 0x5ed3333b, 0x2c5e8ead }, 5 },
+	{ {0x6d73ee99, 0xac367a25, 0x58fd9366, 0xaf75ad39, 0xed0d4e69 }, 19 },
+	{ {0x6d7a8ea1, 0xb283ecc1, 0xcc94c359, 0xe5f053a6, 0xe82ab3f5 }, 5 },
+	{ {0x6d800787, 0xf5f5d638, 0x27b841aa, 0x29fe26ed, 0x89ea2cef }, 5 },
+	{ {0x6da1c669, 0x3b67b041, 0x5be6de17, 0x8bc5d319, 0xc0bef59d }, 19 },
+	{ {0x6da3d46f, 0xa7141596, 0x2004b3b1, 0x3a2bac2d, 0xd513958a }, 55 },
+	{ {0x6dd28797, 0xf9d1fe7c, 0xc041077e, 0xbe77d08f, 0x2ccc0937 }, 5 },
+	{ {0x6dfc622e, 0x350d2985, 0x9f05fddb, 0x3fa1f974, 0xcd4c8bf2 }, 19 },
+	{ {0x6e15b3d9, 0x2191bf2c, 0x5ff07435, 0xc9849e31, 0xdad3ed1e }, 19 },
+	{ {0x6e17ee44, 0xd62f57be, 0x20177a69, 0x2319e4da, 0x14be572f }, 19 },
+	{ {0x6e1d2d5b, 0x0688860b, 0x0a04d53f, 0xe9e5e393, 0x9dfba547 }, 8 },
+	{ {0x6e2e5cff, 0x4ee4dd93, 0x5fbe6684, 0xf2c54b39, 0xeca06092 }, 19 },
+	{ {0x6e5acdfb, 0x1c161025, 0x7a7aabf3, 0xd5aa8588, 0x66dbcf2e }, 3 },
+	{ {0x6e6b8cdc, 0x55713eab, 0xc724f3ec, 0x9624e988, 0x4254ab33 }, 19 },
+	{ {0x6e89f191, 0x79ccfeb8, 0x24bb12a6, 0xf512b9d0, 0x7d0b8534 }, 143 },
+	{ {0x6ebe5e2e, 0xd0fd8409, 0x1ef1a32e, 0x44c1353f, 0x049ac085 }, 19 },
 	{ {0x6ec24f57, 0x4a8e40d8, 0x785b3e72, 0x1b1605e1, 0x984c5834 }, 19 },
-	{ {0x0306181b, 0xb8babbc2, 0x15e8c506, 0x6c1f4907, 0x19541665 }, 19 },
-	{ {0x78e833c0, 0xa94478b9, 0xc07e974f, 0x311dbfef, 0x1e014f1c }, 19 },
-	{ {0xa25f9b81, 0x3c4488c7, 0x3c5f5405, 0x5748b4db, 0xb057c2e9 }, 19 },
-	{ {0xd5547103, 0x17482127, 0xf2e1597e, 0x91e72be5, 0xee0726ce }, 5 },
-	{ {0xde10aa2a, 0x2abfdcaf, 0xe0064e1e, 0x76b676f5, 0x4c7aafc6 }, 19 },
-	{ {0xd1ad3beb, 0x29aecaa7, 0xc3bc1fd8, 0xa4be3b10, 0xd38cc47a }, 19 },
-	{ {0x0856cba1, 0x4ff2396e, 0xa257ff92, 0x7da0767a, 0xe74084c5 }, 19 },
-	{ {0x96e1f8fa, 0x1f4f3fdf, 0xa999f6a9, 0x99d60d75, 0xb590f070 }, 19 },
-	{ {0xa21d354d, 0xdda95975, 0xd737746d, 0x27fd59cb, 0x908ddf0a }, 19 },
-	{ {0x5bff56d5, 0x671d1131, 0x05645102, 0x5b20c1ce, 0x192e279b }, 19 },
-	{ {0x4971bdd3, 0xdb63d394, 0xfbc21861, 0x82c901ca, 0x4b32535b }, 19 },
-	{ {0xa00f9e66, 0xf1fa3de1, 0x5b028e0f, 0xbfed636e, 0x194bb967 }, 19 },
-	{ {0x6580f0c7, 0x2bac8d2e, 0x2ca14b96, 0x76452184, 0xbddd952e }, 19 },
-	{ {0x93bf6725, 0xa3c1b707, 0x1064a018, 0x84e1b6e8, 0xc6f8b579 }, 19 },
-	{ {0xfe39af5e, 0xb457bba8, 0xc5b96b5b, 0x500120cf, 0xc05c265e }, 3 },
-	{ {0xfb837d3a, 0xa087a75c, 0x7064c080, 0x8adf9832, 0x9387cbc6 }, 19 },
-	{ {0x7c0f720c, 0x7601ca6d, 0xc86c81ab, 0x6a76e058, 0x7a052f75 }, 19 },
-	{ {0xfff31b8c, 0x7549493d, 0x8ec220f8, 0x5e3e8536, 0xf150d82a }, 19 },
-	{ {0x0809b47c, 0xf385328c, 0x3faa6a80, 0xf8378fa5, 0xc6690829 }, 3 },
-	{ {0x4b996bdd, 0xf88605c4, 0x32f73564, 0x922106a6, 0x3d31f62c }, 19 },
-	{ {0xe5480a5a, 0x41ce4b8b, 0x0706632e, 0xa92d2901, 0x8416dd73 }, 19 },
-	{ {0xe0e8ed63, 0x7f5d220f, 0x881cc9b5, 0x2bc52e9d, 0xd3373489 }, 19 },
-	{ {0xb9c98b80, 0x216983f9, 0x7e28293b, 0x576ca9be, 0x3602c1a1 }, 19 },
-	{ {0x5cc22b5c, 0xea25b1b0, 0x0f6e32bc, 0xb58fbd49, 0xe7aeb641 }, 19 },
-	{ {0x0303ca82, 0x776894ec, 0x8c6597e5, 0xc29afc4a, 0x605b2a59 }, 19 },
-	{ {0x4d80fae5, 0x133d5550, 0x3968ee24, 0x6c1346cd, 0xdb020ffc }, 19 },
-	{ {0x49e14b02, 0x48c649e7, 0xb5754357, 0x597695ab, 0xef70c17d }, 19 },
-	{ {0x22a927a7, 0xbc70a363, 0x79404743, 0xa3fde5df, 0x8ca543ce }, 19 },
-	{ {0x97f17901, 0x46116198, 0x133c083d, 0xe113ed1e, 0x5ca6ff21 }, 19 },
-	{ {0xd07af802, 0x2481bed2, 0x523e0e9e, 0xec67bf8c, 0xe64f9142 }, 19 },
-	{ {0x33c62e6f, 0x7478be36, 0x9580a2d9, 0x85ff5766, 0x7f13cf84 }, 19 },
-	{ {0x1d129bde, 0x09c9db24, 0x33b334d3, 0x6762704d, 0xe94983ba }, 17 },
-	{ {0x18b90aaa, 0x2284eb46, 0x233e9203, 0xaf1e8cf1, 0x922c417c }, 19 },
-	{ {0x72afbebb, 0x12098ade, 0x1ec26dcd, 0x65890b60, 0xb2c705d0 }, 3 },
-	{ {0xb07a6ae6, 0x19fcc629, 0x1838959d, 0xc1a899de, 0x832f8d97 }, 19 },
-	{ {0xa1e1bffe, 0x4b4ea6d6, 0x7c973fa4, 0x83c4d627, 0x3f68de3c }, 19 },
-	{ {0x94ae0568, 0x95c68827, 0x04bddade, 0x105cc343, 0x3110656d }, 19 },
-	{ {0xeda9580a, 0x1ac75707, 0xf621c251, 0xa7424df3, 0x846e4ec0 }, 19 },
-	{ {0x225894da, 0x7e3afabf, 0x33abf05e, 0x519e1f6b, 0xcac77a21 }, 39 },
-	{ {0xc1746efe, 0xb4b44dcc, 0x80dfc4f4, 0x29009fea, 0xc91d9c48 }, 19 },
-	{ {0x15193ca7, 0x79ed9daf, 0x6950da70, 0xc155d7ca, 0x94767383 }, 19 },
-	{ {0x5fe86465, 0x11934380, 0x4a722ce4, 0x768eb33d, 0xe806a39f }, 19 },
-	{ {0xb58caf47, 0xc953b6f0, 0x0935a201, 0xbfccf7ee, 0x968dff32 }, 19 },
-	{ {0x6a56b46b, 0x8bf014b2, 0x5863433d, 0x6d96e646, 0x41a93eef }, 19 },
-	{ {0x7ae260d7, 0x69a1e12b, 0x8f7af09a, 0x17876027, 0xa423e926 }, 19 },
-	{ {0xf2b5b902, 0x9575b85f, 0x0730914a, 0x44e57f94, 0xc9313df5 }, 19 },
-	{ {0xb2bcc1c0, 0xd64b6ee9, 0xf0e9bbbc, 0xf0ef7b64, 0xd80d3b90 }, 19 },
-	{ {0xe3ce88e9, 0x5115765e, 0x31193777, 0xe57fcb9b, 0x40e10d3a }, 19 },
-	{ {0x0e5062bb, 0x18b4a6fb, 0x93a89318, 0x77292887, 0x4dd4d6ea }, 19 },
-	{ {0xfc5d252a, 0x26c93dc4, 0xcc30984b, 0x954a6a51, 0x24dee653 }, 19 },
-	{ {0x27ce427e, 0xb1c86ba2, 0x2707a6ee, 0x9086db9d, 0x39962dc6 }, 19 },
-	{ {0x480d85e5, 0x325c8902, 0x966fdf22, 0x6868eafc, 0x62de4663 }, 19 },
-	{ {0x2ebd7b78, 0x4094097d, 0x9f0fbebe, 0x4e69be8b, 0xa9a08a5c }, 19 },
-	{ {0xb3370cdf, 0x4707d9c3, 0x8afc0f42, 0xc11cba5e, 0x745ead6a }, 19 },
-	{ {0x1fa73980, 0x05fb0bd7, 0x07514103, 0x5e8d8881, 0x97162030 }, 19 },
-	{ {0x3950f222, 0x65139a84, 0xcf57f3c0, 0x936e7927, 0x173f3d7a }, 19 },
-	{ {0x214cedb8, 0xf4689da1, 0x50878ca6, 0xf4fcac31, 0x359c9766 }, 19 },
-	{ {0x3063bc3a, 0xc5af6d99, 0x0d8d002a, 0xcbc9c3a1, 0x8bab71f6 }, 19 },
-	{ {0x9613d00d, 0x89ce9033, 0x4d9776db, 0x32b984ce, 0xeefdeeff }, 19 },
-	{ {0xf0bacc79, 0x8b381e6f, 0x7c6b27e0, 0xfcbe3065, 0xa2c80d65 }, 19 },
-	{ {0xde505f32, 0x041800ec, 0xae382772, 0xa8f5adf2, 0xe397124b }, 19 },
-	{ {0xe37e2468, 0xfaf0e6bf, 0x3e38b3cf, 0x7e611c84, 0x6e45c5e9 }, 19 },
-	{ {0x65da0e5c, 0x5de057a1, 0xed836ec1, 0x9b1f07e1, 0x0f4b738f }, 5 },
-	{ {0x120d477c, 0xd28b48b8, 0xa63efb34, 0x920ac331, 0xb54e66e5 }, 19 },
-	{ {0xc44cccb5, 0x3e2f0cc8, 0x560c2883, 0x54744f29, 0xd2488850 }, 19 },
-	{ {0xf993369a, 0x54244b63, 0xa11fb435, 0x9f52af19, 0x859eb38b }, 19 },
-	{ {0xccf6e244, 0xd27ec611, 0x95280d09, 0x15a3b43d, 0x291e3fad }, 19 },
-	{ {0x89e71e74, 0x46589f4f, 0xa320f94b, 0x771cc1a0, 0x756ce196 }, 19 },
-	{ {0x05d7016f, 0x39e94bf9, 0xfc33d0e8, 0x482ff303, 0x8d6e01bd }, 39 },
-	{ {0x75794b50, 0xc0ea8ca3, 0x3d6ffa8e, 0xc3b68eb2, 0x1c35d0d2 }, 39 },
-	{ {0xdacc9ed6, 0xa80fb15c, 0x3e82c408, 0x1c07211e, 0x033ba820 }, 4 },
-	{ {0xa3e8e076, 0xb9c8d406, 0x0082233a, 0x2f16184c, 0xf4911a85 }, 4 },
-	{ {0x8b65d999, 0xba187c98, 0xba97a038, 0xea46655f, 0xd9d62deb }, 19 },
-	{ {0xd86b5f30, 0x154b472d, 0x6f61a378, 0x4303d5ac, 0x328f4435 }, 19 },
-	{ {0xcd466c04, 0x209a8815, 0xa95d3723, 0x653e263a, 0x868de9e0 }, 19 },
-	{ {0x85153a8f, 0x25882cad, 0xde8295d0, 0x40ddb758, 0x6c93cefe }, 19 },
-	{ {0x9bafce69, 0x9964f4aa, 0xbc6b60c7, 0x1a71c9ff, 0x5b0cc82d }, 5 },
-	{ {0x14faf5da, 0x6ab76de0, 0xb62f1ede, 0x91e27d46, 0xb9db77a2 }, 5 },
-	{ {0x5d65a308, 0xbb9ec8c4, 0xb4ce334b, 0x18d699b1, 0xf53227ef }, 4 },
-	{ {0x03f112b3, 0x8fb1d05a, 0x9b0b50d3, 0xc6a54aa2, 0xce9dd2b0 }, 19 },
-	{ {0xa84608f1, 0xc2fe1aea, 0x1a8a586f, 0x2e335cb6, 0x4bb951fc }, 19 },
-	{ {0x9fce4dde, 0x148a4a2e, 0x9cbb7731, 0xbaf099d1, 0xd16e7c96 }, 19 },
-	{ {0x7ad00597, 0xceb5a023, 0x79055230, 0xd907c442, 0x1982329a }, 19 },
-	{ {0x31472edf, 0x134c8ba5, 0x32e6a1ed, 0xed0dcc1a, 0xa088e8ba }, 19 },
-	{ {0x87a9f78c, 0x0bba4e38, 0xd98890e3, 0x4033a7b1, 0x4f75f5e2 }, 19 },
-	{ {0xde2dd717, 0x30922168, 0x428dbc11, 0xa82fe91b, 0x84c23192 }, 19 },
-	{ {0x61383444, 0xe658bdcc, 0x4df61e1e, 0x393b2516, 0xbed18106 }, 19 },
-	{ {0x32972530, 0xda19cac5, 0x956f83c2, 0x253c7cbf, 0x41e14dc3 }, 55 },
-	{ {0x93ab050b, 0xc4965667, 0xee863773, 0xb8ecd36d, 0xd4f3f86c }, 56 },
-	{ {0x16553c30, 0xfcdd0e1d, 0x00a48fe1, 0xcb2def53, 0x7c4a7c3f }, 19 },
-	{ {0x54f28859, 0x0f0c882f, 0x6e3a9b7c, 0x3f7d15b4, 0x07190975 }, 19 },
-	{ {0x82c68a93, 0xd01f103a, 0xf4fe9f92, 0x05184ffd, 0x1a36a90f }, 19 },
-	{ {0x05680151, 0x6eb672b4, 0xe06de5ec, 0xe8812173, 0x4bdd4385 }, 19 },
-	{ {0x34716d19, 0xc216436e, 0xdb8d68c6, 0x9f5b779a, 0x70250168 }, 19 },
-	{ {0x27c2cdee, 0x4be0ca16, 0x6c2ebd2d, 0xac61115a, 0x56bb9856 }, 19 },
-	{ {0x2dfbca8f, 0x5cc3a9e9, 0xd151382e, 0xbe0da410, 0xf5393eaf }, 5 },
-	{ {0xc69165e8, 0x4e8350a6, 0x726901f2, 0xab6e4688, 0xf38f03fc }, 4 },
-	{ {0x244399d6, 0x7d7851f3, 0xdaa9bb87, 0xa14f5b8e, 0xf6d8c160 }, 4 },
-	{ {0xcf6fe49b, 0x28fcf815, 0x11f39fdf, 0x68f37af8, 0x2bd724c0 }, 17 },
-	{ {0x81b85b11, 0x52a59bb1, 0x0d0e0118, 0xf80f0a4e, 0xd363c785 }, 17 },
-	{ {0x55f30c8b, 0x71188708, 0x02d00db8, 0x60bc1945, 0xf18a42c0 }, 19 },
-	{ {0x35f13b5a, 0x32c64b21, 0x517f0c40, 0x09f26406, 0x7338912e }, 19 },
-	{ {0x991ef989, 0x0dc3e0c0, 0xd29d6d24, 0x9675eae1, 0x82aca30c }, 19 },
-	{ {0x0d2f86db, 0xb70f4b4a, 0x4e4dc1bc, 0x95df232f, 0x48856037 }, 18 },
-	{ {0x0348f175, 0x8daa118e, 0xbaf2bc59, 0x3ff9a0a6, 0x22fc89e8 }, 19 },
-	{ {0x8dcd9618, 0xf92fb014, 0xd16e8f4e, 0xc9a813e6, 0x5424ad7d }, 19 },
-	{ {0x58b3b3a6, 0x78364d06, 0x49c1af0c, 0x27da144c, 0xfee85146 }, 19 },
-	{ {0x996a1c0d, 0x92400287, 0xc1554511, 0x6b952f84, 0xc7dc03b1 }, 19 },
-	{ {0xa2f8f8f9, 0xf4626234, 0x2eee0a1d, 0xf7c68710, 0x08a3a189 }, 19 },
-	{ {0x830efa0b, 0x25e1cf34, 0xd5f55d08, 0xcb80709d, 0x0a2c82ec }, 19 },
-	{ {0x4a128290, 0x1221207d, 0xa79432fb, 0x0bcb4f1e, 0x722c8278 }, 19 },
-	{ {0x58fc860e, 0xb4e5c33b, 0x22d29a4a, 0x39650aea, 0x0f327b1e }, 19 },
-	{ {0x1a5295a3, 0x37e5b969, 0xc939644c, 0xb5ad55b8, 0x4a6ad31d }, 19 },
-	{ {0xc8015d44, 0x53efb9f7, 0x8005f6c8, 0x481cbce9, 0xd99f6cc5 }, 19 },
-	{ {0x221c76d6, 0xac483fb1, 0xf11c87d3, 0x7b9617f1, 0xe1d7bc6d }, 19 },
-	{ {0x2d8e39f2, 0x10da6d63, 0x3f773cda, 0x03e99707, 0x12ea84cf }, 19 },
+	{ {0x6f0f6128, 0x5be1158e, 0xcf2e5393, 0x619187f2, 0x6a7395be }, 19 },
+	{ {0x6f177419, 0x5b8db0ba, 0x34af5e16, 0xef94700d, 0x1714e011 }, 19 },
+	{ {0x6f247c8a, 0xf6fc1881, 0x242281f1, 0x9912068b, 0x03ca4126 }, 19 },
+	{ {0x6f391d04, 0x08223138, 0xb7927ed7, 0x19d7ac1b, 0x6c38ca0d }, 19 },
+	{ {0x6f9aa263, 0xe74bedf6, 0x133b2912, 0xd55e9750, 0xe52334a6 }, 78 },
+	{ {0x6f9b4d79, 0x1f4a43d7, 0x182650f2, 0x1a7bfe88, 0xd1c5c2b4 }, 19 },
+	{ {0x6fbb3851, 0x47a939a7, 0xe6b47f59, 0x45d8e3b6, 0x71a8c065 }, 19 },
+	{ {0x6fd90e75, 0x73abdb5a, 0x7bd6e4e8, 0xdc44db80, 0xfc163e30 }, 5 },
+	{ {0x6fe7a6bb, 0x86897e57, 0x9393e709, 0x61a3a320, 0x4adfa48b }, 4 },
+	{ {0x6fe8c172, 0x5c35d85a, 0x5e489c0c, 0x8d21134d, 0xef09ecfb }, 39 },
+	{ {0x6fefbe44, 0x8674b6ea, 0x846d0c6b, 0x9c8a0d57, 0xa11aa410 }, 6 },
+	{ {0x6fefe304, 0xcc8cd099, 0x456bbbbb, 0xcb23ff77, 0x6cb113c9 }, 19 },
+	{ {0x7013fcf8, 0xc76bc610, 0xcec9f55f, 0xbb993741, 0x82641251 }, 19 },
+	{ {0x702d8f17, 0x62d4efe9, 0x94f520e2, 0x1e8867ad, 0xae13b817 }, 19 },
+	{ {0x7033c47a, 0x3b20fd04, 0x054ef37d, 0x209e1545, 0xac053865 }, 19 },
+	{ {0x7056a2be, 0xa5013894, 0x930279f8, 0xc09cc776, 0x33964778 }, 19 },
+	{ {0x706dd670, 0x36baeec7, 0x127e4ccd, 0x8c8db8f6, 0xce7d0e4c }, 1 },
+	{ {0x708eef06, 0xa0b5aca9, 0x0dda1208, 0x77b1cc3a, 0x5172a642 }, 19 },
+	{ {0x709fb353, 0x38f21897, 0xe275237c, 0xc4c5615d, 0x0a5c2753 }, 5 },
+	{ {0x70a25b5e, 0x8ca1f02f, 0x91c32ec8, 0xadb80e58, 0xce683911 }, 63 },
+	{ {0x70a8afee, 0x598dd2e2, 0x095353e5, 0x086b9f73, 0x7cf89be3 }, 19 },
+	{ {0x70ba2331, 0x844bd5c1, 0x4906e9f2, 0x284eba11, 0x9b3e41bf }, 19 },
+	{ {0x70eaf556, 0xb2f9f077, 0x895d2b72, 0xebe880e2, 0xf9213b81 }, 19 },
+	{ {0x711e03c6, 0x620ba574, 0xf98f8954, 0xf1750cdc, 0xafd60d14 }, 19 },
+	{ {0x71442ac7, 0x03c29661, 0x42b04071, 0xfedf180e, 0x81daab9a }, 19 },
+	{ {0x716952ea, 0xb41077f1, 0x8e6835d1, 0x1caad676, 0x1b17d400 }, 139 },
+	{ {0x71765b30, 0x95f4b9f2, 0xf04e5534, 0x02e74061, 0x91506a8b }, 19 },
 	{ {0x719f457d, 0x8fcbf6c2, 0x1a88e88f, 0x34fcd54f, 0x5e96ad68 }, 19 },
-	{ {0xcf088b4e, 0xefe7f426, 0xe438dd2f, 0xe7a34331, 0x40abba52 }, 5 },
-	{ {0x16351e6a, 0x7d7fc38c, 0x23b54ee1, 0x5ac6f027, 0x5621ba96 }, 8 },
-	{ {0xb98242b0, 0x8c8779d8, 0x6b516cca, 0x6d5d6e35, 0xec3600e0 }, 19 },
-	{ {0xff999ca3, 0xe78c347b, 0xdbd23cb4, 0xc7adbfc0, 0x2c20a397 }, 19 },
-	{ {0xb5cf0368, 0x4c03dd74, 0xa9d5def3, 0x4a4c2fc6, 0x21c8b20d }, 42 },
-	{ {0xd74c381e, 0xa17acb94, 0x527ef3ab, 0xaa280793, 0xa824d322 }, 19 },
-	{ {0x2c86e339, 0xbb486a84, 0xbaffee81, 0xe9eac062, 0x44363779 }, 19 },
-	{ {0x1672af5b, 0xc1740480, 0xe8302f76, 0x90589ea5, 0xb5391bcb }, 19 },
-	{ {0x2d1983a3, 0x85b4c09d, 0x317b72cd, 0xc9665926, 0x2882a412 }, 19 },
-	{ {0x352d6906, 0x6885fc2c, 0x7c75f0e3, 0xacd885f9, 0x53916d1c }, 19 },
-	{ {0x53337b61, 0xd7b86e6d, 0x18501967, 0xfcfc0908, 0xa00cc55c }, 19 },
-	{ {0x278e4d57, 0x02b2b319, 0x8d4ac1d4, 0x1fb39463, 0xf5843a3b }, 19 },
-	{ {0x117d3b78, 0x3da9c693, 0xe3fcb71f, 0xd113f7d9, 0x0895c8d6 }, 19 },
-	{ {0xe679da4a, 0xf05aa328, 0x43d2f451, 0x8b9ceb0d, 0xf63df990 }, 19 },
-	{ {0x5bbcbd47, 0xf05a2742, 0xcfb0cad8, 0x8856eb2d, 0xf6e469fe }, 19 },
+	{ {0x720054d7, 0xab4da46d, 0xb8c9fb47, 0xd17fb7e0, 0xaa79d25b }, 39 },
+	{ {0x720b629e, 0x2e22e0af, 0x15b482b1, 0x54a1473e, 0x8ab6627c }, 3 },
+	{ {0x721a2ded, 0x692d34d8, 0x64d0440a, 0xc347c608, 0x80942d19 }, 5 },
+	{ {0x72783ba5, 0xa0b9f33b, 0x4573952a, 0x1c721fc5, 0xd5025fd5 }, 5 },
+	{ {0x72815a72, 0x13f899a4, 0x54bcf767, 0x33834ba4, 0x99d35cd8 }, 6 },
+	{ {0x728340e9, 0x5ad58ab9, 0x89a59f61, 0x317a45ab, 0x1f6b0bdc }, 3 },
+	{ {0x72845ccc, 0x50f71456, 0x2ddb87f9, 0x78c99b40, 0x76aa120a }, 42 },
+	{ {0x72afbebb, 0x12098ade, 0x1ec26dcd, 0x65890b60, 0xb2c705d0 }, 3 },
 	{ {0x72ddee44, 0x16abba09, 0x4c0c6ff1, 0x09248fee, 0xcf648946 }, 19 },
-	{ {0xa8ac24a7, 0x02d2c850, 0xc7a15b51, 0x96893817, 0xb0c93123 }, 5 },
-	{ {0x7fef9411, 0x858b1ff3, 0xff019646, 0xe9e7aa0c, 0x61c7e87d }, 19 },
-	{ {0x175488d7, 0xef82b5ee, 0x94eebce3, 0xb96ef675, 0x30f7bad9 }, 19 },
-	{ {0x8f74c91e, 0x6598d8de, 0x188ae1b5, 0x06c44229, 0xc768b11f }, 19 },
-	{ {0x8dd49e12, 0x677443ae, 0xde319f41, 0xbf3f82a0, 0x8d0e5b5d }, 19 },
-	{ {0x14f2d64d, 0x05e2e53e, 0x876e3d6a, 0xf0a5711e, 0x557e3c96 }, 19 },
-	{ {0xa8eff8c5, 0x32da894c, 0x86198b04, 0xb0a5d770, 0x7feb28c5 }, 19 },
-	{ {0xebceb3de, 0x22e4c044, 0x4a969d83, 0xee487f8e, 0xe34204e4 }, 6 },
-	{ {0xf373723b, 0x18cb7534, 0xba1e8de6, 0x1d484800, 0x478ee604 }, 19 },
-	{ {0x50439f12, 0xddff3ed4, 0x49da3cc1, 0x442385aa, 0xba609e7d }, 19 },
-	{ {0x4e17efbe, 0x87adc232, 0xc055d0dc, 0x26eb4476, 0xc661aafe }, 19 },
-	{ {0xb3b31931, 0x1243e20a, 0x25712fbe, 0x861f4e6e, 0xa7f36915 }, 19 },
-	{ {0x249da12e, 0x2711c643, 0xc5e18cf9, 0x6184d33d, 0xbf7e2305 }, 19 },
-	{ {0x45bd8130, 0x39977750, 0xc9a34795, 0x2d2e527a, 0x4e1674c5 }, 19 },
-	{ {0x010d5f32, 0x5fc38c5b, 0x590841d1, 0x5ce4f07d, 0x59f2a4cb }, 19 },
-	{ {0xa0d85c5f, 0xc74547f4, 0x6025369d, 0xa687569f, 0xb5aa3991 }, 19 },
-	{ {0x2f1aacc5, 0xd18973e5, 0x9f9eafa2, 0x0d7ffddc, 0xa34d0ef9 }, 19 },
-	{ {0xc3680636, 0xefd8d2f3, 0xa7c1c677, 0x4dd36399, 0xc754b71d }, 19 },
-	{ {0x33352b5e, 0x33057beb, 0xe0c9b989, 0xafe90f17, 0x8aba7243 }, 19 },
-	{ {0x82bf8016, 0x6e77f99a, 0x6f1e091f, 0x97f8ab16, 0x7373dc60 }, 19 },
-	{ {0x16f06109, 0xc57de5a3, 0x9fbe150d, 0xe9c25754, 0x483ee9fb }, 5 },
-	{ {0x4ff12fc3, 0xadf389a1, 0xf76a7a9b, 0xab6b2fd2, 0x0044f5b4 }, 19 },
-	{ {0x53814fdf, 0xeacce237, 0xbb68fb90, 0x56d005eb, 0x614b708a }, 19 },
-	{ {0xe9398ace, 0xb9f8a648, 0xe4bcebe0, 0x2e5d7b14, 0xa3744c7d }, 19 },
-	{ {0x90df6329, 0x2fc2f210, 0xb88cc8ec, 0x28439142, 0x3d21c917 }, 19 },
-	{ {0xfd1eecd9, 0xc89f4774, 0x1276433b, 0x99b75eca, 0x2930b58d }, 3 },
-	{ {0x3c29eef3, 0x81d77f8c, 0x1f425a3e, 0x29919013, 0xc72f875c }, 19 },
-	{ {0xf6711e1e, 0x2bac04d4, 0x5b8988f1, 0xd03529ad, 0x777abf4e }, 19 },
-	{ {0x049e7dcc, 0xd3977049, 0xb5f68aad, 0x7754105b, 0x014ba771 }, 19 },
-	{ {0x3888c923, 0xf8231448, 0x9405c38b, 0xd6110ab2, 0xfdbc1a61 }, 19 },
-	{ {0x6420473e, 0xc647e4d7, 0x50bc2247, 0x020b6722, 0x435b5211 }, 19 },
-	{ {0xa2109da0, 0x8b1921c4, 0xb3b47c68, 0x47598d42, 0x4581b508 }, 19 },
+	{ {0x72fccb4e, 0xc1889db0, 0x5fe815b4, 0x3857b18e, 0x818bf917 }, 67 },
+	{ {0x7300d44a, 0x753dacf5, 0x82d3079e, 0xd09eafc9, 0xdd629530 }, 19 },
+	{ {0x7341efc0, 0x39394ec1, 0x59feebcf, 0xaa9d4a61, 0xebf08a18 }, 4 },
+	{ {0x73938f51, 0xfcb26349, 0xaa17e1ae, 0x1f1bd43b, 0x20ef227b }, 19 },
+	{ {0x7393f677, 0xe0fae5fc, 0x83071c6b, 0x74756117, 0xb7d75e2d }, 3 },
+	{ {0x73a40e7d, 0x6da2bc84, 0x89297fd5, 0x7b7b93b2, 0xaa5a6440 }, 61 },
+	{ {0x73e3a43c, 0xabbe2a4e, 0xa504a06b, 0x88ccf7f0, 0xb066c726 }, 19 },
+	{ {0x73ec2585, 0x4aae297c, 0x9c3da0a2, 0xd4b4f1ea, 0xe14fe8c6 }, 19 },
+	{ {0x73f2ddb6, 0x1f15fcbd, 0x143e20e3, 0x520df8d7, 0x3e98dedb }, 19 },
 	{ {0x7428159d, 0xf6bf4ecc, 0x84a3ed9f, 0xb302b2da, 0x059475d7 }, 19 },
-	{ {0xda80f0bc, 0x07cb0ed3, 0x6c7c1065, 0x64b5f043, 0x53eb176a }, 19 },
-	{ {0x6a7ab69c, 0x47cc168d, 0xd872d32f, 0x395541be, 0x4939255e }, 19 },
-	{ {0x5ea3d992, 0xdb53de3a, 0x19853173, 0x6d8926de, 0x8401b8c8 }, 19 },
-	{ {0xcd2557fe, 0x39ba4dce, 0xd3219152, 0xc6a6d02c, 0x2219b360 }, 19 },
-	{ {0x49e2331f, 0x97ea9352, 0x329dafbe, 0x0627a238, 0x063ce6b7 }, 19 },
-	{ {0x4f73ba24, 0x163946f6, 0x247523fc, 0x3f2aa5de, 0x00c3d7a6 }, 19 },
-	{ {0xde5da311, 0x941056a9, 0x0cab28fd, 0x91522c05, 0x4871513f }, 19 },
-	{ {0xd1fcd47f, 0x6b68fcee, 0x9914b32f, 0xd48b2634, 0xcf60c994 }, 19 },
-	{ {0xb3d57f96, 0x8fdfebe7, 0x7f78c05f, 0x4a075d13, 0x9f219ae0 }, 19 },
-	{ {0x136f2ded, 0xd45f4419, 0x837eb1e4, 0xe623cb1d, 0xc317ef39 }, 19 },
-	{ {0x43c6a757, 0xce5ec5a2, 0x21e6c0e9, 0x22638f68, 0x8de8fd8b }, 39 },
-	{ {0x00ffd7ad, 0xfc0a7a34, 0x2912344a, 0xd64902e2, 0x26b3ad41 }, 19 },
-	{ {0xb3c2dc4d, 0x1c940ddb, 0x4b9e742b, 0x8f5a47ab, 0x1e2d385f }, 19 },
-	{ {0xc1c5ec40, 0x42760880, 0x216f781e, 0xbd5e7174, 0xa3b0f9ca }, 19 },
-	{ {0xd147f2ca, 0xc0600527, 0xce49bfff, 0xc865c54e, 0xb783e5e5 }, 6 },
-	{ {0x174437bf, 0xb20e2895, 0xf0f55260, 0x2da823ca, 0x17b2fe93 }, 19 },
-	{ {0xea8d86ac, 0x74dcdca1, 0xc72daae5, 0x17722431, 0x767c5ad2 }, 19 },
-	{ {0xb1a154ed, 0x8f52c2a7, 0x4457e1c0, 0x3c996081, 0x81dfb8ee }, 39 },
-	{ {0x9b815efa, 0xa927c118, 0x27acfdb0, 0xf9b9197b, 0x5ac97572 }, 19 },
-	{ {0x9b559703, 0x41aaab59, 0xa73ae921, 0xc6ccf290, 0x09c1a8f0 }, 19 },
-	{ {0xbe165012, 0x55617bad, 0xe264dbf6, 0x3dc59008, 0xe1d84ac8 }, 19 },
-	{ {0x1074acd3, 0x7ee42661, 0xd86b75a8, 0x491365ed, 0x8ceaa6e0 }, 39 },
-	{ {0x23b1b225, 0x8b36997c, 0x97c02478, 0xfd17d0ff, 0xa22f9cc9 }, 39 },
-	{ {0x503cbad7, 0x516c6fde, 0x89761388, 0xab32845f, 0x35284cc6 }, 19 },
-	{ {0x7dbeaf25, 0xe3a1a66f, 0x9c6b3313, 0x32dc36e7, 0x3b511d4a }, 19 },
-	{ {0x0f7f55fe, 0x448d20fc, 0x65dc03c2, 0xa4f17177, 0x61671e43 }, 19 },
-	{ {0xe6af71c9, 0x9290b6ff, 0x2da9d366, 0x7e204665, 0x1e2c9fca }, 19 },
-	{ {0xdfd7ef6f, 0xd86efd5c, 0x8019b59d, 0x8fa5c5a4, 0x7cf90cd0 }, 39 },
-	{ {0xe93da3d1, 0x910d513d, 0xbb78ad59, 0x9adbb05e, 0xb92b5930 }, 19 },
-	{ {0x09d2563f, 0xd5d9df09, 0x5aa48be5, 0xead7771c, 0x23c50ad2 }, 19 },
-	{ {0x4a35065d, 0x97d81a94, 0xa7649d19, 0xb3f9abd3, 0x4f834eab }, 42 },
-	{ {0xb1d51597, 0x8727888f, 0xfe3eaf31, 0xcaf29623, 0x5893e01d }, 42 },
-	{ {0x500d7a1d, 0x81621adf, 0x8c6914c6, 0xa42d65aa, 0x44ad4588 }, 3 },
-	{ {0x8547ae0f, 0xa25b9f3e, 0x26b90d4f, 0x3e1a4325, 0xb9248549 }, 19 },
-	{ {0xbfe8046f, 0x8ccc6d60, 0x16d7752c, 0x04f06544, 0x20ef81e7 }, 6 },
-	{ {0xd77a0208, 0x790f9563, 0x985d236d, 0x79a80d73, 0x7b47f070 }, 19 },
-	{ {0xca52d26e, 0x847b23c7, 0xcaeb7d51, 0x6b5fca5c, 0xbd686ef3 }, 19 },
-	{ {0xd59ad9f1, 0x6932cc3d, 0xadb22c25, 0xe64c10a7, 0x3a055056 }, 19 },
-	{ {0x5925e88d, 0xf896104e, 0x25fc6941, 0xfcb7925a, 0xc7a277b3 }, 19 },
-	{ {0xd0ed63a8, 0xbd030231, 0x3fbdb760, 0x9d35f47a, 0xd096be3e }, 19 },
-	{ {0xe16ad038, 0x563724ff, 0xbba980a2, 0x96ef624c, 0x0826bbb3 }, 19 },
-	{ {0x08be9214, 0x5a99dd6e, 0x0539ff79, 0xdca62b2f, 0x4cc59b0b }, 19 },
-	{ {0x8309d324, 0x1e03b4a8, 0x3b3d9fe5, 0x4224178e, 0xa4e60e31 }, 19 },
-	{ {0x73ec2585, 0x4aae297c, 0x9c3da0a2, 0xd4b4f1ea, 0xe14fe8c6 }, 19 },
-	{ {0x4fa5382d, 0xf5a8ff7d, 0x631be22b, 0xb8445e7b, 0xc8018a11 }, 19 },
-	{ {0xd33fe18e, 0xde20da4d, 0xd3d6991a, 0x9c2995e1, 0x49c8fc3f }, 19 },
+	{ {0x7435a9ca, 0xec4cdefe, 0x398299ba, 0x9b6adf89, 0xc302fda5 }, 19 },
+	{ {0x744c92e3, 0xe861a9f6, 0x41da2710, 0x302b96b0, 0xa26c8dc0 }, 19 },
+	{ {0x74ae85d4, 0x4cb8ef1b, 0xae428c90, 0x200cb74b, 0xe6d56d3a }, 5 },
+	{ {0x74d1c7f6, 0x6242335c, 0x736da294, 0x13037bd2, 0x3384efaa }, 38 },
+	{ {0x74e9ea38, 0x1e2fed07, 0xd989d105, 0x6002de57, 0x37125aaf }, 5 },
+	{ {0x74ead27e, 0xec8d8761, 0x44c2a015, 0xc0260d6d, 0xb2117d72 }, 57 },
+	{ {0x751571d2, 0x1457d89e, 0x5c52c456, 0x57bfe9a6, 0x17ae8e14 }, 62 },
 	{ {0x751d722a, 0x4f36a03e, 0x88ac6211, 0x8ae8d880, 0xe40c1c84 }, 19 },
-	{ {0xadb39773, 0x09d373ad, 0x1dc995ae, 0x7d2f8280, 0xf1673d66 }, 19 },
-	{ {0x8b828d33, 0xdcdfd324, 0xdf1827ef, 0x79f5ca96, 0x35968c6e }, 19 },
-	{ {0xd71b0de8, 0xae4e1d57, 0xace2d1f6, 0x6cac1c19, 0x65102019 }, 19 },
-	{ {0xc551d8cb, 0xe7a2e1e3, 0x4d6662f5, 0x861336df, 0xfad05397 }, 56 },
-	{ {0xb8131232, 0x19446f16, 0xcd10b916, 0xcc18ec4a, 0x8d7c69de }, 56 },
-	{ {0x39a91558, 0xbba92b73, 0x10455cd7, 0x513276d4, 0x87de0f9d }, 56 },
-	{ {0xb3942217, 0xa49f9aed, 0x9497886b, 0x45c03cf0, 0x798dc7e3 }, 19 },
-	{ {0xf01f75f8, 0x14447316, 0xffe25ce9, 0xfc0928de, 0x8622c850 }, 19 },
-	{ {0xf3c0c1f0, 0xec3e10cd, 0x4a5eaae2, 0x6d593198, 0xb1a5ab9a }, 19 },
-	{ {0xfa5badc3, 0xd9486d97, 0x89b05b90, 0x9125bf74, 0x059d26e5 }, 42 },
-	{ {0x22d8ac99, 0xef692675, 0x210f101e, 0xb4e688cd, 0xe9b2d7f5 }, 3 },
-	{ {0xe73a449e, 0x34652c18, 0xaf0a72ab, 0x5c3637af, 0xa57d5842 }, 19 },
-	{ {0x8ab1b72c, 0xe852a778, 0xa645f566, 0xa70fa18e, 0xe32fd021 }, 19 },
-	{ {0x83dee5f1, 0xfd4bdad3, 0x3b095ed1, 0x5870c52c, 0x96becc63 }, 19 },
-	{ {0x059ab9b1, 0x67c0e71b, 0xda811145, 0xa6ea04f0, 0xa41a0bdf }, 19 },
-	{ {0xb550757c, 0x8f5b55db, 0xde16b4a7, 0x888f1099, 0x9f01acfd }, 4 },
-	{ {0x3cffef3c, 0xadd60fa3, 0x54da6a34, 0x9bf970bc, 0x1db15915 }, 19 },
-	{ {0x6a5e4d81, 0xddc779e6, 0x289987da, 0x4a4ad4c2, 0x0461cef0 }, 19 },
-	{ {0xd198fda8, 0x238f8060, 0x7818c41c, 0x86455e1a, 0xe29f9a3b }, 19 },
-	{ {0x4340a258, 0x0c949d49, 0x8d2c8e71, 0x699fff86, 0x0214e9ea }, 6 },
-	{ {0xdf797593, 0x395346e9, 0x4aa1cf13, 0xa9524e30, 0xd631888d }, 19 },
-	{ {0x889954ae, 0x4772156a, 0xeb22fea0, 0xbdf8c9cf, 0x01bec51d }, 19 },
-	{ {0x82868a81, 0xd805fb39, 0x1fce5886, 0x23fc8882, 0x96cbf62a }, 19 },
-	{ {0x3b6fd6a7, 0x8807e700, 0xa38f9ecb, 0x145ab284, 0x7c862f52 }, 19 },
-	{ {0xa2a9d030, 0x3cb0b36a, 0x73d58e42, 0xb7c2c976, 0xc540597f }, 19 },
-	{ {0x01788f62, 0x38dc934f, 0xbc843aab, 0x85fdc058, 0x1ed96989 }, 19 },
-	{ {0xeed68d25, 0x4a17d76c, 0x36e094dd, 0x8a50a362, 0xa964e1b7 }, 19 },
-	{ {0x4f893002, 0xdbb9d456, 0xa16c7220, 0x6a2eedab, 0x2644936b }, 19 },
-	{ {0x7cd94e00, 0x51e1899a, 0xe4a5d6eb, 0xf3da4c32, 0xaa1f6911 }, 19 },
-	{ {0xd131d718, 0xf57aef3a, 0x5469c678, 0x5e342a63, 0x128bf6d1 }, 55 },
-	{ {0x82a5b004, 0x96eb1b97, 0x41a9540a, 0x89085e86, 0x443e76c5 }, 56 },
-	{ {0x22e095ee, 0xfb53adf4, 0x7648520f, 0x117afd8b, 0xfafa63d0 }, 56 },
-	{ {0xe7af2142, 0x4b222331, 0x88335fa8, 0x2e212438, 0x054ae377 }, 19 },
-	{ {0xfa6a5fda, 0xcf29ef40, 0x519f69b8, 0x704dbbfb, 0x250789e7 }, 19 },
-	{ {0x208f8029, 0x29913bd2, 0x683bf86b, 0x587f6398, 0x11c3419e }, 19 },
-	{ {0xeafd8cf8, 0x6facdeb0, 0x38e87900, 0xde4f1233, 0xdd69347c }, 19 },
-	{ {0xc5de32b8, 0x37d16a06, 0x6542e0ce, 0x36d5e85b, 0xd4931d49 }, 39 },
-	{ {0x91186f36, 0x1c832360, 0x5c79dc45, 0x51a768a4, 0xb9c5a320 }, 39 },
-	{ {0x4db63ea4, 0x53df9d17, 0xcf84a0f9, 0x77f47684, 0x38ec9c45 }, 39 },
-	{ {0x17315e6b, 0x40f89c2c, 0xd0d8929e, 0xefcb9394, 0xb04e4cc6 }, 39 },
-	{ {0x8bd0de57, 0xbe23b8d3, 0x8a790119, 0x6f06050b, 0xfaf48980 }, 19 },
-	{ {0x6dfc622e, 0x350d2985, 0x9f05fddb, 0x3fa1f974, 0xcd4c8bf2 }, 19 },
-	{ {0xb9d2e0b6, 0xbb7f2b02, 0x7c9beb0c, 0x762d127e, 0xfcfff127 }, 19 },
-	{ {0x52f95f6f, 0x4261be00, 0xae1b9caf, 0x88a05c02, 0x1c229e28 }, 19 },
-	{ {0x1f47ccfd, 0x979e653b, 0x96c9d7a3, 0x6f62daf3, 0xa186e186 }, 19 },
-	{ {0x9b4da763, 0x6809d569, 0x0d6bd5d7, 0x82ffa3cf, 0x9f4c63ec }, 39 },
-	{ {0x6ce0632a, 0xcc2351ae, 0x968d7d3c, 0xe9c9a0af, 0x05c713cf }, 19 },
-	{ {0xde6db54c, 0xef2cc4cb, 0xcc09c57c, 0x8ed0a1ff, 0x01347b6e }, 19 },
-	{ {0x28aaf59d, 0xadb425c1, 0xef6fca86, 0x0439f4e4, 0x2e1737b8 }, 19 },
-	{ {0x47de7524, 0xc32e72e8, 0x49daee4d, 0x7f3e6cf3, 0x93e3b7dc }, 5 },
-	{ {0xb188980c, 0x998d1dfb, 0x5dfbc218, 0x37ffbbb5, 0xaffdbb3c }, 5 },
-	{ {0xbadcb43e, 0x490e3713, 0xbf291e83, 0xcff204e1, 0xc57ecdfe }, 5 },
-	{ {0xf50d0c66, 0xb08c47b5, 0x99259522, 0x76243e20, 0x08668185 }, 5 },
-	{ {0x9dddbce9, 0x4fb98776, 0xad01870b, 0x98f44687, 0xb8b068c9 }, 19 },
-	{ {0xaa2aaa19, 0x3cddd15c, 0x23068449, 0x9d68bf73, 0xf715ed9c }, 19 },
-	{ {0xb815cb22, 0x2a6314c1, 0xadad0945, 0xaf7be759, 0xa14c200a }, 19 },
-	{ {0x25a51cd9, 0x367c4614, 0x291013b8, 0xa816fa5e, 0x8a2a564c }, 19 },
-	{ {0xe7324782, 0xc7bec087, 0x10531227, 0x50439849, 0x07cbfe1f }, 19 },
-	{ {0x818d9150, 0x5ad39bba, 0x2eaf7f48, 0x57c7d41e, 0x95fcb233 }, 5 },
-	{ {0xda1f2074, 0x66a88b34, 0x7e995a6e, 0xd7d960c7, 0xcec5aa8d }, 19 },
+	{ {0x7538fe6f, 0x0dfbf72b, 0xa7a89d34, 0x9258afdf, 0xf547b4c1 }, 19 },
+	{ {0x75794b50, 0xc0ea8ca3, 0x3d6ffa8e, 0xc3b68eb2, 0x1c35d0d2 }, 39 },
+	{ {0x75d3b72d, 0x9ceeaa55, 0xc76223d9, 0x35629a30, 0xae4124d6 }, 3 },
+	{ {0x75eb441c, 0x8298b7fd, 0x3982999f, 0x772e4c8b, 0x983ef17f }, 3 },
+	{ {0x76107162, 0x2b60384e, 0xc38e964f, 0xa2b2ee12, 0xd3d0b2c9 }, 19 },
+	{ {0x761ab0aa, 0x7f528bf0, 0xf51ea9de, 0x75c847ea, 0x949478d7 }, 19 },
 	{ {0x76209c36, 0xbec7ca97, 0x1c6db2e3, 0xbbce2671, 0x47e4a361 }, 19 },
-	{ {0x58e335c9, 0x43d2647c, 0x3ff1e689, 0x069d9fa5, 0xe1c7ff6e }, 19 },
-	{ {0x1c4e9d38, 0xa8f57212, 0xdbf12f7a, 0xaba65496, 0x83b93ed4 }, 19 },
-	{ {0x1e2abac0, 0x1eb37e43, 0xa7a61da2, 0x5dc147bb, 0xdc30ad32 }, 19 },
-	{ {0x15cc2f74, 0x12373253, 0xe908689a, 0x778738d5, 0x2656ad74 }, 19 },
-	{ {0x50554269, 0x1f3d40ca, 0xcf7779e4, 0x22477172, 0x8c426059 }, 19 },
-	{ {0x1a6c5ba0, 0x3e0cc76f, 0x7e001784, 0xe1a20537, 0x5f5602b8 }, 19 },
-	{ {0xf27721cf, 0x9ec316ea, 0x3b18233f, 0x699febf7, 0x39b25678 }, 19 },
-	{ {0x720054d7, 0xab4da46d, 0xb8c9fb47, 0xd17fb7e0, 0xaa79d25b }, 39 },
-	{ {0x939ed605, 0x3363112c, 0x34766335, 0xb93d0ddf, 0x25059468 }, 19 },
-	{ {0xe62f5f66, 0x8ea615b6, 0xec24ab5a, 0x593aad5b, 0x3bf61558 }, 19 },
-	{ {0x8b3994ab, 0x39768f15, 0x617fb2cd, 0x91990002, 0x26b935bd }, 19 },
-	{ {0xa3090a15, 0xc95334da, 0x3e0f9403, 0x0eadee02, 0xb5032c0c }, 19 },
-	{ {0x4ac9fc27, 0xa4a7b87e, 0x2c2347f5, 0xa420a6e8, 0x46555263 }, 19 },
-	{ {0xb0406a38, 0x453c3bff, 0xcc990576, 0xbb725bbf, 0x7acaf132 }, 19 },
-	{ {0xa68733d2, 0x2706aa04, 0xd261147d, 0x67f2a0a9, 0xc17c386f }, 19 },
-	{ {0x176c82d9, 0x69a8bef1, 0x71bdc2b7, 0x91520195, 0x7f43b260 }, 19 },
-	{ {0x003d5898, 0x8d120823, 0xc84f6617, 0x326f5df8, 0x3c7e5131 }, 55 },
-	{ {0xd0018f19, 0x2ca6a1b7, 0x8fed9ace, 0xf58db389, 0x848add3e }, 55 },
-	{ {0x0f81ebbd, 0x3d027965, 0x00b3f862, 0xfe1a8d58, 0x4fb228d3 }, 56 },
-	{ {0x65e427d3, 0x282fb471, 0x92e4a0f4, 0xa09245cf, 0xe1b00834 }, 56 },
-	{ {0x609d0bac, 0x4933d1bc, 0xc877746a, 0x3e14d82c, 0x204f40e7 }, 19 },
-	{ {0x57827f8d, 0x49369e4d, 0xbf20a968, 0xe535374d, 0x35ff1648 }, 19 },
-	{ {0x5017abec, 0xa8fbed43, 0xff2fd1a9, 0x36843acd, 0xc7192dcc }, 19 },
+	{ {0x763a0c9e, 0x1f2f847d, 0x79e60da4, 0xc6251ce0, 0xad80cb70 }, 19 },
+	{ {0x76461e05, 0x3178371a, 0xeb457588, 0x233cbfcc, 0xd0d6c02a }, 19 },
+	{ {0x765413bb, 0x6b03bc3b, 0xb888ee8f, 0xe00b99ef, 0x69c1317a }, 29 },
+	{ {0x76666da5, 0x870d1901, 0x026e3dde, 0xd3f22ce7, 0xa706689d }, 3 },
+	{ {0x76a67138, 0xd445557e, 0x0c079424, 0xacdff3c6, 0x0423d8ec }, 19 },
+	{ {0x76a79dd0, 0x554b8f7e, 0x84468fcd, 0x3bf73459, 0xce4aeb2b }, 19 },
+	{ {0x76b7a5e7, 0x5d5091f0, 0x482746e5, 0xa0c0a71d, 0xe07ddf83 }, 5 },
+	{ {0x76c191bf, 0x7dcc0888, 0xd65e543c, 0x47f615ae, 0x45b75b92 }, 19 },
+	{ {0x76d48849, 0x7d9ba54b, 0x302a4326, 0xf45909f6, 0x43bdcd7a }, 19 },
+	{ {0x770805bd, 0x0be8b09a, 0x3be10030, 0x060d6ad8, 0xdc07d1c3 }, 19 },
+	{ {0x772ad4ea, 0xbbf0941a, 0x9b4655f5, 0x615f2a5c, 0xf22246b1 }, 5 },
+	{ {0x7752b662, 0x4fb80d94, 0x99aaad28, 0xdd5776ec, 0x74565576 }, 5 },
+	{ {0x7768195d, 0x49ad389d, 0x388468c4, 0xf24a53a5, 0xf53e3c5d }, 56 },
+	{ {0x778472f9, 0x113eb6a8, 0x0144cc71, 0x7151eb48, 0x474b9d34 }, 19 },
+	{ {0x77bd67d5, 0xd10d459d, 0x343e79ea, 0xfcd8e17e, 0xb0f209dd }, 42 },
+	{ {0x77d95640, 0xc80bc486, 0x8d04a913, 0xf9dbf4b5, 0xf6d877d2 }, 6 },
+	{ {0x77f2d9d2, 0x7724a7c7, 0x1c688a59, 0x8d34bd0c, 0x8a8e56d0 }, 3 },
+	{ {0x77f3f675, 0x8bd4cf5d, 0x2b44c51d, 0xe958aa96, 0x7c41a9d7 }, 19 },
+	{ {0x77fcce7b, 0x7c9c915f, 0xb0adff05, 0x9141d4d4, 0x307f5a22 }, 5 },
+	{ {0x78079266, 0x711e6042, 0x0480e4d9, 0x5a39f0d7, 0xd974ad32 }, 19 },
+	{ {0x78507f3f, 0x8b8601d9, 0x9bbedb65, 0x17bec6cd, 0xdf0bd5b4 }, 5 },
+	{ {0x78818059, 0xd126e80c, 0x33ab654e, 0x9ec749cf, 0x336f8f96 }, 19 },
+	{ {0x788c5365, 0x7d9ea180, 0xd04f29cc, 0xaf1f1c29, 0xa9b75519 }, 6 },
+	{ {0x788ce4ba, 0x8d7e881d, 0xd2d3cc69, 0x7c2dd88f, 0x44e27798 }, 39 },
+	{ {0x78b1bb63, 0x975d2b51, 0x39089853, 0x9c075bf4, 0xbdd72343 }, 19 },
+	{ {0x78cd7f84, 0x7e77fd8c, 0xd51a647e, 0xfb2725ba, 0x93f4c471 }, 64 },
 	{ {0x78d3dc3e, 0x48724c1f, 0x570d1ee1, 0x671100cd, 0xd539ad2b }, 19 },
-	{ {0xd65f0010, 0xdacbd252, 0x8eaa2546, 0x7ef007a8, 0x7f17ae7a }, 19 },
-	{ {0x3136bee4, 0xc7d4d20c, 0x1a5ba495, 0x16fc9499, 0xf405a5bf }, 19 },
-	{ {0x181c62bf, 0x30a66ca3, 0xc74b4165, 0xc230fb44, 0x674bdb5d }, 55 },
-	{ {0xc45a710f, 0xccac84de, 0x0d3bffed, 0x8095344a, 0xc1838f1d }, 55 },
-	{ {0x4108d6df, 0xce393ba2, 0x67993a9e, 0x51f8ad9b, 0x3ee7d3f9 }, 56 },
-	{ {0xb27a3e67, 0x215aadc9, 0xbafd80f1, 0x84c6be0b, 0x26731076 }, 56 },
-	{ {0xc60a28a4, 0x048710ad, 0x3c63ef5b, 0xcf4ce03d, 0xb54c00bb }, 19 },
-	{ {0x15345c87, 0x45028c96, 0xfc79036b, 0x2e3e180a, 0xd2f62dab }, 19 },
-	{ {0x7c87b7de, 0xd0c78132, 0x17e5b305, 0x036e5784, 0x9d0b93e9 }, 19 },
-	{ {0x372cdeff, 0x033701c8, 0x6d3e01ef, 0xe73c172a, 0xf7492dd1 }, 19 },
-	{ {0xcec8ffb8, 0x8b3c047f, 0x5dbd95d3, 0xed1cd966, 0x0803fa7b }, 19 },
-	{ {0xe19cfcbe, 0x92ec3682, 0xbee869df, 0xad5f6b40, 0x58b1f2ce }, 5 },
-	{ {0xe4f7a94d, 0x0cb43f56, 0xf73d54c2, 0x2364e914, 0x34363945 }, 19 },
-	{ {0x97e173da, 0xc64dbde7, 0xd6a60de7, 0x606cba0c, 0x860813db }, 5 },
-	{ {0xb6a5552e, 0xffcee708, 0xb665fa74, 0xe5ce7b0f, 0xa2541c03 }, 4 },
-	{ {0xd7e85888, 0x117188a6, 0xd6f7914e, 0x9649fc48, 0x21c594a2 }, 4 },
-	{ {0xfa6c059e, 0x14092d02, 0x3b1f9f2d, 0xf28e482f, 0x966287db }, 5 },
-	{ {0xd53e0c8b, 0xcd98820a, 0xfe820f75, 0x6af35cc9, 0x7911bfe4 }, 4 },
-	{ {0x632bdb16, 0x4acab52e, 0xe715c7ee, 0xfed60e0b, 0x1ae629e0 }, 4 },
-	{ {0xd0706fd1, 0x0e418eba, 0x2929d515, 0xcc0994f4, 0x9376a63f }, 4 },
-	{ {0xd3d411c8, 0xb7891aef, 0x9c59cbc2, 0x0bb4fa3f, 0xf0ca03ea }, 4 },
-	{ {0x898bda19, 0xf882c6d1, 0xdffdb217, 0x3db84a97, 0xdc21f7d6 }, 4 },
-	{ {0xbae8548f, 0xaded657c, 0xca06c2b0, 0x2a59e00c, 0xf1e55484 }, 4 },
-	{ {0x4f35f676, 0xd2f38207, 0x80783439, 0x21374c28, 0x89d06e11 }, 4 },
-	{ {0x05a53104, 0x3d13ba26, 0x1b0db37e, 0x4ef8b257, 0x986ce05f }, 4 },
-	{ {0xde765e69, 0x9af4d76d, 0x8fa80fb1, 0x0d1e4158, 0x1bec11bf }, 19 },
-	{ {0xf784350a, 0xf0c5c740, 0x7d83da2b, 0xb499c59a, 0x08496aac }, 19 },
-	{ {0x645ec2f2, 0x8f08b3ca, 0x20f0dfe6, 0x5fc7ca99, 0x3da6bfbb }, 19 },
-	{ {0x468a1e22, 0x31d790c7, 0x82c0daa0, 0x50083c1f, 0x44960e43 }, 19 },
-	{ {0x7ae2a1ec, 0xccd18b1c, 0x1877a2a3, 0x1e870ced, 0x5b7861ce }, 19 },
-	{ {0x359c8171, 0xcdfbb965, 0x854ff494, 0x2a740d40, 0x45eb5ff5 }, 19 },
-	{ {0x46e9ed7b, 0x7f6dfda8, 0xeee26647, 0x6c9ebc4d, 0xd9d8fcc2 }, 19 },
-	{ {0x66d18c97, 0x14112d2b, 0xd0063a10, 0x10ce0330, 0x4b0a5038 }, 19 },
-	{ {0x4cede763, 0x79308294, 0x74e0bd2b, 0x640b328a, 0x41b51a5c }, 19 },
-	{ {0xe5f138be, 0x98b4ff18, 0xe8bc3baf, 0xbdbb65f4, 0xfdbc378b }, 19 },
-	{ {0x3d36aaa5, 0x8909b813, 0xbff34b4b, 0x1b738dbc, 0xf807b86a }, 19 },
-	{ {0x37262340, 0x1599c579, 0x68daac03, 0x12dd9a0a, 0xbbc6bd2f }, 19 },
-	{ {0xef42e667, 0x558979b4, 0x4785a0f0, 0xd87d9d6a, 0xefc96b4d }, 19 },
-	{ {0xb030b3c2, 0x2baadd0d, 0x419657dc, 0xfa4b974a, 0xe1cd7508 }, 19 },
-	{ {0xffa8fc57, 0x56f7e1d1, 0xef168618, 0xf5606aca, 0x10f8b2c7 }, 19 },
-	{ {0xa9d371c0, 0xeec519c4, 0x8af880df, 0x540e03da, 0x572f263d }, 19 },
-	{ {0x3da301b1, 0x082c158e, 0x505523fa, 0x22c19f1b, 0x3f4d851c }, 19 },
-	{ {0x57034994, 0x710a9d74, 0x4c768493, 0x679b78ca, 0x06b9dc8d }, 19 },
-	{ {0xd88f33ee, 0x40839f87, 0xcdce6cc4, 0x820e1dd1, 0x92a01776 }, 19 },
-	{ {0x59679b1e, 0xd40416f4, 0xc8d65085, 0xe5473c62, 0x1bea6ac4 }, 19 },
-	{ {0x2f4404d1, 0x41acc40e, 0x48af0b12, 0xc70cd44b, 0x066ece10 }, 19 },
-	{ {0xc9440172, 0x802818cc, 0x5b9ae559, 0xfbd3f346, 0xa263605c }, 19 },
-	{ {0x9d5f6098, 0xb71712e9, 0xd9e38673, 0x9b82fc48, 0x4380f114 }, 19 },
-	{ {0x71442ac7, 0x03c29661, 0x42b04071, 0xfedf180e, 0x81daab9a }, 19 },
-	{ {0xa87971b9, 0xdf0de446, 0x44c2188f, 0x5f475aef, 0x7ae85304 }, 19 },
-	{ {0x55ed66ad, 0xa5d82039, 0x37554538, 0xb485fbe0, 0x27a2e2bb }, 19 },
-	{ {0xad3d8fc2, 0x201a245e, 0x35287591, 0x8e421b42, 0x764e4148 }, 5 },
-	{ {0x626e4fc5, 0xf12f6f35, 0x4baf6d60, 0x7beadacb, 0xbafd74ce }, 19 },
-	{ {0x07db3e3f, 0xfb16c138, 0xf9da12ca, 0xcde48bf7, 0x522a188c }, 19 },
-	{ {0xc9135b1e, 0x451193bd, 0x4c06d814, 0x3eaca934, 0xcc89fe05 }, 5 },
-	{ {0xd9826cb2, 0x044ed022, 0x4124f2f3, 0x1d0bdc1f, 0xb840d81c }, 5 },
-	{ {0x2fc15ef2, 0xc728a247, 0x2cfa3a34, 0x053e07f8, 0x21dc18d4 }, 4 },
-	{ {0x66508bbd, 0xc3b133b9, 0xa69ea967, 0x89bc134e, 0xea46796a }, 6 },
-	{ {0x5fd07ed5, 0xb7c0492d, 0x42ed91a5, 0x4a0fe80c, 0xe6e4e40d }, 9 },
-	{ {0x1f17e461, 0x90635a32, 0x14057d33, 0xad4a7689, 0x39d5a071 }, 6 },
-	{ {0xcb544661, 0xb6da6a35, 0xc20bfe50, 0x3974f2b7, 0x9a3c4550 }, 5 },
-	{ {0x5ef7d03b, 0x138a2023, 0xf6def241, 0xb671c666, 0xf97ed83b }, 4 },
-	{ {0xeb58b57f, 0x468e12c4, 0x300d3a88, 0x337e6c45, 0xe532c7d3 }, 4 },
-	{ {0x5460a88c, 0x25386b1b, 0x950b57fc, 0x1325fd75, 0x587cc825 }, 4 },
-	{ {0xb58e77f8, 0x19dfbde7, 0x2845801c, 0xff4b4e0a, 0x2f20ef5f }, 4 },
-	{ {0xe78511a2, 0xb8cca37a, 0x96aa396c, 0x938863c9, 0x2a20c797 }, 4 },
-	{ {0x43084db7, 0x2dd13112, 0x450a7af4, 0xb513e13e, 0x9266defb }, 4 },
-	{ {0xaa13b346, 0xe11644f8, 0x426fc546, 0xb359bc6f, 0xd7c6b357 }, 4 },
-	{ {0x90b57b58, 0x26753609, 0x16ad68ba, 0x65e92849, 0x26d93f4a }, 4 },
-	{ {0x12f6f31f, 0x495bfb38, 0x4c9ca906, 0x7bfbf8f9, 0x8af6adf9 }, 6 },
-	{ {0xfda4422b, 0x86daa233, 0xfa4e6104, 0xe45305e7, 0xcb383053 }, 6 },
-	{ {0x11b71263, 0x3bd0e44e, 0x8d59ceba, 0x5a2d6b1c, 0x20a43ef9 }, 6 },
-	{ {0x2761df1f, 0xf6bf826e, 0x00dbd4f9, 0xa346aa14, 0x5e91c6c6 }, 6 },
-	{ {0xbe2d023f, 0x5f1ee4cf, 0xbdc712c8, 0xef9eda9d, 0x07278d88 }, 6 },
-	{ {0xf4f7c789, 0xdd320192, 0xfd544c66, 0x6ceab720, 0xc7f3a747 }, 6 },
-	{ {0x4b506234, 0xdfd3b6aa, 0x1c315b40, 0xcd8ddca0, 0x24dd15c9 }, 4 },
-	{ {0x03055770, 0x6d72199a, 0xcf17df44, 0x80f6b1a8, 0xff798d1e }, 4 },
-	{ {0x54b05b9c, 0x064232d7, 0x5299fd31, 0xb53335f5, 0x30c20aea }, 4 },
-	{ {0x937f8d41, 0x2e9810c8, 0xaeb9d921, 0x82cd3b00, 0x7ace30d2 }, 4 },
-	{ {0x4a306942, 0x6214aeec, 0xac1a5763, 0x2a9978cb, 0xfb2acc21 }, 19 },
-	{ {0x07793d57, 0xb00ad892, 0x7a3c1f0b, 0x1ed61c60, 0x6441dbbb }, 5 },
-	{ {0x1545566b, 0xd7decb16, 0x12009daa, 0x2daa7175, 0x8fa6e4a1 }, 5 },
-	{ {0x4a8eed64, 0x3993b86e, 0x71ea4609, 0x8a580ec1, 0x5038cbba }, 5 },
-	{ {0x55183b7b, 0x7df66950, 0xdbb65ef1, 0x065d7d98, 0x7e0fdf5a }, 6 },
-	{ {0xa8186cd3, 0xef78662c, 0x87665df5, 0x2026ecba, 0xe4866bfd }, 6 },
-	{ {0xae3c3c2c, 0x022f566d, 0x2e790aba, 0x193470d5, 0x826f36cf }, 6 },
-	{ {0x875a262b, 0xe44a27a8, 0x357f1700, 0x80fb8466, 0xc9599b62 }, 6 },
-	{ {0x1064aa5c, 0x8a884ddd, 0xc0a27147, 0xca70881e, 0x04988725 }, 6 },
-	{ {0xe8e41697, 0x7f5dae36, 0x35362c51, 0x3bba004e, 0xa89a0bf4 }, 6 },
-	{ {0x9c89215d, 0xd36eded7, 0x69691708, 0xeb8c82de, 0xc1ce5109 }, 6 },
-	{ {0x1642891b, 0x693df616, 0xf2743129, 0x9352e1d7, 0x750ac94b }, 5 },
-	{ {0x452deac5, 0xb3341437, 0xe70c5b27, 0x26aa26cc, 0x1d074fba }, 5 },
-	{ {0x9e790499, 0xaf6916f8, 0x2809e35d, 0x68cc159e, 0xfe580f99 }, 17 },
-	{ {0xc843b8b0, 0xe5ed98d3, 0xbae68e70, 0x1fb709ea, 0x178ed968 }, 17 },
-	{ {0xb210047a, 0xf5ccc352, 0xcc044bf6, 0xc1419552, 0x223bf8dc }, 17 },
-	{ {0xc4a919f3, 0x1d20008b, 0x5d6540aa, 0x5d2be59a, 0xa4cef5cf }, 5 },
-	{ {0x1aee947b, 0x1ad6d478, 0xc0def550, 0x868a3851, 0xc2910809 }, 5 },
-	{ {0xa3fbf7c2, 0x392c1f97, 0xd3a0946a, 0x5d1654bf, 0x4f7d9b0a }, 17 },
-	{ {0xe89fc743, 0x7d8f9aed, 0x1640689a, 0x32ebbf04, 0x7699b147 }, 5 },
-	{ {0xae8172bc, 0xf76adfa3, 0xd401467c, 0xbc89cbec, 0x2db86ee2 }, 5 },
-	{ {0x5d82713f, 0x36e93950, 0x92f16663, 0x084fbc85, 0xf05c664a }, 5 },
-	{ {0xa8059dc1, 0x820b4614, 0x18713acf, 0x2af14f3a, 0x25734bd3 }, 5 },
-	{ {0xe839f3ac, 0x7d52c427, 0xecc011d0, 0x1e6e241f, 0x88ca850c }, 5 },
-	{ {0xf57b4615, 0x4cf0711e, 0x3f5218e0, 0x0f67c375, 0xd95d1d5d }, 5 },
-	{ {0xa8eeac42, 0x8a5992a2, 0x390b1827, 0xdb1358f4, 0xc733e200 }, 17 },
-	{ {0xbd1435a1, 0x9ba89514, 0x9fa5b884, 0x25316171, 0xd165c323 }, 17 },
-	{ {0xefdf63f0, 0x1293251d, 0xc593163a, 0x42f31556, 0xfd042282 }, 5 },
-	{ {0x4edb5ed1, 0x2c1b9bc7, 0xefa571ca, 0x67ffc732, 0xf53d3a4a }, 17 },
-	{ {0xe58c1dd4, 0x6067e2ab, 0xaaf3ee6a, 0x70a7e554, 0x1a32017e }, 17 },
-	{ {0x32210a9c, 0xbbb51e30, 0xff59ed44, 0xbf32e628, 0xfdf6c42c }, 17 },
-	{ {0x6fd90e75, 0x73abdb5a, 0x7bd6e4e8, 0xdc44db80, 0xfc163e30 }, 5 },
-	{ {0xBF96A360, 0x083C5C26, 0x43094054, 0x6827E91A, 0x69ADE63E }, 5 },
-	{ {0x2e388978, 0xf765bc5f, 0xe1fa9a42, 0xe1f059de, 0x5053721d }, 17 },
-	{ {0x8a65786d, 0x9c6b2fe7, 0xc1643c27, 0x316d6cbb, 0x35fbfd24 }, 17 },
-	{ {0x022a53d7, 0x9bb72c73, 0x6a5fdad6, 0xd82434a9, 0x8f33e6e7 }, 5 },
-	{ {0x599c824e, 0xc92be036, 0x9accaaaf, 0x31340df6, 0xf471f202 }, 5 },
-	{ {0xe73946f1, 0xf26589d7, 0x7926276c, 0xa4f9dbee, 0x60c53fde }, 5 },
-	{ {0xc5edd1c7, 0x4e72ddae, 0xba1027da, 0x1e848e2c, 0x4fda94f5 }, 5 },
-	{ {0xa40674b5, 0xe0ba4490, 0x78cbb074, 0x06edfd26, 0x27306122 }, 4 },
-	{ {0xd66068f5, 0xa8b6cad0, 0x9ed57893, 0xceb0f3dd, 0x37ce8715 }, 4 },
-	{ {0x930b4896, 0xc1590ebb, 0xb74d3304, 0x47ec36e3, 0xfeb5cab6 }, 19 },
-	{ {0x96897697, 0xAFE3A635, 0x4F2753F2, 0x2A8B15D6, 0xD977B064 }, 19 },
-	{ {0xe36e16ac, 0xfdfa76fa, 0x72b218da, 0x2bebc668, 0xdb39d21e }, 6 },
-	{ {0x1302d258, 0xc952e936, 0x66ecec12, 0x429d6d2c, 0x2f841f43 }, 5 },
-	{ {0x90003c78, 0x975d00b1, 0xe5612fd0, 0x0dffabb7, 0x0d616ecd }, 3 },
-	{ {0xcc46a737, 0xacd729b2, 0x839ecd23, 0x7d38b4a6, 0x3cfb16cb }, 3 },
+	{ {0x78e833c0, 0xa94478b9, 0xc07e974f, 0x311dbfef, 0x1e014f1c }, 19 },
+	{ {0x792e6b28, 0x14ab783d, 0x06c7576c, 0x1e3ccd6a, 0x9bbac34a }, 1 },
+	{ {0x795d47c6, 0xaae378d0, 0xd5bedc9f, 0x104a597b, 0xcc1ee16b }, 5 },
 	{ {0x7964ba4c, 0x3c27b6a3, 0x2d397157, 0xfd38dd1d, 0xc2f1e543 }, 3 },
-	{ {0xbc06bd3d, 0x6f138da8, 0xf5d38b47, 0xe459b4d1, 0x942e49e4 }, 3 },
-	{ {0x42432076, 0x2bcbbb60, 0x81b1e186, 0xe21accf7, 0x58aeb935 }, 3 },
-	{ {0xa21adba6, 0x81956ec3, 0x5816af67, 0x3a9d4f6c, 0x7743253a }, 5 },
-	{ {0x2a4aef32, 0xdb28c059, 0xc30f5f97, 0x2f1c0970, 0x8ef6ce62 }, 38 },
-	{ {0x10c38f91, 0xd8f5db24, 0x38414ea5, 0x8f26dcac, 0x78352088 }, 9 },
-	{ {0x3f072673, 0x752badfb, 0xd234d600, 0x5ddad60a, 0x494a9438 }, 5 },
-	{ {0xd4da7236, 0xbd09d735, 0xdcb92127, 0xc73e43b3, 0xca94dd7f }, 5 },
-	{ {0x3bb2f9f4, 0xbe38b5b0, 0x8da03ee1, 0x90c39cae, 0xc30e2f08 }, 5 },
-	{ {0xfc9adbd8, 0x16109f77, 0x05f342c0, 0x1f168bb0, 0x9ca4b2ff }, 5 },
-	{ {0x35c02d8d, 0x590d9205, 0x3f083b0c, 0x0c897277, 0xa5375af6 }, 5 },
-	{ {0x772ad4ea, 0xbbf0941a, 0x9b4655f5, 0x615f2a5c, 0xf22246b1 }, 5 },
-	{ {0x1ba6b699, 0xb4e34c23, 0xee60db4e, 0x58e1265d, 0xc03f0b50 }, 8 },
+	{ {0x79c1bf77, 0xc08b733a, 0xe04e069d, 0xeaf25fd2, 0x4b28beb7 }, 19 },
+	{ {0x7a0a1c55, 0x70a3361a, 0xd75406ee, 0xa07c93fd, 0xad9fde02 }, 17 },
+	{ {0x7a0ddc5f, 0x086a6bc7, 0xe8e7f7b1, 0x84098862, 0x3a2cc1b5 }, 19 },
+	{ {0x7a402378, 0x67f62611, 0xd0e97666, 0x6451648e, 0xdb80753c }, 19 },
+	{ {0x7a412693, 0x4f9e68c3, 0x4bf00dd3, 0xd9a9e753, 0xc05ee73f }, 6 },
+	{ {0x7a786959, 0xd8fc0b51, 0x8b353414, 0x22f096dd, 0x6019468d }, 4 },
+	{ {0x7a8e82c1, 0x08b06855, 0xe39518b0, 0xf21269cb, 0xd041edf2 }, 19 },
+	{ {0x7abdf08e, 0x9c0a511b, 0x8182c502, 0xed8c5f42, 0x778437e9 }, 19 },
+	{ {0x7abf8965, 0x2396a648, 0xa84ae06e, 0x6dabc097, 0x35a75798 }, 5 },
+	{ {0x7ad00597, 0xceb5a023, 0x79055230, 0xd907c442, 0x1982329a }, 19 },
+	{ {0x7ad40ae5, 0x12bbf4ba, 0x688467ba, 0x23e16354, 0xb8421d0a }, 4 },
+	{ {0x7adb6812, 0xf3702b93, 0xaa2b2a87, 0x2722bbd4, 0x0915670d }, 19 },
+	{ {0x7ae260d7, 0x69a1e12b, 0x8f7af09a, 0x17876027, 0xa423e926 }, 19 },
+	{ {0x7ae2a1ec, 0xccd18b1c, 0x1877a2a3, 0x1e870ced, 0x5b7861ce }, 19 },
+	{ {0x7aec0134, 0xad6a5177, 0xf4056fcb, 0x6047083e, 0x8e00529b }, 42 },
+	{ {0x7b11f333, 0x2c053f19, 0x75b16c70, 0xa70cd6a4, 0x2cc57959 }, 16 },
+	{ {0x7b179856, 0x1ee1844a, 0x7d643292, 0x4fbee9b4, 0xfc591c19 }, 42 },
+	{ {0x7b4a9640, 0x2847decf, 0xc110ff9e, 0xda713bdc, 0xd218bd83 }, 1 },
+	{ {0x7b6029bf, 0xd7cb4b9d, 0x4c5ec5b9, 0xb3e3c93d, 0x00558b5e }, 19 },
+	{ {0x7b6e6451, 0x1a55eed5, 0x8ba04f34, 0xcf2547f7, 0xdf631c33 }, 19 },
+	{ {0x7b8015f9, 0x19c8dd95, 0xdb683f3f, 0x3d0799cf, 0x7ef1bc22 }, 3 },
+	{ {0x7b89c2d6, 0x2c3106a8, 0x7c3375bb, 0xc0284d2b, 0x5a364cc9 }, 19 },
+	{ {0x7b94a728, 0xa5945a53, 0xd518c189, 0x94e1e09a, 0x09ec3c1b }, 5 },
+	{ {0x7b959c60, 0x9deaf67d, 0x29e3f79f, 0x55a03f53, 0x961f129e }, 4 },
+	{ {0x7bba2366, 0x9b7abfb6, 0xa142f9e1, 0x735b847d, 0x6e4e8267 }, 1 },
+	{ {0x7be2f14f, 0xd0df5718, 0xcdb69b97, 0x2c5f7c1f, 0x284b03e6 }, 3 },
+	{ {0x7bf28813, 0xfb11e9db, 0x3bf78cc7, 0x3ee5fb2d, 0x76b547de }, 19 },
+	{ {0x7bf7bd13, 0x4ddf9ed5, 0xb489f7f2, 0xeb0aa26b, 0xb2428fc9 }, 19 },
+	{ {0x7c066cb7, 0x63f7a4fe, 0xc0474b5a, 0x09e3ef43, 0xbbf9248b }, 5 },
+	{ {0x7c0f720c, 0x7601ca6d, 0xc86c81ab, 0x6a76e058, 0x7a052f75 }, 19 },
+	{ {0x7c2743df, 0x543c0d8a, 0x4ba7e42b, 0xf7db580b, 0x996d102e }, 19 },
+	{ {0x7c3aa9cc, 0xa2f1f6e8, 0x1ae9d24b, 0x3a3c675f, 0x08a203ea }, 4 },
+	{ {0x7c50d00a, 0x0d7b8c34, 0x74ed4924, 0x65a92622, 0xca160151 }, 19 },
+	{ {0x7c618058, 0x809302bc, 0x3553d618, 0x9bcf310f, 0x2e5b0e08 }, 39 },
+	{ {0x7c7d0bff, 0x4a51bb0f, 0x1f0cdb41, 0x32fdb11f, 0x8a71c623 }, 4 },
+	{ {0x7c87b7de, 0xd0c78132, 0x17e5b305, 0x036e5784, 0x9d0b93e9 }, 19 },
+	{ {0x7cc524ba, 0x5002b92f, 0xb285ac86, 0xeaae8fde, 0x16ee027e }, 1 },
+	{ {0x7cd94e00, 0x51e1899a, 0xe4a5d6eb, 0xf3da4c32, 0xaa1f6911 }, 19 },
+	{ {0x7d07fdf5, 0x8c7a86d9, 0xf93af35a, 0x35acf2d7, 0xded02ff1 }, 4 },
+	{ {0x7d0bb1da, 0xc966ceee, 0x2e4c53f7, 0x7e6e057d, 0x65f15d4d }, 39 },
+	{ {0x7d1c7b99, 0xc73ff9d8, 0x9cced66f, 0x50ee2f8c, 0x83809881 }, 19 },
+	{ {0x7d53991b, 0x3d63ab97, 0xe2788769, 0xf1078eb5, 0x57973500 }, 19 },
+	{ {0x7d566809, 0xea870ab6, 0x81680ba3, 0xdaa8946c, 0xfcb060e5 }, 19 },
+	{ {0x7d685547, 0xc2a4b92f, 0xa62e0085, 0x4e4a9689, 0xd495f93d }, 4 },
+	{ {0x7dbeaf25, 0xe3a1a66f, 0x9c6b3313, 0x32dc36e7, 0x3b511d4a }, 19 },
+	{ {0x7dc7f7e3, 0x96694328, 0x0f348366, 0x56a7d1bd, 0x3ace67cd }, 5 },
+	{ {0x7de755f9, 0x8b6a6888, 0x6e61473d, 0x524d0aa6, 0xab6577d7 }, 19 },
+	{ {0x7dfe091e, 0x02f6c1b2, 0x1bd65e44, 0xeb5052d5, 0x64d0ef92 }, 19 },
+	{ {0x7e5024e6, 0xe6aecd05, 0xec6c8857, 0x86a4aac2, 0x87ed110b }, 4 },
+	{ {0x7e5264d3, 0x8c9d83c6, 0x2f60a74d, 0x2c51476a, 0x7ca2856f }, 19 },
+	{ {0x7e830246, 0xe183665d, 0x02ac0447, 0x8fe6f590, 0xd330be4d }, 19 },
+	{ {0x7e9a9ce7, 0xc18206b3, 0x25830e9c, 0xdcbb2717, 0x9118de96 }, 4 },
+	{ {0x7ec25356, 0xabf37208, 0x06b2b97c, 0xbabdc1f1, 0x9ed698f8 }, 19 },
+	{ {0x7ed13081, 0x79c41ae6, 0x2cfb4612, 0x4ab0ce22, 0xd8b0513b }, 6 },
+	{ {0x7ed7c55e, 0x0359737a, 0xc5e68d38, 0xcb6903f9, 0xe5d7c2b6 }, 57 },
+	{ {0x7eeeaaed, 0x7c69a524, 0x5f45b937, 0x183a203a, 0xde3c11a4 }, 19 },
+	{ {0x7f086cc2, 0xca0c35bf, 0x599f48c2, 0xd5e901e8, 0x9411239f }, 19 },
+	{ {0x7f115ff9, 0x23a1cc0d, 0x1944cf28, 0x0168add9, 0x46fde854 }, 50 },
+	{ {0x7f16f43b, 0x2197f9bc, 0xc65c564c, 0x14850347, 0x97abacb6 }, 19 },
+	{ {0x7f189caa, 0x1f0c3076, 0x0707e05c, 0x13bc50c3, 0xfb3ac441 }, 19 },
+	{ {0x7f26383f, 0xc61af7be, 0xb0176a64, 0xeb936bcc, 0xee0d7a3b }, 19 },
+	{ {0x7f5a9568, 0x9b81da98, 0x387d812e, 0x0f628046, 0x6f51b832 }, 19 },
+	{ {0x7f5b7660, 0x5e3d898c, 0xc4b5aacf, 0x1d7682b8, 0x2fe84353 }, 42 },
+	{ {0x7f6906ff, 0x7017a558, 0x95219719, 0x8ac7a1c1, 0xe222ed9d }, 19 },
+	{ {0x7fe5f17a, 0xd7e6b70d, 0xd56cad2c, 0x8bdc516a, 0x86f03207 }, 5 },
+	{ {0x7fef9411, 0x858b1ff3, 0xff019646, 0xe9e7aa0c, 0x61c7e87d }, 19 },
+	{ {0x804be214, 0x93a151a0, 0xbe2075e8, 0x6c94759d, 0xd96f0bf7 }, 4 },
+	{ {0x80669b21, 0x72dbaa2d, 0x4f9d5485, 0xd41db699, 0x5ec4e123 }, 19 },
+	{ {0x80767603, 0x8cbba043, 0xb8099eba, 0x9c5840a4, 0x811a7e59 }, 19 },
+	{ {0x80ada024, 0x1ded833e, 0x249c498d, 0x01b0bb54, 0x179e6643 }, 19 },
+	{ {0x80c82bb4, 0x010476a6, 0x79cb616a, 0xc31fc691, 0xb8e8a526 }, 42 },
+	{ {0x81143d2a, 0x8ef7cc59, 0x3a604f3c, 0xc890312b, 0x42bdff01 }, 9 },
+	{ {0x8117ec66, 0xc0645a54, 0x422841a6, 0x32cfd660, 0x2f35c4f9 }, 19 },
+	{ {0x811dca8f, 0xc14a2b00, 0xf503fbef, 0x74fdeae4, 0xf2873d4c }, 19 },
+	{ {0x8161d9b3, 0x25c708af, 0x463c5622, 0xbd89ca94, 0x754cfdef }, 19 },
+	{ {0x817019ca, 0x70a0f72d, 0x294eaa87, 0xed3cb194, 0xb99ceb58 }, 19 },
+	{ {0x817bebb1, 0xbe373e9c, 0x1bae4850, 0xa2bc1dae, 0xc5586a91 }, 19 },
+	{ {0x818a6ced, 0xbfdf3a5a, 0xf0c844f3, 0x2a18e393, 0x0178c798 }, 19 },
+	{ {0x818d9150, 0x5ad39bba, 0x2eaf7f48, 0x57c7d41e, 0x95fcb233 }, 5 },
+	{ {0x81b85b11, 0x52a59bb1, 0x0d0e0118, 0xf80f0a4e, 0xd363c785 }, 17 },
+	{ {0x81bbbd4e, 0xa86350eb, 0xba03e8d8, 0xcb29f050, 0xa3d93a83 }, 5 },
+	{ {0x81befaa4, 0x5ee3f119, 0x6b0e1ea6, 0x57b01614, 0x95601a87 }, 4 },
+	{ {0x81c50af8, 0xef09e0b7, 0xa8a69fd4, 0x715592b5, 0xe803cdb5 }, 19 },
+	{ {0x81ddaf3a, 0x42c1e1a3, 0xd3722e0c, 0xd046316a, 0x202acd33 }, 19 },
+	{ {0x820174b4, 0xdd3f3df8, 0x7e5e32fb, 0x6f7ed457, 0x542d96c1 }, 19 },
+	{ {0x821c611b, 0x851ddd4c, 0xf8cfb4e7, 0x7cecbc88, 0x2f12eb72 }, 19 },
+	{ {0x82397096, 0xd5ef436b, 0x99b943c2, 0xa52d6eff, 0x87694183 }, 6 },
+	{ {0x8262ac06, 0x9e395ba0, 0x20025caf, 0x0519e8eb, 0x5a63a0b8 }, 5 },
+	{ {0x82868a81, 0xd805fb39, 0x1fce5886, 0x23fc8882, 0x96cbf62a }, 19 },
+	{ {0x829c00c3, 0x114f25b3, 0xdae5157c, 0x0a238b52, 0xa3ac37db }, 1 },
+	{ {0x82a15beb, 0x8b31d250, 0xc12666e5, 0xe773a539, 0xad5e47c5 }, 19 },
+	{ {0x82a5b004, 0x96eb1b97, 0x41a9540a, 0x89085e86, 0x443e76c5 }, 56 },
+	{ {0x82bf8016, 0x6e77f99a, 0x6f1e091f, 0x97f8ab16, 0x7373dc60 }, 19 },
+	{ {0x82c68a93, 0xd01f103a, 0xf4fe9f92, 0x05184ffd, 0x1a36a90f }, 19 },
+	{ {0x8301e325, 0x65cc8102, 0x3c71da10, 0xf2f3e2f8, 0xbefb7e3f }, 19 },
+	{ {0x8309d324, 0x1e03b4a8, 0x3b3d9fe5, 0x4224178e, 0xa4e60e31 }, 19 },
+	{ {0x830efa0b, 0x25e1cf34, 0xd5f55d08, 0xcb80709d, 0x0a2c82ec }, 19 },
+	{ {0x835b3e2b, 0xae1d680d, 0x7050ce18, 0x8c617fbc, 0xfb326eb3 }, 19 },
+	{ {0x83dc4599, 0xfb670605, 0x9424695c, 0x58e7dd7b, 0x3041a846 }, 19 },
+	{ {0x83dee5f1, 0xfd4bdad3, 0x3b095ed1, 0x5870c52c, 0x96becc63 }, 19 },
+	{ {0x83df4081, 0x529fe5b8, 0xbb0a3601, 0x614d36c8, 0x384c9202 }, 19 },
+	{ {0x83ed71c0, 0xe245a35c, 0xc4c4f622, 0xa6c88c02, 0x6140748f }, 19 },
+	{ {0x83fa6a78, 0x47faf14b, 0x6ebfae46, 0x37ac8868, 0xc869c7f5 }, 19 },
+	{ {0x83fba433, 0x71d8d3c5, 0x0a97c969, 0x23e52b40, 0xdf2a7816 }, 19 },
+	{ {0x83fce8c3, 0xe4843c4b, 0x1782b9ef, 0x83413c98, 0xf081d12e }, 19 },
+	{ {0x83fdaa42, 0x9ad8b155, 0xab2328a7, 0x2fcb8de6, 0x42ff5615 }, 19 },
+	{ {0x83fed409, 0x0d0942c8, 0xe0054437, 0x745c1c0e, 0xbefc6222 }, 19 },
+	{ {0x842009e0, 0xf7d0e977, 0xe47be7a5, 0x6fe60707, 0xf477ed93 }, 4 },
+	{ {0x8449cdf1, 0x61babec8, 0x5508c35c, 0x8ca64a5c, 0x1fd7671d }, 4 },
+	{ {0x84566b5f, 0x37ab4f04, 0xa2e5b950, 0xc5beecbd, 0x27b88ea0 }, 4 },
+	{ {0x845b9263, 0xd75d89ef, 0x02c23fd0, 0x5cccc13d, 0xb5d512ea }, 5 },
+	{ {0x846bd4d8, 0x9bd034ac, 0x5346cbc5, 0x59752635, 0xad2bda6b }, 19 },
+	{ {0x847841ad, 0x88ff2eff, 0x6602f03b, 0x7231cd1e, 0x03f89ffc }, 4 },
+	{ {0x84831671, 0x935bf80c, 0x250aff22, 0x3a996846, 0x69a0ce72 }, 3 },
+	{ {0x849f9386, 0x7ff7846b, 0x27f84d0b, 0xe418569f, 0xaf058ac2 }, 65 },
+	{ {0x84a44ecf, 0x6f2dcfc1, 0x102f43ec, 0x7f6ddf68, 0x7a44aadf }, 143 },
+	{ {0x84a645be, 0xcec0a25d, 0x3ab7a909, 0xcde1b242, 0x699a8662 }, 24 },
+	{ {0x84c5cce8, 0xe8e74ab5, 0x1c3c0430, 0x75165679, 0x270bc5e7 }, 19 },
+	{ {0x84fb1346, 0x0412203c, 0xe8b35d3f, 0x83c1b41f, 0x15ca42c8 }, 19 },
+	{ {0x85153a8f, 0x25882cad, 0xde8295d0, 0x40ddb758, 0x6c93cefe }, 19 },
+	{ {0x85463e6f, 0xd7e51d48, 0xfb123cba, 0xbfcd4fd2, 0xc6bcf28d }, 63 },
+	{ {0x8547ae0f, 0xa25b9f3e, 0x26b90d4f, 0x3e1a4325, 0xb9248549 }, 19 },
+	{ {0x8557dcdb, 0x4cf1e151, 0x80d17acc, 0x8e6d515b, 0xf7bf7e7c }, 5 },
+	{ {0x855cabd1, 0xad1abae3, 0xa9d26999, 0xd48c66de, 0x8096d7c5 }, 6 },
+	{ {0x8592b14e, 0xe701eaaf, 0x433113a2, 0x6b199084, 0xc124992f }, 19 },
+	{ {0x85a3842e, 0xabac50c4, 0xe1332666, 0xc161541b, 0xe3508249 }, 19 },
+	{ {0x85d305e3, 0xe5d06542, 0x7b8eda98, 0x6736b19f, 0x930abfd8 }, 19 },
+	{ {0x85e3386d, 0x30dd9a64, 0xf4cc1bca, 0x03cff35b, 0x440f70b5 }, 39 },
+	{ {0x8607b924, 0x58584d5a, 0xa770369d, 0x94d50361, 0xb1d64bd3 }, 19 },
+	{ {0x86231b60, 0x4338a9b4, 0xc63be995, 0xadb2fd98, 0x60bab20b }, 19 },
+	{ {0x864824c2, 0xef01945b, 0x7fccb3ec, 0x3399347b, 0x714d6aac }, 19 },
+	{ {0x8666f310, 0x9ad01093, 0xb0afab11, 0x986cfd60, 0xba37d2a0 }, 6 },
+	{ {0x866cb3ab, 0x10f17e4f, 0xb356fbd7, 0x277bbf17, 0xc4e27ebe }, 19 },
+	{ {0x868d84f8, 0xa6ae0434, 0xbf86adfb, 0xb86996ce, 0xddefba84 }, 19 },
+	{ {0x868dd144, 0x80f716e0, 0x2453d0af, 0xac6a09d6, 0xa7f10853 }, 42 },
+	{ {0x86e688ce, 0xa0f0c8bc, 0xd31b6bcd, 0x19fd72ac, 0x108646bb }, 19 },
+	{ {0x86f8e325, 0x0cdcbadc, 0xcf131255, 0xa1ef59ed, 0x291be8e9 }, 19 },
+	{ {0x86fdfe9e, 0x26d6e77f, 0x41cbcb47, 0xe10e2f32, 0xe5518549 }, 17 },
+	{ {0x873bebca, 0x9668f0eb, 0xde02742a, 0xf9ebdcb9, 0x93c6791b }, 19 },
+	{ {0x875a262b, 0xe44a27a8, 0x357f1700, 0x80fb8466, 0xc9599b62 }, 6 },
+	{ {0x875bbb27, 0xf6a54e5d, 0x123dc8a6, 0xdf4bf46f, 0x97c23a57 }, 4 },
+	{ {0x876c0945, 0x0bc2b36a, 0x873e1733, 0xcfa31c6b, 0x9d080ba5 }, 19 },
+	{ {0x8779b004, 0xe7605a3c, 0x419825f0, 0x373a5d8f, 0xa84e1d5b }, 42 },
+	{ {0x877e8a60, 0xee165863, 0x4124db02, 0x3b50bf5d, 0xfa93624b }, 19 },
+	{ {0x878554d3, 0xb579e72b, 0x2d3c22e6, 0x330208ee, 0x0d1ee8a6 }, 19 },
+	{ {0x87936f80, 0x8423dddf, 0xd0062905, 0x6d6807b4, 0xbe1dc63e }, 42 },
 	{ {0x87a7fa43, 0x602f74c4, 0x7151e79f, 0x1aaf7f64, 0x1331ba51 }, 5 },
-	{ {0xecbf33a3, 0x76a7a108, 0x176f8d10, 0x09d042e0, 0x1519241c }, 5 },
-	{ {0xe0a8aff9, 0x80ed84ec, 0x12acbf63, 0xb40cf989, 0x5997faf3 }, 5 },
-	{ {0x81befaa4, 0x5ee3f119, 0x6b0e1ea6, 0x57b01614, 0x95601a87 }, 4 },
-	{ {0x6030005c, 0x4401b3cb, 0xcb09f802, 0xcd48f5c1, 0xc585303b }, 4 },
-	{ {0x5577e483, 0xcaca553c, 0xfbfc0cba, 0x26f3ab24, 0x44569f81 }, 5 },
-	{ {0x7e9a9ce7, 0xc18206b3, 0x25830e9c, 0xdcbb2717, 0x9118de96 }, 4 },
-	{ {0x7c3aa9cc, 0xa2f1f6e8, 0x1ae9d24b, 0x3a3c675f, 0x08a203ea }, 4 },
-	{ {0x27f9144f, 0xb24b434f, 0x7a75737a, 0xa6942830, 0x84782766 }, 17 },
-	{ {0x05280f0a, 0x26ac5c42, 0xab63b80a, 0x487bb909, 0x683e7461 }, 5 },
-	{ {0x77fcce7b, 0x7c9c915f, 0xb0adff05, 0x9141d4d4, 0x307f5a22 }, 5 },
-	{ {0x028eb2de, 0x64ee129f, 0x9403d114, 0xb3059e8b, 0x62fef6c2 }, 5 },
-	{ {0xb63fc17c, 0x1d004ca4, 0xd7f3b1ef, 0x8962210a, 0x779ca665 }, 6 },
-	{ {0x23f3e1b5, 0x97bee953, 0x75f38063, 0x8340995b, 0x55232e7c }, 4 },
-	{ {0x3f87c341, 0x3c8cc2a2, 0x5e1f64cf, 0xdcd01155, 0xa13711f0 }, 5 },
-	{ {0xfa2d5f56, 0x273a0faa, 0x5b390964, 0x48f82998, 0x655de60d }, 4 },
-	{ {0x6d7a8ea1, 0xb283ecc1, 0xcc94c359, 0xe5f053a6, 0xe82ab3f5 }, 5 },
-	{ {0xb11c0ded, 0x529af18c, 0x29ec46b9, 0xe0a795ed, 0x0405e7ec }, 5 },
-	{ {0xaf3524ca, 0xccd33ccb, 0x7a5b42b1, 0xce4314d0, 0x55e01672 }, 5 },
-	{ {0xd0bbf730, 0x72580638, 0x4756f530, 0x6ceccd91, 0xdc01d975 }, 17 },
-	{ {0xbd70b00c, 0xcb8fafca, 0x883c7160, 0x585e9c59, 0x20cca58f }, 6 },
-	{ {0xa6d285e5, 0x15ad1e2c, 0x15b4352d, 0x9b699ebe, 0x060b1dba }, 6 },
-	{ {0xcd8ee800, 0x822ff0cd, 0x295621fa, 0xafafc73b, 0xe4bacad0 }, 5 },
-	{ {0xa1fb6a98, 0x76601b34, 0x3e176693, 0x5cedf61d, 0xab1a8f7d }, 19 },
-	{ {0x21e43a08, 0x613fe974, 0x36e9e1bd, 0xf1f4d0dc, 0x7a0c058b }, 19 },
-	{ {0xcaeca371, 0x13c56e69, 0x6d7053d9, 0x0f5f9f3e, 0x02de8ad1 }, 8 },
-	{ {0x98f67697, 0x41a1c9df, 0x4fd203ed, 0x19d70b28, 0x3c94e41a }, 4 },
-	{ {0x475c3af7, 0x49592275, 0x9a5f424d, 0x2e22d7e4, 0x073d5992 }, 38 },
-	{ {0x39bc111c, 0x953bdf25, 0x683db7ff, 0x4c0bad79, 0xb5c49958 }, 5 },
-	{ {0xf12ad34d, 0xc3b4279d, 0xa0fc7094, 0xf3d50d6b, 0x8bb517dc }, 5 },
-	{ {0x06132ead, 0x4caadb23, 0x95302381, 0xbf72c608, 0x31500dce }, 5 },
-	{ {0xf04f5c69, 0x36301eed, 0x31a79c23, 0x571f8fc4, 0x97864dbb }, 4 },
-	{ {0xb45172e4, 0x628f68c3, 0x2cd13c73, 0xcf17c4dd, 0x1bed1bb2 }, 4 },
-	{ {0x18eada21, 0x78fc1a89, 0x895087aa, 0x513305d1, 0xba73c926 }, 4 },
-	{ {0x924fcf87, 0xb3747dae, 0x06e62197, 0x5903ee73, 0xc42016f2 }, 5 },
-	{ {0x6d72a04e, 0xf018fa1f, 0xa3708c8b, 0x5ed3333b, 0x2c5e8ead }, 5 },
-	{ {0xc74c0a9b, 0x973f4dbf, 0xc132b60f, 0xe4d66660, 0x0ae12552 }, 4 },
-	{ {0xd78d763e, 0x72e23418, 0xf31dc3ce, 0x91deea1e, 0x8ee10490 }, 5 },
-	{ {0x66620207, 0xca6c21bc, 0xbae8f868, 0xbb55532e, 0x72e521a6 }, 4 },
-	{ {0x31dbd1c0, 0x8659c649, 0xc49da8d2, 0xe6b80328, 0xcb6b59e8 }, 17 },
-	{ {0x970e26f3, 0xc2c085e3, 0x92671159, 0x91add6cc, 0xc6e9ff80 }, 6 },
-	{ {0xa58ca651, 0xf4c12bf0, 0x7cf3840d, 0x5e37b534, 0xf5fc075e }, 6 },
-	{ {0x1f39c472, 0xf1e02511, 0xfa7eaaf8, 0xed9fcce4, 0xd45861b9 }, 6 },
-	{ {0xdf10b3c8, 0x470acebb, 0xc445f7c2, 0x4a50b4f2, 0x4db0187d }, 6 },
-	{ {0xcdeadd6c, 0xf7bf5b53, 0xaa7d9014, 0x46b0ce58, 0x6542c580 }, 5 },
-	{ {0x8cbfd943, 0x24f297a4, 0x18e7eec6, 0x920dfead, 0x7b9bed08 }, 5 },
-	{ {0x32dd4df2, 0xb39461c0, 0x694f6bb8, 0x4de07094, 0x78a69d31 }, 6 },
-	{ {0x1f3f5862, 0x55dd49b0, 0xf912bf41, 0xe07e88fe, 0x3eb3fb61 }, 5 },
-	{ {0x273a3dab, 0x994b5b9c, 0x975fd127, 0x11dd19e0, 0xc6367caa }, 5 },
-	{ {0xfd71df03, 0xb0e9f3ca, 0xf701ecfc, 0x6d523206, 0x0cab3b13 }, 4 },
-	{ {0xf5009c44, 0xba1e72b6, 0x4e29fc73, 0x4741d518, 0xb4167aea }, 4 },
-	{ {0x55bad6c0, 0x0e6a676e, 0xfc7ff349, 0xfa1b5422, 0xd624f5ef }, 4 },
-	{ {0xf9249805, 0x11d2ea19, 0x1481c1e4, 0xff5ab7ad, 0xc3f082ab }, 4 },
-	{ {0x02cfc411, 0x32d518e2, 0xb9fc632e, 0xc6ad0065, 0x6bd9ec92 }, 17 },
-	{ {0xf4da2be2, 0xee712ba2, 0xe7cccf56, 0xfcd15483, 0xfe0023ed }, 6 },
-	{ {0x4b872dac, 0x11a720e2, 0xb9e86f22, 0xdf1e2214, 0xc1059281 }, 4 },
-	{ {0x1f26dfa0, 0x26b116c8, 0x0c951a99, 0x5633b4c2, 0xf7fa033d }, 5 },
-	{ {0x2a1c91bc, 0xc9b1b621, 0x77323206, 0x1d74b709, 0x8420f1d4 }, 5 },
-	{ {0x4690b2f6, 0xce28e55d, 0x56ab185c, 0x573fc27a, 0x9b414468 }, 5 },
-	{ {0xb8f4ee14, 0x6c3cdb8f, 0x506371d0, 0x01e6398e, 0xcda85251 }, 3 },
-	{ {0xe22a6317, 0x74790347, 0x5095008d, 0x0d5ad942, 0x7ddb34af }, 3 },
-	{ {0xad995ede, 0x603a28c7, 0x2dad06c2, 0x45fc7d4d, 0xad85d230 }, 3 },
-	{ {0xd89922ed, 0x43ea4fc0, 0xb87d7e5b, 0xaef3f072, 0xbb566849 }, 3 },
-	{ {0x93b07e3c, 0xd5ae2f00, 0xb36824a7, 0x4f83a3ef, 0x0d65d0d5 }, 3 },
-	{ {0xdbed87a5, 0x3c604f71, 0x40577d67, 0x07ca0fc8, 0x490463a6 }, 3 },
-	{ {0xfaa5f0bf, 0x79fde9ce, 0x74b91a70, 0x91d20377, 0x1cae8499 }, 3 },
-	{ {0x74d1c7f6, 0x6242335c, 0x736da294, 0x13037bd2, 0x3384efaa }, 38 },
+	{ {0x87a9f78c, 0x0bba4e38, 0xd98890e3, 0x4033a7b1, 0x4f75f5e2 }, 19 },
+	{ {0x87b7c800, 0x69a15fdb, 0x90b40dfe, 0xd736fb84, 0x92104cd9 }, 3 },
+	{ {0x87eb1620, 0x47403974, 0x0bfe0e7e, 0x3bea0908, 0x5d85f247 }, 19 },
+	{ {0x87f4d0fa, 0x58cfe9ce, 0xf818a318, 0x5df2735e, 0x6da6168c }, 1 },
+	{ {0x882a63a9, 0x655e53fd, 0xdb1cd487, 0x61a1a09b, 0x28f7e5a3 }, 19 },
+	{ {0x883537f1, 0x2814ee63, 0xc48a0ab7, 0x44383f8d, 0x8e6a5ca2 }, 19 },
+	{ {0x88533246, 0xb479840d, 0xe98c8244, 0x84dceeb5, 0xf2f99366 }, 19 },
+	{ {0x8891e3e3, 0x148bb0fe, 0x4e91e322, 0xba709d2f, 0x95285d1e }, 19 },
+	{ {0x889954ae, 0x4772156a, 0xeb22fea0, 0xbdf8c9cf, 0x01bec51d }, 19 },
+	{ {0x88cd9059, 0x5fbb7dba, 0xbd73ac9c, 0x0985c0a0, 0x13992dc6 }, 8 },
+	{ {0x88f3a725, 0x13b04459, 0x21228979, 0x7942c4d7, 0x6f495a05 }, 19 },
+	{ {0x88fa967c, 0x420f7090, 0xa11e5de1, 0xd3674f45, 0x27f53d52 }, 19 },
+	{ {0x89073c05, 0x2b0fe29b, 0x6de077c8, 0xbdf53734, 0x74081edf }, 5 },
+	{ {0x8924e3e1, 0x1eb1c8c1, 0xedcb7efa, 0x63c26d2b, 0xdc142473 }, 65 },
+	{ {0x8927b9aa, 0x770195f2, 0x55e4e0e1, 0x43f89bfe, 0x93353022 }, 56 },
+	{ {0x8948704b, 0xad9ff278, 0x73fa9ccd, 0x0ef89868, 0xe2bd6479 }, 42 },
+	{ {0x8954e59a, 0xa79310c7, 0xb719ecf0, 0xcde1e82f, 0xb731dcd1 }, 65 },
+	{ {0x8963fc04, 0x1975f31d, 0xc2ab1019, 0xcfdd4967, 0x999de53e }, 1 },
+	{ {0x8976f8b8, 0xab2a82f6, 0x26a73c78, 0x1d0a2189, 0x9ae68dae }, 19 },
+	{ {0x898630ad, 0x1497dc9a, 0x329580c6, 0x82ee55c4, 0xbcb9c30c }, 1 },
+	{ {0x898bda19, 0xf882c6d1, 0xdffdb217, 0x3db84a97, 0xdc21f7d6 }, 4 },
+	{ {0x89943ae9, 0x38fb308f, 0x4b5149eb, 0xc0cbea59, 0x7b9b0223 }, 38 },
+	{ {0x8999a51c, 0x94460c8d, 0xb1ca033b, 0x64b568bf, 0x919300c2 }, 19 },
+	{ {0x89ccb1a7, 0xffaaa75c, 0xee9bdc9b, 0x4a9ec9b0, 0x63af7199 }, 19 },
+	{ {0x89e71e74, 0x46589f4f, 0xa320f94b, 0x771cc1a0, 0x756ce196 }, 19 },
+	{ {0x8a158cde, 0xc0923b81, 0xce13af2d, 0xffa5d1b7, 0xe096a469 }, 19 },
+	{ {0x8a25afae, 0xd4bf8746, 0x8ad7a0c5, 0xcf123755, 0x54d67741 }, 5 },
+	{ {0x8a3749af, 0x3d6ff884, 0x04df59da, 0x9d9ac799, 0x0bbc318d }, 19 },
 	{ {0x8a4bcf0f, 0x38c9f243, 0x443a4d48, 0x65278f69, 0x5bd83dc8 }, 38 },
-	{ {0xbb99fe77, 0x02733ab0, 0xf9e8856e, 0x91f5ddcb, 0x55d30b5f }, 6 },
-	{ {0xb74f759b, 0xa3837968, 0xa04e9b64, 0x321b47cf, 0x087e76ff }, 5 },
-	{ {0x6da3d46f, 0xa7141596, 0x2004b3b1, 0x3a2bac2d, 0xd513958a }, 55 },
-	{ {0x2c4f9305, 0xd160b9a0, 0xfbc3ee42, 0x26983750, 0xee5f1952 }, 56 },
-	{ {0x461c581e, 0xbc43b47c, 0x54a6d706, 0xa03c462b, 0xf7d1ef75 }, 56 },
-	{ {0x3e0360a4, 0xf2355224, 0x98682a71, 0x4f523039, 0xa5ab6c7c }, 39 },
-	{ {0x920f141d, 0xb0d42952, 0x130855ac, 0x1dce446c, 0x327e7d9c }, 6 },
-	{ {0x14403ca7, 0x1d287084, 0x569e6c2f, 0x4124d271, 0x2c665219 }, 5 },
+	{ {0x8a65786d, 0x9c6b2fe7, 0xc1643c27, 0x316d6cbb, 0x35fbfd24 }, 17 },
+	{ {0x8a6e0f93, 0x2ce12318, 0xa1c5b8db, 0xbfe44b21, 0x3acb03ae }, 19 },
+	{ {0x8a919dbe, 0xed92db8c, 0x06a61127, 0x9efaed85, 0x52810239 }, 96 },
+	{ {0x8aa6d0aa, 0xdf00de91, 0x12696da5, 0xb7dc6e3b, 0x62f2d9be }, 19 },
+	{ {0x8ab1b72c, 0xe852a778, 0xa645f566, 0xa70fa18e, 0xe32fd021 }, 19 },
+	{ {0x8ac11431, 0xe32e2391, 0x9a2ea37d, 0x5b2ef472, 0xd634921a }, 56 },
+	{ {0x8afd1ec5, 0x843ecfdc, 0xbff11497, 0xfa8c55b8, 0x70c0c6f5 }, 134 },
+	{ {0x8AFE57C2, 0x87ADC0F9, 0x3F234E8E, 0x8C136AE3, 0xC00947C1 }, 9 },
+	{ {0x8b121123, 0x1283041b, 0xcfc9ae45, 0x5d121e2c, 0xf2a06c42 }, 105 },
+	{ {0x8b252fe7, 0x84692fc1, 0x5290a04f, 0xa59848f6, 0x09216f16 }, 3 },
+	{ {0x8b2626f8, 0xdbbb3e97, 0xa5087b34, 0x0a3f3d56, 0xc8ee84d1 }, 19 },
+	{ {0x8b3994ab, 0x39768f15, 0x617fb2cd, 0x91990002, 0x26b935bd }, 19 },
+	{ {0x8b485373, 0x7f7f4006, 0xca4291f4, 0x81cfdfcf, 0x66e2ce34 }, 19 },
+	{ {0x8b63f36b, 0xe31d7d02, 0x1c19103e, 0xbe8c68b6, 0x9aae699c }, 19 },
+	{ {0x8b65d999, 0xba187c98, 0xba97a038, 0xea46655f, 0xd9d62deb }, 19 },
+	{ {0x8b7e4bc4, 0x08a8c715, 0x943bfa00, 0x069f2d51, 0x7b39a748 }, 6 },
+	{ {0x8b828d33, 0xdcdfd324, 0xdf1827ef, 0x79f5ca96, 0x35968c6e }, 19 },
+	{ {0x8bb26018, 0x1c404222, 0xe67f37ce, 0x84a252c5, 0x777472bc }, 19 },
+	{ {0x8bcefc25, 0x0be1c3a6, 0x77de78e6, 0xaf4d01d3, 0x2fe4e5b8 }, 19 },
+	{ {0x8bd0de57, 0xbe23b8d3, 0x8a790119, 0x6f06050b, 0xfaf48980 }, 19 },
+	{ {0x8bd874aa, 0x854cc26d, 0x7fc48e7d, 0x2de60dbb, 0xee681721 }, 19 },
+	{ {0x8be69f0f, 0x6cdd10b2, 0x1bfbb315, 0xe689adc4, 0xb35ba150 }, 50 },
+	{ {0x8c06d9e1, 0xe188431c, 0x13721af9, 0x65faa739, 0x1140af2e }, 19 },
+	{ {0x8c19e017, 0x6b87f243, 0x60579223, 0x28dd1945, 0xbb3175ba }, 39 },
+	{ {0x8c218c31, 0x7e1e213e, 0x1c5e9439, 0x87092900, 0x9d645a47 }, 5 },
+	{ {0x8c317e50, 0xe0aa75df, 0xaa374412, 0xce9866d1, 0x6c0214fd }, 19 },
+	{ {0x8c5cf2df, 0x5f0b9df6, 0x7239161a, 0xa843d980, 0x4af46f0e }, 19 },
+	{ {0x8c609b8b, 0xee4245a1, 0xbb81e37d, 0x888ac5ef, 0xb66533cf }, 4 },
+	{ {0x8c6e1e21, 0xcc45b2ca, 0x72ceea93, 0xdf48eda9, 0xcef1dbad }, 19 },
+	{ {0x8c7ae1a1, 0x720b1dae, 0x9af9904e, 0x638b868f, 0x56d905c2 }, 28 },
+	{ {0x8c9a9a9a, 0xfe13a58e, 0x4cfb7248, 0x9af2d6b0, 0x80dffaf6 }, 19 },
+	{ {0x8cbfd943, 0x24f297a4, 0x18e7eec6, 0x920dfead, 0x7b9bed08 }, 5 },
+	{ {0x8cc1f7ce, 0xeef745bb, 0x34e80253, 0x971e1372, 0x13671486 }, 42 },
+	{ {0x8cf06f93, 0xd4e8bcf7, 0xbe04ae85, 0x32f72e6e, 0xec8ba2f1 }, 19 },
+	{ {0x8cfcf726, 0x62b67bb7, 0x7d4dce81, 0x949b4b68, 0x14a314f7 }, 19 },
+	{ {0x8d142e4f, 0xe476f27e, 0x46a21291, 0x99194f5b, 0x3cc70370 }, 1 },
+	{ {0x8d3f5cb0, 0xd2d23b4a, 0x3079f4f1, 0x39e72173, 0xaee18105 }, 19 },
+	{ {0x8d5fe498, 0xa25420de, 0x9f428265, 0xebbb1fc2, 0xa6c0f2ca }, 19 },
+	{ {0x8dcd9618, 0xf92fb014, 0xd16e8f4e, 0xc9a813e6, 0x5424ad7d }, 19 },
+	{ {0x8dd49e12, 0x677443ae, 0xde319f41, 0xbf3f82a0, 0x8d0e5b5d }, 19 },
+	{ {0x8dfe236a, 0x6a573482, 0x4035725a, 0x4f513b8f, 0xd31b310a }, 4 },
+	{ {0x8e0d4a77, 0xe7d5736e, 0x8225c2df, 0x47015093, 0x63eb230f }, 142 },
+	{ {0x8E2A2837, 0xC48BC8E2, 0xD2478043, 0xC728A463, 0x0982BA87 }, 19 },
+	{ {0x8e3e05e8, 0x928b5b77, 0xfa61f3b8, 0x33e164bf, 0x5222a5fb }, 19 },
+	{ {0x8e3f6f08, 0x309f082a, 0x82be8298, 0xa66c9b90, 0xf2d34ad4 }, 57 },
+	{ {0x8e413a3b, 0xe17e3f0e, 0x4304219a, 0x413a5eb0, 0x4f2b3a04 }, 19 },
+	{ {0x8e644537, 0x6d1fd15c, 0xb5524786, 0x117a09ac, 0x5a832169 }, 19 },
+	{ {0x8e66731c, 0x99f4d041, 0xddcd3308, 0x8d0ab0d4, 0xcae8bf75 }, 6 },
+	{ {0x8e9fb34b, 0x356b02a8, 0x39dce513, 0x9c120305, 0x93be13a2 }, 19 },
+	{ {0x8ecc34eb, 0xff9d37c0, 0xfe9560cf, 0xdc53a052, 0xcff3d1ab }, 19 },
+	{ {0x8f27317f, 0x5eaa3ec7, 0xd5b63184, 0x808a6202, 0xcf036c0f }, 19 },
+	{ {0x8f35c41a, 0x5235dec2, 0x2c3b99cd, 0x6dd63cfd, 0xa0a7a821 }, 19 },
+	{ {0x8f5e7717, 0xa506e331, 0x4d48ae9f, 0xf5e6c6c8, 0xa3df72eb }, 19 },
+	{ {0x8f71dddd, 0x429173df, 0x7ce52c52, 0x45af1a76, 0xb482a901 }, 39 },
+	{ {0x8f74c91e, 0x6598d8de, 0x188ae1b5, 0x06c44229, 0xc768b11f }, 19 },
+	{ {0x8f92ea21, 0x4a7a1139, 0x4c512080, 0xd3b65a7a, 0xfa9a92ed }, 19 },
+	{ {0x8f95a833, 0x28b06e35, 0x9e02fc62, 0x5c3d9c54, 0xa6576bcd }, 19 },
+	{ {0x90003c78, 0x975d00b1, 0xe5612fd0, 0x0dffabb7, 0x0d616ecd }, 3 },
+	{ {0x9002aa0b, 0x2d49a9fc, 0x32318048, 0x7ff59178, 0x1867a99c }, 19 },
+	{ {0x902d109e, 0x4ff45247, 0x1b119360, 0x39a472cb, 0xee81a902 }, 39 },
+	{ {0x90592a09, 0x228b3e33, 0x00eed51e, 0xbd7358b5, 0xed2afa09 }, 19 },
 	{ {0x90722d41, 0x3913ab18, 0x462aa741, 0xf85b820e, 0x751bb50f }, 4 },
-	{ {0xc34a1c22, 0x5d1a5fc4, 0x1a998e23, 0xd1209b59, 0xb3b759bb }, 17 },
-	{ {0xf5e199a5, 0xb39bad10, 0x256d8e96, 0x3f0da272, 0xad359517 }, 17 },
-	{ {0x4376342b, 0xf42334d9, 0x8dbd3e35, 0xef354609, 0x74269c58 }, 17 },
-	{ {0x25022c4f, 0x5cfc805e, 0x93026fd5, 0xfda781e9, 0xa1807474 }, 62 },
-	{ {0x3ff54468, 0xa5acf1ad, 0x44e85bdc, 0x993044aa, 0xa3165a63 }, 62 },
-	{ {0xd08d4e2a, 0x8d92c015, 0x51ff012a, 0x71a1f3e5, 0x7fe2d09c }, 62 },
-	{ {0x751571d2, 0x1457d89e, 0x5c52c456, 0x57bfe9a6, 0x17ae8e14 }, 62 },
-	{ {0x1af617bf, 0xd11b10a7, 0x1936c606, 0x174a8001, 0x9762ea71 }, 40 },
-	{ {0x32151ddc, 0x4303290c, 0x09889bf8, 0x107493dd, 0x34296043 }, 5 },
-	{ {0x4ee3e785, 0xe6949bd5, 0x35804a32, 0xc6a1a31e, 0xeef30031 }, 4 },
-	{ {0xead69958, 0x2641d103, 0xa94775a0, 0x8121ecc3, 0x36b99eae }, 8 },
-	{ {0x6e1d2d5b, 0x0688860b, 0x0a04d53f, 0xe9e5e393, 0x9dfba547 }, 8 },
-	{ {0x13fbb273, 0xa9548133, 0x0d33c9ed, 0xc4263e30, 0xccf1774d }, 5 },
-	{ {0x45760316, 0xa4ebc74d, 0xdd55ee16, 0x3c5aeaaa, 0xfe965d2c }, 5 },
-	{ {0xd723f2eb, 0x1c887db5, 0x448fd56b, 0xe5e7c57e, 0x60d88e63 }, 4 },
-	{ {0x612c1861, 0x6bc800d9, 0xeb69b9da, 0x3cd29eca, 0x31f50c1c }, 4 },
-	{ {0x300f20ad, 0xde3941ab, 0x10eb158d, 0xb48250e8, 0xe856a911 }, 4 },
-	{ {0x357c0c2e, 0x9b3b2970, 0xc587c96f, 0x86a6b727, 0x2160f54a }, 4 },
-	{ {0x875bbb27, 0xf6a54e5d, 0x123dc8a6, 0xdf4bf46f, 0x97c23a57 }, 4 },
-	{ {0xfed52c04, 0x55ce1e7c, 0xef80cd14, 0x4c3d0ef3, 0x636134e5 }, 4 },
-	{ {0x7e5024e6, 0xe6aecd05, 0xec6c8857, 0x86a4aac2, 0x87ed110b }, 4 },
-	{ {0x3837d3a7, 0x2498caa0, 0x70866d94, 0x7956a2e3, 0x0fb94fbe }, 6 },
-	{ {0xfacb9677, 0x17c21fed, 0x9b375481, 0x908aa337, 0xb3361c45 }, 6 },
-	{ {0x14537ad9, 0xa5512452, 0x61776bf9, 0xb64068fe, 0x4921ad47 }, 6 },
-	{ {0xf182d478, 0x5e3eed00, 0x292f7ff4, 0x795c9dcc, 0x6c990a0a }, 5 },
-	{ {0x5d2062ec, 0xc7176ca2, 0xb100724c, 0x2a17f877, 0x878d721d }, 17 },
-	{ {0x219e9acc, 0x2c023c25, 0xa8bbe9fb, 0x7d1764ff, 0xcff66034 }, 5 },
-	{ {0xe0652385, 0x80b9e118, 0xb6c9e789, 0xd797cdd9, 0x9e0a1c69 }, 6 },
-	{ {0x25b80aa6, 0x70e7fdc8, 0x4b51628b, 0x6dbe930e, 0xb234beb7 }, 6 },
-	{ {0xfe8aae62, 0xfdec2863, 0x1d8f7b66, 0x59dd9513, 0x5c1bcbb7 }, 6 },
-	{ {0x0cc6c30c, 0x6918fcf7, 0x80e57d40, 0xf58a4cf2, 0xa82225cd }, 38 },
+	{ {0x908bb09b, 0xa2883c3e, 0xcdec96ed, 0x7e0211cc, 0xb05c5018 }, 3 },
+	{ {0x90b57b58, 0x26753609, 0x16ad68ba, 0x65e92849, 0x26d93f4a }, 4 },
+	{ {0x90bdd12d, 0x632d2e90, 0x9ac5d692, 0x35ad0366, 0xf430b734 }, 19 },
+	{ {0x90df6329, 0x2fc2f210, 0xb88cc8ec, 0x28439142, 0x3d21c917 }, 19 },
+	{ {0x90ea059c, 0x57f011a4, 0xfb33a558, 0xe868ee63, 0x9882fe5e }, 4 },
+	{ {0x910b156b, 0x562880ac, 0xe789fb3f, 0x9b118481, 0x63c2df20 }, 4 },
+	{ {0x91186f36, 0x1c832360, 0x5c79dc45, 0x51a768a4, 0xb9c5a320 }, 39 },
+	{ {0x912433d6, 0x80fd52bf, 0x91e9b926, 0xa98bb081, 0xffdeb1dc }, 39 },
+	{ {0x914f6ccb, 0x25d78621, 0x186001f2, 0xf5e2aaa2, 0xd628cd0c }, 64 },
+	{ {0x91505fcc, 0xdcc43230, 0x550d1019, 0x67010bed, 0x27f9b573 }, 4 },
+	{ {0x917270dd, 0x44c63dc8, 0x83289b4e, 0x0902fe6c, 0x812f5ea3 }, 19 },
+	{ {0x917d1c07, 0x9e03c4a4, 0x4de864f1, 0x23d03c4e, 0x32c8daae }, 42 },
+	{ {0x91afe2ee, 0x3a5b8e80, 0xd67f6c7a, 0x30bafbc2, 0xd63b2421 }, 4 },
+	{ {0x91ba5c06, 0x3d0ed383, 0x165b26e4, 0x609d7abd, 0xa02a5242 }, 19 },
+	{ {0x91bd6c21, 0x530654fa, 0xb12cd8a7, 0x97044d49, 0x4834c223 }, 19 },
+	{ {0x91bee8af, 0x612f69c5, 0x413a1d23, 0x102cc5ea, 0x896c2caa }, 19 },
+	{ {0x91d3f146, 0x3dac4d5f, 0xed8d4ff3, 0x4bed0d38, 0x8c61f164 }, 3 },
+	{ {0x91e17aba, 0x249925c7, 0xe0e5c280, 0x469bef09, 0xd5534da8 }, 19 },
+	{ {0x91e22b72, 0x7002ceeb, 0x0cf5fb10, 0x19a0c907, 0xc3cd24a5 }, 39 },
+	{ {0x91e52247, 0x3a847051, 0x1584df3e, 0xe5b325ea, 0x5e2b81ef }, 19 },
+	{ {0x9200fd6f, 0x1e92f78e, 0x3d9c6d08, 0x2837f719, 0xad0500d4 }, 6 },
+	{ {0x920f141d, 0xb0d42952, 0x130855ac, 0x1dce446c, 0x327e7d9c }, 6 },
+	{ {0x924fcf87, 0xb3747dae, 0x06e62197, 0x5903ee73, 0xc42016f2 }, 5 },
+	{ {0x9255b2ac, 0x6d03fddf, 0x3df8880e, 0xc247dd34, 0x46e3209f }, 19 },
+	{ {0x9267ea63, 0xe1d32095, 0x868eec13, 0x47a4eafb, 0xdfb5ef7e }, 19 },
+	{ {0x92727e6e, 0xcc52dfec, 0xa071673f, 0x0d58e964, 0x746899d2 }, 19 },
+	{ {0x9293403c, 0x3811b667, 0xd21408f4, 0xd670b213, 0x73ea333e }, 56 },
+	{ {0x92a433e8, 0x77626461, 0xa6481ca7, 0x5c252e64, 0x3752f0c4 }, 42 },
+	{ {0x92bada2d, 0x019fcd6e, 0xee6d332a, 0x8068a9dd, 0xfa30d518 }, 5 },
+	{ {0x930b4896, 0xc1590ebb, 0xb74d3304, 0x47ec36e3, 0xfeb5cab6 }, 19 },
+	{ {0x930df587, 0x62e7b5bc, 0xf2d36246, 0x2f03335b, 0xad732398 }, 6 },
+	{ {0x930eae70, 0x57af1652, 0xabae7940, 0x72b296a5, 0x9decd61b }, 50 },
+	{ {0x931d6318, 0x774bd495, 0xa32ec3da, 0xbf8d0edf, 0xc9913324 }, 1 },
+	{ {0x93462ac9, 0xa322c2e5, 0xe0d996fd, 0xdbe9eba2, 0xf3436931 }, 19 },
+	{ {0x9347890b, 0x025cc8c5, 0x21a4abbf, 0xf309ffc0, 0x466f22b3 }, 5 },
+	{ {0x937464eb, 0x371c68ad, 0xd2236bce, 0xf91d24a8, 0xce7c4ed1 }, 3 },
+	{ {0x937f8d41, 0x2e9810c8, 0xaeb9d921, 0x82cd3b00, 0x7ace30d2 }, 4 },
+	{ {0x938602b6, 0x5bb04b94, 0x1d67c453, 0xa948e1f1, 0x8bbbf5ac }, 19 },
+	{ {0x939ed605, 0x3363112c, 0x34766335, 0xb93d0ddf, 0x25059468 }, 19 },
+	{ {0x93ab050b, 0xc4965667, 0xee863773, 0xb8ecd36d, 0xd4f3f86c }, 56 },
+	{ {0x93b07e3c, 0xd5ae2f00, 0xb36824a7, 0x4f83a3ef, 0x0d65d0d5 }, 3 },
+	{ {0x93bf6725, 0xa3c1b707, 0x1064a018, 0x84e1b6e8, 0xc6f8b579 }, 19 },
+	{ {0x93d4d352, 0xb73c3d2e, 0x68ceaa31, 0x75b9af7f, 0x94780eba }, 1 },
+	{ {0x94258154, 0x46d46805, 0x8705bae5, 0x45ffa136, 0x46744a87 }, 1 },
+	{ {0x942f9507, 0xd206cd81, 0x56f15601, 0xfe8032fc, 0xf0e3875b }, 1 },
+	{ {0x9447e50d, 0x1266b7cb, 0x96a414ea, 0xf9ee16c0, 0xf99e55f3 }, 3 },
+	{ {0x94584ca2, 0xe89ab0b2, 0x49cd52f3, 0xa356176a, 0x03f9e35f }, 19 },
+	{ {0x945d91ac, 0x6285daca, 0xf123a953, 0x5dc740ad, 0x65bd06d5 }, 141 },
+	{ {0x94ae0568, 0x95c68827, 0x04bddade, 0x105cc343, 0x3110656d }, 19 },
+	{ {0x94d7a756, 0xe199457e, 0xa9958c8f, 0x5d6860c9, 0xbf334126 }, 3 },
+	{ {0x958c2a68, 0x6fe52324, 0xc0adb85b, 0x3dda4471, 0x910f7000 }, 56 },
+	{ {0x959a2dde, 0xfc9dc1a7, 0x51cf3077, 0x9b1aaac7, 0x75f1612f }, 6 },
+	{ {0x95ae5b3e, 0x24ad0bea, 0x21902cb7, 0xdfd3fd95, 0x81166a76 }, 39 },
+	{ {0x95d8a590, 0xbad595f9, 0x441aea4b, 0xf68667de, 0x05b1b34b }, 19 },
+	{ {0x95d968ba, 0xa9f49969, 0x26371b84, 0x86ab5583, 0x5b7d9d52 }, 19 },
+	{ {0x95de8809, 0xd2758fc0, 0xa743390e, 0xa5085b60, 0x2e59e101 }, 57 },
+	{ {0x95f36cf0, 0x0cee3db5, 0x5940eb60, 0xcd394122, 0x26a99e94 }, 19 },
+	{ {0x95f75fae, 0x9b3e9611, 0x49e352ce, 0xf3d7e478, 0xe9887d5a }, 19 },
+	{ {0x9613d00d, 0x89ce9033, 0x4d9776db, 0x32b984ce, 0xeefdeeff }, 19 },
+	{ {0x9648d43f, 0x3c25d67b, 0x9e4972f7, 0x77d7b024, 0x70080d1c }, 19 },
+	{ {0x965f4982, 0x790f1817, 0xbcbabbb3, 0x8c877718, 0x3b231a55 }, 24 },
+	{ {0x96897697, 0xAFE3A635, 0x4F2753F2, 0x2A8B15D6, 0xD977B064 }, 19 },
+	{ {0x96e1f8fa, 0x1f4f3fdf, 0xa999f6a9, 0x99d60d75, 0xb590f070 }, 19 },
+	{ {0x96e2a716, 0x3c755fbe, 0xa77abfd9, 0xd09a7986, 0x87a5a993 }, 4 },
+	{ {0x970e26f3, 0xc2c085e3, 0x92671159, 0x91add6cc, 0xc6e9ff80 }, 6 },
+	{ {0x971da55e, 0x92167674, 0x628a12c4, 0x43efc43b, 0xafcfb6b4 }, 19 },
+	{ {0x974d6ef7, 0x601dc590, 0xa35644e2, 0xaf774306, 0x7a867ac3 }, 19 },
+	{ {0x975fdf52, 0x1c080308, 0x96eb50af, 0x4f39a235, 0x00eaf7ac }, 19 },
+	{ {0x9776da8b, 0x475d8140, 0x0e027e37, 0xd949ccff, 0xbb33fe30 }, 19 },
+	{ {0x977fed11, 0x35b6cc73, 0xe765b47f, 0x51570fc0, 0x0acd5b79 }, 1 },
+	{ {0x978aa035, 0xcc57a6b6, 0x3d8bbcaf, 0xcb310ebb, 0x2436dd87 }, 19 },
+	{ {0x97adcb65, 0x2bc4baf0, 0x2d29a9ab, 0xe5e65470, 0x65dec298 }, 19 },
+	{ {0x97af4f42, 0x2a283ac8, 0xba387eb0, 0xb1b29395, 0xc2c966eb }, 19 },
+	{ {0x97b8ef65, 0xd86ec425, 0xd5901fce, 0x80d33a3d, 0x731e50e1 }, 19 },
+	{ {0x97c39dad, 0x3e065f90, 0x83fefae1, 0x57f27884, 0x4b208058 }, 19 },
+	{ {0x97ce5989, 0x2573cac3, 0xc440efff, 0x6d74c8a1, 0xc29a5ad3 }, 39 },
+	{ {0x97dd31b2, 0xf0dd056a, 0xbd808062, 0xe306b0c2, 0x536975bc }, 19 },
+	{ {0x97e173da, 0xc64dbde7, 0xd6a60de7, 0x606cba0c, 0x860813db }, 5 },
+	{ {0x97e7d0ee, 0x40c7d6ce, 0x1a8edf7b, 0x06e5014e, 0x6745cfda }, 19 },
+	{ {0x97f17901, 0x46116198, 0x133c083d, 0xe113ed1e, 0x5ca6ff21 }, 19 },
 	{ {0x97f2cc1c, 0xd4c51dc2, 0x0b86cd19, 0x0016b8f0, 0xc006a968 }, 38 },
-	{ {0x6420d610, 0x02da3254, 0x03fcb6f4, 0x1afb1d34, 0x8eeba3b4 }, 38 },
+	{ {0x983eb5de, 0xeb61af5c, 0xe82ad598, 0x692192b8, 0xae8a2a08 }, 3 },
+	{ {0x983f97a0, 0xd8aedad5, 0x2f5a2ade, 0x5fed6f28, 0x12218b2e }, 19 },
+	{ {0x984966dc, 0x32808afa, 0xd67c8460, 0x24aa2889, 0xdf20d6e2 }, 19 },
+	{ {0x9865f0bc, 0x4d541378, 0x09f0d8b4, 0x8d5461dd, 0xf0c5bf4c }, 19 },
+	{ {0x98748c36, 0x4e7bff50, 0xcf073c1a, 0x421ebe5b, 0x5d8b7025 }, 4 },
+	{ {0x989d9ba7, 0xc0f29694, 0xfa3b737d, 0x09cf1026, 0x06b2fd5b }, 19 },
+	{ {0x98b7a6ac, 0x44b82ccf, 0xc45eb515, 0x95e2905a, 0xdabac1c7 }, 6 },
+	{ {0x98bbfa3a, 0xb07b7a5c, 0xad55d7dd, 0xf7cbd944, 0x0caa2a86 }, 1 },
+	{ {0x98df3e94, 0xd3bbef5d, 0x18095b62, 0xe65274eb, 0xfa8d527c }, 42 },
+	{ {0x98e33dca, 0x445850cd, 0xf24f0905, 0x0756c3b7, 0x5202ac13 }, 19 },
+	{ {0x98f3eec6, 0x07cae92e, 0x01c1310f, 0x25d980f2, 0x859b88cd }, 19 },
+	{ {0x98f67697, 0x41a1c9df, 0x4fd203ed, 0x19d70b28, 0x3c94e41a }, 4 },
+	{ {0x991ef989, 0x0dc3e0c0, 0xd29d6d24, 0x9675eae1, 0x82aca30c }, 19 },
+	{ {0x99330820, 0xcf8aef8b, 0xb34d56a6, 0x66accb4b, 0x1ca90e30 }, 5 },
+	{ {0x993ba63b, 0x06e855ba, 0x7294bea2, 0x5b4250bf, 0x2a63fab5 }, 19 },
+	{ {0x996a1c0d, 0x92400287, 0xc1554511, 0x6b952f84, 0xc7dc03b1 }, 19 },
+	{ {0x99a40266, 0xbc296cef, 0x1d432cb0, 0xcaa8df1a, 0x7e570be4 }, 67 },
+	{ {0x99a8631c, 0xdc37f0dd, 0x9d8793ea, 0x8eadd3f3, 0x4e0bba51 }, 19 },
+	{ {0x99cc271b, 0x5cffa38b, 0x8ec6e6d8, 0x770adf21, 0x19055fff }, 19 },
+	{ {0x99d3ef10, 0x7f2ac4d4, 0x52b05eb9, 0x6b922924, 0xef4c5434 }, 19 },
+	{ {0x99f9e975, 0x3edbaee8, 0x20e36a1a, 0x58f1cd7a, 0xe2b26265 }, 19 },
+	{ {0x9a5e3433, 0xc5d82f21, 0x66969162, 0xbb822a96, 0x5c741ce5 }, 56 },
+	{ {0x9a611007, 0xb58a0016, 0x39676728, 0x614ffea6, 0x1cd5ff85 }, 3 },
+	{ {0x9a63d48c, 0x4fc05e76, 0xc9de25e5, 0xc5f2a0c9, 0x9b5d1be4 }, 39 },
+	{ {0x9a743e99, 0x7179bafc, 0x51f04d42, 0x2f0bf1e8, 0xb22fb1d5 }, 19 },
+	{ {0x9aab2b5d, 0xd7ae963d, 0x2f1eb7b3, 0x51222219, 0x96b96ffe }, 19 },
+	{ {0x9ab584be, 0x0a054e76, 0xd345ca93, 0x7917f1ea, 0x195f7967 }, 39 },
+	{ {0x9ae54a8a, 0x5badd3ed, 0xbcb6b693, 0xdf1821d1, 0x5efbd9c9 }, 19 },
 	{ {0x9afdee40, 0xe7b243f9, 0x9cc50dd1, 0xad710ab0, 0x928dd820 }, 8 },
-	{ {0x0eb3a48a, 0x8ab90826, 0x726f0c06, 0xdaadf4bf, 0x13390758 }, 9 },
-	{ {0xd7829313, 0x3b075f48, 0xc9dc5c4c, 0xf0c4a985, 0xae964b08 }, 9 },
-	{ {0xf4dba5ba, 0x267b5dd1, 0xa35eb74a, 0x6ec4fd4d, 0x5ca9a1b4 }, 6 },
+	{ {0x9b2df344, 0xbaa30658, 0x9af86bdd, 0xf2ce373b, 0x6c66e60e }, 19 },
+	{ {0x9b3be704, 0x92994320, 0xe185aae3, 0x02cdb384, 0x1d7f518a }, 19 },
+	{ {0x9B4B4D93, 0xBAE38876, 0xCE095C35, 0x993553F9, 0x62D26FDA }, 19 },
+	{ {0x9b4da763, 0x6809d569, 0x0d6bd5d7, 0x82ffa3cf, 0x9f4c63ec }, 39 },
+	{ {0x9b559703, 0x41aaab59, 0xa73ae921, 0xc6ccf290, 0x09c1a8f0 }, 19 },
+	{ {0x9b6cb224, 0xf2a7a4af, 0x69221f12, 0x80d3344a, 0x5c88450e }, 10 },
+	{ {0x9b815efa, 0xa927c118, 0x27acfdb0, 0xf9b9197b, 0x5ac97572 }, 19 },
+	{ {0x9b99c2ab, 0x2e06f44b, 0x4e17d790, 0x1c091234, 0x2a7295af }, 1 },
+	{ {0x9bafce69, 0x9964f4aa, 0xbc6b60c7, 0x1a71c9ff, 0x5b0cc82d }, 5 },
+	{ {0x9bca89c7, 0x1c033bb9, 0xa85ee30c, 0xf75960ec, 0x839c0462 }, 19 },
+	{ {0x9bdfe44a, 0x7a0d5151, 0x346ff14e, 0xce3216b5, 0x108cc775 }, 19 },
+	{ {0x9c26a5a8, 0x9f543050, 0xdb2d614f, 0x8405c659, 0xf5baae08 }, 19 },
+	{ {0x9c43106d, 0xba3ae282, 0x9e9a11df, 0xfa9d000e, 0xd6d6454c }, 1 },
+	{ {0x9c544426, 0xa02312b7, 0x148249ef, 0x20ae6e20, 0x21b45db4 }, 4 },
+	{ {0x9c5c1c40, 0xec30c34b, 0x1b436cf8, 0xcc494c0b, 0x509e81fc }, 6 },
+	{ {0x9c886fff, 0x02779267, 0x041efe45, 0xdadefc5f, 0xd7f4b9a2 }, 10 },
+	{ {0x9c89215d, 0xd36eded7, 0x69691708, 0xeb8c82de, 0xc1ce5109 }, 6 },
+	{ {0x9c9da64f, 0x7b0ad20b, 0x0d699bbb, 0x254ae206, 0x66867176 }, 19 },
+	{ {0x9cab6a79, 0x3e39076e, 0x3f598aa5, 0x4bffd558, 0x5ddc7e3e }, 19 },
+	{ {0x9ce36aea, 0xa93f969b, 0x6c2ea915, 0x98b0b014, 0x00000000 }, 3 },
+	{ {0x9d5f6098, 0xb71712e9, 0xd9e38673, 0x9b82fc48, 0x4380f114 }, 19 },
+	{ {0x9d67fab5, 0x5b85f4ac, 0x4f592432, 0x3a70020e, 0xb8589057 }, 42 },
+	{ {0x9d789166, 0xe3caf28e, 0x4742fe93, 0x3d962e99, 0x618c633d }, 16 },
+	{ {0x9d8029aa, 0xfc4125af, 0x7f151f37, 0x79783899, 0x63432d49 }, 19 },
+	{ {0x9da58782, 0x05d58fbc, 0xc641c5f1, 0x0da1aa2d, 0xc450ec97 }, 19 },
+	{ {0x9db72bb7, 0x8792595a, 0x12499c82, 0x1048504d, 0xc96ef848 }, 42 },
+	{ {0x9dcb43b6, 0x54a08de2, 0xc52147f4, 0xa2e628b5, 0xfe3761c8 }, 19 },
+	{ {0x9dddbce9, 0x4fb98776, 0xad01870b, 0x98f44687, 0xb8b068c9 }, 19 },
+	{ {0x9de525e0, 0x42d7345f, 0x6b725a69, 0x6bd1b6fe, 0xf69ecbf1 }, 42 },
+	{ {0x9dfc7188, 0x7ffc6d94, 0xb8780b5d, 0x6f207e24, 0xc1f58b54 }, 19 },
+	{ {0x9e0312e7, 0x2f30a20f, 0x556b64fe, 0x37dbbfe0, 0xd4471823 }, 6 },
+	{ {0x9e069397, 0x00ebfebc, 0x28d5fb88, 0x37a84da5, 0xc89fcf2a }, 42 },
+	{ {0x9e1633ec, 0x4492a01a, 0xd654d0a0, 0x8651daa5, 0xababd940 }, 19 },
+	{ {0x9e190cf3, 0xca52d85f, 0xd34eb5df, 0x2c0dd849, 0x0448b9a2 }, 19 },
+	{ {0x9e766243, 0xe681338b, 0xbb7d947e, 0x3ffc5f37, 0x3678ff4b }, 19 },
+	{ {0x9e790499, 0xaf6916f8, 0x2809e35d, 0x68cc159e, 0xfe580f99 }, 17 },
+	{ {0x9eaad185, 0xefc8e224, 0x368d1db4, 0x949eb965, 0x9c26fb2c }, 1 },
+	{ {0x9ed3ab6d, 0x893632b9, 0x246e91b4, 0x12cd5db5, 0x19e7586b }, 24 },
+	{ {0x9efa744b, 0xe8355675, 0xe7bfdd39, 0x76bbbfaf, 0x85d62e1d }, 57 },
+	{ {0x9f0cbb11, 0x91235ecc, 0xa4985de9, 0x76a09937, 0x44b57930 }, 19 },
+	{ {0x9f2fb5f3, 0x1c2bcff9, 0x49e08449, 0xf197b0c3, 0x1bdebe50 }, 3 },
+	{ {0x9f4ac128, 0x7b8caa28, 0x6a847c86, 0xac8601a7, 0x11be2d82 }, 19 },
+	{ {0x9f610356, 0x8e4c1122, 0x4932a223, 0xbfc86fa0, 0xc3eef021 }, 39 },
+	{ {0x9fce4dde, 0x148a4a2e, 0x9cbb7731, 0xbaf099d1, 0xd16e7c96 }, 19 },
+	{ {0xa00f9e66, 0xf1fa3de1, 0x5b028e0f, 0xbfed636e, 0x194bb967 }, 19 },
+	{ {0xa02db35c, 0x2bdfd9d6, 0x838b6cc9, 0x2a3e3d30, 0xa0ced5bf }, 39 },
+	{ {0xa031ff5a, 0xeafb7d47, 0x0e810bd6, 0xcd08c923, 0x94f66295 }, 56 },
+	{ {0xa034d59a, 0x9f66f996, 0xaf90e372, 0x45de5a47, 0x5b6db0bd }, 19 },
+	{ {0xa054ddea, 0xf4712127, 0x64cc596b, 0xcbd30e94, 0xb10e6c28 }, 39 },
+	{ {0xa059f6fb, 0x5ffd3762, 0x010b9743, 0x51883349, 0x9fe2205f }, 39 },
+	{ {0xa0669ca4, 0xababafb7, 0x03ae35c8, 0x6083c3ee, 0x424a9dea }, 39 },
+	{ {0xa0b45f20, 0x8df3091e, 0x461e15f6, 0x182896d2, 0x716c2a11 }, 19 },
 	{ {0xa0c486d0, 0xf25a3dc5, 0x86717d5d, 0x3e1f5a46, 0xd36735fc }, 6 },
-	{ {0x6dd28797, 0xf9d1fe7c, 0xc041077e, 0xbe77d08f, 0x2ccc0937 }, 5 },
-	{ {0x11f1b9fd, 0xa9a44f59, 0xa6de479a, 0xebc18fbc, 0x6347f5a7 }, 5 },
-	{ {0x38a103e5, 0x40eb5fbe, 0x2627fab2, 0x991bda08, 0x092635e0 }, 5 },
-	{ {0x6d3008b9, 0x7b48d995, 0x22e45056, 0xf52ed944, 0xe3d8e208 }, 17 },
-	{ {0xdcc1ecdd, 0x0e3a2a33, 0xb994e472, 0xea367a16, 0x37cc3799 }, 17 },
-	{ {0x99330820, 0xcf8aef8b, 0xb34d56a6, 0x66accb4b, 0x1ca90e30 }, 5 },
-	{ {0xecb53823, 0x8fc7c5e3, 0x74d723f4, 0xd6120d1b, 0x2ef5d80e }, 5 },
-	{ {0xfe4bd35e, 0x87dd50fd, 0xdd255172, 0x129b9bec, 0x38691188 }, 4 },
-	{ {0xc6d2aa3e, 0x7303e0e2, 0x244256bf, 0xcfc113ba, 0xfe2d6b59 }, 4 },
-	{ {0x206b2a47, 0xf437ba9d, 0xfc85f6d0, 0x1c9e2c18, 0x00000000 }, 4 },
-	{ {0xe178917d, 0x1974ac85, 0xfd58cb93, 0xb936eb9a, 0x6f44ba0d }, 4 },
-	{ {0x2b4c386a, 0x56dddd2a, 0x3354bdf1, 0xa0041d3f, 0xaa0ccc72 }, 4 },
-	{ {0xe178917d, 0x1974ac85, 0xfd58cb93, 0xb936eb9a, 0x6f44ba0d }, 4 },
-	{ {0xbd9852ea, 0x114e8b8f, 0xf781115d, 0x1d6e6da6, 0xf8dfafff }, 4 },
-	{ {0x65a5bda3, 0x4d1e1b22, 0xcfa697e4, 0xe7fdf182, 0x9cf2238d }, 4 },
-	{ {0x502d7cf7, 0xbc2595af, 0x6f83bb2b, 0x95baa4db, 0x5b0f6a4d }, 4 },
-	{ {0xde234922, 0x7d765db7, 0x3cdc44ef, 0xc6338f6b, 0x530eb133 }, 4 },
-	{ {0xa5963fa6, 0xc95fbe34, 0x482862b0, 0xf7221b77, 0x66e3a194 }, 17 },
-	{ {0x2e043630, 0x3648097e, 0x8e936c54, 0x67574aff, 0x5e3f1517 }, 3 },
-	{ {0xf25628e4, 0x74035e6b, 0xf0440b27, 0x4c5df04f, 0x94c49fb8 }, 5 },
-	{ {0x5ec88112, 0x54dc762c, 0x6852289a, 0x08acf229, 0x54404f0d }, 3 },
-	{ {0xb5acea41, 0xaeabb5da, 0xa4183953, 0xf800d47d, 0xb0c39fb5 }, 3 },
-	{ {0x2e2543ac, 0x99193f76, 0xb4f35463, 0x142294c0, 0x16f0cf3d }, 8 },
-	{ {0xd4a188a7, 0xee514c18, 0xdc65f3c6, 0xdea7668b, 0x6cedc374 }, 19 },
-	{ {0xf90064fe, 0x4ffed170, 0xf9e9c791, 0x96aa0b17, 0xe0bbd86b }, 3 },
-	{ {0x523330d6, 0x09ca0e52, 0x7f3e28a0, 0x78635b3d, 0x28489ec9 }, 6 },
-	{ {0xf9486dd8, 0x10d6321b, 0xad4bc9d7, 0x703a67d6, 0x30167f98 }, 5 },
-	{ {0x22f5998b, 0x4de47bf2, 0xccc077d5, 0x881ac448, 0xe6b0484d }, 38 },
-	{ {0xe003d57d, 0x2102e8fd, 0xf5d9eea7, 0xbd78a3cf, 0x67d75778 }, 5 },
-	{ {0x51e4231e, 0x245ffd73, 0x3590e320, 0x5fa3ffea, 0x92ad509f }, 5 },
-	{ {0x68158290, 0x666f4d7a, 0xc1ada40d, 0x674a1160, 0xc162b193 }, 5 },
-	{ {0xd57fc412, 0x1d716182, 0xa091bb53, 0xc666b46c, 0x10142668 }, 5 },
-	{ {0x13c59dd8, 0xf7320856, 0xb15c8340, 0x38af3c84, 0x6db33e4e }, 4 },
-	{ {0xdb1513df, 0xf6dd456f, 0xc9732868, 0x16129ace, 0x81bcdfdd }, 6 },
-	{ {0x4c44939a, 0x95a20d70, 0x1f608304, 0x99254e5d, 0xabedeeaa }, 5 },
-	{ {0xa53feafa, 0x4c70d237, 0x8998f0dc, 0xb837905e, 0x5070c541 }, 5 },
-	{ {0xee501fde, 0x62b25ddd, 0x1c82798e, 0xe1b233b8, 0x813e717b }, 5 },
-	{ {0x4fe1d66e, 0x8f3cbd5e, 0xcd9b22b6, 0xaea2b37a, 0x604f2492 }, 4 },
-	{ {0x55fb4e3d, 0x3a762b61, 0x3b635ee9, 0x745d92f0, 0xf3711272 }, 5 },
-	{ {0xde0eb1c4, 0x6c479248, 0x79e2a49f, 0x9eafba0a, 0xb344fe5f }, 6 },
-	{ {0xe6c01bd9, 0x0cf0b279, 0x3282fc53, 0xe9a3150a, 0x6d7804c5 }, 6 },
-	{ {0xc5e3845c, 0x74da6aea, 0x2cb68ccd, 0x765e4f60, 0x6f10b5b6 }, 6 },
-	{ {0xe3b92412, 0x91b5f19a, 0xb2397263, 0x60258a31, 0xe02565a3 }, 136 },
-	{ {0x845b9263, 0xd75d89ef, 0x02c23fd0, 0x5cccc13d, 0xb5d512ea }, 5 },
-	{ {0x495eb918, 0xced94ef4, 0x7885df40, 0xceceef8b, 0x56e96691 }, 5 },
-	{ {0x31b8b69d, 0xe88d84aa, 0xbdb762af, 0x1adeac81, 0x5723562c }, 5 },
-	{ {0x5ff1254d, 0xccd5dde5, 0x8d3475a4, 0x68178738, 0xd6260b05 }, 4 },
+	{ {0xa0d85c5f, 0xc74547f4, 0x6025369d, 0xa687569f, 0xb5aa3991 }, 19 },
+	{ {0xa0e815c2, 0xd224d05f, 0xb2746e4d, 0x327ec22b, 0xfe5b349a }, 19 },
+	{ {0xa0ed2c50, 0xe55241d2, 0x3bb5d12c, 0xb6528a2a, 0x0c3bc156 }, 19 },
+	{ {0xa11949a2, 0x072d5a2f, 0x58cb63e9, 0x34877bac, 0x46809285 }, 42 },
+	{ {0xa14b357a, 0x1b16163f, 0x5ffa96b0, 0xb617d352, 0x713ac047 }, 19 },
+	{ {0xa1656f61, 0x2360a126, 0xe09ef2ba, 0xaa8002d9, 0x2054125d }, 19 },
+	{ {0xa1680d68, 0x9a8f617c, 0x2186a523, 0xc83c831e, 0x733a687e }, 42 },
+	{ {0xa1830ad6, 0x6feb55f4, 0x71d52210, 0xc6f07937, 0xf38238fe }, 3 },
+	{ {0xa18b1d49, 0xdf954a33, 0x16ed215b, 0x6facfc1e, 0xc020ce13 }, 25 },
+	{ {0xa194b845, 0x857c8b33, 0xef4fd5e5, 0x3d7f3815, 0x0b4fa4cf }, 19 },
+	{ {0xa1abfc53, 0xa36d387b, 0x9f0687e3, 0xf5897c1e, 0xbdf21517 }, 19 },
+	{ {0xa1d4461a, 0xdf060d68, 0x5c4a7e42, 0x01a38b5e, 0x24a03dee }, 19 },
+	{ {0xa1e14912, 0xd45944b9, 0xa6baef1d, 0x4d3a04c1, 0xae8df923 }, 19 },
+	{ {0xa1e1bffe, 0x4b4ea6d6, 0x7c973fa4, 0x83c4d627, 0x3f68de3c }, 19 },
+	{ {0xa1fb6a98, 0x76601b34, 0x3e176693, 0x5cedf61d, 0xab1a8f7d }, 19 },
+	{ {0xa2109da0, 0x8b1921c4, 0xb3b47c68, 0x47598d42, 0x4581b508 }, 19 },
+	{ {0xa21adba6, 0x81956ec3, 0x5816af67, 0x3a9d4f6c, 0x7743253a }, 5 },
+	{ {0xa21d354d, 0xdda95975, 0xd737746d, 0x27fd59cb, 0x908ddf0a }, 19 },
+	{ {0xa25f9b81, 0x3c4488c7, 0x3c5f5405, 0x5748b4db, 0xb057c2e9 }, 19 },
+	{ {0xa27eb9cd, 0x77837c1e, 0x443e275d, 0x0e10888e, 0x0fd248f4 }, 19 },
+	{ {0xa2901318, 0xf8216ccd, 0x2f4d08b0, 0xf272e1bf, 0x90ab197a }, 19 },
+	{ {0xA294F54D, 0xA2BE26F7, 0x90206746, 0x16AF95A2, 0x5428BCD3 }, 19 },
+	{ {0xa2a7c93c, 0x9c8b55a5, 0xcce4c900, 0x5f3c194e, 0x3b762e9c }, 19 },
+	{ {0xa2a9d030, 0x3cb0b36a, 0x73d58e42, 0xb7c2c976, 0xc540597f }, 19 },
+	{ {0xa2ca7e6e, 0x216f8b45, 0x0eb8db10, 0xa4120f03, 0x53275b6b }, 6 },
+	{ {0xa2d2e98f, 0x68042b32, 0xf3225b58, 0xc9989529, 0xd5efacdc }, 19 },
+	{ {0xa2de4575, 0x67e87c79, 0x4fba8e35, 0xc992eac3, 0x52da78be }, 19 },
+	{ {0xa2e14454, 0x6a191da8, 0x829b9ca9, 0xfa019884, 0xfe95156c }, 19 },
+	{ {0xa2f8f8f9, 0xf4626234, 0x2eee0a1d, 0xf7c68710, 0x08a3a189 }, 19 },
+	{ {0xa2f9e125, 0x0c67d2e9, 0x8be70900, 0xd4370545, 0x321cdbfe }, 19 },
+	{ {0xa3028515, 0xed829e90, 0x0cc8deb4, 0x03e17b09, 0xa38bf9b0 }, 63 },
+	{ {0xa3090a15, 0xc95334da, 0x3e0f9403, 0x0eadee02, 0xb5032c0c }, 19 },
+	{ {0xa317d27f, 0xb7a89e48, 0x71fc35b3, 0xb6e1e55e, 0x34d1a180 }, 42 },
+	{ {0xa322d4e5, 0x72467be5, 0xe1b45221, 0x4143f88d, 0xb526b49f }, 5 },
+	{ {0xa3537934, 0xa4d9dfbf, 0x27aca5aa, 0xf42e0f18, 0xe4975366 }, 9 },
+	{ {0xa355e495, 0x23edce5f, 0x15ebf92b, 0x8320ffa6, 0x523c1382 }, 19 },
+	{ {0xa3630152, 0x86341ffa, 0xbcdc38ef, 0x0d890897, 0xed51e322 }, 63 },
+	{ {0xa36c00f3, 0x2cad6b60, 0x3bc5525a, 0x741cb090, 0x64670f34 }, 19 },
+	{ {0xa3772599, 0xcdb84df7, 0x1ef2bb38, 0xb1e2cb2f, 0x66593969 }, 19 },
+	{ {0xa39568be, 0x17b6ee5d, 0x10a61d82, 0xd8480cc8, 0x59be778a }, 19 },
+	{ {0xa3a502af, 0xd3e65b16, 0x05260b37, 0x39b196f6, 0xfd0931e2 }, 19 },
+	{ {0xa3d1212e, 0xb4c58958, 0xf063aa85, 0x77ddfa07, 0x903b28b3 }, 19 },
+	{ {0xa3de0761, 0x2da79863, 0x87a4f5c4, 0x1bbbc7e3, 0xb244e077 }, 9 },
+	{ {0xa3e8e076, 0xb9c8d406, 0x0082233a, 0x2f16184c, 0xf4911a85 }, 4 },
+	{ {0xa3f4e2e4, 0x93407492, 0x5d775afe, 0x30ac72f1, 0x50ede543 }, 42 },
+	{ {0xa3fbf7c2, 0x392c1f97, 0xd3a0946a, 0x5d1654bf, 0x4f7d9b0a }, 17 },
+	{ {0xa3fc0a55, 0xa91ed004, 0x1221f8da, 0x788d824d, 0x9d795913 }, 4 },
+	{ {0xa40674b5, 0xe0ba4490, 0x78cbb074, 0x06edfd26, 0x27306122 }, 4 },
+	{ {0xa417d9e3, 0xfc22f409, 0x32d85ee0, 0x7fd7c365, 0x6b90894e }, 19 },
+	{ {0xa41e43fa, 0x3c64d776, 0x831451c3, 0x5fe8bdee, 0x58625041 }, 19 },
+	{ {0xa420f8d7, 0xd3631b1c, 0x795d1821, 0x62221b21, 0xaaf48f1b }, 19 },
+	{ {0xa4383f78, 0x9482a9e8, 0x68a9f136, 0xaa722129, 0x673c2a81 }, 19 },
+	{ {0xa469935d, 0xd39a856c, 0x06676817, 0xf51b403a, 0x3678ac1a }, 19 },
+	{ {0xa4a75ed3, 0x2c2af3c5, 0xf009661b, 0xb76be4f6, 0x5e2e9a1f }, 13 },
+	{ {0xa4be5763, 0xcdf2dcd6, 0x47b87e3a, 0xecbab28e, 0xcc69776e }, 19 },
+	{ {0xa4d4a6fc, 0x06739c54, 0x3ff0767a, 0x1006ae28, 0x60d9b635 }, 19 },
+	{ {0xa4f15647, 0xa4e50f1c, 0xa7777604, 0xdf07267d, 0xbaa8e12c }, 42 },
+	{ {0xa502e37f, 0x580bd287, 0xed8338fc, 0xb1d809b8, 0xdc90bbe0 }, 19 },
 	{ {0xa52021f1, 0xb257c7c3, 0x5d626d5d, 0x64213409, 0x1c45e4f4 }, 4 },
-	{ {0x7d685547, 0xc2a4b92f, 0xa62e0085, 0x4e4a9689, 0xd495f93d }, 4 },
-	{ {0xb656bd19, 0xdf58fc1b, 0xa4628342, 0xb87beeec, 0x5948e0b3 }, 4 },
-	{ {0x7b959c60, 0x9deaf67d, 0x29e3f79f, 0x55a03f53, 0x961f129e }, 4 },
-	{ {0xc461efa9, 0x42e1a3a1, 0xe580f9d0, 0x4bf8d15c, 0x5e834f8b }, 4 },
-	{ {0x804be214, 0x93a151a0, 0xbe2075e8, 0x6c94759d, 0xd96f0bf7 }, 4 },
-	{ {0x8dfe236a, 0x6a573482, 0x4035725a, 0x4f513b8f, 0xd31b310a }, 4 },
+	{ {0xa52c37c1, 0xf16ba13d, 0x3f39bb54, 0x03c82c01, 0x87cbff51 }, 6 },
+	{ {0xa53610ad, 0xcf84bdb1, 0xb84d94d4, 0xc6d1f0a7, 0xd45e9ddd }, 19 },
+	{ {0xa53d1ea7, 0x75a6c90a, 0x84f1f363, 0x49540b16, 0xcf8307e4 }, 19 },
+	{ {0xa53feafa, 0x4c70d237, 0x8998f0dc, 0xb837905e, 0x5070c541 }, 5 },
+	{ {0xa54c4244, 0x526051d8, 0x87f9d74a, 0x767c254c, 0x08d47ad4 }, 19 },
+	{ {0xa553c3f2, 0x04c105c2, 0x3b227a1e, 0x5aeb2906, 0x71ccdbeb }, 5 },
+	{ {0xA5561715, 0x7C5D89DB, 0x5900654B, 0x641E757A, 0x37FECD1A }, 19 },
+	{ {0xa57f8ec4, 0xf89ab849, 0x36f46821, 0x969de6bc, 0xa9f46d8e }, 5 },
+	{ {0xa5802d5f, 0xe8bcda79, 0x354519d7, 0xe7a7b710, 0xbb6f9db8 }, 19 },
+	{ {0xa58ca651, 0xf4c12bf0, 0x7cf3840d, 0x5e37b534, 0xf5fc075e }, 6 },
+	{ {0xa5963fa6, 0xc95fbe34, 0x482862b0, 0xf7221b77, 0x66e3a194 }, 17 },
+	{ {0xa5dc0aa2, 0x83072f77, 0x2ee4b9eb, 0x93b09665, 0x00dd306b }, 19 },
+	{ {0xa5f3ada0, 0x610ad32f, 0x59d2f114, 0x167612d4, 0xf62bec4e }, 17 },
+	{ {0xa6145a65, 0x8ac51d8f, 0x455ac606, 0x29ed2d11, 0x8d50f1ad }, 19 },
+	{ {0xa649e98e, 0xde62e7ca, 0xe982779d, 0x60674eea, 0x9eb7180e }, 19 },
+	{ {0xa66e19e5, 0x8ac5b4da, 0x7db071ca, 0x7ead40c2, 0x8a332198 }, 39 },
+	{ {0xa6761737, 0x80dc3ef4, 0x523ff312, 0x3fdf1792, 0x79d22932 }, 3 },
+	{ {0xa67e699e, 0xdb471c35, 0xa217a5c3, 0xe6831c6c, 0xdb0eabe5 }, 19 },
+	{ {0xa68733d2, 0x2706aa04, 0xd261147d, 0x67f2a0a9, 0xc17c386f }, 19 },
+	{ {0xa6b2fdae, 0x9551ef36, 0x33926f61, 0x77c771d7, 0x94d1e91b }, 39 },
+	{ {0xa6b77c58, 0x73f220c0, 0x05783397, 0x61552e5e, 0xe82fab62 }, 42 },
+	{ {0xa6cd42c6, 0xcdebcd9b, 0x20330e64, 0xa38bb7ab, 0xde5bbe30 }, 19 },
+	{ {0xa6d285e5, 0x15ad1e2c, 0x15b4352d, 0x9b699ebe, 0x060b1dba }, 6 },
+	{ {0xa70c6b0e, 0x90e7b8ba, 0x3e5bc06c, 0x9ae7d6af, 0x344e491f }, 19 },
+	{ {0xa72724a7, 0x9c2c50ec, 0x66046c08, 0x28934b5c, 0xad11b7c9 }, 19 },
+	{ {0xa731d3d3, 0xb5badf33, 0xc7602feb, 0xd32cc4e6, 0xec98c646 }, 17 },
+	{ {0xa7a23dc0, 0x1314e883, 0x81eee88b, 0x4878b399, 0x31ab4818 }, 30 },
+	{ {0xa7b196f7, 0xe934faa7, 0x6602c8c0, 0x0bd2f6e6, 0xd2d70787 }, 3 },
+	{ {0xa7c36fe1, 0x9bb4559e, 0x8cc38ca1, 0xfae1625e, 0xe14b5625 }, 19 },
+	{ {0xa7cf4cbe, 0x12c8956c, 0x0a51a5c2, 0x336fe70a, 0xee7f4a65 }, 42 },
+	{ {0xa8059dc1, 0x820b4614, 0x18713acf, 0x2af14f3a, 0x25734bd3 }, 5 },
+	{ {0xa80b5426, 0xfd0f4ab1, 0x9eba1c06, 0x620f5efb, 0x8fbade3a }, 4 },
+	{ {0xa8186cd3, 0xef78662c, 0x87665df5, 0x2026ecba, 0xe4866bfd }, 6 },
+	{ {0xa8313b0d, 0xce35faa8, 0x0b399a22, 0x0f19b043, 0x33fdec1d }, 19 },
+	{ {0xa84608f1, 0xc2fe1aea, 0x1a8a586f, 0x2e335cb6, 0x4bb951fc }, 19 },
+	{ {0xa87971b9, 0xdf0de446, 0x44c2188f, 0x5f475aef, 0x7ae85304 }, 19 },
+	{ {0xa8ac24a7, 0x02d2c850, 0xc7a15b51, 0x96893817, 0xb0c93123 }, 5 },
+	{ {0xa8eeac42, 0x8a5992a2, 0x390b1827, 0xdb1358f4, 0xc733e200 }, 17 },
+	{ {0xa8eff8c5, 0x32da894c, 0x86198b04, 0xb0a5d770, 0x7feb28c5 }, 19 },
+	{ {0xa9bf062f, 0x695475e8, 0x4be4ab78, 0xafb9715f, 0xc3f6f40e }, 19 },
+	{ {0xa9d371c0, 0xeec519c4, 0x8af880df, 0x540e03da, 0x572f263d }, 19 },
+	{ {0xaa13b346, 0xe11644f8, 0x426fc546, 0xb359bc6f, 0xd7c6b357 }, 4 },
+	{ {0xaa1621a6, 0xb61f7cfb, 0x2df8dd2c, 0xf8647a94, 0x3e13dfa7 }, 19 },
+	{ {0xaa2aaa19, 0x3cddd15c, 0x23068449, 0x9d68bf73, 0xf715ed9c }, 19 },
+	{ {0xaa2ba89e, 0x0b1c91a4, 0x405f516e, 0xf003ad14, 0xa401096c }, 19 },
+	{ {0xaa6055ba, 0x0e433aa9, 0xc93df444, 0x4783cacb, 0x9628a7e2 }, 3 },
+	{ {0xaa68633f, 0xf1afd385, 0x535b2abd, 0x7c8756b6, 0xcf79256a }, 19 },
+	{ {0xaa78fc9b, 0xcd2343f8, 0x4cf79031, 0x0a768ee4, 0x7f90c841 }, 42 },
 	{ {0xaa881a29, 0x36f368ab, 0x887c296b, 0x837a8f7f, 0x553a3fb2 }, 4 },
-	{ {0x847841ad, 0x88ff2eff, 0x6602f03b, 0x7231cd1e, 0x03f89ffc }, 4 },
-	{ {0x8449cdf1, 0x61babec8, 0x5508c35c, 0x8ca64a5c, 0x1fd7671d }, 4 },
-	{ {0x1417f9e8, 0xca99deb3, 0xb422c596, 0x8fdfa03c, 0xfa633ec6 }, 4 },
-	{ {0x65040fb1, 0xe9bc4b2d, 0x027d7d81, 0xe44be30e, 0x7620e368 }, 4 },
-	{ {0x356a9369, 0x87e62967, 0x597ec64a, 0x0d35a1e8, 0xad1aa20b }, 5 },
-	{ {0xe7b8574a, 0x42b10295, 0x39632ce0, 0xf5161b1c, 0x38d5e95f }, 3 },
-	{ {0x4ad4898d, 0xb3bdcf87, 0xb2acd575, 0x5e06d45c, 0x73d338cd }, 5 },
-	{ {0x8262ac06, 0x9e395ba0, 0x20025caf, 0x0519e8eb, 0x5a63a0b8 }, 5 },
+	{ {0xaa95e2c1, 0x96a59b67, 0xbede3536, 0x6275a485, 0x57b1ae06 }, 19 },
+	{ {0xaa9f3ffc, 0xc977fbcc, 0x04a0326d, 0x5a7371d3, 0x72d099f5 }, 19 },
+	{ {0xaab3416a, 0xa54fa9b4, 0x9e98c828, 0x6ba6a8f5, 0x093545d9 }, 19 },
+	{ {0xaacaf2e6, 0x94a1c05f, 0x2ef20a8c, 0xe6892242, 0xc0f88919 }, 19 },
+	{ {0xaace4ef0, 0x766ec752, 0x97cf1945, 0xfe81de4e, 0x9c0a2b0f }, 63 },
+	{ {0xaad42ba4, 0x289b33d8, 0xeed225d4, 0x2cea930b, 0x7fc5c228 }, 78 },
+	{ {0xaadbd54e, 0xdd09d44e, 0xeee77fd0, 0x40039fab, 0xd3f9775b }, 19 },
+	{ {0xab017762, 0x4d46dd77, 0xab4f50ff, 0xcb983c3b, 0xa88223f4 }, 1 },
+	{ {0xab087d04, 0xeb5c2c88, 0x94758c7c, 0xee32ccaf, 0xd80989a7 }, 5 },
+	{ {0xab29429f, 0x7d2df7ce, 0x4bab46d1, 0xd0f2b782, 0xdf7f908e }, 19 },
+	{ {0xab30cdea, 0xacbdf14e, 0x6366d43d, 0x88133817, 0x8fc665cb }, 3 },
+	{ {0xab372a7c, 0xe8aca99a, 0xaad5295e, 0x06cb9f51, 0xcbbc7a21 }, 64 },
+	{ {0xab3f375b, 0x6890b2a9, 0xbb1b6124, 0xf0fa6909, 0x50c749f2 }, 6 },
+	{ {0xab7354c9, 0xced9782d, 0x572c4dd6, 0x9249b76a, 0x1244e5ce }, 19 },
+	{ {0xab924f3b, 0x59a5aee1, 0x5be02584, 0x442a5eec, 0x8ff4e908 }, 19 },
+	{ {0xaba839d5, 0x54733850, 0x902f3073, 0xf7974e2e, 0x87c488ba }, 5 },
+	{ {0xabb5cd4c, 0x8bdde234, 0xcadb0e10, 0xb794be32, 0x49dc51a5 }, 19 },
+	{ {0xabce0b85, 0x5d67ac10, 0xbc667e0f, 0x23ceab4a, 0x12ffeee6 }, 19 },
+	{ {0xabd50f12, 0xd8bc5c4c, 0x8ed2ace6, 0xdd8e98cd, 0xfefadb0e }, 42 },
+	{ {0xabe52920, 0xe895c148, 0x851649ec, 0xb9c029fd, 0xc41a275f }, 6 },
+	{ {0xabe625e8, 0x53cde990, 0x8a302f63, 0xda407d3e, 0x67c6e59e }, 19 },
+	{ {0xabeccfe4, 0x9a687470, 0x2d65eb4d, 0x06a970d8, 0xfcf55123 }, 3 },
+	{ {0xac1096e7, 0xb725830e, 0x61213b2b, 0x26310ff3, 0x22df2946 }, 19 },
+	{ {0xac109dac, 0x24df4dae, 0x813ca5d9, 0xf0938cc4, 0x8a162bb1 }, 6 },
+	{ {0xac150939, 0x558ec4e5, 0x6446be95, 0x02177f28, 0xa29881eb }, 19 },
+	{ {0xac2475e9, 0x55e98c5d, 0x5816ec60, 0x118b424b, 0x46c30670 }, 19 },
+	{ {0xac381dfb, 0x4d0b52de, 0xdb18a8df, 0x7a4651ed, 0x2978d12f }, 19 },
+	{ {0xac391fe5, 0x1f69e0a5, 0x5fe3ab66, 0xc8ec3f27, 0x92dd5d08 }, 19 },
+	{ {0xac4facb5, 0x17e2383b, 0x4cb22504, 0xcda961b1, 0x5af0a83e }, 56 },
+	{ {0xac5639b8, 0xca66600e, 0x61452697, 0xed44b486, 0x07256065 }, 19 },
 	{ {0xac71117e, 0xb20ec8a8, 0x4035acbb, 0xd380df82, 0x35a5c665 }, 5 },
-	{ {0xaf567ea6, 0xe27912d6, 0xd5bf1c8e, 0x9bc18e9b, 0x393fd1ab }, 3 },
-	{ {0x983eb5de, 0xeb61af5c, 0xe82ad598, 0x692192b8, 0xae8a2a08 }, 3 },
+	{ {0xacab2c61, 0x47df1015, 0x36efde0d, 0x57ca4ccd, 0xe8ba3379 }, 19 },
+	{ {0xacb6e932, 0x27bc89da, 0x119443e0, 0x3890b58a, 0x1befc0b0 }, 19 },
+	{ {0xacc14e98, 0x86a3281b, 0x658dc458, 0xc1ae93fa, 0x9f24db04 }, 19 },
+	{ {0xacc93f81, 0x8a9f2925, 0xbfcc61df, 0x7d9fe2e0, 0xcbc0a9ae }, 19 },
+	{ {0xacce81bf, 0x851fa586, 0x9cd75181, 0xdf4fcf7d, 0x4489a9db }, 19 },
+	{ {0xacd46021, 0xa228b2b6, 0x12c82d04, 0xc124b78e, 0x7d4c25e3 }, 42 },
+	{ {0xad1081f3, 0x98ac69c0, 0xc92e4afa, 0xdde48257, 0x4fe875bb }, 3 },
+	{ {0xad2e1e95, 0x7ee469d5, 0x1faa07a9, 0x9a20dbf0, 0x0003dacf }, 19 },
+	{ {0xad3d8fc2, 0x201a245e, 0x35287591, 0x8e421b42, 0x764e4148 }, 5 },
 	{ {0xad621247, 0xf95f80a1, 0xa32e67de, 0xf5e978c8, 0x45d19208 }, 3 },
-	{ {0xa7b196f7, 0xe934faa7, 0x6602c8c0, 0x0bd2f6e6, 0xd2d70787 }, 3 },
-	{ {0x7be2f14f, 0xd0df5718, 0xcdb69b97, 0x2c5f7c1f, 0x284b03e6 }, 3 },
-	{ {0x53e1fb8e, 0xe77757cd, 0x20bf4c7a, 0xa4a5c6c7, 0x86c664d6 }, 3 },
+	{ {0xad995ede, 0x603a28c7, 0x2dad06c2, 0x45fc7d4d, 0xad85d230 }, 3 },
+	{ {0xadb39773, 0x09d373ad, 0x1dc995ae, 0x7d2f8280, 0xf1673d66 }, 19 },
+	{ {0xadc65666, 0xdb35cd2c, 0xe694a8e2, 0xf32b95bd, 0x98d72291 }, 19 },
+	{ {0xade0c5ba, 0x5574f811, 0x4d707905, 0x0317099b, 0x4519e88f }, 40 },
+	{ {0xae0c0b0c, 0x9468e137, 0xeba5b52f, 0x96241acd, 0x55d9746a }, 19 },
+	{ {0xae24f03a, 0x969bfc73, 0x94b9620c, 0x8f227ae9, 0x7627a7ce }, 56 },
+	{ {0xae3bd232, 0x0892fb02, 0xab9facce, 0x986af078, 0x07513600 }, 39 },
+	{ {0xae3c3c2c, 0x022f566d, 0x2e790aba, 0x193470d5, 0x826f36cf }, 6 },
+	{ {0xae4a6632, 0xd4456ef4, 0x4603e72f, 0x5acd5bbc, 0xd6c0d124 }, 1 },
+	{ {0xae52922a, 0x197a2f47, 0xc7fc4adf, 0x9dbfde13, 0xc136ed14 }, 19 },
+	{ {0xae5b8e69, 0x732a23ae, 0xe102bcd9, 0x96ad0622, 0x5f1b3eba }, 19 },
+	{ {0xae62d7cd, 0x44e6a85e, 0xe6d30a31, 0x9ef5e347, 0x6f784148 }, 19 },
+	{ {0xae6ad52d, 0x5ebcad77, 0x22ea0701, 0x09a286fe, 0x13b06cb7 }, 5 },
+	{ {0xae6d0efd, 0x55def942, 0x74f4cec4, 0x59df8927, 0xd132675a }, 19 },
+	{ {0xae8172bc, 0xf76adfa3, 0xd401467c, 0xbc89cbec, 0x2db86ee2 }, 5 },
+	{ {0xae8c7355, 0xc8292483, 0x05384243, 0xf78a8704, 0x53367e77 }, 19 },
+	{ {0xaea0e4a6, 0x35efce53, 0x36e496d3, 0x6e4cb0a4, 0xb79593ff }, 1 },
+	{ {0xaeb705ac, 0x42f8d9d6, 0x2ecdb258, 0x99535d1f, 0x14f1c49c }, 39 },
+	{ {0xaeca6948, 0x208b14d1, 0x12b4733a, 0xdedea026, 0x56b706a0 }, 19 },
+	{ {0xaee97fa5, 0xe5ead1ff, 0x4f0bd4a7, 0x2872a929, 0x3e3fb536 }, 19 },
+	{ {0xaeeb8ddb, 0xd385bc3a, 0xba500967, 0x6e5192d3, 0x2beecf15 }, 19 },
+	{ {0xaeecb99e, 0xd7bfe2ff, 0x39a5f426, 0x37b6b33e, 0xcc79c443 }, 19 },
+	{ {0xaf1a6f4d, 0xd12d726a, 0x7a437775, 0x3ce3db82, 0xbf24eba4 }, 19 },
+	{ {0xaf310ee2, 0x1b5534f3, 0x2ea92c0a, 0xe34a44d8, 0x28d157a7 }, 5 },
+	{ {0xaf3524ca, 0xccd33ccb, 0x7a5b42b1, 0xce4314d0, 0x55e01672 }, 5 },
+	{ {0xaf4e0490, 0xc178a18a, 0x47b34831, 0xfb5e3cf8, 0xb61d34d9 }, 19 },
+	{ {0xaf567ea6, 0xe27912d6, 0xd5bf1c8e, 0x9bc18e9b, 0x393fd1ab }, 3 },
+	{ {0xafb693fd, 0x0a138cfc, 0x59a2bf81, 0xeabd7ca2, 0xabd4e162 }, 5 },
+	{ {0xafe11b84, 0x0b7bf024, 0x3b1c4f98, 0x309e274a, 0x3ddde35f }, 19 },
+	{ {0xaffa3c5c, 0xd8db79a1, 0x450ad8a7, 0xf405a425, 0xb251653d }, 1 },
+	{ {0xaffc4dcc, 0x0b2c8846, 0x202cd99a, 0x2f0ef27f, 0xc705d96d }, 19 },
+	{ {0xB00FDE74, 0x73740966, 0xC0713ED2, 0xE6043B2C, 0xD6D9262B }, 19 },
+	{ {0xb01434c6, 0xbc67efef, 0xe4dce17d, 0x85283866, 0x61db92b2 }, 1 },
+	{ {0xb030b3c2, 0x2baadd0d, 0x419657dc, 0xfa4b974a, 0xe1cd7508 }, 19 },
+	{ {0xb034764e, 0x6a8978db, 0x60b1d652, 0x917f5e24, 0xa66a7925 }, 1 },
+	{ {0xb0378652, 0x8689b201, 0x4c90493f, 0x3e02d941, 0xc73122bc }, 19 },
+	{ {0xb0406a38, 0x453c3bff, 0xcc990576, 0xbb725bbf, 0x7acaf132 }, 19 },
+	{ {0xb07a6ae6, 0x19fcc629, 0x1838959d, 0xc1a899de, 0x832f8d97 }, 19 },
+	{ {0xb084a949, 0x23ce948c, 0xb39dc186, 0xd83015f7, 0x487cfbe4 }, 19 },
+	{ {0xb0956b97, 0xc9087aab, 0xab333c27, 0x1c7afd97, 0x54ae84cd }, 19 },
+	{ {0xb0d384ec, 0x10f59d20, 0x1f346a3c, 0xd7eb31b9, 0xa80c28ca }, 19 },
+	{ {0xb103d424, 0x8729aeda, 0x9ebf5766, 0xc1791b19, 0x50246968 }, 19 },
+	{ {0xb11b93ad, 0xd30086ce, 0x00d21262, 0x52893700, 0xca6fd82b }, 19 },
+	{ {0xb11c0ded, 0x529af18c, 0x29ec46b9, 0xe0a795ed, 0x0405e7ec }, 5 },
+	{ {0xb1248f7b, 0x9d4e16a8, 0x94555c51, 0xc533d3fd, 0x9a90802e }, 19 },
+	{ {0xb154c8ec, 0xe9646864, 0x327c97ab, 0xaf49c133, 0x4cd392c7 }, 96 },
+	{ {0xb15e73a5, 0xff1ae17a, 0xc67f2ceb, 0xb5862d5e, 0x5bd80bc0 }, 42 },
+	{ {0xb17d9bea, 0x0eb16a1a, 0xa2d0ccbd, 0x7c9488da, 0x9f57698e }, 1 },
+	{ {0xb186d547, 0xc0b79612, 0xbffb63dd, 0x49c3230f, 0x156c2bbe }, 19 },
+	{ {0xb188980c, 0x998d1dfb, 0x5dfbc218, 0x37ffbbb5, 0xaffdbb3c }, 5 },
+	{ {0xb18d36cc, 0x60d0e3b3, 0x25138bb9, 0x8472b685, 0xcca89f90 }, 9 },
+	{ {0xb1a154ed, 0x8f52c2a7, 0x4457e1c0, 0x3c996081, 0x81dfb8ee }, 39 },
+	{ {0xb1a97ef6, 0x5f2bc3e7, 0x9b628a51, 0xfde8dc98, 0xf37d9db6 }, 19 },
+	{ {0xb1cce60e, 0xf61c058f, 0x5e42ef7a, 0xc635018d, 0x1a431168 }, 1 },
+	{ {0xb1cf4532, 0x06beef8a, 0xb2ede2b0, 0x61ed95a3, 0xcd91eae3 }, 4 },
+	{ {0xb1d51597, 0x8727888f, 0xfe3eaf31, 0xcaf29623, 0x5893e01d }, 42 },
+	{ {0xb1e6299c, 0x4711d2f5, 0x71b72f11, 0xd3b1aeb2, 0x3eb99b64 }, 19 },
+	{ {0xb20e02cb, 0xffef692c, 0x7aee6281, 0xeb36729e, 0xe1e928ef }, 5 },
+	{ {0xb210047a, 0xf5ccc352, 0xcc044bf6, 0xc1419552, 0x223bf8dc }, 17 },
+	{ {0xb25b7fda, 0x37ba2a02, 0x362a45b2, 0xacdb2103, 0xf9a6e323 }, 42 },
+	{ {0xb262aedc, 0x71b44530, 0x3f84efe5, 0xe865cbb7, 0x1fd7d952 }, 39 },
+	{ {0xb272f73f, 0xe2cb27de, 0x212d6753, 0xaf0e0981, 0x2a707f0e }, 19 },
+	{ {0xb27a3e67, 0x215aadc9, 0xbafd80f1, 0x84c6be0b, 0x26731076 }, 56 },
+	{ {0xb2bcc1c0, 0xd64b6ee9, 0xf0e9bbbc, 0xf0ef7b64, 0xd80d3b90 }, 19 },
+	{ {0xb2cca92b, 0x7a51a43c, 0x310e58e0, 0x11f3ede1, 0xe7125a96 }, 6 },
+	{ {0xb2ce0bc8, 0x6f82f727, 0xdb956dfb, 0xbe2a3fd0, 0xcb72f5fc }, 38 },
+	{ {0xb2d9dcee, 0x787ace26, 0xf8f4d2d1, 0x8e24a3d6, 0x45a6f853 }, 39 },
+	{ {0xb31f223d, 0xd6304244, 0xc49c026e, 0x26503b58, 0x6ebc1885 }, 19 },
+	{ {0xb3370cdf, 0x4707d9c3, 0x8afc0f42, 0xc11cba5e, 0x745ead6a }, 19 },
+	{ {0xb337ea56, 0x278523f9, 0x84d1b000, 0xcd00f339, 0xd82017a0 }, 19 },
+	{ {0xb36c9250, 0x05f1e530, 0xcab2b5f6, 0xe2a5ddfd, 0x182c0140 }, 19 },
+	{ {0xb3942217, 0xa49f9aed, 0x9497886b, 0x45c03cf0, 0x798dc7e3 }, 19 },
+	{ {0xb3b31931, 0x1243e20a, 0x25712fbe, 0x861f4e6e, 0xa7f36915 }, 19 },
+	{ {0xb3c2dc4d, 0x1c940ddb, 0x4b9e742b, 0x8f5a47ab, 0x1e2d385f }, 19 },
+	{ {0xb3ca70c8, 0xc8120f82, 0x61bb865b, 0xaf5f57b6, 0x506ca02e }, 19 },
+	{ {0xb3d57f96, 0x8fdfebe7, 0x7f78c05f, 0x4a075d13, 0x9f219ae0 }, 19 },
+	{ {0xb40b178c, 0x6876cf3d, 0xedf4ae48, 0x262a5914, 0xc5f674fd }, 25 },
+	{ {0xb4333576, 0x83fb1154, 0xd75c677b, 0xa0189366, 0x5880f483 }, 19 },
+	{ {0xb43a4be5, 0xc754f68d, 0xc3ee64ee, 0xe29d64f3, 0x0fac2aff }, 65 },
+	{ {0xb4433a39, 0x75c57dd4, 0x40d6bf12, 0xdbd28b2a, 0xc1b90ef4 }, 42 },
+	{ {0xb45172e4, 0x628f68c3, 0x2cd13c73, 0xcf17c4dd, 0x1bed1bb2 }, 4 },
+	{ {0xb4788d85, 0xe6795017, 0x7882ea4c, 0xf6a5fa32, 0x19f3fbd0 }, 3 },
+	{ {0xb484c8fa, 0x4549b79c, 0xff976001, 0xac4beb19, 0xabf7cfb5 }, 65 },
+	{ {0xb493dd7d, 0x082e25fc, 0x40ad1ccc, 0xc364e194, 0x5590a2f9 }, 3 },
+	{ {0xb4dd886d, 0x4a44cc42, 0xfc9e95d2, 0xdb0943d4, 0x22e4bda8 }, 42 },
+	{ {0xb52b68e6, 0xaaa3be87, 0x6b3349a3, 0x2b388853, 0xea32fbcc }, 19 },
+	{ {0xb5414e11, 0xb227c3c8, 0x28ee1de2, 0x06bf2d8f, 0x14486bd4 }, 42 },
+	{ {0xb550757c, 0x8f5b55db, 0xde16b4a7, 0x888f1099, 0x9f01acfd }, 4 },
+	{ {0xb5749b4c, 0xac530e26, 0x1da9acc0, 0xd494a817, 0x66d2acc3 }, 17 },
+	{ {0xb58caf47, 0xc953b6f0, 0x0935a201, 0xbfccf7ee, 0x968dff32 }, 19 },
+	{ {0xb58e77f8, 0x19dfbde7, 0x2845801c, 0xff4b4e0a, 0x2f20ef5f }, 4 },
+	{ {0xb5acea41, 0xaeabb5da, 0xa4183953, 0xf800d47d, 0xb0c39fb5 }, 3 },
+	{ {0xb5afee9c, 0x37901735, 0x4fbefce7, 0x97701efe, 0xeb30caea }, 19 },
+	{ {0xb5b24db1, 0xa01ba677, 0x8b6768df, 0x15efb097, 0xfad5856f }, 19 },
+	{ {0xb5b28f53, 0xb16d4374, 0x2d9d7daf, 0x5ee7dcf7, 0x4b80e6c8 }, 39 },
+	{ {0xb5bb76d6, 0x66dda2c3, 0xad93f2ec, 0xe44be72f, 0x5d0f61e3 }, 19 },
+	{ {0xb5bcbe2d, 0xfeaf7cc1, 0x56c0d8bb, 0xf4fdcbe9, 0x7b2007d4 }, 3 },
+	{ {0xb5cdef44, 0xb22c7e23, 0x4895b053, 0xe487233c, 0x117d1a4f }, 19 },
+	{ {0xb5cf0368, 0x4c03dd74, 0xa9d5def3, 0x4a4c2fc6, 0x21c8b20d }, 42 },
+	{ {0xb5d130a5, 0x0f693902, 0x8702c164, 0x5426a29e, 0xc8ead6e5 }, 19 },
+	{ {0xb60dea0a, 0x4256869a, 0x1cd0d104, 0x4cde4269, 0x7852552e }, 19 },
+	{ {0xb63fc17c, 0x1d004ca4, 0xd7f3b1ef, 0x8962210a, 0x779ca665 }, 6 },
+	{ {0xb656bd19, 0xdf58fc1b, 0xa4628342, 0xb87beeec, 0x5948e0b3 }, 4 },
+	{ {0xb660a4e2, 0xf45477a6, 0xb62201ca, 0x2ac9cd36, 0x748c18d9 }, 19 },
+	{ {0xb677a861, 0xb67e8763, 0xa11d5dcf, 0x52416b42, 0x493ade57 }, 1 },
+	{ {0xb6a5552e, 0xffcee708, 0xb665fa74, 0xe5ce7b0f, 0xa2541c03 }, 4 },
+	{ {0xb6d3649a, 0x6647fa9f, 0x6bd61efc, 0x317485a2, 0x0901128f }, 1 },
+	{ {0xb6d39bba, 0xedb89f8c, 0x908cc2f4, 0x4a0ab17e, 0x4b80ca4f }, 19 },
+	{ {0xb6f10b6b, 0xedc26d94, 0x15335997, 0x493139ce, 0x7a2c7916 }, 19 },
+	{ {0xb6f8e143, 0x1bda1296, 0xc2959b10, 0xb021b80e, 0x0ff2a8a2 }, 19 },
+	{ {0xb7068e2a, 0xab020728, 0x52ca2495, 0x96b7550a, 0xc632c4c2 }, 57 },
+	{ {0xb7104477, 0xc8801fe5, 0x4d1ba91f, 0x3a77ac6e, 0x4f399f52 }, 6 },
+	{ {0xb74f759b, 0xa3837968, 0xa04e9b64, 0x321b47cf, 0x087e76ff }, 5 },
+	{ {0xb755d7db, 0x109cd0a9, 0x392accd1, 0xc83e6d99, 0x5a8a04d6 }, 19 },
+	{ {0xb76f2e8d, 0xf68968e3, 0xaf8a10f7, 0xe5966448, 0xd6665cb6 }, 39 },
+	{ {0xb76ffb94, 0xa08457df, 0x0a51897c, 0xd87cd8a9, 0x1610224c }, 19 },
+	{ {0xb7b4d5c8, 0x3d8c336d, 0xbfe32833, 0xbba974ce, 0xa7f0cb8d }, 19 },
+	{ {0xb7b4e4cd, 0x40a856bb, 0x071976e6, 0xcf0f5e54, 0x6fc86a78 }, 1 },
+	{ {0xb7e279cd, 0x68faa5ae, 0xe4434480, 0xfeebdf18, 0x9fb54e73 }, 19 },
+	{ {0xb7f36450, 0xd1ac7683, 0x4046fd58, 0x2d6e77a6, 0xd3881a8c }, 3 },
+	{ {0xb7fd07b7, 0x825c6bee, 0xb19b1f38, 0x631d2869, 0xf60939fb }, 19 },
+	{ {0xb8131232, 0x19446f16, 0xcd10b916, 0xcc18ec4a, 0x8d7c69de }, 56 },
+	{ {0xb815cb22, 0x2a6314c1, 0xadad0945, 0xaf7be759, 0xa14c200a }, 19 },
+	{ {0xb81dd702, 0xafaaa594, 0x6e4ec065, 0x042c891a, 0xd2f76c2b }, 17 },
+	{ {0xb82dc590, 0xaadc930b, 0x43db303b, 0xb3e3458e, 0x7695e3b5 }, 19 },
+	{ {0xb88e9c54, 0x8873dcfd, 0x190e0e38, 0xf7b27934, 0x4eea41ec }, 19 },
+	{ {0xb8e30d60, 0x4d319d51, 0x1cbfbc61, 0xe5d8c38f, 0xbb9c5a33 }, 1 },
+	{ {0xb8f4ee14, 0x6c3cdb8f, 0x506371d0, 0x01e6398e, 0xcda85251 }, 3 },
+	{ {0xb8f9248a, 0x6f2bc02e, 0xd2dcae3f, 0x21d6fe0e, 0x572e23fe }, 19 },
+	{ {0xb98242b0, 0x8c8779d8, 0x6b516cca, 0x6d5d6e35, 0xec3600e0 }, 19 },
+	{ {0xb987a785, 0x8c9fbf2a, 0x996cc200, 0xf52fb2a8, 0x40766eb2 }, 19 },
+	{ {0xb9aad68e, 0x2338ab18, 0x14f2dac7, 0x8b2c4b58, 0x77d29cee }, 39 },
+	{ {0xb9ac3ac1, 0x5b49eaab, 0xcb640cc6, 0xb48f4706, 0xe0f18246 }, 19 },
+	{ {0xb9c98b80, 0x216983f9, 0x7e28293b, 0x576ca9be, 0x3602c1a1 }, 19 },
+	{ {0xb9d2e0b6, 0xbb7f2b02, 0x7c9beb0c, 0x762d127e, 0xfcfff127 }, 19 },
+	{ {0xb9d46267, 0xd081882d, 0xfd89342d, 0x3e09b82d, 0x7e8f618d }, 41 },
+	{ {0xb9d5ec44, 0x8d5de19c, 0x62dc09ff, 0xe3b257e0, 0xcef610d2 }, 19 },
+	{ {0xb9ee4f30, 0xa36e283a, 0x2b1b9a28, 0xa70ab9b9, 0x831570c6 }, 87 },
+	{ {0xb9faa034, 0x49949cb1, 0xb1990955, 0x61e0f07c, 0xca2c8e0b }, 42 },
+	{ {0xba07b1b5, 0x85386f88, 0x7d4c7e45, 0x7210b3fc, 0xe819709a }, 4 },
+	{ {0xba30ad98, 0xa8488bec, 0x6d0c661f, 0x7b859beb, 0x2fe219d1 }, 19 },
+	{ {0xba325451, 0xfb5a80c2, 0x872742c5, 0xbd61e7bb, 0x75c5763b }, 19 },
+	{ {0xba6bff43, 0xe5773c67, 0x77f73ebc, 0x63b4f384, 0x66dc2630 }, 19 },
+	{ {0xba83a80a, 0x0041e3a8, 0xfb5c075a, 0x9b4a29ee, 0x92255d62 }, 65 },
+	{ {0xbadcb43e, 0x490e3713, 0xbf291e83, 0xcff204e1, 0xc57ecdfe }, 5 },
+	{ {0xbae8548f, 0xaded657c, 0xca06c2b0, 0x2a59e00c, 0xf1e55484 }, 4 },
+	{ {0xbb3df0a7, 0x656249e4, 0x86accc60, 0xf583d3dd, 0x41db590b }, 19 },
+	{ {0xbb422bc2, 0x72c72979, 0xb50e2c23, 0x11c649b5, 0x51c0fdfa }, 19 },
+	{ {0xbb59c849, 0x898d46a2, 0x3fdbd0cc, 0x04ab3508, 0x8e74a18d }, 57 },
+	{ {0xbb7468dd, 0x32a16085, 0x1b39121d, 0x24713b0b, 0x4e065c19 }, 19 },
+	{ {0xbb75492c, 0x6ebbbf18, 0x27b3695f, 0x70e481d6, 0x5487da44 }, 19 },
+	{ {0xbb902e82, 0xa2bdda61, 0x101a9b36, 0x46462ade, 0xcdd18c8d }, 11 },
+	{ {0xbb99fe77, 0x02733ab0, 0xf9e8856e, 0x91f5ddcb, 0x55d30b5f }, 6 },
+	{ {0xbbabc8ce, 0x1e39d440, 0x5dee5877, 0x37e4dea2, 0x4477c24d }, 19 },
+	{ {0xbbca0b00, 0x374ba536, 0x6ba53b38, 0x0285d388, 0x57450a7d }, 19 },
+	{ {0xbbe8df03, 0x4869a06c, 0xb263255a, 0xc04374de, 0x469c00ba }, 19 },
+	{ {0xbc06bd3d, 0x6f138da8, 0xf5d38b47, 0xe459b4d1, 0x942e49e4 }, 3 },
+	{ {0xbc3be8f8, 0x29211dd8, 0xa8eb854f, 0x86ff014c, 0x47ed9254 }, 19 },
+	{ {0xbc4b2426, 0x47116f48, 0x86bb92e8, 0x6421f97b, 0x1be51938 }, 105 },
+	{ {0xbc76a049, 0x70c547b7, 0xc080e747, 0xd393d13c, 0x87e82e7d }, 19 },
+	{ {0xbcdb4dae, 0x303dfe52, 0x34f372d7, 0x0a5e0271, 0xd3202c36 }, 24 },
+	{ {0xbcf72a46, 0x73c79823, 0x61db4efa, 0xf8ebc776, 0xb6539938 }, 19 },
+	{ {0xbcfdb43b, 0x275c62a7, 0x6856aab9, 0x4fb1b53b, 0xd92b2db2 }, 19 },
+	{ {0xbd1435a1, 0x9ba89514, 0x9fa5b884, 0x25316171, 0xd165c323 }, 17 },
+	{ {0xbd44cc15, 0x2851d9f3, 0x827fb304, 0xf3e4780e, 0xe607f896 }, 19 },
+	{ {0xbd46981d, 0x1b580ec9, 0xa2d1d909, 0xf5c1a8df, 0xd9a71ed7 }, 19 },
+	{ {0xbd4b8c48, 0xf1d8107f, 0x11ae680a, 0x787d7b38, 0x25669b7c }, 19 },
+	{ {0xbd70b00c, 0xcb8fafca, 0x883c7160, 0x585e9c59, 0x20cca58f }, 6 },
+	{ {0xbd8227af, 0x9833b7c0, 0x2fa8ecff, 0x6416b7cb, 0x9e3e1de4 }, 19 },
+	{ {0xbd865b52, 0xe80ae713, 0xf34e1d21, 0x37553011, 0xd0983e36 }, 19 },
+	{ {0xbd8f335f, 0xc45e9920, 0xf0691a52, 0x5a0fc853, 0xb2e4b595 }, 19 },
+	{ {0xbd9852ea, 0x114e8b8f, 0xf781115d, 0x1d6e6da6, 0xf8dfafff }, 4 },
+	{ {0xbe165012, 0x55617bad, 0xe264dbf6, 0x3dc59008, 0xe1d84ac8 }, 19 },
+	{ {0xbe2d023f, 0x5f1ee4cf, 0xbdc712c8, 0xef9eda9d, 0x07278d88 }, 6 },
+	{ {0xbe42c55f, 0xfebc1aea, 0x52447512, 0x8cb687e2, 0xafe8e2e4 }, 19 },
+	{ {0xbe608739, 0x9419e253, 0x9751faf3, 0xaa079c45, 0xfcd590c7 }, 19 },
+	{ {0xbe7cfd5c, 0xa5d78b99, 0xc05dbda1, 0xe26f4afb, 0xddb50c48 }, 19 },
+	{ {0xbe8bb7f5, 0xe812cd31, 0xa65aec37, 0x82a2d526, 0xbef9b3d6 }, 19 },
+	{ {0xbe9d337d, 0xd412056f, 0x5fe78fd1, 0x9467a63e, 0x80e3864c }, 19 },
+	{ {0xbec70fbf, 0x9b1384b6, 0xa8adc452, 0x26689f02, 0xd996b6a7 }, 19 },
+	{ {0xbefa36ce, 0x537fefc0, 0x9a71de4b, 0xb7fc69ce, 0x0d6575fe }, 19 },
+	{ {0xbefebc91, 0x6bfdb5e8, 0x057040f0, 0xae82b551, 0x7a7750db }, 78 },
+	{ {0xbf0014ca, 0x7dd0815b, 0x2385a778, 0xc5328ae6, 0x3c692229 }, 3 },
+	{ {0xbf041bc8, 0xce3b5dab, 0x7b1f85f6, 0x23b371b2, 0x63639aab }, 19 },
+	{ {0xbf3d9433, 0xbf32d3af, 0x7a7adc0b, 0xa77b9690, 0xac754daa }, 19 },
+	{ {0xbf4a0bab, 0x1e8eaa70, 0xa8b12cd9, 0xa81d7a90, 0xa74c9e26 }, 19 },
+	{ {0xbf5678f3, 0xc065a450, 0x7f71ed62, 0x06a63ac9, 0x22ad93dd }, 19 },
+	{ {0xbf7e27b3, 0x456f1a96, 0xd94a8dbf, 0x06688c8f, 0x833bd818 }, 19 },
+	{ {0xBF96A360, 0x083C5C26, 0x43094054, 0x6827E91A, 0x69ADE63E }, 5 },
+	{ {0xbfa533c5, 0x39035345, 0xcee719b4, 0xbbc7b309, 0x89e97372 }, 19 },
+	{ {0xbfe8046f, 0x8ccc6d60, 0x16d7752c, 0x04f06544, 0x20ef81e7 }, 6 },
+	{ {0xc0476fab, 0x5ca3c69b, 0x381bb8c4, 0x3efea127, 0x7d7a1b43 }, 19 },
+	{ {0xc06de0ed, 0xa82e1daa, 0x3ea3cbc5, 0xeba5d884, 0xfd0ce8e8 }, 19 },
+	{ {0xc0717a98, 0x31d66e29, 0xeb907be5, 0x98ba6606, 0xe17ea044 }, 19 },
+	{ {0xc08a3c14, 0x78e51db6, 0x2624814a, 0xcbf36c19, 0x8d6561e6 }, 5 },
+	{ {0xc0d33b51, 0x3704adc5, 0x6718b1f5, 0x6c106271, 0x8683c77c }, 19 },
+	{ {0xc0fa7d53, 0xb3e66bd1, 0xe1680bb1, 0x35db8f74, 0xabbac52e }, 19 },
+	{ {0xc10d2a3d, 0xc77816cf, 0xb5b5d4b9, 0x83323284, 0xf4a4aef5 }, 19 },
+	{ {0xc1219e07, 0x35d31f1c, 0x41995795, 0xe58b04b9, 0x7bf1b71a }, 3 },
+	{ {0xc1376fac, 0xb3db0124, 0xf0557a95, 0x684d3059, 0xa3043fec }, 19 },
+	{ {0xc1746efe, 0xb4b44dcc, 0x80dfc4f4, 0x29009fea, 0xc91d9c48 }, 19 },
 	{ {0xc18adae0, 0xca1243e1, 0x3a15d381, 0xa431cc0d, 0xfc68223b }, 3 },
-	{ {0xea0824ea, 0x0692d2cd, 0xff816a2b, 0x3c3eb9a5, 0x87a5f536 }, 3 },
-	{ {0xe9e778c3, 0xd103cc8c, 0x32093cd6, 0x880fa8d7, 0x238bbd9e }, 3 },
-	{ {0x4b785147, 0x53008cab, 0xda2ff3d3, 0xcb537b24, 0x29efd7d2 }, 3 },
-	{ {0x21ac0ae7, 0xda47abf3, 0x0986b479, 0x489134c7, 0x9405f95d }, 3 },
-	{ {0x3a0b0bdd, 0x77a1f3a1, 0x1533f5ef, 0x030370bc, 0xc90c6334 }, 3 },
-	{ {0x1c17e58f, 0x1a602e07, 0xf185bce1, 0xaa8589fa, 0xe76e8b44 }, 5 },
-	{ {0xd53a8efe, 0xfe371426, 0x9538a91e, 0x5256c293, 0x8fe13239 }, 5 },
-	{ {0x1cbd5c78, 0x49f97dea, 0x1e3375a8, 0x42f784ff, 0x9283310c }, 145 },
-	{ {0xab087d04, 0xeb5c2c88, 0x94758c7c, 0xee32ccaf, 0xd80989a7 }, 5 },
-	{ {0x4c2a8cde, 0x9b40c493, 0x6f512365, 0xa7cd6c8c, 0xef92095e }, 4 },
-	{ {0xb1cf4532, 0x06beef8a, 0xb2ede2b0, 0x61ed95a3, 0xcd91eae3 }, 4 },
-	{ {0x04a13591, 0x0588ef87, 0x53b04a49, 0xc66d138c, 0x081284d2 }, 4 },
-	{ {0x721a2ded, 0x692d34d8, 0x64d0440a, 0xc347c608, 0x80942d19 }, 5 },
-	{ {0x1d97922a, 0x5ab63e73, 0x611d0edb, 0xe952f041, 0xaf3385b3 }, 5 },
-	{ {0x688b70e6, 0x0dc27265, 0x4ac6b0a7, 0x2237fefd, 0xce2ef9ff }, 5 },
-	{ {0x6075cd96, 0xbc85864f, 0x22c643b0, 0x23302f00, 0x6b565049 }, 4 },
-	{ {0x5c278deb, 0x1390eb45, 0xc79b7667, 0xb1ea1c54, 0x183123ac }, 5 },
-	{ {0xcb6bd269, 0x61387def, 0x757c7fae, 0xec7563d7, 0x7d404d01 }, 38 },
-	{ {0x89943ae9, 0x38fb308f, 0x4b5149eb, 0xc0cbea59, 0x7b9b0223 }, 38 },
-	{ {0xfbfdd89e, 0xc183ceae, 0x63d3d66b, 0x0ab45faa, 0x951b525a }, 38 },
+	{ {0xc1923ab5, 0xc5dcaf67, 0xaf3e23fd, 0x1ac42e2d, 0x4c61aca7 }, 5 },
+	{ {0xc19f6788, 0x2b2586c4, 0xba577ffc, 0x5d04197e, 0x757e19a5 }, 3 },
+	{ {0xc1bb307a, 0x570ab833, 0xe3bfcc4a, 0x58a4f4e1, 0x2dc1df0f }, 65 },
+	{ {0xc1c350c7, 0x19236af5, 0xeef8798c, 0x4532351b, 0xefcfd348 }, 39 },
+	{ {0xc1c5ec40, 0x42760880, 0x216f781e, 0xbd5e7174, 0xa3b0f9ca }, 19 },
+	{ {0xc1d27264, 0x5a249757, 0xb8be5bd9, 0x13ba2d34, 0x47892387 }, 19 },
+	{ {0xc1d83c55, 0x9e1e6a6d, 0xa961eafa, 0x55aab105, 0x681c634c }, 64 },
+	{ {0xc1dfc86c, 0x441e1128, 0x194f3ab4, 0x90c94e29, 0x275b5df9 }, 19 },
+	{ {0xc1fb0fa0, 0x1fadf82d, 0x86ed02da, 0xff46e7bd, 0x4ad7a59d }, 64 },
+	{ {0xc20def84, 0xefe71efd, 0xf91df310, 0x0919d151, 0xb2e7bdc1 }, 19 },
+	{ {0xc212b11f, 0xda13f83d, 0xafed688c, 0x54d098e7, 0xe47ab225 }, 27 },
+	{ {0xc221c5d9, 0x0c3c6eab, 0xf1a65107, 0x2cd9841a, 0xd1b25d7d }, 19 },
+	{ {0xc2296f08, 0xc9c5069e, 0xb5269832, 0x7ace1e22, 0x6cd3c1ff }, 65 },
+	{ {0xc2340313, 0xbfda7511, 0x81e8a528, 0x7d60f77b, 0xc6a2f3e6 }, 42 },
+	{ {0xc23c342f, 0xf5274356, 0xa2d17d18, 0x272253d1, 0x4fd8ffdf }, 19 },
+	{ {0xc279c3f4, 0x1d536876, 0x1f908815, 0x7b80214d, 0x835a548c }, 42 },
+	{ {0xc2a1ea76, 0xf3e3517f, 0x9952e495, 0x395b8fcc, 0x820c7420 }, 19 },
+	{ {0xc2f4df1b, 0xd91f7dee, 0x1536774b, 0x9d708908, 0x6b9bf835 }, 5 },
+	{ {0xc30d7363, 0xfcfb3827, 0x2ae927c6, 0x84df1c52, 0xc7de1a72 }, 19 },
+	{ {0xc344ed78, 0x465203e1, 0x2143bd98, 0x89281ba9, 0x81a195e4 }, 19 },
+	{ {0xc345357e, 0x71d1b8f2, 0xc9663bf2, 0x8abb5a3a, 0x2957d49f }, 19 },
+	{ {0xc34a1c22, 0x5d1a5fc4, 0x1a998e23, 0xd1209b59, 0xb3b759bb }, 17 },
+	{ {0xc3680636, 0xefd8d2f3, 0xa7c1c677, 0x4dd36399, 0xc754b71d }, 19 },
+	{ {0xc3ab3edb, 0x7f9ba311, 0x24092dc0, 0xf1dd2f13, 0xd3b52f8f }, 5 },
+	{ {0xc3c67787, 0xe2a69e2f, 0xdc739d8d, 0x1542726e, 0xc4ee7c47 }, 6 },
+	{ {0xc3efedda, 0x7ab947a0, 0x6d9345f7, 0xb8261076, 0xfa7ceeef }, 65 },
+	{ {0xc3f3ca45, 0x4d66a0bc, 0x791f1d4b, 0x60e6857b, 0x44eb8755 }, 65 },
+	{ {0xc3f849c3, 0x42839fef, 0x2ef718b5, 0x115a90a3, 0x1e7db1f6 }, 19 },
+	{ {0xc44cccb5, 0x3e2f0cc8, 0x560c2883, 0x54744f29, 0xd2488850 }, 19 },
+	{ {0xc45a710f, 0xccac84de, 0x0d3bffed, 0x8095344a, 0xc1838f1d }, 55 },
+	{ {0xc461efa9, 0x42e1a3a1, 0xe580f9d0, 0x4bf8d15c, 0x5e834f8b }, 4 },
+	{ {0xc46f85f2, 0x1f780f12, 0x6a0d6184, 0x8071fcdc, 0xf84f15b9 }, 39 },
+	{ {0xc484f44a, 0xf0ab1bca, 0xf46ae5f1, 0x4a3b38a5, 0x3ee77f31 }, 19 },
+	{ {0xc48f3950, 0x60d919a1, 0x3b3dfdb0, 0xd89cea9e, 0x32fc8f10 }, 19 },
+	{ {0xc4a919f3, 0x1d20008b, 0x5d6540aa, 0x5d2be59a, 0xa4cef5cf }, 5 },
+	{ {0xc4bd9f0d, 0x34061b40, 0x25f8d5c5, 0x866d51c7, 0x63612e92 }, 19 },
+	{ {0xc4c49d01, 0xeca572ce, 0x2e35d914, 0x53270f4d, 0x3e27152e }, 19 },
+	{ {0xc4f95225, 0x8020de9e, 0x23a718a7, 0x8c18d22e, 0x2cccfe3c }, 19 },
+	{ {0xc518232e, 0x8e59ab43, 0x3243ab2a, 0xf546afd2, 0x2cc7bf26 }, 63 },
+	{ {0xc53b3f2c, 0x00f31683, 0x914f7452, 0xf3f4d94a, 0xe2929c0d }, 1 },
+	{ {0xc551d8cb, 0xe7a2e1e3, 0x4d6662f5, 0x861336df, 0xfad05397 }, 56 },
+	{ {0xc5568fc0, 0x7bfb193b, 0x43ad7c84, 0x0787f274, 0xd9c1e42f }, 19 },
+	{ {0xc55b0daf, 0x698d93b8, 0x278a9d89, 0xf3827206, 0x4d1594bd }, 19 },
+	{ {0xc55dd15a, 0x27b69b61, 0xe839f850, 0x0f56badb, 0x4ee58ad4 }, 39 },
+	{ {0xc570eccb, 0x1bf0c993, 0xe375e094, 0xd803ef11, 0x2d0763ad }, 4 },
+	{ {0xc5af6c42, 0x55bab55d, 0x68e82fa0, 0x16cb35e3, 0x213ba244 }, 19 },
+	{ {0xc5b4cd4b, 0x49144e8f, 0x77455e9f, 0xf9077ff8, 0x40ab278c }, 4 },
+	{ {0xc5b4fdca, 0x8887a8ab, 0xa203b311, 0xc5519f8e, 0x4863d910 }, 19 },
+	{ {0xc5be2ecf, 0xd16094d3, 0x2e68f4e0, 0x14c58d73, 0x11437c5d }, 1 },
+	{ {0xc5cd97ee, 0xbe8ac90e, 0x57197f0d, 0xf847f24e, 0x14779e2f }, 19 },
+	{ {0xc5de32b8, 0x37d16a06, 0x6542e0ce, 0x36d5e85b, 0xd4931d49 }, 39 },
+	{ {0xc5e3845c, 0x74da6aea, 0x2cb68ccd, 0x765e4f60, 0x6f10b5b6 }, 6 },
+	{ {0xc5edd1c7, 0x4e72ddae, 0xba1027da, 0x1e848e2c, 0x4fda94f5 }, 5 },
+	{ {0xc5f1897c, 0x416f62cd, 0x58cd6257, 0x282e3428, 0x155cd698 }, 19 },
+	{ {0xc60a28a4, 0x048710ad, 0x3c63ef5b, 0xcf4ce03d, 0xb54c00bb }, 19 },
+	{ {0xc6227431, 0xbfbc3aa9, 0x21120ec3, 0xda7f6429, 0xa1a799a0 }, 19 },
+	{ {0xc62e058c, 0x2a54f3c9, 0xadba2e6a, 0x3006b8e7, 0x49c43bd7 }, 19 },
+	{ {0xc63db266, 0x60da96af, 0x56f8a7d3, 0xea18544b, 0x9ae5a37c }, 1 },
+	{ {0xc64f2fad, 0x6417c645, 0x95bc204d, 0x843527e1, 0x7a58776f }, 19 },
+	{ {0xc654b842, 0xcff7227d, 0x9e85fda2, 0x5279259e, 0x837cee9e }, 3 },
+	{ {0xc66483cd, 0x0d83292e, 0x4f2b54a3, 0xe89bd96b, 0x8bf9abb2 }, 3 },
+	{ {0xc69165e8, 0x4e8350a6, 0x726901f2, 0xab6e4688, 0xf38f03fc }, 4 },
+	{ {0xc69c5b26, 0xeb3fb5e1, 0x03a887c9, 0x6e702ea4, 0xacafb75a }, 19 },
+	{ {0xc6c64d80, 0x3d65ce43, 0x9d00034a, 0x86a570f8, 0xc77d18d5 }, 19 },
+	{ {0xc6d2aa3e, 0x7303e0e2, 0x244256bf, 0xcfc113ba, 0xfe2d6b59 }, 4 },
+	{ {0xc6e0b0bc, 0x71059583, 0xe7e9da22, 0xfe13be9e, 0x937ad7dc }, 19 },
+	{ {0xc6f09088, 0x2886dcf7, 0x83e5b65b, 0xff75c5e0, 0x34fbb2eb }, 42 },
+	{ {0xc713ecd0, 0xe2ef89b2, 0x443e516d, 0x5ffa53d3, 0xa3422e22 }, 19 },
+	{ {0xc72af511, 0x8835e49a, 0xc6d181cc, 0x832336ab, 0x22ec5dcb }, 39 },
+	{ {0xc7377eae, 0xb7f91639, 0x296c3df0, 0x95ba403d, 0xbf4f8e79 }, 3 },
+	{ {0xc73d4c27, 0xaa2b0fb9, 0x46e39832, 0x3bd67d9e, 0x53c4f9ef }, 39 },
+	{ {0xc74a5a61, 0x64536750, 0xd6b3ea90, 0xe19798ab, 0x6fad79d7 }, 5 },
+	{ {0xc74c0a9b, 0x973f4dbf, 0xc132b60f, 0xe4d66660, 0x0ae12552 }, 4 },
+	{ {0xc76ca96e, 0xd23621a6, 0x267d9906, 0xcc4a1ee4, 0x28677f98 }, 19 },
+	{ {0xc79626ed, 0xdf8bc390, 0xd64ada99, 0xad6da32d, 0xfd52d086 }, 19 },
+	{ {0xc7a2c5ba, 0xee6a9f0e, 0x1c6ee7d7, 0x6944c0ab, 0x1886796c }, 1 },
+	{ {0xc7af3306, 0xdbae898f, 0xcc077492, 0xcc457429, 0x8951df34 }, 19 },
+	{ {0xc7df1bc6, 0xe115a39c, 0x850d0d59, 0xcfba8c17, 0x407c476f }, 19 },
+	{ {0xc8015d44, 0x53efb9f7, 0x8005f6c8, 0x481cbce9, 0xd99f6cc5 }, 19 },
+	{ {0xc80228bd, 0x14f149db, 0xccf57bf9, 0xc00f34a4, 0xdf953d85 }, 19 },
+	{ {0xc81a30ec, 0xa8cc5226, 0x855ea752, 0xa9d83181, 0x247329ea }, 19 },
+	{ {0xc82c6e05, 0x4313f4c8, 0x864e6489, 0x7baea8b6, 0x3776020d }, 5 },
+	{ {0xc83ee585, 0xa2b5643f, 0xefa61d77, 0xcd4455d6, 0xaad7cb52 }, 19 },
+	{ {0xc843b8b0, 0xe5ed98d3, 0xbae68e70, 0x1fb709ea, 0x178ed968 }, 17 },
+	{ {0xc84487e4, 0x85b8739e, 0xc75e09a0, 0x31f84260, 0xfb0e319c }, 19 },
+	{ {0xc84ea9e7, 0xa02609c7, 0x1ff75893, 0xcbb948fc, 0x1f1cf21c }, 3 },
+	{ {0xc8ff858d, 0x239c62a8, 0x59f15c2f, 0x1bf44e1d, 0x657cec13 }, 19 },
+	{ {0xc9135b1e, 0x451193bd, 0x4c06d814, 0x3eaca934, 0xcc89fe05 }, 5 },
+	{ {0xc9440172, 0x802818cc, 0x5b9ae559, 0xfbd3f346, 0xa263605c }, 19 },
+	{ {0xc95f8edb, 0x24edca9f, 0x5d38c26d, 0x0e8a34c6, 0xb61efb0c }, 6 },
+	{ {0xc960c1b8, 0x95557ef1, 0xb3360350, 0x29d5c6d5, 0x53c64085 }, 3 },
+	{ {0xc964e2a3, 0xb63e1261, 0xc1daec4b, 0x4d8bb8e7, 0x4018e0be }, 19 },
+	{ {0xc9a89cce, 0xb355e5da, 0xf47ed5e8, 0xee3e211e, 0xbd2494d8 }, 42 },
 	{ {0xc9c272ff, 0xa69d3e0a, 0xf5be42e7, 0x636b02dc, 0x2af6ea8c }, 6 },
-	{ {0x82397096, 0xd5ef436b, 0x99b943c2, 0xa52d6eff, 0x87694183 }, 6 },
-	{ {0x8e66731c, 0x99f4d041, 0xddcd3308, 0x8d0ab0d4, 0xcae8bf75 }, 6 },
-	{ {0x0f10d77d, 0x1536993b, 0x8455b3b4, 0x7278ca57, 0x82ef9275 }, 5 },
-	{ {0x6933de9a, 0x128e90a3, 0x4383f3a9, 0xb2660d5b, 0xae5d9fe3 }, 5 },
-	{ {0xb1a97ef6, 0x5f2bc3e7, 0x9b628a51, 0xfde8dc98, 0xf37d9db6 }, 19 },
-	{ {0x5118d6f1, 0xc1023706, 0x91903d07, 0x350d5090, 0x633589cd }, 19 },
-	{ {0xd5902afb, 0xd8dfb1ea, 0x96fc8cf4, 0xd62cf6e4, 0xfa40d4f7 }, 5 },
-	{ {0x78507f3f, 0x8b8601d9, 0x9bbedb65, 0x17bec6cd, 0xdf0bd5b4 }, 5 },
-	{ {0x4607ed28, 0x4bd4602a, 0xffa00600, 0xc749ce43, 0xb2b89b6d }, 6 },
-	{ {0xb7104477, 0xc8801fe5, 0x4d1ba91f, 0x3a77ac6e, 0x4f399f52 }, 6 },
-	{ {0x788c5365, 0x7d9ea180, 0xd04f29cc, 0xaf1f1c29, 0xa9b75519 }, 6 },
-	{ {0xce4c5ce0, 0x7afd2971, 0x56899eb6, 0xc1056eef, 0x3f83b803 }, 6 },
+	{ {0xc9d10b1d, 0xf3bcadb3, 0xd917cf2a, 0x6877ae6e, 0x71ca3a57 }, 19 },
+	{ {0xca05a183, 0xf4e7e561, 0x02706d1b, 0x9b852ad4, 0x350264ba }, 39 },
+	{ {0xca0f156e, 0x66016c72, 0x681754d7, 0xd9a6da56, 0x85e48247 }, 19 },
+	{ {0xca45da2f, 0x9cd8edf4, 0xab04ffd5, 0x42b9c60e, 0xf6a9a254 }, 3 },
+	{ {0xca52d26e, 0x847b23c7, 0xcaeb7d51, 0x6b5fca5c, 0xbd686ef3 }, 19 },
+	{ {0xca5c5f38, 0x72057a6a, 0xa65fe493, 0x6791850d, 0xe302d501 }, 64 },
+	{ {0xca5f1492, 0x5a7d33d8, 0x3dc581bb, 0xe2ff5258, 0x389bfba7 }, 19 },
+	{ {0xca770384, 0x382bd487, 0xdd733055, 0x2403f85d, 0x7edbb8ce }, 39 },
+	{ {0xcab996c6, 0xabc011b8, 0xc2abf3f3, 0xa7628437, 0xdd40deff }, 19 },
+	{ {0xcad65376, 0x6b597a4a, 0xa130a9a1, 0x956ece77, 0xba4d52bc }, 19 },
+	{ {0xcaeca371, 0x13c56e69, 0x6d7053d9, 0x0f5f9f3e, 0x02de8ad1 }, 8 },
+	{ {0xcb06dea7, 0xb025745f, 0x9d2b87dc, 0xf03ded61, 0x5287ead3 }, 42 },
+	{ {0xcb0d3556, 0x27b8c036, 0x931a6766, 0x6e425d8f, 0x9225a180 }, 19 },
+	{ {0xcb325faf, 0xed4b6604, 0xa7146bca, 0x14109a29, 0x443b0c7f }, 19 },
+	{ {0xcb352e97, 0xe9416f4c, 0x30321187, 0x58fc77d6, 0xd0f3ad73 }, 19 },
+	{ {0xcb35e8c3, 0xa0a3e922, 0x81810d5b, 0x0eb886fb, 0xb1e461cc }, 19 },
+	{ {0xcb48969f, 0x27eaebf2, 0x4c61f651, 0x399ec243, 0x3d85bcbc }, 19 },
+	{ {0xcb544661, 0xb6da6a35, 0xc20bfe50, 0x3974f2b7, 0x9a3c4550 }, 5 },
+	{ {0xcb6bd269, 0x61387def, 0x757c7fae, 0xec7563d7, 0x7d404d01 }, 38 },
+	{ {0xcbe6c0db, 0x6201f8ac, 0x09310c78, 0x8adc6348, 0x73251164 }, 17 },
 	{ {0xcbec713b, 0x32517a50, 0x3ae6c024, 0x97357a83, 0x61eccb76 }, 17 },
-	{ {0xb20e02cb, 0xffef692c, 0x7aee6281, 0xeb36729e, 0xe1e928ef }, 5 },
-	{ {0xe243cb1c, 0xb7d7a8c4, 0x4d68f1a2, 0xe2be34a2, 0xe6ab220b }, 19 },
-	{ {0x8cfcf726, 0x62b67bb7, 0x7d4dce81, 0x949b4b68, 0x14a314f7 }, 19 },
-	{ {0xae6ad52d, 0x5ebcad77, 0x22ea0701, 0x09a286fe, 0x13b06cb7 }, 5 },
-	{ {0xd7f8c34e, 0x3ae9dea5, 0x1d0c8785, 0x7e0ff780, 0x28d402b7 }, 5 },
-	{ {0xf5269015, 0x7a51c662, 0xffdf4ae3, 0x592ada93, 0xd7be4032 }, 5 },
-	{ {0x81143d2a, 0x8ef7cc59, 0x3a604f3c, 0xc890312b, 0x42bdff01 }, 9 },
-	{ {0x8AFE57C2, 0x87ADC0F9, 0x3F234E8E, 0x8C136AE3, 0xC00947C1 }, 9 },
-	{ {0x418f6248, 0x221c7903, 0x9fe6c44f, 0xc5a95148, 0x42e3ec71 }, 5 },
-	{ {0x07c4c39c, 0x6e6c0324, 0x1d235330, 0x0f630b36, 0x7322e78a }, 5 },
-	{ {0x91afe2ee, 0x3a5b8e80, 0xd67f6c7a, 0x30bafbc2, 0xd63b2421 }, 4 },
-	{ {0x29a42c2b, 0x679bac55, 0xa0318ce8, 0xc97708e4, 0x02e2779b }, 5 },
-	{ {0x0c625910, 0x33aa4e5e, 0x6b9eeb21, 0xeb2e5e60, 0xdcd8ee8e }, 3 },
-	{ {0x2312bff7, 0x0c83e60d, 0x1ca0fb9c, 0xa78a5063, 0x7d02771c }, 3 },
-	{ {0x1ccac7ca, 0xeaaa1c5a, 0x89503221, 0xb0a5eec2, 0xf34b1c91 }, 3 },
-	{ {0xc82c6e05, 0x4313f4c8, 0x864e6489, 0x7baea8b6, 0x3776020d }, 5 },
-	{ {0xf7872715, 0x97abbcb1, 0x297e4e8a, 0x4a956195, 0x9a195649 }, 5 },
-	{ {0xc08a3c14, 0x78e51db6, 0x2624814a, 0xcbf36c19, 0x8d6561e6 }, 5 },
-	{ {0xb81dd702, 0xafaaa594, 0x6e4ec065, 0x042c891a, 0xd2f76c2b }, 17 },
-	{ {0x02c3ec94, 0x190c6fce, 0x6fa4984d, 0x92be48b2, 0x697e7706 }, 5 },
-	{ {0x4bd533cd, 0x7859489a, 0x3b26787f, 0xb5c7e4d8, 0x662cc420 }, 5 },
-	{ {0xb5749b4c, 0xac530e26, 0x1da9acc0, 0xd494a817, 0x66d2acc3 }, 17 },
-	{ {0xafb693fd, 0x0a138cfc, 0x59a2bf81, 0xeabd7ca2, 0xabd4e162 }, 5 },
-	{ {0x81bbbd4e, 0xa86350eb, 0xba03e8d8, 0xcb29f050, 0xa3d93a83 }, 5 },
+	{ {0xcc06d65a, 0x9aba634e, 0x3ad75675, 0xb9601409, 0x32506ffe }, 19 },
+	{ {0xcc141385, 0xd69ccf35, 0x8d7055e7, 0x6ffe1a8c, 0x2cf52802 }, 63 },
+	{ {0xcc15f65d, 0x607a573e, 0x0bcd23ab, 0xe9d0d825, 0xe05deb10 }, 56 },
+	{ {0xcc1744c6, 0xc513d640, 0x9a142b4f, 0xb42fbe70, 0xa95d9b7f }, 1 },
+	{ {0xcc46a737, 0xacd729b2, 0x839ecd23, 0x7d38b4a6, 0x3cfb16cb }, 3 },
+	{ {0xcc93d295, 0xa7a5d6b6, 0x69328cd4, 0x9b1825c7, 0x7fe39705 }, 19 },
+	{ {0xcc9a8289, 0x8da39e5c, 0xfeb04000, 0x06d093d3, 0xb869f28c }, 19 },
+	{ {0xccf6e244, 0xd27ec611, 0x95280d09, 0x15a3b43d, 0x291e3fad }, 19 },
+	{ {0xccf79dc8, 0x9000d2c2, 0xed45112a, 0x76a7cfce, 0x86fb1aff }, 19 },
+	{ {0xcd2159b9, 0xc60f3ca7, 0xbf9f4b3f, 0x3163203b, 0x9ce2851f }, 19 },
+	{ {0xcd2557fe, 0x39ba4dce, 0xd3219152, 0xc6a6d02c, 0x2219b360 }, 19 },
+	{ {0xcd452442, 0x33836641, 0x1f6b2473, 0x9fe59e20, 0xf3ac24dc }, 19 },
+	{ {0xcd466c04, 0x209a8815, 0xa95d3723, 0x653e263a, 0x868de9e0 }, 19 },
+	{ {0xcd69ce70, 0x747bc0de, 0xebba9fd3, 0x07a07f5d, 0xfb926cc3 }, 19 },
+	{ {0xcd8ee800, 0x822ff0cd, 0x295621fa, 0xafafc73b, 0xe4bacad0 }, 5 },
+	{ {0xcda2df54, 0x006d9889, 0x0feb1aac, 0x1dd955d0, 0x458132a4 }, 19 },
+	{ {0xcdaf507d, 0xba4a48b5, 0xc98850a9, 0x6f61f6d2, 0xe8464e00 }, 19 },
+	{ {0xcdeadd6c, 0xf7bf5b53, 0xaa7d9014, 0x46b0ce58, 0x6542c580 }, 5 },
+	{ {0xcdeb0ed8, 0xadecaaad, 0xb78d5a53, 0x64fd6032, 0x38591685 }, 42 },
+	{ {0xce01afe3, 0x0da38dc5, 0x8994c826, 0x4070195e, 0x1cd921b8 }, 19 },
+	{ {0xce137694, 0x1359471c, 0xae41887f, 0xe11f10d3, 0xb696a926 }, 19 },
+	{ {0xce3f9356, 0xeaa5fd6c, 0x1b5ff1ad, 0xe244ebd9, 0x130f1ceb }, 5 },
+	{ {0xce493944, 0xb6b57ffa, 0x56e7eb09, 0xdf76e73b, 0x65dcb800 }, 19 },
+	{ {0xce4c5ce0, 0x7afd2971, 0x56899eb6, 0xc1056eef, 0x3f83b803 }, 6 },
+	{ {0xceb7807a, 0x78bcc462, 0x85afbf6e, 0x607d2f9a, 0x5bdffbcc }, 19 },
+	{ {0xcec8ffb8, 0x8b3c047f, 0x5dbd95d3, 0xed1cd966, 0x0803fa7b }, 19 },
+	{ {0xcee2b352, 0x0404f1eb, 0x6eea6bc1, 0x4ae99713, 0x85920514 }, 19 },
+	{ {0xcef16eb9, 0x5502ba6a, 0xb2265fca, 0xfcedde47, 0x0a101541 }, 1 },
+	{ {0xcef76580, 0xa01cc8e1, 0x6704590d, 0x0d884d7e, 0xeadaa3a8 }, 19 },
+	{ {0xcf00ec60, 0x608010aa, 0xc94cfe24, 0x5eb7aa67, 0xcb44d110 }, 1 },
+	{ {0xcf088b4e, 0xefe7f426, 0xe438dd2f, 0xe7a34331, 0x40abba52 }, 5 },
+	{ {0xcf344e0f, 0x58fd918c, 0x089c4d45, 0x75caec88, 0x43944ff6 }, 6 },
+	{ {0xcf4c1a4d, 0xf0a55c4a, 0x0cf33436, 0xe649f32e, 0x5857b5cc }, 19 },
+	{ {0xcf55b0d1, 0x2e550f71, 0xcef70935, 0x8bc7e799, 0xeced0083 }, 19 },
+	{ {0xcf6a4318, 0x1a15cfde, 0x3091d182, 0xceaddf3d, 0x9bddd57b }, 19 },
+	{ {0xcf6fe49b, 0x28fcf815, 0x11f39fdf, 0x68f37af8, 0x2bd724c0 }, 17 },
+	{ {0xcf726044, 0x3f814c57, 0x619a862f, 0x82162fe3, 0xe12369e1 }, 19 },
+	{ {0xcf8e4031, 0x5f34e30e, 0x1be4776b, 0xbebc08c0, 0xa8403523 }, 19 },
+	{ {0xcf93e1f7, 0x90c4bdf5, 0x0b41ec05, 0x37dfb97e, 0xd0d11b21 }, 19 },
+	{ {0xcfa30c1d, 0x6741e1b5, 0x6b54622b, 0xbc3d8900, 0x3f739a17 }, 19 },
+	{ {0xcfd872d0, 0x05b7bd4c, 0xdd6e06c4, 0xc0162191, 0xf0b0415d }, 3 },
+	{ {0xd0018f19, 0x2ca6a1b7, 0x8fed9ace, 0xf58db389, 0x848add3e }, 55 },
+	{ {0xd03fdca5, 0x7b55bdb7, 0xe6b54816, 0x15b8ad0c, 0x8a71f77d }, 19 },
+	{ {0xd0706fd1, 0x0e418eba, 0x2929d515, 0xcc0994f4, 0x9376a63f }, 4 },
+	{ {0xd076d718, 0x5078b8ad, 0xddbacfee, 0x7e46c61e, 0x3e02fe7e }, 17 },
+	{ {0xd07af802, 0x2481bed2, 0x523e0e9e, 0xec67bf8c, 0xe64f9142 }, 19 },
+	{ {0xd086280d, 0xea7fb10f, 0xabaae26e, 0xd9d404bb, 0xe69c70c4 }, 19 },
+	{ {0xd08b5ec2, 0xa98bd40e, 0x8b97f4c5, 0x152db54a, 0x455ae493 }, 1 },
+	{ {0xd08d4e2a, 0x8d92c015, 0x51ff012a, 0x71a1f3e5, 0x7fe2d09c }, 62 },
+	{ {0xd09d75c7, 0xf242a696, 0x93140745, 0x8e717c9b, 0xdaadb7d9 }, 6 },
+	{ {0xd0bbf730, 0x72580638, 0x4756f530, 0x6ceccd91, 0xdc01d975 }, 17 },
+	{ {0xd0cd4840, 0x4eec5975, 0xd0f284c4, 0x6b3cd710, 0x236b87a5 }, 19 },
+	{ {0xd0cfc35f, 0x22b150a1, 0xcb10deca, 0xe4841dfe, 0x63b78251 }, 1 },
+	{ {0xd0dfc192, 0x7461d947, 0x3d0ed471, 0x375dcedd, 0xdba42279 }, 4 },
+	{ {0xd0e8bc3f, 0x5fd93dcd, 0x07cbb945, 0xb00018a4, 0x91842242 }, 42 },
+	{ {0xd0ed63a8, 0xbd030231, 0x3fbdb760, 0x9d35f47a, 0xd096be3e }, 19 },
+	{ {0xd1001f93, 0xc87ff7fb, 0x389e418e, 0x33bf7bc8, 0x1bdbb65f }, 65 },
+	{ {0xd120ca30, 0x3c3e1dd5, 0x6adee68f, 0x10e9e1ab, 0x51f50ab3 }, 19 },
+	{ {0xd131d718, 0xf57aef3a, 0x5469c678, 0x5e342a63, 0x128bf6d1 }, 55 },
+	{ {0xd147f2ca, 0xc0600527, 0xce49bfff, 0xc865c54e, 0xb783e5e5 }, 6 },
 	{ {0xd17acc97, 0xbf2f853a, 0x5fff58da, 0x733e4cd5, 0x3cdaa3ed }, 6 },
-	{ {0x59f679c5, 0xebf75de9, 0x8b5e909d, 0xa9182dbd, 0x80413364 }, 5 },
-	{ {0xa80b5426, 0xfd0f4ab1, 0x9eba1c06, 0x620f5efb, 0x8fbade3a }, 4 },
-	{ {0x2f6e0a02, 0xfcc3d368, 0xdb142ac8, 0x37304c18, 0xc5226e2f }, 55 },
-	{ {0x4524768e, 0x575298ce, 0xe3b7eee0, 0x9b3caab7, 0x84ca3bb7 }, 56 },
-	{ {0xe9b5b79f, 0x434b1c5b, 0xdb47f3ff, 0xece3ad42, 0xe489e20b }, 56 },
-	{ {0x3f20b961, 0x49f58b86, 0xd1f0e794, 0x83d5ddf4, 0x02191ec9 }, 55 },
-	{ {0x0a0203d6, 0x9b68e1c6, 0x36fdb789, 0x34ae7fb5, 0xb4d88179 }, 56 },
-	{ {0x04a56495, 0x8ea71653, 0xf87a8aa5, 0x1b84aa56, 0x7c73a8bd }, 56 },
-	{ {0xa57f8ec4, 0xf89ab849, 0x36f46821, 0x969de6bc, 0xa9f46d8e }, 5 },
+	{ {0xd198fda8, 0x238f8060, 0x7818c41c, 0x86455e1a, 0xe29f9a3b }, 19 },
+	{ {0xd1a7cbaf, 0xf354b590, 0x03f0e297, 0x723b912c, 0xb6ad0b36 }, 19 },
+	{ {0xd1ad3beb, 0x29aecaa7, 0xc3bc1fd8, 0xa4be3b10, 0xd38cc47a }, 19 },
+	{ {0xd1b20d78, 0x340d85fe, 0x7786d5f6, 0xc7156fa7, 0x01aaeca1 }, 143 },
+	{ {0xd1cc2a77, 0xfb17608d, 0x542c50e2, 0xa1404cf5, 0xb4231521 }, 9 },
+	{ {0xd1cf5410, 0xed71f776, 0x70f65eb0, 0x8ee94443, 0x6bc0eb10 }, 19 },
+	{ {0xd1e3afec, 0xde165609, 0x9dadff99, 0xc6ed2aa8, 0xfa6dd834 }, 19 },
+	{ {0xd1ece8b5, 0xffeb9b99, 0x230e640a, 0xf32cb488, 0xfee51e35 }, 19 },
+	{ {0xd1fbdbdf, 0x2e830139, 0x584d7dc7, 0x96806aa3, 0x327720dd }, 6 },
+	{ {0xd1fcd47f, 0x6b68fcee, 0x9914b32f, 0xd48b2634, 0xcf60c994 }, 19 },
+	{ {0xd22817c5, 0x19f5316f, 0x61c96358, 0x0a620b04, 0x93a6232d }, 19 },
+	{ {0xd2604a1f, 0x76cadd36, 0xede570e2, 0x3ad49b08, 0x85187e25 }, 19 },
+	{ {0xd264152d, 0x4974b789, 0x59465acf, 0xe0d5678e, 0x72930073 }, 19 },
+	{ {0xd28201ca, 0x9b7d062d, 0x37c62bc4, 0xd6212f2a, 0x0d3e1cb4 }, 19 },
+	{ {0xd29414f6, 0x1bc1c4f8, 0xc1fe4a24, 0x3a8a8afc, 0x2d4f6925 }, 19 },
+	{ {0xd2aa1605, 0xa6b56c11, 0x8e18b385, 0xab879536, 0xd74cc355 }, 19 },
+	{ {0xd2bf2769, 0x5023a3e7, 0xdaaeab1c, 0xb76572f2, 0xc412de1e }, 19 },
+	{ {0xd2c5497a, 0x52f5b8ab, 0xabfc24ff, 0xf1573622, 0xf86a69c6 }, 19 },
+	{ {0xd2ccc4a8, 0xde5da217, 0x45209d07, 0x31671e8f, 0x3cbea515 }, 6 },
+	{ {0xd2ce76cd, 0xdb6cc12d, 0xc68e9683, 0xb072fb57, 0x947ec172 }, 42 },
+	{ {0xd30c1710, 0x9fa1c4a8, 0x1e39dca5, 0x7b79464b, 0x0aa0b7c2 }, 3 },
+	{ {0xd31eb4ff, 0x4d6e4b3a, 0xf645f243, 0x88c734a1, 0xd00a0c47 }, 39 },
+	{ {0xd32279e0, 0x1fb57627, 0x78d696ac, 0xc2053b95, 0x03d5a715 }, 19 },
+	{ {0xd33508c8, 0x9656b180, 0x63893cad, 0xb74573e0, 0xb656792d }, 5 },
+	{ {0xd33fe18e, 0xde20da4d, 0xd3d6991a, 0x9c2995e1, 0x49c8fc3f }, 19 },
+	{ {0xd358e08c, 0x3df089fb, 0x97acf94b, 0x27519b2d, 0x2d2ab44a }, 19 },
+	{ {0xd37ab4bd, 0x2bfddd8c, 0x97476cbe, 0x7347ae58, 0x1a6f2972 }, 142 },
+	{ {0xd394e2f7, 0x1cdb955d, 0x03cbf817, 0x3950e82f, 0xc69646bd }, 55 },
+	{ {0xd3a71b31, 0x810614c6, 0x762a9bca, 0xafda00a6, 0xdef043b8 }, 143 },
 	{ {0xd3a936e5, 0xef24fdbc, 0x7a02a816, 0x44ab6cd4, 0xb88119d3 }, 4 },
-	{ {0x522a5303, 0x4cf40448, 0xd441683f, 0x3308fcb4, 0xb65e6d7c }, 38 },
-	{ {0xdab5a9f9, 0x3a35fcb9, 0x2c01e425, 0x0b01928f, 0xe8bd294b }, 38 },
-	{ {0x25ffc7e8, 0xca902745, 0x66c31e10, 0xb5998cca, 0x6522673a }, 38 },
-	{ {0xc1923ab5, 0xc5dcaf67, 0xaf3e23fd, 0x1ac42e2d, 0x4c61aca7 }, 5 },
-	{ {0x24384e63, 0xbfe450bc, 0xe6abd327, 0xeae3e279, 0x69025379 }, 5 },
-	{ {0x3f9d72bd, 0xafecfa64, 0x0639cf66, 0x721e7380, 0xe41c6e6d }, 4 },
-	{ {0xc5b4cd4b, 0x49144e8f, 0x77455e9f, 0xf9077ff8, 0x40ab278c }, 4 },
-	{ {0x3535be7d, 0x6d2a5d3c, 0x8048bca7, 0x52e6adcd, 0x52a994d6 }, 19 },
-	{ {0xc74a5a61, 0x64536750, 0xd6b3ea90, 0xe19798ab, 0x6fad79d7 }, 5 },
-	{ {0x510f6d85, 0x4f813269, 0xf67ee15a, 0x4cc2ed77, 0xd96d2903 }, 5 },
-	{ {0xa5f3ada0, 0x610ad32f, 0x59d2f114, 0x167612d4, 0xf62bec4e }, 17 },
-	{ {0xd076d718, 0x5078b8ad, 0xddbacfee, 0x7e46c61e, 0x3e02fe7e }, 17 },
-	{ {0x77d95640, 0xc80bc486, 0x8d04a913, 0xf9dbf4b5, 0xf6d877d2 }, 6 },
-	{ {0xdbcfa558, 0x70a26711, 0x2c9a71bc, 0xf85b481b, 0x11d98e04 }, 4 },
-	{ {0xee095ee6, 0x361f0a76, 0x7250fe19, 0xc9bc805b, 0xba8da4e9 }, 4 },
-	{ {0x39d500fb, 0xf22168be, 0x2a12ac89, 0xff5a5013, 0x1bb1c30b }, 8 },
-	{ {0x3194153a, 0x9c93aa24, 0xb37804a7, 0x64f112bd, 0xef091bf8 }, 8 },
-	{ {0xeca36fe8, 0x0a916eb6, 0xb196ec56, 0xedfc1296, 0xd793e350 }, 4 },
+	{ {0xd3af963e, 0x2529662e, 0xae63f04a, 0x25304546, 0x85a1989f }, 1 },
+	{ {0xd3bc33d5, 0x6b93e19f, 0xd32cc473, 0xde3e5b99, 0x35b3ba28 }, 19 },
+	{ {0xd3d411c8, 0xb7891aef, 0x9c59cbc2, 0x0bb4fa3f, 0xf0ca03ea }, 4 },
+	{ {0xd41676fd, 0xe0a30477, 0x92f93c4a, 0x41509b87, 0x49e55e74 }, 39 },
+	{ {0xd441ccfe, 0xde2c089f, 0xbef54e20, 0xb90c0d4b, 0x513c5196 }, 3 },
+	{ {0xd4480639, 0xd6468e19, 0x19c43f4c, 0xd0a08e9a, 0xc60073dc }, 19 },
+	{ {0xd44e9a41, 0x9f5bba1b, 0xccecc907, 0x71f066fd, 0x6a8093db }, 39 },
 	{ {0xd452a79b, 0x25f18e6a, 0x6eadc5c5, 0x92d5101f, 0x115ef0f0 }, 4 },
-	{ {0xebed1926, 0x9b7625c9, 0x3eccefc2, 0xbd758555, 0xe2027431 }, 17 },
-	{ {0xe388e8d8, 0x546e329d, 0x2c58269d, 0x4fa02662, 0x4a640f1b }, 5 },
-	{ {0xf6199f48, 0xff994fc9, 0xa8e33a85, 0x81bb3bb1, 0x6dd301ab }, 3 },
-	{ {0x9447e50d, 0x1266b7cb, 0x96a414ea, 0xf9ee16c0, 0xf99e55f3 }, 3 },
-	{ {0xad1081f3, 0x98ac69c0, 0xc92e4afa, 0xdde48257, 0x4fe875bb }, 3 },
-	{ {0x17583adb, 0x63d16d64, 0xae518200, 0x55cd32c0, 0xe935425a }, 3 },
-	{ {0x2fc050db, 0xc44ba9df, 0xb7229912, 0x9d48e5e5, 0xe1c892c3 }, 5 },
-	{ {0x2bfa08db, 0x95502ee9, 0xbde61c5f, 0xe7b6557c, 0x0e4aef5a }, 5 },
-	{ {0xdc56cff1, 0x211bacd9, 0x4f59e188, 0xe44a58d6, 0xf40a0c26 }, 6 },
-	{ {0xde251a0a, 0xf1df3be1, 0x8469578d, 0xc00d414e, 0x572ee33e }, 38 },
-	{ {0xd1cc2a77, 0xfb17608d, 0x542c50e2, 0xa1404cf5, 0xb4231521 }, 9 },
-	{ {0x8666f310, 0x9ad01093, 0xb0afab11, 0x986cfd60, 0xba37d2a0 }, 6 },
-	{ {0xfbb22cea, 0x9227f6f4, 0x0080a42a, 0x1a169c07, 0x47129c95 }, 6 },
-	{ {0xe171d0ce, 0xc1d32aaf, 0x084e3c81, 0x50705c17, 0x7522cbe6 }, 17 },
-	{ {0x4164dcdf, 0xe0613d0f, 0x4c53b6f3, 0x581548bb, 0xbad5eb43 }, 41 },
-	{ {0xef6c6cde, 0x14eb551b, 0x74640ed6, 0xb3866057, 0x2f121b86 }, 41 },
-	{ {0xb9d46267, 0xd081882d, 0xfd89342d, 0x3e09b82d, 0x7e8f618d }, 41 },
-	{ {0x2a3c7ad7, 0x0e34989f, 0xa5170028, 0xbad760e6, 0x5ebe9d57 }, 6 },
-	{ {0x3202af11, 0x3265e67e, 0x130a0b94, 0x8dc167a9, 0xf9e9cc79 }, 5 },
-	{ {0x1ab38b01, 0x4480745e, 0xaae143c9, 0xe6f67b54, 0x2e62442f }, 4 },
-	{ {0x795d47c6, 0xaae378d0, 0xd5bedc9f, 0x104a597b, 0xcc1ee16b }, 5 },
-	{ {0x414fd2a2, 0x2076f455, 0x02c2329b, 0x45bda9f8, 0x730dcaae }, 8 },
-	{ {0xb2ce0bc8, 0x6f82f727, 0xdb956dfb, 0xbe2a3fd0, 0xcb72f5fc }, 38 },
-	{ {0x00c70cf3, 0x7c71cb8f, 0x99567ae4, 0x07ff6dd5, 0x2c4774c2 }, 5 },
-	{ {0xc3ab3edb, 0x7f9ba311, 0x24092dc0, 0xf1dd2f13, 0xd3b52f8f }, 5 },
-	{ {0xaba839d5, 0x54733850, 0x902f3073, 0xf7974e2e, 0x87c488ba }, 5 },
-	{ {0x19e79a79, 0xbe13ac62, 0xbb002ed3, 0x323502be, 0x97886e17 }, 4 },
-	{ {0xdb22cd03, 0xdb61a495, 0xd55c460c, 0xfaa26627, 0x1c8a5926 }, 4 },
-	{ {0x17dcbe8e, 0x9ab79248, 0x3a542b02, 0x30897baf, 0x0240dcc9 }, 4 },
-	{ {0xaf310ee2, 0x1b5534f3, 0x2ea92c0a, 0xe34a44d8, 0x28d157a7 }, 5 },
-	{ {0xee267ee2, 0x1f575313, 0x0af66543, 0x5d4e1ce8, 0x4a6256f1 }, 55 },
-	{ {0x8ac11431, 0xe32e2391, 0x9a2ea37d, 0x5b2ef472, 0xd634921a }, 56 },
-	{ {0xa031ff5a, 0xeafb7d47, 0x0e810bd6, 0xcd08c923, 0x94f66295 }, 56 },
-	{ {0xe3036a7b, 0xc6ed3ece, 0x1c85d5e3, 0x7fb2ff39, 0xba98ba47 }, 5 },
-	{ {0x2300aa82, 0xbfcbcf95, 0x329eb04e, 0x58bcd7e4, 0xca0a7889 }, 17 },
-	{ {0x7fe5f17a, 0xd7e6b70d, 0xd56cad2c, 0x8bdc516a, 0x86f03207 }, 5 },
-	{ {0x632cb083, 0x4441626d, 0x20cc113c, 0xfad2e3a7, 0xec0e0dc7 }, 4 },
-	{ {0xd7fb2ca6, 0x004c5fdf, 0x77c42a5e, 0xab102b95, 0xa9a862d7 }, 4 },
-	{ {0x4ff2aad8, 0x371e382e, 0x203c7f29, 0xb665612a, 0x8c9d937c }, 4 },
-	{ {0x7c7d0bff, 0x4a51bb0f, 0x1f0cdb41, 0x32fdb11f, 0x8a71c623 }, 4 },
-	{ {0x216b2c18, 0x1c9ee0fb, 0x48e2d9ef, 0xdb88ea91, 0x8c8ff04f }, 4 },
-	{ {0x33846002, 0x9d65ebce, 0x0d9119d8, 0x11187a35, 0xc866a958 }, 5 },
-	{ {0x108e9164, 0xef6cf1ff, 0xe6e3c530, 0x3bfbbc3b, 0xd807b6df }, 5 },
-	{ {0x18be429f, 0x8b5c7bc4, 0x775c9929, 0x2110aa09, 0x341cd644 }, 8 },
-	{ {0x92bada2d, 0x019fcd6e, 0xee6d332a, 0x8068a9dd, 0xfa30d518 }, 5 },
-	{ {0xc7377eae, 0xb7f91639, 0x296c3df0, 0x95ba403d, 0xbf4f8e79 }, 3 },
-	{ {0x2f2c7559, 0xa5ba7fb9, 0x38aba152, 0xbd84879c, 0x0bd3cae2 }, 6 },
-	{ {0x7ed13081, 0x79c41ae6, 0x2cfb4612, 0x4ab0ce22, 0xd8b0513b }, 6 },
-	{ {0x6a95b7f3, 0xa4cff9c9, 0xb3d7b8b3, 0x0b0b0f75, 0x2dadaa37 }, 6 },
-	{ {0x34635bf3, 0x518c7b33, 0x164f3d96, 0xda769c7a, 0x01102d28 }, 8 },
-	{ {0xebe20c85, 0xc5314957, 0xfafc223c, 0x26bf3938, 0x47e3bb03 }, 6 },
-	{ {0xf2361230, 0x358bd945, 0x690ca1c2, 0xa9dcc1cb, 0xce83941b }, 6 },
-	{ {0xab3f375b, 0x6890b2a9, 0xbb1b6124, 0xf0fa6909, 0x50c749f2 }, 6 },
-	{ {0xf84d7fc0, 0x89b31440, 0xcac1f4fb, 0xee3d45b2, 0xf6c90e37 }, 6 },
-	{ {0x28b54294, 0x007ec345, 0xaef7322a, 0x2fcaa18d, 0x3363a73e }, 6 },
-	{ {0x3e57fad1, 0x30be7922, 0x3068ab29, 0xf1e77ecb, 0x7f2ad237 }, 5 },
-	{ {0xefed4885, 0x4beb2803, 0xd9f2b564, 0x4edff2aa, 0xcf7c6af9 }, 5 },
-	{ {0x9347890b, 0x025cc8c5, 0x21a4abbf, 0xf309ffc0, 0x466f22b3 }, 5 },
-	{ {0x6fe7a6bb, 0x86897e57, 0x9393e709, 0x61a3a320, 0x4adfa48b }, 4 },
-	{ {0xc570eccb, 0x1bf0c993, 0xe375e094, 0xd803ef11, 0x2d0763ad }, 4 },
-	{ {0x27248716, 0x29b46e05, 0xa0c8b555, 0x4a962211, 0xe700de0e }, 4 },
-	{ {0x9200fd6f, 0x1e92f78e, 0x3d9c6d08, 0x2837f719, 0xad0500d4 }, 6 },
-	{ {0x23e70208, 0x4e303115, 0x8a50a056, 0x0746767b, 0xbc1b7bee }, 6 },
-	{ {0x289ac363, 0x81905685, 0xdda39946, 0x127ab2af, 0x3317a010 }, 6 },
-	{ {0x36eda820, 0xb734ac7a, 0x42653af3, 0x70a475f3, 0x6bd36b1b }, 6 },
+	{ {0xd4686042, 0x69ae7664, 0xac739ea9, 0xf922a05e, 0x14ffa3d1 }, 42 },
+	{ {0xd4a188a7, 0xee514c18, 0xdc65f3c6, 0xdea7668b, 0x6cedc374 }, 19 },
+	{ {0xd4cea8c8, 0x15f3eeab, 0xe0c6a1c8, 0x45f902ec, 0x4318bf6b }, 39 },
+	{ {0xd4da7236, 0xbd09d735, 0xdcb92127, 0xc73e43b3, 0xca94dd7f }, 5 },
+	{ {0xd4edb2af, 0x4170fd40, 0x69960ad6, 0x1d3f6644, 0x62bef568 }, 19 },
 	{ {0xd526249c, 0x1a35cf11, 0x74300df7, 0x5bc28662, 0xf579290a }, 6 },
-	{ {0xa322d4e5, 0x72467be5, 0xe1b45221, 0x4143f88d, 0xb526b49f }, 5 },
-	{ {0x67fa6e90, 0x05d23d9c, 0x49f77884, 0xa856cfb3, 0x76194083 }, 4 },
-	{ {0x4cc5f197, 0xd2bd3f03, 0x06c07a88, 0x0590b4b4, 0xa5574e12 }, 5 },
-	{ {0x06c527db, 0x4fbe929b, 0x4da005e7, 0x463078c0, 0x5944f477 }, 5 },
-	{ {0x094d11eb, 0xf8a20b6b, 0xfc07902c, 0x7f136bdd, 0x18b1e7ca }, 5 },
-	{ {0xf9122717, 0xf50a7a5a, 0x195d7ade, 0x2dd9bd3e, 0xa353cc1c }, 19 },
-	{ {0x0f1c600f, 0xc3c3f7ef, 0x390214ee, 0x8028ce11, 0x8d2cf5b8 }, 19 },
-	{ {0xa034d59a, 0x9f66f996, 0xaf90e372, 0x45de5a47, 0x5b6db0bd }, 19 },
-	{ {0x5e094fca, 0x95ab8e91, 0x873ee372, 0xa3f1239b, 0x9a48a48d }, 1 },
-	{ {0x35195ab6, 0x7c289a0b, 0x47088346, 0x4df66bc6, 0xea5b00d3 }, 1 },
-	{ {0xebb76f90, 0x61e87536, 0x50235236, 0x07db610f, 0x2eda1d26 }, 1 },
-	{ {0x358e69f4, 0x27390041, 0xb5aa2801, 0x8550a88f, 0x996bddb6 }, 64 },
-	{ {0x2c9600c6, 0xe0025fee, 0x10d249e9, 0x7448ecaa, 0x37e38c42 }, 42 },
-	{ {0xf8cd4c05, 0x083decfc, 0x098cff07, 0x7e055a4a, 0xe1e91a73 }, 42 },
-	{ {0x11140aff, 0x5c92f580, 0x3f8fdbbb, 0x274c7518, 0xaf67b570 }, 98 },
-	{ {0x8963fc04, 0x1975f31d, 0xc2ab1019, 0xcfdd4967, 0x999de53e }, 1 },
-	{ {0x0274dd9b, 0x5096065a, 0x7f4ed019, 0x101124c9, 0xbd1d56b8 }, 65 },
-	{ {0xbefebc91, 0x6bfdb5e8, 0x057040f0, 0xae82b551, 0x7a7750db }, 78 },
-	{ {0x6f9aa263, 0xe74bedf6, 0x133b2912, 0xd55e9750, 0xe52334a6 }, 78 },
-	{ {0x5029cf47, 0x031b22bd, 0x5d1f68eb, 0xfd3be6d6, 0xda56dfe9 }, 1 },
-	{ {0xcc1744c6, 0xc513d640, 0x9a142b4f, 0xb42fbe70, 0xa95d9b7f }, 1 },
-	{ {0xa3028515, 0xed829e90, 0x0cc8deb4, 0x03e17b09, 0xa38bf9b0 }, 63 },
-	{ {0xaffa3c5c, 0xd8db79a1, 0x450ad8a7, 0xf405a425, 0xb251653d }, 1 },
-	{ {0xfb51c505, 0xadfbc174, 0xdf94289f, 0xa894ef96, 0x9f5357bc }, 1 },
-	{ {0xf08c91f8, 0xc78d681e, 0x1f02eaaa, 0xaafb87ad, 0x81112b60 }, 42 },
-	{ {0x47a9d9a2, 0x4e4fc6f9, 0x467c6e7d, 0x61a02d45, 0xf5a753ef }, 42 },
-	{ {0xa0669ca4, 0xababafb7, 0x03ae35c8, 0x6083c3ee, 0x424a9dea }, 39 },
-	{ {0x965f4982, 0x790f1817, 0xbcbabbb3, 0x8c877718, 0x3b231a55 }, 24 },
-	{ {0x87936f80, 0x8423dddf, 0xd0062905, 0x6d6807b4, 0xbe1dc63e }, 42 },
-	{ {0x914f6ccb, 0x25d78621, 0x186001f2, 0xf5e2aaa2, 0xd628cd0c }, 64 },
-	{ {0xb6d3649a, 0x6647fa9f, 0x6bd61efc, 0x317485a2, 0x0901128f }, 1 },
-	{ {0x30fff22e, 0x3e3d4649, 0x93707488, 0x442721a5, 0xe56a9707 }, 24 },
-	{ {0x6a50295e, 0xa35e720b, 0xa6f4ba56, 0x16c34411, 0x28b384ed }, 42 },
-	{ {0x171b587b, 0xd5a947a1, 0x3f311412, 0x0b6e7bac, 0xa3b57d78 }, 1 },
-	{ {0xd41676fd, 0xe0a30477, 0x92f93c4a, 0x41509b87, 0x49e55e74 }, 39 },
-	{ {0x4421fa25, 0x04cbce18, 0xf7c84b5e, 0xa97f04e0, 0x17007f07 }, 39 },
-	{ {0x85463e6f, 0xd7e51d48, 0xfb123cba, 0xbfcd4fd2, 0xc6bcf28d }, 63 },
-	{ {0xf1b4603c, 0x672f52a9, 0x2a93b4cd, 0x5e861a3c, 0x2f6230b7 }, 63 },
-	{ {0xf59d3331, 0x1c95edc0, 0x168445f7, 0x4eddd8a6, 0x772aa6a0 }, 63 },
-	{ {0xcc141385, 0xd69ccf35, 0x8d7055e7, 0x6ffe1a8c, 0x2cf52802 }, 63 },
-	{ {0x1d6e68a3, 0xfe7c831e, 0xea257e0c, 0x0ab8d324, 0xaa0df9b7 }, 63 },
-	{ {0x1b946463, 0x07fbc586, 0xd9572e42, 0xe871f7af, 0x82dd5f73 }, 21 },
-	{ {0x124126ce, 0xe840e43c, 0x7668c11c, 0x2bec2f34, 0xb3d00c68 }, 63 },
-	{ {0xaace4ef0, 0x766ec752, 0x97cf1945, 0xfe81de4e, 0x9c0a2b0f }, 63 },
-	{ {0xa3630152, 0x86341ffa, 0xbcdc38ef, 0x0d890897, 0xed51e322 }, 63 },
-	{ {0x70a25b5e, 0x8ca1f02f, 0x91c32ec8, 0xadb80e58, 0xce683911 }, 63 },
-	{ {0xc518232e, 0x8e59ab43, 0x3243ab2a, 0xf546afd2, 0x2cc7bf26 }, 63 },
+	{ {0xd53a8efe, 0xfe371426, 0x9538a91e, 0x5256c293, 0x8fe13239 }, 5 },
+	{ {0xd53e0c8b, 0xcd98820a, 0xfe820f75, 0x6af35cc9, 0x7911bfe4 }, 4 },
+	{ {0xd552319a, 0x19814494, 0xe3016de4, 0xb8f010e8, 0xf7b97e02 }, 1 },
+	{ {0xd5528825, 0xc7eea2cf, 0xeadd64db, 0x1dbdbe13, 0x44478fc6 }, 1 },
+	{ {0xd5547103, 0x17482127, 0xf2e1597e, 0x91e72be5, 0xee0726ce }, 5 },
+	{ {0xd55e9e23, 0x7504bc64, 0x44c6b628, 0x94bf8829, 0x2150042a }, 19 },
+	{ {0xd5674f02, 0x17031d4b, 0xfab9c533, 0x93c18036, 0xa9707b72 }, 19 },
+	{ {0xd57fc412, 0x1d716182, 0xa091bb53, 0xc666b46c, 0x10142668 }, 5 },
+	{ {0xd5902afb, 0xd8dfb1ea, 0x96fc8cf4, 0xd62cf6e4, 0xfa40d4f7 }, 5 },
+	{ {0xd59ad9f1, 0x6932cc3d, 0xadb22c25, 0xe64c10a7, 0x3a055056 }, 19 },
+	{ {0xd5b16479, 0x7bc969b5, 0x5c1a6f40, 0x06a4535c, 0x3fb03cf0 }, 17 },
+	{ {0xd5bf4814, 0xea694481, 0xc8badbb8, 0xde8d56a0, 0x8ee03cc0 }, 1 },
+	{ {0xd5f5d285, 0x0b0bfda4, 0x5ba4dfff, 0x70d3fd99, 0x86399a94 }, 19 },
+	{ {0xd605458c, 0x96bbb538, 0xc4624dee, 0xeed3294e, 0xa489a61e }, 3 },
+	{ {0xd621e2a2, 0xf0f924a1, 0x7673f5d4, 0x7f218209, 0x5074acf4 }, 19 },
+	{ {0xd632a1f0, 0x6a801842, 0x2fc9bc83, 0xab26c501, 0xd34d447d }, 19 },
+	{ {0xd63e2036, 0x9f984877, 0x67810a0c, 0x57603bef, 0x6a2a07e5 }, 3 },
+	{ {0xd65f0010, 0xdacbd252, 0x8eaa2546, 0x7ef007a8, 0x7f17ae7a }, 19 },
+	{ {0xd66068f5, 0xa8b6cad0, 0x9ed57893, 0xceb0f3dd, 0x37ce8715 }, 4 },
+	{ {0xd6720845, 0x928ee848, 0xcfa88a86, 0xaccb0673, 0x97685f02 }, 1 },
+	{ {0xd67be6d7, 0xd56d7229, 0x418f4e12, 0x2f2ec279, 0x90db7d19 }, 1 },
+	{ {0xd69d4a6f, 0x2834b20d, 0xf3a2afbd, 0x7a927220, 0xe96e31e1 }, 19 },
+	{ {0xd6b6cb3d, 0x85b991f8, 0xadf2e07a, 0x0e8e74b5, 0x86741d12 }, 19 },
+	{ {0xd7109cf2, 0x0a22558f, 0x923c833f, 0xf0b4e231, 0x1340acb1 }, 6 },
+	{ {0xd71b0de8, 0xae4e1d57, 0xace2d1f6, 0x6cac1c19, 0x65102019 }, 19 },
+	{ {0xd723f2eb, 0x1c887db5, 0x448fd56b, 0xe5e7c57e, 0x60d88e63 }, 4 },
+	{ {0xd7446382, 0x4c3c15cb, 0x391ef7a1, 0x3054472b, 0x5e7abe73 }, 19 },
+	{ {0xd74885c9, 0x73915980, 0x5bc9fa66, 0x163c56c6, 0xa0daa5fb }, 42 },
+	{ {0xd74c381e, 0xa17acb94, 0x527ef3ab, 0xaa280793, 0xa824d322 }, 19 },
+	{ {0xd76a904d, 0xd88f7360, 0xfe79000c, 0x374f40a6, 0x9b801325 }, 19 },
+	{ {0xd76c7a5c, 0x2d28684f, 0x0d67114c, 0xc7b9707b, 0x296e68a2 }, 5 },
+	{ {0xd77a0208, 0x790f9563, 0x985d236d, 0x79a80d73, 0x7b47f070 }, 19 },
+	{ {0xd7829313, 0x3b075f48, 0xc9dc5c4c, 0xf0c4a985, 0xae964b08 }, 9 },
+	{ {0xd78d763e, 0x72e23418, 0xf31dc3ce, 0x91deea1e, 0x8ee10490 }, 5 },
+	{ {0xd7b46aec, 0xe68c924e, 0x09f07e3d, 0xf45711f3, 0x37d35d6a }, 5 },
+	{ {0xd7bd6e84, 0xedcaf6d9, 0x9abaf659, 0x78135019, 0x26bda398 }, 19 },
+	{ {0xd7e2a4f7, 0x8b3e2403, 0x09c6367a, 0xc9dd9c9a, 0xeb95e3ee }, 19 },
+	{ {0xd7e85888, 0x117188a6, 0xd6f7914e, 0x9649fc48, 0x21c594a2 }, 4 },
+	{ {0xd7f8c34e, 0x3ae9dea5, 0x1d0c8785, 0x7e0ff780, 0x28d402b7 }, 5 },
+	{ {0xd7fb2ca6, 0x004c5fdf, 0x77c42a5e, 0xab102b95, 0xa9a862d7 }, 4 },
+	{ {0xd81a4fee, 0x5bff14ed, 0xa613fb72, 0xbc784298, 0x74bbb18f }, 19 },
+	{ {0xd82135a5, 0xe28b750c, 0x44995af1, 0x16db890a, 0x15f6428a }, 8 },
+	{ {0xd833c66d, 0xd5412399, 0x08555762, 0xe04bcbb2, 0x2bca748a }, 19 },
+	{ {0xd83bb9d7, 0xf71de899, 0xa726af11, 0x80e2e766, 0xd39fe5a2 }, 19 },
+	{ {0xd844c4c5, 0xae9c7ac6, 0x71c4be71, 0xac1190a1, 0xe5db4d36 }, 19 },
+	{ {0xd86b5f30, 0x154b472d, 0x6f61a378, 0x4303d5ac, 0x328f4435 }, 19 },
+	{ {0xd88f33ee, 0x40839f87, 0xcdce6cc4, 0x820e1dd1, 0x92a01776 }, 19 },
+	{ {0xd89922ed, 0x43ea4fc0, 0xb87d7e5b, 0xaef3f072, 0xbb566849 }, 3 },
+	{ {0xd8b93575, 0x7e77f071, 0x7559291e, 0x2abc7f7a, 0xd2e397ad }, 19 },
+	{ {0xd8c07426, 0x7e0b2ec2, 0x25d5acba, 0x688ea730, 0x4233da13 }, 19 },
+	{ {0xd8e34fab, 0xf8584bb5, 0x66c5056f, 0x8b42b50b, 0x6f497f48 }, 19 },
+	{ {0xd8e9fd3e, 0x9420bcbb, 0x1dd530fd, 0xa1e9c718, 0xaa08d8e4 }, 19 },
+	{ {0xd916f0e4, 0xbd3c829a, 0x0472c6ec, 0x18d08907, 0xa5c991f3 }, 19 },
+	{ {0xd9195b9a, 0x24f6e7c5, 0xb99eca04, 0x6908915b, 0xfe369d46 }, 19 },
+	{ {0xd927dce3, 0xca188da7, 0x33889e41, 0x41aa526b, 0x9a10e635 }, 19 },
+	{ {0xd92c82e1, 0x55cb34f6, 0x5587d472, 0xd4eb5ed1, 0xb9e68018 }, 19 },
+	{ {0xd9307bfd, 0xaab1312d, 0x25e38af7, 0xc0d3a767, 0x1a9f716b }, 42 },
+	{ {0xd9432774, 0x5bbb865a, 0x394e31e1, 0x50a6c772, 0x63ee95da }, 4 },
+	{ {0xd956167e, 0x234f60ad, 0x91612043, 0x7120f86f, 0xc8c3c321 }, 105 },
+	{ {0xd9634296, 0x511c5998, 0x52aff0c6, 0xb9993509, 0xbcbc3bef }, 19 },
+	{ {0xd9826cb2, 0x044ed022, 0x4124f2f3, 0x1d0bdc1f, 0xb840d81c }, 5 },
+	{ {0xd99eebde, 0xd5db5fce, 0x1e072d08, 0xe642c090, 0x9bc7efdd }, 1 },
+	{ {0xda1f2074, 0x66a88b34, 0x7e995a6e, 0xd7d960c7, 0xcec5aa8d }, 19 },
+	{ {0xda397e78, 0x3d677d1a, 0x78fff222, 0xd9d6cb48, 0xb915dada }, 5 },
+	{ {0xda4b44c7, 0x34029f60, 0x388b7cea, 0x4ab97c3d, 0x5c6a09e9 }, 9 },
+	{ {0xda55d2b5, 0xde5d6b04, 0xa55d9019, 0x11c9fa77, 0x76fd0159 }, 19 },
+	{ {0xda5fd6ce, 0x2f92a40b, 0x1ccaf6e3, 0xc425d720, 0xfebc3543 }, 19 },
+	{ {0xda6a332d, 0xc2360732, 0x86aa7858, 0x2c0fccf7, 0x28c86ba4 }, 19 },
+	{ {0xda7cfd16, 0xdd1a76ae, 0x6b551cea, 0xbfd7053c, 0xa8e3412f }, 19 },
+	{ {0xda80f0bc, 0x07cb0ed3, 0x6c7c1065, 0x64b5f043, 0x53eb176a }, 19 },
+	{ {0xda824945, 0x2da86c0b, 0xa44f0ae2, 0x79ccff82, 0xa1ddd756 }, 19 },
+	{ {0xda95bcd1, 0xf0c28683, 0xcfb4a7a2, 0xc1059926, 0x1dca3622 }, 19 },
+	{ {0xdab3e6f3, 0x68433926, 0x65b71b04, 0x178aadd8, 0x762c6589 }, 65 },
+	{ {0xdab5a9f9, 0x3a35fcb9, 0x2c01e425, 0x0b01928f, 0xe8bd294b }, 38 },
+	{ {0xdacc9ed6, 0xa80fb15c, 0x3e82c408, 0x1c07211e, 0x033ba820 }, 4 },
+	{ {0xdb07b3da, 0x69674e36, 0x356bc78c, 0xaa2ac524, 0xdee26477 }, 42 },
+	{ {0xdb0ed31c, 0x779fffd2, 0x084946e3, 0xba69512b, 0x372d845f }, 19 },
+	{ {0xdb1513df, 0xf6dd456f, 0xc9732868, 0x16129ace, 0x81bcdfdd }, 6 },
+	{ {0xdb22cd03, 0xdb61a495, 0xd55c460c, 0xfaa26627, 0x1c8a5926 }, 4 },
+	{ {0xdb33011d, 0x006201b3, 0xbd3bbc4c, 0x7c952da2, 0x990f36e4 }, 17 },
+	{ {0xdb7e4c8d, 0xc56a0e8e, 0x0e3df08b, 0x14a65030, 0x738d5ac4 }, 3 },
+	{ {0xdbcfa558, 0x70a26711, 0x2c9a71bc, 0xf85b481b, 0x11d98e04 }, 4 },
+	{ {0xdbed87a5, 0x3c604f71, 0x40577d67, 0x07ca0fc8, 0x490463a6 }, 3 },
+	{ {0xdc39adf9, 0xf825e2f5, 0x5fa7e6c1, 0xbb69483c, 0xbbec2695 }, 19 },
+	{ {0xdc49e2ac, 0x9985a417, 0x078412cc, 0x09fe7270, 0x033ffb17 }, 19 },
+	{ {0xdc50f2c9, 0xdb233e50, 0x5b0981c2, 0x44ff3de5, 0x53ac9d68 }, 42 },
+	{ {0xdc56cff1, 0x211bacd9, 0x4f59e188, 0xe44a58d6, 0xf40a0c26 }, 6 },
+	{ {0xdc6437a5, 0xd52f77f5, 0x24198b9d, 0x539b34de, 0xc6122854 }, 42 },
+	{ {0xdc69c7a9, 0xea93cbb0, 0x09330095, 0x5935ef15, 0x6af5c194 }, 19 },
+	{ {0xdcc1ecdd, 0x0e3a2a33, 0xb994e472, 0xea367a16, 0x37cc3799 }, 17 },
+	{ {0xdcc3a677, 0x32aa01c4, 0xf2ee8d1a, 0xd886444a, 0x4dbafe06 }, 42 },
+	{ {0xdccdb2d1, 0x8c70a94e, 0x48b3ec5e, 0x0cb986c5, 0xd708bbc9 }, 4 },
+	{ {0xdceffda9, 0x22852fd2, 0x2e1a566b, 0x9cb3106d, 0x82db5847 }, 19 },
+	{ {0xdcf79362, 0xf6885373, 0x3326a22e, 0xb8fdafa1, 0x7bca281e }, 42 },
+	{ {0xdcfd6739, 0x26a1c10c, 0xf4bada73, 0x1d072d3f, 0x6ce29c44 }, 19 },
+	{ {0xdd1e87a1, 0x6e5fb38d, 0x9d729ef7, 0xedc6da21, 0x146a99fe }, 4 },
+	{ {0xdd5c2d2d, 0x5f094715, 0x9b7615f6, 0x47fb8121, 0xf3b037a2 }, 19 },
+	{ {0xdd76ee10, 0x71e427cb, 0xfedeeedc, 0xb3a4b8bc, 0xad56ba71 }, 19 },
+	{ {0xdd926342, 0x09338632, 0x401e2b6f, 0x118cbaaa, 0x5f8add86 }, 19 },
+	{ {0xdd9a41e4, 0xc8802cd4, 0xbbb87e30, 0x281711f4, 0xe7ae017f }, 19 },
+	{ {0xdd9d6ed4, 0x42122d14, 0x2987fd69, 0x1001efcc, 0x2bc18c7c }, 19 },
 	{ {0xddadcea0, 0xe72463e5, 0xa86be972, 0x686c02b5, 0xda2fb21b }, 63 },
-	{ {0x7b11f333, 0x2c053f19, 0x75b16c70, 0xa70cd6a4, 0x2cc57959 }, 16 },
-	{ {0x409e82ad, 0xac40f6bd, 0xd18eb6c8, 0x4e8b2fbd, 0xc7fb5498 }, 1 },
-	{ {0xaea0e4a6, 0x35efce53, 0x36e496d3, 0x6e4cb0a4, 0xb79593ff }, 1 },
-	{ {0xcf00ec60, 0x608010aa, 0xc94cfe24, 0x5eb7aa67, 0xcb44d110 }, 1 },
-	{ {0x3a1f5fcb, 0x8c0856aa, 0xef8dd611, 0x99a62acb, 0x760b0086 }, 141 },
-	{ {0x02ee1a32, 0xd48525cc, 0x29440608, 0x666bfdfe, 0x77507888 }, 141 },
-	{ {0x945d91ac, 0x6285daca, 0xf123a953, 0x5dc740ad, 0x65bd06d5 }, 141 },
-	{ {0x415561d4, 0x2dfe384f, 0x9cb9bc08, 0x7fe3ac89, 0x326e8114 }, 1 },
-	{ {0x9b99c2ab, 0x2e06f44b, 0x4e17d790, 0x1c091234, 0x2a7295af }, 1 },
-	{ {0x9d789166, 0xe3caf28e, 0x4742fe93, 0x3d962e99, 0x618c633d }, 16 },
-	{ {0x19bf90b8, 0xd2e695ff, 0xad61fff6, 0xf47f7fcd, 0xa2f24a1d }, 87 },
-	{ {0x3abca440, 0xcba16ac5, 0xe162b602, 0x557d3016, 0x9f77adab }, 1 },
-	{ {0x9eaad185, 0xefc8e224, 0x368d1db4, 0x949eb965, 0x9c26fb2c }, 1 },
-	{ {0x829c00c3, 0x114f25b3, 0xdae5157c, 0x0a238b52, 0xa3ac37db }, 1 },
-	{ {0xd5bf4814, 0xea694481, 0xc8badbb8, 0xde8d56a0, 0x8ee03cc0 }, 1 },
-	{ {0xef3e010e, 0xb57e4476, 0x700a3bbf, 0xf9d2119a, 0xb3acdf62 }, 1 },
-	{ {0xd6720845, 0x928ee848, 0xcfa88a86, 0xaccb0673, 0x97685f02 }, 1 },
-	{ {0x605f5af3, 0xf358c681, 0x1f54e017, 0x3bad9086, 0x14a198c0 }, 1 },
-	{ {0xd4cea8c8, 0x15f3eeab, 0xe0c6a1c8, 0x45f902ec, 0x4318bf6b }, 39 },
-	{ {0x91e22b72, 0x7002ceeb, 0x0cf5fb10, 0x19a0c907, 0xc3cd24a5 }, 39 },
-	{ {0x9c43106d, 0xba3ae282, 0x9e9a11df, 0xfa9d000e, 0xd6d6454c }, 1 },
-	{ {0x4f2a7e01, 0x72f0214f, 0x025f2384, 0x5f6e053d, 0x0ffd28e8 }, 1 },
-	{ {0x1fc23069, 0x11ab6e1e, 0xbdf7cb8c, 0x3c34a7f1, 0x16414e88 }, 1 },
-	{ {0xd5528825, 0xc7eea2cf, 0xeadd64db, 0x1dbdbe13, 0x44478fc6 }, 1 },
-	{ {0x5c463dd9, 0x90582e67, 0x7c8206f6, 0x1035a7c5, 0x4d8c67f0 }, 1 },
-	{ {0xfe0254cb, 0xfc11405b, 0x79e7c86c, 0x7769bd63, 0x22b04995 }, 1 },
-	{ {0x3c86f9aa, 0x84febfe4, 0x9c1b2cd3, 0x5442a46a, 0x172b5493 }, 63 },
-	{ {0xffc1bafc, 0xa38d20ed, 0x6e9a27c9, 0x0c6ab089, 0xa8482d89 }, 63 },
-	{ {0xcc141385, 0xd69ccf35, 0x8d7055e7, 0x6ffe1a8c, 0x2cf52802 }, 63 },
-	{ {0xf59d3331, 0x1c95edc0, 0x168445f7, 0x4eddd8a6, 0x772aa6a0 }, 63 },
-	{ {0xff26b2b0, 0x23d04513, 0x08ff932b, 0x5280fe33, 0xea60496b }, 100 },
-	{ {0x977fed11, 0x35b6cc73, 0xe765b47f, 0x51570fc0, 0x0acd5b79 }, 1 },
-	{ {0x4f41f851, 0x24a682b0, 0x243e9d64, 0xa5f7f6a9, 0x9258ea20 }, 1 },
-	{ {0x0cbe0df4, 0xaf45e8f5, 0x31e9c761, 0x403ac9e7, 0x1808f20c }, 1 },
-	{ {0x32760893, 0xce06dbe3, 0x93062775, 0x5ba065cc, 0x3d8ec6ca }, 79 },
-	{ {0x7f115ff9, 0x23a1cc0d, 0x1944cf28, 0x0168add9, 0x46fde854 }, 50 },
-	{ {0x181bf58d, 0xa7184e12, 0x8cd419da, 0x3109b933, 0x44a543cf }, 42 },
-	{ {0xb25b7fda, 0x37ba2a02, 0x362a45b2, 0xacdb2103, 0xf9a6e323 }, 42 },
-	{ {0x47370bec, 0x7ca1f061, 0x5a54eda5, 0x48b07fbc, 0x0c7ef398 }, 42 },
-	{ {0xc279c3f4, 0x1d536876, 0x1f908815, 0x7b80214d, 0x835a548c }, 42 },
-	{ {0xd4686042, 0x69ae7664, 0xac739ea9, 0xf922a05e, 0x14ffa3d1 }, 42 },
-	{ {0xebd1f02f, 0xa4e5f165, 0xd756ab78, 0x864f8820, 0x22ede844 }, 42 },
-	{ {0xb9faa034, 0x49949cb1, 0xb1990955, 0x61e0f07c, 0xca2c8e0b }, 42 },
-	{ {0xf979ad20, 0x850a5c16, 0x73bc2c59, 0x43f470db, 0x6925eb50 }, 24 },
-	{ {0x8d142e4f, 0xe476f27e, 0x46a21291, 0x99194f5b, 0x3cc70370 }, 1 },
-	{ {0x32de67d6, 0x26d799d6, 0x6e41c57d, 0xd9e049d4, 0xea01c997 }, 1 },
-	{ {0x54f91914, 0x8673fa54, 0x0f987e6d, 0xb85d85ba, 0xa45bd17b }, 21 },
-	{ {0x6354ccc5, 0xc100b1c5, 0x58c9395f, 0xa8c00784, 0xd2e9b0a3 }, 78 },
-	{ {0x5f2ab7f9, 0xc4e8218b, 0x956dd76f, 0x3706e9e7, 0xde3361f3 }, 1 },
-	{ {0xb9ee4f30, 0xa36e283a, 0x2b1b9a28, 0xa70ab9b9, 0x831570c6 }, 87 },
-	{ {0xc7a2c5ba, 0xee6a9f0e, 0x1c6ee7d7, 0x6944c0ab, 0x1886796c }, 1 },
-	{ {0x302afb5d, 0x8be26c75, 0x8309ca3d, 0xf611ae69, 0xcced2821 }, 1 },
-	{ {0xf1525de4, 0xe0b60a66, 0x87156c2a, 0x96f8a8b2, 0x044b6c56 }, 64 },
-	{ {0x77bd67d5, 0xd10d459d, 0x343e79ea, 0xfcd8e17e, 0xb0f209dd }, 42 },
-	{ {0x931d6318, 0x774bd495, 0xa32ec3da, 0xbf8d0edf, 0xc9913324 }, 1 },
-	{ {0xdf48902f, 0x5f12af88, 0x67ae1a87, 0xf255145f, 0x0e5e0774 }, 1 },
-	{ {0x9ed3ab6d, 0x893632b9, 0x246e91b4, 0x12cd5db5, 0x19e7586b }, 24 },
-	{ {0x3f047469, 0xb62d9390, 0x4005a0ea, 0x29092e89, 0x2724ce0b }, 1 },
-	{ {0x0081ea0d, 0x25bc5cd8, 0xd70b60ad, 0x8cfdc730, 0x7812c0fd }, 1 },
+	{ {0xddc18248, 0x26d78e29, 0x261b30a6, 0x75bff986, 0x2f308392 }, 19 },
+	{ {0xddc458bb, 0x3c70e070, 0x8841e516, 0xd9b89220, 0xc0e098a1 }, 19 },
+	{ {0xde05494f, 0xae17c0a8, 0xc411cf0f, 0x782f00aa, 0x9209c34e }, 19 },
+	{ {0xde0eb1c4, 0x6c479248, 0x79e2a49f, 0x9eafba0a, 0xb344fe5f }, 6 },
+	{ {0xde10aa2a, 0x2abfdcaf, 0xe0064e1e, 0x76b676f5, 0x4c7aafc6 }, 19 },
+	{ {0xde234922, 0x7d765db7, 0x3cdc44ef, 0xc6338f6b, 0x530eb133 }, 4 },
+	{ {0xde251a0a, 0xf1df3be1, 0x8469578d, 0xc00d414e, 0x572ee33e }, 38 },
+	{ {0xde2dd717, 0x30922168, 0x428dbc11, 0xa82fe91b, 0x84c23192 }, 19 },
+	{ {0xde3035a1, 0x59dbd910, 0xd4f390cc, 0x814e9e99, 0xfba94ee0 }, 19 },
+	{ {0xde4e210e, 0x6f757efc, 0x45e66be6, 0x6b14cd6e, 0xc21b2ba7 }, 19 },
+	{ {0xde505f32, 0x041800ec, 0xae382772, 0xa8f5adf2, 0xe397124b }, 19 },
+	{ {0xde5da311, 0x941056a9, 0x0cab28fd, 0x91522c05, 0x4871513f }, 19 },
+	{ {0xde6db54c, 0xef2cc4cb, 0xcc09c57c, 0x8ed0a1ff, 0x01347b6e }, 19 },
+	{ {0xde765e69, 0x9af4d76d, 0x8fa80fb1, 0x0d1e4158, 0x1bec11bf }, 19 },
+	{ {0xde7b6525, 0xf9aafe8e, 0xf77d25a7, 0x99f0f829, 0x0bbc8f2e }, 55 },
+	{ {0xde95b99d, 0xffeab5c2, 0xb453778d, 0xbdc8723d, 0xc15cbfd7 }, 4 },
+	{ {0xde9eb0e9, 0xef183f49, 0xe9d9b631, 0xf8818f9c, 0xac5df409 }, 19 },
+	{ {0xded7907e, 0xd2894200, 0x806319a9, 0xcf7b13c7, 0xcf0d88d9 }, 143 },
+	{ {0xded8d969, 0x542b7be0, 0x2524037f, 0xa244e664, 0x8c3f4e03 }, 39 },
+	{ {0xdee167d8, 0x6c9d9d43, 0x5b141080, 0x4055b561, 0xffa2c6e3 }, 19 },
 	{ {0xdf07e89f, 0xa0b1c787, 0x4f9cdf18, 0x4c136f96, 0x4fea4ff4 }, 1 },
-	{ {0xc63db266, 0x60da96af, 0x56f8a7d3, 0xea18544b, 0x9ae5a37c }, 1 },
-	{ {0xe89ea1e8, 0xe583392e, 0x2dd9debb, 0x8a4b6a16, 0x2f58ba91 }, 28 },
-	{ {0x1ebb0606, 0x2428fcdc, 0x66808a03, 0x761818db, 0x2bba3c73 }, 29 },
-	{ {0x6442c1c5, 0xcece64c6, 0xdae90cc6, 0xae3675f0, 0x70d93e06 }, 1 },
-	{ {0x4c8ea05c, 0x09b40c41, 0x888fa18d, 0xb065575a, 0x317fda16 }, 1 },
-	{ {0x3ce8e357, 0x90eb4689, 0xb21e14c7, 0xecdd4b63, 0x943ee158 }, 1 },
-	{ {0xb8e30d60, 0x4d319d51, 0x1cbfbc61, 0xe5d8c38f, 0xbb9c5a33 }, 1 },
-	{ {0x073feb8b, 0xb645d935, 0xe099afaf, 0x61e6f04f, 0x52adee42 }, 64 },
-	{ {0x005794c1, 0x0a4237de, 0x3907ba4a, 0x44d43607, 0x8d3c06c2 }, 31 },
-	{ {0x31292b9c, 0xa9fe7d1d, 0x8833530f, 0x44c0a567, 0x1bfefe4e }, 1 },
-	{ {0x02155fc2, 0x5c9bd23e, 0x1654fe81, 0xc7448635, 0x1e1ecc28 }, 1 },
-	{ {0x3a9a942e, 0xd888dd64, 0x1cddf8de, 0xada1879c, 0x454df3c6 }, 42 },
-	{ {0x0fbd45ef, 0x3dd7bb82, 0xd4c31f19, 0x47884f41, 0x1f1ca344 }, 1 },
-	{ {0x5e872d58, 0x53698731, 0xa0ed22fb, 0x72dbcdfd, 0x59cd19c3 }, 24 },
-	{ {0xa7a23dc0, 0x1314e883, 0x81eee88b, 0x4878b399, 0x31ab4818 }, 30 },
-	{ {0xf5af1d2a, 0x8bcf247f, 0x78847e1a, 0x9d995e58, 0x1df87e8e }, 1 },
-	{ {0x78cd7f84, 0x7e77fd8c, 0xd51a647e, 0xfb2725ba, 0x93f4c471 }, 64 },
-	{ {0x59967765, 0xd6e93289, 0x09dee4da, 0xc1cbe4cf, 0x9d47d315 }, 1 },
-	{ {0x98bbfa3a, 0xb07b7a5c, 0xad55d7dd, 0xf7cbd944, 0x0caa2a86 }, 1 },
-	{ {0xb677a861, 0xb67e8763, 0xa11d5dcf, 0x52416b42, 0x493ade57 }, 1 },
-	{ {0x44e0dd21, 0x5b2a9f07, 0x70dd76fb, 0x49187c05, 0xb083eed9 }, 1 },
-	{ {0x4be8371f, 0x3b03e70d, 0xdaca4959, 0x58345f3c, 0x4f8e2d36 }, 1 },
-	{ {0xc1fb0fa0, 0x1fadf82d, 0x86ed02da, 0xff46e7bd, 0x4ad7a59d }, 64 },
-	{ {0x8c7ae1a1, 0x720b1dae, 0x9af9904e, 0x638b868f, 0x56d905c2 }, 28 },
-	{ {0x765413bb, 0x6b03bc3b, 0xb888ee8f, 0xe00b99ef, 0x69c1317a }, 29 },
-	{ {0x352ec8c9, 0x9fe1397a, 0x88ecb3ae, 0xe6dbb4d1, 0x21c818e9 }, 135 },
-	{ {0x1594eea1, 0x91c9f660, 0xe7b8ab2f, 0x3b68f76d, 0x02605c80 }, 135 },
-	{ {0xeb284ea9, 0x205f3889, 0x8feff96f, 0x85e8cf17, 0x207e2c4d }, 135 },
-	{ {0x1d4c0916, 0x6755c656, 0x9ff0ed38, 0x78bbf1b2, 0x2d7e3864 }, 134 },
-	{ {0x8afd1ec5, 0x843ecfdc, 0xbff11497, 0xfa8c55b8, 0x70c0c6f5 }, 134 },
-	{ {0x0479fa6f, 0xcedf97c2, 0x560c08cc, 0x13556c9e, 0x3adf5671 }, 110 },
-	{ {0x4781c2c1, 0x626211b4, 0x551af324, 0xc566aa37, 0xbc2274c7 }, 110 },
-	{ {0x5ebfb4f6, 0xaf4cb5b4, 0xb228863d, 0xbdd41205, 0xdfaa1341 }, 110 },
-	{ {0x5ca722c5, 0x6381e2a9, 0xcdb41fc0, 0x0923bc4e, 0x05780e4f }, 110 },
-	{ {0x1131e86e, 0x488e24cd, 0x8ef9a341, 0xc3115c5c, 0x7addd3b7 }, 110 },
-	{ {0xab017762, 0x4d46dd77, 0xab4f50ff, 0xcb983c3b, 0xa88223f4 }, 1 },
-	{ {0x19595017, 0x3701abeb, 0x460a1a07, 0x0d83466f, 0x3f53b337 }, 1 },
-	{ {0x69bf27b6, 0x10e11437, 0xdad1f7a1, 0xc37a6317, 0x9a293d12 }, 1 },
-	{ {0x63098f27, 0xbeac9eca, 0x6b39d837, 0xd2a55239, 0x5df33fe1 }, 42 },
-	{ {0xd9307bfd, 0xaab1312d, 0x25e38af7, 0xc0d3a767, 0x1a9f716b }, 42 },
-	{ {0x7f5b7660, 0x5e3d898c, 0xc4b5aacf, 0x1d7682b8, 0x2fe84353 }, 42 },
-	{ {0x2752cd89, 0x754c05ab, 0xdf7c23cb, 0xa132d38e, 0x3ef0f27d }, 42 },
-	{ {0xe194d290, 0xebfa4595, 0xce0349ea, 0x2fc15442, 0x508485b0 }, 42 },
-	{ {0xa3f4e2e4, 0x93407492, 0x5d775afe, 0x30ac72f1, 0x50ede543 }, 42 },
-	{ {0x4a99f244, 0x4f29c2b6, 0x42efd6f0, 0x84081d6f, 0xd96bfa9b }, 42 },
-	{ {0xea35cc2c, 0xad9cfdf5, 0x6cae224d, 0x8ee41579, 0xde37f000 }, 42 },
-	{ {0x141e61cc, 0x8e0e5138, 0x2e508fbd, 0x77a34b77, 0x8a4f8444 }, 57 },
-	{ {0x607cfca6, 0x05eaf82e, 0x3efa3345, 0x9d6583ef, 0xb7ecc13b }, 57 },
-	{ {0x716952ea, 0xb41077f1, 0x8e6835d1, 0x1caad676, 0x1b17d400 }, 139 },
-	{ {0xf89e3d8f, 0x3b6855c2, 0x9d71d314, 0x9cc762e0, 0xf6918ad5 }, 139 },
-	{ {0xa11949a2, 0x072d5a2f, 0x58cb63e9, 0x34877bac, 0x46809285 }, 42 },
-	{ {0x304bb59b, 0x8fcc19fd, 0x76b68793, 0x31243f42, 0xf53fc47d }, 140 },
-	{ {0x2367ad17, 0xbc6bfaaf, 0x7b94a009, 0xae26d508, 0xbdcf5565 }, 140 },
-	{ {0xd552319a, 0x19814494, 0xe3016de4, 0xb8f010e8, 0xf7b97e02 }, 1 },
-	{ {0x9d67fab5, 0x5b85f4ac, 0x4f592432, 0x3a70020e, 0xb8589057 }, 42 },
+	{ {0xdf10b3c8, 0x470acebb, 0xc445f7c2, 0x4a50b4f2, 0x4db0187d }, 6 },
+	{ {0xdf13ed64, 0x7ed4f5a6, 0xb04f1710, 0xfc1140ea, 0x65dc966f }, 39 },
+	{ {0xdf15daf1, 0xe68e9c8c, 0xd95c4431, 0x803d86fe, 0x6c2f985e }, 3 },
+	{ {0xdf203139, 0xad0cd235, 0x7f312541, 0x7a4157e7, 0x01dbacf6 }, 56 },
+	{ {0xdf2ef80e, 0x9cfabde8, 0xb630c180, 0x2fd69757, 0x6102feb7 }, 105 },
+	{ {0xdf48902f, 0x5f12af88, 0x67ae1a87, 0xf255145f, 0x0e5e0774 }, 1 },
+	{ {0xdf503d6f, 0x5d72a2a3, 0x55db53c3, 0x5950348f, 0xb7c767bf }, 42 },
+	{ {0xdf505aec, 0xddb20171, 0xcafd0635, 0x1e0b7d20, 0x8365e708 }, 144 },
+	{ {0xdf797593, 0x395346e9, 0x4aa1cf13, 0xa9524e30, 0xd631888d }, 19 },
+	{ {0xdfd7ef6f, 0xd86efd5c, 0x8019b59d, 0x8fa5c5a4, 0x7cf90cd0 }, 39 },
+	{ {0xe002a9b4, 0x26732e6c, 0x2d31e548, 0xc40cf7c1, 0x22348ce3 }, 78 },
+	{ {0xe003d57d, 0x2102e8fd, 0xf5d9eea7, 0xbd78a3cf, 0x67d75778 }, 5 },
+	{ {0xe03ec3a6, 0xbb6d8b1b, 0xc6eab349, 0xc7675cb7, 0x2aa47d57 }, 19 },
+	{ {0xe0652385, 0x80b9e118, 0xb6c9e789, 0xd797cdd9, 0x9e0a1c69 }, 6 },
+	{ {0xe067ce2b, 0x444ec7a3, 0xdd45d9e2, 0xdf4b34c1, 0xba732872 }, 65 },
+	{ {0xe06ed9b0, 0xb3e1fbb9, 0xf27be65c, 0x37b4d9b5, 0x48889b4f }, 19 },
+	{ {0xe0854e93, 0x22c113ec, 0xbccf61f9, 0xde1c0a59, 0xbda03d23 }, 19 },
+	{ {0xe0a8aff9, 0x80ed84ec, 0x12acbf63, 0xb40cf989, 0x5997faf3 }, 5 },
+	{ {0xe0c2bfb0, 0x78562d15, 0xacabc583, 0x1020a237, 0x0ea87052 }, 1 },
+	{ {0xe0d84b3b, 0x2ac7675c, 0x3ed10479, 0x7840d43b, 0xc2347a5b }, 19 },
+	{ {0xe0e8ed63, 0x7f5d220f, 0x881cc9b5, 0x2bc52e9d, 0xd3373489 }, 19 },
 	{ {0xe0e99cd9, 0x1e88ce26, 0x76445663, 0xf832c835, 0xd74d6fd4 }, 24 },
-	{ {0x2a0d228a, 0xfde36ac7, 0xc5d3c2aa, 0xc9c7c664, 0xdd071a8c }, 57 },
-	{ {0xbb59c849, 0x898d46a2, 0x3fdbd0cc, 0x04ab3508, 0x8e74a18d }, 57 },
-	{ {0xe90f80a6, 0x1d94c617, 0x850c415e, 0x12ad70ac, 0x41e66bb7 }, 1 },
-	{ {0x1ef3956f, 0x7f918873, 0xfb9b0313, 0x39bba45d, 0x1e5e5878 }, 42 },
-	{ {0x6e89f191, 0x79ccfeb8, 0x24bb12a6, 0xf512b9d0, 0x7d0b8534 }, 143 },
-	{ {0x0527fb75, 0x775caa76, 0xc7eca8d4, 0x49938ace, 0x83d36e96 }, 143 },
-	{ {0x4880bf34, 0xf1c86fff, 0x5456ec2b, 0x4cf70d02, 0x339e2caa }, 143 },
+	{ {0xe0fd133e, 0xb7f64523, 0x8b3ec546, 0x624c2d12, 0xb8a913f9 }, 19 },
+	{ {0xe11afc03, 0xdb4e1d03, 0x976d0279, 0x6b29da9c, 0x65d4ff3d }, 5 },
+	{ {0xe1497038, 0x7aa89272, 0x56397cd3, 0x5fd8c356, 0xa0502143 }, 19 },
+	{ {0xe1527ae1, 0x6d33a09d, 0x9cf3d4ea, 0x52e63337, 0xd2273910 }, 19 },
+	{ {0xe168d460, 0xc2acc0f2, 0x5523e2b9, 0x9861d187, 0xd1aaac00 }, 39 },
+	{ {0xe16ad038, 0x563724ff, 0xbba980a2, 0x96ef624c, 0x0826bbb3 }, 19 },
+	{ {0xe171d0ce, 0xc1d32aaf, 0x084e3c81, 0x50705c17, 0x7522cbe6 }, 17 },
+	{ {0xe178917d, 0x1974ac85, 0xfd58cb93, 0xb936eb9a, 0x6f44ba0d }, 4 },
+	{ {0xe194d290, 0xebfa4595, 0xce0349ea, 0x2fc15442, 0x508485b0 }, 42 },
+	{ {0xe19cfcbe, 0x92ec3682, 0xbee869df, 0xad5f6b40, 0x58b1f2ce }, 5 },
+	{ {0xe1c0aaf5, 0x3501aff4, 0x07c49b53, 0x32c7b5e3, 0x977317c3 }, 19 },
+	{ {0xe1c7169b, 0xd44a3c67, 0xf2941a14, 0x699b954d, 0x7e337d29 }, 56 },
+	{ {0xe22a6317, 0x74790347, 0x5095008d, 0x0d5ad942, 0x7ddb34af }, 3 },
+	{ {0xe2340608, 0x00fdcca4, 0x1eb3f701, 0x9edd21c2, 0x8c9ce223 }, 19 },
+	{ {0xe243cb1c, 0xb7d7a8c4, 0x4d68f1a2, 0xe2be34a2, 0xe6ab220b }, 19 },
+	{ {0xe2abb08a, 0xbacce577, 0x03fc0088, 0x81279890, 0x328f6277 }, 19 },
+	{ {0xe2ef32f2, 0xfc312f96, 0xb8424569, 0xe9e85a6e, 0xa3b21ce4 }, 19 },
+	{ {0xe2fbd56e, 0x42da6376, 0x09d23ae9, 0xdf9efd1b, 0x4241b18a }, 1 },
+	{ {0xe3036a7b, 0xc6ed3ece, 0x1c85d5e3, 0x7fb2ff39, 0xba98ba47 }, 5 },
+	{ {0xe31ac652, 0x0e912c27, 0xce96431a, 0x1dfb112b, 0xf71cb7b9 }, 4 },
+	{ {0xe32d7334, 0xace26a57, 0x0a08fe7c, 0x01ad01a2, 0xc08b1991 }, 5 },
+	{ {0xe3391daa, 0xb17710b3, 0xf34c70f6, 0x0ac6c8bf, 0xea15b6cc }, 19 },
+	{ {0xe3416103, 0x4364ef03, 0xdf907d62, 0x976c2ac8, 0xf551404f }, 19 },
+	{ {0xe348e62e, 0x3c4c02d8, 0x7ff2aa4d, 0x55ddebb6, 0x0c3ea507 }, 136 },
+	{ {0xe35c48aa, 0xe9aed93a, 0x114a28ee, 0x90f8f20f, 0xced3587b }, 19 },
+	{ {0xe36e16ac, 0xfdfa76fa, 0x72b218da, 0x2bebc668, 0xdb39d21e }, 6 },
+	{ {0xe373e3e9, 0xbe4f6d30, 0xd5db84b6, 0x99082c00, 0xb2021ba3 }, 19 },
+	{ {0xe37e2468, 0xfaf0e6bf, 0x3e38b3cf, 0x7e611c84, 0x6e45c5e9 }, 19 },
+	{ {0xe388e8d8, 0x546e329d, 0x2c58269d, 0x4fa02662, 0x4a640f1b }, 5 },
+	{ {0xe3a52d44, 0x8e69d6d1, 0x4f67d35f, 0x24d99241, 0x58b1cce1 }, 19 },
+	{ {0xe3ac6a3a, 0xb223f544, 0x0bca5ea6, 0x96e99669, 0xdd1f626d }, 19 },
+	{ {0xe3b92412, 0x91b5f19a, 0xb2397263, 0x60258a31, 0xe02565a3 }, 136 },
+	{ {0xe3ce88e9, 0x5115765e, 0x31193777, 0xe57fcb9b, 0x40e10d3a }, 19 },
+	{ {0xe4401a78, 0x869ffa87, 0x9a55f239, 0xe5da4990, 0xcb6797a6 }, 3 },
+	{ {0xe49f66e8, 0xba45d064, 0x7c93a57b, 0xbc1fb7ab, 0xa4665a6e }, 19 },
+	{ {0xe4c8f3b8, 0x7d755c21, 0x572040c5, 0x1cec1431, 0xae59a0be }, 42 },
+	{ {0xe4d61ee7, 0x4867066b, 0x04b0f6ab, 0xa35d98d7, 0x2665e6e0 }, 19 },
+	{ {0xe4f7a94d, 0x0cb43f56, 0xf73d54c2, 0x2364e914, 0x34363945 }, 19 },
+	{ {0xe5171c36, 0x8883de03, 0xfc8d75e6, 0x1bf23d95, 0x4ec1bba4 }, 19 },
+	{ {0xe5480a5a, 0x41ce4b8b, 0x0706632e, 0xa92d2901, 0x8416dd73 }, 19 },
+	{ {0xe568e345, 0x5c14cab8, 0x992b58c2, 0x849a745e, 0xf5b19b21 }, 19 },
+	{ {0xe58c1dd4, 0x6067e2ab, 0xaaf3ee6a, 0x70a7e554, 0x1a32017e }, 17 },
+	{ {0xe59d739e, 0xcd56a11e, 0xcf402043, 0x0585ea4c, 0xc61b02a6 }, 19 },
+	{ {0xe5de6e75, 0xab06822a, 0xa10263e9, 0x71b2473a, 0x3b573124 }, 19 },
+	{ {0xe5f138be, 0x98b4ff18, 0xe8bc3baf, 0xbdbb65f4, 0xfdbc378b }, 19 },
+	{ {0xe60e2abf, 0x907b66f5, 0xb275c7b7, 0xb710439a, 0xdae58d37 }, 19 },
+	{ {0xe61f407e, 0x51ea4411, 0x145e2362, 0x72842bdb, 0x3e0743e6 }, 19 },
+	{ {0xe62f5f66, 0x8ea615b6, 0xec24ab5a, 0x593aad5b, 0x3bf61558 }, 19 },
+	{ {0xe6419519, 0xc2d3247e, 0xa395e4fe, 0xaa494a2e, 0x23e469ce }, 8 },
+	{ {0xe679da4a, 0xf05aa328, 0x43d2f451, 0x8b9ceb0d, 0xf63df990 }, 19 },
+	{ {0xe6a0d6c4, 0x0419647e, 0x6b17d30a, 0x000331a9, 0x04c8f5df }, 19 },
+	{ {0xe6a1d90a, 0x7a8b4e4b, 0x8a8e1afb, 0x3d971866, 0x931b986d }, 19 },
+	{ {0xe6af71c9, 0x9290b6ff, 0x2da9d366, 0x7e204665, 0x1e2c9fca }, 19 },
+	{ {0xe6b71484, 0xd5ab578f, 0xd3695917, 0xfce3c1e8, 0x05a5b536 }, 19 },
+	{ {0xe6ba4960, 0x3707c929, 0x291c39fb, 0xdf866474, 0xbf096316 }, 19 },
+	{ {0xe6ba7a6e, 0xcda80a1c, 0x844542be, 0x0b2a44a4, 0xa33dc113 }, 17 },
+	{ {0xe6c01bd9, 0x0cf0b279, 0x3282fc53, 0xe9a3150a, 0x6d7804c5 }, 6 },
+	{ {0xe6dba66c, 0x8716593b, 0x8ab88f79, 0xf7205211, 0x938d1598 }, 1 },
+	{ {0xe6de8bbd, 0x60123444, 0xde2a9092, 0x8853985c, 0xeb0b4cbf }, 38 },
+	{ {0xe6fbfb4b, 0x10dc3939, 0x53211dda, 0x4b114080, 0xa08302a1 }, 109 },
+	{ {0xe700493e, 0x1c4c14f7, 0x11e9c1c2, 0x62fe3e8d, 0x76931ca3 }, 19 },
+	{ {0xe7273fea, 0xa30b6769, 0x41b25061, 0xef0631ec, 0x09ccdb7c }, 4 },
+	{ {0xe7324782, 0xc7bec087, 0x10531227, 0x50439849, 0x07cbfe1f }, 19 },
+	{ {0xe7351ef9, 0x606bd6d5, 0xf38acb7c, 0x17aed8a0, 0x0170b85d }, 5 },
+	{ {0xe738a8e4, 0xe09b5081, 0x67b552e9, 0xe4350c04, 0x1ca68c20 }, 19 },
+	{ {0xe73946f1, 0xf26589d7, 0x7926276c, 0xa4f9dbee, 0x60c53fde }, 5 },
+	{ {0xe7396ad7, 0x00f7edf9, 0x8cc2b0ec, 0x2e6127a6, 0x8d3cd9ba }, 19 },
+	{ {0xe73a449e, 0x34652c18, 0xaf0a72ab, 0x5c3637af, 0xa57d5842 }, 19 },
+	{ {0xe73fb565, 0x55a72327, 0x58d4b5bf, 0x2dd6736c, 0x9b3d5358 }, 39 },
+	{ {0xe7657d80, 0x70399d8e, 0x4d65308b, 0x356e110d, 0x83d23151 }, 19 },
+	{ {0xe767c023, 0x9b798214, 0x63fa42f2, 0xc1989d3f, 0xd1b4b868 }, 19 },
 	{ {0xe779c338, 0xeb91a7de, 0xa3ff75f3, 0xfde76b8a, 0xf22c4a3a }, 68 },
-	{ {0x6306ca2b, 0xc9fdd3be, 0xcf13e51a, 0x921ea6d3, 0x93f571ae }, 68 },
-	{ {0x6aea1aef, 0x5ec31c18, 0x26c22edf, 0x580525f9, 0x3baad425 }, 78 },
-	{ {0xb4433a39, 0x75c57dd4, 0x40d6bf12, 0xdbd28b2a, 0xc1b90ef4 }, 42 },
-	{ {0x242e73d8, 0x284a012b, 0x275c0a26, 0x6844ebbc, 0x4269d787 }, 141 },
-	{ {0x018d7a52, 0x22f28514, 0x908fb1b1, 0x513286a6, 0x558a6d05 }, 141 },
-	{ {0x5b39c1cc, 0xd3a213b7, 0x8e02927f, 0x56a9abc7, 0x2cd8c28d }, 141 },
-	{ {0x5aff2d9b, 0x6efc723b, 0xc395b0f9, 0x6f0adfa8, 0x3cc54a49 }, 24 },
-	{ {0xd3a71b31, 0x810614c6, 0x762a9bca, 0xafda00a6, 0xdef043b8 }, 143 },
-	{ {0xded7907e, 0xd2894200, 0x806319a9, 0xcf7b13c7, 0xcf0d88d9 }, 143 },
-	{ {0x84a44ecf, 0x6f2dcfc1, 0x102f43ec, 0x7f6ddf68, 0x7a44aadf }, 143 },
-	{ {0x5d218665, 0x8adcf4ce, 0x0c2d3232, 0x384b5712, 0x341108e5 }, 143 },
-	{ {0xd1b20d78, 0x340d85fe, 0x7786d5f6, 0xc7156fa7, 0x01aaeca1 }, 143 },
-	{ {0xff3c2311, 0xbdeec5a2, 0x57877e68, 0xce020c69, 0xdcefe55a }, 143 },
-	{ {0xc212b11f, 0xda13f83d, 0xafed688c, 0x54d098e7, 0xe47ab225 }, 27 },
-	{ {0x4b84465c, 0x2faa802b, 0xfd5f7721, 0x18c4d31f, 0x993f29d0 }, 27 },
-	{ {0xfef04a6e, 0x1b3a49bc, 0xc130969c, 0x062f6551, 0xecd5feaf }, 27 },
-	{ {0xe002a9b4, 0x26732e6c, 0x2d31e548, 0xc40cf7c1, 0x22348ce3 }, 78 },
-	{ {0xcb06dea7, 0xb025745f, 0x9d2b87dc, 0xf03ded61, 0x5287ead3 }, 42 },
+	{ {0xe78511a2, 0xb8cca37a, 0x96aa396c, 0x938863c9, 0x2a20c797 }, 4 },
+	{ {0xe7905d16, 0xd2ccd57a, 0x013c122d, 0xc432106c, 0xd59ef52c }, 1 },
+	{ {0xe7af2142, 0x4b222331, 0x88335fa8, 0x2e212438, 0x054ae377 }, 19 },
+	{ {0xe7b8574a, 0x42b10295, 0x39632ce0, 0xf5161b1c, 0x38d5e95f }, 3 },
+	{ {0xe7c800fa, 0x576b3a95, 0x54836aa9, 0xc5eaa3ae, 0x893805d4 }, 19 },
+	{ {0xe7d06c0a, 0x5c7f256c, 0x061e5b81, 0x73fdcc14, 0x5d2fc4d6 }, 19 },
+	{ {0xe7d9d1e4, 0xdcf48779, 0xdab41eb6, 0xc15478f9, 0x34bd8bc1 }, 19 },
+	{ {0xe817ab7b, 0x50674c41, 0x4b1c1b72, 0x530024eb, 0x03396a41 }, 19 },
+	{ {0xe82bbd2d, 0x9dbbb30a, 0x2b4a2599, 0x54c5484f, 0xa236733a }, 19 },
+	{ {0xe839f3ac, 0x7d52c427, 0xecc011d0, 0x1e6e241f, 0x88ca850c }, 5 },
+	{ {0xe84d3ec7, 0xa595ee36, 0xb50e9796, 0x83c84105, 0xc1871857 }, 39 },
+	{ {0xe894a38f, 0x3e2ad435, 0xcc5d17a6, 0x6600e601, 0x6b5e47fb }, 19 },
+	{ {0xe8959529, 0xa71ce9d5, 0x80766dd2, 0x074b2c17, 0xcde34c2d }, 19 },
+	{ {0xe89ea1e8, 0xe583392e, 0x2dd9debb, 0x8a4b6a16, 0x2f58ba91 }, 28 },
+	{ {0xe89fc743, 0x7d8f9aed, 0x1640689a, 0x32ebbf04, 0x7699b147 }, 5 },
+	{ {0xe8a9c605, 0xe4be1e07, 0xefc89a19, 0xd9a80f67, 0x6abdaa2f }, 65 },
+	{ {0xe8ab4678, 0x5e75e19d, 0xac497c4a, 0x82ac2f5b, 0x37ac0580 }, 6 },
+	{ {0xe8af1da8, 0x478ebfd7, 0x96b1f04a, 0x24290732, 0x59761ebb }, 19 },
+	{ {0xe8b9690a, 0xf00be945, 0x13c417d7, 0xcb780163, 0x39f6dc60 }, 19 },
+	{ {0xe8d2f130, 0xb0937d1b, 0xaced5a39, 0x96b78f16, 0x3d4fa70a }, 19 },
+	{ {0xe8d4acdc, 0x4141fb9e, 0xdaaa5c6a, 0xeb4fcf19, 0x594e3512 }, 19 },
+	{ {0xe8dd2edf, 0x5b0db48e, 0xee729988, 0x731d11b1, 0x67fe1dd3 }, 19 },
+	{ {0xe8e41697, 0x7f5dae36, 0x35362c51, 0x3bba004e, 0xa89a0bf4 }, 6 },
+	{ {0xe904efab, 0xc5a75840, 0xc50ea7ed, 0xb0705268, 0x3468a64a }, 19 },
+	{ {0xe90b579a, 0xc6479834, 0x3abb635f, 0xcbf929e8, 0x3714312a }, 19 },
+	{ {0xe90f80a6, 0x1d94c617, 0x850c415e, 0x12ad70ac, 0x41e66bb7 }, 1 },
+	{ {0xe92baa5f, 0xdfb2715e, 0x68700024, 0xd964098e, 0xf35704d9 }, 6 },
+	{ {0xe930f53b, 0xf480aba5, 0xd50d97ee, 0x7c60aad9, 0x6c000d33 }, 19 },
+	{ {0xe9398ace, 0xb9f8a648, 0xe4bcebe0, 0x2e5d7b14, 0xa3744c7d }, 19 },
+	{ {0xe93b8da1, 0xe8dddbb3, 0x742292b0, 0xe5e58731, 0xb90e9313 }, 65 },
+	{ {0xe93c3966, 0x49bf6328, 0x103e8da0, 0x247952eb, 0xef2a04e9 }, 19 },
+	{ {0xe93da3d1, 0x910d513d, 0xbb78ad59, 0x9adbb05e, 0xb92b5930 }, 19 },
+	{ {0xe94d34d1, 0x64f5379e, 0xa85464b5, 0x1743461e, 0x3f6c92ab }, 19 },
+	{ {0xe96888c9, 0x6c3044ca, 0x7ce57dbd, 0xf1744df7, 0x469f7465 }, 5 },
+	{ {0xe984bfb4, 0x251e7b9f, 0x9b6b95d5, 0xe1005e67, 0xc223ae67 }, 39 },
+	{ {0xe98e4351, 0x119d78b6, 0x402c4499, 0xed16faeb, 0x3364f6c3 }, 19 },
+	{ {0xe997d8f0, 0x2e413d2d, 0xf5aed2bf, 0x7e79986c, 0x4c851d34 }, 19 },
+	{ {0xe998f0c4, 0x41f4f180, 0x0ef44e42, 0xcd165915, 0x0206cf79 }, 1 },
+	{ {0xe9b36524, 0x82a5b09a, 0xe662203f, 0x8758a30a, 0xa23af62f }, 19 },
+	{ {0xe9b5b79f, 0x434b1c5b, 0xdb47f3ff, 0xece3ad42, 0xe489e20b }, 56 },
+	{ {0xe9c35caa, 0x8544f81d, 0x927cb610, 0xe850085e, 0x5d81ceca }, 19 },
+	{ {0xe9ca3d6a, 0x21092ec8, 0xd6933279, 0xdc6c96f3, 0x927f3b15 }, 19 },
+	{ {0xe9d7d74f, 0x71daeff1, 0x73f9979c, 0xc51c0c4d, 0x4424bac2 }, 1 },
+	{ {0xe9e778c3, 0xd103cc8c, 0x32093cd6, 0x880fa8d7, 0x238bbd9e }, 3 },
+	{ {0xea0824ea, 0x0692d2cd, 0xff816a2b, 0x3c3eb9a5, 0x87a5f536 }, 3 },
+	{ {0xea151b44, 0x3c27b77a, 0xc43fdae9, 0x9db3adb0, 0xabf43fbb }, 19 },
+	{ {0xea35cc2c, 0xad9cfdf5, 0x6cae224d, 0x8ee41579, 0xde37f000 }, 42 },
+	{ {0xea4a723c, 0xf098be7d, 0x7b40f23a, 0x7ab831cf, 0x5e2190d7 }, 1 },
+	{ {0xea62733c, 0xe2a8cd17, 0xff665225, 0x1d6879c1, 0x3fe6377a }, 19 },
+	{ {0xea6a82cf, 0x8c6e65eb, 0x30b98755, 0xc8577cde, 0x8d9186c0 }, 1 },
+	{ {0xea774f43, 0xf9c02064, 0xfcc07d51, 0x31691f5b, 0xd4e9c4f5 }, 39 },
+	{ {0xea8d86ac, 0x74dcdca1, 0xc72daae5, 0x17722431, 0x767c5ad2 }, 19 },
+	{ {0xeaa6b787, 0x784bae1c, 0x7f648b57, 0xdaa1c88c, 0xf2b1b095 }, 19 },
+	{ {0xead69958, 0x2641d103, 0xa94775a0, 0x8121ecc3, 0x36b99eae }, 8 },
+	{ {0xeade20a0, 0x145afd47, 0xec355182, 0x5e9994fa, 0x29e17e22 }, 19 },
+	{ {0xeadf124b, 0x91b996b8, 0x90b1ae84, 0xb75b21ee, 0x6568d1f3 }, 19 },
+	{ {0xeafd8cf8, 0x6facdeb0, 0x38e87900, 0xde4f1233, 0xdd69347c }, 19 },
+	{ {0xeb284ea9, 0x205f3889, 0x8feff96f, 0x85e8cf17, 0x207e2c4d }, 135 },
+	{ {0xeb58b57f, 0x468e12c4, 0x300d3a88, 0x337e6c45, 0xe532c7d3 }, 4 },
+	{ {0xeb5ed1fd, 0x10bbdd68, 0x53f595f7, 0x48f92841, 0xde3f55f9 }, 19 },
+	{ {0xebb46dd4, 0xcf36407a, 0xd82d9f50, 0xd9bef3e9, 0x38dc144e }, 19 },
+	{ {0xebb70722, 0xf7527991, 0x1cce79e6, 0xbd78b8f5, 0x14561b0f }, 19 },
+	{ {0xebb76f90, 0x61e87536, 0x50235236, 0x07db610f, 0x2eda1d26 }, 1 },
+	{ {0xebb7eb54, 0x0a390509, 0xedfd36c8, 0x4288ba85, 0xe63f2d1f }, 1 },
+	{ {0xebceb3de, 0x22e4c044, 0x4a969d83, 0xee487f8e, 0xe34204e4 }, 6 },
+	{ {0xebd1f02f, 0xa4e5f165, 0xd756ab78, 0x864f8820, 0x22ede844 }, 42 },
+	{ {0xebde4d61, 0x18443817, 0x5db424fd, 0xf25cec23, 0x8d91a15f }, 19 },
+	{ {0xebe20c85, 0xc5314957, 0xfafc223c, 0x26bf3938, 0x47e3bb03 }, 6 },
+	{ {0xebed1926, 0x9b7625c9, 0x3eccefc2, 0xbd758555, 0xe2027431 }, 17 },
+	{ {0xebf474cf, 0x35a56e03, 0x771d0b17, 0x548b59fe, 0xb2df0656 }, 19 },
+	{ {0xebff5d2b, 0x4253f62d, 0x3a00f1a6, 0xd6b4d810, 0x53c7b8a6 }, 19 },
+	{ {0xec0320ed, 0xa10bf6bb, 0xee8081f6, 0x672a7bf9, 0xd858c1bb }, 19 },
+	{ {0xec1bb5c3, 0x6952b12e, 0x6c0805e9, 0xa8d5bf31, 0xc20a68c4 }, 5 },
+	{ {0xec2f1e74, 0x7756ba1f, 0xdae60665, 0x8aeeafa0, 0x7e6e7fd4 }, 19 },
+	{ {0xec5111e3, 0xb06d64ef, 0x51196ff8, 0x7448e1c6, 0x2be4cdd8 }, 19 },
+	{ {0xec53d72e, 0x41e11457, 0x4f4c116c, 0xab19e163, 0x3f3da207 }, 42 },
+	{ {0xec54e05a, 0x6f784f9c, 0x616c94ab, 0x8d57e5d2, 0x647abc66 }, 19 },
+	{ {0xec76d4d9, 0xb61bdbde, 0x9a4b5be0, 0x82dbdae9, 0x6321a591 }, 19 },
+	{ {0xeca36fe8, 0x0a916eb6, 0xb196ec56, 0xedfc1296, 0xd793e350 }, 4 },
+	{ {0xecb53823, 0x8fc7c5e3, 0x74d723f4, 0xd6120d1b, 0x2ef5d80e }, 5 },
+	{ {0xecbf33a3, 0x76a7a108, 0x176f8d10, 0x09d042e0, 0x1519241c }, 5 },
+	{ {0xecc68b4a, 0x04279442, 0x4df771a3, 0x336361fd, 0xb50d0875 }, 19 },
+	{ {0xece128e7, 0x1c14cacd, 0xe1c58f61, 0xc51a86d9, 0x86789c3e }, 39 },
+	{ {0xed15174d, 0xec31a29f, 0x9d41a06d, 0xe3008db0, 0x4af11a25 }, 19 },
+	{ {0xed1f7342, 0xb9b26ec0, 0x2ca2d584, 0x570d75f9, 0x25167ea1 }, 19 },
+	{ {0xed2fea5c, 0x2a3c2e58, 0xd4f69f9d, 0x636e0857, 0x4486a2b1 }, 42 },
+	{ {0xed547caf, 0x3e45f621, 0xb588cb1f, 0xa91008c9, 0xc1bc9ed7 }, 19 },
+	{ {0xed798b8e, 0xe852611a, 0x0e4d054b, 0xf31652ef, 0x3f73e67f }, 19 },
+	{ {0xed97f51e, 0xef9192ec, 0x7f905f2b, 0xa4aabf6a, 0xcc513587 }, 19 },
+	{ {0xeda9580a, 0x1ac75707, 0xf621c251, 0xa7424df3, 0x846e4ec0 }, 19 },
+	{ {0xedc238c1, 0xeb254cbf, 0x90f1dfdc, 0x276ff7cc, 0xc93a940e }, 3 },
+	{ {0xedd109e4, 0xb518c41e, 0xb30a2b6f, 0x2a492598, 0xc9a08008 }, 51 },
+	{ {0xedd61208, 0xe11149e2, 0x26cd2edd, 0xf5c9eca8, 0xee1ba33e }, 19 },
+	{ {0xedff8461, 0xc6b88028, 0x31a59f82, 0xcdf0fa37, 0x35921c00 }, 19 },
+	{ {0xee095ee6, 0x361f0a76, 0x7250fe19, 0xc9bc805b, 0xba8da4e9 }, 4 },
+	{ {0xee267ee2, 0x1f575313, 0x0af66543, 0x5d4e1ce8, 0x4a6256f1 }, 55 },
+	{ {0xee3ca231, 0x328534bb, 0xa92f9a90, 0x8c4faed8, 0x65bcea68 }, 19 },
+	{ {0xee501fde, 0x62b25ddd, 0x1c82798e, 0xe1b233b8, 0x813e717b }, 5 },
+	{ {0xee533b8e, 0x4bdd6cdf, 0x2c273f7c, 0x80753cf8, 0xdb60f545 }, 17 },
+	{ {0xee60e88a, 0xe409ddd9, 0x3d4259b7, 0x9586dacb, 0x2e5ee372 }, 5 },
+	{ {0xee66334f, 0xbac1c926, 0xed05c1c3, 0xf38df392, 0x0f501fe6 }, 3 },
+	{ {0xee7dbd36, 0xa2b0bbae, 0x11c68ac4, 0xde75077f, 0x283bed05 }, 19 },
+	{ {0xeeb810dd, 0x36b512e8, 0xcc842be6, 0xa22ddf33, 0x80088a56 }, 19 },
+	{ {0xeebfb48d, 0x0fd8fe5a, 0x7f370195, 0xa2b4a76b, 0x51b89dc8 }, 19 },
+	{ {0xeed68d25, 0x4a17d76c, 0x36e094dd, 0x8a50a362, 0xa964e1b7 }, 19 },
+	{ {0xef3e010e, 0xb57e4476, 0x700a3bbf, 0xf9d2119a, 0xb3acdf62 }, 1 },
+	{ {0xef42e667, 0x558979b4, 0x4785a0f0, 0xd87d9d6a, 0xefc96b4d }, 19 },
+	{ {0xef476e25, 0xfb6b7221, 0xca778a37, 0x91178854, 0x50dd36f0 }, 19 },
+	{ {0xef535ab6, 0x013d9b6e, 0x38227272, 0xf2ebe6a0, 0xf0b33cb5 }, 19 },
+	{ {0xef6c6cde, 0x14eb551b, 0x74640ed6, 0xb3866057, 0x2f121b86 }, 41 },
+	{ {0xefdf63f0, 0x1293251d, 0xc593163a, 0x42f31556, 0xfd042282 }, 5 },
+	{ {0xefe44e5f, 0x4593036a, 0x6c003586, 0x38462a93, 0x3d16b979 }, 19 },
+	{ {0xefed4885, 0x4beb2803, 0xd9f2b564, 0x4edff2aa, 0xcf7c6af9 }, 5 },
+	{ {0xf01f75f8, 0x14447316, 0xffe25ce9, 0xfc0928de, 0x8622c850 }, 19 },
+	{ {0xf02281aa, 0x13cb34d2, 0xf10add30, 0x1529b95a, 0xdff7f768 }, 7 },
+	{ {0xf025c9c2, 0xdb97dce6, 0x08fcc105, 0x0426beff, 0x0dea43eb }, 19 },
+	{ {0xf02ca47b, 0xe665e83d, 0x812979d8, 0x074a985e, 0x5637b979 }, 19 },
+	{ {0xf033ab8a, 0x33e2d7a8, 0xac1313b8, 0x62bc1381, 0x38b4346e }, 19 },
+	{ {0xf04f5c69, 0x36301eed, 0x31a79c23, 0x571f8fc4, 0x97864dbb }, 4 },
 	{ {0xf078b5ec, 0x56884bfb, 0x81481d45, 0xc7151418, 0x770bff5a }, 141 },
-	{ {0x373412f9, 0xc32762de, 0x1c3a7e27, 0xfc3d8061, 0x4e0a0c8e }, 141 },
-	{ {0x7ed7c55e, 0x0359737a, 0xc5e68d38, 0xcb6903f9, 0xe5d7c2b6 }, 57 },
-	{ {0xb7068e2a, 0xab020728, 0x52ca2495, 0x96b7550a, 0xc632c4c2 }, 57 },
-	{ {0x3330d9b6, 0xb76e3c4c, 0xcb7cf252, 0x496ed15d, 0x08b95d3f }, 142 },
-	{ {0xf4433752, 0xd3bf876b, 0xfefb363c, 0x749d4d2e, 0x08a218b6 }, 1 },
-	{ {0xdcc3a677, 0x32aa01c4, 0xf2ee8d1a, 0xd886444a, 0x4dbafe06 }, 42 },
-	{ {0xd37ab4bd, 0x2bfddd8c, 0x97476cbe, 0x7347ae58, 0x1a6f2972 }, 142 },
-	{ {0x8e0d4a77, 0xe7d5736e, 0x8225c2df, 0x47015093, 0x63eb230f }, 142 },
-	{ {0x400fe724, 0xbddb6a1e, 0x6c28fd18, 0x15820cb7, 0x64ef9e95 }, 50 },
-	{ {0x8be69f0f, 0x6cdd10b2, 0x1bfbb315, 0xe689adc4, 0xb35ba150 }, 50 },
-	{ {0x930eae70, 0x57af1652, 0xabae7940, 0x72b296a5, 0x9decd61b }, 50 },
-	{ {0x4061c461, 0xfa9ff21a, 0x6c0e46b3, 0xa71607e3, 0x32d80ba3 }, 50 },
-	{ {0x8e3f6f08, 0x309f082a, 0x82be8298, 0xa66c9b90, 0xf2d34ad4 }, 57 },
-	{ {0x24f36e4d, 0x879f6492, 0xfbf0cb5a, 0x3b141a18, 0xdc4938ad }, 57 },
-	{ {0x74ead27e, 0xec8d8761, 0x44c2a015, 0xc0260d6d, 0xb2117d72 }, 57 },
-	{ {0x22fab445, 0x9e8afc4f, 0x88605506, 0x50e8ff08, 0x3f3ad92a }, 57 },
-	{ {0x15b83242, 0x8c4648e4, 0xdaadd05e, 0xec12f615, 0x072cc839 }, 31 },
-	{ {0x06fb8b9a, 0x0304037a, 0xe0e4196c, 0xa88cddf5, 0xaffd4c5f }, 31 },
-	{ {0x13007f93, 0x40670ded, 0xa42c4b53, 0xc06c19d3, 0xd3c09704 }, 27 },
-	{ {0x7cc524ba, 0x5002b92f, 0xb285ac86, 0xeaae8fde, 0x16ee027e }, 1 },
-	{ {0x032cb1c1, 0xc75b9a19, 0x1fa12309, 0x78971698, 0xd9d2a17f }, 21 },
-	{ {0x308f6593, 0x073a5211, 0xc73ea3e0, 0x0da3bae6, 0x6a44031a }, 21 },
-	{ {0x21329398, 0xc0f350e3, 0x30b353f4, 0x5f21aa7b, 0xa338fc8d }, 1 },
 	{ {0xf081a884, 0x505af9a1, 0x080b2b57, 0xe86b6da9, 0x3b784301 }, 42 },
+	{ {0xf08c91f8, 0xc78d681e, 0x1f02eaaa, 0xaafb87ad, 0x81112b60 }, 42 },
+	{ {0xf0b65b71, 0xc505c680, 0x19e2285d, 0x3b8afcf0, 0x68a74b9f }, 19 },
+	{ {0xf0bacc79, 0x8b381e6f, 0x7c6b27e0, 0xfcbe3065, 0xa2c80d65 }, 19 },
+	{ {0xf0be97ce, 0xca47b65b, 0x46c9518e, 0x6157b295, 0xf8c99c38 }, 3 },
+	{ {0xf0d74d95, 0x1a3781c7, 0xa2680e1d, 0x7ab809d2, 0xafe1fd18 }, 19 },
+	{ {0xf0e4168e, 0xa18188fc, 0xa2581526, 0xc2503223, 0xb9a28581 }, 4 },
+	{ {0xf0fee046, 0x198a076e, 0x664811f4, 0xe3a788d5, 0xf0b47183 }, 3 },
+	{ {0xf100a761, 0x17e95ab0, 0x335e89a9, 0x01e47d84, 0x4bbc0ab6 }, 5 },
+	{ {0xf12ad34d, 0xc3b4279d, 0xa0fc7094, 0xf3d50d6b, 0x8bb517dc }, 5 },
+	{ {0xf1525de4, 0xe0b60a66, 0x87156c2a, 0x96f8a8b2, 0x044b6c56 }, 64 },
+	{ {0xf182d478, 0x5e3eed00, 0x292f7ff4, 0x795c9dcc, 0x6c990a0a }, 5 },
+	{ {0xf19712f0, 0xda98b542, 0x3ebec315, 0x0f5741df, 0xa25acf85 }, 19 },
+	{ {0xf1b4603c, 0x672f52a9, 0x2a93b4cd, 0x5e861a3c, 0x2f6230b7 }, 63 },
+	{ {0xf1d68b47, 0x7f3f54c0, 0xb6080985, 0x954208b0, 0xd95c5973 }, 19 },
+	{ {0xf1de76df, 0xcd8c4e35, 0x4a8a8058, 0xa7619116, 0x7fd112e3 }, 3 },
+	{ {0xf1f571c1, 0xd9360839, 0x450c26d7, 0x3c6aef89, 0xe1e052eb }, 19 },
+	{ {0xf2361230, 0x358bd945, 0x690ca1c2, 0xa9dcc1cb, 0xce83941b }, 6 },
+	{ {0xf236345f, 0x43828597, 0x739f4a32, 0x6318b6a3, 0x876ff73f }, 19 },
+	{ {0xf25628e4, 0x74035e6b, 0xf0440b27, 0x4c5df04f, 0x94c49fb8 }, 5 },
+	{ {0xf25c4168, 0x69372ac0, 0x7abefad1, 0x31fc732d, 0xfbe33a45 }, 61 },
+	{ {0xf27721cf, 0x9ec316ea, 0x3b18233f, 0x699febf7, 0x39b25678 }, 19 },
+	{ {0xf2854b71, 0x98f32569, 0x1a5ad312, 0x9bd05b44, 0xd6120771 }, 55 },
+	{ {0xf28c23c8, 0xcf65ac80, 0xd2a89272, 0x5164aa80, 0xc2cabcb5 }, 65 },
+	{ {0xf294becf, 0x726a704c, 0xed1d7214, 0xf1c2b1ed, 0xc77b6bf0 }, 19 },
+	{ {0xf29cac37, 0xc5001ddc, 0x752ff4a0, 0xb9cc51a9, 0x65906da8 }, 19 },
+	{ {0xf2ac1ce7, 0x584297bb, 0x646caec3, 0xfe4f0384, 0xed5b072f }, 19 },
+	{ {0xf2b5b902, 0x9575b85f, 0x0730914a, 0x44e57f94, 0xc9313df5 }, 19 },
+	{ {0xf2d1a057, 0x940b44c0, 0x4ba08f4f, 0xf2767eef, 0x8b515833 }, 19 },
+	{ {0xf2ec3714, 0x13817521, 0x2b6b6e28, 0xb5da4361, 0xcc4b5471 }, 19 },
+	{ {0xf2eef740, 0x2d2e6e7f, 0x7c15a1f3, 0xd8bd2516, 0x03eabf12 }, 3 },
+	{ {0xf3306e6f, 0x25d111da, 0x21ce66db, 0x3404f5f4, 0x8acb25a1 }, 5 },
+	{ {0xf332df80, 0x4849c7a1, 0x2f50dbbd, 0xbbb37949, 0x716b3671 }, 19 },
+	{ {0xf3434cae, 0x8631f2f9, 0x068b3624, 0xbfd1ed8b, 0xa4292370 }, 19 },
+	{ {0xf35a3f1f, 0x09b01895, 0x7696e015, 0xb20dc1d1, 0x2d3ccc2e }, 39 },
+	{ {0xf364a44d, 0x0b4ceaaa, 0x87068302, 0x37c0b824, 0xdcf9ce0c }, 19 },
+	{ {0xf36af9ea, 0x08780ebf, 0xb194337c, 0xcc869aeb, 0xab65ac66 }, 19 },
+	{ {0xf373723b, 0x18cb7534, 0xba1e8de6, 0x1d484800, 0x478ee604 }, 19 },
+	{ {0xf3815211, 0xc6183b4f, 0x9c26b9e7, 0xd0a12c3b, 0x3870bdda }, 19 },
+	{ {0xf3952b79, 0x0ae2a8a1, 0x434b52bf, 0x816c56c9, 0xe680f73e }, 19 },
+	{ {0xf3c0c1f0, 0xec3e10cd, 0x4a5eaae2, 0x6d593198, 0xb1a5ab9a }, 19 },
+	{ {0xf3dd9797, 0x06fa466e, 0x2a34bbb8, 0x729cf1bc, 0x7c298864 }, 1 },
+	{ {0xf415e409, 0x6ff3f6a9, 0xf17bfbf0, 0x2f146e44, 0xf0d5fb66 }, 19 },
+	{ {0xf416b424, 0xfb913ca0, 0x67fe7527, 0x9c924a20, 0xfac5c6a1 }, 5 },
+	{ {0xf4433752, 0xd3bf876b, 0xfefb363c, 0x749d4d2e, 0x08a218b6 }, 1 },
+	{ {0xf448289d, 0xb0d5c8fe, 0x6c4b3ca8, 0x63af73db, 0x3c4a5e45 }, 19 },
+	{ {0xf4a1e82c, 0x533677ed, 0x9923b11a, 0x0b970264, 0xd9ecf8ca }, 4 },
+	{ {0xf4b58fec, 0xbcbc8cd3, 0x07c34806, 0xecece2a2, 0x04c26c65 }, 19 },
+	{ {0xf4d4d132, 0x866707e7, 0xf8a97408, 0xb093acab, 0xb67ef5aa }, 19 },
+	{ {0xf4da2be2, 0xee712ba2, 0xe7cccf56, 0xfcd15483, 0xfe0023ed }, 6 },
+	{ {0xf4dba5ba, 0x267b5dd1, 0xa35eb74a, 0x6ec4fd4d, 0x5ca9a1b4 }, 6 },
+	{ {0xf4f7c789, 0xdd320192, 0xfd544c66, 0x6ceab720, 0xc7f3a747 }, 6 },
+	{ {0xf5009c44, 0xba1e72b6, 0x4e29fc73, 0x4741d518, 0xb4167aea }, 4 },
+	{ {0xf50d0c66, 0xb08c47b5, 0x99259522, 0x76243e20, 0x08668185 }, 5 },
+	{ {0xf51f9368, 0x87498d21, 0xf6ee9fe8, 0xa7701633, 0xbe67e79d }, 19 },
+	{ {0xf52113b4, 0x5062adc7, 0x5cf7a0ed, 0x0538b3a0, 0x7696cc24 }, 19 },
+	{ {0xf5269015, 0x7a51c662, 0xffdf4ae3, 0x592ada93, 0xd7be4032 }, 5 },
+	{ {0xf53bdd84, 0x7d0097fd, 0x4ca47dab, 0x03157036, 0x6c882e65 }, 19 },
+	{ {0xf53fd0b5, 0x50c437d6, 0x83668376, 0x829fbd7f, 0x569f0ee5 }, 19 },
+	{ {0xf5526481, 0xe64def12, 0x9bd4109f, 0xa2074609, 0xee2e92a0 }, 19 },
+	{ {0xf5551b5c, 0x88e64509, 0x0cd9297a, 0xa1b3ca92, 0x1526a6ba }, 39 },
+	{ {0xf57b4615, 0x4cf0711e, 0x3f5218e0, 0x0f67c375, 0xd95d1d5d }, 5 },
+	{ {0xf59d3331, 0x1c95edc0, 0x168445f7, 0x4eddd8a6, 0x772aa6a0 }, 63 },
+	{ {0xf5af1d2a, 0x8bcf247f, 0x78847e1a, 0x9d995e58, 0x1df87e8e }, 1 },
+	{ {0xf5e199a5, 0xb39bad10, 0x256d8e96, 0x3f0da272, 0xad359517 }, 17 },
+	{ {0xf5e2e4aa, 0xcd44739d, 0x3a0c1ea4, 0xecb87da3, 0x85ce89dc }, 19 },
 	{ {0xf5eb0a39, 0x60975725, 0x89f2a6ef, 0xeed04504, 0x4e9425e4 }, 1 },
-	{ {0x6103b39f, 0x1e38d1aa, 0x2d84b1c3, 0x219c44f1, 0xabb5436e }, 1 },
-	{ {0xc3f3ca45, 0x4d66a0bc, 0x791f1d4b, 0x60e6857b, 0x44eb8755 }, 65 },
-	{ {0xb484c8fa, 0x4549b79c, 0xff976001, 0xac4beb19, 0xabf7cfb5 }, 65 },
-	{ {0x459f2fc5, 0x6412ad89, 0x6bb41898, 0x6d005156, 0x8d9b3b81 }, 65 },
-	{ {0xe7905d16, 0xd2ccd57a, 0x013c122d, 0xc432106c, 0xd59ef52c }, 1 },
-	{ {0x58ba1887, 0xe8fd21c9, 0x12b6859c, 0xae6514bd, 0x874ffcca }, 65 },
-	{ {0xb034764e, 0x6a8978db, 0x60b1d652, 0x917f5e24, 0xa66a7925 }, 1 },
+	{ {0xf6199f48, 0xff994fc9, 0xa8e33a85, 0x81bb3bb1, 0x6dd301ab }, 3 },
+	{ {0xf629b8f7, 0x133c3442, 0xd0371a4d, 0x84275fb2, 0xe0974854 }, 19 },
+	{ {0xf6314590, 0x061a6b44, 0xc5ed24f6, 0x0ded13d8, 0xf2f7d95b }, 19 },
+	{ {0xf63d274a, 0x8a7ad8e2, 0x85dd8800, 0x264ab9c1, 0x4aa9f870 }, 19 },
+	{ {0xf6711e1e, 0x2bac04d4, 0x5b8988f1, 0xd03529ad, 0x777abf4e }, 19 },
+	{ {0xf67ea4e2, 0xdd0356e7, 0x747b2463, 0x3dedae8c, 0x414e7e32 }, 19 },
+	{ {0xf69541b8, 0x6c2b396c, 0xdce765c2, 0xdec498e1, 0x1232b3c9 }, 19 },
+	{ {0xf6d7b12a, 0xe2d9cb0c, 0xcb75e2cb, 0x69d58a01, 0x808359bd }, 105 },
+	{ {0xf6e0dff9, 0xf8674383, 0xa866902f, 0xddb72a28, 0x0d331d9d }, 17 },
+	{ {0xf6eb3444, 0x08fbf693, 0x32fdf865, 0xa8c21345, 0x5f0a024c }, 19 },
+	{ {0xf72681f0, 0x9b52d530, 0xec905e8d, 0xf21c4a15, 0xe30201ab }, 19 },
+	{ {0xf76e7e4c, 0xcca2a77a, 0x13d9a2d5, 0x198667ba, 0x810491f9 }, 19 },
+	{ {0xf772396b, 0xecdbd15b, 0xa0648bf1, 0xaef8ccb1, 0x55e1adad }, 19 },
+	{ {0xf784350a, 0xf0c5c740, 0x7d83da2b, 0xb499c59a, 0x08496aac }, 19 },
+	{ {0xf7872715, 0x97abbcb1, 0x297e4e8a, 0x4a956195, 0x9a195649 }, 5 },
+	{ {0xf795668a, 0xfe66c7d8, 0x8e51f5a2, 0x2471e2c0, 0xa42c7ffb }, 56 },
+	{ {0xf7dd6841, 0xd280cbff, 0xa9f0f2da, 0x7af3549f, 0x23270ddb }, 5 },
+	{ {0xf8164d38, 0x72b5d54e, 0xaeafc6de, 0x3bb98a47, 0x2f0c828d }, 39 },
+	{ {0xf84d7fc0, 0x89b31440, 0xcac1f4fb, 0xee3d45b2, 0xf6c90e37 }, 6 },
+	{ {0xf858a75f, 0x0a7a12a4, 0x449a3d57, 0x5b121801, 0xace0aa42 }, 1 },
+	{ {0xf864f825, 0xb2270c3b, 0x98b3c046, 0x71a3ac5f, 0x2d95affa }, 19 },
+	{ {0xf86a7945, 0xb34c97cc, 0x58d5ee27, 0x96496887, 0x0bfcef93 }, 19 },
+	{ {0xf89e3d8f, 0x3b6855c2, 0x9d71d314, 0x9cc762e0, 0xf6918ad5 }, 139 },
+	{ {0xf8c69742, 0x60b4da94, 0x345295ee, 0xe27d97a3, 0x89abfe96 }, 19 },
+	{ {0xf8cd4c05, 0x083decfc, 0x098cff07, 0x7e055a4a, 0xe1e91a73 }, 42 },
+	{ {0xf8feeac4, 0x384bc4f1, 0x09c70f96, 0x2e15ce92, 0x5bf70c13 }, 19 },
+	{ {0xf90064fe, 0x4ffed170, 0xf9e9c791, 0x96aa0b17, 0xe0bbd86b }, 3 },
+	{ {0xf9122717, 0xf50a7a5a, 0x195d7ade, 0x2dd9bd3e, 0xa353cc1c }, 19 },
+	{ {0xf9201b7b, 0x99a6cb4d, 0x8c847e30, 0xdc2617d4, 0x243be8e7 }, 19 },
+	{ {0xf9249805, 0x11d2ea19, 0x1481c1e4, 0xff5ab7ad, 0xc3f082ab }, 4 },
+	{ {0xf924d89a, 0x28966a1d, 0x08c10d5d, 0xdbc9e0e1, 0x82be4669 }, 19 },
+	{ {0xf93e23d9, 0x58d2075b, 0xf476cb05, 0xa3c4f48d, 0x0c41aabb }, 19 },
+	{ {0xf9486dd8, 0x10d6321b, 0xad4bc9d7, 0x703a67d6, 0x30167f98 }, 5 },
+	{ {0xf979ad20, 0x850a5c16, 0x73bc2c59, 0x43f470db, 0x6925eb50 }, 24 },
+	{ {0xf993369a, 0x54244b63, 0xa11fb435, 0x9f52af19, 0x859eb38b }, 19 },
+	{ {0xf99919c8, 0xf42addb7, 0xf65ab4fb, 0x21b603ee, 0x7e716c90 }, 19 },
+	{ {0xf999e018, 0x7023413d, 0x839a6733, 0x7d0595e1, 0x50b2398f }, 5 },
+	{ {0xf9a8731b, 0x7b978b6e, 0xb5310aa9, 0xbf644fae, 0x5a9015b3 }, 19 },
+	{ {0xf9ad0cdb, 0x227c588b, 0x1a5c7522, 0x0ed53d03, 0x14550d7f }, 19 },
+	{ {0xf9c85b43, 0x4839f844, 0x072dc73a, 0xbc8d16c9, 0x30013f3f }, 19 },
+	{ {0xf9e8cc6e, 0x47d5632e, 0x3b285001, 0x97f8e918, 0x7295c52b }, 5 },
+	{ {0xf9e9a6e5, 0x17ee0b9b, 0x3147abb6, 0x144b31ed, 0x2ca8dbda }, 19 },
+	{ {0xfa29ca44, 0x86a089e3, 0x2790a69a, 0x9598b051, 0xd6b7dac4 }, 19 },
+	{ {0xfa2d5f56, 0x273a0faa, 0x5b390964, 0x48f82998, 0x655de60d }, 4 },
+	{ {0xfa4f31ba, 0x6d0d9ac8, 0x21592a8b, 0xb224dad3, 0x90fae0c4 }, 19 },
+	{ {0xfa5badc3, 0xd9486d97, 0x89b05b90, 0x9125bf74, 0x059d26e5 }, 42 },
+	{ {0xfa6a5fda, 0xcf29ef40, 0x519f69b8, 0x704dbbfb, 0x250789e7 }, 19 },
+	{ {0xfa6c059e, 0x14092d02, 0x3b1f9f2d, 0xf28e482f, 0x966287db }, 5 },
+	{ {0xfa717868, 0x6ddf5dd2, 0x898c9453, 0xd8bb2c0b, 0x83984c73 }, 19 },
+	{ {0xfa9ae320, 0x5ac5fe83, 0x04d53d94, 0xbb8b1cb3, 0x94183c3a }, 19 },
+	{ {0xfaa5aef2, 0x3febc61a, 0x875e28ee, 0xbe3aadf8, 0x3e1f5ba7 }, 19 },
+	{ {0xfaa5f0bf, 0x79fde9ce, 0x74b91a70, 0x91d20377, 0x1cae8499 }, 3 },
+	{ {0xfacb9677, 0x17c21fed, 0x9b375481, 0x908aa337, 0xb3361c45 }, 6 },
+	{ {0xfae43707, 0x2234c65b, 0xca174db9, 0xaefd2107, 0xa53c358a }, 19 },
+	{ {0xfafd58ec, 0x55b2e1e8, 0x4255036a, 0x3cdf2de8, 0x7d348942 }, 19 },
+	{ {0xfb053bec, 0xf87f12e1, 0x96e00b3e, 0x153ec802, 0x9ebf1ff8 }, 4 },
+	{ {0xfb4724b8, 0x159beae1, 0x32f89f39, 0x4f71ce39, 0x34a61ae2 }, 19 },
+	{ {0xfb51c505, 0xadfbc174, 0xdf94289f, 0xa894ef96, 0x9f5357bc }, 1 },
+	{ {0xfb837d3a, 0xa087a75c, 0x7064c080, 0x8adf9832, 0x9387cbc6 }, 19 },
+	{ {0xfb968a24, 0x07eee00c, 0x683af3ac, 0x19e88015, 0x341564ad }, 39 },
+	{ {0xfbb0dccf, 0x7da4c24a, 0xe9e2db67, 0x53092d1d, 0x03e35bef }, 1 },
+	{ {0xfbb22cea, 0x9227f6f4, 0x0080a42a, 0x1a169c07, 0x47129c95 }, 6 },
+	{ {0xfbbd9a77, 0x004f9bdb, 0xcfc292f8, 0x5c32106f, 0xaa18cfa6 }, 19 },
+	{ {0xfbe43d67, 0xa5bc0aed, 0xb2e194a4, 0xe5f9497b, 0x7488362b }, 19 },
+	{ {0xfbfdd89e, 0xc183ceae, 0x63d3d66b, 0x0ab45faa, 0x951b525a }, 38 },
+	{ {0xfc22cec0, 0x76c0a0a1, 0xee7e4107, 0x72af3d7d, 0x31de3149 }, 19 },
+	{ {0xfc2a86cd, 0x2c24e2ac, 0xce77a6d3, 0xe491821a, 0x03dccdfa }, 19 },
+	{ {0xfc327d39, 0x46366ca7, 0x5de0d061, 0x9eb0917a, 0x27e1bd61 }, 19 },
+	{ {0xfc4c05ca, 0x47c94df8, 0x77bed2e0, 0x2307bd63, 0x07f738a6 }, 19 },
+	{ {0xfc5d252a, 0x26c93dc4, 0xcc30984b, 0x954a6a51, 0x24dee653 }, 19 },
+	{ {0xfc6292d4, 0x9736e4f9, 0x86d2f44e, 0xae19a2e0, 0xe3185f45 }, 19 },
+	{ {0xfc63b9cd, 0x7d3fbf5a, 0x8309ef09, 0xbe46ed04, 0x1321e029 }, 19 },
+	{ {0xfc6660a2, 0x02dbd228, 0xc9e0d7c4, 0x04340d1d, 0xcc1e2844 }, 19 },
+	{ {0xfc71561a, 0x64f73da0, 0xe0043d25, 0x6f67fd18, 0xd7fc3a7f }, 19 },
+	{ {0xfc7212c6, 0x81357422, 0x4114c3bb, 0x5bfa9920, 0x6c0816a5 }, 19 },
+	{ {0xfc760d1d, 0x7b16370a, 0xbc7eea39, 0x955f230b, 0x95b37df6 }, 65 },
+	{ {0xfc9adbd8, 0x16109f77, 0x05f342c0, 0x1f168bb0, 0x9ca4b2ff }, 5 },
+	{ {0xfcc1cf81, 0x6657e90b, 0xb1e0a938, 0x98fd17a8, 0x325c2cd3 }, 19 },
+	{ {0xfcc6b6b9, 0xf05de409, 0x492a1fb9, 0x88fa671e, 0x46d54196 }, 19 },
+	{ {0xfcd563fe, 0x7ccb293b, 0xe1f1adb0, 0xda7d6f0d, 0xa8fc7e2e }, 56 },
+	{ {0xfcdbc5e1, 0x5dd6b973, 0xe0f1112f, 0x4599dad9, 0x85f48042 }, 17 },
+	{ {0xfd0e46e4, 0xaef2d971, 0x3d20b51d, 0x2ba57d55, 0xbde7dcee }, 3 },
+	{ {0xfd156985, 0x18172bcd, 0xe3318f08, 0xee032531, 0xcbbb9f5d }, 19 },
+	{ {0xfd1eecd9, 0xc89f4774, 0x1276433b, 0x99b75eca, 0x2930b58d }, 3 },
 	{ {0xfd4bcc81, 0xa8160a1d, 0xea06036c, 0x5f79d200, 0xf948f4d6 }, 1 },
-	{ {0x5c1f9c7f, 0xb655e43d, 0x38e5dd1f, 0xcc6b942b, 0x2ff68b02 }, 1 },
-	{ {0xc2296f08, 0xc9c5069e, 0xb5269832, 0x7ace1e22, 0x6cd3c1ff }, 65 },
-	{ {0xdab3e6f3, 0x68433926, 0x65b71b04, 0x178aadd8, 0x762c6589 }, 65 },
-	{ {0xb17d9bea, 0x0eb16a1a, 0xa2d0ccbd, 0x7c9488da, 0x9f57698e }, 1 },
-	{ {0x4ab7b203, 0x0d022f54, 0x86abaab2, 0x2aaeaf8a, 0xa23e05f3 }, 1 },
-	{ {0xd1001f93, 0xc87ff7fb, 0x389e418e, 0x33bf7bc8, 0x1bdbb65f }, 65 },
-	{ {0x42252cf8, 0x7deeb581, 0x81a7bfec, 0x7c874190, 0xa1351779 }, 1 },
-	{ {0xb01434c6, 0xbc67efef, 0xe4dce17d, 0x85283866, 0x61db92b2 }, 1 },
-	{ {0x42252cf8, 0x7deeb581, 0x81a7bfec, 0x7c874190, 0xa1351779 }, 1 },
-	{ {0xb01434c6, 0xbc67efef, 0xe4dce17d, 0x85283866, 0x61db92b2 }, 1 },
-	{ {0x898630ad, 0x1497dc9a, 0x329580c6, 0x82ee55c4, 0xbcb9c30c }, 1 },
-	{ {0x380225f8, 0xbcd65345, 0x36b41fc6, 0xf15ab80e, 0x48aa7172 }, 1 },
-	{ {0xe998f0c4, 0x41f4f180, 0x0ef44e42, 0xcd165915, 0x0206cf79 }, 1 },
-	{ {0x9eaad185, 0xefc8e224, 0x368d1db4, 0x949eb965, 0x9c26fb2c }, 1 },
-	{ {0xae4a6632, 0xd4456ef4, 0x4603e72f, 0x5acd5bbc, 0xd6c0d124 }, 1 },
-	{ {0x0de3c802, 0x05756056, 0x0a03d796, 0x5fcc4cff, 0x69f8575c }, 1 },
-	{ {0x3288894e, 0x1be6af70, 0x5871499b, 0x23c85732, 0xdbc40993 }, 1 },
-	{ {0xb43a4be5, 0xc754f68d, 0xc3ee64ee, 0xe29d64f3, 0x0fac2aff }, 65 },
-	{ {0x0f579885, 0x0d11b316, 0xa4254b22, 0x2ca08cc4, 0xad6d4da2 }, 65 },
-	{ {0x849f9386, 0x7ff7846b, 0x27f84d0b, 0xe418569f, 0xaf058ac2 }, 65 },
-	{ {0x8954e59a, 0xa79310c7, 0xb719ecf0, 0xcde1e82f, 0xb731dcd1 }, 65 },
-	{ {0x3926cdd9, 0x1fa89657, 0xa811463e, 0x48cfbdb3, 0x50676e51 }, 1 },
-	{ {0x792e6b28, 0x14ab783d, 0x06c7576c, 0x1e3ccd6a, 0x9bbac34a }, 1 },
-	{ {0xc3efedda, 0x7ab947a0, 0x6d9345f7, 0xb8261076, 0xfa7ceeef }, 65 },
-	{ {0xf28c23c8, 0xcf65ac80, 0xd2a89272, 0x5164aa80, 0xc2cabcb5 }, 65 },
-	{ {0x8924e3e1, 0x1eb1c8c1, 0xedcb7efa, 0x63c26d2b, 0xdc142473 }, 65 },
-	{ {0x4f0102cd, 0xc27216fd, 0x9bcdb966, 0x3db728d2, 0xccd8ca6d }, 1 },
-	{ {0xb7b4e4cd, 0x40a856bb, 0x071976e6, 0xcf0f5e54, 0x6fc86a78 }, 1 },
-	{ {0xdc50f2c9, 0xdb233e50, 0x5b0981c2, 0x44ff3de5, 0x53ac9d68 }, 42 },
-	{ {0x92a433e8, 0x77626461, 0xa6481ca7, 0x5c252e64, 0x3752f0c4 }, 42 },
-	{ {0x7aec0134, 0xad6a5177, 0xf4056fcb, 0x6047083e, 0x8e00529b }, 42 },
-	{ {0x5d387d26, 0xb36347ff, 0x68a07d6a, 0xe98a95d7, 0x1efc0727 }, 42 },
-	{ {0xabd50f12, 0xd8bc5c4c, 0x8ed2ace6, 0xdd8e98cd, 0xfefadb0e }, 42 },
-	{ {0xdb07b3da, 0x69674e36, 0x356bc78c, 0xaa2ac524, 0xdee26477 }, 42 },
-	{ {0x007e08a4, 0x3482e1e4, 0x4dd017fb, 0x64091056, 0xc27438c1 }, 42 },
-	{ {0x868dd144, 0x80f716e0, 0x2453d0af, 0xac6a09d6, 0xa7f10853 }, 42 },
-	{ {0xd74885c9, 0x73915980, 0x5bc9fa66, 0x163c56c6, 0xa0daa5fb }, 42 },
-	{ {0x40348c56, 0xadd3cf5a, 0x4b40b8cb, 0xc94a39e0, 0xec94ff0a }, 1 },
-	{ {0xd67be6d7, 0xd56d7229, 0x418f4e12, 0x2f2ec279, 0x90db7d19 }, 1 },
-	{ {0x58ac78bb, 0xa29a0664, 0x5ca8d6a9, 0x4ef2ac68, 0xb743ad32 }, 65 },
+	{ {0xfd5dd1d1, 0x6c46eba1, 0x34910b5e, 0x9550656b, 0xa9a1fd82 }, 19 },
+	{ {0xfd6cc08d, 0x4842a85a, 0x3c741cf9, 0xc30883dd, 0xfc378895 }, 19 },
+	{ {0xfd71df03, 0xb0e9f3ca, 0xf701ecfc, 0x6d523206, 0x0cab3b13 }, 4 },
+	{ {0xfd7518a6, 0xaedb5163, 0x0364082c, 0x27bdfe44, 0x11adfd4c }, 19 },
+	{ {0xfd7b23a4, 0xf1c2058b, 0x966b5ddd, 0x52cf7ae4, 0x4a0eebb0 }, 5 },
+	{ {0xfd9eef4e, 0xa54e31e9, 0xffb121c0, 0x79e4b76c, 0x990d755c }, 19 },
 	{ {0xfd9fa78b, 0xac25aa3c, 0x0792425b, 0x21d14e36, 0x4cf7eea4 }, 1 },
-	{ {0x4ce41fcc, 0x1a603411, 0xec4e9955, 0x6409c442, 0x078f0ecf }, 1 },
-	{ {0xfbb0dccf, 0x7da4c24a, 0xe9e2db67, 0x53092d1d, 0x03e35bef }, 1 },
-	{ {0xd3af963e, 0x2529662e, 0xae63f04a, 0x25304546, 0x85a1989f }, 1 },
-	{ {0x4190c488, 0xacc6a326, 0x5deb5d7c, 0xf9511fc7, 0xf61bb964 }, 1 },
-	{ {0xb1cce60e, 0xf61c058f, 0x5e42ef7a, 0xc635018d, 0x1a431168 }, 1 },
-	{ {0x84a645be, 0xcec0a25d, 0x3ab7a909, 0xcde1b242, 0x699a8662 }, 24 },
-	{ {0xbcdb4dae, 0x303dfe52, 0x34f372d7, 0x0a5e0271, 0xd3202c36 }, 24 },
-	{ {0x95de8809, 0xd2758fc0, 0xa743390e, 0xa5085b60, 0x2e59e101 }, 57 },
-	{ {0x9efa744b, 0xe8355675, 0xe7bfdd39, 0x76bbbfaf, 0x85d62e1d }, 57 },
-	{ {0xaad42ba4, 0x289b33d8, 0xeed225d4, 0x2cea930b, 0x7fc5c228 }, 78 },
-	{ {0x22b3191d, 0x86501026, 0x4001b9d8, 0x96186a98, 0x18478a6b }, 39 },
-	{ {0x608e8e9a, 0xb91c67f7, 0x015a67ea, 0x12f52ea3, 0xb0d609cd }, 65 },
-	{ {0x663f8c51, 0x2d04d213, 0xfa616b0d, 0xb5eefe37, 0x74012a4b }, 1 },
-	{ {0x94258154, 0x46d46805, 0x8705bae5, 0x45ffa136, 0x46744a87 }, 1 },
-	{ {0xe0c2bfb0, 0x78562d15, 0xacabc583, 0x1020a237, 0x0ea87052 }, 1 },
-	{ {0x942f9507, 0xd206cd81, 0x56f15601, 0xfe8032fc, 0xf0e3875b }, 1 },
-	{ {0xd0cfc35f, 0x22b150a1, 0xcb10deca, 0xe4841dfe, 0x63b78251 }, 1 },
-	{ {0x0f4f09f1, 0xa6ef7535, 0xb243afab, 0xfb44a3a0, 0xeb0498d9 }, 39 },
-	{ {0xe84d3ec7, 0xa595ee36, 0xb50e9796, 0x83c84105, 0xc1871857 }, 39 },
-	{ {0x5e7c8eab, 0x238712d1, 0xe18b0219, 0xc0f4d4da, 0xe180420d }, 1 },
-	{ {0x365c93d7, 0x652c9f72, 0x7221689b, 0xcc348652, 0x832a7b7a }, 1 },
-	{ {0x97ce5989, 0x2573cac3, 0xc440efff, 0x6d74c8a1, 0xc29a5ad3 }, 39 },
-	{ {0x38a645fe, 0xbd0e0fe8, 0x6d594f27, 0xc2d14be9, 0x95acc730 }, 1 },
-	{ {0xb262aedc, 0x71b44530, 0x3f84efe5, 0xe865cbb7, 0x1fd7d952 }, 39 },
-	{ {0x9db72bb7, 0x8792595a, 0x12499c82, 0x1048504d, 0xc96ef848 }, 42 },
-	{ {0xaa78fc9b, 0xcd2343f8, 0x4cf79031, 0x0a768ee4, 0x7f90c841 }, 42 },
-	{ {0x58accf41, 0xa9069387, 0x4b86ce98, 0xd8d43c27, 0xbeb8b6dc }, 42 },
-	{ {0x30d914cd, 0xa2180889, 0xa40a3328, 0xe0a0c132, 0x7f4eaa10 }, 42 },
-	{ {0xed2fea5c, 0x2a3c2e58, 0xd4f69f9d, 0x636e0857, 0x4486a2b1 }, 42 },
-	{ {0x917d1c07, 0x9e03c4a4, 0x4de864f1, 0x23d03c4e, 0x32c8daae }, 42 },
-	{ {0xe8a9c605, 0xe4be1e07, 0xefc89a19, 0xd9a80f67, 0x6abdaa2f }, 65 },
-	{ {0x12f2cc79, 0xb3d09723, 0x840bae77, 0x4be48c0d, 0x721ec1c6 }, 65 },
-	{ {0xc1bb307a, 0x570ab833, 0xe3bfcc4a, 0x58a4f4e1, 0x2dc1df0f }, 65 },
-	{ {0xe2fbd56e, 0x42da6376, 0x09d23ae9, 0xdf9efd1b, 0x4241b18a }, 1 },
-	{ {0xade0c5ba, 0x5574f811, 0x4d707905, 0x0317099b, 0x4519e88f }, 40 },
-	{ {0x218d91eb, 0x6df2823c, 0x924d3774, 0xa9f45549, 0x2a10aecb }, 24 },
-	{ {0x5a4e7dbb, 0xfb759109, 0xc7d2a3b3, 0x8bda9c60, 0xbf6ffef5 }, 65 },
-	{ {0x174c9254, 0xf09d9936, 0x1ff76076, 0x30248ff9, 0xd7d8d4d6 }, 1 },
-	{ {0xe93b8da1, 0xe8dddbb3, 0x742292b0, 0xe5e58731, 0xb90e9313 }, 65 },
-	{ {0x6acaf2ee, 0xb57f65f7, 0x408235d5, 0xe07b7563, 0x229de799 }, 24 },
-	{ {0x15665321, 0x46fcfc28, 0xc7077537, 0x77c66585, 0xdc12418a }, 65 },
-	{ {0x0e081572, 0xf84555dc, 0x13bdb0c7, 0x044a19d6, 0xc164d985 }, 65 },
-	{ {0xcef16eb9, 0x5502ba6a, 0xb2265fca, 0xfcedde47, 0x0a101541 }, 1 },
+	{ {0xfda4422b, 0x86daa233, 0xfa4e6104, 0xe45305e7, 0xcb383053 }, 6 },
+	{ {0xfdc3cc10, 0xb4821ea5, 0x169c817f, 0xcbd6e99f, 0xac464feb }, 19 },
+	{ {0xfe0254cb, 0xfc11405b, 0x79e7c86c, 0x7769bd63, 0x22b04995 }, 1 },
+	{ {0xfe1d0228, 0x4b0b0513, 0x08e3c796, 0xe8e9eee2, 0xf86521b8 }, 19 },
+	{ {0xfe31a9a3, 0xdab733f3, 0xd0edb24f, 0xea3cff93, 0xdc9df6ae }, 19 },
+	{ {0xfe39af5e, 0xb457bba8, 0xc5b96b5b, 0x500120cf, 0xc05c265e }, 3 },
+	{ {0xfe4bd35e, 0x87dd50fd, 0xdd255172, 0x129b9bec, 0x38691188 }, 4 },
+	{ {0xfe53d85a, 0xdb758103, 0x097fd561, 0x32e71c7f, 0x4cb32313 }, 19 },
+	{ {0xfe71908e, 0x340aa5dd, 0x241d56a3, 0xe8381263, 0xe5eb5aeb }, 19 },
+	{ {0xfe74b4df, 0x9698a61d, 0xffd3ac88, 0xf4761967, 0x5514ba1c }, 7 },
+	{ {0xfe8aae62, 0xfdec2863, 0x1d8f7b66, 0x59dd9513, 0x5c1bcbb7 }, 6 },
+	{ {0xfed52c04, 0x55ce1e7c, 0xef80cd14, 0x4c3d0ef3, 0x636134e5 }, 4 },
 	{ {0xfedd9b68, 0x2d056ddd, 0x1e9b3d28, 0x1723e12f, 0x859b2e69 }, 1 },
-	{ {0x3376cf9d, 0xd2b1ac9b, 0x41bf6bf6, 0x598b3313, 0x6e86f9d5 }, 65 },
-	{ {0x4811956f, 0x878c3e03, 0xda46317f, 0x787cdc4b, 0xebc86f47 }, 1 },
-	{ {0x1e9a9559, 0x43aeea9b, 0x1807ddf1, 0x250ba643, 0x6d8dd276 }, 1 },
-	{ {0xfc760d1d, 0x7b16370a, 0xbc7eea39, 0x955f230b, 0x95b37df6 }, 65 },
-	{ {0x558b7383, 0x544542cf, 0x7333700f, 0xf90c3efb, 0xf93ba2a3 }, 42 },
-	{ {0x8cc1f7ce, 0xeef745bb, 0x34e80253, 0x971e1372, 0x13671486 }, 42 },
-	{ {0x2d1880d1, 0xf5a6944f, 0xcb1b198b, 0x997a3d90, 0xecd1903d }, 42 },
-	{ {0x7b4a9640, 0x2847decf, 0xc110ff9e, 0xda713bdc, 0xd218bd83 }, 1 },
-	{ {0x47642bb0, 0xa2c46a82, 0x100543dc, 0x3970d0a4, 0x9fc53b69 }, 1 },
-	{ {0x65253cb3, 0x8ab11084, 0xf355a2d4, 0xad78fa6c, 0x64cbe660 }, 1 },
-	{ {0x8948704b, 0xad9ff278, 0x73fa9ccd, 0x0ef89868, 0xe2bd6479 }, 42 },
-	{ {0x03556d38, 0x0a9bd413, 0xfaf1b9e3, 0xcbd7da47, 0xc7238775 }, 1 },
-	{ {0x373aa82d, 0x04268308, 0x80a7344e, 0xf98f7309, 0xd93814c7 }, 42 },
-	{ {0x8779b004, 0xe7605a3c, 0x419825f0, 0x373a5d8f, 0xa84e1d5b }, 42 },
-	{ {0x2144036d, 0x6573d666, 0x143e890e, 0x5413956b, 0xfe8f66c5 }, 65 },
-	{ {0xe067ce2b, 0x444ec7a3, 0xdd45d9e2, 0xdf4b34c1, 0xba732872 }, 65 },
-	{ {0xba83a80a, 0x0041e3a8, 0xfb5c075a, 0x9b4a29ee, 0x92255d62 }, 65 },
-	{ {0x342e7d4b, 0xd86f3351, 0x766f460f, 0x6de3c89a, 0x40791ee0 }, 1 },
-	{ {0x6aa856cc, 0x56eb9886, 0x3c9da7a5, 0x66571605, 0x682b5c6b }, 67 },
-	{ {0x3f16d551, 0x3ad35692, 0x488ae7d8, 0x64f660e7, 0x6c6e8ed3 }, 103 },
-	{ {0xea6a82cf, 0x8c6e65eb, 0x30b98755, 0xc8577cde, 0x8d9186c0 }, 1 },
-	{ {0x0b8ab949, 0x7924547b, 0x6afbddb1, 0x7013dd5d, 0x84efebb9 }, 67 },
-	{ {0x72fccb4e, 0xc1889db0, 0x5fe815b4, 0x3857b18e, 0x818bf917 }, 67 },
-	{ {0x2e0acabe, 0x8a5baac4, 0xd17271ef, 0x6c0b4c86, 0xed540747 }, 67 },
-	{ {0x99a40266, 0xbc296cef, 0x1d432cb0, 0xcaa8df1a, 0x7e570be4 }, 67 },
-	{ {0x6d3a530a, 0xe822ec91, 0xf6444c68, 0x1c9b08b9, 0xefadc7e7 }, 67 },
-	{ {0xc53b3f2c, 0x00f31683, 0x914f7452, 0xf3f4d94a, 0xe2929c0d }, 1 },
-	{ {0x93d4d352, 0xb73c3d2e, 0x68ceaa31, 0x75b9af7f, 0x94780eba }, 1 },
-	{ {0xf3dd9797, 0x06fa466e, 0x2a34bbb8, 0x729cf1bc, 0x7c298864 }, 1 },
-	{ {0xd08b5ec2, 0xa98bd40e, 0x8b97f4c5, 0x152db54a, 0x455ae493 }, 1 },
-	{ {0xf858a75f, 0x0a7a12a4, 0x449a3d57, 0x5b121801, 0xace0aa42 }, 1 },
-	{ {0xc5be2ecf, 0xd16094d3, 0x2e68f4e0, 0x14c58d73, 0x11437c5d }, 1 },
-	{ {0x4e9384c9, 0xd137f0ab, 0x65ffc5a7, 0x8f04cd8c, 0x9df6c8b7 }, 42 },
-	{ {0x9de525e0, 0x42d7345f, 0x6b725a69, 0x6bd1b6fe, 0xf69ecbf1 }, 42 },
-	{ {0x87f4d0fa, 0x58cfe9ce, 0xf818a318, 0x5df2735e, 0x6da6168c }, 1 },
-	{ {0x1b70a195, 0xa00b1fc4, 0x99576639, 0x0f39d3ba, 0x884b5148 }, 1 },
-	{ {0x0f57ede0, 0xe3deeabf, 0x47f03ea9, 0x7860934a, 0x5a36eee2 }, 96 },
-	{ {0x51a1467d, 0x73d26c91, 0xaab7923e, 0x3be66490, 0xdaaffdee }, 96 },
-	{ {0xb154c8ec, 0xe9646864, 0x327c97ab, 0xaf49c133, 0x4cd392c7 }, 96 },
-	{ {0x1c79c8fc, 0xfd661394, 0xf91be94b, 0x218955c8, 0x4cabd742 }, 96 },
-	{ {0x8a919dbe, 0xed92db8c, 0x06a61127, 0x9efaed85, 0x52810239 }, 96 },
-	{ {0x09db7369, 0xe42b5064, 0x1ae1a862, 0x2428909c, 0x17d23180 }, 1 },
-	{ {0xc1d83c55, 0x9e1e6a6d, 0xa961eafa, 0x55aab105, 0x681c634c }, 64 },
-	{ {0x7bba2366, 0x9b7abfb6, 0xa142f9e1, 0x735b847d, 0x6e4e8267 }, 1 },
-	{ {0x39dfc462, 0x60f99b67, 0x0916b1e5, 0x5f67a5d4, 0x136e6e54 }, 1 },
-	{ {0xcdeb0ed8, 0xadecaaad, 0xb78d5a53, 0x64fd6032, 0x38591685 }, 42 },
-	{ {0xca5c5f38, 0x72057a6a, 0xa65fe493, 0x6791850d, 0xe302d501 }, 64 },
-	{ {0x4dad9de7, 0xc28b4523, 0x51cc1291, 0x0849b51b, 0xd9a37ab3 }, 1 },
-	{ {0x0d246b0e, 0x3edc6380, 0x3fcce861, 0xea07eadf, 0x29dc488c }, 42 },
-	{ {0x08fb8a2a, 0x1c05537b, 0x9deacfc0, 0xcc55e803, 0x17b84d19 }, 63 },
-	{ {0xe6dba66c, 0x8716593b, 0x8ab88f79, 0xf7205211, 0x938d1598 }, 1 },
-	{ {0xe9d7d74f, 0x71daeff1, 0x73f9979c, 0xc51c0c4d, 0x4424bac2 }, 1 },
-	{ {0x706dd670, 0x36baeec7, 0x127e4ccd, 0x8c8db8f6, 0xce7d0e4c }, 1 },
-	{ {0x0dde59e8, 0xd98fa524, 0x961cd37b, 0x0e100dbf, 0xb42cf576 }, 1 },
-	{ {0xea4a723c, 0xf098be7d, 0x7b40f23a, 0x7ab831cf, 0x5e2190d7 }, 1 },
-	{ {0x521928db, 0x7bc81a8d, 0xb4cac1e6, 0x66851e2b, 0xf01c8d53 }, 1 },
-	{ {0x48b0c2ff, 0x1f1e407c, 0xc4439421, 0x9f7b3878, 0xefaa919f }, 42 },
-	{ {0xc2340313, 0xbfda7511, 0x81e8a528, 0x7d60f77b, 0xc6a2f3e6 }, 42 },
-	{ {0xdf503d6f, 0x5d72a2a3, 0x55db53c3, 0x5950348f, 0xb7c767bf }, 42 },
-	{ {0x43465130, 0x5f92aa77, 0x0a89e40b, 0x81125fb2, 0x2d91603d }, 106 },
-	{ {0xbc4b2426, 0x47116f48, 0x86bb92e8, 0x6421f97b, 0x1be51938 }, 105 },
-	{ {0xdf2ef80e, 0x9cfabde8, 0xb630c180, 0x2fd69757, 0x6102feb7 }, 105 },
-	{ {0xd956167e, 0x234f60ad, 0x91612043, 0x7120f86f, 0xc8c3c321 }, 105 },
-	{ {0x6680d711, 0x8d854188, 0x13f1db94, 0x49bf3e20, 0x942b16da }, 105 },
-	{ {0x8b121123, 0x1283041b, 0xcfc9ae45, 0x5d121e2c, 0xf2a06c42 }, 105 },
-	{ {0xf6d7b12a, 0xe2d9cb0c, 0xcb75e2cb, 0x69d58a01, 0x808359bd }, 105 },
-	{ {0x4f3114e9, 0x6d7b8929, 0x11e3dccf, 0x1eece712, 0xbe26f396 }, 1 },
-	{ {0x04990aa1, 0xc3a3fc72, 0x94ec884b, 0x81deaa89, 0x832df614 }, 1 },
-	{ {0xa317d27f, 0xb7a89e48, 0x71fc35b3, 0xb6e1e55e, 0x34d1a180 }, 42 },
-	{ {0xab372a7c, 0xe8aca99a, 0xaad5295e, 0x06cb9f51, 0xcbbc7a21 }, 64 },
-	{ {0xa1680d68, 0x9a8f617c, 0x2186a523, 0xc83c831e, 0x733a687e }, 42 },
-	{ {0x0f851ee7, 0xa1cf7981, 0x9f61cc89, 0xe9948ee7, 0x2a413802 }, 1 },
-	{ {0xebb7eb54, 0x0a390509, 0xedfd36c8, 0x4288ba85, 0xe63f2d1f }, 1 },
-	{ {0x03bf6d2a, 0xc86f5c9a, 0xb618e155, 0x442787c7, 0x00f99fed }, 1 },
-	{ {0x3a481c7b, 0x7e4f0406, 0xa55952bc, 0x5b9f8cf9, 0xd699376c }, 64 },
-	{ {0xa317d27f, 0xb7a89e48, 0x71fc35b3, 0xb6e1e55e, 0x34d1a180 }, 42 },
-	{ {0xd99eebde, 0xd5db5fce, 0x1e072d08, 0xe642c090, 0x9bc7efdd }, 1 },
+	{ {0xfef04a6e, 0x1b3a49bc, 0xc130969c, 0x062f6551, 0xecd5feaf }, 27 },
+	{ {0xff26b2b0, 0x23d04513, 0x08ff932b, 0x5280fe33, 0xea60496b }, 100 },
+	{ {0xff3c2311, 0xbdeec5a2, 0x57877e68, 0xce020c69, 0xdcefe55a }, 143 },
+	{ {0xff4c92cc, 0x84676c62, 0xb9c08b19, 0x7effc6ed, 0xa741db01 }, 56 },
+	{ {0xff5b1227, 0x5950edae, 0x9ece3f49, 0xed59402d, 0x47f23b1b }, 39 },
+	{ {0xff72a178, 0x8d47f987, 0x6d9fabd7, 0x20f6a289, 0xfb409090 }, 3 },
+	{ {0xff987766, 0x6d983759, 0xd41398c5, 0xe3e29801, 0xad95a589 }, 19 },
+	{ {0xff999ca3, 0xe78c347b, 0xdbd23cb4, 0xc7adbfc0, 0x2c20a397 }, 19 },
+	{ {0xffa8fc57, 0x56f7e1d1, 0xef168618, 0xf5606aca, 0x10f8b2c7 }, 19 },
+	{ {0xffc1bafc, 0xa38d20ed, 0x6e9a27c9, 0x0c6ab089, 0xa8482d89 }, 63 },
+	{ {0xffc8c57b, 0x26f2f495, 0xbd77efac, 0x5b815efe, 0x9c25336c }, 19 },
+	{ {0xfff31b8c, 0x7549493d, 0x8ec220f8, 0x5e3e8536, 0xf150d82a }, 19 },
@@ -41,23 +41,22 @@ extern "C" {
 #include <imagine/util/builtins.h>
 #include <imagine/util/algorithm.h>
 #include <imagine/logger/logger.h>
-// throw_exception.hpp, Boost 1.50
-#define UUID_AA15E74A856F11E08B8D93F24824019B
-#define BOOST_THROW_EXCEPTION(x)
-#define BOOST_STATIC_ASSERT( ... ) static_assert(__VA_ARGS__, #__VA_ARGS__)
-#include "../uuid/sha1.hpp"
+#include <emuframework/RomIdentity.hh>
 
 struct RomDBInfo
 {
-	uint digest[5];
+	std::array<uint32_t, 5> digest;
 	uint romType;
 };
 
-static const RomDBInfo romDB[] =
+// sorted by SHA-1 for binary search
+static constexpr RomDBInfo romDB[] =
 {
 #include "EmbeddedRomDBData.h"
 };
 
+static_assert(romDBIsSorted(romDB, &RomDBInfo::digest), "romDB must be sorted by digest");
+
 struct MediaType {
     constexpr MediaType(RomType rt) : romType(rt) {}
 
@@ -550,27 +549,14 @@ extern "C" MediaType* mediaDbLookupRom(const void *buffer, int size)
     }*/
     static MediaType staticMediaType(ROM_UNKNOWN);
 
-    boost::uuids::detail::sha1 sha1;
-		sha1.process_bytes(buffer, size);
-		unsigned int digest[5];
-		sha1.get_digest(digest);
+		auto digest = makeRomDigest(buffer, size).sha1Words();
 		logMsg("rom sha1 0x%X 0x%X 0x%X 0x%X 0x%X", digest[0], digest[1], digest[2], digest[3], digest[4]);
 
-		for(auto e : romDB)
+		if(auto e = findRomDBEntry(romDB, digest, &RomDBInfo::digest))
 		{
-			int match = 0;
-			iterateTimes(5, i)
-			{
-					if(digest[i] != e.digest[i])
-						break;
-					else match++;
-			}
-			if(match == 5)
-			{
-				logMsg("found match with type %s", romTypeToString(e.romType));
-				staticMediaType = e.romType;
-				return &staticMediaType;
-			}
+			logMsg("found match with type %s", romTypeToString(e->romType));
+			staticMediaType = e->romType;
+			return &staticMediaType;
 		}
 
 		logMsg("rom not in DB");
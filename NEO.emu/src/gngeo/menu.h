@@ -69,11 +69,17 @@ int gn_loop_menu(GN_MENU *m);
 Uint32 run_menu(void);
 void gn_reset_pbar(void);
 //void gn_init_pbar(const char *name,int size);
-enum { PBAR_ACTION_LOADROM, PBAR_ACTION_DECRYPT, PBAR_ACTION_LOADGNO, PBAR_ACTION_SAVEGNO };
+enum { PBAR_ACTION_LOADROM, PBAR_ACTION_DECRYPT, PBAR_ACTION_LOADGNO, PBAR_ACTION_SAVEGNO, PBAR_ACTION_CONVERT };
 void gn_init_pbar(uint action,int size);
 void gn_update_pbar(int pos);
 void gn_terminate_pbar(void);
 
+/* Calls func on sub-ranges [start, end) of [0, items) from all CPU cores and returns when
+   every range is done. Ranges start on a multiple of align. If pbar_base >= 0 the calling
+   thread reports gn_update_pbar(pbar_base + completed items) as ranges finish. */
+typedef void (*gn_range_func)(Uint32 start, Uint32 end, void *data);
+void gn_parallel_for(Uint32 items, Uint32 align, gn_range_func func, void *data, int pbar_base);
+
 void gn_popup_error(char *name,char *fmt,...);
 int gn_popup_question(char *name,char *fmt,...);
 
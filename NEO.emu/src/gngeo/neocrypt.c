@@ -531,40 +531,44 @@ static void decrypt(UINT8 *r0, UINT8 *r1,
 }
 
 #include <stdio.h>
+#include <string.h>
 
 
-static void neogeo_gfx_decrypt(running_machine *machine, int extra_xor)
-{
+struct gfx_decrypt_args {
 	UINT8 *buf;
 	UINT8 *rom;
-	uint rpos;
-	const uint rom_size = memory_region_length(machine, "sprites");
-
-	buf = alloc_array_or_die(UINT8, rom_size);
+	uint rom_size;
+	int extra_xor;
+};
 
-	rom = memory_region(machine, "sprites");
-	const uint pbarUpdateCount = 20;
-	const uint pbarSteps = (rom_size/4)/pbarUpdateCount;
-	gn_init_pbar(PBAR_ACTION_DECRYPT, rom_size/2);
+static void gfx_decrypt_data_range(Uint32 start, Uint32 end, void *data)
+{
+	struct gfx_decrypt_args *args = data;
+	UINT8 *buf = args->buf;
+	const UINT8 *rom = args->rom;
+	uint rpos;
 	// Data xor
-	for (rpos = 0;rpos < rom_size/4;rpos++)
+	for (rpos = start;rpos < end;rpos++)
 	{
 		decrypt(buf+4*rpos+0, buf+4*rpos+3, rom[4*rpos+0], rom[4*rpos+3], type0_t03, type0_t12, type1_t03, rpos, (rpos>>8) & 1);
 		decrypt(buf+4*rpos+1, buf+4*rpos+2, rom[4*rpos+1], rom[4*rpos+2], type0_t12, type0_t03, type1_t12, rpos, ((rpos>>16) ^ address_16_23_xor2[(rpos>>8) & 0xff]) & 1);
-		if (rpos % pbarSteps == 0) {
-			gn_update_pbar(rpos);
-		}
 	}
+}
+
+static void gfx_decrypt_address_range(Uint32 start, Uint32 end, void *data)
+{
+	struct gfx_decrypt_args *args = data;
+	const UINT8 *buf = args->buf;
+	UINT8 *rom = args->rom;
+	const uint rom_size = args->rom_size;
+	uint rpos;
 	// Address xor
-	for (rpos = 0;rpos < rom_size/4;rpos++)
+	for (rpos = start;rpos < end;rpos++)
 	{
 		int baser;
-		if (rpos % pbarSteps == 0) {
-			gn_update_pbar(rpos + (rom_size >> 2));
-		}
 		baser = rpos;
 
-		baser ^= extra_xor;
+		baser ^= args->extra_xor;
 
 		baser ^= address_8_15_xor1[(baser >> 16) & 0xff] << 8;
 		baser ^= address_8_15_xor2[baser & 0xff] << 8;
@@ -590,13 +594,26 @@ static void neogeo_gfx_decrypt(running_machine *machine, int extra_xor)
 		else /* Clamp to the real rom size */
 			baser &= (rom_size/4)-1;
 
-		rom[4*rpos+0] = buf[4*baser+0];
-		rom[4*rpos+1] = buf[4*baser+1];
-		rom[4*rpos+2] = buf[4*baser+2];
-		rom[4*rpos+3] = buf[4*baser+3];
+		memcpy(&rom[4*rpos], &buf[4*baser], 4);
 	}
+}
+
+static void neogeo_gfx_decrypt(running_machine *machine, int extra_xor)
+{
+	struct gfx_decrypt_args args;
+	const uint rom_size = memory_region_length(machine, "sprites");
+
+	args.buf = alloc_array_or_die(UINT8, rom_size);
+	args.rom = memory_region(machine, "sprites");
+	args.rom_size = rom_size;
+	args.extra_xor = extra_xor;
+	gn_init_pbar(PBAR_ACTION_DECRYPT, rom_size/2);
+	// each word is decrypted independently into buf, then gathered back into rom,
+	// so both passes can be split over the rom
+	gn_parallel_for(rom_size/4, 1, gfx_decrypt_data_range, &args, 0);
+	gn_parallel_for(rom_size/4, 1, gfx_decrypt_address_range, &args, rom_size/4);
 	gn_terminate_pbar();
-	free(buf);
+	free(args.buf);
 }
 
 
@@ -22,6 +22,9 @@
 #if defined(HAVE_LIBZ)// && defined (HAVE_MMAP)
 #include <zlib.h>
 #endif
+#if defined(HAVE_MMAP)
+#include <sys/mman.h>
+#endif
 #include "unzip.h"
 
 #include "video.h"
@@ -940,9 +943,14 @@ static int allocate_region(ROM_REGION *r, Uint32 size, int region) {
 	return 0;
 }
 
+static int region_in_gno_map(const ROM_REGION *r) {
+	const GFX_CACHE *gcache = &memory.vid.spr_cache;
+	return gcache->map && r->p >= gcache->map && r->p < gcache->map + gcache->map_size;
+}
+
 static void free_region(ROM_REGION *r) {
 	DEBUG_LOG("Free Region %p %p %d", r, r->p, r->size);
-	if (r->p)
+	if (r->p && !region_in_gno_map(r))
 		free(r->p);
 	r->size = 0;
 	r->p = NULL;
@@ -1101,79 +1109,86 @@ static struct PKZIP *open_rom_zip(char *rom_path, char *name) {
 	return NULL;
 }
 
+/* Spreads the 8 bits of a bitplane byte into the low bit of each nibble,
+   with bit 0 in the highest nibble */
+static Uint32 tile_plane_lut[256];
+
+static void init_tile_plane_lut(void) {
+	int b, x;
+	if (tile_plane_lut[0x80])
+		return;
+	for (b = 0; b < 256; b++) {
+		Uint32 dw = 0;
+		for (x = 0; x < 8; x++)
+			dw |= ((b >> x) & 1) << ((7 - x) << 2);
+		tile_plane_lut[b] = dw;
+	}
+}
+
+static inline Uint32 convert_tile_line(const Uint8 *planes) {
+	return (tile_plane_lut[planes[3]] << 3) | (tile_plane_lut[planes[1]] << 2) |
+		(tile_plane_lut[planes[2]] << 1) | tile_plane_lut[planes[0]];
+}
+
 static int convert_roms_tile(Uint8 *g, int tileno) {
-	unsigned char swap[128];
-	unsigned int *gfxdata;
-	int x, y;
-	unsigned int pen, usage = 0;
+	Uint8 swap[128];
+	Uint32 *gfxdata;
+	Uint32 used = 0;
+	int y;
 	gfxdata = (Uint32*) & g[tileno << 7];
 
 	memcpy(swap, gfxdata, 128);
 
-	//filed=1;
 	for (y = 0; y < 16; y++) {
-		unsigned int dw;
-
-		dw = 0;
-		for (x = 0; x < 8; x++) {
-			pen = ((swap[64 + (y << 2) + 3] >> x) & 1) << 3;
-			pen |= ((swap[64 + (y << 2) + 1] >> x) & 1) << 2;
-			pen |= ((swap[64 + (y << 2) + 2] >> x) & 1) << 1;
-			pen |= (swap[64 + (y << 2)] >> x) & 1;
-			//if (!pen) filed=0;
-			dw |= pen << ((7 - x) << 2);
-			//memory.pen_usage[tileno]  |= (1 << pen);
-			usage |= (1 << pen);
-		}
-		*(gfxdata++) = dw;
-
-		dw = 0;
-		for (x = 0; x < 8; x++) {
-			pen = ((swap[(y << 2) + 3] >> x) & 1) << 3;
-			pen |= ((swap[(y << 2) + 1] >> x) & 1) << 2;
-			pen |= ((swap[(y << 2) + 2] >> x) & 1) << 1;
-			pen |= (swap[(y << 2)] >> x) & 1;
-			//if (!pen) filed=0;
-			dw |= pen << ((7 - x) << 2);
-			//memory.pen_usage[tileno]  |= (1 << pen);
-			usage |= (1 << pen);
-		}
-		*(gfxdata++) = dw;
+		Uint32 dw0 = convert_tile_line(&swap[64 + (y << 2)]);
+		Uint32 dw1 = convert_tile_line(&swap[y << 2]);
+		*(gfxdata++) = dw0;
+		*(gfxdata++) = dw1;
+		used |= dw0 | dw1;
 	}
 
-	//if ((usage & ~1) == 0) pen_usage|=(TILE_INVISIBLE<<((tileno&0xF)*2));
 	/* TODO transpack support */
-	if ((usage & ~1) == 0)
+	/* a tile only using pen 0 is fully transparent */
+	if (!used)
 		return (TILE_INVISIBLE << ((tileno & 0xF) * 2));
 	else
 		return 0;
 
 }
 
-void convert_all_tile(GAME_ROMS *r) {
+static void convert_tile_range(Uint32 start, Uint32 end, void *data) {
+	GAME_ROMS *r = data;
 	Uint32 i;
-	allocate_region(&r->spr_usage, (r->tiles.size >> 11) * sizeof (Uint32), REGION_SPR_USAGE);
-	memset(r->spr_usage.p, 0, r->spr_usage.size);
-	for (i = 0; i < r->tiles.size >> 7; i++) {
+	/* ranges are aligned to 16 tiles so each usage word is only written by one thread */
+	for (i = start; i < end; i++) {
 		((Uint32*) r->spr_usage.p)[i >> 4] |= convert_roms_tile(r->tiles.p, i);
 	}
 }
 
-void convert_all_char(Uint8 *Ptr, int Taille,
-		Uint8 *usage_ptr) {
-	int i, j;
-	unsigned char usage;
+void convert_all_tile(GAME_ROMS *r) {
+	Uint32 tiles = r->tiles.size >> 7;
+	allocate_region(&r->spr_usage, (r->tiles.size >> 11) * sizeof (Uint32), REGION_SPR_USAGE);
+	memset(r->spr_usage.p, 0, r->spr_usage.size);
+	init_tile_plane_lut();
+	gn_init_pbar(PBAR_ACTION_CONVERT, tiles);
+	gn_parallel_for(tiles, 16, convert_tile_range, r, 0);
+	gn_terminate_pbar();
+}
 
-	Uint8 *Src;
-	Uint8 *sav_src;
+struct convert_char_args {
+	Uint8 *ptr;
+	Uint8 *usage_ptr;
+};
 
-	Src = (Uint8*) malloc(Taille);
-	if (!Src) {
-		logMsg("Not enought memory!!");
-		return;
-	}
-	sav_src = Src;
-	memcpy(Src, Ptr, Taille);
+static void convert_char_range(Uint32 start, Uint32 end, void *data) {
+	struct convert_char_args *args = data;
+	Uint8 *Ptr = args->ptr + start * 32;
+	Uint8 *usage_ptr = args->usage_ptr + start;
+	Uint32 i;
+	int j;
+	unsigned char usage;
+	Uint8 tile[32];
+	Uint8 *Src;
 #ifdef WORDS_BIGENDIAN
 #define CONVERT_TILE *Ptr++ = *(Src+8);\
 	             usage |= *(Src+8);\
@@ -1195,18 +1210,25 @@ void convert_all_char(Uint8 *Ptr, int Taille,
 		     usage |= *(Src+8);\
 		     Src++;
 #endif
-	for (i = Taille; i > 0; i -= 32) {
+	for (i = start; i < end; i++) {
+		/* each tile is converted in place from a copy of itself */
+		memcpy(tile, Ptr, 32);
+		Src = tile;
 		usage = 0;
 		for (j = 0; j < 8; j++) {
 			CONVERT_TILE
 		}
-		Src += 24;
 		*usage_ptr++ = usage;
 	}
-	free(sav_src);
 #undef CONVERT_TILE
 }
 
+void convert_all_char(Uint8 *Ptr, int Taille,
+		Uint8 *usage_ptr) {
+	struct convert_char_args args = { Ptr, usage_ptr };
+	gn_parallel_for((Uint32)(Taille + 31) / 32, 1, convert_char_range, &args, -1);
+}
+
 static int init_roms(GAME_ROMS *r) {
 	int i = 0;
 	//printf("INIT ROM %s\n",r->info.name);
@@ -1748,7 +1770,7 @@ int read_region(FILE *gno, GAME_ROMS *roms) {
 	Uint8 lid, type;
 	ROM_REGION *r = NULL;
 	size_t totread = 0;
-	Uint32 cache_size[] = {64, 32, 24, 16, 8, 6, 4, 2, 1, 0};
+	Uint32 cache_size[] = {16, 8, 6, 4, 2, 1, 0};
 	int i = 0;
 
 	/* Read region header */
@@ -1793,7 +1815,16 @@ int read_region(FILE *gno, GAME_ROMS *roms) {
 	}
 
 	logMsg("Read region %d %08X type %d\n", lid, size, type);
-	if (type == 0) {
+	if (type == 0 && memory.vid.spr_cache.map &&
+			(lid == REGION_AUDIO_DATA_1 || lid == REGION_AUDIO_DATA_2)) {
+		/* ADPCM samples are only ever read byte-wise, use them in place
+		 * from the mapping so they're paged in as they're played */
+		long pos = ftell(gno);
+		r->p = memory.vid.spr_cache.map + pos;
+		r->size = size;
+		logMsg("Map %d %08x\n", lid, r->size);
+		fseek(gno, size, SEEK_CUR);
+	} else if (type == 0) {
 		/* TODO: Support ADPCM streaming for platform with less that 64MB of Mem */
 		allocate_region(r, size, lid);
 		logMsg("Load %d %08x\n", lid, r->size);
@@ -1816,7 +1847,8 @@ int read_region(FILE *gno, GAME_ROMS *roms) {
 
 		fseek(gno, cmp_size, SEEK_CUR);
 
-		/* TODO: Find the best cache size dynamically! */
+		/* Blocks are decompressed on demand into a bounded LRU cache,
+		 * so the full tile set never needs to be resident */
 		for (i = 0; cache_size[i] != 0; i++) {
 			if (init_sprite_cache(cache_size[i]*1024 * 1024, block_size) == 0) {
 				logMsg("Cache size=%dMB\n", cache_size[i]);
@@ -1864,6 +1896,24 @@ int dr_open_gno(char *filename, char romerror[1024]) {
 	totread += fread(&r->info.flags, sizeof (Uint32), 1, gno);
 	totread += fread(&nb_sec, sizeof (Uint8), 1, gno);
 
+#if defined(HAVE_MMAP)
+	{
+		/* Map the whole dump privately so sprite blocks and sample data can be
+		 * read in place, falling back to regular reads if it fails */
+		GFX_CACHE *gcache = &memory.vid.spr_cache;
+		long pos = ftell(gno);
+		fseek(gno, 0, SEEK_END);
+		gcache->map_size = ftell(gno);
+		fseek(gno, pos, SEEK_SET);
+		gcache->map = mmap(NULL, gcache->map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(gno), 0);
+		if (gcache->map == MAP_FAILED) {
+			logMsg("Can't map %s, using buffered reads\n", filename);
+			gcache->map = NULL;
+			gcache->map_size = 0;
+		}
+	}
+#endif
+
 	gn_init_pbar(PBAR_ACTION_LOADGNO, nb_sec);
 	for (i = 0; i < nb_sec; i++) {
 		gn_update_pbar(i);
@@ -1941,8 +1991,12 @@ void dr_free_roms(GAME_ROMS *r) {
 		free_region(&r->tiles);
 	} else {
 		fclose(memory.vid.spr_cache.gno);
+		memory.vid.spr_cache.gno = NULL;
 		free_sprite_cache();
 		free(memory.vid.spr_cache.offset);
+		memory.vid.spr_cache.offset = NULL;
+		r->tiles.p = NULL;
+		r->tiles.size = 0;
 	}
 	free_region(&r->game_sfix);
 
@@ -1966,6 +2020,14 @@ void dr_free_roms(GAME_ROMS *r) {
 	free(memory.fix_game_usage);
 	free_region(&r->spr_usage);
 
+#if defined(HAVE_MMAP)
+	if (memory.vid.spr_cache.map) {
+		munmap(memory.vid.spr_cache.map, memory.vid.spr_cache.map_size);
+		memory.vid.spr_cache.map = NULL;
+		memory.vid.spr_cache.map_size = 0;
+	}
+#endif
+
 	//free(r->info.name);
 	//free(r->info.longname);
 
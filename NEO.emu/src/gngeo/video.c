@@ -126,21 +126,52 @@ static Uint16 fix_addr[40][32];
 static Uint8 fix_shift[40];
 
 
+static void reset_sprite_cache_lru(GFX_CACHE *gcache) {
+	int i;
+	for (i = 0; i < gcache->max_slot; i++) {
+		gcache->usage[i] = -1;
+		gcache->lru_prev[i] = i - 1;
+		gcache->lru_next[i] = i + 1;
+	}
+	gcache->lru_next[gcache->max_slot - 1] = -1;
+	gcache->lru_head = 0;
+	gcache->lru_tail = gcache->max_slot - 1;
+}
+
+/* Move a slot to the most recently used end of the list */
+static __inline__ void touch_sprite_cache_slot(GFX_CACHE *gcache, int slot) {
+	int prev = gcache->lru_prev[slot];
+	int next = gcache->lru_next[slot];
+	if (prev == -1)
+		return; /* already the head */
+	gcache->lru_next[prev] = next;
+	if (next != -1)
+		gcache->lru_prev[next] = prev;
+	else
+		gcache->lru_tail = prev;
+	gcache->lru_prev[slot] = -1;
+	gcache->lru_next[slot] = gcache->lru_head;
+	gcache->lru_prev[gcache->lru_head] = slot;
+	gcache->lru_head = slot;
+}
+
 int init_sprite_cache(Uint32 size, Uint32 bsize) {
 	GFX_CACHE *gcache = &memory.vid.spr_cache;
-	int i;
 
 	if (gcache->data != NULL) { /* We allready have a cache, just reset it */
 		memset(gcache->ptr, 0, gcache->total_bank * sizeof (Uint8*));
-		for (i = 0; i < gcache->max_slot; i++)
-			gcache->usage[i] = -1;
+		reset_sprite_cache_lru(gcache);
 		return 0;
 	}
 
 	/* Create our video cache */
 	gcache->slot_size = bsize;
+	for (gcache->slot_shift = 0; (1 << gcache->slot_shift) < bsize; gcache->slot_shift++);
 	logMsg("gfx_size=%08x\n", memory.rom.tiles.size);
 	gcache->total_bank = memory.rom.tiles.size / gcache->slot_size;
+	/* no point in caching more than the whole sprite region */
+	if (size > gcache->total_bank * bsize)
+		size = gcache->total_bank * bsize;
 	gcache->ptr = malloc(gcache->total_bank * sizeof (Uint8*));
 	if (gcache->ptr == NULL)
 		return 1;
@@ -151,24 +182,25 @@ int init_sprite_cache(Uint32 size, Uint32 bsize) {
 	gcache->data = malloc(gcache->size);
 	if (gcache->data == NULL) {
 		free(gcache->ptr);
+		gcache->ptr = NULL;
 		return 1;
 	}
 	logMsg("INIT CACHE %p\n", gcache->data);
 
-	//gcache->max_slot=((float)gcache->size/0x4000000)*TOTAL_GFX_BANK;
-	//gcache->max_slot=((float)gcache->size/memory.rom.tiles.size)*gcache->total_bank;
 	gcache->max_slot = size / gcache->slot_size;
-	//gcache->slot_size=0x4000000/TOTAL_GFX_BANK;
 	logMsg("Allocating %08x for gfx cache (%d %d slot)\n", gcache->size, gcache->max_slot, gcache->slot_size);
-	gcache->usage = malloc(gcache->max_slot * sizeof (Uint32));
-	for (i = 0; i < gcache->max_slot; i++)
-		gcache->usage[i] = -1;
+	gcache->usage = malloc(gcache->max_slot * sizeof (int));
+	gcache->lru_prev = malloc(gcache->max_slot * sizeof (int));
+	gcache->lru_next = malloc(gcache->max_slot * sizeof (int));
+	reset_sprite_cache_lru(gcache);
 	//printf("inbuf size= %d\n",compressBound(bsize));
+	if (!gcache->map) {
 #ifdef WIZ
-	gcache->in_buf = malloc(bsize + 1024);
+		gcache->in_buf = malloc(bsize + 1024);
 #else
-	gcache->in_buf = malloc(compressBound(bsize));
+		gcache->in_buf = malloc(compressBound(bsize));
 #endif
+	}
 	return 0;
 }
 
@@ -186,6 +218,14 @@ void free_sprite_cache(void) {
 		free(gcache->usage);
 		gcache->usage = NULL;
 	}
+	if (gcache->lru_prev) {
+		free(gcache->lru_prev);
+		gcache->lru_prev = NULL;
+	}
+	if (gcache->lru_next) {
+		free(gcache->lru_next);
+		gcache->lru_next = NULL;
+	}
 	if (gcache->in_buf) {
 		free(gcache->in_buf);
 		gcache->in_buf = NULL;
@@ -194,31 +234,36 @@ void free_sprite_cache(void) {
 
 Uint8 *get_cached_sprite_ptr(Uint32 tileno) {
 	GFX_CACHE *gcache = &memory.vid.spr_cache;
-	static int pos = 0;
-	static int init = 1;
-	int tile_sh = ~((gcache->slot_size >> 7) - 1);
-
-	int bank = ((tileno & tile_sh) / (gcache->slot_size >> 7));
+	int bank = tileno >> (gcache->slot_shift - 7);
 	int a;
-	int r;
 	Uint32 cmp_size;
+	const Uint8 *cmp_data;
 	uLongf dst_size;
 
 	if (gcache->ptr[bank]) {
 		/* The bank is present in the cache */
+		touch_sprite_cache_slot(gcache, (gcache->ptr[bank] - gcache->data) >> gcache->slot_shift);
 		return gcache->ptr[bank];
 	}
-	/* We have to find a slot for this bank */
-	a = pos;
-	pos++;
-	if (pos >= gcache->max_slot) pos = 0;
+	/* Recycle the least recently used slot for this bank */
+	a = gcache->lru_tail;
+	touch_sprite_cache_slot(gcache, a);
 	//printf("Offset for bank is %d\n",gcache->offset[bank]);
 
-	fseek(gcache->gno, gcache->offset[bank], SEEK_SET);
-	r = fread(&cmp_size, sizeof (Uint32), 1, gcache->gno);
-	r = fread(gcache->in_buf, cmp_size, 1, gcache->gno);
+	if (gcache->map) {
+		/* Decompress straight from the mapped file, only the touched
+		 * pages of the compressed data are ever paged in */
+		memcpy(&cmp_size, gcache->map + gcache->offset[bank], sizeof (Uint32));
+		cmp_data = gcache->map + gcache->offset[bank] + sizeof (Uint32);
+	} else {
+		int r;
+		fseek(gcache->gno, gcache->offset[bank], SEEK_SET);
+		r = fread(&cmp_size, sizeof (Uint32), 1, gcache->gno);
+		r = fread(gcache->in_buf, cmp_size, 1, gcache->gno);
+		cmp_data = gcache->in_buf;
+	}
 	dst_size = gcache->slot_size;
-	r = uncompress(gcache->data + a * gcache->slot_size, &dst_size, gcache->in_buf, cmp_size);
+	uncompress(gcache->data + a * gcache->slot_size, &dst_size, cmp_data, cmp_size);
 
 	gcache->ptr[bank] = gcache->data + a * gcache->slot_size;
 
@@ -577,7 +622,7 @@ void draw_screen(void *emuTaskPtr, void *emuVideoPtr) {
 			if (sx >= -16 && sx + 15 < 336 && sy >= 0 && sy + 15 < 256) {
 
 				penusage = PEN_USAGE(tileno);
-				if (memory.vid.spr_cache.data) {
+				if (memory.vid.spr_cache.data && penusage != TILE_INVISIBLE) {
 					memory.rom.tiles.p = get_cached_sprite_ptr(tileno);
 					tileno = (tileno & ((memory.vid.spr_cache.slot_size >> 7) - 1));
 				}
@@ -797,7 +842,7 @@ void draw_screen_scanline(int start_line, int end_line, int refresh, void *emuTa
 			if (tileatr & 0x02) yoffs ^= 0x0f; /* flip y */
 
 			penusage = PEN_USAGE(tileno);
-			if (memory.vid.spr_cache.data) {
+			if (memory.vid.spr_cache.data && penusage != TILE_INVISIBLE) {
 				memory.rom.tiles.p = get_cached_sprite_ptr(tileno);
 				tileno = (tileno & ((memory.vid.spr_cache.slot_size >> 7) - 1));
 			}
@@ -35,10 +35,15 @@ typedef struct gfx_cache {
 	Uint8 **ptr/*[TOTAL_GFX_BANK]*/; /* ptr[i] Contain a pointer to cached data for bank i */
 	int max_slot; /* Maximal numer of bank that can be cached (depend on cache size) */
 	int slot_size;
-	int *usage;   /* contain index to the banks in used order */
+	int *usage;   /* contain the bank held by each slot, -1 if free */
+	int *lru_prev, *lru_next; /* slots in most recently used order */
+	int lru_head, lru_tail;
+	int slot_shift; /* log2(slot_size) */
 	FILE *gno;
     Uint32 *offset;
     Uint8* in_buf;
+	Uint8 *map;   /* the whole .gno file when it could be memory-mapped */
+	size_t map_size;
 }GFX_CACHE;
 
 typedef struct VIDEO {
@@ -23,6 +23,8 @@
 #include <imagine/fs/ArchiveFS.hh>
 #include <imagine/util/ScopeGuard.hh>
 #include "internal.hh"
+#include <atomic>
+#include <vector>
 
 extern "C"
 {
@@ -210,6 +212,10 @@ void gn_init_pbar(uint action,int size)
 			{
 				str = "Building Cache...\n(may take a while)";
 			}
+			bcase PBAR_ACTION_CONVERT:
+			{
+				str = "Converting Graphics...";
+			}
 		}
 		onLoadProgress(0, size, str);
 	}
@@ -224,6 +230,49 @@ void gn_update_pbar(int pos)
 	}
 }
 
+CLINK void gn_parallel_for(Uint32 items, Uint32 align, gn_range_func func, void *data, int pbarBase)
+{
+	if(!items)
+		return;
+	align = std::max(align, 1u);
+	const uint threads = std::clamp(std::thread::hardware_concurrency(), 1u, 8u);
+	// use several ranges per thread to balance the load and give the progress bar some granularity
+	const Uint32 maxRanges = threads * 8;
+	Uint32 rangeSize = (items + maxRanges - 1) / maxRanges;
+	rangeSize = (rangeSize + align - 1) / align * align;
+	const Uint32 ranges = (items + rangeSize - 1) / rangeSize;
+	std::atomic_uint32_t nextRange{}, doneItems{};
+	auto runRange = [&]()
+	{
+		Uint32 r = nextRange++;
+		if(r >= ranges)
+			return false;
+		Uint32 start = r * rangeSize;
+		Uint32 end = std::min(start + rangeSize, items);
+		func(start, end, data);
+		doneItems += end - start;
+		return true;
+	};
+	const uint extraThreads = std::min(threads, ranges) - 1;
+	std::vector<std::thread> workers{};
+	workers.reserve(extraThreads);
+	iterateTimes(extraThreads, i)
+	{
+		workers.emplace_back([&](){ while(runRange()); });
+	}
+	while(runRange())
+	{
+		if(pbarBase >= 0)
+			gn_update_pbar(pbarBase + doneItems);
+	}
+	for(auto &t : workers)
+	{
+		t.join();
+	}
+	if(pbarBase >= 0)
+		gn_update_pbar(pbarBase + items);
+}
+
 static auto openGngeoDataIO(const char *filename)
 {
 	#ifdef __ANDROID__
@@ -0,0 +1,385 @@
+/*  This file is part of NEO.emu.
+
+	NEO.emu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	NEO.emu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with NEO.emu.  If not, see <http://www.gnu.org/licenses/> */
+
+// Loads a ROM set from its zip (plus parent & BIOS zips) with the gngeo loader and writes
+// the decrypted, pre-converted .gno dump that NEO.emu maps and streams sprites from.
+// Copy the output to NEO.emu's save path to use it. Build from this directory with:
+// G="-DHAVE_CONFIG_H -DIMAGINE_CONFIG_H=stddef.h -I../src -I../src/gngeo -I../../imagine/include"
+// cc -c -O2 $G ../src/gngeo/roms.c ../src/gngeo/neocrypt.c ../src/gngeo/neoboot.c ../src/gngeo/mame_layer.c
+// c++ -std=c++17 -O2 $G mkgno.cc roms.o neocrypt.o neoboot.o mame_layer.o -lz -lpthread -o mkgno
+
+#include <zlib.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdarg>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+extern "C"
+{
+	#include <gngeo/roms.h>
+	#include <gngeo/conf.h>
+	#include <gngeo/emu.h>
+	#include <gngeo/memory.h>
+	#include <gngeo/video.h>
+	#include <gngeo/menu.h>
+	#include <gngeo/unzip.h>
+	#include <gngeo/resfile.h>
+
+	CONFIG conf{};
+	neo_mem memory{};
+}
+
+static bool verbose = false;
+static std::string datafilePath;
+static CONF_ITEM rompathConfItem{};
+static const char *pbarLabel = "";
+static int pbarSize = 0;
+
+static uint16_t get16(const uint8_t *p) { return p[0] | (p[1] << 8); }
+static uint32_t get32(const uint8_t *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+struct ZipEntry
+{
+	std::string name;
+	uint32_t crc, compSize, size, localOffset;
+	uint16_t method;
+};
+
+struct PKZIP
+{
+	FILE *file;
+	std::vector<ZipEntry> entries;
+};
+
+struct ZFILE
+{
+	std::vector<uint8_t> data;
+	size_t pos;
+};
+
+static bool readEntry(PKZIP &zip, const ZipEntry &e, std::vector<uint8_t> &out)
+{
+	uint8_t local[30];
+	if(fseek(zip.file, e.localOffset, SEEK_SET) || fread(local, sizeof(local), 1, zip.file) != 1
+		|| get32(local) != 0x04034b50)
+		return false;
+	fseek(zip.file, get16(local + 26) + get16(local + 28), SEEK_CUR);
+	std::vector<uint8_t> comp(e.compSize);
+	if(e.compSize && fread(comp.data(), e.compSize, 1, zip.file) != 1)
+		return false;
+	if(e.method == 0)
+	{
+		out = std::move(comp);
+		return true;
+	}
+	if(e.method != 8)
+	{
+		fprintf(stderr, "unsupported compression method %d for %s\n", e.method, e.name.c_str());
+		return false;
+	}
+	out.resize(e.size);
+	z_stream strm{};
+	if(inflateInit2(&strm, -MAX_WBITS) != Z_OK)
+		return false;
+	strm.next_in = comp.data();
+	strm.avail_in = comp.size();
+	strm.next_out = out.data();
+	strm.avail_out = out.size();
+	int rc = inflate(&strm, Z_FINISH);
+	inflateEnd(&strm);
+	return rc == Z_STREAM_END;
+}
+
+static PKZIP *openZip(const char *path)
+{
+	FILE *f = fopen(path, "rb");
+	if(!f)
+		return nullptr;
+	// find the end of central directory record, allowing for a trailing comment
+	fseek(f, 0, SEEK_END);
+	long fileSize = ftell(f);
+	long tailSize = std::min(fileSize, 0xFFFFL + 22);
+	std::vector<uint8_t> tail(tailSize);
+	fseek(f, fileSize - tailSize, SEEK_SET);
+	if(fread(tail.data(), tailSize, 1, f) != 1)
+	{
+		fclose(f);
+		return nullptr;
+	}
+	const uint8_t *eocd{};
+	for(long i = tailSize - 22; i >= 0; i--)
+	{
+		if(get32(&tail[i]) == 0x06054b50)
+		{
+			eocd = &tail[i];
+			break;
+		}
+	}
+	if(!eocd)
+	{
+		fprintf(stderr, "%s isn't a zip file\n", path);
+		fclose(f);
+		return nullptr;
+	}
+	std::vector<uint8_t> cd(get32(eocd + 12));
+	fseek(f, get32(eocd + 16), SEEK_SET);
+	if(cd.size() && fread(cd.data(), cd.size(), 1, f) != 1)
+	{
+		fclose(f);
+		return nullptr;
+	}
+	auto zip = new PKZIP{f, {}};
+	size_t pos = 0;
+	for(unsigned i = 0, entries = get16(eocd + 10); i < entries && pos + 46 <= cd.size(); i++)
+	{
+		const uint8_t *h = &cd[pos];
+		if(get32(h) != 0x02014b50)
+			break;
+		uint16_t nameLen = get16(h + 28);
+		zip->entries.push_back({{(const char*)h + 46, nameLen},
+			get32(h + 16), get32(h + 20), get32(h + 24), get32(h + 42), get16(h + 10)});
+		pos += 46 + nameLen + get16(h + 30) + get16(h + 32);
+	}
+	return zip;
+}
+
+static bool readArchiveFile(const char *zipPath, const char *filename, std::vector<uint8_t> &out)
+{
+	auto zip = openZip(zipPath);
+	if(!zip)
+		return false;
+	bool found = false;
+	for(auto &e : zip->entries)
+	{
+		if(e.name == filename)
+		{
+			found = readEntry(*zip, e, out);
+			break;
+		}
+	}
+	gn_close_zip(zip);
+	return found;
+}
+
+extern "C"
+{
+	CONF_ITEM *cf_get_item_by_name(const char *name)
+	{
+		static CONF_ITEM conf{};
+		if(!strcmp(name, "rompath"))
+			return &rompathConfItem;
+		return &conf;
+	}
+
+	struct PKZIP *gn_open_zip(const char *path)
+	{
+		return openZip(path);
+	}
+
+	void gn_close_zip(struct PKZIP *zf)
+	{
+		fclose(zf->file);
+		delete zf;
+	}
+
+	int gn_strictROMChecking()
+	{
+		return 0;
+	}
+
+	struct ZFILE *gn_unzip_fopen(struct PKZIP *zf, const char *filename, uint32_t file_crc)
+	{
+		for(auto &e : zf->entries)
+		{
+			if(e.name == filename || e.crc == file_crc)
+			{
+				auto z = new ZFILE{{}, 0};
+				if(!readEntry(*zf, e, z->data))
+				{
+					fprintf(stderr, "error reading %s from archive\n", e.name.c_str());
+					delete z;
+					return nullptr;
+				}
+				return z;
+			}
+		}
+		if(verbose)
+			fprintf(stderr, "file:%s crc32:0x%X not found in archive\n", filename, file_crc);
+		return nullptr;
+	}
+
+	void gn_unzip_fclose(struct ZFILE *z)
+	{
+		delete z;
+	}
+
+	int gn_unzip_fread(struct ZFILE *z, uint8_t *data, unsigned int size)
+	{
+		size = std::min<size_t>(size, z->data.size() - z->pos);
+		memcpy(data, z->data.data() + z->pos, size);
+		z->pos += size;
+		return size;
+	}
+
+	uint8_t *gn_unzip_file_malloc(struct PKZIP *zf, const char *filename, uint32_t file_crc, unsigned int *outlen)
+	{
+		auto z = gn_unzip_fopen(zf, filename, file_crc);
+		if(!z)
+			return nullptr;
+		auto buff = (uint8_t*)malloc(z->data.size());
+		memcpy(buff, z->data.data(), z->data.size());
+		*outlen = z->data.size();
+		gn_unzip_fclose(z);
+		return buff;
+	}
+
+	ROM_DEF *res_load_drv(const char *name)
+	{
+		std::string drvFilename = std::string{DATAFILE_PREFIX "rom/"} + name + ".drv";
+		std::vector<uint8_t> buff;
+		if(!readArchiveFile(datafilePath.c_str(), drvFilename.c_str(), buff))
+		{
+			fprintf(stderr, "Can't open driver %s\n", name);
+			return nullptr;
+		}
+		// Fill out the driver struct, same layout as read by NEO.emu
+		auto drv = (ROM_DEF*)calloc(sizeof(ROM_DEF), 1);
+		size_t pos = 0;
+		auto read = [&](void *dest, size_t size)
+			{
+				size = pos < buff.size() ? std::min(size, buff.size() - pos) : 0;
+				memcpy(dest, &buff[pos], size);
+				pos += size;
+			};
+		auto read32 = [&]() { uint32_t v = 0; if(pos + 4 <= buff.size()) v = get32(&buff[pos]); pos += 4; return v; };
+		read(drv->name, 32);
+		read(drv->parent, 32);
+		read(drv->longname, 128);
+		drv->year = read32();
+		for(int i = 0; i < 10; i++)
+			drv->romsize[i] = read32();
+		drv->nb_romfile = read32();
+		for(unsigned i = 0; i < drv->nb_romfile; i++)
+		{
+			read(drv->rom[i].filename, 32);
+			read(&drv->rom[i].region, 1);
+			drv->rom[i].src = read32();
+			drv->rom[i].dest = read32();
+			drv->rom[i].size = read32();
+			drv->rom[i].crc = read32();
+		}
+		return drv;
+	}
+
+	void *res_load_data(const char *name)
+	{
+		std::vector<uint8_t> buff;
+		if(!readArchiveFile(datafilePath.c_str(), name, buff))
+		{
+			fprintf(stderr, "Can't open data file %s\n", name);
+			return nullptr;
+		}
+		auto data = malloc(buff.size());
+		memcpy(data, buff.data(), buff.size());
+		return data;
+	}
+
+	void gn_init_pbar(uint action, int size)
+	{
+		static const char *labels[]{"Loading...", "Decrypting...", "Loading...", "Building Cache...", "Converting Graphics..."};
+		pbarLabel = action < 5 ? labels[action] : "";
+		pbarSize = size;
+		gn_update_pbar(0);
+	}
+
+	void gn_update_pbar(int pos)
+	{
+		fprintf(stderr, "\r%-24s %3d%%", pbarLabel, pbarSize ? (int)((int64_t)pos * 100 / pbarSize) : 0);
+		if(pos >= pbarSize)
+			fprintf(stderr, "\n");
+	}
+
+	void gn_parallel_for(Uint32 items, Uint32 align, gn_range_func func, void *data, int pbar_base)
+	{
+		unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+		Uint32 chunk = (items + threads - 1) / threads;
+		chunk = (chunk + align - 1) / align * align;
+		std::vector<std::thread> workers;
+		for(Uint32 start = 0; start < items; start += chunk)
+		{
+			workers.emplace_back(func, start, std::min(start + chunk, items), data);
+		}
+		for(auto &t : workers)
+			t.join();
+		if(pbar_base >= 0)
+			gn_update_pbar(pbar_base + items);
+	}
+
+	// the sprite cache and video state aren't used when only dumping
+	int init_sprite_cache(Uint32 size, Uint32 bsize) { return 1; }
+	void free_sprite_cache(void) {}
+	void init_video(void) {}
+
+	void logger_printf(LoggerSeverity severity, const char *msg, ...)
+	{
+		if(!verbose)
+			return;
+		va_list args;
+		va_start(args, msg);
+		vfprintf(stderr, msg, args);
+		va_end(args);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	int arg = 1;
+	if(arg < argc && !strcmp(argv[arg], "-v"))
+	{
+		verbose = true;
+		arg++;
+	}
+	if(argc - arg < 3)
+	{
+		fprintf(stderr, "usage: %s [-v] <gngeo.dat> <rom dir> <game name> [output .gno]\n", argv[0]);
+		return 1;
+	}
+	datafilePath = argv[arg];
+	snprintf(CF_STR((&rompathConfItem)), sizeof(rompathConfItem.data.dt_str.str), "%s", argv[arg + 1]);
+	std::string gameName = argv[arg + 2];
+	std::string outPath = argc - arg > 3 ? argv[arg + 3] : gameName + ".gno";
+
+	// the BIOS isn't stored in the dump unless the game has a custom one, any MVS BIOS will do
+	conf.system = SYS_ARCADE;
+	conf.country = CTY_EUROPE;
+	char romerror[1024]{};
+	if(!dr_load_game(gameName.data(), romerror))
+	{
+		fprintf(stderr, "error loading %s: %s\n", gameName.c_str(), romerror);
+		return 1;
+	}
+	if(!dr_save_gno(&memory.rom, outPath.data()))
+	{
+		fprintf(stderr, "error writing %s\n", outPath.c_str());
+		return 1;
+	}
+	printf("wrote %s\n", outPath.c_str());
+	return 0;
+}
@@ -180,6 +180,9 @@ void FCEUD_LoadStateFrom(void);
 //you may also need to maintain your own internal state
 void FCEUD_SetInput(bool fourscore, bool microphone, ESI port0, ESI port1, ESIFC fcexp);
 
+//called when the game strobes the joypads so the driver can update the port data right before it's read
+void FCEUD_LatchInput(void);
+
 
 void FCEUD_MovieRecordTo(void);
 void FCEUD_MovieReplayFrom(void);
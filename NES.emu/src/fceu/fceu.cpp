@@ -230,6 +230,8 @@ void (*GameStateRestore)(int version);
 
 readfunc ARead[0x10000];
 writefunc BWrite[0x10000];
+uint8 *ReadPage[32];
+static uint8 ReadPageIsCart[32];
 static readfunc *AReadG;
 static writefunc *BWriteG;
 static int RWWrap = 0;
@@ -287,6 +289,7 @@ void FlushGenieRW(void) {
 		AReadG = NULL;
 		BWriteG = NULL;
 		RWWrap = 0;
+		UpdateReadPages(0x8000, 0xFFFF);
 	}
 }
 
@@ -313,6 +316,7 @@ void SetReadHandler(int32 start, int32 end, readfunc func) {
 	else
 		for (x = end; x >= start; x--)
 			ARead[x] = func;
+	UpdateReadPages(start, end);
 }
 
 writefunc GetWriteHandler(int32 a) {
@@ -373,6 +377,35 @@ static DECLFR(ARAMH) {
 	return RAM[A & 0x7FF];
 }
 
+//Points ReadPage[] at the memory behind each 2KB page whose reads all go through CartBR
+//or the internal RAM handlers, so the CPU core can read it without calling a handler.
+//Pages with any other handler, including cheat substitutions, get NULL.
+void UpdateReadPages(int32 start, int32 end) {
+	for (int32 p = start >> 11; p <= (end >> 11); p++) {
+		readfunc func = ARead[p << 11];
+		uint8 *ptr = NULL;
+		int x;
+		for (x = 1; x < 0x800; x++)
+			if (ARead[(p << 11) + x] != func)
+				break;
+		if (x == 0x800) {
+			if (func == CartBR)
+				ptr = Page[p];
+			else if (RAM && ((p == 0 && func == ARAML) || (p > 0 && p < 4 && func == ARAMH)))
+				ptr = RAM - (p << 11);
+		}
+		ReadPageIsCart[p] = x == 0x800 && func == CartBR;
+		ReadPage[p] = ptr;
+	}
+}
+
+//called after Page[] changes for the given pages
+void SyncCartReadPages(int first, int count) {
+	for (int p = first; p < first + count; p++)
+		if (ReadPageIsCart[p])
+			ReadPage[p] = Page[p];
+}
+
 
 void ResetGameLoaded(void) {
 	if (GameInfo) FCEU_CloseGame();
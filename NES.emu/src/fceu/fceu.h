@@ -75,6 +75,10 @@ void FCEU_WriteRomByte(uint32 i, uint8 value);
 
 extern readfunc ARead[0x10000];
 extern writefunc BWrite[0x10000];
+//direct pointers for 2KB pages read without a handler, NULL if a page needs ARead
+extern uint8 *ReadPage[32];
+void UpdateReadPages(int32 start, int32 end);
+void SyncCartReadPages(int first, int count);
 
 enum GI {
 	GI_RESETM2	=1,
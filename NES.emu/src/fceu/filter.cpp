@@ -12,6 +12,8 @@
 
 #include <cmath>
 #include <cstdio>
+#include <cstring>
+#include <chrono>
 
 static int32 sq2coeffs[SQ2NCOEFFS];
 static int32 coeffs[NCOEFFS];
@@ -93,55 +95,56 @@ void SexyFilter(int32 *in, int32 *out, int32 count)
    code to be higher, or you *might* overflow the FIR code.
 */
 
-int32 NeoFilterSound(int32 *in, int32 *out, uint32 inlen, int32 *leftover)
+/* The FIR loops below are the original per-output dot products with the
+   symmetric coefficient table walked forwards over contiguous input, which
+   lets the compiler vectorize them. Since only the order of the integer
+   additions changes, the output is bit-exact with the scalar version.
+*/
+
+template <unsigned NCO>
+static int32 FIRFilterBlock(const int32 *in, int32 *out, const int32 *__restrict co, uint32 max, uint32 &pos)
 {
-	uint32 x;
-	uint32 max;
-	int32 *outsave=out;
 	int32 count=0;
+	uint32 x;
+	for(x=pos;x<max;x+=mrratio)
+	{
+		const int32 *__restrict S=&in[(x>>16)-NCO+1];
+		int32 acc=0,acc2=0;
+		for(unsigned c=0;c<NCO;c++)
+		{
+			acc+=(S[c]*co[c])>>6;
+			acc2+=(S[c+1]*co[c])>>6;
+		}
+		acc=((int64)acc*(65536-(x&65535))+(int64)acc2*(x&65535))>>(16+11);
+		out[count++]=acc;
+	}
+	pos=x;
+	return count;
+}
+
+static SoundFilterStats filterStats;
+
+static void FinishFilterSound(int32 *out, int32 count)
+{
+	if(GameExpSound.NeoFill)
+	 GameExpSound.NeoFill(out,count);
 
-//	for(x=0;x<inlen;x++)
-//	{
-//	 if(in[x]>mva){ mva=in[x]; printf("%ld\n",in[x]);}
-//	}
-        max=(inlen-1)<<16;
+	SexyFilter(out,out,count);
+	if(FSettings.lowpass)
+	 SexyFilter2(out,count);
+}
+
+int32 NeoFilterSound(int32 *in, int32 *out, uint32 inlen, int32 *leftover)
+{
+	auto startTime=std::chrono::steady_clock::now();
+	uint32 x=mrindex;
+	uint32 max=(inlen-1)<<16;
+	int32 count;
 
 	if(FSettings.soundq==2)
-        for(x=mrindex;x<max;x+=mrratio)
-        {
-			int32 acc=0,acc2=0;
-			unsigned int c;
-			int32 *S,*D;
-
-			for(c=SQ2NCOEFFS,S=&in[(x>>16)-SQ2NCOEFFS],D=sq2coeffs;c;c--,D++)
-			{
-				acc+=(S[c]**D)>>6;
-				acc2+=(S[1+c]**D)>>6;
-			}
-
-			acc=((int64)acc*(65536-(x&65535))+(int64)acc2*(x&65535))>>(16+11);
-			*out=acc;
-			out++;
-			count++;
-        }
+	 count=FIRFilterBlock<SQ2NCOEFFS>(in,out,sq2coeffs,max,x);
 	else
-		for(x=mrindex;x<max;x+=mrratio)
-		{
-			int32 acc=0,acc2=0;
-			unsigned int c;
-			const int32 *S,*D;
-
-			for(c=NCOEFFS,S=&in[(x>>16)-NCOEFFS],D=coeffs;c;c--,D++)
-			{
-				acc+=(S[c]**D)>>6;
-				acc2+=(S[1+c]**D)>>6;
-			}
-
-			acc=((int64)acc*(65536-(x&65535))+(int64)acc2*(x&65535))>>(16+11);
-			*out=acc;
-			out++;
-			count++;
-		}
+	 count=FIRFilterBlock<NCOEFFS>(in,out,coeffs,max,x);
 
 	mrindex=x-max;
 
@@ -156,15 +159,116 @@ int32 NeoFilterSound(int32 *in, int32 *out, uint32 inlen, int32 *leftover)
          *leftover=NCOEFFS+1;
 	}
 
-	if(GameExpSound.NeoFill)
-	 GameExpSound.NeoFill(outsave,count);
+	FinishFilterSound(out,count);
+	filterStats.nsecs+=std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-startTime).count();
+	filterStats.cycles+=inlen;
+	filterStats.samples+=count;
+	return(count);
+}
 
-	SexyFilter(outsave,outsave,count);
-	if(FSettings.lowpass)
-	 SexyFilter2(outsave,count);
+/* Band-limited step synthesis: instead of running the FIR over every CPU cycle,
+   only the cycles where the mixed output changes are visited and each change is
+   added to the output as a windowed-sinc step (Blackman window, 16 taps, 32
+   phases, cutoff at 0.45 of the output rate). The result isn't bit-exact with
+   the FIR path but has the same DC gain, with slightly more rolloff above
+   ~18kHz at 44.1kHz and aliasing attenuated by about 70dB. */
+
+enum { BLIP_PHASE_BITS=5, BLIP_PHASES=1<<BLIP_PHASE_BITS, BLIP_TAPS=16, BLIP_KERNEL_SHIFT=15 };
+
+static int32 blipKernel[BLIP_PHASES][BLIP_TAPS];
+static int32 blipBuf[2048+512+BLIP_TAPS];
+static uint64 blipFactor; /* output samples per CPU cycle, 32.32 fixed point */
+static uint64 blipOffset; /* fractional output position carried between frames */
+static int32 blipAmp, blipLastIn, blipGain;
+
+static void MakeBlipKernel(void)
+{
+	const double fc=0.45;
+	for(int p=0;p<BLIP_PHASES;p++)
+	{
+		double h[BLIP_TAPS], sum=0;
+		for(int k=0;k<BLIP_TAPS;k++)
+		{
+			double t=(k-(BLIP_TAPS/2-1))-(double)p/BLIP_PHASES;
+			double sinc=t==0 ? 1. : std::sin(2*M_PI*fc*t)/(2*M_PI*fc*t);
+			double w=(t+BLIP_TAPS/2)/BLIP_TAPS;
+			double window=0.42-0.5*std::cos(2*M_PI*w)+0.08*std::cos(4*M_PI*w);
+			h[k]=sinc*window;
+			sum+=h[k];
+		}
+		/* normalize each phase to unity gain so steps don't cause DC drift */
+		int32 isum=0;
+		for(int k=0;k<BLIP_TAPS;k++)
+		{
+			blipKernel[p][k]=std::lround(h[k]/sum*(1<<BLIP_KERNEL_SHIFT));
+			isum+=blipKernel[p][k];
+		}
+		blipKernel[p][BLIP_TAPS/2-1]+=(1<<BLIP_KERNEL_SHIFT)-isum;
+	}
+}
+
+static inline void BlipAddDelta(uint64 pos, int32 delta)
+{
+	int32 *b=&blipBuf[pos>>32];
+	const int32 *k=blipKernel[(pos>>(32-BLIP_PHASE_BITS))&(BLIP_PHASES-1)];
+	int32 sum=0;
+	for(int i=0;i<BLIP_TAPS;i++)
+	{
+		int32 v=((int64)delta*k[i])>>BLIP_KERNEL_SHIFT;
+		b[i]+=v;
+		sum+=v;
+	}
+	/* put the rounding error in the center tap so the step height is exact */
+	b[BLIP_TAPS/2-1]+=delta-sum;
+}
+
+int32 BlipFilterSound(int32 *in, int32 *out, uint32 inlen, int32 *leftover)
+{
+	auto startTime=std::chrono::steady_clock::now();
+	uint64 pos=blipOffset;
+	int32 last=blipLastIn;
+	for(uint32 x=0;x<inlen;x++,pos+=blipFactor)
+	{
+		int32 v=in[x];
+		if(v!=last)
+		{
+			BlipAddDelta(pos,v-last);
+			last=v;
+		}
+	}
+	blipLastIn=last;
+	int32 count=pos>>32;
+	blipOffset=pos&0xFFFFFFFF;
+
+	int32 amp=blipAmp;
+	for(int32 x=0;x<count;x++)
+	{
+		amp+=blipBuf[x];
+		out[x]=((int64)amp*blipGain)>>16;
+	}
+	blipAmp=amp;
+	memmove(blipBuf,blipBuf+count,BLIP_TAPS*sizeof(int32));
+	memset(blipBuf+BLIP_TAPS,0,count*sizeof(int32));
+
+	*leftover=0;
+
+	FinishFilterSound(out,count);
+	filterStats.nsecs+=std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-startTime).count();
+	filterStats.cycles+=inlen;
+	filterStats.samples+=count;
 	return(count);
 }
 
+SoundFilterStats GetSoundFilterStats(void)
+{
+	return filterStats;
+}
+
+void ResetSoundFilterStats(void)
+{
+	filterStats={};
+}
+
 void MakeFilters(int32 rate)
 {
  const int32 *tabs[6]={C44100NTSC,C44100PAL,C48000NTSC,C48000PAL,C96000NTSC,
@@ -196,6 +300,20 @@ void MakeFilters(int32 rate)
   for(x=0;x<NCOEFFS>>1;x++)
    coeffs[x]=coeffs[NCOEFFS-1-x]=tmp[x];
 
+ if(FSettings.soundq==3)
+ {
+  /* match the DC gain of the FIR, sum(coeffs) / 2^(6+11) in 16.16 fixed point */
+  int64 sum=0;
+  for(x=0;x<NCOEFFS;x++)
+   sum+=coeffs[x];
+  blipGain=sum>>1;
+  blipFactor=(uint64)((double)rate*4294967296.0/(PAL?PAL_CPU:NTSC_CPU));
+  blipOffset=0;
+  blipAmp=blipLastIn=0;
+  memset(blipBuf,0,sizeof(blipBuf));
+  MakeBlipKernel();
+ }
+
  #ifdef MOO
  /* Some tests involving precision and error. */
  {
@@ -1,3 +1,18 @@
+#ifndef _FCEU_FILTER_H
+#define _FCEU_FILTER_H
+
+struct SoundFilterStats
+{
+	uint64 nsecs;
+	uint64 cycles;
+	uint64 samples;
+};
+
 int32 NeoFilterSound(int32 *in, int32 *out, uint32 inlen, int32 *leftover);
+int32 BlipFilterSound(int32 *in, int32 *out, uint32 inlen, int32 *leftover);
+SoundFilterStats GetSoundFilterStats(void);
+void ResetSoundFilterStats(void);
 void MakeFilters(int32 rate);
 void SexyFilter(int32 *in, int32 *out, int32 count);
+
+#endif
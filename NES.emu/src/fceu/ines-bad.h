@@ -1,41 +1,40 @@
-{ 0xecf78d8a13a030a6ULL, "Ai Sensei no Oshiete", INESB_HACKED },
-{ 0x4712856d3e12f21fULL, "Akumajou Densetsu", INESB_HACKED },
-{ 0x10f90ba5bd55c22eULL, "Alien Syndrome", INESB_HACKED },
+{ 0x001c0bb9c358252aULL, "110-in-1", INESB_CORRUPT },
+{ 0x02bdcf375704784bULL, "Erika to Satoru no Yume Bouken", INESB_HACKED },
+{ 0x04afae4ad480c11cULL, "Gradius 2", INESB_HACKED },
 { 0x0d69ab3ad28ad1c2ULL, "Banana", INESB_INCOMPLETE },
-{ 0x85d2c348a161cdbfULL, "Bio Senshi Dan", INESB_HACKED },
+{ 0x103fc85d978b861bULL, "Sweet Home", INESB_CORRUPT },
+{ 0x10f90ba5bd55c22eULL, "Alien Syndrome", INESB_HACKED },
+{ 0x1895afc6eef26c7dULL, "Super Mario Bros.", INESB_HACKED },
 { 0x18fdb7c16aa8cb5cULL, "Bucky O'Hare", INESB_CORRUPT },
-{ 0xe27c48302108d11bULL, "Chibi Maruko Chan", INESB_HACKED },
-{ 0x9d1f505c6ba507bfULL, "Contra", INESB_HACKED },
+{ 0x23214fe456fba2ceULL, "Ganbare Goemon 2", INESB_HACKED },
+{ 0x27da2b0c500dc346ULL, "Fire Emblem", INESB_HACKED },
+{ 0x30471e773f7cdc89ULL, "Famista 94", INESB_HACKED },
+{ 0x3716c4bebf885344ULL, "Super Mario Bros.", INESB_HACKED },
+{ 0x4712856d3e12f21fULL, "Akumajou Densetsu", INESB_HACKED },
+{ 0x500b267abb323005ULL, "Dragon Warrior 4", INESB_CORRUPT },
 { 0x60936436d3ea0ab6ULL, "Crisis Force", INESB_HACKED },
-{ 0xcf31097ddbb03c5dULL, "Crystalis (Prototype)", INESB_CORRUPT },
-{ 0x92080a8ce94200eaULL, "Digital Devil Story II", INESB_HACKED },
 { 0x6c2a2f95c2fe4b6eULL, "Dragon Ball", INESB_HACKED },
 { 0x767aaff62963c58fULL, "Dragon Ball", INESB_HACKED },
-{ 0x97f133d8bc1c28dbULL, "Dragon Ball", INESB_HACKED },
-{ 0x500b267abb323005ULL, "Dragon Warrior 4", INESB_CORRUPT },
-{ 0x02bdcf375704784bULL, "Erika to Satoru no Yume Bouken", INESB_HACKED },
-{ 0xd4fea9d2633b9186ULL, "Famista 91", INESB_HACKED },
-{ 0xfdf8c812839b61f0ULL, "Famista 92", INESB_HACKED },
-{ 0xb5bb1d0fb47d0850ULL, "Famista 93", INESB_HACKED },
-{ 0x30471e773f7cdc89ULL, "Famista 94", INESB_HACKED },
 { 0x76c5c44ffb4a0bd7ULL, "Fantasy Zone", INESB_HACKED },
-{ 0xb470bfb90e2b1049ULL, "Fire Emblem Gaiden", INESB_HACKED },
-{ 0x27da2b0c500dc346ULL, "Fire Emblem", INESB_HACKED },
-{ 0x23214fe456fba2ceULL, "Ganbare Goemon 2", INESB_HACKED },
-{ 0xbf8b22524e8329d9ULL, "Ganbare Goemon Gaiden", INESB_HACKED },
-{ 0xa97041c3da0134e3ULL, "Gegege no Kitarou 2", INESB_INCOMPLETE },
+{ 0x7979dc51da86f19fULL, "110-in-1", INESB_CORRUPT },
 { 0x805db49a86db5449ULL, "Goonies", INESB_HACKED },
-{ 0xc5abdaa65ac49b6bULL, "Gradius 2", INESB_HACKED },
-{ 0x04afae4ad480c11cULL, "Gradius 2", INESB_HACKED },
+{ 0x81c1de64550a1531ULL, "Nobunaga no Yabou Zenkokuban", INESB_HACKED },
+{ 0x85d2c348a161cdbfULL, "Bio Senshi Dan", INESB_HACKED },
+{ 0x92080a8ce94200eaULL, "Digital Devil Story II", INESB_HACKED },
+{ 0x97f133d8bc1c28dbULL, "Dragon Ball", INESB_HACKED },
 { 0x9b4bad37b5498992ULL, "Gradius 2", INESB_HACKED },
+{ 0x9d1f505c6ba507bfULL, "Contra", INESB_HACKED },
+{ 0xa97041c3da0134e3ULL, "Gegege no Kitarou 2", INESB_INCOMPLETE },
 { 0xb068d4ac10ef848eULL, "Highway Star", INESB_HACKED },
+{ 0xb470bfb90e2b1049ULL, "Fire Emblem Gaiden", INESB_HACKED },
+{ 0xb5bb1d0fb47d0850ULL, "Famista 93", INESB_HACKED },
 { 0xbf5175271e5019c3ULL, "Kaiketsu Yanchamaru 3", INESB_HACKED },
-{ 0x81c1de64550a1531ULL, "Nobunaga no Yabou Zenkokuban", INESB_HACKED },
+{ 0xbf8b22524e8329d9ULL, "Ganbare Goemon Gaiden", INESB_HACKED },
+{ 0xc5abdaa65ac49b6bULL, "Gradius 2", INESB_HACKED },
+{ 0xcf31097ddbb03c5dULL, "Crystalis (Prototype)", INESB_CORRUPT },
+{ 0xd4fea9d2633b9186ULL, "Famista 91", INESB_HACKED },
+{ 0xe27c48302108d11bULL, "Chibi Maruko Chan", INESB_HACKED },
+{ 0xecf78d8a13a030a6ULL, "Ai Sensei no Oshiete", INESB_HACKED },
 { 0xfb4b508a236bbba3ULL, "Salamander", INESB_HACKED },
-{ 0x1895afc6eef26c7dULL, "Super Mario Bros.", INESB_HACKED },
-{ 0x3716c4bebf885344ULL, "Super Mario Bros.", INESB_HACKED },
+{ 0xfdf8c812839b61f0ULL, "Famista 92", INESB_HACKED },
 { 0xfffda4407d80885aULL, "Sweet Home", INESB_CORRUPT },
-{ 0x103fc85d978b861bULL, "Sweet Home", INESB_CORRUPT },
-{ 0x7979dc51da86f19fULL, "110-in-1", INESB_CORRUPT },
-{ 0x001c0bb9c358252aULL, "110-in-1", INESB_CORRUPT },
-{ 0, 0, 0 }
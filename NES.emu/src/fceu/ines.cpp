@@ -37,6 +37,7 @@
 #include "cheat.h"
 #include "vsuni.h"
 #include "driver.h"
+#include <emuframework/RomIdentity.hh>
 
 #include <cstdio>
 #include <cstdlib>
@@ -243,20 +244,16 @@ struct BADINF {
 	uint32 type;
 };
 
-static struct BADINF BadROMImages[] =
+static constexpr BADINF BadROMImages[] =
 {
 	#include "ines-bad.h"
 };
 
+static_assert(romDBIsSorted(BadROMImages, &BADINF::md5partial), "ines-bad.h must be sorted by md5partial");
+
 void CheckBad(uint64 md5partial) {
-	int32 x = 0;
-	while (BadROMImages[x].name) {
-		if (BadROMImages[x].md5partial == md5partial) {
-			FCEU_PrintError("The copy game you have loaded, \"%s\", is bad, and will not work properly in FCEUX.", BadROMImages[x].name);
-			return;
-		}
-		x++;
-	}
+	if (auto bad = findRomDBEntry(BadROMImages, md5partial, &BADINF::md5partial))
+		FCEU_PrintError("The copy game you have loaded, \"%s\", is bad, and will not work properly in FCEUX.", bad->name);
 }
 
 
@@ -326,10 +323,11 @@ static void CheckHInfo(void) {
 		0						/* Abandon all hope if the game has 0 in the lower 64-bits of its MD5 hash */
 	};
 
-	static struct CHINF moo[] =
+	static constexpr CHINF moo[] =
 	{
 		#include "ines-correct.h"
 	};
+	static_assert(romDBIsSorted(moo, &CHINF::crc32), "ines-correct.h must be sorted by crc32");
 	int32 tofix = 0, x, mask;
 	uint64 partialmd5 = 0;
 
@@ -354,45 +352,40 @@ static void CheckHInfo(void) {
 		break;
 	}
 
-	x = 0;
-	do {
-		if (moo[x].crc32 == iNESGameCRC32) {
-			if (moo[x].mapper >= 0) {
-				if (moo[x].mapper & 0x800 && VROM_size) {
-					VROM_size = 0;
-					free(VROM);
-					VROM = NULL;
-					tofix |= 8;
-				}
-				if (moo[x].mapper & 0x1000)
-					mask = 0xFFF;
-				else
-					mask = 0xFF;
-				if (MapperNo != (moo[x].mapper & mask)) {
-					tofix |= 1;
-					MapperNo = moo[x].mapper & mask;
-				}
+	if (auto fix = findRomDBEntry(moo, iNESGameCRC32, &CHINF::crc32)) {
+		if (fix->mapper >= 0) {
+			if (fix->mapper & 0x800 && VROM_size) {
+				VROM_size = 0;
+				free(VROM);
+				VROM = NULL;
+				tofix |= 8;
 			}
-			if (moo[x].mirror >= 0) {
-				if (moo[x].mirror == 8) {
-					if (Mirroring == 2) {	/* Anything but hard-wired(four screen). */
-						tofix |= 2;
-						Mirroring = 0;
-					}
-				} else if (Mirroring != moo[x].mirror) {
-					if (Mirroring != (moo[x].mirror & ~4))
-						if ((moo[x].mirror & ~4) <= 2)	/* Don't complain if one-screen mirroring
-														needs to be set(the iNES header can't
-														hold this information).
-														*/
-							tofix |= 2;
-					Mirroring = moo[x].mirror;
+			if (fix->mapper & 0x1000)
+				mask = 0xFFF;
+			else
+				mask = 0xFF;
+			if (MapperNo != (fix->mapper & mask)) {
+				tofix |= 1;
+				MapperNo = fix->mapper & mask;
+			}
+		}
+		if (fix->mirror >= 0) {
+			if (fix->mirror == 8) {
+				if (Mirroring == 2) {	/* Anything but hard-wired(four screen). */
+					tofix |= 2;
+					Mirroring = 0;
 				}
+			} else if (Mirroring != fix->mirror) {
+				if (Mirroring != (fix->mirror & ~4))
+					if ((fix->mirror & ~4) <= 2)	/* Don't complain if one-screen mirroring
+													needs to be set(the iNES header can't
+													hold this information).
+													*/
+						tofix |= 2;
+				Mirroring = fix->mirror;
 			}
-			break;
 		}
-		x++;
-	} while (moo[x].mirror >= 0 || moo[x].mapper >= 0);
+	}
 
 	x = 0;
 	while (savie[x] != 0) {
@@ -741,8 +734,6 @@ BMAPPINGLocal bmap[] = {
 };
 
 int iNESLoad(const char *name, FCEUFILE *fp, int OverwriteVidMode) {
-	struct md5_context md5;
-
 	if (FCEU_fread(&head, 1, 16, fp) != 16 || memcmp(&head, "NES\x1A", 4))
 		return 0;
 
@@ -821,16 +812,14 @@ int iNESLoad(const char *name, FCEUFILE *fp, int OverwriteVidMode) {
 	if (VROM_size)
 		FCEU_fread(VROM, 0x2000, VROM_size, fp);
 
-	md5_starts(&md5);
-	md5_update(&md5, ROM, ROM_size << 14);
-
-	iNESGameCRC32 = CalcCRC32(0, ROM, ROM_size << 14);
-
-	if (VROM_size) {
-		iNESGameCRC32 = CalcCRC32(iNESGameCRC32, VROM, VROM_size << 13);
-		md5_update(&md5, VROM, VROM_size << 13);
-	}
-	md5_finish(&md5, iNESCart.MD5);
+	// CRC32 & MD5 in a single pass over the PRG and CHR data
+	RomHasher hasher;
+	hasher.update(ROM, ROM_size << 14);
+	if (VROM_size)
+		hasher.update(VROM, VROM_size << 13);
+	auto digest = hasher.finish();
+	iNESGameCRC32 = digest.crc32;
+	memcpy(iNESCart.MD5, digest.md5.data(), sizeof(iNESCart.MD5));
 	memcpy(&GameInfo->MD5, &iNESCart.MD5, sizeof(iNESCart.MD5));
 
 	iNESCart.CRC32 = iNESGameCRC32;
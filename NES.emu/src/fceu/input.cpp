@@ -177,6 +177,16 @@ static DECLFW(B4016)
 
 		//mbg 6/7/08 - I guess he means that the input drivers could track the strobing themselves
 		//I dont see why it is unreasonable here.
+		if(!FCEUMOV_Mode(MOVIEMODE_PLAY|MOVIEMODE_RECORD) && !FCEUnetplay)
+		{
+			//refresh gamepad data at the strobe instead of only at the start of the frame
+			FCEUD_LatchInput();
+			for(int i=0;i<2;i++)
+			{
+				if(joyports[i].type==SI_GAMEPAD)
+					joyports[i].driver->Update(i,joyports[i].ptr,joyports[i].attrib);
+			}
+		}
 		for(int i=0;i<2;i++)
 			joyports[i].driver->Strobe(i);
 		if(portFC.driver)
@@ -70,7 +70,8 @@ static void CopySprites(uint8 *target);
 static void Fixit1(void);
 static uint32 ppulut1[256];
 static uint32 ppulut2[256];
-static uint32 ppulut3[128];
+//one byte per pixel, in pixel order
+static uint64 ppulutrow[256];
 
 static bool new_ppu_reset = false;
 
@@ -300,7 +301,7 @@ void newppu_hacky_emergency_reset()
 static void makeppulut(void) {
 	int x;
 	int y;
-	int cc, xo, pixel;
+	int pixel;
 
 
 	for (x = 0; x < 256; x++) {
@@ -310,16 +311,11 @@ static void makeppulut(void) {
 		ppulut2[x] = ppulut1[x] << 1;
 	}
 
-	for (cc = 0; cc < 16; cc++) {
-		for (xo = 0; xo < 8; xo++) {
-			ppulut3[xo | (cc << 3)] = 0;
-			for (pixel = 0; pixel < 8; pixel++) {
-				int shiftr;
-				shiftr = (pixel + xo) / 8;
-				shiftr *= 2;
-				ppulut3[xo | (cc << 3)] |= ((cc >> shiftr) & 3) << (2 + pixel * 4);
-			}
-		}
+	for (x = 0; x < 256; x++) {
+		uint8 row[8];
+		for (pixel = 0; pixel < 8; pixel++)
+			row[pixel] = (x >> (7 - pixel)) & 1;
+		memcpy(&ppulutrow[x], row, 8);
 	}
 }
 
@@ -1082,8 +1078,8 @@ static int spork = 0;
 
 // lasttile is really "second to last tile."
 static void RefreshLine(int lastpixel) {
-	static uint32 pshift[2];
-	static uint32 atlatch;
+	//palette indexes of the last two fetched tiles, pixels are drawn from XOffset onward
+	static uint64 bgrows[2];
 	uint32 smorkus = RefreshAddr;
 
 	#define RefreshAddr smorkus
@@ -1748,6 +1744,7 @@ void FCEUPPU_Power(void) {
 		ARead[x + 7] = A2007;
 		BWrite[x + 7] = B2007;
 	}
+	UpdateReadPages(0x2000, 0x3FFF);
 	BWrite[0x4014] = B4014;
 }
 
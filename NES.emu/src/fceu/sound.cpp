@@ -1065,7 +1065,10 @@ int FlushEmulateSound(int32 *WaveFinal)
     *tmpo=(b&65535)+wlookup2[(b>>16)&255]+wlookup1[b>>24];
     tmpo++;
    }
-   end=NeoFilterSound(WaveHi,WaveFinal,SOUNDTS,&left);
+   if(FSettings.soundq==3)
+    end=BlipFilterSound(WaveHi,WaveFinal,SOUNDTS,&left);
+   else
+    end=NeoFilterSound(WaveHi,WaveFinal,SOUNDTS,&left);
 
    memmove(WaveHi,WaveHi+SOUNDTS-left,left*sizeof(uint32));
    memset(WaveHi+left,0,sizeof(WaveHi)-left*sizeof(uint32));
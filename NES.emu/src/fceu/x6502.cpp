@@ -44,9 +44,11 @@ void (*MapIRQHook)(int a);
  if(!overclocking) soundtimestamp+=__x; \
 }
 
-//normal memory read
+//normal memory read, pages backed directly by ROM or RAM skip the handler call
 static INLINE uint8 RdMem(unsigned int A)
 {
+ if(uint8 *p = ReadPage[A >> 11])
+  return(_DB=p[A]);
  return(_DB=ARead[A](A));
 }
 
@@ -62,7 +64,7 @@ static INLINE void WrMem(unsigned int A, uint8 V)
 static INLINE uint8 RdRAM(unsigned int A)
 {
   //bbit edited: this was changed so cheat substituion would work
-  return(_DB=ARead[A](A));
+  return RdMem(A);
   // return(_DB=RAM[A]);
 }
 
@@ -77,7 +79,7 @@ static INLINE void WrRAM(unsigned int A, uint8 V)
 uint8 X6502_DMR(uint32 A)
 {
  ADDCYC(1);
- return(X.DB=ARead[A](A));
+ return RdMem(A);
 }
 
 void X6502_DMW(uint32 A, uint8 V)
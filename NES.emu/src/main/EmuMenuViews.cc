@@ -274,11 +274,12 @@ class CustomAudioOptionView : public AudioOptionView
 		FCEUI_SetSoundQuality(quaility);
 	}
 
-	TextMenuItem qualityItem[3]
+	TextMenuItem qualityItem[4]
 	{
 		{"Normal", [](){ setQuality(0); }},
 		{"High", []() { setQuality(1); }},
-		{"Highest", []() { setQuality(2); }}
+		{"Highest", []() { setQuality(2); }},
+		{"High (Fast Filter)", []() { setQuality(3); }}
 	};
 
 	MultiChoiceMenuItem quality
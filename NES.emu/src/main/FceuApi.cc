@@ -106,6 +106,8 @@ void FCEUD_NetworkClose(void) {}
 
 void FCEUD_VideoChanged() {}
 
+void FCEUD_LatchInput() { EmuSystem::latchInput(); }
+
 bool FCEUI_AviIsRecording(void) { return 0; }
 
 bool FCEUI_AviDisableMovieMessages() { return 1; }
@@ -29,6 +29,7 @@
 #include <fceu/cheat.h>
 #include <fceu/video.h>
 #include <fceu/sound.h>
+#include <fceu/filter.h>
 #include <fceu/palette.h>
 
 using PalArray = std::array<pal, 512>;
@@ -163,6 +164,13 @@ void EmuSystem::saveBackupMem() // for manually saving when not closing game
 
 void EmuSystem::closeSystem()
 {
+	if(auto stats = GetSoundFilterStats();
+		stats.samples)
+	{
+		logMsg("sound filter: %.1fns per output sample, %.1f cycles per sample",
+			(double)stats.nsecs / stats.samples, (double)stats.cycles / stats.samples);
+		ResetSoundFilterStats();
+	}
 	FCEUI_CloseGame();
 	fceuCheats = 0;
 }
@@ -395,7 +403,7 @@ void emulateSound(EmuAudio *audio)
 	if(audio)
 	{
 		int16 sound16[maxAudioFrames];
-		iterateTimes(maxAudioFrames, i)
+		iterateTimes(frames, i)
 		{
 			sound16[i] = sound[i];
 		}
@@ -82,22 +82,35 @@ uint32		cycles_extra;	//How many extra state changes?
 
 uint16 fetch16(void)
 {
-	uint16 a = loadW(pc);
+	uint16 a;
+	if (const uint8 *ptr = fetchPtr())
+	{
+		memcpy(&a, ptr, 2);
+		a = le16toh(a);
+	}
+	else
+		a = loadW(pc);
 	pc += 2;
 	return a;
 }
 
 uint32 fetch24(void)
 {
-	uint32 b, a = loadW(pc);
-	pc += 2;
-	b = loadB(pc++);
+	uint32 b, a = fetch16();
+	b = fetch8();
 	return (b << 16) | a;
 }
 
 uint32 fetch32(void)
 {
-	uint32 a = loadL(pc);
+	uint32 a;
+	if (const uint8 *ptr = fetchPtr())
+	{
+		memcpy(&a, ptr, 4);
+		a = le32toh(a);
+	}
+	else
+		a = loadL(pc);
 	pc += 4;
 	return a;
 }
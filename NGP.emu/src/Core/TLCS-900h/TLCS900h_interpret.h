@@ -42,6 +42,10 @@
 
 #ifndef __TLCS900H_INTERPRET__
 #define __TLCS900H_INTERPRET__
+
+#include "../mem.h"
+#include "TLCS900h_registers.h"
+
 //=============================================================================
 
 //Interprets a single instruction from 'pc', 
@@ -70,7 +74,28 @@ extern bool brCode;
 
 //=============================================================================
 
-#define FETCH8		loadB(pc++)
+//Host address of the code at 'pc', or NULL if it has to be read through
+//the memory map. A pending EEPROM status read is cleared by the next
+//read outside RAM, so fetches take the full path until it's done.
+static inline const uint8 *fetchPtr(void)
+{
+	const uint8 *page = codePages[(pc >> 16) & 0xFF];
+	if (page && !eepromStatusEnable)
+		return page + (pc & 0xFFFF);
+	return NULL;
+}
+
+static inline uint8 fetch8(void)
+{
+	if (const uint8 *ptr = fetchPtr())
+	{
+		pc++;
+		return *ptr;
+	}
+	return loadB(pc++);
+}
+
+#define FETCH8		fetch8()
 
 uint16 fetch16(void) __attribute__ ((hot));
 uint32 fetch24(void) __attribute__ ((hot));
@@ -42,6 +42,7 @@
 #include "neopop.h"
 #include "mem.h"
 #include "gfx.h"
+#include <algorithm>
 
 //=============================================================================
 
@@ -93,3 +94,152 @@ void gfx_delayed_settings(void)
 }
 
 //=============================================================================
+
+//Decodes one row of a tile into 8 pixels from left to right, each stored
+//as (palette << 2) | colour so colour 0 stays transparent.
+static inline void decodeTileRow(uint8* dst, uint16 tile, uint8 tiley,
+	uint16 mirror, uint8 pal)
+{
+	uint16 data = le16toh(*(uint16*)(ram + 0xA000 + (tile * 16) + (tiley * 2)));
+	uint8 palBits = pal << 2;
+
+	//The rightmost pixel is in the lowest bits, unless flipped
+	if (mirror)
+	{
+		for (int x = 0; x < 8; x++, data >>= 2)
+			dst[x] = palBits | (data & 3);
+	}
+	else
+	{
+		for (int x = 7; x >= 0; x--, data >>= 2)
+			dst[x] = palBits | (data & 3);
+	}
+}
+
+//Decodes the tiles of a scroll plane covering the current scanline,
+//screen pixel x is at line[x + (scrollx & 7)].
+static void decodePlaneLine(uint8* line, uint16 mapAddr, uint8 scrollx,
+	uint8 scrolly, bool colour)
+{
+	uint8 y = scanline + scrolly, row = y & 7;
+	uint8* map = ram + mapAddr + ((y >> 3) << 6);
+
+	for (int tx = 0; tx <= SCREEN_WIDTH / 8; tx++)
+	{
+		uint16 data16 = le16toh(*(uint16*)(map + ((((scrollx >> 3) + tx) & 31) << 1)));
+		uint8 pal = colour ? (data16 & 0x1E00) >> 9 : (data16 & 0x2000) >> 13;
+
+		decodeTileRow(line + tx * 8, data16 & 0x01FF,
+			(data16 & 0x4000) ? 7 - row : row, data16 & 0x8000, pal);
+	}
+}
+
+void gfx_draw_line(const GfxLinePalettes &pal, bool colour)
+{
+	int x, left, right;
+
+	//Get the current scanline
+	scanline = ram[0x8009];
+	cfb_scanline = cfb + (scanline * SCREEN_WIDTH);	//Calculate fast offset
+
+	//Above or below the window
+	if (scanline < winy || scanline >= winy + winh)
+	{
+		std::fill_n(cfb_scanline, SCREEN_WIDTH, pal.window);
+		return;
+	}
+
+	left = std::min((int)winx, SCREEN_WIDTH);
+	right = std::max(std::min(winx + winw, SCREEN_WIDTH), left);
+	std::fill_n(cfb_scanline, left, pal.window);
+	std::fill_n(cfb_scanline + right, SCREEN_WIDTH - right, pal.window);
+	memset(zbuffer, 0, SCREEN_WIDTH);
+
+	//Scroll planes, drawn together since the front plane always covers the
+	//back one & neither is depth tested against anything
+	{
+		uint8 line1[SCREEN_WIDTH + 8], line2[SCREEN_WIDTH + 8];
+		decodePlaneLine(line1, 0x9000, scroll1x, scroll1y, colour);
+		decodePlaneLine(line2, 0x9800, scroll2x, scroll2y, colour);
+
+		//Swap Front/Back scroll planes?
+		const uint8* front = planeSwap ? line2 + (scroll2x & 7) : line1 + (scroll1x & 7);
+		const uint8* back = planeSwap ? line1 + (scroll1x & 7) : line2 + (scroll2x & 7);
+		const uint16* frontPal = planeSwap ? pal.scroll2 : pal.scroll1;
+		const uint16* backPal = planeSwap ? pal.scroll1 : pal.scroll2;
+
+		for (x = left; x < right; x++)
+		{
+			if (front[x] & 3)
+			{
+				cfb_scanline[x] = frontPal[front[x]];
+				zbuffer[x] = ZDEPTH_FOREGROUND_SCROLL;
+			}
+			else if (back[x] & 3)
+			{
+				cfb_scanline[x] = backPal[back[x]];
+				zbuffer[x] = ZDEPTH_BACKGROUND_SCROLL;
+			}
+			else
+				cfb_scanline[x] = pal.background;
+		}
+	}
+
+	//Draw Sprites
+	//Last sprite position, (defaults to top-left, sure?)
+	int16 lastSpriteX = 0;
+	int16 lastSpriteY = 0;
+	for (int spr = 0; spr < 64; spr++)
+	{
+		uint8 priority, row;
+		uint8 sx = ram[0x8800 + (spr * 4) + 2];	//X position
+		uint8 sy = ram[0x8800 + (spr * 4) + 3];	//Y position
+		int16 x = sx;
+		int16 y = sy;
+		uint16 data16;
+
+		data16 = le16toh(*(uint16*)(ram + 0x8800 + (spr * 4)));
+		priority = (data16 & 0x1800) >> 11;
+
+		if (data16 & 0x0400) x = lastSpriteX + sx;	//Horizontal chain?
+		if (data16 & 0x0200) y = lastSpriteY + sy;	//Vertical chain?
+
+		//Store the position for chaining
+		lastSpriteX = x;
+		lastSpriteY = y;
+
+		//Visible?
+		if (priority == 0)	continue;
+
+		//Scroll the sprite
+		x += scrollsprx;
+		y += scrollspry;
+
+		//Off-screen?
+		if (x > 248 && x < 256)	x = x - 256; else x &= 0xFF;
+		if (y > 248 && y < 256)	y = y - 256; else y &= 0xFF;
+
+		//In range?
+		if (scanline < y || scanline > y + 7)
+			continue;
+
+		uint8 pixels[8];
+		uint8 depth = priority << 1;
+		row = (scanline - y) & 7;	//Which row?
+		decodeTileRow(pixels, data16 & 0x01FF, (data16 & 0x4000) ? 7 - row : row,
+			data16 & 0x8000, colour ? ram[0x8C00 + spr] & 0xF : (data16 & 0x2000) >> 13);
+
+		for (int px = 0; px < 8; px++)
+		{
+			uint8 xx = x + px;	//Wraps around like the tile position
+
+			//Clip, then depth check, <= to stop later sprites overwriting pixels!
+			if (xx < left || xx >= right || (pixels[px] & 3) == 0 || depth <= zbuffer[xx])
+				continue;
+			zbuffer[xx] = depth;
+			cfb_scanline[xx] = pal.sprite[pixels[px]];
+		}
+	}
+}
+
+//=============================================================================
@@ -72,6 +72,18 @@ extern uint16 r,g,b;
 
 void gfx_delayed_settings(void);
 
+//Output pixels for one scanline, indexed by (palette << 2) | colour,
+//with the negative effect already applied
+struct GfxLinePalettes
+{
+	uint16 window, background;
+	uint16 scroll1[64], scroll2[64], sprite[64];
+};
+
+//Draws the current scanline from decoded tile rows, 'colour' selects
+//how palette numbers are read from tiles & sprites
+void gfx_draw_line(const GfxLinePalettes &pal, bool colour);
+
 //=============================================================================
 
 void gfx_draw_scanline_colour(void);
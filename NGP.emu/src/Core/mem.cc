@@ -133,6 +133,32 @@ static void memory_error(uint32 address, bool read)
 
 static uint32 memNullVal = 0;
 
+const uint8 *codePages[256];
+
+//Maps each 64KB page that translate_address_read() resolves to the same
+//ROM or BIOS region for every address in it. Pages touching RAM, I/O or
+//the end of the ROM are left NULL and keep going through the full lookup.
+static void update_code_pages(void)
+{
+	memset(codePages, 0, sizeof(codePages));
+
+	if (rom.data)
+	{
+		for (uint32 page = ROM_START >> 16; page <= 0xFE; page++)
+		{
+			uint32 start = page << 16, end = start + 0xFFFF;
+
+			if (end <= rom.realEnd)
+				codePages[page] = rom.data + (start & 0x1FFFFF);
+			else if (rom.length > 0x200000 && start > rom.realEnd &&
+				start >= HIROM_START && end <= rom.realHEnd)
+				codePages[page] = rom.data + 0x200000 + (start - HIROM_START);
+		}
+	}
+
+	codePages[BIOS_START >> 16] = bios;
+}
+
 void* translate_address_read(uint32 address)
 {
 	address &= 0xFFFFFF;
@@ -609,6 +635,8 @@ void reset_memory(void)
 
 	ram[0x8400] = 0xFF;	// LED on
 	ram[0x8402] = 0x80;	// Flash cycle = 1.3s
+
+	update_code_pages();
 }
 
 //=============================================================================
@@ -68,6 +68,10 @@ extern bool memory_flash_command;
 
 extern bool eepromStatusEnable;
 
+//Host addresses of the 64KB ROM & BIOS pages instruction fetches can read
+//directly, NULL where reads need translate_address_read()
+extern const uint8 *codePages[256];
+
 //=============================================================================
 
 uint8  loadB(uint32 address) __attribute__ ((hot));
@@ -280,7 +280,7 @@ void rom_unload(void)
 
 		flash_commit();
 
-		free(rom.data);
+		// rom.data is owned by the frontend
 		rom.data = NULL;
 		rom.length = 0;
 		rom_header = 0;
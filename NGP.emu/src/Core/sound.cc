@@ -117,156 +117,134 @@ static uint32 UpdateStep;	//Number of steps during one sample.
 
 //=============================================================================
 
-static uint16 sample_chip_tone(void)
-{
-	int i;
-
-	int vol[4];
-	unsigned int out;
-#if 0
-	int left;
-#endif
+//Samples are mixed in chunks, one channel at a time, so each channel's
+//state stays in locals for the whole chunk
+#define MIX_CHUNK 256
 
-	/* vol[] keeps track of how long each square wave stays */
-	/* in the 1 position during the sample period. */
-	vol[0] = vol[1] = vol[2] = vol[3] = 0;
+static void run_chip_tone(SoundChip* chip, int i, unsigned int* acc, int samples)
+{
+	int count = chip->Count[i];
+	int output = chip->Output[i];
+	const int period = chip->Period[i];
+	const int volume = chip->Volume[i];
 
-	for (i = 0; i < 3; i++)
+	if (!volume)
 	{
-		if (toneChip.Output[i]) vol[i] += toneChip.Count[i];
-		toneChip.Count[i] -= STEP;
-
-		/* Period[i] is the half period of the square wave. Here, in each */
-		/* loop I add Period[i] twice, so that at the end of the loop the */
-		/* square wave is in the same status (0 or 1) it was at the start. */
-		/* vol[i] is also incremented by Period[i], since the wave has been 1 */
-		/* exactly half of the time, regardless of the initial position. */
-		/* If we exit the loop in the middle, Output[i] has to be inverted */
-		/* and vol[i] incremented only if the exit status of the square */
-		/* wave is 1. */
-
-		while (toneChip.Count[i] <= 0)
+		/* Silent, only the square wave position has to advance. Count */
+		/* ends up in (0, Period] after as many half periods as needed, */
+		/* each of which inverts Output. */
+		count -= samples * STEP;
+		if (count <= 0)
 		{
-			toneChip.Count[i] += toneChip.Period[i];
-			if (toneChip.Count[i] > 0)
-			{
-				toneChip.Output[i] ^= 1;
-				if (toneChip.Output[i]) vol[i] += toneChip.Period[i];
-				break;
-			}
-			toneChip.Count[i] += toneChip.Period[i];
-			vol[i] += toneChip.Period[i];
+			int halfPeriods = (-count) / period + 1;
+			count += halfPeriods * period;
+			output ^= halfPeriods & 1;
 		}
-		if (toneChip.Output[i]) vol[i] -= toneChip.Count[i];
 	}
-
-#if 0
-	left = STEP;
-	do
+	else
 	{
-		int nextevent;
-
-		if (toneChip.Count[3] < left) nextevent = toneChip.Count[3];
-		else nextevent = left;
-
-		if (toneChip.Output[3]) vol[3] += toneChip.Count[3];
-		toneChip.Count[3] -= nextevent;
-		if (toneChip.Count[3] <= 0)
+		for (int s = 0; s < samples; s++)
 		{
-			if (toneChip.RNG & 1) toneChip.RNG ^= toneChip.NoiseFB;
-			toneChip.RNG >>= 1;
-			toneChip.Output[3] = toneChip.RNG & 1;
-			toneChip.Count[3] += toneChip.Period[3];
-			if (toneChip.Output[3]) vol[3] += toneChip.Period[3];
-		}
-		if (toneChip.Output[3]) vol[3] -= toneChip.Count[3];
-
-		left -= nextevent;
-	} while (left > 0);
-#endif
-
-
-	out = vol[0] * toneChip.Volume[0] + vol[1] * toneChip.Volume[1] +
-		vol[2] * toneChip.Volume[2];
+			/* vol keeps track of how long the square wave stays */
+			/* in the 1 position during the sample period. */
+			int vol = 0;
+
+			if (output) vol += count;
+			count -= STEP;
+
+			/* period is the half period of the square wave. Here, in each */
+			/* loop I add period twice, so that at the end of the loop the */
+			/* square wave is in the same status (0 or 1) it was at the start. */
+			/* vol is also incremented by period, since the wave has been 1 */
+			/* exactly half of the time, regardless of the initial position. */
+			/* If we exit the loop in the middle, output has to be inverted */
+			/* and vol incremented only if the exit status of the square */
+			/* wave is 1. */
+
+			while (count <= 0)
+			{
+				count += period;
+				if (count > 0)
+				{
+					output ^= 1;
+					if (output) vol += period;
+					break;
+				}
+				count += period;
+				vol += period;
+			}
+			if (output) vol -= count;
 
-	if (out > MAX_OUTPUT * STEP) out = MAX_OUTPUT * STEP;
+			acc[s] += vol * volume;
+		}
+	}
 
-	return out / STEP;
+	chip->Count[i] = count;
+	chip->Output[i] = output;
 }
 
-//=============================================================================
-
-static uint16 sample_chip_noise(void)
+static void run_chip_noise(SoundChip* chip, unsigned int* acc, int samples)
 {
-#if 0
-	int i;
-#endif
-
-	int vol[4];
-	unsigned int out;
-	int left;
-
-	/* vol[] keeps track of how long each square wave stays */
-	/* in the 1 position during the sample period. */
-	vol[0] = vol[1] = vol[2] = vol[3] = 0;
-
-#if 0
-	for (i = 0; i < 3; i++)
+	int count = chip->Count[3];
+	int output = chip->Output[3];
+	unsigned int rng = chip->RNG;
+	const int period = chip->Period[3];
+	const int volume = chip->Volume[3];
+	const int noiseFB = chip->NoiseFB;
+
+	if (!volume)
 	{
-		if (noiseChip.Output[i]) vol[i] += noiseChip.Count[i];
-		noiseChip.Count[i] -= STEP;
-
-		/* Period[i] is the half period of the square wave. Here, in each */
-		/* loop I add Period[i] twice, so that at the end of the loop the */
-		/* square wave is in the same status (0 or 1) it was at the start. */
-		/* vol[i] is also incremented by Period[i], since the wave has been 1 */
-		/* exactly half of the time, regardless of the initial position. */
-		/* If we exit the loop in the middle, Output[i] has to be inverted */
-		/* and vol[i] incremented only if the exit status of the square */
-		/* wave is 1. */
-
-		while (noiseChip.Count[i] <= 0)
+		/* Silent, only clock the noise generator for each event in the chunk */
+		int left = samples * STEP;
+		while (count <= left)
 		{
-			noiseChip.Count[i] += noiseChip.Period[i];
-			if (noiseChip.Count[i] > 0)
-			{
-				noiseChip.Output[i] ^= 1;
-				if (noiseChip.Output[i]) vol[i] += noiseChip.Period[i];
-				break;
-			}
-			noiseChip.Count[i] += noiseChip.Period[i];
-			vol[i] += noiseChip.Period[i];
+			left -= count;
+			if (rng & 1) rng ^= noiseFB;
+			rng >>= 1;
+			output = rng & 1;
+			count = period;
 		}
-		if (noiseChip.Output[i]) vol[i] -= noiseChip.Count[i];
+		count -= left;
 	}
-#endif
-
-	left = STEP;
-	do
+	else
 	{
-		int nextevent;
+		for (int s = 0; s < samples; s++)
+		{
+			int vol = 0;
+			int left = STEP;
+			do
+			{
+				int nextevent;
 
-		if (noiseChip.Count[3] < left) nextevent = noiseChip.Count[3];
-		else nextevent = left;
+				if (count < left) nextevent = count;
+				else nextevent = left;
 
-		if (noiseChip.Output[3]) vol[3] += noiseChip.Count[3];
-		noiseChip.Count[3] -= nextevent;
-		if (noiseChip.Count[3] <= 0)
-		{
-			if (noiseChip.RNG & 1) noiseChip.RNG ^= noiseChip.NoiseFB;
-			noiseChip.RNG >>= 1;
-			noiseChip.Output[3] = noiseChip.RNG & 1;
-			noiseChip.Count[3] += noiseChip.Period[3];
-			if (noiseChip.Output[3]) vol[3] += noiseChip.Period[3];
-		}
-		if (noiseChip.Output[3]) vol[3] -= noiseChip.Count[3];
+				if (output) vol += count;
+				count -= nextevent;
+				if (count <= 0)
+				{
+					if (rng & 1) rng ^= noiseFB;
+					rng >>= 1;
+					output = rng & 1;
+					count += period;
+					if (output) vol += period;
+				}
+				if (output) vol -= count;
 
-		left -= nextevent;
-	} while (left > 0);
+				left -= nextevent;
+			} while (left > 0);
 
+			acc[s] += vol * volume;
+		}
+	}
 
-	out = vol[3] * noiseChip.Volume[3];
+	chip->Count[3] = count;
+	chip->Output[3] = output;
+	chip->RNG = rng;
+}
 
+static uint16 chip_sample(unsigned int out)
+{
 	if (out > MAX_OUTPUT * STEP) out = MAX_OUTPUT * STEP;
 
 	return out / STEP;
@@ -276,13 +254,27 @@ static uint16 sample_chip_noise(void)
 
 void sound_update(uint16* chip_buffer, int length_bytes)
 {
-	while (length_bytes > 0)
+	unsigned int tone[MIX_CHUNK], noise[MIX_CHUNK];
+	int samples = (length_bytes + 1) / 2;	// 2 bytes = 16 bits
+
+	while (samples > 0)
 	{
+		int i, s, n = samples < MIX_CHUNK ? samples : MIX_CHUNK;
+
+		//Only the tone channels of the tone chip and the noise
+		//channel of the noise chip are audible
+		memset(tone, 0, n * sizeof(tone[0]));
+		memset(noise, 0, n * sizeof(noise[0]));
+		for (i = 0; i < 3; i++)
+			run_chip_tone(&toneChip, i, tone, n);
+		run_chip_noise(&noiseChip, noise, n);
+
 		//Mix a mono track out of: (Tone + Noise) >> 1
 		//Write it to the sound buffer
-		*(chip_buffer++) = (sample_chip_tone() + sample_chip_noise()) >> 1;
+		for (s = 0; s < n; s++)
+			*(chip_buffer++) = (chip_sample(tone[s]) + chip_sample(noise[s])) >> 1;
 
-		length_bytes -= 2;	// 2 bytes = 16 bits
+		samples -= n;
 	}
 }
 
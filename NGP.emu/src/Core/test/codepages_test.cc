@@ -0,0 +1,206 @@
+//---------------------------------------------------------------------------
+//	This program is free software; you can redistribute it and/or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation; either version 2 of the License, or
+//	(at your option) any later version. See also the license.txt file for
+//	additional informations.
+//---------------------------------------------------------------------------
+
+// Equivalence check of the codePages[] instruction fetch path. For several
+// cart sizes, with and without the BIOS installed, every address the fetch
+// functions read directly is also read through loadB/loadW/loadL, and both
+// must resolve to the same host memory and return the same values. Reads with
+// a pending EEPROM status request must still take the full memory map path.
+
+#include "neopop.h"
+#include "TLCS900h_registers.h"
+#include "TLCS900h_interpret.h"
+#include "bios.h"
+#include "mem.h"
+#include <imagine/logger/logger.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+//=============================================================================
+// normally supplied by the frontend
+
+uint32 frameskip_active = 0;
+
+CLINK void logger_printf(LoggerSeverity, const char*, ...) {}
+void system_message(const char*, ...) {}
+char* system_get_string(STRINGS) { return (char*)""; }
+void system_VBL(void) {}
+void system_sound_chipreset(void) {}
+bool system_comms_read(uint8_t*) { return 0; }
+bool system_comms_poll(uint8_t*) { return 0; }
+void system_comms_write(uint8_t) {}
+bool system_io_flash_read(uint8_t*, uint32) { return 0; }
+bool system_io_flash_write(uint8_t*, uint32) { return 1; }
+bool system_io_state_read(const char*, uint8_t*, uint32) { return 0; }
+
+//=============================================================================
+
+namespace
+{
+
+// the frontend maps the whole cart address space, zero-filled past the end of the ROM
+const uint32 maxRomSize = 0x400000;
+
+int failures = 0;
+
+void check(bool cond, const char *config, const char *what, uint32 address)
+{
+	if (!cond)
+	{
+		if (failures < 20)
+			printf("FAIL %s: %s at %06X\n", config, what, address);
+		++failures;
+	}
+}
+
+// fills 'len' bytes with a pattern that differs at every offset modulo 2^24
+void fillPattern(uint8 *data, uint32 len, uint32 seed)
+{
+	uint32 x = seed;
+	for (uint32 i = 0; i < len; i++)
+	{
+		x = x * 1664525 + 1013904223;
+		data[i] = (uint8)(x >> 24);
+	}
+}
+
+void loadCart(std::vector<uint8> &buff, uint32 romSize)
+{
+	if (!romSize)
+		return;
+	buff.assign(maxRomSize + 4, 0);
+	fillPattern(&buff[0], romSize, romSize);
+	memset(&buff[0], 0, sizeof(RomHeader));
+	memcpy(&buff[0], "COPYRIGHT BY SNK CORPORATION", 28);
+	memcpy(&buff[0x24], "CODEPAGES   ", 12);
+	rom.data = &buff[0];
+	rom.length = romSize;
+	rom_loaded();
+}
+
+uint32 fetchAt(uint32 (*fetch)(void), uint32 address)
+{
+	pc = address;
+	return fetch();
+}
+
+uint32 fetch8Func(void) { return FETCH8; }
+uint32 fetch16Func(void) { return fetch16(); }
+uint32 load24(uint32 address) { return loadW(address) | (loadB(address + 2) << 16); }
+
+// compares each fetch size starting at 'address' against the matching loads,
+// sizes that would read past 'end' are covered by the pointer check instead
+void compareFetches(const char *config, uint32 address, uint32 end, bool eepromStatus)
+{
+	uint32 space = end - address;
+	struct
+	{
+		uint32 bytes;
+		uint32 (*fetch)(void);
+		uint32 (*load)(uint32);
+		const char *what;
+	}
+	const sizes[] =
+	{
+		{1, fetch8Func, [](uint32 a) -> uint32 { return loadB(a); }, "FETCH8 != loadB"},
+		{2, fetch16Func, [](uint32 a) -> uint32 { return loadW(a); }, "fetch16 != loadW"},
+		{3, fetch24, load24, "fetch24 != loadW/loadB"},
+		{4, fetch32, loadL, "fetch32 != loadL"},
+	};
+	for (auto &s : sizes)
+	{
+		if (s.bytes > space)
+			break;
+		eepromStatusEnable = eepromStatus;
+		uint32 fetched = fetchAt(s.fetch, address);
+		bool fetchedEnable = eepromStatusEnable;
+		check(pc == address + s.bytes, config, "pc not advanced by the fetch size", address);
+		eepromStatusEnable = eepromStatus;
+		uint32 loaded = s.load(address);
+		check(fetched == loaded, config, s.what, address);
+		check(fetchedEnable == eepromStatusEnable, config, "EEPROM status state differs", address);
+	}
+}
+
+void testConfig(uint32 romSize, bool withBios)
+{
+	char config[64];
+	if (romSize)
+		snprintf(config, sizeof(config), "ROM 0x%X, %s BIOS", romSize, withBios ? "with" : "without");
+	else
+		snprintf(config, sizeof(config), "no ROM, %s BIOS", withBios ? "with" : "without");
+
+	std::vector<uint8> cart;
+	memset(bios, 0, sizeof(bios));
+	if (withBios)
+		bios_install();
+	loadCart(cart, romSize);
+	reset();
+
+	check(codePages[BIOS_START >> 16] == bios, config, "BIOS page not mapped", BIOS_START);
+	if (romSize)
+		check(codePages[ROM_START >> 16] == rom.data, config, "first ROM page not mapped", ROM_START);
+	if (romSize >= 0x210000)
+		check(codePages[HIROM_START >> 16] == rom.data + 0x200000, config, "first high ROM page not mapped", HIROM_START);
+
+	uint32 pages = 0;
+	for (uint32 page = 0; page < 256; page++)
+	{
+		// RAM reads are always safe to translate, other unmapped pages may
+		// point outside the ROM and are never read directly anyway
+		if (!codePages[page] && page != 0)
+			continue;
+		pages += codePages[page] != NULL;
+		uint32 end = codePages[page] ? (page + 1) << 16 : RAM_END + 1;
+		for (uint32 address = page << 16; address < end; address++)
+		{
+			if (codePages[page])
+				check(codePages[page] + (address & 0xFFFF) == translate_address_read(address),
+					config, "page pointer differs from translate_address_read()", address);
+			compareFetches(config, address, end, false);
+			compareFetches(config, address, end, true);
+		}
+	}
+
+	// a pending EEPROM status read must be answered on the next fetch too
+	if (romSize)
+	{
+		for (uint32 address : {0x220000u, 0x230000u})
+		{
+			eepromStatusEnable = TRUE;
+			uint32 status = fetchAt(fetch32, address);
+			check(status == 0xFFFFFFFF, config, "EEPROM status not returned by fetch32", address);
+			check(!eepromStatusEnable, config, "EEPROM status request not cleared", address);
+		}
+	}
+
+	printf("%s: %u direct pages compared\n", config, pages);
+	rom_unload();
+}
+
+} // anon namespace
+
+int main()
+{
+	const uint32 romSizes[] = {0, 0x80000, 0x123457, 0x200000, 0x280000, 0x3A5A5A, 0x400000};
+	for (uint32 romSize : romSizes)
+	{
+		testConfig(romSize, true);
+		testConfig(romSize, false);
+	}
+	if (failures)
+	{
+		printf("%d check(s) failed\n", failures);
+		return 1;
+	}
+
+	printf("all checks passed\n");
+	return 0;
+}
@@ -33,6 +33,7 @@ static constexpr auto pixFmt = IG::PIXEL_FMT_RGB565;
 static EmuSystemTask *emuSysTask{};
 static EmuVideo *emuVideo{};
 static IG::Pixmap srcPix{{{ngpResX, ngpResY}, pixFmt}, cfb};
+static IG::BufferView romBuffer{};
 
 EmuSystem::NameFilterFunc EmuSystem::defaultFsFilter =
 	[](const char *name)
@@ -114,23 +115,26 @@ void EmuSystem::saveBackupMem()
 void EmuSystem::closeSystem()
 {
 	rom_unload();
+	romBuffer = {};
 	logMsg("closing game %s", gameName().data());
 }
 
 static bool romLoad(IO &io)
 {
 	const uint maxRomSize = 0x400000;
-	auto data = (uint8_t*)calloc(maxRomSize, 1);
-	uint readSize = io.read(data, maxRomSize);
-	if(readSize > 0)
-	{
-		logMsg("read 0x%X byte rom", readSize);
-		rom.data = data;
-		rom.length = readSize;
-		return true;
-	}
-	free(data);
-	return false;
+	uint romSize = std::min(io.size(), (size_t)maxRomSize);
+	if(!romSize)
+		return false;
+	// the whole cart address space is readable, zero-filled past the end of the ROM,
+	// and flash writes only touch the pages they modify when the file is memory mapped
+	auto buff = io.bufferView(maxRomSize);
+	if(!buff)
+		return false;
+	logMsg("loaded 0x%X byte rom", romSize);
+	romBuffer = std::move(buff);
+	rom.data = (uint8_t*)romBuffer.data();
+	rom.length = romSize;
+	return true;
 }
 
 EmuSystem::Error EmuSystem::loadGame(IO &io, EmuSystemCreateParams, OnLoadProgressDelegate)
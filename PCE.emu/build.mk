@@ -9,6 +9,7 @@ main/input.cc \
 main/EmuControls.cc \
 main/EmuMenuViews.cc \
 common/CDImpl.cc \
+common/CDAccess_CDZ.cc \
 common/MDFNApi.cc \
 common/MThreading.cc \
 common/StreamImpl.cc \
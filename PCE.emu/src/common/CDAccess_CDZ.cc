@@ -0,0 +1,149 @@
+/*  This file is part of PCE.emu.
+
+	PCE.emu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	PCE.emu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with PCE.emu.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <mednafen/mednafen.h>
+#include <mednafen/cdrom/CDAccess_CDZ.h>
+
+namespace Mednafen
+{
+
+using namespace CDUtility;
+
+static uint8 subqControl(const CompressedCDImage::Track &track)
+{
+	return track.type == CompressedCDImage::TrackType::AUDIO ? 0 : SUBQ_CTRLF_DATA;
+}
+
+CDAccess_CDZ::CDAccess_CDZ(VirtualFS* vfs, const std::string& path)
+{
+	if(auto ec = image.open(path.c_str(), 32);
+		ec)
+	{
+		throw MDFN_Error(ec.value(), _("Error opening compressed CD image \"%s\": %s"), path.c_str(), ec.message().c_str());
+	}
+	tocd.Clear();
+	auto &firstTrack = image.track(0);
+	auto &lastTrack = image.track(image.tracks() - 1);
+	tocd.first_track = firstTrack.number;
+	tocd.last_track = lastTrack.number;
+	tocd.disc_type = DISC_TYPE_CDDA_OR_M1;
+	for(uint32 i = 0; i < image.tracks(); i++)
+	{
+		auto &track = image.track(i);
+		if(track.type == CompressedCDImage::TrackType::MODE2)
+			tocd.disc_type = DISC_TYPE_CD_XA;
+		tocd.tracks[track.number].lba = track.lba;
+		tocd.tracks[track.number].adr = ADR_CURPOS;
+		tocd.tracks[track.number].control = subqControl(track);
+		tocd.tracks[track.number].valid = true;
+	}
+	tocd.tracks[100].lba = image.sectors();
+	tocd.tracks[100].adr = ADR_CURPOS;
+	tocd.tracks[100].control = subqControl(lastTrack);
+	tocd.tracks[100].valid = true;
+}
+
+CDAccess_CDZ::~CDAccess_CDZ() {}
+
+void CDAccess_CDZ::MakeSubPQ(int32 lba, uint8 *SubPWBuf) const
+{
+	auto &track = image.track(image.trackForSector(lba));
+	bool inPregap = lba < (int32)track.lba;
+	uint32 lbaRelative = inPregap ? track.lba - 1 - lba : lba - track.lba;
+	uint8 buf[0xC]{};
+	buf[0] = ADR_CURPOS | (subqControl(track) << 4);
+	buf[1] = U8_to_BCD(track.number);
+	buf[2] = U8_to_BCD(inPregap ? 0 : 1);
+	ABA_to_AMSF_BCD(lbaRelative, &buf[3], &buf[4], &buf[5]);
+	ABA_to_AMSF_BCD(LBA_to_ABA(lba), &buf[7], &buf[8], &buf[9]);
+	subq_generate_checksum(buf);
+	uint8 pauseOr = inPregap ? 0x80 : 0x00;
+	for(int i = 0; i < 96; i++)
+		SubPWBuf[i] |= (((buf[i >> 3] >> (7 - (i & 0x7))) & 1) ? 0x40 : 0x00) | pauseOr;
+}
+
+int CDAccess_CDZ::Read_Raw_Sector(uint8 *buf, int32 lba)
+{
+	if(lba < 0)
+	{
+		synth_udapp_sector_lba(0xFF, tocd, lba, 0, buf);
+		return -1;
+	}
+	if((uint32)lba >= image.sectors())
+	{
+		synth_leadout_sector_lba(0xFF, tocd, lba, buf);
+		return -1;
+	}
+	if(!image.readSector(buf, lba))
+		throw MDFN_Error(0, _("Error reading sector %d"), lba);
+	if(image.hasSubchannel())
+		return 0;
+	memset(buf + 2352, 0, 96);
+	MakeSubPQ(lba, buf + 2352);
+	return 0;
+}
+
+bool CDAccess_CDZ::Fast_Read_Raw_PW_TSRE(uint8* pwbuf, int32 lba) const noexcept
+{
+	if(lba < 0)
+	{
+		subpw_synth_udapp_lba(tocd, lba, 0, pwbuf);
+		return true;
+	}
+	if((uint32)lba >= image.sectors())
+	{
+		subpw_synth_leadout_lba(tocd, lba, pwbuf);
+		return true;
+	}
+	if(image.hasSubchannel())
+		return false;
+	memset(pwbuf, 0, 96);
+	MakeSubPQ(lba, pwbuf);
+	return true;
+}
+
+void CDAccess_CDZ::Read_TOC(CDUtility::TOC *toc)
+{
+	*toc = tocd;
+}
+
+void CDAccess_CDZ::HintReadSector(int32 lba, int32 count)
+{
+	if(lba >= 0)
+		image.hintReadAhead(lba);
+}
+
+int CDAccess_CDZ::Read_Sector(uint8 *buf, int32 lba, uint32 size)
+{
+	uint8 data[2352 + 96];
+	if(lba < 0 || (uint32)lba >= image.sectors() || !image.readSector(data, lba))
+		return -1;
+	auto &track = image.track(image.trackForSector(lba));
+	switch(track.type)
+	{
+		case CompressedCDImage::TrackType::AUDIO:
+			memcpy(buf, data, size);
+			break;
+		case CompressedCDImage::TrackType::MODE1:
+			memcpy(buf, data + 16, size);
+			break;
+		case CompressedCDImage::TrackType::MODE2:
+			memcpy(buf, data + 24, size);
+			break;
+	}
+	return (int)track.type;
+}
+
+}
@@ -50,14 +50,21 @@ FileStream::FileStream(const std::string& path, const uint32 mode, const int do_
 	assert(!do_lock);
 	auto [openMode, attribs] = modeToAttribs(mode);
 	this->attribs = attribs;
-	if(auto ec = io.open(path.c_str(), IO::AccessHint::SEQUENTIAL, openMode);
+	FileIO file;
+	if(auto ec = file.open(path.c_str(), IO::AccessHint::SEQUENTIAL, openMode);
 		ec)
 	{
 		ErrnoHolder ene(errno);
 		throw MDFN_Error(ene.Errno(), _("Error opening file \"%s\": %s"), path.c_str(), ene.StrError());
 	}
+	io = file.makeGeneric();
 }
 
+FileStream::FileStream(GenericIO io):
+	io{std::move(io)},
+	attribs{Stream::ATTRIBUTE_READABLE}
+{}
+
 FileStream::~FileStream() {}
 
 uint64 FileStream::attributes(void)
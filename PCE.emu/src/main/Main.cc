@@ -19,14 +19,17 @@
 #include <emuframework/EmuAudio.hh>
 #include <emuframework/EmuVideo.hh>
 #include <emuframework/EmuInput.hh>
+#include <emuframework/CompressedCDImage.hh>
 #include <emuframework/EmuAppInlines.hh>
 #include "internal.hh"
 #include <imagine/util/ScopeGuard.hh>
+#include <imagine/io/BufferMapIO.hh>
 #include <mednafen/pce_fast/pce.h>
 #include <mednafen/pce_fast/huc.h>
 #include <mednafen/pce_fast/vdc.h>
 #include <mednafen/pce_fast/pcecd_drive.h>
 #include <mednafen/MemoryStream.h>
+#include <mednafen/FileStream.h>
 
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2011-2020\nRobert Broglia\nwww.explusalpha.com\n\nPortions (c) the\nMednafen Team\nmednafen.sourceforge.net";
 FS::PathString sysCardPath{};
@@ -66,7 +69,8 @@ bool hasHuCardExtension(const char *name)
 
 static bool hasCDExtension(const char *name)
 {
-	return string_hasDotExtension(name, "toc") || string_hasDotExtension(name, "cue") || string_hasDotExtension(name, "ccd");
+	return string_hasDotExtension(name, "toc") || string_hasDotExtension(name, "cue") || string_hasDotExtension(name, "ccd") ||
+		CompressedCDImage::hasExtension(name);
 }
 
 static bool hasPCEWithCDExtension(const char *name)
@@ -193,9 +197,21 @@ EmuSystem::Error EmuSystem::loadGame(IO &io, EmuSystemCreateParams, OnLoadProgre
 	{
 		try
 		{
-			auto size = io.size();
-			auto stream = std::make_unique<MemoryStream>(size, true);
-			io.read(stream->map(), stream->map_size());
+			std::unique_ptr<Stream> stream;
+			if(auto mapped = io.mmapConst();
+				mapped)
+			{
+				// read the ROM directly from the memory mapped file
+				BufferMapIO mapIO;
+				mapIO.open(mapped, io.size());
+				stream = std::make_unique<FileStream>(mapIO.makeGeneric());
+			}
+			else
+			{
+				auto size = io.size();
+				stream = std::make_unique<MemoryStream>(size, true);
+				io.read(stream->map(), stream->map_size());
+			}
 			MDFNFILE fp(&NVFS, std::move(stream), originalGameFileName().data());
 			GameFile gf{fp.active_vfs(), fp.active_dir_path(), fp.stream(), fp.ext, fp.fbase};
 			emuSys->Load(&gf);
@@ -61,6 +61,8 @@ class FileStream : public Stream
  };
 
  FileStream(const std::string& path, const uint32 mode, const int do_lock = false);
+ // read-only stream over an already opened IO, map() exposes its memory mapping if present
+ FileStream(GenericIO io);
  virtual ~FileStream() override;
 
  virtual uint64 attributes(void) override;
@@ -87,7 +89,7 @@ class FileStream : public Stream
  FileStream(const FileStream &);		// Copy constructor
  //FileStream(FileStream &);                // Copy constructor
 
- FileIO io;
+ GenericIO io;
  uint8 attribs;
 };
 
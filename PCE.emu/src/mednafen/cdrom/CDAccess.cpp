@@ -23,6 +23,7 @@
 #include "CDAccess.h"
 #include "CDAccess_Image.h"
 #include "CDAccess_CCD.h"
+#include "CDAccess_CDZ.h"
 
 namespace Mednafen
 {
@@ -43,6 +44,9 @@ CDAccess* CDAccess_Open(VirtualFS* vfs, const std::string& path, bool image_memc
 {
  CDAccess *ret = NULL;
 
+ if(CompressedCDImage::hasExtension(path.c_str()))
+  ret = new CDAccess_CDZ(vfs, path);
+ else
  #ifndef MDFN_CD_NO_CCD
  if(path.size() >= 4 && !MDFN_strazicmp(path.c_str() + path.size() - 4, ".ccd"))
   ret = new CDAccess_CCD(vfs, path, image_memcache);
@@ -0,0 +1,37 @@
+#ifndef __MDFN_CDACCESS_CDZ_H
+#define __MDFN_CDACCESS_CDZ_H
+
+#include "CDAccess.h"
+#include <emuframework/CompressedCDImage.hh>
+
+namespace Mednafen
+{
+
+// Adapts the EmuFramework compressed image reader to the CDAccess interface
+class CDAccess_CDZ final: public CDAccess
+{
+ public:
+
+ CDAccess_CDZ(VirtualFS* vfs, const std::string& path);
+ ~CDAccess_CDZ() final;
+
+ int Read_Raw_Sector(uint8 *buf, int32 lba) final;
+
+ bool Fast_Read_Raw_PW_TSRE(uint8* pwbuf, int32 lba) const noexcept final;
+
+ void Read_TOC(CDUtility::TOC *toc) final;
+
+ void HintReadSector(int32 lba, int32 count) final;
+
+ int Read_Sector(uint8 *buf, int32 lba, uint32 size) final;
+
+ private:
+
+ void MakeSubPQ(int32 lba, uint8 *SubPWBuf) const;
+
+ CompressedCDImage image;
+ CDUtility::TOC tocd;
+};
+
+}
+#endif
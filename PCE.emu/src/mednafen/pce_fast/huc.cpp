@@ -172,16 +172,27 @@ uint32 HuC_Load(Stream* fp)
   PCE_IsCD = 0;
 
 
-  HuCROM = new uint8[m_len];
-  memset(HuCROM, 0xFF, m_len);
-  fp->read(HuCROM, std::min<uint64>(m_len, len));
+  // Use the stream's memory mapping directly unless the ROM needs padding
+  // or must outlive the stream for the SF2 mapper.
+  const uint8* ROMData;
+  uint8* mapped = fp->map();
+
+  if(mapped && !sf2_mapper && len >= m_len && fp->map_size() >= fp->tell() + m_len)
+   ROMData = mapped + fp->tell();
+  else
+  {
+   HuCROM = new uint8[m_len];
+   memset(HuCROM, 0xFF, m_len);
+   fp->read(HuCROM, std::min<uint64>(m_len, len));
+   ROMData = HuCROM;
+  }
 
   md5_context md5;
   md5.starts();
-  md5.update(HuCROM, std::min<uint64>(m_len, len));
+  md5.update(ROMData, std::min<uint64>(m_len, len));
   md5.finish(MDFNGameInfo->MD5);
 
-  crc = crc32(0, HuCROM, std::min<uint64>(m_len, len));
+  crc = crc32(0, ROMData, std::min<uint64>(m_len, len));
 
   MDFN_printf(_("ROM:       %lluKiB\n"), (unsigned long long)(std::min<uint64>(m_len, len) / 1024));
   MDFN_printf(_("ROM CRC32: 0x%04x\n"), crc);
@@ -191,31 +202,32 @@ uint32 HuC_Load(Stream* fp)
 
   if(m_len == 0x60000)
   {
-   memcpy(ROMSpace + 0x00 * 8192, HuCROM, 0x20 * 8192);
-   memcpy(ROMSpace + 0x20 * 8192, HuCROM, 0x20 * 8192);
-   memcpy(ROMSpace + 0x40 * 8192, HuCROM + 0x20 * 8192, 0x10 * 8192);
-   memcpy(ROMSpace + 0x50 * 8192, HuCROM + 0x20 * 8192, 0x10 * 8192);
-   memcpy(ROMSpace + 0x60 * 8192, HuCROM + 0x20 * 8192, 0x10 * 8192);
-   memcpy(ROMSpace + 0x70 * 8192, HuCROM + 0x20 * 8192, 0x10 * 8192);
+   memcpy(ROMSpace + 0x00 * 8192, ROMData, 0x20 * 8192);
+   memcpy(ROMSpace + 0x20 * 8192, ROMData, 0x20 * 8192);
+   memcpy(ROMSpace + 0x40 * 8192, ROMData + 0x20 * 8192, 0x10 * 8192);
+   memcpy(ROMSpace + 0x50 * 8192, ROMData + 0x20 * 8192, 0x10 * 8192);
+   memcpy(ROMSpace + 0x60 * 8192, ROMData + 0x20 * 8192, 0x10 * 8192);
+   memcpy(ROMSpace + 0x70 * 8192, ROMData + 0x20 * 8192, 0x10 * 8192);
   }
   else if(m_len == 0x80000)
   {
-   memcpy(ROMSpace + 0x00 * 8192, HuCROM, 0x40 * 8192);
-   memcpy(ROMSpace + 0x40 * 8192, HuCROM + 0x20 * 8192, 0x20 * 8192);
-   memcpy(ROMSpace + 0x60 * 8192, HuCROM + 0x20 * 8192, 0x20 * 8192);
+   memcpy(ROMSpace + 0x00 * 8192, ROMData, 0x40 * 8192);
+   memcpy(ROMSpace + 0x40 * 8192, ROMData + 0x20 * 8192, 0x20 * 8192);
+   memcpy(ROMSpace + 0x60 * 8192, ROMData + 0x20 * 8192, 0x20 * 8192);
   }
   else
   {
-   memcpy(ROMSpace + 0x00 * 8192, HuCROM, (m_len < 1024 * 1024) ? m_len : 1024 * 1024);
+   memcpy(ROMSpace + 0x00 * 8192, ROMData, (m_len < 1024 * 1024) ? m_len : 1024 * 1024);
   }
 
   for(int x = 0x00; x < 0x80; x++)
   {
    HuCPU.FastMap[x] = &ROMSpace[x * 8192];
+   HuCPU.ReadMap[x] = &ROMSpace[x * 8192];
    HuCPU.PCERead[x] = HuCRead;
   }
 
-  if(!memcmp(HuCROM + 0x1F26, "POPULOUS", strlen("POPULOUS")))
+  if(!memcmp(ROMData + 0x1F26, "POPULOUS", strlen("POPULOUS")))
   {
    uint8 *PopRAM = ROMSpace + 0x40 * 8192;
    memset(PopRAM, 0xFF, 32768);
@@ -229,6 +241,7 @@ uint32 HuC_Load(Stream* fp)
    for(int x = 0x40; x < 0x44; x++)
    {
     HuCPU.FastMap[x] = &PopRAM[(x & 3) * 8192];
+    HuCPU.ReadMap[x] = HuCPU.WriteMap[x] = &PopRAM[(x & 3) * 8192];
     HuCPU.PCERead[x] = HuCRead;
     HuCPU.PCEWrite[x] = HuCRAMWrite;
    }
@@ -253,6 +266,7 @@ uint32 HuC_Load(Stream* fp)
   {
    for(int x = 0x40; x < 0x80; x++)
    {
+    HuCPU.ReadMap[x] = NULL;
     HuCPU.PCERead[x] = HuCSF2Read;
    }
    HuCPU.PCEWrite[0] = HuCSF2Write;
@@ -309,16 +323,19 @@ void HuC_LoadCD(const std::string& bios_path)
   for(int x = 0; x < 0x40; x++)
   {
    HuCPU.FastMap[x] = &ROMSpace[x * 8192];
+   HuCPU.ReadMap[x] = &ROMSpace[x * 8192];
    HuCPU.PCERead[x] = HuCRead;
   }
 
   for(int x = 0x68; x < 0x88; x++)
   {
    HuCPU.FastMap[x] = &ROMSpace[x * 8192];
+   HuCPU.ReadMap[x] = HuCPU.WriteMap[x] = &ROMSpace[x * 8192];
    HuCPU.PCERead[x] = HuCRead;
    HuCPU.PCEWrite[x] = HuCRAMWrite;
   }
   HuCPU.PCEWrite[0x80] = HuCRAMWriteCDSpecial; 	// Hyper Dyne Special hack
+  HuCPU.WriteMap[0x80] = NULL;
   MDFNMP_AddRAM(262144, 0x68 * 8192, ROMSpace + 0x68 * 8192);
 
   if(PCE_ACEnabled)
@@ -327,6 +344,7 @@ void HuC_LoadCD(const std::string& bios_path)
 
    for(int x = 0x40; x < 0x44; x++)
    {
+    HuCPU.ReadMap[x] = HuCPU.WriteMap[x] = NULL;
     HuCPU.PCERead[x] = ACPhysRead;
     HuCPU.PCEWrite[x] = ACPhysWrite;
    }
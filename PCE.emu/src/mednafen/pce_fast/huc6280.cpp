@@ -125,6 +125,11 @@ HuC6280 HuCPU;
  }									\
  HuCPU.MPR[wmpr] = wbank;						\
  HuCPU.FastPageR[wmpr] = (uintptr_t)HuCPU.FastMap[wbank] - wmpr * 8192;	\
+ if(wmpr < 8)								\
+ {									\
+  HuCPU.FastPageRd[wmpr] = HuCPU.ReadMap[wbank] ? (uintptr_t)HuCPU.ReadMap[wbank] - wmpr * 8192 : 0;	\
+  HuCPU.FastPageWr[wmpr] = HuCPU.WriteMap[wbank] ? (uintptr_t)HuCPU.WriteMap[wbank] - wmpr * 8192 : 0;	\
+ }									\
 }
 
 void HuC6280_SetMPR(int i, int v)
@@ -145,6 +150,11 @@ static void HuC6280_FlushMPRCache(void)
 
 static INLINE uint8 RdMem(unsigned int A)
 {
+ const uintptr_t fast = HuCPU.FastPageRd[A >> 13];
+
+ if(MDFN_LIKELY(fast))
+  return *(uint8*)(fast + A);
+
  uint8 wmpr = HuCPU.MPR[A >> 13];
  return(HuCPU.PCERead[wmpr]((wmpr << 13) | (A & 0x1FFF)));
 }
@@ -161,6 +171,14 @@ static INLINE uint16 RdMem16(unsigned int A)
 
 static INLINE void WrMem(unsigned int A, uint8 V)
 {
+ const uintptr_t fast = HuCPU.FastPageWr[A >> 13];
+
+ if(fast)
+ {
+  *(uint8*)(fast + A) = V;
+  return;
+ }
+
  uint8 wmpr = HuCPU.MPR[A >> 13];
  HuCPU.PCEWrite[wmpr]((wmpr << 13) | (A & 0x1FFF), V);
 }
@@ -602,6 +620,11 @@ void HuC6280_Power(void)
   HuCPU.MPR[i] = 0;
   HuCPU.FastPageR[i] = 0;
  }  
+ for(int i = 0; i < 8; i++)
+ {
+  HuCPU.FastPageRd[i] = 0;
+  HuCPU.FastPageWr[i] = 0;
+ }
  HuC6280_Reset();
 }
 
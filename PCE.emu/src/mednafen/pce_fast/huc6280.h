@@ -25,6 +25,8 @@ struct HuC6280
 	uint8 MPR[9];		// 8, + 1 for PC overflow from $ffff to $10000
 	uint8 timer_status;
 	uintptr_t FastPageR[9];
+	uintptr_t FastPageRd[8];	// Direct data read/write pointers for the mapped bank minus its base address,
+	uintptr_t FastPageWr[8];	// or 0 to go through PCERead/PCEWrite.
 	uint8 *Page1;
 	//uint8 *PAGE1_W;
 	//const uint8 *PAGE1_R;
@@ -52,6 +54,11 @@ struct HuC6280
 	//
 	uint8 *FastMap[0x100];
 
+	// Host memory for banks whose read/write handlers are plain memory accesses,
+	// NULL if the handler must be called.
+	uint8 *ReadMap[0x100];
+	uint8 *WriteMap[0x100];
+
 	readfunc PCERead[0x100];
 	writefunc PCEWrite[0x100];
 };
@@ -331,6 +331,9 @@ static void LoadCommon(void)
   for(int x = 0xf8; x < 0xfb; x++)
    HuCPU.FastMap[x] = &BaseRAM[(x & 0x3) * 8192];
 
+  for(int x = 0xf8; x <= 0xfb; x++)
+   HuCPU.ReadMap[x] = HuCPU.WriteMap[x] = &BaseRAM[(x & 0x3) * 8192];
+
   HuCPU.PCERead[0xFF] = IOReadSGX;
  }
  else
@@ -344,6 +347,9 @@ static void LoadCommon(void)
   for(int x = 0xf8; x < 0xfb; x++)
    HuCPU.FastMap[x] = &BaseRAM[0];
 
+  for(int x = 0xf8; x <= 0xfb; x++)
+   HuCPU.ReadMap[x] = HuCPU.WriteMap[x] = &BaseRAM[0];
+
   HuCPU.PCERead[0xFF] = IORead;
  }
 
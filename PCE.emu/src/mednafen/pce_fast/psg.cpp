@@ -31,6 +31,20 @@ void PCEFast_PSG::SetVolume(double new_volume)
  Synth.volume(OutputVolume / 6);
 }
 
+// A zero delta adds nothing to the Blip_Buffer, so only changed sides go through the synth.
+// Flat waveform stretches, noise runs, single-sided panning and muted channels are common.
+INLINE void PCEFast_PSG::SetOutput(const int32 timestamp, psg_channel *ch, const int32 (&samp)[2])
+{
+ for(int lr = 0; lr < 2; lr++)
+ {
+  if(samp[lr] != ch->blip_prev_samp[lr])
+  {
+   Synth.offset_inline(timestamp, samp[lr] - ch->blip_prev_samp[lr], &sbuf[lr]);
+   ch->blip_prev_samp[lr] = samp[lr];
+  }
+ }
+}
+
 void PCEFast_PSG::UpdateOutput_Norm(const int32 timestamp, psg_channel *ch)
 {
  int32 samp[2];
@@ -39,11 +53,7 @@ void PCEFast_PSG::UpdateOutput_Norm(const int32 timestamp, psg_channel *ch)
  samp[0] = dbtable[ch->vl[0]][sv];
  samp[1] = dbtable[ch->vl[1]][sv];
 
- Synth.offset_inline(timestamp, samp[0] - ch->blip_prev_samp[0], &sbuf[0]);
- Synth.offset_inline(timestamp, samp[1] - ch->blip_prev_samp[1], &sbuf[1]);
-
- ch->blip_prev_samp[0] = samp[0];
- ch->blip_prev_samp[1] = samp[1];
+ SetOutput(timestamp, ch, samp);
 }
 
 void PCEFast_PSG::UpdateOutput_Noise(const int32 timestamp, psg_channel *ch)
@@ -54,11 +64,7 @@ void PCEFast_PSG::UpdateOutput_Noise(const int32 timestamp, psg_channel *ch)
  samp[0] = dbtable[ch->vl[0]][sv];
  samp[1] = dbtable[ch->vl[1]][sv];
 
- Synth.offset_inline(timestamp, samp[0] - ch->blip_prev_samp[0], &sbuf[0]);
- Synth.offset_inline(timestamp, samp[1] - ch->blip_prev_samp[1], &sbuf[1]);
-
- ch->blip_prev_samp[0] = samp[0];
- ch->blip_prev_samp[1] = samp[1];
+ SetOutput(timestamp, ch, samp);
 }
 
 void PCEFast_PSG::UpdateOutput_Off(const int32 timestamp, psg_channel *ch)
@@ -67,11 +73,7 @@ void PCEFast_PSG::UpdateOutput_Off(const int32 timestamp, psg_channel *ch)
 
  samp[0] = samp[1] = 0;
 
- Synth.offset_inline(timestamp, samp[0] - ch->blip_prev_samp[0], &sbuf[0]);
- Synth.offset_inline(timestamp, samp[1] - ch->blip_prev_samp[1], &sbuf[1]);
-
- ch->blip_prev_samp[0] = samp[0];
- ch->blip_prev_samp[1] = samp[1];
+ SetOutput(timestamp, ch, samp);
 }
 
 
@@ -82,11 +84,7 @@ void PCEFast_PSG::UpdateOutput_Accum(const int32 timestamp, psg_channel *ch)
  samp[0] = ((int32)dbtable_volonly[ch->vl[0]] * ((int32)ch->samp_accum - 496)) >> (8 + 5);
  samp[1] = ((int32)dbtable_volonly[ch->vl[1]] * ((int32)ch->samp_accum - 496)) >> (8 + 5);
 
- Synth.offset_inline(timestamp, samp[0] - ch->blip_prev_samp[0], &sbuf[0]);
- Synth.offset_inline(timestamp, samp[1] - ch->blip_prev_samp[1], &sbuf[1]);
-
- ch->blip_prev_samp[0] = samp[0];
- ch->blip_prev_samp[1] = samp[1];
+ SetOutput(timestamp, ch, samp);
 }
 
 // This function should always be called after RecalcFreqCache() (it's not called from RecalcFreqCache to avoid redundant code)
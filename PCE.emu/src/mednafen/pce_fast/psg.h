@@ -59,6 +59,7 @@ class PCEFast_PSG
 	void UpdateSubNonLFO(int32 timestamp);
 
 	void RecalcUOFunc(int chnum);
+	void SetOutput(const int32 timestamp, psg_channel *ch, const int32 (&samp)[2]);
 	void UpdateOutput_Off(const int32 timestamp, psg_channel *ch);
 	void UpdateOutput_Accum(const int32 timestamp, psg_channel *ch);
         void UpdateOutput_Norm(const int32 timestamp, psg_channel *ch);
@@ -0,0 +1,387 @@
+/* Mednafen - Multi-system Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ Equivalence check of the HuC6280 direct-pointer data path. Loads HuCard, SuperGrafx, Populous,
+ Street Fighter 2 mapper, CD and Arcade Card layouts through the real loaders, maps every bank into
+ every MPR with HuC6280_SetMPR() and verifies that RdMem()/WrMem() through FastPageRd/FastPageWr
+ read the same values and change memory the same way as the bank's PCERead/PCEWrite handlers.
+ The same checks are repeated after loading savestates, which rebuild the cache through
+ HuC6280_FlushMPRCache().
+*/
+
+// RdMem()/WrMem() are static, so the CPU core is built as part of this file
+#include "../huc6280.cpp"
+
+#include "../vdc.h"
+#include <mednafen/MemoryStream.h>
+#include <mednafen/NativeVFS.h>
+#include <mednafen/file.h>
+#include <mednafen/state.h>
+#include <mednafen/mempatcher.h>
+#include <mednafen/Time.h>
+#include <mednafen/cdrom/CDInterface.h>
+#include <mednafen/cputest/cputest.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <errno.h>
+
+extern MDFNGI EmulatedPCE_Fast;
+
+//
+// Normally supplied by the frontend
+//
+namespace Mednafen
+{
+
+MDFNGI *MDFNGameInfo = &EmulatedPCE_Fast;
+NativeVFS NVFS;
+int MDFNnetplay = 0;
+
+static bool settingArcadeCard, settingForceSGX;
+static std::vector<uint8> cdBIOS;
+
+uint64 MDFN_GetSettingUI(const char *name)
+{
+ if(!strcmp(name, "pce_fast.slend"))
+  return 235;
+ if(!strcmp(name, "pce_fast.slstart"))
+  return 4;
+ if(strstr(name, "volume"))
+  return 100;
+ return 1;
+}
+
+int64 MDFN_GetSettingI(const char *name) { return 0; }
+double MDFN_GetSettingF(const char *name) { return 1.0; }
+
+bool MDFN_GetSettingB(const char *name)
+{
+ if(!strcmp(name, "pce_fast.arcadecard"))
+  return settingArcadeCard;
+ if(!strcmp(name, "pce_fast.forcesgx"))
+  return settingForceSGX;
+ return false;
+}
+
+std::string MDFN_GetSettingS(const char *name) { return "bios.pce"; }
+std::string MDFN_MakeFName(MakeFName_Type type, int id1, const char *cd1) { return ""; }
+void MDFN_printf(const char *format, ...) noexcept {}
+void MDFN_Notify(MDFN_NoticeType t, const char* format, ...) noexcept {}
+void MDFND_OutputNotice(MDFN_NoticeType t, const char* s) noexcept {}
+void MDFND_NetplayText(const char* text, bool NetEcho) {}
+void MDFND_SetStateStatus(StateStatusStruct *status) noexcept {}
+void MDFND_commitVideoFrame(EmulateSpecStruct *espec) {}
+void MDFN_MidLineUpdate(EmulateSpecStruct *espec, int y) {}
+void NetplaySendState(void) {}
+void MDFNI_SelectMovie(int) {}
+bool MDFNMOV_IsRecording(void) noexcept { return false; }
+void MDFNMOV_RecordState(void) noexcept {}
+void MDFNMP_Init(uint32 ps, uint32 numpages) {}
+void MDFNMP_AddRAM(uint32 size, uint32 address, uint8 *RAM, bool use_in_search) {}
+void MDFNMP_ApplyPeriodicCheats(void) {}
+bool MDFN_DumpToFile(const std::string& path, const void *data, const uint64 length, bool throw_on_error) { return true; }
+int64 Time::EpochTime(void) { return 0; }
+
+void MDFN_StateAction(StateMem *sm, const unsigned load, const bool data_only)
+{
+ MDFNGameInfo->StateAction(sm, load, data_only);
+}
+
+uint64 Stream::readAtPos(void *data, uint64 count, uint64 pos) { return 0; }
+bool Stream::isMemoryStream() { return false; }
+void Stream::advise(off_t offset, size_t bytes, IO::Advice advice) {}
+
+uint64 MemoryStream::readAtPos(void *data, uint64 count, uint64 pos)
+{
+ auto prevPos = tell();
+ seek(pos, SEEK_SET);
+ auto bytes = read(data, count, false);
+ seek(prevPos, SEEK_SET);
+ return bytes;
+}
+
+bool MemoryStream::isMemoryStream() { return true; }
+
+// the CD BIOS is the only file the core opens
+MDFNFILE::MDFNFILE(VirtualFS* vfs, const char* path, const std::vector<FileExtensionSpecStruct>& known_ext, const char* purpose):
+ ext(f_ext), fbase(f_fbase), f_vfs{vfs}
+{
+ str = std::make_unique<MemoryStream>(cdBIOS.size(), true);
+ memcpy(str->map(), cdBIOS.data(), cdBIOS.size());
+}
+
+MDFNFILE::~MDFNFILE() {}
+void MDFNFILE::Close(void) throw() { str.reset(); }
+
+NativeVFS::NativeVFS() : VirtualFS(MDFN_PS, PSS) {}
+NativeVFS::~NativeVFS() {}
+Stream* NativeVFS::open(const std::string& path, const uint32 mode, const int do_lock, const bool throw_on_noent, const CanaryType canary)
+{
+ throw MDFN_Error(ENOENT, "No file system in the test");
+}
+bool NativeVFS::mkdir(const std::string& path, const bool throw_on_exist) { return false; }
+bool NativeVFS::unlink(const std::string& path, const bool throw_on_noent, const CanaryType canary) { return false; }
+void NativeVFS::rename(const std::string& oldpath, const std::string& newpath, const CanaryType canary) {}
+bool NativeVFS::finfo(const std::string& path, FileInfo*, const bool throw_on_noent) { return false; }
+void NativeVFS::readdirentries(const std::string& path, std::function<bool(const std::string&)> callb) {}
+bool NativeVFS::is_absolute_path(const std::string& path) { return false; }
+void NativeVFS::get_file_path_components(const std::string& file_path, std::string* dir_path_out, std::string* file_base_out, std::string *file_ext_out) {}
+void NativeVFS::check_firop_safe(const std::string& path) {}
+
+// a disc with a single audio track, so no sectors are ever read
+CDInterface::CDInterface() : UnrecoverableError(false)
+{
+ disc_toc.first_track = disc_toc.last_track = 1;
+ disc_toc.tracks[1].valid = true;
+ disc_toc.tracks[100].lba = 75 * 60;
+ disc_toc.tracks[100].valid = true;
+}
+CDInterface::~CDInterface() {}
+bool CDInterface::NonDeterministic_CheckSectorReady(int32 lba) { return true; }
+uint8 CDInterface::ReadSectors(uint8* buf, int32 lba, uint32 sector_count) { return 0; }
+
+}
+
+// no SIMD paths in the host build, as on the ARM targets
+int cputest_get_flags(void) { return 0; }
+
+CLINK void bug_doExit(const char *msg, ...)
+{
+ va_list args;
+ va_start(args, msg);
+ vprintf(msg, args);
+ va_end(args);
+ printf("\n");
+ abort();
+}
+
+namespace
+{
+
+using namespace PCE_Fast;
+
+class AudioCD : public CDInterface
+{
+ public:
+ void HintReadSector(int32 lba) override {}
+ bool ReadRawSector(uint8* buf, int32 lba) override { return false; }
+ bool ReadRawSectorPWOnly(uint8* pwbuf, int32 lba, bool hint_fullread) override { return false; }
+};
+
+int failures = 0;
+
+void check(bool cond, const char *layout, const char *what, unsigned bank = 0, unsigned mpr = 0)
+{
+ if(!cond)
+ {
+  if(failures < 20)
+   printf("FAIL %s: %s, bank %02x in MPR %u\n", layout, what, bank, mpr);
+  ++failures;
+ }
+}
+
+void fillPattern(uint8 *data, size_t len, uint32 seed)
+{
+ uint32 x = seed;
+ for(size_t i = 0; i < len; i++)
+ {
+  x = x * 1664525 + 1013904223;
+  data[i] = x >> 24;
+ }
+}
+
+// all memory a data write can reach outside of the I/O page
+struct MemorySnapshot
+{
+ std::vector<uint8> rom, ram;
+
+ MemorySnapshot() : rom(ROMSpace, ROMSpace + sizeof(ROMSpace)), ram(BaseRAM, BaseRAM + sizeof(BaseRAM)) { }
+ void restore() const
+ {
+  memcpy(ROMSpace, rom.data(), rom.size());
+  memcpy(BaseRAM, ram.data(), ram.size());
+ }
+ bool operator ==(const MemorySnapshot &o) const { return rom == o.rom && ram == o.ram; }
+};
+
+unsigned directReadBanks, directWriteBanks;
+
+// compares the data path of whatever bank is in 'mpr' against its handlers
+void checkMPR(const char *layout, unsigned mpr)
+{
+ const unsigned bank = HuCPU.MPR[mpr];
+ const unsigned base = mpr * 8192;
+
+ check(!HuCPU.FastPageRd[mpr] == !HuCPU.ReadMap[bank], layout, "read pointer cache doesn't match ReadMap", bank, mpr);
+ check(!HuCPU.FastPageWr[mpr] == !HuCPU.WriteMap[bank], layout, "write pointer cache doesn't match WriteMap", bank, mpr);
+
+ // banks without a pointer go through the handlers in RdMem()/WrMem() already
+ if(HuCPU.FastPageRd[mpr])
+ {
+  directReadBanks++;
+  for(unsigned A = 0; A < 8192; A++)
+  {
+   if(RdMem(base + A) != HuCPU.PCERead[bank]((bank << 13) | A))
+   {
+    check(false, layout, "RdMem() differs from PCERead", bank, mpr);
+    break;
+   }
+  }
+ }
+
+ if(HuCPU.FastPageWr[mpr])
+ {
+  directWriteBanks++;
+  uint8 data[8192];
+  fillPattern(data, sizeof(data), bank * 8 + mpr);
+  const MemorySnapshot before;
+
+  for(unsigned A = 0; A < 8192; A++)
+   WrMem(base + A, data[A]);
+  const MemorySnapshot direct;
+  before.restore();
+
+  for(unsigned A = 0; A < 8192; A++)
+   HuCPU.PCEWrite[bank]((bank << 13) | A, data[A]);
+  const MemorySnapshot handled;
+
+  check(direct == handled, layout, "WrMem() changes memory differently than PCEWrite", bank, mpr);
+  before.restore();
+ }
+}
+
+void checkAllBanks(const char *layout)
+{
+ for(unsigned bank = 0; bank < 0x100; bank++)
+ {
+  for(unsigned mpr = 0; mpr < 8; mpr++)
+  {
+   HuC6280_SetMPR(mpr, bank);
+   checkMPR(layout, mpr);
+  }
+ }
+}
+
+// maps each group of 8 banks, saves a state, maps other banks and loads the state back
+void checkStateLoads(const char *layout)
+{
+ for(unsigned group = 0; group < 0x100; group += 8)
+ {
+  for(unsigned mpr = 0; mpr < 8; mpr++)
+   HuC6280_SetMPR(mpr, group + mpr);
+
+  MemoryStream state(65536);
+  MDFNSS_SaveSM(&state, false);
+
+  for(unsigned mpr = 0; mpr < 8; mpr++)
+   HuC6280_SetMPR(mpr, (group + 0x80 + mpr * 3) & 0xFF);
+
+  state.rewind();
+  MDFNSS_LoadSM(&state, false);
+
+  for(unsigned mpr = 0; mpr < 8; mpr++)
+  {
+   check(HuCPU.MPR[mpr] == group + mpr, layout, "MPR not restored by state load", group + mpr, mpr);
+   checkMPR(layout, mpr);
+  }
+ }
+}
+
+// sanity checks that the layout enabled the paths it's expected to
+void checkCoverage(const char *layout, std::initializer_list<unsigned> directRead, std::initializer_list<unsigned> directWrite,
+	std::initializer_list<unsigned> handlerOnly)
+{
+ for(unsigned bank : directRead)
+  check(HuCPU.ReadMap[bank], layout, "expected a direct read bank", bank);
+ for(unsigned bank : directWrite)
+  check(HuCPU.WriteMap[bank], layout, "expected a direct write bank", bank);
+ for(unsigned bank : handlerOnly)
+  check(!HuCPU.ReadMap[bank] && !HuCPU.WriteMap[bank], layout, "expected a handler-only bank", bank);
+}
+
+std::vector<uint8> makeHuCard(size_t size, bool populous)
+{
+ std::vector<uint8> rom(size);
+ fillPattern(rom.data(), size, size);
+ if(populous)
+  memcpy(&rom[0x1F26], "POPULOUS", 8);
+ return rom;
+}
+
+void runLayout(const char *layout)
+{
+ directReadBanks = directWriteBanks = 0;
+ checkAllBanks(layout);
+ checkStateLoads(layout);
+ printf("%s: %u direct read and %u direct write mappings compared\n", layout, directReadBanks, directWriteBanks);
+}
+
+void testHuCard(const char *layout, size_t size, const char *ext, bool populous,
+	std::initializer_list<unsigned> directRead, std::initializer_list<unsigned> directWrite, std::initializer_list<unsigned> handlerOnly)
+{
+ std::vector<uint8> rom = makeHuCard(size, populous);
+ MemoryStream stream(rom.size(), true);
+ memcpy(stream.map(), rom.data(), rom.size());
+ GameFile gf{&NVFS, "", &stream, ext, "test", {&NVFS, "", "test"}};
+ EmulatedPCE_Fast.Load(&gf);
+ checkCoverage(layout, directRead, directWrite, handlerOnly);
+ runLayout(layout);
+ EmulatedPCE_Fast.CloseGame();
+}
+
+void testCD(const char *layout, bool arcadeCard, bool sgx,
+	std::initializer_list<unsigned> directRead, std::initializer_list<unsigned> directWrite, std::initializer_list<unsigned> handlerOnly)
+{
+ settingArcadeCard = arcadeCard;
+ settingForceSGX = sgx;
+ cdBIOS.resize(262144);
+ fillPattern(cdBIOS.data(), cdBIOS.size(), 262144);
+ AudioCD cd;
+ std::vector<CDInterface*> cdifs{&cd};
+ EmulatedPCE_Fast.LoadCD(&cdifs);
+ checkCoverage(layout, directRead, directWrite, handlerOnly);
+ check(HuCPU.ReadMap[0x80] && !HuCPU.WriteMap[0x80], layout, "Hyper Dyne write hack bank must use its write handler", 0x80);
+ runLayout(layout);
+ EmulatedPCE_Fast.CloseGame();
+ settingArcadeCard = settingForceSGX = false;
+}
+
+}
+
+int main()
+{
+ // 0xFF is I/O, 0xF7 save RAM, 0x40-0x43 Populous RAM or the Arcade Card, 0x80 has the Hyper Dyne write hack
+ testHuCard("HuCard 384KB", 0x60000, "pce", false, {0x00, 0x7F, 0xF8, 0xFB}, {0xF8, 0xFB}, {0xF7, 0xFF});
+ testHuCard("HuCard 512KB", 0x80000, "pce", false, {0x00, 0x7F, 0xF8}, {0xF8}, {0xF7, 0xFF});
+ testHuCard("HuCard 1MB", 0x100000, "pce", false, {0x00, 0x7F, 0xF8}, {0xF8}, {0xF7, 0xFF});
+ testHuCard("SuperGrafx", 0x100000, "sgx", false, {0x00, 0xF8, 0xFB}, {0xF8, 0xFB}, {0xF7, 0xFF});
+ testHuCard("Populous", 0x80000, "pce", true, {0x00, 0x40, 0x43}, {0x40, 0x43, 0xF8}, {0xF7, 0xFF});
+ testHuCard("Street Fighter 2 mapper", 0x280000, "pce", false, {0x00, 0x3F, 0xF8}, {0xF8}, {0x40, 0x7F, 0xF7, 0xFF});
+ testCD("CD", false, false, {0x00, 0x3F, 0x68, 0x87, 0xF8}, {0x68, 0x87, 0xF8}, {0x40, 0xF7, 0xFF});
+ testCD("CD Arcade Card", true, false, {0x00, 0x68, 0x80, 0xF8}, {0x68, 0x87, 0xF8}, {0x40, 0x43, 0xF7, 0xFF});
+ testCD("CD Arcade Card SuperGrafx", true, true, {0x00, 0x68, 0xF8, 0xFB}, {0x68, 0xF8, 0xFB}, {0x40, 0xF7, 0xFF});
+
+ if(failures)
+ {
+  printf("%d check(s) failed\n", failures);
+  return 1;
+ }
+
+ printf("all checks passed\n");
+ return 0;
+}
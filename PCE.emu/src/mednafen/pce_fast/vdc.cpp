@@ -1088,75 +1088,74 @@ static void MixNone(const uint32 count, T* __restrict__ target)
 static const int prio_select[4] = { 1, 1, 0, 0 };
 static const int prio_shift[4] = { 4, 0, 4, 0 };
 
+// The priority setting is a template parameter so the selects in vpc_mix_inner.inc fold away,
+// leaving a branch-free loop the compiler can vectorize.
+template<unsigned pb, typename T>
+static void MixVPCRun(const uint32 count, const uint32* __restrict__ lb0, const uint32* __restrict__ lb1, T* __restrict__ target)
+{
+	const uint32 amask = ::amask;
+	const uint32 backdrop = vce.color_table_cache[0];
+
+	for(uint32 x = 0; x < count; x++)
+	{
+	 #include "vpc_mix_inner.inc"
+	}
+}
+
 template<typename T>
-static void MixVPC(const uint32 count, const uint32* __restrict__ lb0, const uint32* __restrict__ lb1, T*  __restrict__ target)
+static void MixVPCSpan(const uint8 pb, const uint32 count, const uint32* __restrict__ lb0, const uint32* __restrict__ lb1, T* __restrict__ target)
 {
-	// Windowing disabled.
-	if(MDFN_LIKELY(vpc.winwidths[0] <= 0x40 && vpc.winwidths[1] <= 0x40))
+	switch(pb)
 	{
-	 const uint8 pb = (vpc.priority[prio_select[0]] >> prio_shift[0]) & 0xF;
+	 case 0x0: MixVPCRun<0x0>(count, lb0, lb1, target); break;
+	 case 0x1: MixVPCRun<0x1>(count, lb0, lb1, target); break;
+	 case 0x2: MixVPCRun<0x2>(count, lb0, lb1, target); break;
+	 case 0x3: MixVPCRun<0x3>(count, lb0, lb1, target); break;
+	 case 0x4: MixVPCRun<0x4>(count, lb0, lb1, target); break;
+	 case 0x5: MixVPCRun<0x5>(count, lb0, lb1, target); break;
+	 case 0x6: MixVPCRun<0x6>(count, lb0, lb1, target); break;
+	 case 0x7: MixVPCRun<0x7>(count, lb0, lb1, target); break;
+	 case 0x8: MixVPCRun<0x8>(count, lb0, lb1, target); break;
+	 case 0x9: MixVPCRun<0x9>(count, lb0, lb1, target); break;
+	 case 0xA: MixVPCRun<0xA>(count, lb0, lb1, target); break;
+	 case 0xB: MixVPCRun<0xB>(count, lb0, lb1, target); break;
+	 case 0xC: MixVPCRun<0xC>(count, lb0, lb1, target); break;
+	 case 0xD: MixVPCRun<0xD>(count, lb0, lb1, target); break;
+	 case 0xE: MixVPCRun<0xE>(count, lb0, lb1, target); break;
+	 case 0xF: MixVPCRun<0xF>(count, lb0, lb1, target); break;
+	}
+}
 
-	 switch(pb)
-	 {
-	  default:
-	  	  //printf("%02x\n", pb);
-		  for(int x = 0; MDFN_LIKELY(x < (int)count); x++)
-		  {	 
-		   #include "vpc_mix_inner.inc"
-		  }
-		  break;
-
-	  case 0x3:
-		  for(int x = 0; MDFN_LIKELY(x < (int)count); x++)
-		  {	 
-		   #include "vpc_mix_inner.inc"
-		  }
-		  break;
-
-	  case 0x7:
-		  for(int x = 0; MDFN_LIKELY(x < (int)count); x++)
-		  {	 
-		   #include "vpc_mix_inner.inc"
-		  }
-		  break;
-
-	  case 0xB:
-		  for(int x = 0; MDFN_LIKELY(x < (int)count); x++)
-		  {	 
-		   #include "vpc_mix_inner.inc"
-		  }
-		  break;
-
-	  case 0xF:
-		  for(int x = 0; MDFN_LIKELY(x < (int)count); x++)
-		  {	 
-		   #include "vpc_mix_inner.inc"
-		  }
-		  break;
-	 }
+template<typename T>
+static void MixVPC(const uint32 count, const uint32* __restrict__ lb0, const uint32* __restrict__ lb1, T*  __restrict__ target)
+{
+	// The window state only changes at the two window widths, so mix the line as up to 3 spans
+	// with a fixed priority setting each. Widths <= 0x40 disable windowing.
+	const int32 ww[2] = { std::min<int32>(std::max<int32>(vpc.winwidths[0] - 0x40, 0), count),
+			      std::min<int32>(std::max<int32>(vpc.winwidths[1] - 0x40, 0), count) };
+	int32 x = 0;
 
-	 //switch(pb & 0xF)
-	 //{
-	 // case 0x0: for(int x = 0; x < (int)count; x++)
-	 //	    { 
-	 //	     #include "vpc_mix_inner.inc"
-	 //	    }
-	 //	    break;
-         //}
-	}
-	else for(int x = 0; x < (int)count; x++)
-	{    
+	while(x < (int32)count)
+	{
 	 int in_window = 0;
+	 int32 end = count;
 
-	 if(x < (vpc.winwidths[0] - 0x40))
+	 if(x < ww[0])
+	 {
 	  in_window |= 1;
+	  end = std::min(end, ww[0]);
+	 }
 
-	 if(x < (vpc.winwidths[1] - 0x40))
+	 if(x < ww[1])
+	 {
 	  in_window |= 2;
+	  end = std::min(end, ww[1]);
+	 }
 
-	 uint8 pb = (vpc.priority[prio_select[in_window]] >> prio_shift[in_window]) & 0xF;
+	 const uint8 pb = (vpc.priority[prio_select[in_window]] >> prio_shift[in_window]) & 0xF;
 
-	 #include "vpc_mix_inner.inc"
+	 MixVPCSpan(pb, end - x, lb0 + x, lb1 + x, target + x);
+	 x = end;
 	}
 }
 
@@ -18,6 +18,7 @@
 #include <emuframework/EmuAppInlines.hh>
 #include <emuframework/EmuAudio.hh>
 #include <emuframework/EmuVideo.hh>
+#include <emuframework/CompressedCDImage.hh>
 #include "internal.hh"
 
 extern "C"
@@ -47,7 +48,8 @@ static bool hasCDExtension(const char *name)
 {
 	return string_hasDotExtension(name, "cue") ||
 			string_hasDotExtension(name, "iso") ||
-			string_hasDotExtension(name, "bin");
+			string_hasDotExtension(name, "bin") ||
+			CompressedCDImage::hasExtension(name);
 }
 
 bool hasBIOSExtension(const char *name)
@@ -125,6 +127,79 @@ static SoundInterface_struct SNDImagine =
 	SNDImagineSetVolume
 };
 
+// CD
+
+static CompressedCDImage cdzImage{};
+static u32 cdzTOC[102];
+
+static int CDZCDInit(const char *path)
+{
+	if(auto ec = cdzImage.open(path, 32);
+		ec)
+	{
+		logErr("error opening %s: %s", path, ec.message().c_str());
+		return -1;
+	}
+	std::fill_n(cdzTOC, std::size(cdzTOC), 0xFFFFFFFF);
+	iterateTimes(cdzImage.tracks(), i)
+	{
+		auto &track = cdzImage.track(i);
+		u32 ctlAddr = track.type == CompressedCDImage::TrackType::AUDIO ? 0x01 : 0x41;
+		cdzTOC[i] = (ctlAddr << 24) | (track.lba + 150);
+	}
+	auto lastTrackIdx = cdzImage.tracks() - 1;
+	cdzTOC[99] = (cdzTOC[0] & 0xFF000000) | 0x010000;
+	cdzTOC[100] = (cdzTOC[lastTrackIdx] & 0xFF000000) | (cdzImage.track(lastTrackIdx).number << 16);
+	cdzTOC[101] = (cdzTOC[lastTrackIdx] & 0xFF000000) | (cdzImage.sectors() + 150);
+	return 0;
+}
+
+static void CDZCDDeInit()
+{
+	cdzImage.close();
+}
+
+static int CDZCDGetStatus()
+{
+	return cdzImage ? 0 : 2;
+}
+
+static s32 CDZCDReadTOC(u32 *TOC)
+{
+	memcpy(TOC, cdzTOC, sizeof(cdzTOC));
+	return sizeof(cdzTOC);
+}
+
+static int CDZCDReadSectorFAD(u32 FAD, void *buffer)
+{
+	memset(buffer, 0, 2448);
+	if(FAD < 150 || !cdzImage.readSector(buffer, FAD - 150))
+	{
+		logWarn("sector FAD %u not readable", FAD);
+		return 0;
+	}
+	return 1;
+}
+
+static void CDZCDReadAheadFAD(u32 FAD)
+{
+	if(FAD >= 150)
+		cdzImage.hintReadAhead(FAD - 150);
+}
+
+#define CDCORE_CDZ 3
+static CDInterface CDZCD =
+{
+	CDCORE_CDZ,
+	"Compressed Image Virtual Drive",
+	CDZCDInit,
+	CDZCDDeInit,
+	CDZCDGetStatus,
+	CDZCDReadTOC,
+	CDZCDReadSectorFAD,
+	CDZCDReadAheadFAD
+};
+
 static FS::PathString bupPath{};
 static char mpegPath[] = "";
 static char cartPath[] = "";
@@ -146,6 +221,7 @@ CDInterface *CDCoreList[] =
 {
 	&DummyCD,
 	&ISOCD,
+	&CDZCD,
 	nullptr
 };
 
@@ -307,6 +383,7 @@ void EmuSystem::closeSystem()
 EmuSystem::Error EmuSystem::loadGame(IO &, EmuSystemCreateParams, OnLoadProgressDelegate)
 {
 	string_printf(bupPath, "%s/bkram.bin", savePath());
+	yinit.cdcoretype = CompressedCDImage::hasExtension(gameFileName().data()) ? CDCORE_CDZ : CDCORE_ISO;
 	if(YabauseInit(&yinit) != 0)
 	{
 		logErr("YabauseInit failed");
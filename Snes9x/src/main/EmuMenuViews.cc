@@ -45,6 +45,28 @@ public:
 		item.emplace_back(&dspInterpolation);
 	}
 };
+
+class CustomVideoOptionView : public VideoOptionView
+{
+	BoolMenuItem threadedRendering
+	{
+		"Threaded PPU Rendering",
+		(bool)optionThreadedRendering,
+		[this](BoolMenuItem &item, View &, Input::Event e)
+		{
+			optionThreadedRendering = item.flipBoolValue(*this);
+			S9xSetRenderThread(optionThreadedRendering);
+		}
+	};
+
+public:
+	CustomVideoOptionView(ViewAttachParams attach): VideoOptionView{attach, true}
+	{
+		loadStockItems();
+		item.emplace_back(&systemSpecificHeading);
+		item.emplace_back(&threadedRendering);
+	}
+};
 #endif
 
 class ConsoleOptionView : public TableView
@@ -253,6 +275,7 @@ std::unique_ptr<View> EmuApp::makeCustomView(ViewAttachParams attach, ViewID id)
 	{
 		#ifndef SNES9X_VERSION_1_4
 		case ViewID::AUDIO_OPTIONS: return std::make_unique<CustomAudioOptionView>(attach);
+		case ViewID::VIDEO_OPTIONS: return std::make_unique<CustomVideoOptionView>(attach);
 		#endif
 		case ViewID::SYSTEM_ACTIONS: return std::make_unique<CustomSystemActionsView>(attach);
 		case ViewID::EDIT_CHEATS: return std::make_unique<EmuEditCheatListView>(attach);
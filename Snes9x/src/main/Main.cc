@@ -25,6 +25,9 @@ static EmuSystemTask *emuSysTask{};
 static EmuVideo *emuVideo{};
 static const uint heightChangeFrameDelay = 4;
 static uint heightChangeFrames = heightChangeFrameDelay;
+#ifndef SNES9X_VERSION_1_4
+static size_t memStateSize{};
+#endif
 bool EmuSystem::hasCheats = true;
 bool EmuSystem::hasPALVideoSystem = true;
 bool EmuSystem::hasResetModes = true;
@@ -142,6 +145,32 @@ EmuSystem::Error EmuSystem::loadState(const char *path)
 		return EmuSystem::makeFileReadError();
 }
 
+#ifndef SNES9X_VERSION_1_4
+size_t EmuSystem::stateSize()
+{
+	// depends only on the enabled chips, so measure once per game
+	if(!memStateSize)
+		memStateSize = S9xFreezeSize();
+	return memStateSize;
+}
+
+EmuSystem::Error EmuSystem::saveStateToMemory(void *buff, size_t size)
+{
+	if(size < stateSize())
+		return makeError("State buffer too small");
+	S9xFreezeGameMem((uint8*)buff, size);
+	return {};
+}
+
+EmuSystem::Error EmuSystem::loadStateFromMemory(const void *buff, size_t size)
+{
+	if(S9xUnfreezeGameMem((const uint8*)buff, size) != SUCCESS)
+		return makeError("Invalid state data");
+	IPPU.RenderThisFrame = TRUE;
+	return {};
+}
+#endif
+
 void EmuSystem::saveBackupMem() // for manually saving when not closing game
 {
 	if(gameIsRunning())
@@ -169,6 +198,9 @@ void S9xAutoSaveSRAM (void)
 void EmuSystem::closeSystem()
 {
 	saveBackupMem();
+	#ifndef SNES9X_VERSION_1_4
+	memStateSize = 0;
+	#endif
 }
 
 bool EmuSystem::vidSysIsPAL() { return Settings.PAL; }
@@ -157,6 +157,11 @@ bool S9xPollAxis(uint32 id, int16 *value)
 	return 0;
 }
 
+void S9xOnLatchJoypads()
+{
+	EmuSystem::latchInput();
+}
+
 bool S9xPollPointer(uint32 id, int16 *x, int16 *y)
 {
 	return 0;
@@ -104,6 +104,11 @@ CLINK uint32 S9xReadJoypad(int which)
 {
 	assert(which < 5);
 	//logMsg("reading joypad %d", which);
+	if(which == 0)
+	{
+		// all joypads are read together once per frame
+		EmuSystem::latchInput();
+	}
 	return 0x80000000 | joypadData[which];
 }
 
@@ -2831,6 +2831,8 @@ void S9xSetJoypadLatch (bool latch)
 	{
 		int	i;
 
+		S9xOnLatchJoypads();
+
 		for (int n = 0; n < 2; n++)
 		{
 			for (int j = 0; j < 2; j++)
@@ -230,6 +230,9 @@ bool S9xPollButton (uint32 id, bool *pressed);
 bool S9xPollPointer (uint32 id, int16 *x, int16 *y);
 bool S9xPollAxis (uint32 id, int16 *value);
 
+// Called when the game latches the controllers, before any of their state is read.
+void S9xOnLatchJoypads (void);
+
 // These are called when snes9x tries to apply a command with a S9x*Port type.
 // data1 and data2 are filled in like S9xApplyCommand.
 
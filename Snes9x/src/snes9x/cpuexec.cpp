@@ -409,7 +409,10 @@ void S9xDoHEventProcessing (void)
 
 		case HC_RENDER_EVENT:
 			if (CPU.V_Counter >= FIRST_VISIBLE_LINE && CPU.V_Counter <= PPU.ScreenHeight)
+			{
 				RenderLine((uint8) (CPU.V_Counter - FIRST_VISIBLE_LINE));
+				S9xQueueScreenUpdate();
+			}
 
 			S9xReschedule();
 
@@ -110,6 +110,9 @@ bool8 S9xDoDMA (uint8 Channel)
 		return (TRUE);
 	}
 
+	// VRAM, CGRAM & OAM may be written directly below
+	S9xWaitForRenderThread();
+
 	// Prepare for accessing $2118-2119
 	switch (d->BAddress)
 	{
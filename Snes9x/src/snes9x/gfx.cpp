@@ -14,6 +14,10 @@
 #include "screenshot.h"
 #include "font.h"
 #include "display.h"
+#include <imagine/thread/Semaphore.hh>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 extern struct SCheatData		Cheat;
 
@@ -100,6 +104,7 @@ bool8 S9xGraphicsInit (void)
 
 void S9xGraphicsDeinit (void)
 {
+	S9xSetRenderThread(FALSE);
 	if (GFX.ZERO)       { free(GFX.ZERO);       GFX.ZERO       = NULL; }
 	if (GFX.SubScreen)  { free(GFX.SubScreen);  GFX.SubScreen  = NULL; }
 	if (GFX.ZBuffer)    { free(GFX.ZBuffer);    GFX.ZBuffer    = NULL; }
@@ -159,6 +164,8 @@ void S9xBuildDirectColourMaps (void)
 
 void S9xStartScreenRefresh (void)
 {
+	S9xWaitForRenderThread();
+
 	GFX.InterlaceFrame = !GFX.InterlaceFrame;
 	if (GFX.DoInterlace)
 		GFX.DoInterlace--;
@@ -180,7 +187,7 @@ void S9xStartScreenRefresh (void)
 
 		PPU.MosaicStart = 0;
 		PPU.RecomputeClipWindows = TRUE;
-		IPPU.PreviousLine = IPPU.CurrentLine = 0;
+		IPPU.PreviousLine = IPPU.CurrentLine = IPPU.QueuedLine = 0;
 	}
 
 	if (++IPPU.FrameCount % Memory.ROMFramesPerSecond == 0)
@@ -201,6 +208,7 @@ void S9xEndScreenRefresh (void)
 	if (IPPU.RenderThisFrame)
 	{
 		FLUSH_REDRAW();
+		S9xWaitForRenderThread();
 
 		if (GFX.DoInterlace && GFX.InterlaceFrame == 0)
 		{
@@ -437,87 +445,84 @@ static inline void RenderScreen (bool8 sub)
 	DrawBackdrop();
 }
 
-void S9xUpdateScreen (void)
+// Prepares GFX for drawing lines GFX.StartY through GFX.EndY, returns whether
+// the subscreen needs to be drawn as well
+static bool8 SetupScreenUpdate (void)
 {
-	if (IPPU.OBJChanged || IPPU.InterlaceOBJ)
-		SetupOBJ();
+	if (PPU.ForcedBlanking)
+		return FALSE;
 
-	// XXX: Check ForceBlank? Or anything else?
-	PPU.RangeTimeOver |= GFX.OBJLines[GFX.EndY].RTOFlags;
-
-	GFX.StartY = IPPU.PreviousLine;
-	if ((GFX.EndY = IPPU.CurrentLine - 1) >= PPU.ScreenHeight)
-		GFX.EndY = PPU.ScreenHeight - 1;
-
-	if (!PPU.ForcedBlanking)
+	if (PPU.RecomputeClipWindows)
 	{
-		// If force blank, may as well completely skip all this. We only did
-		// the OBJ because (AFAWK) the RTO flags are updated even during force-blank.
-
-		if (PPU.RecomputeClipWindows)
-		{
-			S9xComputeClipWindows();
-			PPU.RecomputeClipWindows = FALSE;
-		}
+		S9xComputeClipWindows();
+		PPU.RecomputeClipWindows = FALSE;
+	}
 
-		if (Settings.SupportHiRes)
+	if (Settings.SupportHiRes)
+	{
+		if (!IPPU.DoubleWidthPixels && (PPU.BGMode == 5 || PPU.BGMode == 6 || IPPU.PseudoHires))
 		{
-			if (!IPPU.DoubleWidthPixels && (PPU.BGMode == 5 || PPU.BGMode == 6 || IPPU.PseudoHires))
+			#ifdef USE_OPENGL
+			if (Settings.OpenGLEnable && GFX.RealPPL == 256)
 			{
-				#ifdef USE_OPENGL
-				if (Settings.OpenGLEnable && GFX.RealPPL == 256)
-				{
-					// Have to back out of the speed up hack where the low res.
-					// SNES image was rendered into a 256x239 sized buffer,
-					// ignoring the true, larger size of the buffer.
-					GFX.RealPPL = GFX.Pitch >> 1;
+				// Have to back out of the speed up hack where the low res.
+				// SNES image was rendered into a 256x239 sized buffer,
+				// ignoring the true, larger size of the buffer.
+				GFX.RealPPL = GFX.Pitch >> 1;
 
-					for (int32 y = (int32) GFX.StartY - 1; y >= 0; y--)
-					{
-						uint16	*p = GFX.Screen + y * GFX.PPL     + 255;
-						uint16	*q = GFX.Screen + y * GFX.RealPPL + 510;
-
-						for (int x = 255; x >= 0; x--, p--, q -= 2)
-							*q = *(q + 1) = *p;
-					}
-
-					GFX.PPL = GFX.RealPPL; // = GFX.Pitch >> 1 above
-				}
-				else
-				#endif
-				// Have to back out of the regular speed hack
-				for (uint32 y = 0; y < GFX.StartY; y++)
+				for (int32 y = (int32) GFX.StartY - 1; y >= 0; y--)
 				{
-					uint16	*p = GFX.Screen + y * GFX.PPL + 255;
-					uint16	*q = GFX.Screen + y * GFX.PPL + 510;
+					uint16	*p = GFX.Screen + y * GFX.PPL     + 255;
+					uint16	*q = GFX.Screen + y * GFX.RealPPL + 510;
 
 					for (int x = 255; x >= 0; x--, p--, q -= 2)
 						*q = *(q + 1) = *p;
 				}
 
-				IPPU.DoubleWidthPixels = TRUE;
-				IPPU.RenderedScreenWidth = 512;
+				GFX.PPL = GFX.RealPPL; // = GFX.Pitch >> 1 above
 			}
-
-			if (!IPPU.DoubleHeightPixels && IPPU.Interlace && (PPU.BGMode == 5 || PPU.BGMode == 6))
+			else
+			#endif
+			// Have to back out of the regular speed hack
+			for (uint32 y = 0; y < GFX.StartY; y++)
 			{
-				IPPU.DoubleHeightPixels = TRUE;
-				IPPU.RenderedScreenHeight = PPU.ScreenHeight << 1;
-				GFX.PPL = GFX.RealPPL << 1;
-				GFX.DoInterlace = 2;
+				uint16	*p = GFX.Screen + y * GFX.PPL + 255;
+				uint16	*q = GFX.Screen + y * GFX.PPL + 510;
 
-				for (int32 y = (int32) GFX.StartY - 2; y >= 0; y--)
-					memmove(GFX.Screen + (y + 1) * GFX.PPL, GFX.Screen + y * GFX.RealPPL, GFX.PPL * sizeof(uint16));
+				for (int x = 255; x >= 0; x--, p--, q -= 2)
+					*q = *(q + 1) = *p;
 			}
+
+			IPPU.DoubleWidthPixels = TRUE;
+			IPPU.RenderedScreenWidth = 512;
 		}
 
-		if ((Memory.FillRAM[0x2130] & 0x30) != 0x30 && (Memory.FillRAM[0x2131] & 0x3f))
-			GFX.FixedColour = BUILD_PIXEL(IPPU.XB[PPU.FixedColourRed], IPPU.XB[PPU.FixedColourGreen], IPPU.XB[PPU.FixedColourBlue]);
+		if (!IPPU.DoubleHeightPixels && IPPU.Interlace && (PPU.BGMode == 5 || PPU.BGMode == 6))
+		{
+			IPPU.DoubleHeightPixels = TRUE;
+			IPPU.RenderedScreenHeight = PPU.ScreenHeight << 1;
+			GFX.PPL = GFX.RealPPL << 1;
+			GFX.DoInterlace = 2;
 
-		if (PPU.BGMode == 5 || PPU.BGMode == 6 || IPPU.PseudoHires ||
-			((Memory.FillRAM[0x2130] & 0x30) != 0x30 && (Memory.FillRAM[0x2130] & 2) && (Memory.FillRAM[0x2131] & 0x3f) && (Memory.FillRAM[0x212d] & 0x1f)))
-			// If hires (Mode 5/6 or pseudo-hires) or math is to be done
-			// involving the subscreen, then we need to render the subscreen...
+			for (int32 y = (int32) GFX.StartY - 2; y >= 0; y--)
+				memmove(GFX.Screen + (y + 1) * GFX.PPL, GFX.Screen + y * GFX.RealPPL, GFX.PPL * sizeof(uint16));
+		}
+	}
+
+	if ((Memory.FillRAM[0x2130] & 0x30) != 0x30 && (Memory.FillRAM[0x2131] & 0x3f))
+		GFX.FixedColour = BUILD_PIXEL(IPPU.XB[PPU.FixedColourRed], IPPU.XB[PPU.FixedColourGreen], IPPU.XB[PPU.FixedColourBlue]);
+
+	// If hires (Mode 5/6 or pseudo-hires) or math is to be done
+	// involving the subscreen, then we need to render the subscreen...
+	return PPU.BGMode == 5 || PPU.BGMode == 6 || IPPU.PseudoHires ||
+		((Memory.FillRAM[0x2130] & 0x30) != 0x30 && (Memory.FillRAM[0x2130] & 2) && (Memory.FillRAM[0x2131] & 0x3f) && (Memory.FillRAM[0x212d] & 0x1f));
+}
+
+static void RenderScreenUpdate (bool8 blank, bool8 sub)
+{
+	if (!blank)
+	{
+		if (sub)
 			RenderScreen(TRUE);
 
 		RenderScreen(FALSE);
@@ -534,10 +539,133 @@ void S9xUpdateScreen (void)
 			for (int x = 0; x < IPPU.RenderedScreenWidth; x++)
 				GFX.S[x] = black;
 	}
+}
+
+void S9xUpdateScreen (void)
+{
+	S9xWaitForRenderThread();
+
+	if (IPPU.OBJChanged || IPPU.InterlaceOBJ)
+		SetupOBJ();
+
+	// XXX: Check ForceBlank? Or anything else?
+	PPU.RangeTimeOver |= GFX.OBJLines[GFX.EndY].RTOFlags;
+
+	// lines already handed to the render thread are skipped
+	GFX.StartY = std::max(IPPU.PreviousLine, IPPU.QueuedLine);
+	if ((GFX.EndY = IPPU.CurrentLine - 1) >= PPU.ScreenHeight)
+		GFX.EndY = PPU.ScreenHeight - 1;
+
+	// If force blank, may as well completely skip all this. We only did
+	// the OBJ because (AFAWK) the RTO flags are updated even during force-blank.
+	bool8 sub = SetupScreenUpdate();
+	RenderScreenUpdate(PPU.ForcedBlanking, sub);
 
 	IPPU.PreviousLine = IPPU.CurrentLine;
 }
 
+// Lines are drawn in batches of at least this many on the render thread,
+// smaller batches spend more time waking the thread than drawing
+#define RENDER_THREAD_MIN_LINES	16
+
+static struct SRenderThread
+{
+	std::thread		Thread;
+	IG::Semaphore	StartSem{0};
+	IG::Semaphore	DoneSem{0};
+	std::atomic_bool	Busy{};
+	bool8	Running = FALSE;
+	bool8	Queued = FALSE;
+	bool8	Blank = FALSE;
+	bool8	Sub = FALSE;
+	uint32	SavedEndY = 0;
+
+	~SRenderThread()
+	{
+		S9xSetRenderThread(FALSE);
+	}
+}	RenderThread;
+
+static void RenderThreadMain (void)
+{
+	for (;;)
+	{
+		RenderThread.StartSem.wait();
+		if (!RenderThread.Running)
+			return;
+
+		RenderScreenUpdate(RenderThread.Blank, RenderThread.Sub);
+		RenderThread.Busy.store(false, std::memory_order_release);
+		RenderThread.DoneSem.notify();
+	}
+}
+
+void S9xSetRenderThread (bool8 enable)
+{
+	if (enable == RenderThread.Running)
+		return;
+
+	if (enable)
+	{
+		RenderThread.Running = TRUE;
+		RenderThread.Thread = std::thread{RenderThreadMain};
+	}
+	else
+	{
+		S9xWaitForRenderThread();
+		RenderThread.Running = FALSE;
+		RenderThread.StartSem.notify();
+		RenderThread.Thread.join();
+	}
+}
+
+void S9xWaitForRenderThread (void)
+{
+	if (!RenderThread.Queued)
+		return;
+
+	RenderThread.DoneSem.wait();
+	RenderThread.Queued = FALSE;
+	// S9xUpdateScreen() reads the RTO flags from the end of its previous batch
+	GFX.EndY = RenderThread.SavedEndY;
+}
+
+// Called after each visible line, hands the lines finished since the last
+// update to the render thread if it's idle. The emulated PPU state they're drawn
+// from stays untouched until S9xWaitForRenderThread() collects them, so the
+// result matches drawing them in S9xUpdateScreen().
+void S9xQueueScreenUpdate (void)
+{
+	if (!RenderThread.Running || !IPPU.RenderThisFrame)
+		return;
+
+	if (RenderThread.Queued)
+	{
+		if (RenderThread.Busy.load(std::memory_order_acquire))
+			return;
+
+		S9xWaitForRenderThread();
+	}
+
+	int	startY = std::max(IPPU.PreviousLine, IPPU.QueuedLine);
+	int	endY = std::min(IPPU.CurrentLine - 1, (int) PPU.ScreenHeight - 1);
+	if (endY - startY + 1 < RENDER_THREAD_MIN_LINES)
+		return;
+
+	if (IPPU.OBJChanged || IPPU.InterlaceOBJ)
+		SetupOBJ();
+
+	RenderThread.SavedEndY = GFX.EndY;
+	GFX.StartY = startY;
+	GFX.EndY = endY;
+	RenderThread.Sub = SetupScreenUpdate();
+	RenderThread.Blank = PPU.ForcedBlanking;
+	IPPU.QueuedLine = IPPU.CurrentLine;
+	RenderThread.Queued = TRUE;
+	RenderThread.Busy.store(true, std::memory_order_relaxed);
+	RenderThread.StartSem.notify();
+}
+
 static void SetupOBJ (void)
 {
 	int	SmallWidth, SmallHeight, LargeWidth, LargeHeight;
@@ -205,6 +205,12 @@ void S9xStartScreenRefresh (void);
 void S9xEndScreenRefresh (void);
 void S9xBuildDirectColourMaps (void);
 void RenderLine (uint8);
+// lines queued by S9xQueueScreenUpdate() are drawn on the render thread while
+// emulation continues, anything that changes PPU state must call
+// S9xWaitForRenderThread() first
+void S9xSetRenderThread (bool8);
+void S9xQueueScreenUpdate (void);
+void S9xWaitForRenderThread (void);
 void S9xComputeClipWindows (void);
 void S9xDisplayChar (uint16 *, uint8);
 void S9xGraphicsScreenResize (void);
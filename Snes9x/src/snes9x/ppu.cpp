@@ -206,6 +206,27 @@ void S9xFixColourBrightness (void)
 	}
 }
 
+// Whether a register write can change state that lines queued on the render
+// thread still read. Scroll and Mode 7 matrix values are latched per line in
+// RenderLine(), and the VRAM/CGRAM address ports, read-only registers and WRAM
+// port don't feed the renderer, so HDMA writes to them don't wait.
+static inline bool8 WriteNeedsRenderThreadSync (uint16 Address)
+{
+	switch (Address)
+	{
+		case 0x210d: case 0x210e: case 0x210f: case 0x2110: // BGnHOFS, BGnVOFS, M7HOFS, M7VOFS
+		case 0x2111: case 0x2112: case 0x2113: case 0x2114:
+		case 0x2115: case 0x2116: case 0x2117:              // VMAIN, VMADDL, VMADDH
+		case 0x211b: case 0x211c: case 0x211d: case 0x211e: // M7A, M7B, M7C, M7D
+		case 0x211f: case 0x2120:                           // M7X, M7Y
+		case 0x2121:                                        // CGADD
+			return (FALSE);
+
+		default:
+			return (Address <= 0x2133);
+	}
+}
+
 void S9xSetPPU (uint8 Byte, uint16 Address)
 {
 	// MAP_PPU: $2000-$3FFF
@@ -251,6 +272,9 @@ void S9xSetPPU (uint8 Byte, uint16 Address)
 	else
 	if (Address <= 0x2183)
 	{
+		if (WriteNeedsRenderThreadSync(Address))
+			S9xWaitForRenderThread();
+
 		switch (Address)
 		{
 			case 0x2100: // INIDISP
@@ -1737,6 +1761,7 @@ void S9xResetPPU (void)
 
 void S9xResetPPUFast (void)
 {
+	S9xWaitForRenderThread();
 	PPU.RecomputeClipWindows = TRUE;
 	IPPU.ColorsChanged = TRUE;
 	IPPU.OBJChanged = TRUE;
@@ -1751,6 +1776,7 @@ void S9xResetPPUFast (void)
 
 void S9xSoftResetPPU (void)
 {
+	S9xWaitForRenderThread();
 	S9xControlsSoftReset();
 
 	PPU.VMA.High = 0;
@@ -1902,6 +1928,7 @@ void S9xSoftResetPPU (void)
 	IPPU.DoubleHeightPixels = FALSE;
 	IPPU.CurrentLine = 0;
 	IPPU.PreviousLine = 0;
+	IPPU.QueuedLine = 0;
 	IPPU.XB = NULL;
 	for (int c = 0; c < 256; c++)
 		IPPU.ScreenColors[c] = c;
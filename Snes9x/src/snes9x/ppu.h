@@ -48,6 +48,7 @@ struct InternalPPU
 	bool8	DoubleHeightPixels;
 	int		CurrentLine;
 	int		PreviousLine;
+	int		QueuedLine;
 	const uint8	*XB;
 	uint32	Red[256];
 	uint32	Green[256];
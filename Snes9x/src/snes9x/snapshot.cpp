@@ -19,6 +19,8 @@
 #include "display.h"
 #include "language.h"
 #include "gfx.h"
+#include <algorithm>
+#include <vector>
 
 #ifndef min
 #define min(a,b)	(((a) < (b)) ? (a) : (b))
@@ -1002,6 +1004,31 @@ static void FreezeStruct (STREAM, const char *, void *, FreezeData *, int);
 static bool CheckBlockName(STREAM stream, const char *name, int &len);
 static void SkipBlockWithName(STREAM stream, const char *name);
 
+// Temporary blocks used while freezing or unfreezing come from here instead of
+// new/delete. Every snapshot asks for the same sizes in the same order, so once
+// the blocks have grown to fit, repeated in-memory snapshots don't allocate.
+static std::vector<std::vector<uint8> >	ScratchBlocks;
+static size_t							ScratchBlocksUsed = 0;
+
+static uint8 * ScratchBlock (size_t size)
+{
+	if (ScratchBlocksUsed == ScratchBlocks.size())
+		ScratchBlocks.emplace_back();
+
+	std::vector<uint8>	&block = ScratchBlocks[ScratchBlocksUsed++];
+	if (block.size() < size || block.empty())
+		block.resize(std::max(size, (size_t) 1));
+
+	return (block.data());
+}
+
+// releases the blocks taken during its lifetime
+struct ScratchScope
+{
+	size_t	start = ScratchBlocksUsed;
+	~ScratchScope() { ScratchBlocksUsed = start; }
+};
+
 
 void S9xResetSaveTimer (bool8 dontsave)
 {
@@ -1179,8 +1206,9 @@ bool8 S9xUnfreezeScreenshot(const char *filename, uint16 **image_buffer, int &wi
 
 void S9xFreezeToStream (STREAM stream)
 {
+	ScratchScope	scratch;
 	char	buffer[8192];
-	uint8	*soundsnapshot = new uint8[SPC_SAVE_STATE_BLOCK_SIZE];
+	uint8	*soundsnapshot = ScratchBlock(SPC_SAVE_STATE_BLOCK_SIZE);
 
 	sprintf(buffer, "%s:%04d\n", SNAPSHOT_MAGIC, SNAPSHOT_VERSION);
 	WRITE_STREAM(buffer, strlen(buffer), stream);
@@ -1273,7 +1301,7 @@ void S9xFreezeToStream (STREAM stream)
 
 	if (Settings.SnapshotScreenshots)
 	{
-		SnapshotScreenshotInfo	*ssi = new SnapshotScreenshotInfo;
+		SnapshotScreenshotInfo	*ssi = (SnapshotScreenshotInfo *) ScratchBlock(sizeof(SnapshotScreenshotInfo));
 
 		ssi->Width  = min(IPPU.RenderedScreenWidth,  MAX_SNES_WIDTH);
 		ssi->Height = min(IPPU.RenderedScreenHeight, MAX_SNES_HEIGHT);
@@ -1298,8 +1326,6 @@ void S9xFreezeToStream (STREAM stream)
 		memset(rowpix, 0, sizeof(ssi->Data) + ssi->Data - rowpix);
 
 		FreezeStruct(stream, "SHO", ssi, SnapScreenshot, COUNT(SnapScreenshot));
-
-		delete ssi;
 	}
 
 	if (S9xMovieActive())
@@ -1319,12 +1345,11 @@ void S9xFreezeToStream (STREAM stream)
 			delete [] movie_freeze_buf;
 		}
 	}
-
-	delete [] soundsnapshot;
 }
 
 int S9xUnfreezeFromStream (STREAM stream)
 {
+	ScratchScope	scratch;
 	const bool8 fast = Settings.FastSavestates;
 
 	int		result = SUCCESS;
@@ -1754,7 +1779,7 @@ int S9xUnfreezeFromStream (STREAM stream)
 
 		if (local_screenshot)
 		{
-			SnapshotScreenshotInfo	*ssi = new SnapshotScreenshotInfo;
+			SnapshotScreenshotInfo	*ssi = (SnapshotScreenshotInfo *) ScratchBlock(sizeof(SnapshotScreenshotInfo));
 
 			UnfreezeStructFromCopy(ssi, SnapScreenshot, COUNT(SnapScreenshot), local_screenshot, version);
 
@@ -1801,46 +1826,16 @@ int S9xUnfreezeFromStream (STREAM stream)
 			// black out what we might have missed
 			for (uint32 y = IPPU.RenderedScreenHeight; y < (uint32) (IMAGE_HEIGHT); y++)
 				memset(GFX.Screen + y * GFX.RealPPL, 0, GFX.RealPPL * 2);
-
-			delete ssi;
 		}
 	}
 
-	if (local_cpu)				delete [] local_cpu;
-	if (local_registers)		delete [] local_registers;
-	if (local_ppu)				delete [] local_ppu;
-	if (local_dma)				delete [] local_dma;
-	if (local_vram)				delete [] local_vram;
-	if (local_ram)				delete [] local_ram;
-	if (local_sram)				delete [] local_sram;
-	if (local_fillram)			delete [] local_fillram;
-	if (local_apu_sound)		delete [] local_apu_sound;
-	if (local_control_data)		delete [] local_control_data;
-	if (local_timing_data)		delete [] local_timing_data;
-	if (local_superfx)			delete [] local_superfx;
-	if (local_sa1)				delete [] local_sa1;
-	if (local_sa1_registers)	delete [] local_sa1_registers;
-	if (local_dsp1)				delete [] local_dsp1;
-	if (local_dsp2)				delete [] local_dsp2;
-	if (local_dsp4)				delete [] local_dsp4;
-	if (local_cx4_data)			delete [] local_cx4_data;
-	if (local_st010)			delete [] local_st010;
-	if (local_obc1)				delete [] local_obc1;
-	if (local_obc1_data)		delete [] local_obc1_data;
-	if (local_spc7110)			delete [] local_spc7110;
-	if (local_srtc)				delete [] local_srtc;
-	if (local_rtc_data)			delete [] local_rtc_data;
-	if (local_bsx_data)			delete [] local_bsx_data;
-	if (local_msu1_data)			delete [] local_msu1_data;
-	if (local_screenshot)		delete [] local_screenshot;
-	if (local_movie_data)		delete [] local_movie_data;
-
 	return (result);
 }
 
 // load screenshot from file, allocating memory for it
 int S9xUnfreezeScreenshotFromStream(STREAM stream, uint16 **image_buffer, int &width, int &height)
 {
+    ScratchScope	scratch;
     int		result = SUCCESS;
     int		version, len;
     char	buffer[PATH_MAX + 1];
@@ -1894,7 +1889,7 @@ int S9xUnfreezeScreenshotFromStream(STREAM stream, uint16 **image_buffer, int &w
 
     if(result == SUCCESS && local_screenshot)
     {
-        SnapshotScreenshotInfo	*ssi = new SnapshotScreenshotInfo;
+        SnapshotScreenshotInfo	*ssi = (SnapshotScreenshotInfo *) ScratchBlock(sizeof(SnapshotScreenshotInfo));
 
         UnfreezeStructFromCopy(ssi, SnapScreenshot, COUNT(SnapScreenshot), local_screenshot, version);
 
@@ -1919,12 +1914,8 @@ int S9xUnfreezeScreenshotFromStream(STREAM stream, uint16 **image_buffer, int &w
                 screen[x] = BUILD_PIXEL(r, g, b);
             }
         }
-
-        delete ssi;
     }
 
-    if(local_screenshot)		delete[] local_screenshot;
-
     return (result);
 }
 
@@ -1962,7 +1953,7 @@ static void FreezeStruct (STREAM stream, const char *name, void *base, FreezeDat
 			len += FreezeSize(fields[i].size, fields[i].type);
 	}
 
-	uint8	*block = new uint8[len];
+	uint8	*block = ScratchBlock(len);
 	uint8	*ptr = block;
 	uint8	*addr;
 	uint16	word;
@@ -2064,7 +2055,6 @@ static void FreezeStruct (STREAM stream, const char *name, void *base, FreezeDat
 	}
 
 	FreezeBlock(stream, name, block, len);
-	delete [] block;
 }
 
 static void FreezeBlock (STREAM stream, const char *name, uint8 *block, int size)
@@ -2185,9 +2175,8 @@ static int UnfreezeBlock (STREAM stream, const char *name, uint8 *block, int siz
 
 	if (rem)
 	{
-		char	*junk = new char[rem];
+		uint8	*junk = ScratchBlock(rem);
 		len = READ_STREAM(junk, rem, stream);
-		delete [] junk;
 		if (len != rem)
 		{
 			REVERT_STREAM(stream, rewind, 0);
@@ -2202,19 +2191,18 @@ static int UnfreezeBlockCopy (STREAM stream, const char *name, uint8 **block, in
 {
 	int	result;
 
-	//check name first to avoid memory allocation
+	//check name first to avoid taking a scratch block
 	int blockLength;
 	if (!CheckBlockName(stream, name, blockLength))
 	{
 		return 0;
 	}
 
-	*block = new uint8[size];
+	*block = ScratchBlock(size);
 
 	result = UnfreezeBlock(stream, name, *block, size);
 	if (result != SUCCESS)
 	{
-		delete [] (*block);
 		*block = NULL;
 		return (result);
 	}
@@ -2229,14 +2217,9 @@ static int UnfreezeStruct (STREAM stream, const char *name, void *base, FreezeDa
 
 	result = UnfreezeStructCopy(stream, name, &block, fields, num_fields, version);
 	if (result != SUCCESS)
-	{
-		if (block != NULL)
-			delete [] block;
 		return (result);
-	}
 
 	UnfreezeStructFromCopy(base, fields, num_fields, block, version);
-	delete [] block;
 
 	return (SUCCESS);
 }
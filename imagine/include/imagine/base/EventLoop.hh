@@ -20,6 +20,8 @@
 
 #if defined CONFIG_BASE_GLIB
 #include <imagine/base/eventloop/GlibEventLoop.hh>
+#elif defined CONFIG_BASE_EPOLL
+#include <imagine/base/eventloop/EpollEventLoop.hh>
 #elif defined __ANDROID__
 #include <imagine/base/eventloop/ALooperEventLoop.hh>
 #elif defined __APPLE__
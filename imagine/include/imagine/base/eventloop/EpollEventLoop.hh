@@ -0,0 +1,72 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/base/eventLoopDefs.hh>
+#include <imagine/util/typeTraits.hh>
+#include <sys/epoll.h>
+#include <memory>
+
+namespace Base
+{
+
+static const int POLLEV_IN = EPOLLIN, POLLEV_OUT = EPOLLOUT, POLLEV_ERR = EPOLLERR, POLLEV_HUP = EPOLLHUP;
+
+struct EpollContext;
+
+struct EpollFDEventSourceInfo
+{
+	PollEventDelegate callback{};
+	EpollContext *ctx{};
+	bool *destroyedFlag{}; // set while the callback runs, see dispatchSource()
+	int fd = -1;
+};
+
+class EpollFDEventSource
+{
+public:
+	constexpr EpollFDEventSource() {}
+	EpollFDEventSource(int fd) : EpollFDEventSource{nullptr, fd} {}
+	EpollFDEventSource(const char *debugLabel, int fd);
+	EpollFDEventSource(EpollFDEventSource &&o);
+	EpollFDEventSource &operator=(EpollFDEventSource &&o);
+	~EpollFDEventSource();
+
+protected:
+	IG_enableMemberIf(Config::DEBUG_BUILD, const char *, debugLabel){};
+	std::unique_ptr<EpollFDEventSourceInfo> info{};
+	int fd_ = -1;
+
+	const char *label();
+	void deinit();
+};
+
+using FDEventSourceImpl = EpollFDEventSource;
+
+class EpollEventLoop
+{
+public:
+	constexpr EpollEventLoop() {}
+	constexpr EpollEventLoop(EpollContext *ctx): ctx{ctx} {}
+	EpollContext *nativeObject() const { return ctx; }
+
+protected:
+	EpollContext *ctx{};
+};
+
+using EventLoopImpl = EpollEventLoop;
+
+}
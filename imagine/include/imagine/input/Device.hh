@@ -19,11 +19,35 @@
 #include <imagine/input/config.hh>
 #include <imagine/util/bits.h>
 #include <imagine/util/DelegateFunc.hh>
+#include <array>
 #include <string>
 
 namespace Input
 {
 
+struct KeyStateSnapshot
+{
+	static constexpr uint32_t MAX_KEYS = 32;
+	std::array<Key, MAX_KEYS> pushed{};
+	uint32_t keys = 0;
+
+	bool isPushed(Key key) const
+	{
+		for(uint32_t i = 0; i < keys; i++)
+		{
+			if(pushed[i] == key)
+				return true;
+		}
+		return false;
+	}
+
+	void addPushed(Key key)
+	{
+		if(key && keys < MAX_KEYS && !isPushed(key))
+			pushed[keys++] = key;
+	}
+};
+
 class Device
 {
 public:
@@ -130,6 +154,10 @@ public:
 	virtual uint32_t joystickAxisBits() { return 0; }
 
 	virtual const char *keyName(Key k) const;
+	// Read the currently pushed keys directly from the system without consuming
+	// any queued events, may be called from any thread until the device's removal is notified,
+	// returns false if the device doesn't support it
+	virtual bool readKeyState(KeyStateSnapshot &snapshot) const { return false; }
 
 	// TODO
 	//bool isDisconnectable() { return 0; }
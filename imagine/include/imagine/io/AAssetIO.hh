@@ -33,6 +33,7 @@ public:
 	using IO::tell;
 	using IO::send;
 	using IO::constBufferView;
+	using IO::bufferView;
 	using IO::get;
 
 	constexpr AAssetIO() {}
@@ -36,8 +36,13 @@ public:
 		return open(buff, size, {});
 	}
 
+	// takes ownership of a read-only MAP_PRIVATE mmap() region,
+	// unmapping it on close unless transferred with releaseBuffer()
+	std::error_code openPrivateMap(void *data, size_t size);
+	IG::BufferView releaseBuffer(size_t minSize) final;
 	void close() final;
 
 protected:
 	OnCloseDelegate onClose{};
+	bool isPrivateMap{};
 };
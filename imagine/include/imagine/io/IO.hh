@@ -55,6 +55,9 @@ public:
 	off_t tell(std::error_code *ecOut = nullptr);
 	ssize_t send(IO &output, off_t *srcOffset, size_t bytes, std::error_code *ecOut = nullptr);
 	IG::ConstBufferView constBufferView();
+	// writable contents of the IO padded with zeros to at least minSize bytes,
+	// taken from releaseBuffer() when possible, otherwise read into a new buffer
+	IG::BufferView bufferView(size_t minSize = 0);
 
 	template <class T>
 	std::pair<T, ssize_t> read(std::error_code *ecOut = nullptr)
@@ -97,6 +100,7 @@ public:
 	using IOUtils<IO>::tell;
 	using IOUtils<IO>::send;
 	using IOUtils<IO>::constBufferView;
+	using IOUtils<IO>::bufferView;
 	using IOUtils<IO>::get;
 
 	// allow reading file, default if OPEN_WRITE isn't present
@@ -118,6 +122,10 @@ public:
 	virtual ssize_t read(void *buff, size_t bytes, std::error_code *ecOut) = 0;
 	virtual ssize_t readAtPos(void *buff, size_t bytes, off_t offset, std::error_code *ecOut);
 	virtual const char *mmapConst();
+	// transfer ownership of memory mapped data as a private copy-on-write
+	// buffer the caller can modify, padded with zeros to at least minSize bytes,
+	// the IO is closed on success, returns an empty buffer if unsupported
+	virtual IG::BufferView releaseBuffer(size_t minSize);
 
 	// writing
 	virtual ssize_t write(const void *buff, size_t bytes, std::error_code *ecOut) = 0;
@@ -148,6 +156,7 @@ public:
 	using IOUtils<GenericIO>::tell;
 	using IOUtils<GenericIO>::send;
 	using IOUtils<GenericIO>::constBufferView;
+	using IOUtils<GenericIO>::bufferView;
 	using IOUtils<GenericIO>::get;
 
 	constexpr GenericIO() {}
@@ -164,6 +173,7 @@ public:
 	ssize_t read(void *buff, size_t bytes, std::error_code *ecOut);
 	ssize_t readAtPos(void *buff, size_t bytes, off_t offset, std::error_code *ecOut);
 	const char *mmapConst();
+	IG::BufferView releaseBuffer(size_t minSize);
 	ssize_t write(const void *buff, size_t bytes, std::error_code *ecOut);
 	std::error_code truncate(off_t offset);
 	off_t seek(off_t offset, IO::SeekMode mode, std::error_code *ecOut);
@@ -33,6 +33,7 @@ public:
 	using IOUtils<PosixFileIO>::tell;
 	using IOUtils<PosixFileIO>::send;
 	using IOUtils<PosixFileIO>::constBufferView;
+	using IOUtils<PosixFileIO>::bufferView;
 	using IOUtils<PosixFileIO>::get;
 
 	constexpr PosixFileIO() {}
@@ -64,6 +65,7 @@ public:
 	ssize_t read(void *buff, size_t bytes, std::error_code *ecOut);
 	ssize_t readAtPos(void *buff, size_t bytes, off_t offset, std::error_code *ecOut);
 	const char *mmapConst();
+	IG::BufferView releaseBuffer(size_t minSize);
 	ssize_t write(const void *buff, size_t bytes, std::error_code *ecOut);
 	std::error_code truncate(off_t offset);
 	off_t seek(off_t offset, IO::SeekMode mode, std::error_code *ecOut);
@@ -24,9 +24,11 @@ template<class T>
 class BaseBufferView
 {
 public:
+	using DeleterFunc = void(*)(T*, size_t);
+
 	BaseBufferView() {}
-	BaseBufferView(T *data, size_t size, void(*deleter)(T*)):
-		data_{data, deleter}, size_{size} {}
+	BaseBufferView(T *data, size_t size, DeleterFunc deleter):
+		data_{data, {deleter, size}}, size_{size} {}
 
 	T *data()
 	{
@@ -44,7 +46,15 @@ public:
 	}
 
 protected:
-	std::unique_ptr<T[], void(*)(T*)> data_{nullptr, [](T*){}};
+	struct Deleter
+	{
+		DeleterFunc del = [](T*, size_t){};
+		size_t size = 0;
+
+		void operator()(T *ptr) const { del(ptr, size); }
+	};
+
+	std::unique_ptr<T[], Deleter> data_{};
 	size_t size_ = 0;
 };
 
@@ -0,0 +1,280 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "EventLoop"
+#include <imagine/base/EventLoop.hh>
+#include <imagine/thread/Thread.hh>
+#include <imagine/logger/logger.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+#include <cstring>
+
+namespace Base
+{
+
+// Per-thread epoll instance. Events are dispatched in batches of up to
+// MAX_EVENTS and an eventfd is registered with the context itself as its
+// user data pointer so stop() can wake epoll_wait().
+struct EpollContext
+{
+	static constexpr int MAX_EVENTS = 16;
+	int epollFD = -1;
+	int wakeFD = -1;
+	epoll_event *pendingEvents{};
+	int pendingEventCount = 0;
+
+	EpollContext():
+		epollFD{epoll_create1(EPOLL_CLOEXEC)},
+		wakeFD{eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)}
+	{
+		if(epollFD == -1 || wakeFD == -1)
+		{
+			logErr("error creating epoll context: %s", strerror(errno));
+			return;
+		}
+		epoll_event ev{};
+		ev.events = EPOLLIN;
+		ev.data.ptr = this;
+		epoll_ctl(epollFD, EPOLL_CTL_ADD, wakeFD, &ev);
+	}
+
+	~EpollContext()
+	{
+		if(wakeFD != -1)
+			close(wakeFD);
+		if(epollFD != -1)
+			close(epollFD);
+	}
+
+	void cancelPendingEvents(EpollFDEventSourceInfo *info)
+	{
+		// a callback may remove other sources that still have events in the current batch
+		for(int i = 0; i < pendingEventCount; i++)
+		{
+			if(pendingEvents[i].data.ptr == info)
+				pendingEvents[i].data.ptr = nullptr;
+		}
+	}
+};
+
+static thread_local std::unique_ptr<EpollContext> threadContext{};
+
+static void removeFromContext(EpollFDEventSourceInfo &info)
+{
+	epoll_ctl(info.ctx->epollFD, EPOLL_CTL_DEL, info.fd, nullptr);
+	info.ctx->cancelPendingEvents(&info);
+	info.ctx = {};
+}
+
+static void dispatchSource(EpollFDEventSourceInfo &info, uint32_t events)
+{
+	// the callback may destroy its own source (and this info with it),
+	// in which case deinit() sets the flag and the info can't be touched again
+	bool destroyed = false;
+	auto prevFlag = std::exchange(info.destroyedFlag, &destroyed);
+	bool keep = info.callback(info.fd, events);
+	if(destroyed)
+	{
+		if(prevFlag)
+			*prevFlag = true;
+		return;
+	}
+	info.destroyedFlag = prevFlag;
+	if(!keep && info.ctx)
+		removeFromContext(info);
+}
+
+EpollFDEventSource::EpollFDEventSource(const char *debugLabel, int fd):
+	debugLabel{debugLabel ? debugLabel : "unnamed"},
+	info{std::make_unique<EpollFDEventSourceInfo>()},
+	fd_{fd}
+{
+	info->fd = fd;
+}
+
+EpollFDEventSource::EpollFDEventSource(EpollFDEventSource &&o)
+{
+	*this = std::move(o);
+}
+
+EpollFDEventSource &EpollFDEventSource::operator=(EpollFDEventSource &&o)
+{
+	deinit();
+	info = std::move(o.info);
+	fd_ = std::exchange(o.fd_, -1);
+	debugLabel = o.debugLabel;
+	return *this;
+}
+
+EpollFDEventSource::~EpollFDEventSource()
+{
+	deinit();
+}
+
+bool FDEventSource::attach(EventLoop loop, PollEventDelegate callback, uint32_t events)
+{
+	assumeExpr(info);
+	detach();
+	if(!loop)
+		loop = EventLoop::forThread();
+	if(!loop)
+	{
+		logErr("no event loop in current thread to add fd:%d (%s)", fd_, label());
+		return false;
+	}
+	logMsg("adding fd:%d to epoll:%d (%s)", fd_, loop.nativeObject()->epollFD, label());
+	epoll_event ev{};
+	ev.events = events;
+	ev.data.ptr = info.get();
+	if(epoll_ctl(loop.nativeObject()->epollFD, EPOLL_CTL_ADD, fd_, &ev) == -1)
+	{
+		logErr("error adding fd:%d to epoll: %s (%s)", fd_, strerror(errno), label());
+		return false;
+	}
+	info->callback = callback;
+	info->ctx = loop.nativeObject();
+	return true;
+}
+
+void FDEventSource::detach()
+{
+	if(!info || !info->ctx)
+		return;
+	logMsg("removing fd %d from epoll (%s)", fd_, label());
+	removeFromContext(*info);
+}
+
+void FDEventSource::setEvents(uint32_t events)
+{
+	if(!hasEventLoop())
+	{
+		logErr("trying to set events while not attached to event loop");
+		return;
+	}
+	epoll_event ev{};
+	ev.events = events;
+	ev.data.ptr = info.get();
+	epoll_ctl(info->ctx->epollFD, EPOLL_CTL_MOD, fd_, &ev);
+}
+
+void FDEventSource::dispatchEvents(uint32_t events)
+{
+	assumeExpr(info);
+	dispatchSource(*info, events);
+}
+
+void FDEventSource::setCallback(PollEventDelegate callback)
+{
+	if(!hasEventLoop())
+	{
+		logErr("trying to set callback while not attached to event loop");
+		return;
+	}
+	info->callback = callback;
+}
+
+bool FDEventSource::hasEventLoop() const
+{
+	return info && info->ctx;
+}
+
+int FDEventSource::fd() const
+{
+	return fd_;
+}
+
+void FDEventSource::closeFD()
+{
+	if(fd_ == -1)
+		return;
+	detach();
+	close(fd_);
+	fd_ = -1;
+}
+
+void EpollFDEventSource::deinit()
+{
+	static_cast<FDEventSource*>(this)->detach();
+	if(info && info->destroyedFlag)
+		*info->destroyedFlag = true;
+}
+
+const char *EpollFDEventSource::label()
+{
+	return debugLabel;
+}
+
+EventLoop EventLoop::forThread()
+{
+	return {threadContext.get()};
+}
+
+EventLoop EventLoop::makeForThread()
+{
+	if(!threadContext)
+	{
+		threadContext = std::make_unique<EpollContext>();
+		if(Config::DEBUG_BUILD)
+		{
+			logMsg("made epoll:%d for thread:0x%lx", threadContext->epollFD, IG::thisThreadID<long>());
+		}
+	}
+	return {threadContext.get()};
+}
+
+void EventLoop::run()
+{
+	epoll_event events[EpollContext::MAX_EVENTS];
+	int count = epoll_wait(ctx->epollFD, events, EpollContext::MAX_EVENTS, -1);
+	if(count == -1)
+	{
+		if(errno != EINTR)
+			logErr("error in epoll_wait: %s", strerror(errno));
+		return;
+	}
+	ctx->pendingEvents = events;
+	ctx->pendingEventCount = count;
+	for(int i = 0; i < count; i++)
+	{
+		auto ptr = events[i].data.ptr;
+		if(!ptr)
+			continue; // source removed during this batch
+		if(ptr == ctx)
+		{
+			eventfd_t counter;
+			if(read(ctx->wakeFD, &counter, sizeof(counter)) == -1 && Config::DEBUG_BUILD && errno != EAGAIN)
+				logErr("error reading wake eventfd");
+			continue;
+		}
+		dispatchSource(*((EpollFDEventSourceInfo*)ptr), events[i].events);
+	}
+	ctx->pendingEvents = {};
+	ctx->pendingEventCount = 0;
+}
+
+void EventLoop::stop()
+{
+	eventfd_t counter = 1;
+	if(write(ctx->wakeFD, &counter, sizeof(counter)) == -1)
+		logErr("error writing wake eventfd");
+}
+
+EventLoop::operator bool() const
+{
+	return ctx;
+}
+
+}
@@ -24,18 +24,22 @@ ifeq ($(linuxWinSystem), x11)
  include $(imagineSrcDir)/base/x11/build.mk
 endif
 
+# glib or epoll, the DBus integration needs the GLib main context
 linuxEventLoop ?= glib
 
-ifeq ($(linuxEventLoop), glib)
+ifeq ($(linuxEventLoop), epoll)
+ configDefs += CONFIG_BASE_EPOLL
+ SRC += base/common/eventloop/EpollEventLoop.cc
+else
  configDefs += CONFIG_BASE_GLIB
  SRC += base/common/eventloop/GlibEventLoop.cc
  include $(IMAGINE_PATH)/make/package/glib.mk
-endif
 
-ifneq ($(SUBENV), pandora)
- configDefs += CONFIG_BASE_DBUS
- SRC += base/linux/dbus.cc
- include $(IMAGINE_PATH)/make/package/gio.mk
+ ifneq ($(SUBENV), pandora)
+  configDefs += CONFIG_BASE_DBUS
+  SRC += base/linux/dbus.cc
+  include $(IMAGINE_PATH)/make/package/gio.mk
+ endif
 endif
 
 endif
@@ -25,7 +25,11 @@
 #ifdef CONFIG_INPUT_EVDEV
 #include "../../input/evdev/evdev.hh"
 #endif
+#ifdef CONFIG_BASE_GLIB
+#include <glib.h>
+#endif
 #include <sys/stat.h>
+#include <algorithm>
 #include <cstring>
 
 namespace Base
@@ -35,6 +39,21 @@ static FS::PathString appPath{};
 
 constexpr mode_t defaultDirMode = S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH;
 
+static void makeDirWithParents(FS::PathString path)
+{
+	// create each parent in turn, existing directories are skipped by mkdir() failing with EEXIST
+	for(auto c = path.data() + 1; *c; c++)
+	{
+		if(*c != '/')
+			continue;
+		*c = '\0';
+		mkdir(path.data(), defaultDirMode);
+		*c = '/';
+	}
+	mkdir(path.data(), defaultDirMode);
+}
+
+#ifdef CONFIG_BASE_GLIB
 static GSourceFuncs x11SourceFuncs
 {
 	[](GSource *, gint *timeout)
@@ -54,6 +73,7 @@ static GSourceFuncs x11SourceFuncs
 	},
 	nullptr
 };
+#endif
 
 static void cleanup()
 {
@@ -92,14 +112,14 @@ FS::PathString supportPath(const char *appName)
 		home)
 	{
 		auto path = FS::makePathString(home, appName);
-		g_mkdir_with_parents(path.data(), defaultDirMode);
+		makeDirWithParents(path);
 		return path;
 	}
 	else if(auto home = getenv("HOME");
 		home)
 	{
 		auto path = FS::makePathStringPrintf("%s/.local/share/%s", home, appName);
-		g_mkdir_with_parents(path.data(), defaultDirMode);
+		makeDirWithParents(path);
 		return path;
 	}
 	logErr("XDG_DATA_HOME and HOME env variables not defined");
@@ -112,14 +132,14 @@ FS::PathString cachePath(const char *appName)
 		home)
 	{
 		auto path = FS::makePathString(home, appName);
-		g_mkdir_with_parents(path.data(), defaultDirMode);
+		makeDirWithParents(path);
 		return path;
 	}
 	else if(auto home = getenv("HOME");
 		home)
 	{
 		auto path = FS::makePathStringPrintf("%s/.cache/%s", home, appName);
-		g_mkdir_with_parents(path.data(), defaultDirMode);
+		makeDirWithParents(path);
 		return path;
 	}
 	logErr("XDG_DATA_HOME and HOME env variables not defined");
@@ -233,6 +253,16 @@ int main(int argc, char** argv)
 	engineInit();
 	appPath = FS::makeAppPathFromLaunchCommand(argv[0]);
 	auto eventLoop = EventLoop::makeForThread();
+	// skip connecting to the window system & input devices for apps
+	// that only do batch work when passed this arg, like test runners
+	bool headless = std::any_of(&argv[1], &argv[argc],
+		[](const char *arg){ return string_equal(arg, "--headless"); });
+	if(headless)
+	{
+		logMsg("running headless");
+		onInit(argc, argv);
+		return 0;
+	}
 	#ifdef CONFIG_BASE_X11
 	auto [ec, fd] = initWindowSystem(eventLoop);
 	if(fd == -1)
@@ -240,7 +270,16 @@ int main(int argc, char** argv)
 		return ec.value();
 	}
 	FDEventSource x11Src{"XServer", fd};
+	#ifdef CONFIG_BASE_GLIB
 	x11Src.attach(eventLoop, nullptr, &Base::x11SourceFuncs);
+	#else
+	x11Src.attach(eventLoop,
+		[](int fd, int events)
+		{
+			x11FDHandler();
+			return true;
+		});
+	#endif
 	#endif
 	#ifdef CONFIG_INPUT_EVDEV
 	Input::initEvdev(eventLoop);
@@ -248,7 +287,18 @@ int main(int argc, char** argv)
 	onInit(argc, argv);
 	setRunningActivityState();
 	dispatchOnResume(true);
+	#if defined CONFIG_BASE_X11 && !defined CONFIG_BASE_GLIB
+	// Xlib may have already read events into its queue that won't signal the fd,
+	// so drain them before each wait like the GLib source's prepare function does
+	while(true)
+	{
+		if(x11FDPending())
+			x11FDHandler();
+		eventLoop.run();
+	}
+	#else
 	bool eventLoopRunning = true;
 	eventLoop.run(eventLoopRunning);
+	#endif
 	return 0;
 }
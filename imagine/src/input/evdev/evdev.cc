@@ -271,9 +271,10 @@ struct EvdevInputDevice : public Device
 	void close()
 	{
 		fdSrc.detach();
-		::close(fd);
 		removeDevice(*this);
+		// notify first so users of readKeyState() on other threads can stop before the fd is closed
 		onDeviceChange.callCopySafe(*this, { Device::Change::REMOVED });
+		::close(fd);
 	}
 
 	void setJoystickAxisAsDpadBits(uint32_t axisMask) final
@@ -291,6 +292,38 @@ struct EvdevInputDevice : public Device
 	{
 		return axis[ABS_X].keyEmu.lowKey == Keycode::LEFT;
 	}
+
+	bool readKeyState(KeyStateSnapshot &snapshot) const final
+	{
+		ulong keyBit[Bits::elemsToHold<ulong>(KEY_CNT)] {0};
+		if(ioctl(fd, EVIOCGKEY(sizeof(keyBit)), keyBit) < 0)
+			return false;
+		snapshot.keys = 0;
+		for(uint32_t code = 0; code < KEY_CNT; code++)
+		{
+			if(!keyBit[code / (sizeof(ulong) * 8)])
+			{
+				code += sizeof(ulong) * 8 - 1; // skip empty word
+				continue;
+			}
+			if(Bits::isSetInArray(keyBit, code))
+				snapshot.addPushed(toSysKey(code));
+		}
+		iterateTimes(std::size(axis), i)
+		{
+			if(!axis[i].active)
+				continue;
+			struct input_absinfo info;
+			if(ioctl(fd, EVIOCGABS(i), &info) < 0)
+				continue;
+			auto &keyEmu = axis[i].keyEmu;
+			if(info.value <= keyEmu.lowLimit)
+				snapshot.addPushed(keyEmu.lowKey);
+			else if(info.value >= keyEmu.highLimit)
+				snapshot.addPushed(keyEmu.highKey);
+		}
+		return true;
+	}
 };
 
 static std::vector<std::unique_ptr<EvdevInputDevice>> evDevice{};
@@ -16,6 +16,10 @@
 #define LOGTAG "BufferMapIO"
 #include <imagine/io/BufferMapIO.hh>
 #include <imagine/logger/logger.h>
+#include <algorithm>
+#include <cstring>
+#include <sys/mman.h>
+#include <imagine/util/system/pagesize.h>
 
 BufferMapIO::~BufferMapIO()
 {
@@ -32,6 +36,7 @@ BufferMapIO &BufferMapIO::operator=(BufferMapIO &&o)
 	close();
 	MapIO::operator=(o);
 	onClose = std::exchange(o.onClose, {});
+	isPrivateMap = std::exchange(o.isPrivateMap, false);
 	o.resetData();
 	return *this;
 }
@@ -49,6 +54,58 @@ std::error_code BufferMapIO::open(const void *buff, size_t size, OnCloseDelegate
 	return {};
 }
 
+std::error_code BufferMapIO::openPrivateMap(void *data, size_t size)
+{
+	auto ec = open(data, size,
+		[data](BufferMapIO &io)
+		{
+			logMsg("unmapping %p", data);
+			munmap(data, io.size());
+		});
+	isPrivateMap = true;
+	return ec;
+}
+
+IG::BufferView BufferMapIO::releaseBuffer(size_t minSize)
+{
+	if(!isPrivateMap)
+		return {};
+	auto mapData = (char*)data;
+	size_t mapSize = roundUpToPageSize(dataSize);
+	size_t buffSize = std::max(dataSize, minSize);
+	#if !defined __linux__
+	if(buffSize > mapSize) // can't grow the mapping without mremap()
+		return {};
+	#endif
+	// bytes past the end of the file in its last page read as zero
+	if(mprotect(mapData, mapSize, PROT_READ | PROT_WRITE) != 0)
+	{
+		logErr("error making mapping @ %p writable:%s", mapData, strerror(errno));
+		return {};
+	}
+	#if defined __linux__
+	if(buffSize > mapSize)
+	{
+		// move the file pages to the start of a zero-filled anonymous region
+		void *region = mmap(nullptr, buffSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if(region == MAP_FAILED)
+			return {};
+		if(mremap(mapData, mapSize, mapSize, MREMAP_MAYMOVE | MREMAP_FIXED, region) == MAP_FAILED)
+		{
+			logErr("error moving mapping @ %p:%s", mapData, strerror(errno));
+			munmap(region, buffSize);
+			return {};
+		}
+		mapData = (char*)region;
+	}
+	#endif
+	logMsg("released %zu byte copy-on-write mapping @ %p", buffSize, mapData);
+	onClose = {};
+	isPrivateMap = false;
+	resetData();
+	return {mapData, buffSize, [](char *ptr, size_t size){ munmap(ptr, size); }};
+}
+
 void BufferMapIO::close()
 {
 	if(data)
@@ -58,6 +115,7 @@ void BufferMapIO::close()
 			onClose(*this);
 			onClose = {};
 		}
+		isPrivateMap = false;
 		resetData();
 	}
 }
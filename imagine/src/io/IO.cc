@@ -28,6 +28,8 @@ IO::~IO() {}
 
 const char *IO::mmapConst() { return nullptr; };
 
+IG::BufferView IO::releaseBuffer(size_t minSize) { return {}; };
+
 std::error_code IO::truncate(off_t offset) { return {ENOSYS, std::system_category()}; };
 
 void IO::sync() {}
@@ -148,6 +150,11 @@ const char *GenericIO::mmapConst()
 	return io ? io->mmapConst() : nullptr;
 }
 
+IG::BufferView GenericIO::releaseBuffer(size_t minSize)
+{
+	return io ? io->releaseBuffer(minSize) : IG::BufferView{};
+}
+
 ssize_t GenericIO::write(const void *buff, size_t bytes, std::error_code *ecOut)
 {
 	if(!io)
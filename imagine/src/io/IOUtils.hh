@@ -17,6 +17,7 @@
 
 #include <imagine/io/IO.hh>
 #include <array>
+#include <algorithm>
 
 template <class IO>
 ssize_t IOUtils<IO>::read(void *buff, size_t bytes)
@@ -114,7 +115,7 @@ IG::ConstBufferView IOUtils<IO>::constBufferView()
 	auto mmapData = static_cast<IO*>(this)->mmapConst();
 	if(mmapData)
 	{
-		return IG::ConstBufferView(mmapData, size, [](const char*){});
+		return IG::ConstBufferView(mmapData, size, [](const char*, size_t){});
 	}
 	else
 	{
@@ -125,6 +126,26 @@ IG::ConstBufferView IOUtils<IO>::constBufferView()
 			delete[] buff;
 			return {};
 		}
-		return IG::ConstBufferView(buff, size, [](const char *ptr){ delete[] ptr; });
+		return IG::ConstBufferView(buff, size, [](const char *ptr, size_t){ delete[] ptr; });
 	}
 }
+
+template <class IO>
+IG::BufferView IOUtils<IO>::bufferView(size_t minSize)
+{
+	if(auto buff = static_cast<IO*>(this)->releaseBuffer(minSize);
+		buff)
+	{
+		return buff;
+	}
+	auto size = static_cast<IO*>(this)->size();
+	auto buffSize = std::max(size, minSize);
+	seekS(0);
+	auto buff = new char[buffSize]{};
+	if(static_cast<IO*>(this)->read(buff, size) != (ssize_t)size)
+	{
+		delete[] buff;
+		return {};
+	}
+	return IG::BufferView(buff, buffSize, [](char *ptr, size_t){ delete[] ptr; });
+}
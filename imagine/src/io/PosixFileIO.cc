@@ -92,7 +92,8 @@ std::error_code PosixFileIO::open(const char *path, IO::AccessHint access, uint3
 BufferMapIO PosixFileIO::makePosixMapIO(IO::AccessHint access, int fd)
 {
 	off_t size = fd_size(fd);
-	int flags = MAP_SHARED;
+	// private so the pages can later be made writable as copy-on-write by releaseBuffer()
+	int flags = MAP_PRIVATE;
 	#if defined __linux__
 	if(access == IO::AccessHint::ALL)
 		flags |= MAP_POPULATE;
@@ -101,12 +102,7 @@ BufferMapIO PosixFileIO::makePosixMapIO(IO::AccessHint access, int fd)
 	if(data == MAP_FAILED)
 		return {};
 	BufferMapIO io;
-	io.open((const char*)data, size,
-		[data](BufferMapIO &io)
-		{
-			logMsg("unmapping %p", data);
-			munmap(data, io.size());
-		});
+	io.openPrivateMap(data, size);
 	return io;
 }
 
@@ -125,6 +121,11 @@ const char *PosixFileIO::mmapConst()
 	return io().mmapConst();
 }
 
+IG::BufferView PosixFileIO::releaseBuffer(size_t minSize)
+{
+	return io().releaseBuffer(minSize);
+}
+
 ssize_t PosixFileIO::write(const void *buff, size_t bytes, std::error_code *ecOut)
 {
 	return io().write(buff, bytes, ecOut);